@@ -0,0 +1,286 @@
+// BeaconCache - Bounded, refcounted per-BSSID beacon cache
+// hashcat and WPA-SEC need the AP beacon next to the EAPOL frames in a
+// PCAP. CapturedHandshake used to malloc its own copy (up to 1500 bytes)
+// per station, so three clients on one AP meant three identical beacons,
+// on top of OINK's static 1500-byte target buffer and DNH's 512-byte
+// staging buffers.
+//
+// Now every capture holds a Ref to one shared entry per BSSID:
+//   acquire(bssid)      - take a reference; creates an empty "wanted" entry
+//                         if the AP's beacon has not been seen yet
+//   offer(bssid, f, n)  - fill a wanted entry (cheap no-op for other APs,
+//                         so it can run on every beacon)
+//   put(bssid, f, n)    - cache a beacon whether or not anyone wants it yet
+//   release(ref)        - drop a reference; unreferenced beacons stay cached
+//                         until space is needed (LRU)
+//
+// Frames are stored back to back in one caller-owned block at their exact
+// length. Removing one slides the later frames down, so the block never
+// fragments and a long session costs no heap at all. Only unreferenced
+// entries are ever evicted; a Ref stays valid until released.
+//
+// data() pointers move when a frame is removed: read them only while no
+// other put()/offer()/release() can run (capture saves pause recon).
+// Not thread-safe; BeaconStore wraps the shared instance in a spinlock.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+class BeaconCache {
+public:
+    static constexpr uint8_t kMaxEntries = 16;
+    static constexpr uint16_t kMaxFrame = 1500;  // 802.11 practical limit
+
+    /**
+     * @brief Handle to one cache entry. slot == 0 means none, so a
+     * zero-initialised Ref (e.g. in CapturedHandshake hs = {0}) is valid.
+     */
+    struct Ref {
+        uint8_t slot;
+
+        bool empty() const { return slot == 0; }
+    };
+
+    /**
+     * @brief Attach caller-owned storage and drop every entry
+     * Existing Refs become invalid.
+     */
+    void attach(uint8_t* storage, size_t bytes) {
+        buf = storage;
+        cap = storage ? (uint16_t)(bytes < 0xFFFF ? bytes : 0xFFFF) : 0;
+        reset();
+    }
+
+    /**
+     * @brief Drop every entry (all outstanding Refs become invalid)
+     */
+    void reset() {
+        memset(entries, 0, sizeof(entries));
+        used = 0;
+        tick = 0;
+    }
+
+    bool attached() const { return buf != nullptr && cap > 0; }
+
+    /**
+     * @brief Take a reference to bssid's entry, creating an empty one
+     * @return Empty Ref if every entry is referenced by other APs
+     */
+    Ref acquire(const uint8_t* bssid) {
+        int i = indexOf(bssid);
+        if (i < 0) {
+            i = freeEntry();
+            if (i < 0) {
+                failedAcquires++;
+                return Ref{0};
+            }
+            Entry& e = entries[i];
+            memcpy(e.bssid, bssid, 6);
+            e.live = true;
+            e.off = 0;
+            e.len = 0;
+            e.refs = 0;
+        }
+        Entry& e = entries[i];
+        if (e.refs < 0xFF) e.refs++;
+        e.lastUse = ++tick;
+        return Ref{(uint8_t)(i + 1)};
+    }
+
+    /**
+     * @brief Drop a reference and empty ref
+     * A frameless entry nobody wants any more is removed immediately.
+     */
+    void release(Ref& ref) {
+        Entry* e = entryFor(ref);
+        ref.slot = 0;
+        if (!e) return;
+        if (e->refs > 0) e->refs--;
+        if (e->refs == 0 && e->len == 0) e->live = false;
+    }
+
+    /**
+     * @brief Store a beacon for bssid only if an entry is waiting for one
+     * @return true if the frame was stored
+     */
+    bool offer(const uint8_t* bssid, const uint8_t* frame, uint16_t len) {
+        int i = indexOf(bssid);
+        if (i < 0 || entries[i].len != 0) return false;
+        return fill(i, frame, len);
+    }
+
+    /**
+     * @brief Cache a beacon for bssid (kept if one is already cached)
+     * @return true if bssid now has a frame
+     */
+    bool put(const uint8_t* bssid, const uint8_t* frame, uint16_t len) {
+        int i = indexOf(bssid);
+        if (i >= 0) {
+            if (entries[i].len != 0) return true;
+            return fill(i, frame, len);
+        }
+        if (!frame || len == 0 || len > kMaxFrame || len > cap) return false;
+        i = freeEntry();
+        if (i < 0) {
+            failedStores++;
+            return false;
+        }
+        Entry& e = entries[i];
+        memcpy(e.bssid, bssid, 6);
+        e.live = true;
+        e.off = 0;
+        e.len = 0;
+        e.refs = 0;
+        e.lastUse = ++tick;
+        if (fill(i, frame, len)) return true;
+        e.live = false;
+        return false;
+    }
+
+    /**
+     * @brief Unreferenced handle to bssid's cached frame (empty if none)
+     * For fallbacks; use acquire() to keep the frame from being evicted.
+     */
+    Ref find(const uint8_t* bssid) const {
+        int i = indexOf(bssid);
+        if (i < 0 || entries[i].len == 0) return Ref{0};
+        return Ref{(uint8_t)(i + 1)};
+    }
+
+    bool hasFrame(const Ref& ref) const {
+        const Entry* e = entryFor(ref);
+        return e && e->len > 0;
+    }
+
+    const uint8_t* data(const Ref& ref) const {
+        const Entry* e = entryFor(ref);
+        return (e && e->len > 0) ? buf + e->off : nullptr;
+    }
+
+    uint16_t length(const Ref& ref) const {
+        const Entry* e = entryFor(ref);
+        return e ? e->len : 0;
+    }
+
+    uint8_t refCount(const Ref& ref) const {
+        const Entry* e = entryFor(ref);
+        return e ? e->refs : 0;
+    }
+
+    uint8_t entryCount() const {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < kMaxEntries; i++) {
+            if (entries[i].live) n++;
+        }
+        return n;
+    }
+
+    uint16_t bytesUsed() const { return used; }
+    uint16_t capacity() const { return cap; }
+    uint32_t getEvictions() const { return evictions; }
+    uint32_t getFailedStores() const { return failedStores; }
+    uint32_t getFailedAcquires() const { return failedAcquires; }
+
+private:
+    struct Entry {
+        uint8_t bssid[6];
+        bool live;
+        uint8_t refs;
+        uint16_t off;
+        uint16_t len;   // 0 = wanted, frame not seen yet
+        uint32_t lastUse;
+    };
+
+    Entry entries[kMaxEntries] = {};
+    uint8_t* buf = nullptr;
+    uint16_t cap = 0;
+    uint16_t used = 0;
+    uint32_t tick = 0;
+    uint32_t evictions = 0;
+    uint32_t failedStores = 0;
+    uint32_t failedAcquires = 0;
+
+    Entry* entryFor(const Ref& ref) {
+        if (ref.slot == 0 || ref.slot > kMaxEntries) return nullptr;
+        Entry& e = entries[ref.slot - 1];
+        return e.live ? &e : nullptr;
+    }
+
+    const Entry* entryFor(const Ref& ref) const {
+        if (ref.slot == 0 || ref.slot > kMaxEntries) return nullptr;
+        const Entry& e = entries[ref.slot - 1];
+        return e.live ? &e : nullptr;
+    }
+
+    int indexOf(const uint8_t* bssid) const {
+        for (uint8_t i = 0; i < kMaxEntries; i++) {
+            if (entries[i].live && memcmp(entries[i].bssid, bssid, 6) == 0) return i;
+        }
+        return -1;
+    }
+
+    // Least recently used entry nobody references, or -1
+    int lruVictim(int keep) const {
+        int victim = -1;
+        for (uint8_t i = 0; i < kMaxEntries; i++) {
+            const Entry& e = entries[i];
+            if (!e.live || e.refs != 0 || (int)i == keep) continue;
+            if (victim < 0 || e.lastUse < entries[victim].lastUse) victim = i;
+        }
+        return victim;
+    }
+
+    int freeEntry() {
+        for (uint8_t i = 0; i < kMaxEntries; i++) {
+            if (!entries[i].live) return i;
+        }
+        int victim = lruVictim(-1);
+        if (victim >= 0) evict(victim);
+        return victim;
+    }
+
+    // Remove an entry's frame and slide later frames down over it
+    void dropFrame(Entry& e) {
+        if (e.len == 0) return;
+        uint16_t end = (uint16_t)(e.off + e.len);
+        if (end < used) memmove(buf + e.off, buf + end, used - end);
+        for (uint8_t i = 0; i < kMaxEntries; i++) {
+            Entry& other = entries[i];
+            if (other.live && other.len > 0 && other.off > e.off) other.off -= e.len;
+        }
+        used -= e.len;
+        e.len = 0;
+        e.off = 0;
+    }
+
+    void evict(int i) {
+        dropFrame(entries[i]);
+        entries[i].live = false;
+        evictions++;
+    }
+
+    bool fill(int i, const uint8_t* frame, uint16_t len) {
+        if (!buf || !frame || len == 0 || len > kMaxFrame || len > cap) {
+            failedStores++;
+            return false;
+        }
+        while ((uint32_t)used + len > cap) {
+            int victim = lruVictim(i);
+            if (victim < 0) {
+                failedStores++;
+                return false;
+            }
+            evict(victim);
+        }
+        Entry& e = entries[i];
+        memcpy(buf + used, frame, len);
+        e.off = used;
+        e.len = len;
+        e.lastUse = ++tick;
+        used += len;
+        return true;
+    }
+};
@@ -0,0 +1,79 @@
+// BeaconStore - Shared beacon cache for captured handshakes
+
+#include "beacon_store.h"
+
+namespace BeaconStore {
+
+// ~8 typical beacons; a single 1500-byte beacon still fits
+static const uint16_t POOL_BYTES = 2560;
+
+static uint8_t pool[POOL_BYTES];
+static BeaconCache beaconCache;
+static bool attached = false;
+static portMUX_TYPE cacheMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void ensureAttached() {
+    if (!attached) {
+        beaconCache.attach(pool, sizeof(pool));
+        attached = true;
+    }
+}
+
+BeaconCache::Ref acquire(const uint8_t* bssid) {
+    taskENTER_CRITICAL(&cacheMux);
+    ensureAttached();
+    BeaconCache::Ref ref = beaconCache.acquire(bssid);
+    taskEXIT_CRITICAL(&cacheMux);
+    return ref;
+}
+
+void release(BeaconCache::Ref& ref) {
+    if (ref.empty()) return;
+    taskENTER_CRITICAL(&cacheMux);
+    beaconCache.release(ref);
+    taskEXIT_CRITICAL(&cacheMux);
+}
+
+bool offer(const uint8_t* bssid, const uint8_t* frame, uint16_t len) {
+    taskENTER_CRITICAL(&cacheMux);
+    ensureAttached();
+    bool stored = beaconCache.offer(bssid, frame, len);
+    taskEXIT_CRITICAL(&cacheMux);
+    return stored;
+}
+
+bool put(const uint8_t* bssid, const uint8_t* frame, uint16_t len) {
+    taskENTER_CRITICAL(&cacheMux);
+    ensureAttached();
+    bool stored = beaconCache.put(bssid, frame, len);
+    taskEXIT_CRITICAL(&cacheMux);
+    return stored;
+}
+
+BeaconCache::Ref find(const uint8_t* bssid) {
+    taskENTER_CRITICAL(&cacheMux);
+    BeaconCache::Ref ref = beaconCache.find(bssid);
+    taskEXIT_CRITICAL(&cacheMux);
+    return ref;
+}
+
+bool hasFrame(const BeaconCache::Ref& ref) {
+    taskENTER_CRITICAL(&cacheMux);
+    bool has = beaconCache.hasFrame(ref);
+    taskEXIT_CRITICAL(&cacheMux);
+    return has;
+}
+
+const uint8_t* data(const BeaconCache::Ref& ref) {
+    return beaconCache.data(ref);
+}
+
+uint16_t length(const BeaconCache::Ref& ref) {
+    return beaconCache.length(ref);
+}
+
+const BeaconCache& cache() {
+    return beaconCache;
+}
+
+}  // namespace BeaconStore
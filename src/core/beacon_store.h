@@ -0,0 +1,43 @@
+// BeaconStore - Shared beacon cache for captured handshakes
+// Owns the one BeaconCache that OINK, DO NO HAM and PigSync attach AP
+// beacons to captures through. The storage is a static block sized for a
+// handful of typical beacons, replacing the old per-handshake mallocs and
+// per-mode beacon buffers.
+//
+// Thread safety: every call takes a spinlock, so the packet callback can
+// offer()/put() while the main loop acquires and releases. data() pointers
+// are only stable while no callback can run (read them with recon paused,
+// as the PCAP writers do).
+#pragma once
+
+#include <Arduino.h>
+#include "beacon_cache.h"
+
+namespace BeaconStore {
+    /**
+     * @brief Reference bssid's beacon (waits for one if not cached yet)
+     */
+    BeaconCache::Ref acquire(const uint8_t* bssid);
+    void release(BeaconCache::Ref& ref);
+
+    /**
+     * @brief Fill a waiting entry (cheap no-op for unwanted APs)
+     */
+    bool offer(const uint8_t* bssid, const uint8_t* frame, uint16_t len);
+
+    /**
+     * @brief Cache a beacon even if nothing references the AP yet
+     */
+    bool put(const uint8_t* bssid, const uint8_t* frame, uint16_t len);
+
+    /**
+     * @brief Unreferenced handle to a cached beacon (PCAP fallback)
+     */
+    BeaconCache::Ref find(const uint8_t* bssid);
+
+    bool hasFrame(const BeaconCache::Ref& ref);
+    const uint8_t* data(const BeaconCache::Ref& ref);
+    uint16_t length(const BeaconCache::Ref& ref);
+
+    const BeaconCache& cache();
+}
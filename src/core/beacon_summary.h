@@ -0,0 +1,297 @@
+// BeaconSummary - Single-pass 802.11 information element parser
+// One bounds-checked walk over a beacon / probe response / assoc request IE
+// list, extracting everything the modes need: SSID, DS channel, RSN/WPA
+// AKMs, MFPC/MFPR and vendor IEs. Zero-copy: SSID and vendor bodies point
+// into the caller's frame buffer, so a summary is only valid while that
+// buffer is.
+//
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Fixed parameter layout ahead of the IE list
+static constexpr uint16_t kMgmtHeaderLen = 24;
+static constexpr uint16_t kBeaconIeOffset = 36;        // hdr(24) + ts(8) + intvl(2) + cap(2)
+static constexpr uint16_t kAssocReqIeOffset = 28;      // hdr(24) + cap(2) + listen(2)
+static constexpr uint16_t kReassocReqIeOffset = 34;    // assoc + current AP(6)
+
+// Element IDs we care about
+static constexpr uint8_t kIeSsid = 0;
+static constexpr uint8_t kIeDsParams = 3;
+static constexpr uint8_t kIeRsn = 0x30;
+static constexpr uint8_t kIeVendor = 0xDD;
+
+// AKM suite selectors (00-0F-AC:n for RSN, 00-50-F2:n for WPA1) as bit n
+static constexpr uint32_t kAkm8021X = 1u << 1;
+static constexpr uint32_t kAkmPsk = 1u << 2;
+static constexpr uint32_t kAkmFt8021X = 1u << 3;
+static constexpr uint32_t kAkmFtPsk = 1u << 4;
+static constexpr uint32_t kAkmPskSha256 = 1u << 6;
+static constexpr uint32_t kAkmSae = 1u << 8;
+static constexpr uint32_t kAkmFtSae = 1u << 9;
+static constexpr uint32_t kAkmOwe = 1u << 18;
+
+/**
+ * @brief Bounds-checked cursor over an IE list
+ * next() stops at the first element whose length runs past the buffer and
+ * flags it as truncated instead of reading out of bounds.
+ */
+struct IECursor {
+    const uint8_t* data;
+    uint16_t len;
+    uint16_t offset;
+    bool truncated;
+
+    IECursor(const uint8_t* ies, uint16_t iesLen)
+        : data(ies), len(iesLen), offset(0), truncated(false) {}
+
+    bool next(uint8_t& id, uint8_t& ieLen, const uint8_t*& body) {
+        if (!data || offset + 2 > len) return false;
+        id = data[offset];
+        ieLen = data[offset + 1];
+        if (offset + 2 + ieLen > len) {
+            truncated = true;
+            return false;
+        }
+        body = data + offset + 2;
+        offset += 2 + ieLen;
+        return true;
+    }
+};
+
+/**
+ * @brief Security classification, values match wifi_auth_mode_t
+ * (kept numeric so this header stays free of esp_wifi.h)
+ */
+enum class BeaconAuth : uint8_t {
+    Open = 0,
+    Wpa = 2,        // WIFI_AUTH_WPA_PSK
+    Wpa2 = 3,       // WIFI_AUTH_WPA2_PSK
+    WpaWpa2 = 4,    // WIFI_AUTH_WPA_WPA2_PSK
+    Wpa3 = 6,       // WIFI_AUTH_WPA3_PSK
+    Wpa2Wpa3 = 7    // WIFI_AUTH_WPA2_WPA3_PSK
+};
+
+struct BeaconSummary {
+    static constexpr uint8_t kMaxVendorIes = 8;
+
+    struct VendorIe {
+        const uint8_t* body;   // Starts at OUI
+        uint8_t len;
+    };
+
+    // SSID (first SSID element only)
+    const uint8_t* ssid;
+    uint8_t ssidLen;
+    bool ssidPresent;
+    bool ssidAllNull;          // Zero-length or all-0x00 SSID (hidden AP)
+
+    // DS Parameter Set
+    uint8_t dsChannel;         // 0 if absent
+
+    // RSN (first RSN element only)
+    bool hasRSN;
+    bool rsnCapsPresent;
+    bool mfpc;                 // RSN caps bit 6 - PMF capable
+    bool mfpr;                 // RSN caps bit 7 - PMF required
+    uint32_t rsnAkms;          // kAkm* bits
+
+    // WPA1 vendor element (00:50:F2 type 1)
+    bool hasWPA;
+    uint32_t wpaAkms;
+
+    // Other well-known vendor elements
+    bool hasWPS;               // 00:50:F2 type 4
+    bool hasWMM;               // 00:50:F2 type 2
+
+    uint8_t vendorCount;       // Stored entries (capped)
+    uint8_t vendorTotal;       // All vendor elements seen
+
+    bool truncated;            // IE list ran past the frame
+
+    // Last so clear() can skip it - entries past vendorCount are never read
+    VendorIe vendor[kMaxVendorIes];
+
+    void clear() { memset(this, 0, offsetof(BeaconSummary, vendor)); }
+
+    /** @brief SSID is 1-32 bytes and not all-null */
+    bool hasUsableSsid() const {
+        return ssidPresent && ssidLen > 0 && ssidLen <= 32 && !ssidAllNull;
+    }
+
+    /** @brief Broadcast SSID is empty or zeroed */
+    bool isHidden() const {
+        return ssidPresent && ssidAllNull;
+    }
+
+    /**
+     * @brief Copy SSID (1-32 bytes) into a 33-byte buffer
+     * @return false (out untouched) if there is no 1-32 byte SSID
+     */
+    bool copySsid(char* out) const {
+        if (!ssidPresent || ssidLen == 0 || ssidLen > 32) return false;
+        memcpy(out, ssid, ssidLen);
+        out[ssidLen] = 0;
+        return true;
+    }
+
+    /**
+     * @brief Classify auth the same way every mode always has
+     * RSN + MFPR = WPA3, RSN + MFPC = WPA2/WPA3, RSN = WPA2,
+     * WPA vendor = WPA1, both = WPA/WPA2, neither = open
+     */
+    BeaconAuth auth() const {
+        if (hasRSN && hasWPA) return BeaconAuth::WpaWpa2;
+        if (hasRSN) {
+            if (mfpr) return BeaconAuth::Wpa3;
+            if (mfpc) return BeaconAuth::Wpa2Wpa3;
+            return BeaconAuth::Wpa2;
+        }
+        if (hasWPA) return BeaconAuth::Wpa;
+        return BeaconAuth::Open;
+    }
+};
+
+namespace BeaconParser {
+
+static inline uint16_t le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// Walk a suite list of `count` 4-byte selectors, OR-ing matching AKM types
+static inline uint32_t akmBits(const uint8_t* p, uint16_t count, uint8_t oui0, uint8_t oui1, uint8_t oui2) {
+    uint32_t bits = 0;
+    for (uint16_t i = 0; i < count; i++, p += 4) {
+        if (p[0] == oui0 && p[1] == oui1 && p[2] == oui2 && p[3] < 32) {
+            bits |= 1u << p[3];
+        }
+    }
+    return bits;
+}
+
+// RSN body: version(2) group(4) pairwiseCount(2) pairwise(4n) akmCount(2) akm(4n) caps(2)
+static inline void parseRsn(const uint8_t* body, uint8_t len, BeaconSummary& out) {
+    if (len < 8) return;
+    if (le16(body) != 1) return;
+    uint32_t off = 6;
+    uint16_t pairwiseCount = le16(body + off);
+    off += 2 + pairwiseCount * 4;
+    if (off + 2 > len) return;
+    uint16_t akmCount = le16(body + off);
+    off += 2;
+    if (off + akmCount * 4 > len) return;
+    out.rsnAkms = akmBits(body + off, akmCount, 0x00, 0x0F, 0xAC);
+    off += akmCount * 4;
+    if (off + 2 > len) return;
+    uint16_t caps = le16(body + off);
+    out.rsnCapsPresent = true;
+    out.mfpc = (caps >> 6) & 0x01;
+    out.mfpr = (caps >> 7) & 0x01;
+}
+
+// WPA1 body after OUI+type: version(2) group(4) pairwiseCount(2) pairwise(4n) akmCount(2) akm(4n)
+static inline void parseWpa(const uint8_t* body, uint8_t len, BeaconSummary& out) {
+    uint32_t off = 4 + 6;
+    if (off + 2 > len) return;
+    uint16_t pairwiseCount = le16(body + off);
+    off += 2 + pairwiseCount * 4;
+    if (off + 2 > len) return;
+    uint16_t akmCount = le16(body + off);
+    off += 2;
+    if (off + akmCount * 4 > len) return;
+    out.wpaAkms = akmBits(body + off, akmCount, 0x00, 0x50, 0xF2);
+}
+
+/**
+ * @brief Summarize a raw IE list in one pass
+ * @param ies Start of the first element
+ * @param len Bytes of IE data (exclude FCS)
+ */
+static inline void parseIEs(const uint8_t* ies, uint16_t len, BeaconSummary& out) {
+    out.clear();
+    IECursor cur(ies, len);
+    uint8_t id;
+    uint8_t ieLen;
+    const uint8_t* body;
+    while (cur.next(id, ieLen, body)) {
+        switch (id) {
+            case kIeSsid:
+                if (out.ssidPresent) break;
+                out.ssidPresent = true;
+                out.ssid = body;
+                out.ssidLen = ieLen;
+                out.ssidAllNull = true;
+                for (uint8_t i = 0; i < ieLen; i++) {
+                    if (body[i] != 0) { out.ssidAllNull = false; break; }
+                }
+                break;
+
+            case kIeDsParams:
+                if (ieLen == 1 && out.dsChannel == 0) {
+                    out.dsChannel = body[0];
+                }
+                break;
+
+            case kIeRsn:
+                if (ieLen >= 2 && !out.hasRSN) {
+                    out.hasRSN = true;
+                    parseRsn(body, ieLen, out);
+                }
+                break;
+
+            case kIeVendor:
+                out.vendorTotal++;
+                if (out.vendorCount < BeaconSummary::kMaxVendorIes) {
+                    out.vendor[out.vendorCount].body = body;
+                    out.vendor[out.vendorCount].len = ieLen;
+                    out.vendorCount++;
+                }
+                if (ieLen >= 4 && body[0] == 0x00 && body[1] == 0x50 && body[2] == 0xF2) {
+                    if (body[3] == 0x01 && ieLen >= 8) {
+                        out.hasWPA = true;
+                        parseWpa(body, ieLen, out);
+                    } else if (body[3] == 0x02) {
+                        out.hasWMM = true;
+                    } else if (body[3] == 0x04) {
+                        out.hasWPS = true;
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    out.truncated = cur.truncated;
+}
+
+/**
+ * @brief Summarize a beacon or probe response (IEs start at offset 36)
+ * @return false if the frame is too short to carry any IEs
+ */
+static inline bool parseBeacon(const uint8_t* frame, uint16_t len, BeaconSummary& out) {
+    if (!frame || len < kBeaconIeOffset) {
+        out.clear();
+        return false;
+    }
+    parseIEs(frame + kBeaconIeOffset, len - kBeaconIeOffset, out);
+    return true;
+}
+
+/**
+ * @brief Summarize an (re)association request
+ */
+static inline bool parseAssocRequest(const uint8_t* frame, uint16_t len, bool isReassoc, BeaconSummary& out) {
+    uint16_t ieOffset = isReassoc ? kReassocReqIeOffset : kAssocReqIeOffset;
+    if (!frame || len < ieOffset) {
+        out.clear();
+        return false;
+    }
+    parseIEs(frame + ieOffset, len - ieOffset, out);
+    return true;
+}
+
+} // namespace BeaconParser
@@ -0,0 +1,145 @@
+// BssidIndex - Fixed-capacity open-addressed BSSID -> slot lookup table
+// Used by NetworkRecon to map a BSSID to its position in the shared networks
+// vector without a linear memcmp scan inside the promiscuous callback.
+//
+// Header-only and Arduino-free so the native test suite can exercise it.
+// No allocation: the whole table lives inline (kBuckets * 8 bytes).
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+template <uint16_t kBuckets>
+class BssidIndex {
+    static_assert(kBuckets >= 2 && (kBuckets & (kBuckets - 1)) == 0,
+                  "BssidIndex bucket count must be a power of two");
+
+public:
+    static constexpr uint16_t kEmpty = 0xFFFF;
+    // Keep at least one empty bucket so probe sequences always terminate
+    static constexpr uint16_t kMaxEntries = kBuckets - 1;
+
+    BssidIndex() { clear(); }
+
+    /**
+     * @brief Drop every entry (O(kBuckets))
+     */
+    void clear() {
+        for (uint16_t i = 0; i < kBuckets; i++) {
+            buckets[i].slot = kEmpty;
+        }
+        count = 0;
+    }
+
+    uint16_t size() const { return count; }
+
+    /**
+     * @brief Look up the slot stored for a BSSID
+     * @return Slot, or -1 if the BSSID is not indexed
+     */
+    int find(const uint8_t* bssid) const {
+        uint16_t i = home(bssid);
+        while (buckets[i].slot != kEmpty) {
+            if (memcmp(buckets[i].bssid, bssid, 6) == 0) {
+                return buckets[i].slot;
+            }
+            i = (i + 1) & kMask;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Insert a BSSID, or overwrite its slot if already present
+     * @return false if the table is full (entry not stored)
+     */
+    bool insert(const uint8_t* bssid, uint16_t slot) {
+        if (slot == kEmpty) return false;
+        uint16_t i = home(bssid);
+        while (buckets[i].slot != kEmpty) {
+            if (memcmp(buckets[i].bssid, bssid, 6) == 0) {
+                buckets[i].slot = slot;
+                return true;
+            }
+            i = (i + 1) & kMask;
+        }
+        if (count >= kMaxEntries) return false;
+        memcpy(buckets[i].bssid, bssid, 6);
+        buckets[i].slot = slot;
+        count++;
+        return true;
+    }
+
+    /**
+     * @brief Remove a BSSID
+     * Uses backward-shift deletion, so no tombstones accumulate and lookups
+     * never degrade over a long session of churn.
+     * @return true if the BSSID was present
+     */
+    bool erase(const uint8_t* bssid) {
+        uint16_t i = home(bssid);
+        while (buckets[i].slot != kEmpty) {
+            if (memcmp(buckets[i].bssid, bssid, 6) == 0) {
+                removeAt(i);
+                return true;
+            }
+            i = (i + 1) & kMask;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Rebuild from a container of items exposing a `bssid` member
+     * Slots are container positions. If a BSSID appears more than once the
+     * first occurrence wins, matching the old linear scan.
+     */
+    template <typename Container>
+    void rebuild(const Container& items) {
+        clear();
+        uint16_t n = (uint16_t)(items.size() < kMaxEntries ? items.size() : kMaxEntries);
+        for (uint16_t s = 0; s < n; s++) {
+            if (find(items[s].bssid) < 0) {
+                insert(items[s].bssid, s);
+            }
+        }
+    }
+
+private:
+    static constexpr uint16_t kMask = kBuckets - 1;
+
+    struct Bucket {
+        uint8_t bssid[6];
+        uint16_t slot;
+    };
+
+    Bucket buckets[kBuckets];
+    uint16_t count = 0;
+
+    static uint16_t home(const uint8_t* bssid) {
+        // OUI bytes are highly repetitive in a scan; the NIC-specific low
+        // bytes carry most of the entropy. Fold both and finalize.
+        uint32_t lo = (uint32_t)bssid[2] | ((uint32_t)bssid[3] << 8) |
+                      ((uint32_t)bssid[4] << 16) | ((uint32_t)bssid[5] << 24);
+        uint32_t hi = (uint32_t)bssid[0] | ((uint32_t)bssid[1] << 8);
+        uint32_t h = (lo ^ (hi * 0x85EBCA6Bu)) * 0x9E3779B1u;
+        h ^= h >> 16;
+        return (uint16_t)(h & kMask);
+    }
+
+    void removeAt(uint16_t hole) {
+        buckets[hole].slot = kEmpty;
+        count--;
+        uint16_t i = (hole + 1) & kMask;
+        while (buckets[i].slot != kEmpty) {
+            uint16_t h = home(buckets[i].bssid);
+            // Move entry back into the hole if its home is not in (hole, i]
+            bool movable = (hole <= i) ? (h <= hole || h > i)
+                                       : (h <= hole && h > i);
+            if (movable) {
+                buckets[hole] = buckets[i];
+                buckets[i].slot = kEmpty;
+                hole = i;
+            }
+            i = (i + 1) & kMask;
+        }
+    }
+};
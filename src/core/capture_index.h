@@ -0,0 +1,134 @@
+// CaptureIndex - Fixed-capacity hash index over (AP, station) capture pairs
+// Used by OINK and DO NO HAM to map a BSSID + station to its position in the
+// handshake / PMKID vectors, replacing a linear double-memcmp scan done for
+// every EAPOL frame while holding the recon spinlock.
+//
+// Compact: each bucket is a 16-bit hash and a 16-bit slot (4 bytes). The
+// full 12-byte key is not copied - a hash hit is confirmed against the
+// indexed container's own bssid/station fields, so find() takes the
+// container. Entries are only ever added (capture vectors grow until
+// cleared), so there is no erase and no tombstones.
+//
+// Thread safety: none of its own. Guard it with the same lock as the vector
+// it indexes (OINK: NetworkRecon::enterCritical(), held by both the callback
+// lookup and the main-loop insert).
+// Header-only and Arduino-free so the native test suite can exercise it.
+// No allocation: the whole table lives inline (kBuckets * 4 bytes).
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+template <uint16_t kBuckets>
+class CaptureIndex {
+    static_assert(kBuckets >= 2 && (kBuckets & (kBuckets - 1)) == 0,
+                  "CaptureIndex bucket count must be a power of two");
+
+public:
+    static constexpr uint16_t kEmpty = 0xFFFF;
+    // Keep at least one empty bucket so probe sequences always terminate
+    static constexpr uint16_t kMaxEntries = kBuckets - 1;
+
+    CaptureIndex() { clear(); }
+
+    /**
+     * @brief Drop every entry (O(kBuckets))
+     */
+    void clear() {
+        for (uint16_t i = 0; i < kBuckets; i++) {
+            buckets[i].slot = kEmpty;
+        }
+        count = 0;
+    }
+
+    uint16_t size() const { return count; }
+
+    /**
+     * @brief Look up the slot for an (AP, station) pair
+     * Pass station = nullptr for AP-only keys (DO NO HAM's PMKIDs); such
+     * entries must also be inserted with station = nullptr.
+     * @param items Container the slots index (elements expose bssid/station)
+     * @return Slot, or -1 if the pair is not indexed
+     */
+    template <typename Container>
+    int find(const Container& items, const uint8_t* bssid, const uint8_t* station) const {
+        uint16_t h = hashPair(bssid, station);
+        uint16_t i = h & kMask;
+        while (buckets[i].slot != kEmpty) {
+            uint16_t s = buckets[i].slot;
+            if (buckets[i].hash == h && s < items.size() &&
+                memcmp(items[s].bssid, bssid, 6) == 0 &&
+                (!station || memcmp(items[s].station, station, 6) == 0)) {
+                return s;
+            }
+            i = (i + 1) & kMask;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Index a new entry (caller has checked it is not present)
+     * @return false if the table is full (entry not indexed)
+     */
+    bool insert(const uint8_t* bssid, const uint8_t* station, uint16_t slot) {
+        if (slot == kEmpty || count >= kMaxEntries) return false;
+        uint16_t h = hashPair(bssid, station);
+        uint16_t i = h & kMask;
+        while (buckets[i].slot != kEmpty) {
+            i = (i + 1) & kMask;
+        }
+        buckets[i].hash = h;
+        buckets[i].slot = slot;
+        count++;
+        return true;
+    }
+
+    /**
+     * @brief Rebuild from a container (slots are container positions)
+     * @param apOnly Index on bssid alone (see find())
+     */
+    template <typename Container>
+    void rebuild(const Container& items, bool apOnly = false) {
+        clear();
+        uint16_t n = (uint16_t)(items.size() < kMaxEntries ? items.size() : kMaxEntries);
+        for (uint16_t s = 0; s < n; s++) {
+            const uint8_t* station = apOnly ? nullptr : items[s].station;
+            if (find(items, items[s].bssid, station) < 0) {
+                insert(items[s].bssid, station, s);
+            }
+        }
+    }
+
+    /**
+     * @brief 16-bit hash of the pair (station = nullptr hashes as all-zero)
+     */
+    static uint16_t hashPair(const uint8_t* bssid, const uint8_t* station) {
+        // Low NIC-specific bytes of both MACs carry the entropy; OUIs repeat
+        uint32_t ap = (uint32_t)bssid[2] | ((uint32_t)bssid[3] << 8) |
+                      ((uint32_t)bssid[4] << 16) | ((uint32_t)bssid[5] << 24);
+        uint32_t apHi = (uint32_t)bssid[0] | ((uint32_t)bssid[1] << 8);
+        uint32_t sta = 0, staHi = 0;
+        if (station) {
+            sta = (uint32_t)station[2] | ((uint32_t)station[3] << 8) |
+                  ((uint32_t)station[4] << 16) | ((uint32_t)station[5] << 24);
+            staHi = (uint32_t)station[0] | ((uint32_t)station[1] << 8);
+        }
+        uint32_t h = (ap ^ (apHi * 0x85EBCA6Bu)) * 0x9E3779B1u;
+        h ^= (sta ^ (staHi * 0xC2B2AE35u)) * 0x27D4EB2Fu;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 16;
+        return (uint16_t)h;
+    }
+
+private:
+    static constexpr uint16_t kMask = kBuckets - 1;
+
+    struct Bucket {
+        uint16_t hash;
+        uint16_t slot;
+    };
+
+    Bucket buckets[kBuckets];
+    uint16_t count = 0;
+};
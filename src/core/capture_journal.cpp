@@ -0,0 +1,328 @@
+// CaptureJournal - Append-only session capture journal on SD
+
+#include "capture_journal.h"
+#include "config.h"
+#include "sd_layout.h"
+#include "sdlog.h"
+#include <SD.h>
+
+using JournalFormat::FileHeader;
+using JournalFormat::RecordHeader;
+using JournalFormat::RecordType;
+
+namespace CaptureJournal {
+
+// reserve() keeps at least RESERVE_LOW zeroed ahead of the write position,
+// growing RESERVE_STEP per main-loop call so each top-up is a short stall
+// and cluster allocation happens outside the capture pause
+static const uint32_t RESERVE_LOW = 32768;
+static const uint32_t RESERVE_STEP = 8192;
+static const size_t COPY_CHUNK = 512;
+static const uint16_t MAX_JOURNALS = 1000;
+
+// Positional store for JournalFormat::Appender; seeks only when needed
+struct FileStore {
+    File file;
+    uint32_t pos = 0;
+
+    bool seekTo(uint32_t off) {
+        if (pos == off) return true;
+        if (!file.seek(off)) return false;
+        pos = off;
+        return true;
+    }
+
+    bool write(uint32_t off, const uint8_t* data, size_t len) {
+        if (!seekTo(off)) return false;
+        size_t n = file.write(data, len);
+        pos += n;
+        return n == len;
+    }
+
+    bool zero(uint32_t off, uint32_t len) {
+        static const uint8_t zeros[COPY_CHUNK] = {0};
+        if (!seekTo(off)) return false;
+        while (len > 0) {
+            size_t n = len < sizeof(zeros) ? len : sizeof(zeros);
+            if (!write(pos, zeros, n)) return false;
+            len -= n;
+        }
+        return true;
+    }
+};
+
+static FileStore store;
+static JournalFormat::Appender<FileStore> appender(store);
+static char openPath[64] = {0};
+static bool dirty = false;
+static uint32_t recordCount = 0;
+static uint32_t bytesWritten = 0;
+
+// Print adapter so PayloadWriters stream straight into the appender
+class RecordSink : public Print {
+public:
+    size_t write(uint8_t b) override {
+        return write(&b, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t len) override {
+        return appender.payload(data, len) ? len : 0;
+    }
+};
+
+static const char* basenameOf(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+// "session_NNN.pjl" -> NNN
+static bool parseSession(const char* name, uint16_t& session) {
+    unsigned n = 0;
+    int used = 0;
+    if (sscanf(name, "session_%u.pjl%n", &n, &used) != 1) return false;
+    if (name[used] != '\0' || n >= MAX_JOURNALS) return false;
+    session = (uint16_t)n;
+    return true;
+}
+
+static bool readAt(File& f, uint32_t off, void* dst, size_t len) {
+    return f.seek(off) && f.read((uint8_t*)dst, len) == len;
+}
+
+void journalPath(uint16_t session, char* out, size_t len) {
+    snprintf(out, len, "%s/session_%03u.pjl", SDLayout::journalDir(), (unsigned)session);
+}
+
+bool open() {
+    if (store.file) return true;
+    if (!Config::isSDAvailable()) return false;
+
+    const char* dir = SDLayout::journalDir();
+    if (!SD.exists(dir) && !SD.mkdir(dir)) {
+        SDLog::log("JOURNAL", "Failed to create %s", dir);
+        return false;
+    }
+
+    uint16_t session = 0;
+    for (; session < MAX_JOURNALS; session++) {
+        journalPath(session, openPath, sizeof(openPath));
+        if (!SD.exists(openPath)) break;
+    }
+    if (session >= MAX_JOURNALS) {
+        SDLog::log("JOURNAL", "No free journal name in %s", dir);
+        openPath[0] = '\0';
+        return false;
+    }
+
+    store.file = SD.open(openPath, FILE_WRITE);
+    store.pos = 0;
+    if (!store.file) {
+        SDLog::log("JOURNAL", "Failed to create %s", openPath);
+        openPath[0] = '\0';
+        return false;
+    }
+
+    // Header plus the first zero slot only - reserve() grows the rest
+    // from the main loop once NetworkRecon is running again
+    FileHeader hdr = JournalFormat::makeFileHeader(session);
+    appender.reset(sizeof(hdr));
+    if (!store.write(0, (const uint8_t*)&hdr, sizeof(hdr)) ||
+        !appender.reserve(sizeof(RecordHeader))) {
+        SDLog::log("JOURNAL", "Failed to initialise %s", openPath);
+        store.file.close();
+        SD.remove(openPath);
+        openPath[0] = '\0';
+        return false;
+    }
+    store.file.flush();
+
+    dirty = false;
+    recordCount = 0;
+    bytesWritten = 0;
+    Serial.printf("[JOURNAL] Opened %s\n", openPath);
+    return true;
+}
+
+void close() {
+    if (!store.file) return;
+    sync();
+    store.file.close();
+    Serial.printf("[JOURNAL] Closed %s (%u records, %u bytes, %u reserved + %u inline zero bytes)\n",
+                  openPath, (unsigned)recordCount, (unsigned)bytesWritten,
+                  (unsigned)appender.getReservedBytes(),
+                  (unsigned)appender.getInlineZeroBytes());
+    // An empty journal holds no captures - don't leave it behind
+    if (recordCount == 0) {
+        SD.remove(openPath);
+    }
+    openPath[0] = '\0';
+}
+
+bool isOpen() {
+    return (bool)store.file;
+}
+
+void reserve() {
+    if (!store.file || appender.headroom() >= RESERVE_LOW) return;
+    if (!appender.reserve(RESERVE_STEP)) {
+        SDLog::log("JOURNAL", "Reserve failed at %u", (unsigned)appender.zeroedTo());
+    }
+}
+
+bool append(RecordType type, const uint8_t* bssid, const uint8_t* station,
+            const char* ssid, PayloadWriter writer, const void* ctx) {
+    if (!store.file || !writer) return false;
+    if (!appender.begin()) return false;
+
+    RecordSink sink;
+    if (!writer(sink, ctx)) {
+        appender.abort();
+        return false;  // Header slot still zero: the walk stops here
+    }
+    uint32_t length = appender.payloadLength();
+    if (!appender.commit(type, bssid, station, ssid, millis())) return false;
+
+    dirty = true;
+    recordCount++;
+    bytesWritten += sizeof(RecordHeader) + length;
+    return true;
+}
+
+void sync() {
+    if (!store.file || !dirty) return;
+    store.file.flush();
+    dirty = false;
+}
+
+uint16_t forEachRecord(RecordVisitor visit, void* ctx) {
+    if (!visit || !Config::isSDAvailable()) return 0;
+
+    File d = SD.open(SDLayout::journalDir());
+    if (!d || !d.isDirectory()) {
+        if (d) d.close();
+        return 0;
+    }
+
+    uint16_t visited = 0;
+    bool stop = false;
+    File entry = d.openNextFile();
+    while (entry && !stop) {
+        RecordRef rec;
+        char path[64];
+        if (!entry.isDirectory() && parseSession(basenameOf(entry.name()), rec.session)) {
+            journalPath(rec.session, path, sizeof(path));
+            if (strcmp(path, openPath) != 0) {
+                rec.written = entry.getLastWrite();
+                JournalFormat::Walk w = JournalFormat::walkRecords(
+                    (uint32_t)entry.size(),
+                    [&entry](uint32_t off, void* dst, size_t len) { return readAt(entry, off, dst, len); },
+                    [&](const RecordHeader& h, uint32_t off) {
+                        rec.offset = off;
+                        rec.hdr = h;
+                        visited++;
+                        if (!visit(rec, ctx)) stop = true;
+                        return !stop;
+                    });
+                if (w == JournalFormat::Walk::NotJournal || w == JournalFormat::Walk::ReadError) {
+                    Serial.printf("[JOURNAL] %s: %s\n", path,
+                                  w == JournalFormat::Walk::NotJournal ? "no file header" : "read error");
+                }
+            }
+        }
+        entry.close();
+        if (stop) break;
+        entry = d.openNextFile();
+        yield();
+    }
+    d.close();
+    return visited;
+}
+
+void fileName(const RecordHeader& hdr, char* out, size_t len) {
+    const char* suffix = JournalFormat::suffixFor((RecordType)hdr.type);
+    char ssid[JournalFormat::kMaxSsidLen + 1];
+    JournalFormat::copySsid(hdr, ssid);
+    char path[96];
+    SDLayout::buildCaptureFilename(path, sizeof(path), "", ssid, hdr.bssid,
+                                   suffix ? suffix : "");
+    snprintf(out, len, "%s", basenameOf(path));
+}
+
+bool seekRecord(File& journal, uint32_t offset, RecordHeader& hdr) {
+    uint32_t size = (uint32_t)journal.size();
+    if (!readAt(journal, offset, &hdr, sizeof(hdr)) ||
+        !JournalFormat::isRecord(hdr, offset, size)) {
+        return false;
+    }
+
+    uint8_t buf[COPY_CHUNK];
+    JournalFormat::Payload p = JournalFormat::readPayload(
+        hdr, offset, buf, sizeof(buf),
+        [&journal](uint32_t off, void* dst, size_t len) { return readAt(journal, off, dst, len); },
+        [](const uint8_t*, size_t) { return true; });
+    if (p != JournalFormat::Payload::Ok) {
+        SDLog::log("JOURNAL", "Record at %u: %s", (unsigned)offset,
+                   p == JournalFormat::Payload::Corrupt ? "CRC mismatch" : "read error");
+        return false;
+    }
+    return journal.seek(offset + sizeof(RecordHeader));
+}
+
+bool openRecord(const char* path, uint32_t offset, RecordHeader& hdr, File& out) {
+    if (!path || strcmp(path, openPath) == 0) return false;
+    out = SD.open(path, FILE_READ);
+    if (!out) return false;
+    if (!seekRecord(out, offset, hdr)) {
+        out.close();
+        return false;
+    }
+    return true;
+}
+
+uint16_t removeAll() {
+    if (!Config::isSDAvailable()) return 0;
+
+    // Collect names first - removing while iterating a FAT directory is
+    // unsafe; repeat until a pass finds nothing more to remove
+    static const int MAX_PER_PASS = 16;
+    uint16_t removed = 0;
+    for (;;) {
+        File d = SD.open(SDLayout::journalDir());
+        if (!d || !d.isDirectory()) {
+            if (d) d.close();
+            break;
+        }
+        char paths[MAX_PER_PASS][64];
+        int count = 0;
+        File entry = d.openNextFile();
+        while (entry && count < MAX_PER_PASS) {
+            uint16_t session;
+            if (!entry.isDirectory() && parseSession(basenameOf(entry.name()), session)) {
+                journalPath(session, paths[count], sizeof(paths[count]));
+                if (strcmp(paths[count], openPath) != 0) count++;
+            }
+            entry.close();
+            entry = d.openNextFile();
+        }
+        if (entry) entry.close();
+        d.close();
+
+        int pass = 0;
+        for (int i = 0; i < count; i++) {
+            if (SD.remove(paths[i])) pass++;
+        }
+        removed += pass;
+        if (pass == 0 || count < MAX_PER_PASS) break;
+    }
+    return removed;
+}
+
+uint32_t getRecordCount() {
+    return recordCount;
+}
+
+uint32_t getBytesWritten() {
+    return bytesWritten;
+}
+
+}  // namespace CaptureJournal
@@ -0,0 +1,123 @@
+// CaptureJournal - Append-only session capture journal on SD
+// OINK appends every handshake PCAP / 22000 and PMKID 22000 body to one
+// file per session (see capture_journal_format.h) instead of creating two
+// or three files per network. One file create at session start replaces
+// the per-capture SD.exists / mkdir / directory updates, and the zeroed
+// region reserve() keeps ahead of the write position means appends rarely
+// touch the FAT at all.
+//
+// Journals are the permanent home of those captures - nothing copies them
+// back out to per-network files. The captures menu, /download, WPA-SEC and
+// the hash export walk the record headers with forEachRecord() and read a
+// payload in place with openRecord() or copyPayload(); fileName() gives the
+// SSID_BSSID name the record would have had as a loose file.
+//
+// Main loop only (SD access). Callers pause NetworkRecon around appends the
+// same way they did around per-file saves, and call reserve() outside it.
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "capture_journal_format.h"
+
+namespace CaptureJournal {
+    /**
+     * @brief Streams one record payload into out
+     * @return false to abandon the record (nothing is committed)
+     */
+    typedef bool (*PayloadWriter)(Print& out, const void* ctx);
+
+    static constexpr uint16_t kNoSession = 0xFFFF;
+
+    // One committed record of a closed journal
+    struct RecordRef {
+        uint16_t session;       // journalPath(session) holds it
+        uint32_t offset;        // File offset of the record header
+        time_t written;         // Journal's last-write time
+        JournalFormat::RecordHeader hdr;
+    };
+
+    /**
+     * @brief Called per record; return false to stop the walk
+     */
+    typedef bool (*RecordVisitor)(const RecordRef& rec, void* ctx);
+
+    /**
+     * @brief Create a new session journal (idempotent)
+     * Writes the file header and one zeroed header slot; reserve() grows it.
+     * @return true if a journal is open for appends
+     */
+    bool open();
+
+    /**
+     * @brief Sync and close the session journal
+     */
+    void close();
+
+    bool isOpen();
+
+    /**
+     * @brief Top up the zeroed region ahead of appends
+     * Call from the main loop outside NetworkRecon pauses. Zeroes at most
+     * one small step per call, and only once headroom runs low.
+     */
+    void reserve();
+
+    /**
+     * @brief Append one record; its header is written last as the commit
+     * Zero-fills at most the two header slots it needs when reserve() has
+     * fallen behind, so the paused save stays bounded.
+     * @param writer Streams the payload (the complete per-network file body)
+     * @return true once the record is committed (durable after sync())
+     */
+    bool append(JournalFormat::RecordType type, const uint8_t* bssid,
+                const uint8_t* station, const char* ssid,
+                PayloadWriter writer, const void* ctx);
+
+    /**
+     * @brief Flush committed records to the card (no-op when clean)
+     */
+    void sync();
+
+    /**
+     * @brief Walk the committed records of every closed journal
+     * Reads one 64-byte header per record; payloads are not touched.
+     * The open session journal is skipped.
+     * @return Number of records visited
+     */
+    uint16_t forEachRecord(RecordVisitor visit, void* ctx);
+
+    /**
+     * @brief Path of a session's journal file
+     */
+    void journalPath(uint16_t session, char* out, size_t len);
+
+    /**
+     * @brief Loose-file name of a record (SSID_BSSID.pcap / _hs.22000 / .22000)
+     */
+    void fileName(const JournalFormat::RecordHeader& hdr, char* out, size_t len);
+
+    /**
+     * @brief Open a journal positioned at a record's payload
+     * Checks the header at offset and the payload CRC first, so the caller
+     * can read exactly hdr.payloadLen good bytes from the returned file.
+     * @param path Journal file (any path is checked, not only journalDir())
+     * @return false if the file, header or payload is bad
+     */
+    bool openRecord(const char* path, uint32_t offset,
+                    JournalFormat::RecordHeader& hdr, File& out);
+
+    /**
+     * @brief Same, on a journal the caller already has open for reading
+     */
+    bool seekRecord(File& journal, uint32_t offset, JournalFormat::RecordHeader& hdr);
+
+    /**
+     * @brief Delete every closed journal (the open one is kept)
+     * @return Number of journals removed
+     */
+    uint16_t removeAll();
+
+    uint32_t getRecordCount();
+    uint32_t getBytesWritten();
+}
@@ -0,0 +1,347 @@
+// JournalFormat - On-SD layout of the OINK session capture journal
+// One file per session: a FileHeader, then back-to-back records, each a
+// RecordHeader followed by payloadLen bytes. A payload is the complete body
+// of the per-network file it stands for (a whole .pcap including its global
+// header, or a 22000 hash line), so consumers read it in place by offset.
+//
+// Commit protocol: a record's header slot is written as zeros, then the
+// payload, then the real header over the zeros. The header is the commit
+// marker - a torn write leaves a zero (or otherwise invalid) header and the
+// walk stops there. The tail of the file is kept zero-filled ahead of the
+// write position, so "first invalid header" is also the normal end.
+//
+// The chain of record headers is the index: walking it reads 64 bytes per
+// record and seeks over payloads, enough to list or read any network.
+// Appender, walkRecords() and readPayload() are the code CaptureJournal runs
+// on the card; they take the I/O as parameters so tests drive them in RAM.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "crc32.h"
+
+namespace JournalFormat {
+
+static constexpr uint32_t kFileMagic = 0x314A4B50;    // "PKJ1" little-endian
+static constexpr uint32_t kRecordMagic = 0x43524B50;  // "PKRC" little-endian
+static constexpr uint16_t kVersion = 1;
+static constexpr uint8_t kMaxSsidLen = 32;
+static constexpr uint32_t kMaxPayloadBytes = 16384;   // Sanity bound for scans
+
+enum class RecordType : uint8_t {
+    None = 0,
+    HandshakePcap = 1,    // -> SSID_BSSID.pcap
+    Handshake22000 = 2,   // -> SSID_BSSID_hs.22000
+    Pmkid22000 = 3        // -> SSID_BSSID.22000
+};
+
+#pragma pack(push, 1)
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerBytes;     // sizeof(FileHeader) - first record offset
+    uint32_t sessionId;
+    uint32_t reserved;
+};
+
+struct RecordHeader {
+    uint32_t magic;
+    uint8_t type;             // RecordType
+    uint8_t ssidLen;
+    uint16_t reserved;
+    uint32_t payloadLen;
+    uint32_t payloadCrc;      // Crc32 of the payload bytes
+    uint32_t timestampMs;
+    uint8_t bssid[6];
+    uint8_t station[6];
+    char ssid[32];            // Not NUL-terminated; ssidLen bytes valid
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FileHeader) == 16, "JournalFormat::FileHeader must be 16 bytes");
+static_assert(sizeof(RecordHeader) == 64, "JournalFormat::RecordHeader must be 64 bytes");
+
+inline FileHeader makeFileHeader(uint32_t sessionId) {
+    FileHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = kFileMagic;
+    h.version = kVersion;
+    h.headerBytes = sizeof(FileHeader);
+    h.sessionId = sessionId;
+    return h;
+}
+
+inline bool isFileHeader(const FileHeader& h) {
+    return h.magic == kFileMagic && h.version == kVersion &&
+           h.headerBytes >= sizeof(FileHeader);
+}
+
+inline RecordHeader makeRecordHeader(RecordType type, const uint8_t* bssid,
+                                     const uint8_t* station, const char* ssid,
+                                     uint32_t payloadLen, uint32_t payloadCrc,
+                                     uint32_t timestampMs) {
+    RecordHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = kRecordMagic;
+    h.type = (uint8_t)type;
+    h.payloadLen = payloadLen;
+    h.payloadCrc = payloadCrc;
+    h.timestampMs = timestampMs;
+    if (bssid) memcpy(h.bssid, bssid, 6);
+    if (station) memcpy(h.station, station, 6);
+    size_t n = ssid ? strnlen(ssid, kMaxSsidLen) : 0;
+    memcpy(h.ssid, ssid ? ssid : "", n);
+    h.ssidLen = (uint8_t)n;
+    return h;
+}
+
+/**
+ * @brief True if h is a committed record whose payload fits in the file
+ * @param offset File offset of the header
+ * @param fileSize Current journal size
+ */
+inline bool isRecord(const RecordHeader& h, uint32_t offset, uint32_t fileSize) {
+    if (h.magic != kRecordMagic) return false;
+    if (h.type == (uint8_t)RecordType::None || h.type > (uint8_t)RecordType::Pmkid22000) return false;
+    if (h.ssidLen > kMaxSsidLen) return false;
+    if (h.payloadLen == 0 || h.payloadLen > kMaxPayloadBytes) return false;
+    uint64_t end = (uint64_t)offset + sizeof(RecordHeader) + h.payloadLen;
+    return end <= fileSize;
+}
+
+/**
+ * @brief Offset of the record after h (h must satisfy isRecord)
+ */
+inline uint32_t nextOffset(const RecordHeader& h, uint32_t offset) {
+    return offset + sizeof(RecordHeader) + h.payloadLen;
+}
+
+/**
+ * @brief Copy the record's SSID into out as a C string (out >= 33 bytes)
+ */
+inline void copySsid(const RecordHeader& h, char* out) {
+    uint8_t n = h.ssidLen > kMaxSsidLen ? kMaxSsidLen : h.ssidLen;
+    memcpy(out, h.ssid, n);
+    out[n] = '\0';
+}
+
+/**
+ * @brief Filename suffix of the loose per-network file a record stands for
+ */
+inline const char* suffixFor(RecordType type) {
+    switch (type) {
+        case RecordType::HandshakePcap:  return ".pcap";
+        case RecordType::Handshake22000: return "_hs.22000";
+        case RecordType::Pmkid22000:     return ".22000";
+        default:                         return nullptr;
+    }
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+enum class Walk : uint8_t {
+    End,            // Reached the first uncommitted header slot (or EOF)
+    Stopped,        // visit() asked to stop
+    NotJournal,     // Missing or bad file header
+    ReadError       // I/O failed mid-walk - a retry may get further
+};
+
+/**
+ * @brief Visit every committed record in file order
+ * Stops at the first header that is not a committed record: the zero tail,
+ * a torn append, or damage (records behind it are unreachable).
+ * @param read bool(uint32_t offset, void* dst, size_t len), exact reads
+ * @param visit bool(const RecordHeader& h, uint32_t offset), false stops
+ */
+template <typename ReadFn, typename VisitFn>
+inline Walk walkRecords(uint32_t fileSize, ReadFn read, VisitFn visit) {
+    FileHeader fh;
+    if (fileSize < sizeof(fh)) return Walk::NotJournal;
+    if (!read(0, &fh, sizeof(fh))) return Walk::ReadError;
+    if (!isFileHeader(fh)) return Walk::NotJournal;
+
+    uint32_t offset = fh.headerBytes;
+    RecordHeader h;
+    while ((uint64_t)offset + sizeof(h) <= fileSize) {
+        if (!read(offset, &h, sizeof(h))) return Walk::ReadError;
+        if (!isRecord(h, offset, fileSize)) return Walk::End;
+        if (!visit(h, offset)) return Walk::Stopped;
+        offset = nextOffset(h, offset);
+    }
+    return Walk::End;
+}
+
+enum class Payload : uint8_t {
+    Ok,
+    Corrupt,        // CRC mismatch - the bytes on the card are wrong for good
+    IoError         // Read (or out) failed - a retry may succeed
+};
+
+/**
+ * @brief Stream a record's payload through buf, checking its CRC
+ * out() sees every chunk before the verdict is known, so callers that must
+ * not emit a damaged payload run this once with a no-op out() first.
+ * @param offset File offset of the record header
+ * @param read bool(uint32_t offset, void* dst, size_t len), exact reads
+ * @param out bool(const uint8_t* data, size_t len), false aborts
+ */
+template <typename ReadFn, typename OutFn>
+inline Payload readPayload(const RecordHeader& h, uint32_t offset,
+                           uint8_t* buf, size_t bufLen, ReadFn read, OutFn out) {
+    uint32_t pos = offset + sizeof(RecordHeader);
+    uint32_t remaining = h.payloadLen;
+    uint32_t crc = 0;
+    while (remaining > 0) {
+        size_t n = remaining < bufLen ? remaining : bufLen;
+        if (!read(pos, buf, n)) return Payload::IoError;
+        crc = Crc32::update(crc, buf, n);
+        if (!out(buf, n)) return Payload::IoError;
+        pos += n;
+        remaining -= n;
+    }
+    return crc == h.payloadCrc ? Payload::Ok : Payload::Corrupt;
+}
+
+// ============================================================================
+// Appending
+// ============================================================================
+
+/**
+ * @brief Write side of the commit protocol over a positional store
+ * Store provides bool write(uint32_t offset, const uint8_t* data, size_t len)
+ * and bool zero(uint32_t offset, uint32_t len).
+ *
+ * zeroedEnd is how far the file is known to read as zero past the last
+ * committed record. reserve() pushes it out ahead of time; begin() and
+ * commit() only ever zero the one header slot they need when the reserve
+ * has run out, so the append itself does at most 128 bytes of zero-fill.
+ */
+template <typename Store>
+class Appender {
+public:
+    explicit Appender(Store& s) : store(s) {}
+
+    /**
+     * @brief Start appending at firstRecord (end of the file header)
+     */
+    void reset(uint32_t firstRecord) {
+        writePos = firstRecord;
+        zeroedEnd = firstRecord;
+        active = false;
+        reservedBytes = 0;
+        inlineZeroBytes = 0;
+    }
+
+    /**
+     * @brief Zero-fill another `bytes` past the known-zero region
+     */
+    bool reserve(uint32_t bytes) {
+        if (active) return false;   // Would zero under the open payload
+        if (!store.zero(zeroedEnd, bytes)) return false;
+        zeroedEnd += bytes;
+        reservedBytes += bytes;
+        return true;
+    }
+
+    /**
+     * @brief Known-zero bytes ahead of the next record header
+     */
+    uint32_t headroom() const {
+        return zeroedEnd > writePos ? zeroedEnd - writePos : 0;
+    }
+
+    /**
+     * @brief Open a record: its header slot must read as zero first
+     */
+    bool begin() {
+        length = 0;
+        crc = 0;
+        failed = false;
+        active = zeroTo(writePos + sizeof(RecordHeader));
+        return active;
+    }
+
+    /**
+     * @brief Append payload bytes behind the (still zero) header slot
+     */
+    bool payload(const uint8_t* data, size_t len) {
+        if (!active || failed) return false;
+        if (length + len > kMaxPayloadBytes ||
+            !store.write(writePos + sizeof(RecordHeader) + length, data, len)) {
+            failed = true;
+            return false;
+        }
+        crc = Crc32::update(crc, data, len);
+        length += (uint32_t)len;
+        return true;
+    }
+
+    /**
+     * @brief Zero the slot after the payload, then write the header
+     * @return false if nothing was committed (the header slot stays zero)
+     */
+    bool commit(RecordType type, const uint8_t* bssid, const uint8_t* station,
+                const char* ssid, uint32_t timestampMs) {
+        if (!active) return false;
+        if (failed || length == 0) {
+            abort();
+            return false;
+        }
+
+        // The payload itself now covers [slot, next) - only the slot after
+        // it may still need zeroing before this record becomes reachable
+        uint32_t next = writePos + sizeof(RecordHeader) + length;
+        if (zeroedEnd < next) zeroedEnd = next;
+        RecordHeader h = makeRecordHeader(type, bssid, station, ssid,
+                                          length, crc, timestampMs);
+        if (!zeroTo(next + sizeof(RecordHeader)) ||
+            !store.write(writePos, (const uint8_t*)&h, sizeof(h))) {
+            abort();
+            return false;
+        }
+        writePos = next;
+        active = false;
+        return true;
+    }
+
+    /**
+     * @brief Drop the open record
+     * Its payload bytes are no longer zero, so the known-zero region shrinks
+     * back to the header slot; the next commit re-zeroes what it needs.
+     */
+    void abort() {
+        if (active && length > 0) zeroedEnd = writePos + sizeof(RecordHeader);
+        active = false;
+    }
+
+    uint32_t position() const { return writePos; }
+    uint32_t zeroedTo() const { return zeroedEnd; }
+    uint32_t payloadLength() const { return length; }
+    uint32_t getReservedBytes() const { return reservedBytes; }
+    uint32_t getInlineZeroBytes() const { return inlineZeroBytes; }
+
+private:
+    bool zeroTo(uint32_t end) {
+        if (end <= zeroedEnd) return true;
+        if (!store.zero(zeroedEnd, end - zeroedEnd)) return false;
+        inlineZeroBytes += end - zeroedEnd;
+        zeroedEnd = end;
+        return true;
+    }
+
+    Store& store;
+    uint32_t writePos = 0;          // Offset of the next record header
+    uint32_t zeroedEnd = 0;         // File reads as zero from the slot to here
+    uint32_t length = 0;            // Payload bytes of the open record
+    uint32_t crc = 0;
+    bool active = false;
+    bool failed = false;
+    uint32_t reservedBytes = 0;     // Zero-fill done by reserve()
+    uint32_t inlineZeroBytes = 0;   // Zero-fill done inside begin()/commit()
+};
+
+}  // namespace JournalFormat
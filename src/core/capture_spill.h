@@ -0,0 +1,156 @@
+// CaptureSpill - Bookkeeping for flushing captures to SD and dropping them
+// Used by DO NO HAM so a passive session is not capped by how many captures
+// fit in RAM. Completed captures are written to SD and evicted; RAM holds
+// only in-progress entries plus:
+//   DirtyMask       - which vector slots have something new to save, so a
+//                     save pass visits those slots instead of every entry
+//   SavedCaptureSet - 64-bit fingerprints of evicted (AP, station) pairs,
+//                     so late frames for a saved capture do not start a
+//                     new entry and write the same loot again
+// Eviction is swap-with-last + pop (removeSlot), which keeps the vector
+// dense; callers rebuild their CaptureIndex afterwards. OINK keeps saved
+// captures in RAM (frames released) and uses oldestIncomplete() to pick
+// which in-progress capture gives its EAPOL arena chunks back first.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace CaptureSpill {
+
+/**
+ * Set of vector slots (up to 64) with unsaved changes.
+ */
+class DirtyMask {
+public:
+    void clear() { bits = 0; }
+    bool any() const { return bits != 0; }
+    uint64_t raw() const { return bits; }
+
+    void set(uint8_t slot) { if (slot < 64) bits |= (1ull << slot); }
+    void reset(uint8_t slot) { if (slot < 64) bits &= ~(1ull << slot); }
+    bool test(uint8_t slot) const { return slot < 64 && (bits & (1ull << slot)) != 0; }
+
+    /**
+     * @brief Mirror a swap-remove: slot takes last's state, last is cleared
+     */
+    void moveLast(uint8_t slot, uint8_t last) {
+        bool lastDirty = test(last);
+        reset(last);
+        if (slot == last) return;
+        if (lastDirty) set(slot);
+        else reset(slot);
+    }
+
+private:
+    uint64_t bits = 0;
+};
+
+/**
+ * @brief Non-zero fingerprint of an (AP, station) pair
+ * station = nullptr keys AP-only captures (PMKIDs) apart from handshakes.
+ */
+inline uint64_t captureKey(const uint8_t* bssid, const uint8_t* station) {
+    uint64_t h = 0xCBF29CE484222325ull ^ (station ? 0x5A : 0xA5);
+    for (int i = 0; i < 6; i++) h = (h ^ bssid[i]) * 0x100000001B3ull;
+    if (station) {
+        for (int i = 0; i < 6; i++) h = (h ^ station[i]) * 0x100000001B3ull;
+    }
+    h ^= h >> 31;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 29;
+    return h ? h : 1;
+}
+
+/**
+ * Fixed-capacity set of capture keys (open addressing, no allocation).
+ * When full, add() reports false and the caller falls back to its slower
+ * check (DNH: CapturedIndex plus the loot file on SD).
+ */
+template <uint16_t kSlots>
+class SavedCaptureSet {
+    static_assert(kSlots >= 4 && (kSlots & (kSlots - 1)) == 0,
+                  "SavedCaptureSet slot count must be a power of two");
+
+public:
+    // 75% load keeps probe runs short
+    static constexpr uint16_t kCapacity = kSlots - kSlots / 4;
+
+    SavedCaptureSet() { clear(); }
+
+    void clear() {
+        memset(keys, 0, sizeof(keys));
+        count = 0;
+    }
+
+    uint16_t size() const { return count; }
+    bool full() const { return count >= kCapacity; }
+
+    bool contains(uint64_t key) const {
+        uint16_t i = (uint16_t)key & kMask;
+        while (keys[i] != 0) {
+            if (keys[i] == key) return true;
+            i = (i + 1) & kMask;
+        }
+        return false;
+    }
+
+    /**
+     * @return true if the key is (now) in the set
+     */
+    bool add(uint64_t key) {
+        uint16_t i = (uint16_t)key & kMask;
+        while (keys[i] != 0) {
+            if (keys[i] == key) return true;
+            i = (i + 1) & kMask;
+        }
+        if (count >= kCapacity) return false;
+        keys[i] = key;
+        count++;
+        return true;
+    }
+
+private:
+    static constexpr uint16_t kMask = kSlots - 1;
+
+    uint64_t keys[kSlots];
+    uint16_t count = 0;
+};
+
+/**
+ * @brief Swap-remove items[slot] (order is not preserved)
+ * @return Index of the element that moved into slot (== old last index)
+ */
+template <typename Vec>
+inline size_t removeSlot(Vec& items, size_t slot) {
+    size_t last = items.size() - 1;
+    if (slot != last) items[slot] = items[last];
+    items.pop_back();
+    return last;
+}
+
+/**
+ * @brief Least recently seen capture that still holds frames but is
+ * neither complete nor saved (arena reclaim victim)
+ * Items need capturedMask, saved, lastSeen and isComplete().
+ * @param skip Slot to leave alone (the capture being stored), or -1
+ * @return Slot, or -1 if there is none
+ */
+template <typename Vec>
+inline int oldestIncomplete(const Vec& items, uint32_t now, int skip = -1) {
+    int victim = -1;
+    uint32_t victimAge = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+        const auto& c = items[i];
+        if ((int)i == skip || c.saved || c.capturedMask == 0 || c.isComplete()) continue;
+        uint32_t age = now - c.lastSeen;
+        if (victim < 0 || age > victimAge) {
+            victim = (int)i;
+            victimAge = age;
+        }
+    }
+    return victim;
+}
+
+}  // namespace CaptureSpill
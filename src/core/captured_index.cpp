@@ -0,0 +1,339 @@
+// CapturedIndex - Persistent "already captured" BSSID index on SD
+
+#include "captured_index.h"
+#include "capture_journal.h"
+#include "config.h"
+#include "sd_layout.h"
+#include "sdlog.h"
+#include <SD.h>
+
+using CapturedIndexFormat::Delta;
+using CapturedIndexFormat::KeyFilter;
+using CapturedIndexFormat::kHeaderSize;
+using CapturedIndexFormat::kPageRecords;
+using CapturedIndexFormat::kRecordSize;
+
+namespace CapturedIndex {
+
+// Pending adds held in RAM before a merge rewrites the file (512 bytes)
+static const uint16_t DELTA_SLOTS = 64;
+static const size_t PAGE_BYTES = kPageRecords * kRecordSize;
+
+// Bloom filter over the sorted file's keys (~3% false positives at 2000)
+static const uint16_t FILTER_BYTES = 2048;
+
+typedef Delta<DELTA_SLOTS> PendingSet;
+
+static PendingSet delta;
+static KeyFilter<FILTER_BYTES> fileKeys;
+static bool filterValid = false;      // False: every lookup reads SD
+static uint8_t pageBuf[PAGE_BYTES];   // Lookup page cache, merge read buffer
+static uint8_t outBuf[PAGE_BYTES];    // Merge write buffer
+static int32_t cachedPage = -1;
+static uint32_t fileCount = 0;        // Records in the sorted file
+static bool ready = false;
+
+static void sidePath(char* out, size_t len, const char* ext) {
+    snprintf(out, len, "%s%s", SDLayout::capturedIndexPath(), ext);
+}
+
+static const char* basenameOf(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+static bool readPage(File& f, uint32_t page, const uint8_t*& recs, uint32_t& n) {
+    uint32_t first = page * kPageRecords;
+    n = fileCount - first;
+    if (n > kPageRecords) n = kPageRecords;
+    recs = pageBuf;
+    if ((int32_t)page == cachedPage) return true;
+
+    cachedPage = -1;
+    if (!f) {
+        f = SD.open(SDLayout::capturedIndexPath(), FILE_READ);
+        if (!f) return false;
+    }
+    size_t bytes = n * kRecordSize;
+    if (!f.seek(kHeaderSize + first * kRecordSize) || f.read(pageBuf, bytes) != (int)bytes) {
+        return false;
+    }
+    cachedPage = (int32_t)page;
+    return true;
+}
+
+// Merge the delta into a new sorted file and swap it in. dropLog also
+// deletes the append log, whose records are all in the delta by then.
+static bool writeIndex(bool dropLog) {
+    const char* path = SDLayout::capturedIndexPath();
+    char tmpPath[64];
+    sidePath(tmpPath, sizeof(tmpPath), ".tmp");
+    SD.remove(tmpPath);
+
+    File out = SD.open(tmpPath, FILE_WRITE);
+    if (!out) {
+        SDLog::log("CAPIDX", "Cannot create %s", tmpPath);
+        return false;
+    }
+    File in;
+    if (fileCount > 0) {
+        in = SD.open(path, FILE_READ);
+    }
+
+    uint8_t hdr[kHeaderSize];
+    CapturedIndexFormat::encodeHeader(hdr, 0);
+    bool ok = out.write(hdr, kHeaderSize) == kHeaderSize;
+    if (fileCount > 0) ok = ok && in && in.seek(kHeaderSize);
+    cachedPage = -1;  // pageBuf now holds merge input
+    fileKeys.clear();  // Refilled from the merge output
+    filterValid = false;
+
+    uint32_t inLeft = ok ? fileCount : 0;
+    uint32_t inPos = 0, inAvail = 0;
+    size_t outUsed = 0;
+    auto next = [&](uint64_t& rec) -> bool {
+        if (inPos == inAvail) {
+            if (inLeft == 0) return false;
+            uint32_t n = inLeft < kPageRecords ? inLeft : kPageRecords;
+            if (in.read(pageBuf, n * kRecordSize) != (int)(n * kRecordSize)) {
+                ok = false;
+                return false;
+            }
+            inLeft -= n;
+            inAvail = n;
+            inPos = 0;
+        }
+        rec = CapturedIndexFormat::getRecord(pageBuf + inPos++ * kRecordSize);
+        return true;
+    };
+    auto put = [&](uint64_t rec) -> bool {
+        fileKeys.add(CapturedIndexFormat::recordKey(rec));
+        CapturedIndexFormat::putRecord(outBuf + outUsed, rec);
+        outUsed += kRecordSize;
+        if (outUsed < PAGE_BYTES) return true;
+        bool wrote = out.write(outBuf, outUsed) == outUsed;
+        outUsed = 0;
+        return wrote;
+    };
+
+    int32_t merged = ok ? CapturedIndexFormat::mergeSorted(delta, next, put) : -1;
+    ok = ok && merged >= 0 && (outUsed == 0 || out.write(outBuf, outUsed) == outUsed);
+    if (ok) {
+        CapturedIndexFormat::encodeHeader(hdr, (uint32_t)merged);
+        ok = out.seek(0) && out.write(hdr, kHeaderSize) == kHeaderSize;
+    }
+    out.close();
+    if (in) in.close();
+
+    if (ok) {
+        SD.remove(path);
+        ok = SD.rename(tmpPath, path);
+    }
+    if (!ok) {
+        SD.remove(tmpPath);
+        SDLog::log("CAPIDX", "Merge failed (%u pending)", (unsigned)delta.size());
+        return false;
+    }
+
+    fileCount = (uint32_t)merged;
+    filterValid = true;
+    delta.clear();
+    if (dropLog) {
+        char logPath[64];
+        sidePath(logPath, sizeof(logPath), ".log");
+        SD.remove(logPath);
+    }
+    return true;
+}
+
+// Add to the delta, merging it into the file first when it is full
+static bool addPending(uint64_t key, uint8_t types, bool dropLog) {
+    if (delta.add(key, types) != PendingSet::Add::Full) return true;
+    if (!writeIndex(dropLog)) return false;
+    return delta.add(key, types) != PendingSet::Add::Full;
+}
+
+// One-time scan of loot file names (first boot, or a damaged index)
+static uint32_t rebuildFromLoot() {
+    // Journaled OINK captures count as loot without a file of their own
+    uint32_t found = 0;
+    CaptureJournal::forEachRecord([](const CaptureJournal::RecordRef& rec, void* ctx) {
+        uint8_t type = rec.hdr.type == (uint8_t)JournalFormat::RecordType::Pmkid22000
+                           ? CapturedIndexFormat::kPmkid : CapturedIndexFormat::kHandshake;
+        if (addPending(CapturedIndexFormat::bssidKey(rec.hdr.bssid), type, false)) {
+            (*(uint32_t*)ctx)++;
+        }
+        return true;
+    }, &found);
+
+    File d = SD.open(SDLayout::handshakesDir());
+    if (!d || !d.isDirectory()) {
+        if (d) d.close();
+        return found;
+    }
+    File entry = d.openNextFile();
+    while (entry) {
+        uint8_t bssid[6];
+        uint8_t type;
+        if (!entry.isDirectory() &&
+            CapturedIndexFormat::parseLootName(basenameOf(entry.name()), bssid, type)) {
+            if (addPending(CapturedIndexFormat::bssidKey(bssid), type, false)) found++;
+        }
+        entry.close();
+        entry = d.openNextFile();
+        yield();
+    }
+    d.close();
+    return found;
+}
+
+// One sequential pass over a valid file left as-is by begin()
+static void loadFilter() {
+    fileKeys.clear();
+    filterValid = false;
+    File f = SD.open(SDLayout::capturedIndexPath(), FILE_READ);
+    if (!f) return;
+    bool ok = f.seek(kHeaderSize);
+    uint32_t left = fileCount;
+    while (ok && left > 0) {
+        uint32_t n = left < kPageRecords ? left : kPageRecords;
+        ok = f.read(pageBuf, n * kRecordSize) == (int)(n * kRecordSize);
+        for (uint32_t i = 0; ok && i < n; i++) {
+            fileKeys.add(CapturedIndexFormat::recordKey(
+                CapturedIndexFormat::getRecord(pageBuf + i * kRecordSize)));
+        }
+        left -= n;
+        yield();
+    }
+    f.close();
+    cachedPage = -1;
+    filterValid = ok;
+}
+
+// Adds since the last merge; a torn final record is ignored
+static uint32_t replayLog() {
+    char logPath[64];
+    sidePath(logPath, sizeof(logPath), ".log");
+    File f = SD.open(logPath, FILE_READ);
+    if (!f) return 0;
+    uint32_t replayed = 0;
+    uint8_t rec[kRecordSize];
+    while (f.read(rec, kRecordSize) == (int)kRecordSize) {
+        uint64_t r = CapturedIndexFormat::getRecord(rec);
+        if (!CapturedIndexFormat::validRecord(r)) continue;
+        if (addPending(CapturedIndexFormat::recordKey(r), CapturedIndexFormat::recordTypes(r), false)) {
+            replayed++;
+        }
+    }
+    f.close();
+    return replayed;
+}
+
+bool begin() {
+    ready = false;
+    delta.clear();
+    fileCount = 0;
+    cachedPage = -1;
+    fileKeys.clear();
+    filterValid = false;
+    if (!Config::isSDAvailable()) return false;
+
+    const char* path = SDLayout::capturedIndexPath();
+    bool valid = false;
+    File f = SD.open(path, FILE_READ);
+    if (f) {
+        uint8_t hdr[kHeaderSize];
+        valid = f.read(hdr, kHeaderSize) == (int)kHeaderSize &&
+                CapturedIndexFormat::decodeHeader(hdr, fileCount) &&
+                f.size() >= kHeaderSize + (size_t)fileCount * kRecordSize;
+        f.close();
+    }
+    ready = true;
+
+    uint32_t rebuilt = 0;
+    if (!valid) {
+        fileCount = 0;
+        SD.remove(path);
+        rebuilt = rebuildFromLoot();
+    }
+    uint32_t replayed = replayLog();
+    if ((!valid || replayed > 0) && !writeIndex(true)) {
+        ready = false;
+        return false;
+    }
+    if (!filterValid) loadFilter();
+
+    if (!valid) {
+        SDLog::log("CAPIDX", "Index built from loot: %lu captures", (unsigned long)rebuilt);
+    }
+    Serial.printf("[CAPIDX] %lu captured BSSIDs (%lu replayed)\n",
+                  (unsigned long)fileCount, (unsigned long)replayed);
+    return true;
+}
+
+bool isReady() {
+    return ready;
+}
+
+uint8_t lookup(const uint8_t* bssid) {
+    if (!ready || !bssid) return 0;
+    uint64_t key = CapturedIndexFormat::bssidKey(bssid);
+    uint8_t types = delta.find(key);
+    if (fileCount == 0) return types;
+    if (filterValid && !fileKeys.mayContain(key)) return types;  // No SD read
+
+    File f;
+    types |= CapturedIndexFormat::searchPaged(fileCount, key,
+        [&](uint32_t page, const uint8_t*& recs, uint32_t& n) {
+            return readPage(f, page, recs, n);
+        });
+    if (f) f.close();
+    return types;
+}
+
+bool contains(const uint8_t* bssid, uint8_t types) {
+    return (lookup(bssid) & types) != 0;
+}
+
+bool add(const uint8_t* bssid, uint8_t types) {
+    types &= kAnyCapture;
+    if (!ready || !bssid || types == 0) return false;
+    if ((lookup(bssid) & types) == types) return false;
+
+    uint64_t key = CapturedIndexFormat::bssidKey(bssid);
+    if (!addPending(key, types, true)) return false;
+
+    // Logged after the delta so a merge triggered above cannot drop it
+    char logPath[64];
+    sidePath(logPath, sizeof(logPath), ".log");
+    File log = SD.open(logPath, FILE_APPEND);
+    if (log) {
+        uint8_t rec[kRecordSize];
+        CapturedIndexFormat::putRecord(rec, CapturedIndexFormat::makeRecord(key, types));
+        log.write(rec, kRecordSize);
+        log.close();
+    }
+    return true;
+}
+
+bool compact() {
+    if (!ready) return false;
+    if (delta.size() == 0) return true;
+    return writeIndex(true);
+}
+
+void clear() {
+    if (!ready) return;
+    delta.clear();
+    fileCount = 0;
+    cachedPage = -1;
+    SD.remove(SDLayout::capturedIndexPath());
+    writeIndex(true);
+    SDLog::log("CAPIDX", "Index cleared");
+}
+
+uint32_t size() {
+    return fileCount + delta.size();
+}
+
+}  // namespace CapturedIndex
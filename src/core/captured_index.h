@@ -0,0 +1,61 @@
+// CapturedIndex - Persistent "already captured" BSSID index on SD
+// Remembers every (BSSID, capture type) saved to the loot folder across
+// sessions (format in captured_index_format.h). OINK skips targets it has
+// a handshake for, DNH skips rewriting loot it already has, and WARHOG
+// leaves captured networks out of the bounty pool.
+//
+// begin() validates the header, replays the small append log and fills a
+// 2KB in-RAM Bloom filter in one sequential read of the index (8 bytes per
+// capture, not a loot folder listing). Lookups for BSSIDs the filter rules
+// out never touch SD, so per-tick checks in OINK and WARHOG stay cheap;
+// the rest page the sorted file in 256 bytes at a time. The first boot without an index (or after a
+// damaged one) builds it once from the handshakes directory file names.
+//
+// Main loop only (SD access). Callers pause NetworkRecon around add() the
+// same way they do around capture saves.
+#pragma once
+
+#include <Arduino.h>
+#include "captured_index_format.h"
+
+namespace CapturedIndex {
+    using CapturedIndexFormat::kHandshake;
+    using CapturedIndexFormat::kPmkid;
+    using CapturedIndexFormat::kAnyCapture;
+
+    /**
+     * @brief Open the index at boot (rebuilds it from loot names if missing)
+     * @return true if queries and adds are available
+     */
+    bool begin();
+
+    bool isReady();
+
+    /**
+     * @brief Capture types recorded for a BSSID (0 = never captured)
+     */
+    uint8_t lookup(const uint8_t* bssid);
+
+    /**
+     * @brief True if any of types was captured for this BSSID before
+     */
+    bool contains(const uint8_t* bssid, uint8_t types);
+
+    /**
+     * @brief Record a saved capture (no SD write if already known)
+     * @return true if the index changed
+     */
+    bool add(const uint8_t* bssid, uint8_t types);
+
+    /**
+     * @brief Merge pending adds into the sorted file
+     */
+    bool compact();
+
+    /**
+     * @brief Forget every capture (after the loot folder is wiped)
+     */
+    void clear();
+
+    uint32_t size();  // Records in the file plus pending adds (approximate)
+}
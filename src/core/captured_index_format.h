@@ -0,0 +1,324 @@
+// CapturedIndexFormat - On-SD layout of the captured (BSSID, type) index
+// CapturedIndex keeps one record per BSSID ever saved to the loot folder so
+// OINK, DNH and WARHOG can tell "already captured" across sessions without
+// listing the handshakes directory.
+//
+// File: 16-byte header, then count 8-byte records sorted by BSSID.
+//   Header: magic, version, record size, count, CRC-32 of the first 12 bytes
+//   Record: little-endian uint64 = BSSID (48 bits, big-endian MAC order,
+//           same packing as WARHOG's bssidToKey) << 8 | type mask
+// Lookups read one page of kPageRecords records at a time and binary search
+// page by page, so the file is never loaded whole. New captures go to a
+// small sorted delta in RAM (and an append log of raw records for crash
+// safety); a full delta is merged into a fresh sorted file in one
+// sequential pass. A KeyFilter in RAM answers most misses without
+// touching SD.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "crc32.h"
+
+namespace CapturedIndexFormat {
+
+static constexpr uint32_t kMagic = 0x58434B50;  // "PKCX"
+static constexpr uint16_t kVersion = 1;
+static constexpr size_t kHeaderSize = 16;
+static constexpr size_t kRecordSize = 8;
+static constexpr uint32_t kPageRecords = 32;    // 256-byte read unit
+static constexpr uint64_t kKeyMask = 0xFFFFFFFFFFFFull;
+
+// Capture types (bit mask)
+static constexpr uint8_t kHandshake = 0x01;
+static constexpr uint8_t kPmkid = 0x02;
+static constexpr uint8_t kAnyCapture = kHandshake | kPmkid;
+
+inline uint64_t bssidKey(const uint8_t* bssid) {
+    uint64_t k = 0;
+    for (int i = 0; i < 6; i++) k = (k << 8) | bssid[i];
+    return k;
+}
+
+inline uint64_t makeRecord(uint64_t key, uint8_t types) {
+    return ((key & kKeyMask) << 8) | types;
+}
+
+inline uint64_t recordKey(uint64_t rec) { return rec >> 8; }
+inline uint8_t recordTypes(uint64_t rec) { return (uint8_t)rec; }
+
+/**
+ * @brief A record is usable if it carries a known type and nothing else
+ */
+inline bool validRecord(uint64_t rec) {
+    uint8_t t = recordTypes(rec);
+    return t != 0 && (t & ~kAnyCapture) == 0;
+}
+
+inline void putRecord(uint8_t* p, uint64_t rec) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(rec >> (8 * i));
+}
+
+inline uint64_t getRecord(const uint8_t* p) {
+    uint64_t rec = 0;
+    for (int i = 7; i >= 0; i--) rec = (rec << 8) | p[i];
+    return rec;
+}
+
+inline void encodeHeader(uint8_t* out, uint32_t count) {
+    const uint32_t magic = kMagic;
+    for (int i = 0; i < 4; i++) out[i] = (uint8_t)(magic >> (8 * i));
+    out[4] = (uint8_t)kVersion;
+    out[5] = (uint8_t)(kVersion >> 8);
+    out[6] = (uint8_t)kRecordSize;
+    out[7] = 0;
+    for (int i = 0; i < 4; i++) out[8 + i] = (uint8_t)(count >> (8 * i));
+    uint32_t crc = Crc32::compute(out, 12);
+    for (int i = 0; i < 4; i++) out[12 + i] = (uint8_t)(crc >> (8 * i));
+}
+
+/**
+ * @brief Validate a header and read its record count
+ * @return false for a foreign, newer or damaged file (caller rebuilds)
+ */
+inline bool decodeHeader(const uint8_t* in, uint32_t& count) {
+    uint32_t magic = 0, crc = 0;
+    count = 0;
+    for (int i = 3; i >= 0; i--) {
+        magic = (magic << 8) | in[i];
+        count = (count << 8) | in[8 + i];
+        crc = (crc << 8) | in[12 + i];
+    }
+    if (magic != kMagic || crc != Crc32::compute(in, 12)) return false;
+    uint16_t version = (uint16_t)(in[4] | (in[5] << 8));
+    uint16_t recSize = (uint16_t)(in[6] | (in[7] << 8));
+    return version == kVersion && recSize == kRecordSize;
+}
+
+/**
+ * @brief Binary search n encoded records (sorted by key) for key
+ * @return Type mask of the match, 0 if absent
+ */
+inline uint8_t findInRun(const uint8_t* recs, uint32_t n, uint64_t key) {
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint64_t rec = getRecord(recs + mid * kRecordSize);
+        uint64_t k = recordKey(rec);
+        if (k == key) return recordTypes(rec);
+        if (k < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return 0;
+}
+
+/**
+ * @brief Page-by-page binary search of a sorted file of count records
+ * @param readPage bool(uint32_t page, const uint8_t*& recs, uint32_t& n):
+ *        loads page (kPageRecords records, the last may be short)
+ * @return Type mask of the match, 0 if absent or a read failed
+ */
+template <typename ReadPage>
+inline uint8_t searchPaged(uint32_t count, uint64_t key, ReadPage&& readPage) {
+    if (count == 0) return 0;
+    uint32_t lo = 0, hi = (count + kPageRecords - 1) / kPageRecords;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const uint8_t* recs = nullptr;
+        uint32_t n = 0;
+        if (!readPage(mid, recs, n) || n == 0) return 0;
+        if (key < recordKey(getRecord(recs))) {
+            hi = mid;
+        } else if (key > recordKey(getRecord(recs + (n - 1) * kRecordSize))) {
+            lo = mid + 1;
+        } else {
+            return findInRun(recs, n, key);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Sorted in-RAM set of records not yet merged into the file.
+ * Adding a BSSID already present ORs the type into its record.
+ */
+template <uint16_t kSlots>
+class Delta {
+public:
+    enum class Add : uint8_t { Added, Merged, Unchanged, Full };
+
+    void clear() { count = 0; }
+    uint16_t size() const { return count; }
+    bool full() const { return count >= kSlots; }
+    uint64_t at(uint16_t i) const { return recs[i]; }
+
+    uint8_t find(uint64_t key) const {
+        uint16_t i = lowerBound(key);
+        return (i < count && recordKey(recs[i]) == key) ? recordTypes(recs[i]) : 0;
+    }
+
+    Add add(uint64_t key, uint8_t types) {
+        uint16_t i = lowerBound(key);
+        if (i < count && recordKey(recs[i]) == key) {
+            uint8_t merged = recordTypes(recs[i]) | types;
+            if (merged == recordTypes(recs[i])) return Add::Unchanged;
+            recs[i] = makeRecord(key, merged);
+            return Add::Merged;
+        }
+        if (count >= kSlots) return Add::Full;
+        memmove(&recs[i + 1], &recs[i], sizeof(uint64_t) * (count - i));
+        recs[i] = makeRecord(key, types);
+        count++;
+        return Add::Added;
+    }
+
+private:
+    uint16_t lowerBound(uint64_t key) const {
+        uint16_t lo = 0, hi = count;
+        while (lo < hi) {
+            uint16_t mid = (uint16_t)((lo + hi) / 2);
+            if (recordKey(recs[mid]) < key) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    uint64_t recs[kSlots];
+    uint16_t count = 0;
+};
+
+/**
+ * In-RAM Bloom filter over every indexed BSSID, so the common "never
+ * captured" answer costs no SD read. Filled from the merge stream and
+ * from add(); a hit still goes to the file, so false positives only cost
+ * the lookup they would have cost anyway. No deletes (clear() empties).
+ */
+template <uint16_t kBytes>
+class KeyFilter {
+    static_assert(kBytes >= 64 && (kBytes & (kBytes - 1)) == 0,
+                  "KeyFilter size must be a power of two");
+
+public:
+    static constexpr uint8_t kHashes = 3;
+
+    KeyFilter() { clear(); }
+
+    void clear() {
+        memset(bits, 0, sizeof(bits));
+        keys = 0;
+    }
+
+    void add(uint64_t key) {
+        uint64_t h = mix(key);
+        for (uint8_t i = 0; i < kHashes; i++) {
+            uint32_t b = bitFor(h, i);
+            bits[b >> 3] |= (uint8_t)(1u << (b & 7));
+        }
+        keys++;
+    }
+
+    bool mayContain(uint64_t key) const {
+        uint64_t h = mix(key);
+        for (uint8_t i = 0; i < kHashes; i++) {
+            uint32_t b = bitFor(h, i);
+            if (!(bits[b >> 3] & (1u << (b & 7)))) return false;
+        }
+        return true;
+    }
+
+    uint32_t size() const { return keys; }  // Adds (duplicates counted)
+
+private:
+    static constexpr uint32_t kBitMask = (uint32_t)kBytes * 8 - 1;
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // Double hashing: bit i = h1 + i * h2
+    static uint32_t bitFor(uint64_t h, uint8_t i) {
+        return ((uint32_t)h + i * ((uint32_t)(h >> 32) | 1u)) & kBitMask;
+    }
+
+    uint8_t bits[kBytes];
+    uint32_t keys = 0;
+};
+
+/**
+ * @brief Merge a sorted record stream with a delta into a sorted stream
+ * Records with the same BSSID are combined (type masks ORed).
+ * @param next bool(uint64_t& rec): next record of the file, false at end
+ * @param put bool(uint64_t rec): emit one merged record, false to abort
+ * @return Records emitted, or -1 if put() failed
+ */
+template <uint16_t kSlots, typename Next, typename Put>
+inline int32_t mergeSorted(const Delta<kSlots>& delta, Next&& next, Put&& put) {
+    int32_t written = 0;
+    uint16_t d = 0;
+    uint64_t rec = 0;
+    bool have = next(rec);
+    while (have || d < delta.size()) {
+        uint64_t out;
+        if (!have) {
+            out = delta.at(d++);
+        } else if (d >= delta.size() || recordKey(rec) < recordKey(delta.at(d))) {
+            out = rec;
+            have = next(rec);
+        } else if (recordKey(rec) > recordKey(delta.at(d))) {
+            out = delta.at(d++);
+        } else {
+            out = rec | recordTypes(delta.at(d++));
+            have = next(rec);
+        }
+        if (!put(out)) return -1;
+        written++;
+    }
+    return written;
+}
+
+/**
+ * @brief Recognize a loot file name: SSID_AABBCCDDEEFF.22000 (PMKID),
+ * SSID_AABBCCDDEEFF_hs.22000 or SSID_AABBCCDDEEFF.pcap (handshake)
+ * @return false for anything else (logs, companions, exports)
+ */
+inline bool parseLootName(const char* name, uint8_t bssid[6], uint8_t& type) {
+    size_t len = strlen(name);
+    size_t suffix;
+    if (len > 9 && strcmp(name + len - 9, "_hs.22000") == 0) {
+        suffix = 9;
+        type = kHandshake;
+    } else if (len > 6 && strcmp(name + len - 6, ".22000") == 0) {
+        suffix = 6;
+        type = kPmkid;
+    } else if (len > 5 && strcmp(name + len - 5, ".pcap") == 0) {
+        suffix = 5;
+        type = kHandshake;
+    } else {
+        return false;
+    }
+    if (len < suffix + 13) return false;
+    const char* hex = name + len - suffix - 12;
+    if (hex[-1] != '_') return false;
+    for (int i = 0; i < 6; i++) {
+        uint8_t b = 0;
+        for (int j = 0; j < 2; j++) {
+            char c = hex[i * 2 + j];
+            uint8_t v;
+            if (c >= '0' && c <= '9') v = (uint8_t)(c - '0');
+            else if (c >= 'A' && c <= 'F') v = (uint8_t)(c - 'A' + 10);
+            else if (c >= 'a' && c <= 'f') v = (uint8_t)(c - 'a' + 10);
+            else return false;
+            b = (uint8_t)((b << 4) | v);
+        }
+        bssid[i] = b;
+    }
+    return true;
+}
+
+}  // namespace CapturedIndexFormat
@@ -4,6 +4,7 @@
 #include "config.h"
 #include "sdlog.h"
 #include "sd_layout.h"
+#include "captured_index.h"
 #include <M5Cardputer.h>
 #include <SD.h>
 #include <SPIFFS.h>
@@ -39,7 +40,7 @@ static bool sdAvailable = false;
 
 // ---- Binary config blob (zero heap allocation) ----
 static constexpr uint32_t CONFIG_MAGIC   = 0x504F524B;  // 'PORK'
-static constexpr uint16_t CONFIG_VERSION = 1;
+static constexpr uint16_t CONFIG_VERSION = 2;
 #define CONFIG_BIN_FILE "/porkchop.dat"
 
 static const char* configBinPathSD() {
@@ -96,6 +97,9 @@ struct __attribute__((packed)) ConfigBlob {
     float    mlVulnScorerThreshold;
     uint8_t  mlAutoUpdate;
     char     mlUpdateUrl[128];
+
+    // v2
+    uint8_t  gpsPassiveScan;
 };
 
 static void populateBlob(ConfigBlob& b, const GPSConfig& gps, const WiFiConfig& wifi,
@@ -144,6 +148,8 @@ static void populateBlob(ConfigBlob& b, const GPSConfig& gps, const WiFiConfig&
     b.mlVulnScorerThreshold  = ml.vulnScorerThreshold;
     b.mlAutoUpdate           = ml.autoUpdate ? 1 : 0;
     strncpy(b.mlUpdateUrl, ml.updateUrl, sizeof(b.mlUpdateUrl) - 1);
+
+    b.gpsPassiveScan = gps.passiveScan ? 1 : 0;
 }
 
 static bool writeBlobTo(fs::FS& fs, const char* path, const ConfigBlob& b) {
@@ -231,6 +237,9 @@ static void extractBlob(const ConfigBlob& b, GPSConfig& gps, WiFiConfig& wifi,
     ml.autoUpdate           = b.mlAutoUpdate != 0;
     strncpy(ml.updateUrl, b.mlUpdateUrl, sizeof(ml.updateUrl) - 1);
     ml.updateUrl[sizeof(ml.updateUrl) - 1] = '\0';
+
+    // v1 blobs end before this field (zero-filled on read): keep the default
+    gps.passiveScan = (b.version >= 2) ? (b.gpsPassiveScan != 0) : true;
 }
 
 static uint16_t clampU16(uint32_t value, uint16_t minVal, uint16_t maxVal) {
@@ -322,6 +331,7 @@ bool Config::init() {
         SDLayout::migrateIfNeeded();
         SDLayout::ensureDirs();
         SDLog::log("CFG", "SD card mounted OK");
+        CapturedIndex::begin();
     }
 
     // Load personality from SPIFFS (always available)
@@ -461,6 +471,7 @@ bool Config::reinitSD() {
         }
         SDLayout::ensureDirs();
         SDLog::log("CFG", "SD card re-initialized OK");
+        CapturedIndex::begin();
     } else {
         // FAIL: Restore previous state — don't corrupt flags
         sdAvailable = wasSdAvailable;
@@ -516,6 +527,7 @@ bool Config::applyJson(const JsonDocument& doc) {
         gpsConfig.sleepTimeMs = doc["gps"]["sleepTimeMs"] | 5000;
         gpsConfig.powerSave = doc["gps"]["powerSave"] | true;
         gpsConfig.timezoneOffset = doc["gps"]["timezoneOffset"] | 0;
+        gpsConfig.passiveScan = doc["gps"]["passiveScan"] | true;
     }
 
     // ML config
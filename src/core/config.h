@@ -40,6 +40,7 @@ struct GPSConfig {
     uint16_t sleepTimeMs = 5000;        // Sleep duration when stationary
     bool powerSave = true;
     int8_t timezoneOffset = 0;          // Hours offset from UTC (-12 to +14)
+    bool passiveScan = true;            // WARHOG: log NetworkRecon beacons instead of active scans
 };
 
 // ML data collection mode
@@ -0,0 +1,205 @@
+// EapolArena - Fixed-chunk slab for captured EAPOL / 802.11 frames
+// CapturedHandshake used to embed data[512] + fullFrame[300] per message,
+// ~3.3KB per handshake even when only M1+M2 (~120 bytes each) were seen.
+// Frames now live here at their actual length: each is a chain of 64-byte
+// chunks (2-byte next link + 62 data bytes) taken from one preallocated
+// block, so a typical M1+M2 pair costs ~640 bytes.
+//
+// Every chunk is the same size and comes back to a free list, so frees and
+// rewrites over a long session never fragment the arena (or the heap - the
+// block itself is allocated once). Frames are not contiguous: read them
+// with copyOut() or forEachSpan().
+//
+// Not thread-safe; callers serialise store/release (see EapolStore).
+// Storage is caller-owned (attach()), like FrameRing.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+class EapolArena {
+public:
+    static constexpr uint16_t kChunkBytes = 64;
+    static constexpr uint16_t kChunkData = kChunkBytes - 2;
+    static constexpr uint16_t kNil = 0xFFFF;
+    static constexpr uint16_t kMaxChunks = 0xFFFE;
+
+    /**
+     * @brief Handle to one stored frame. len == 0 means empty, so a
+     * zero-initialised Ref (e.g. in CapturedHandshake hs = {0}) is valid.
+     */
+    struct Ref {
+        uint16_t head;
+        uint16_t len;
+
+        bool empty() const { return len == 0; }
+    };
+
+    /**
+     * @brief Attach caller-owned storage and mark every chunk free
+     * Existing Refs into previous storage become invalid.
+     */
+    void attach(uint8_t* storage, size_t bytes) {
+        buf = storage;
+        size_t n = storage ? bytes / kChunkBytes : 0;
+        total = (uint16_t)(n < kMaxChunks ? n : kMaxChunks);
+        reset();
+    }
+
+    /**
+     * @brief Free everything (all outstanding Refs become invalid)
+     */
+    void reset() {
+        for (uint16_t i = 0; i < total; i++) {
+            setNext(i, (uint16_t)(i + 1 < total ? i + 1 : kNil));
+        }
+        freeHead = total ? 0 : kNil;
+        freeCount = total;
+        lowWater = total;
+    }
+
+    bool attached() const { return buf != nullptr && total > 0; }
+
+    static uint16_t chunksFor(uint16_t len) {
+        return (uint16_t)((len + kChunkData - 1) / kChunkData);
+    }
+
+    /**
+     * @brief Store len bytes into ref, replacing whatever it held
+     * @return false if the arena is out of chunks (ref keeps its old frame)
+     */
+    bool store(Ref& ref, const uint8_t* data, uint16_t len) {
+        if (len == 0 || !data) {
+            release(ref);
+            return true;
+        }
+        uint16_t need = chunksFor(len);
+        uint32_t available = (uint32_t)freeCount + chunksFor(ref.len);
+        if (need > available) {
+            failedStores++;
+            return false;
+        }
+        release(ref);
+
+        uint16_t head = freeHead;
+        uint16_t c = head;
+        uint16_t off = 0;
+        for (uint16_t k = 0; k < need; k++) {
+            uint16_t take = (uint16_t)(len - off < kChunkData ? len - off : kChunkData);
+            memcpy(chunkData(c), data + off, take);
+            off += take;
+            if (k + 1 < need) c = next(c);
+        }
+        freeHead = next(c);
+        setNext(c, kNil);
+        freeCount -= need;
+        if (freeCount < lowWater) lowWater = freeCount;
+
+        ref.head = head;
+        ref.len = len;
+        return true;
+    }
+
+    /**
+     * @brief Store two frames all-or-nothing (EAPOL payload + full frame)
+     * An empty (len 0) side is released. On failure both refs keep their
+     * old frames.
+     */
+    bool storePair(Ref& a, const uint8_t* dataA, uint16_t lenA,
+                   Ref& b, const uint8_t* dataB, uint16_t lenB) {
+        if (!dataA) lenA = 0;
+        if (!dataB) lenB = 0;
+        uint32_t need = (uint32_t)chunksFor(lenA) + chunksFor(lenB);
+        uint32_t available = (uint32_t)freeCount + chunksFor(a.len) + chunksFor(b.len);
+        if (need > available) {
+            failedStores++;
+            return false;
+        }
+        release(a);
+        release(b);
+        store(a, dataA, lenA);
+        store(b, dataB, lenB);
+        return true;
+    }
+
+    /**
+     * @brief Return a frame's chunks to the free list and empty the ref
+     */
+    void release(Ref& ref) {
+        if (ref.len == 0) return;
+        uint16_t n = chunksFor(ref.len);
+        uint16_t c = ref.head;
+        if (c >= total) {
+            ref.len = 0;
+            return;
+        }
+        for (uint16_t k = 1; k < n; k++) {
+            uint16_t nx = next(c);
+            if (nx >= total) break;
+            c = nx;
+        }
+        setNext(c, freeHead);
+        freeHead = ref.head;
+        freeCount += n;
+        ref.len = 0;
+    }
+
+    /**
+     * @brief Copy a frame into dst (truncated to cap)
+     * @return Bytes copied
+     */
+    uint16_t copyOut(const Ref& ref, uint8_t* dst, uint16_t cap) const {
+        uint16_t copied = 0;
+        forEachSpan(ref, [&](const uint8_t* p, uint16_t n) {
+            if (copied >= cap) return;
+            uint16_t take = (uint16_t)(cap - copied < n ? cap - copied : n);
+            memcpy(dst + copied, p, take);
+            copied += take;
+        });
+        return copied;
+    }
+
+    /**
+     * @brief Call fn(const uint8_t* bytes, uint16_t n) for each piece of a
+     * frame in order (for writing straight to a file without a copy)
+     */
+    template <typename Fn>
+    void forEachSpan(const Ref& ref, Fn fn) const {
+        uint16_t left = ref.len;
+        uint16_t c = ref.head;
+        while (left > 0 && c < total) {
+            uint16_t n = left < kChunkData ? left : kChunkData;
+            fn(chunkData(c), n);
+            left -= n;
+            c = next(c);
+        }
+    }
+
+    uint16_t totalChunks() const { return total; }
+    uint16_t freeChunks() const { return freeCount; }
+    uint16_t lowWaterChunks() const { return lowWater; }
+    uint32_t getFailedStores() const { return failedStores; }
+
+private:
+    uint8_t* buf = nullptr;
+    uint16_t total = 0;
+    uint16_t freeHead = kNil;
+    uint16_t freeCount = 0;
+    uint16_t lowWater = 0;
+    uint32_t failedStores = 0;
+
+    uint8_t* chunk(uint16_t i) const { return buf + (size_t)i * kChunkBytes; }
+    uint8_t* chunkData(uint16_t i) const { return chunk(i) + 2; }
+
+    uint16_t next(uint16_t i) const {
+        uint16_t v;
+        memcpy(&v, chunk(i), 2);
+        return v;
+    }
+
+    void setNext(uint16_t i, uint16_t v) {
+        memcpy(chunk(i), &v, 2);
+    }
+};
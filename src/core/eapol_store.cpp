@@ -0,0 +1,79 @@
+// EapolStore - Shared EAPOL arena for captured handshakes
+
+#include "eapol_store.h"
+#include "heap_policy.h"
+#include <esp_heap_caps.h>
+
+namespace EapolStore {
+
+static EapolArena eapolArena;
+static uint8_t* arenaBlock = nullptr;
+
+bool begin(size_t preferredBytes) {
+    if (arenaBlock) return true;
+
+    size_t bytes = preferredBytes;
+    while (bytes >= HeapPolicy::kEapolArenaMinBytes) {
+        size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+        if (largest >= bytes + HeapPolicy::kReserveSlackLarge) {
+            arenaBlock = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+            if (arenaBlock) break;
+        }
+        bytes /= 2;
+    }
+    if (!arenaBlock) {
+        Serial.printf("[EAPOL] Arena alloc failed (largest=%u)\n",
+                      (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+        return false;
+    }
+
+    eapolArena.attach(arenaBlock, bytes);
+    Serial.printf("[EAPOL] Arena %u bytes (%u chunks)\n",
+                  (unsigned)bytes, (unsigned)eapolArena.totalChunks());
+    return true;
+}
+
+void end() {
+    if (!arenaBlock) return;
+    Serial.printf("[EAPOL] Arena freed (peak use %u/%u chunks, %u failed stores)\n",
+                  (unsigned)(eapolArena.totalChunks() - eapolArena.lowWaterChunks()),
+                  (unsigned)eapolArena.totalChunks(),
+                  (unsigned)eapolArena.getFailedStores());
+    eapolArena.attach(nullptr, 0);
+    heap_caps_free(arenaBlock);
+    arenaBlock = nullptr;
+}
+
+bool isReady() {
+    return arenaBlock != nullptr;
+}
+
+bool store(EapolArena::Ref& ref, const uint8_t* data, uint16_t len) {
+    if (!arenaBlock) return false;
+    return eapolArena.store(ref, data, len);
+}
+
+bool storePair(EapolArena::Ref& a, const uint8_t* dataA, uint16_t lenA,
+               EapolArena::Ref& b, const uint8_t* dataB, uint16_t lenB) {
+    if (!arenaBlock) return false;
+    return eapolArena.storePair(a, dataA, lenA, b, dataB, lenB);
+}
+
+void release(EapolArena::Ref& ref) {
+    if (!arenaBlock) {
+        ref.len = 0;
+        return;
+    }
+    eapolArena.release(ref);
+}
+
+uint16_t copy(const EapolArena::Ref& ref, uint8_t* dst, uint16_t cap) {
+    if (!arenaBlock || !dst) return 0;
+    return eapolArena.copyOut(ref, dst, cap);
+}
+
+const EapolArena& arena() {
+    return eapolArena;
+}
+
+}  // namespace EapolStore
@@ -0,0 +1,49 @@
+// EapolStore - Shared EAPOL arena for captured handshakes
+// Owns the one EapolArena block that OINK, DO NO HAM and PigSync store
+// CapturedHandshake frames in. Capture modes are exclusive: each begin()s
+// the store on start and end()s it on stop after clearing its handshakes.
+//
+// Thread safety: store()/release() mutate the free list - callers that can
+// race the packet callback must hold NetworkRecon::enterCritical() (OINK)
+// or only touch the store from the main loop (DO NO HAM, PigSync).
+#pragma once
+
+#include <Arduino.h>
+#include "eapol_arena.h"
+
+namespace EapolStore {
+    /**
+     * @brief Allocate the arena if it is not already (idempotent)
+     * Halves the size down to HeapPolicy::kEapolArenaMinBytes when the
+     * largest free block cannot fit preferredBytes.
+     * @return true if an arena is attached
+     */
+    bool begin(size_t preferredBytes);
+
+    /**
+     * @brief Free the arena block. Every outstanding Ref becomes invalid.
+     */
+    void end();
+
+    bool isReady();
+
+    /**
+     * @brief Copy len bytes in (replacing ref's old frame)
+     * @return false if not ready or out of chunks
+     */
+    bool store(EapolArena::Ref& ref, const uint8_t* data, uint16_t len);
+
+    /**
+     * @brief Store two frames all-or-nothing (see EapolArena::storePair)
+     */
+    bool storePair(EapolArena::Ref& a, const uint8_t* dataA, uint16_t lenA,
+                   EapolArena::Ref& b, const uint8_t* dataB, uint16_t lenB);
+    void release(EapolArena::Ref& ref);
+
+    /**
+     * @brief Copy a stored frame into dst (truncated to cap)
+     */
+    uint16_t copy(const EapolArena::Ref& ref, uint8_t* dst, uint16_t cap);
+
+    const EapolArena& arena();
+}
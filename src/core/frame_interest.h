@@ -0,0 +1,67 @@
+// FrameInterest - Which 802.11 frames a promiscuous consumer actually reads
+// NetworkRecon ORs its own mask with the active mode's and pushes the
+// result down: frame types go to the driver's promiscuous filter (so
+// unwanted control/data frames never raise a callback), and management
+// subtypes - which the driver cannot filter - are dropped in the WiFi
+// callback before they reach the RX ring.
+//
+// Bits 0-15: management subtype n. Bit 16: data frames. Bit 17: control
+// frames. Type numbers follow wifi_promiscuous_pkt_type_t (MGMT=0,
+// CTRL=1, DATA=2, MISC=3).
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstdint>
+
+namespace FrameInterest {
+
+static constexpr uint32_t mgmt(uint8_t subtype) {
+    return subtype < 16 ? (1u << subtype) : 0u;
+}
+
+static constexpr uint32_t kAssocReq = mgmt(0);
+static constexpr uint32_t kAssocResp = mgmt(1);
+static constexpr uint32_t kReassocReq = mgmt(2);
+static constexpr uint32_t kReassocResp = mgmt(3);
+static constexpr uint32_t kProbeReq = mgmt(4);
+static constexpr uint32_t kProbeResp = mgmt(5);
+static constexpr uint32_t kBeacon = mgmt(8);
+static constexpr uint32_t kDisassoc = mgmt(10);
+static constexpr uint32_t kAuth = mgmt(11);
+static constexpr uint32_t kDeauth = mgmt(12);
+static constexpr uint32_t kAction = mgmt(13);
+static constexpr uint32_t kMgmtAll = 0xFFFFu;
+
+static constexpr uint32_t kData = 1u << 16;
+static constexpr uint32_t kCtrl = 1u << 17;
+
+static constexpr uint32_t kAll = kMgmtAll | kData | kCtrl;
+
+// What NetworkRecon parses for itself (see dispatchPacket)
+static constexpr uint32_t kRecon = kBeacon | kProbeResp | kAssocReq | kReassocReq | kData;
+
+static constexpr uint8_t kTypeMgmt = 0;
+static constexpr uint8_t kTypeCtrl = 1;
+static constexpr uint8_t kTypeData = 2;
+
+static inline bool wantsMgmt(uint32_t interest) { return (interest & kMgmtAll) != 0; }
+static inline bool wantsData(uint32_t interest) { return (interest & kData) != 0; }
+static inline bool wantsCtrl(uint32_t interest) { return (interest & kCtrl) != 0; }
+
+/**
+ * @brief Software half of the filter: does this frame pass?
+ * @param type wifi_promiscuous_pkt_type_t value
+ * @param fc0 First frame-control byte (subtype in the high nibble)
+ * Types the driver filter already passed are accepted as-is; only
+ * management subtypes are checked here.
+ */
+static inline bool accepts(uint32_t interest, uint8_t type, uint8_t fc0) {
+    switch (type) {
+        case kTypeMgmt: return (interest & mgmt((uint8_t)(fc0 >> 4))) != 0;
+        case kTypeData: return wantsData(interest);
+        case kTypeCtrl: return wantsCtrl(interest);
+        default: return true;
+    }
+}
+
+} // namespace FrameInterest
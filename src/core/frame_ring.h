@@ -0,0 +1,173 @@
+// FrameRing - Lock-free SPSC ring of variable-length frame records
+// Producer: WiFi driver promiscuous callback (copy and return).
+// Consumer: NetworkRecon worker task (parse + mode dispatch).
+//
+// Each record is stored contiguously (never split across the wrap) so the
+// consumer can hand a pointer straight to parsers without a second copy:
+//
+//   [u16 recLen][u8 type][u8 flags][header bytes][payload bytes][pad to 4]
+//
+// recLen == 0 is a wrap marker: the consumer jumps back to offset 0.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+class FrameRing {
+public:
+    static constexpr uint16_t kRecordHeader = 4;
+    static constexpr uint8_t kFlagTruncated = 0x01;
+
+    /**
+     * @brief Attach caller-owned storage (capacity rounded down to 4 bytes)
+     * Not thread-safe - call before either side starts.
+     */
+    void attach(uint8_t* storage, uint32_t capacity) {
+        buf = storage;
+        cap = capacity & ~3u;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        resetStats();
+    }
+
+    bool attached() const { return buf != nullptr && cap >= 64; }
+    uint32_t capacity() const { return cap; }
+
+    /**
+     * @brief Producer: copy one record in
+     * @param wasEmpty Set true if the consumer may be idle (worth a wakeup)
+     * @return false if there was no room (counted as a drop)
+     */
+    bool push(uint8_t type, uint8_t flags,
+              const void* hdr, uint16_t hdrLen,
+              const uint8_t* payload, uint16_t payloadLen,
+              bool* wasEmpty = nullptr) {
+        uint32_t need = ((uint32_t)kRecordHeader + hdrLen + payloadLen + 3u) & ~3u;
+        uint32_t w = head.load(std::memory_order_relaxed);
+        uint32_t r = tail.load(std::memory_order_acquire);
+        if (wasEmpty) *wasEmpty = (w == r);
+        if (!buf || need > 0xFFFFu) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint32_t at;
+        if (w >= r) {
+            // Free: [w, cap) and [0, r) - one byte kept empty so full != empty
+            if (cap - w > need || (cap - w == need && r != 0)) {
+                at = w;
+            } else if (need < r) {
+                writeLen(w, 0);  // Wrap marker (always fits: w < cap, 4-aligned)
+                at = 0;
+            } else {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } else {
+            if (r - w > need) {
+                at = w;
+            } else {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        uint8_t* rec = buf + at;
+        writeLen(at, (uint16_t)need);
+        rec[2] = type;
+        rec[3] = flags;
+        if (hdrLen) memcpy(rec + kRecordHeader, hdr, hdrLen);
+        if (payloadLen) memcpy(rec + kRecordHeader + hdrLen, payload, payloadLen);
+
+        uint32_t next = at + need;
+        if (next == cap) next = 0;
+        head.store(next, std::memory_order_release);
+
+        pushed.fetch_add(1, std::memory_order_relaxed);
+        uint32_t used = usedBetween(next, r);
+        if (used > highWater.load(std::memory_order_relaxed)) {
+            highWater.store(used, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Consumer: look at the oldest record without removing it
+     * @param bodyLen Bytes after the 4-byte record header (includes padding)
+     * @return Pointer to the record body (4-byte aligned), or nullptr if empty
+     */
+    const uint8_t* peek(uint16_t& bodyLen, uint8_t& type, uint8_t& flags) {
+        uint32_t r = tail.load(std::memory_order_relaxed);
+        uint32_t w = head.load(std::memory_order_acquire);
+        if (r == w) return nullptr;
+        uint16_t recLen = readLen(r);
+        if (recLen == 0) {
+            // Wrap marker - producer continued at offset 0
+            r = 0;
+            tail.store(0, std::memory_order_release);
+            if (r == w) return nullptr;
+            recLen = readLen(r);
+        }
+        bodyLen = recLen - kRecordHeader;
+        type = buf[r + 2];
+        flags = buf[r + 3];
+        return buf + r + kRecordHeader;
+    }
+
+    /**
+     * @brief Consumer: release the record returned by peek()
+     */
+    void pop() {
+        uint32_t r = tail.load(std::memory_order_relaxed);
+        uint32_t next = r + readLen(r);
+        if (next == cap) next = 0;
+        tail.store(next, std::memory_order_release);
+        popped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    uint32_t usedBytes() const {
+        return usedBetween(head.load(std::memory_order_acquire),
+                           tail.load(std::memory_order_acquire));
+    }
+
+    uint32_t getPushed() const { return pushed.load(std::memory_order_relaxed); }
+    uint32_t getPopped() const { return popped.load(std::memory_order_relaxed); }
+    uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    uint32_t getHighWater() const { return highWater.load(std::memory_order_relaxed); }
+
+    void resetStats() {
+        pushed.store(0, std::memory_order_relaxed);
+        popped.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        highWater.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    uint8_t* buf = nullptr;
+    uint32_t cap = 0;
+    std::atomic<uint32_t> head{0};   // Producer-owned
+    std::atomic<uint32_t> tail{0};   // Consumer-owned
+    std::atomic<uint32_t> pushed{0};
+    std::atomic<uint32_t> popped{0};
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint32_t> highWater{0};
+
+    uint32_t usedBetween(uint32_t w, uint32_t r) const {
+        return (w >= r) ? (w - r) : (cap - r + w);
+    }
+
+    void writeLen(uint32_t at, uint16_t len) {
+        buf[at] = (uint8_t)(len & 0xFF);
+        buf[at + 1] = (uint8_t)(len >> 8);
+    }
+
+    uint16_t readLen(uint32_t at) const {
+        return (uint16_t)(buf[at] | (buf[at + 1] << 8));
+    }
+};
@@ -0,0 +1,285 @@
+// GzipStream - Bounded-memory streaming gzip (DEFLATE, fixed Huffman)
+// Compresses WiGLE CSV on its way to an upload. miniz's tdefl needs a
+// ~160KB state for its 32KB window; this keeps a small power-of-two
+// window in a caller-owned block (see stateBytes) and nothing else.
+//
+// Greedy LZ77: one hash-head probe per position (4-byte hash, no chains),
+// matches of 4..258 bytes up to one window back, then the fixed Huffman
+// code of RFC 1951 so there are no tables to build or send. WiGLE lines
+// repeat most of their bytes within a few lines (timestamps, auth
+// strings, coordinate prefixes, ",,,WIFI\r\n"), so a 4KB window already
+// gets close to 3x; see test_gzip_stream for measured ratios.
+//
+// Output is deterministic for a given window size. The stream is one
+// open fixed block closed by an empty final block, then CRC-32 (crc32.h)
+// and length - a standard .gz any gunzip / WiGLE accepts.
+//
+// Sinks are callables bool(const uint8_t*, size_t); a false return
+// fails the stream. Header-only and Arduino-free so the native test suite
+// can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "crc32.h"
+
+class GzipStream {
+public:
+    static constexpr size_t kMinWindow = 1024;
+    static constexpr size_t kMaxWindow = 16384;     // Buffer offsets fit uint16_t
+    static constexpr size_t kMinMatch = 4;
+    static constexpr size_t kMaxMatch = 258;
+    static constexpr size_t kOutBytes = 256;
+
+    /**
+     * @brief Block size for a window: 2x window of input + window/2 hash heads
+     */
+    static constexpr size_t stateBytes(size_t window) {
+        return 2 * window + (window / 2) * sizeof(uint16_t);
+    }
+
+    /**
+     * @brief Bind caller-owned state, using the largest window that fits
+     * @return false if bytes cannot hold the minimum window
+     */
+    bool attach(uint8_t* storage, size_t bytes) {
+        window = 0;
+        if (!storage) return false;
+        for (size_t w = kMaxWindow; w >= kMinWindow; w /= 2) {
+            if (stateBytes(w) <= bytes) {
+                window = w;
+                break;
+            }
+        }
+        if (window == 0) return false;
+        buf = storage;
+        head = (uint16_t*)(storage + 2 * window);
+        hashMask = (uint32_t)(window / 2 - 1);
+        return true;
+    }
+
+    size_t getWindow() const { return window; }
+
+    /**
+     * @brief Start a new .gz stream (header is emitted with the first write)
+     */
+    void begin() {
+        if (window) memset(head, 0, (window / 2) * sizeof(uint16_t));
+        pos = 0;
+        end = 0;
+        bitBuf = 0;
+        bitCount = 0;
+        outLen = 0;
+        crc = 0;
+        totalIn = 0;
+        totalOut = 0;
+        started = false;
+        failed = (window == 0);
+    }
+
+    /**
+     * @brief Feed uncompressed bytes; compressed output goes to sink
+     */
+    template <typename Sink>
+    bool write(const uint8_t* data, size_t len, Sink& sink) {
+        if (failed) return false;
+        if (!started) start();
+        crc = Crc32::update(crc, data, len);
+        totalIn += len;
+
+        while (len > 0 && !failed) {
+            size_t room = 2 * window - end;
+            size_t n = len < room ? len : room;
+            memcpy(buf + end, data, n);
+            end += n;
+            data += n;
+            len -= n;
+            if (end == 2 * window) {
+                compress(false, sink);
+                slide();
+            }
+        }
+        return !failed;
+    }
+
+    /**
+     * @brief Compress what is left and write the gzip trailer
+     */
+    template <typename Sink>
+    bool finish(Sink& sink) {
+        if (failed) return false;
+        if (!started) start();
+        compress(true, sink);
+        putCode(0, 7);                 // End of the open block (symbol 256)
+        putBits(1, 1);                 // BFINAL
+        putBits(1, 2);                 // BTYPE = fixed Huffman
+        putCode(0, 7);                 // Empty: end of block
+        if (bitCount > 0) putBits(0, 8 - bitCount);
+        for (int i = 0; i < 4; i++) queueByte((uint8_t)(crc >> (8 * i)));
+        for (int i = 0; i < 4; i++) queueByte((uint8_t)(totalIn >> (8 * i)));
+        flushOut(sink);
+        return !failed;
+    }
+
+    bool hasFailed() const { return failed; }
+    uint32_t bytesIn() const { return totalIn; }
+    uint32_t bytesOut() const { return totalOut; }
+
+private:
+    uint8_t* buf = nullptr;
+    uint16_t* head = nullptr;          // Hash -> buffer offset + 1 (0 = empty)
+    size_t window = 0;
+    uint32_t hashMask = 0;
+    size_t pos = 0;                    // Next byte to encode
+    size_t end = 0;                    // Bytes buffered
+    uint32_t bitBuf = 0;
+    uint8_t bitCount = 0;
+    uint8_t out[kOutBytes];
+    size_t outLen = 0;
+    uint32_t crc = 0;
+    uint32_t totalIn = 0;
+    uint32_t totalOut = 0;
+    bool started = false;
+    bool failed = true;
+
+    static constexpr uint16_t kLengthBase[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    static constexpr uint8_t kLengthExtra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    static constexpr uint16_t kDistBase[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+        8193, 12289, 16385, 24577
+    };
+    static constexpr uint8_t kDistExtra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    void start() {
+        static const uint8_t kHeader[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+        for (uint8_t b : kHeader) queueByte(b);
+        putBits(0, 1);                 // BFINAL = 0: closed by finish()
+        putBits(1, 2);                 // BTYPE = fixed Huffman
+        started = true;
+    }
+
+    // Bits are packed LSB-first; whole bytes wait in out[] for the sink.
+    // compress() drains out[] before it can overflow (one match <= 4 bytes).
+    void putBits(uint32_t value, uint8_t n) {
+        bitBuf |= value << bitCount;
+        bitCount += n;
+        while (bitCount >= 8) {
+            queueByte((uint8_t)bitBuf);
+            bitBuf >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    // Huffman codes go out MSB-first
+    void putCode(uint32_t code, uint8_t n) {
+        uint32_t rev = 0;
+        for (uint8_t i = 0; i < n; i++) {
+            rev = (rev << 1) | (code & 1);
+            code >>= 1;
+        }
+        putBits(rev, n);
+    }
+
+    void putLiteral(uint16_t sym) {
+        if (sym < 144) putCode(0x30 + sym, 8);
+        else if (sym < 256) putCode(0x190 + (sym - 144), 9);
+        else if (sym < 280) putCode(sym - 256, 7);
+        else putCode(0xC0 + (sym - 280), 8);
+    }
+
+    void putMatch(size_t len, size_t dist) {
+        int l = 28;
+        while (kLengthBase[l] > len) l--;
+        putLiteral((uint16_t)(257 + l));
+        if (kLengthExtra[l]) putBits((uint32_t)(len - kLengthBase[l]), kLengthExtra[l]);
+
+        int d = 29;
+        while (kDistBase[d] > dist) d--;
+        putCode((uint32_t)d, 5);
+        if (kDistExtra[d]) putBits((uint32_t)(dist - kDistBase[d]), kDistExtra[d]);
+    }
+
+    void queueByte(uint8_t b) {
+        out[outLen++] = b;
+    }
+
+    template <typename Sink>
+    void flushOut(Sink& sink) {
+        if (outLen == 0) return;
+        if (!failed && !sink((const uint8_t*)out, outLen)) failed = true;
+        totalOut += (uint32_t)outLen;
+        outLen = 0;
+    }
+
+    uint32_t hashAt(size_t i) const {
+        uint32_t v;
+        memcpy(&v, buf + i, 4);
+        return ((v * 2654435761u) >> 16) & hashMask;
+    }
+
+    void insertHash(size_t i) {
+        head[hashAt(i)] = (uint16_t)(i + 1);
+    }
+
+    // Encode buffered input. Without flush, stop while a full-length match
+    // could still run past the data buffered so far.
+    template <typename Sink>
+    void compress(bool flush, Sink& sink) {
+        while (pos < end && !failed) {
+            size_t avail = end - pos;
+            if (!flush && avail < kMaxMatch) break;
+            if (outLen > kOutBytes - 8) flushOut(sink);
+
+            size_t bestLen = 0, bestDist = 0;
+            if (avail >= kMinMatch) {
+                uint32_t h = hashAt(pos);
+                size_t cand = head[h];
+                head[h] = (uint16_t)(pos + 1);
+                if (cand > 0 && pos - (cand - 1) <= window) {
+                    const uint8_t* a = buf + cand - 1;
+                    const uint8_t* b = buf + pos;
+                    size_t maxLen = avail < kMaxMatch ? avail : kMaxMatch;
+                    size_t n = 0;
+                    while (n < maxLen && a[n] == b[n]) n++;
+                    if (n >= kMinMatch) {
+                        bestLen = n;
+                        bestDist = pos - (cand - 1);
+                    }
+                }
+            }
+
+            if (bestLen) {
+                putMatch(bestLen, bestDist);
+                for (size_t i = 1; i < bestLen; i++) {
+                    if (pos + i + kMinMatch <= end) insertHash(pos + i);
+                }
+                pos += bestLen;
+            } else {
+                putLiteral(buf[pos]);
+                pos++;
+            }
+        }
+        flushOut(sink);
+    }
+
+    // Drop the older half of the buffer; heads that pointed there expire
+    void slide() {
+        memmove(buf, buf + window, window);
+        pos -= window;
+        end -= window;
+        for (size_t i = 0; i <= hashMask; i++) {
+            head[i] = head[i] > window ? (uint16_t)(head[i] - window) : 0;
+        }
+    }
+};
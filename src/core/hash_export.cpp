@@ -0,0 +1,382 @@
+// HashExport - Merge every 22000 capture into one deduplicated hash file
+
+#include "hash_export.h"
+#include "capture_journal.h"
+#include "config.h"
+#include "hc22000_dedupe.h"
+#include "hc22000_encoder.h"
+#include "heap_policy.h"
+#include "sd_layout.h"
+#include "sdlog.h"
+#include <SD.h>
+#include <esp_heap_caps.h>
+#include <vector>
+
+using Hc22000Dedupe::FingerprintSet;
+using Hc22000Dedupe::LineSplitter;
+
+namespace HashExport {
+
+static const size_t IO_CHUNK = 512;
+// Longest line our encoder writes, plus room for foreign tools' lines
+static const size_t LINE_BYTES = Hc22000Encoder::kMaxHandshakeLine + 64;
+
+// Buffered output, flushed in whole IO_CHUNK blocks
+struct OutBuffer {
+    File* file;
+    uint8_t* buf;
+    size_t used;
+    uint32_t total;
+    bool failed;
+
+    void flush() {
+        if (used == 0) return;
+        if (!failed && file->write(buf, used) != used) failed = true;
+        total += used;
+        used = 0;
+    }
+
+    void put(const char* data, size_t len) {
+        while (len > 0) {
+            size_t n = IO_CHUNK - used;
+            if (n > len) n = len;
+            memcpy(buf + used, data, n);
+            used += n;
+            data += n;
+            len -= n;
+            if (used == IO_CHUNK) flush();
+        }
+    }
+};
+
+struct PassState {
+    FingerprintSet* seen;
+    OutBuffer* out;
+    Stats* stats;
+    bool first;          // Count lines on the first pass only
+    uint64_t rangeLo;    // Key range handled by this pass: [lo, hi)
+    uint64_t rangeHi;
+};
+
+static void onLine(void* ctx, const char* line, size_t len) {
+    PassState& st = *static_cast<PassState*>(ctx);
+    uint64_t key;
+    if (!Hc22000Dedupe::lineKey(line, len, key)) {
+        // Blank lines are just separators, not worth reporting
+        if (st.first && len > 0) st.stats->skipped++;
+        return;
+    }
+    if (st.first) st.stats->lines++;
+    uint32_t range = Hc22000Dedupe::rangeOf(key);
+    if (range < st.rangeLo || range >= st.rangeHi) return;
+
+    FingerprintSet::Insert r = st.seen->insert(key);
+    if (r == FingerprintSet::Insert::Duplicate) {
+        st.stats->duplicates++;
+        return;
+    }
+    // Full means a range ran far over its share; keep the line (a possible
+    // duplicate beats a lost hash)
+    st.out->put(line, len);
+    st.out->put("\n", 1);
+    st.stats->written++;
+}
+
+static bool is22000(const char* name) {
+    size_t len = strlen(name);
+    return len > 6 && strcmp(name + len - 6, ".22000") == 0;
+}
+
+static const char* basenameOf(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+// A journaled 22000 capture, read in place
+struct RecordSlot {
+    uint16_t session;
+    uint32_t offset;
+};
+
+// The whole job lives here between step() calls
+struct Job {
+    State state = State::Idle;
+    const char* error = "";
+    Stats stats;
+    uint32_t maxLines = 0;       // Upper bound from file sizes
+    std::vector<char> names;     // NUL-separated basenames, listed once
+    size_t nextName = 0;         // Offset of the next file in this pass
+    std::vector<RecordSlot> records;  // Journal 22000 records, listed once
+    size_t nextRecord = 0;       // Read after the files in each pass
+    File journal;                // Journal of the last record read
+    uint16_t journalSession = CaptureJournal::kNoSession;
+    uint16_t fileInPass = 0;
+    uint8_t* block = nullptr;
+    FingerprintSet seen;
+    LineSplitter splitter;
+    char* chunk = nullptr;
+    File outFile;
+    OutBuffer out = {nullptr, nullptr, 0, 0, false};
+    PassState st = {nullptr, nullptr, nullptr, true, 0, 0};
+    char tmpPath[72];
+};
+
+static Job job;
+
+// One listing per job: names plus an upper bound on hash lines from sizes
+static bool listFiles(const char* dir) {
+    File d = SD.open(dir);
+    if (!d || !d.isDirectory()) {
+        if (d) d.close();
+        return false;
+    }
+    File entry = d.openNextFile();
+    while (entry) {
+        const char* name = basenameOf(entry.name());
+        if (!entry.isDirectory() && is22000(name) && job.stats.files < 0xFFFF) {
+            size_t size = entry.size();
+            job.maxLines += (uint32_t)((size + Hc22000Dedupe::kMinLineBytes - 1) / Hc22000Dedupe::kMinLineBytes);
+            job.names.insert(job.names.end(), name, name + strlen(name) + 1);
+            job.stats.files++;
+        }
+        entry.close();
+        entry = d.openNextFile();
+        yield();
+    }
+    d.close();
+    job.names.shrink_to_fit();
+    return true;
+}
+
+// Journal records from the header chain (payloads are checked when read)
+static void listRecords() {
+    CaptureJournal::forEachRecord([](const CaptureJournal::RecordRef& rec, void*) {
+        if (rec.hdr.type != (uint8_t)JournalFormat::RecordType::Handshake22000 &&
+            rec.hdr.type != (uint8_t)JournalFormat::RecordType::Pmkid22000) {
+            return true;
+        }
+        if (job.stats.files == 0xFFFF) return false;
+        job.maxLines += (rec.hdr.payloadLen + Hc22000Dedupe::kMinLineBytes - 1) / Hc22000Dedupe::kMinLineBytes;
+        job.records.push_back({rec.session, rec.offset});
+        job.stats.files++;
+        return true;
+    }, nullptr);
+    job.records.shrink_to_fit();
+}
+
+static void beginPass() {
+    // First pass sized from the upper bound, the rest from its count
+    uint32_t lines = job.st.first ? job.maxLines : job.stats.lines;
+    job.st.rangeHi = job.st.rangeLo + Hc22000Dedupe::passWidth(lines, job.seen.capacity());
+    if (job.st.rangeHi > Hc22000Dedupe::kKeySpace) job.st.rangeHi = Hc22000Dedupe::kKeySpace;
+    job.seen.clear();
+    job.nextName = 0;
+    job.nextRecord = 0;
+    job.fileInPass = 0;
+}
+
+static void releaseJob() {
+    if (job.outFile) job.outFile.close();
+    if (job.journal) job.journal.close();
+    job.journalSession = CaptureJournal::kNoSession;
+    if (job.block) heap_caps_free(job.block);
+    job.block = nullptr;
+    std::vector<char>().swap(job.names);
+    std::vector<RecordSlot>().swap(job.records);
+}
+
+static State fail(const char* why) {
+    releaseJob();
+    SD.remove(job.tmpPath);
+    job.error = why;
+    job.state = State::Failed;
+    SDLog::log("EXPORT", "Merge failed: %s (%s)", why, SDLayout::hashExportPath());
+    return job.state;
+}
+
+static State finish() {
+    job.out.flush();
+    bool ok = !job.out.failed;
+    job.stats.bytes = job.out.total;
+    releaseJob();
+
+    const char* finalPath = SDLayout::hashExportPath();
+    if (ok) {
+        SD.remove(finalPath);
+        ok = SD.rename(job.tmpPath, finalPath);
+    }
+    if (!ok) return fail("merge failed");
+
+    job.state = State::Done;
+    SDLog::log("EXPORT", "%s: %lu lines from %u files, %lu duplicates, %lu skipped, %u passes",
+               finalPath, (unsigned long)job.stats.written, (unsigned)job.stats.files,
+               (unsigned long)job.stats.duplicates, (unsigned long)job.stats.skipped,
+               (unsigned)job.stats.passes);
+    return job.state;
+}
+
+bool start() {
+    if (job.state == State::Running) return false;
+    job.state = State::Idle;
+    job.error = "";
+    job.stats = Stats();
+    job.maxLines = 0;
+    if (!Config::isSDAvailable()) {
+        job.error = "no SD card";
+        job.state = State::Failed;
+        return false;
+    }
+    snprintf(job.tmpPath, sizeof(job.tmpPath), "%s.tmp", SDLayout::hashExportPath());
+
+    bool listed = listFiles(SDLayout::handshakesDir());
+    listRecords();
+    if ((!listed && job.records.empty()) || job.stats.files == 0) {
+        releaseJob();
+        job.error = "no 22000 files";
+        job.state = State::Failed;
+        SDLog::log("EXPORT", "No 22000 files to merge");
+        return false;
+    }
+
+    // One block: fingerprint table, line buffer, read chunk, write chunk
+    const size_t ioBytes = LINE_BYTES + 2 * IO_CHUNK;
+    size_t tableBytes = HeapPolicy::kHashExportTableBytes;
+    while (tableBytes >= HeapPolicy::kHashExportTableMinBytes) {
+        size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+        if (largest >= tableBytes + ioBytes + HeapPolicy::kReserveSlackLarge) {
+            job.block = (uint8_t*)heap_caps_malloc(tableBytes + ioBytes, MALLOC_CAP_8BIT);
+            if (job.block) break;
+        }
+        tableBytes /= 2;
+    }
+    if (!job.block) {
+        SDLog::log("EXPORT", "Alloc failed (largest=%u)",
+                   (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+        fail("no heap");
+        return false;
+    }
+
+    job.seen = FingerprintSet();     // Fresh counters for this job
+    job.splitter = LineSplitter();
+    job.seen.attach((uint64_t*)job.block, (uint32_t)(tableBytes / sizeof(uint64_t)));
+    job.splitter.attach((char*)job.block + tableBytes, LINE_BYTES);
+    job.chunk = (char*)job.block + tableBytes + LINE_BYTES;
+
+    SD.remove(job.tmpPath);
+    job.outFile = SD.open(job.tmpPath, FILE_WRITE);
+    if (!job.outFile) {
+        fail("cannot create file");
+        return false;
+    }
+    job.out = {&job.outFile, (uint8_t*)job.chunk + IO_CHUNK, 0, 0, false};
+    job.st = {&job.seen, &job.out, &job.stats, true, 0, 0};
+    job.state = State::Running;
+    beginPass();
+    return true;
+}
+
+State step() {
+    if (job.state != State::Running) return job.state;
+
+    if (job.nextName >= job.names.size() && job.nextRecord >= job.records.size()) {
+        if (job.st.first) job.stats.skipped += job.splitter.overlong();
+        job.st.first = false;
+        job.st.rangeLo = job.st.rangeHi;
+        job.stats.passes++;
+        if (job.st.rangeLo >= Hc22000Dedupe::kKeySpace) return finish();
+        beginPass();
+        return job.state;
+    }
+
+    job.fileInPass++;
+    if (job.nextName < job.names.size()) {
+        const char* name = &job.names[job.nextName];
+        job.nextName += strlen(name) + 1;
+
+        char path[128];
+        snprintf(path, sizeof(path), "%s/%s", SDLayout::handshakesDir(), name);
+        File f = SD.open(path, FILE_READ);
+        if (!f) return job.state;  // Deleted since the listing
+        job.splitter.reset();
+        int n;
+        while ((n = f.read((uint8_t*)job.chunk, IO_CHUNK)) > 0) {
+            job.splitter.feed(job.chunk, (size_t)n, onLine, &job.st);
+        }
+        job.splitter.finish(onLine, &job.st);
+        f.close();
+    } else {
+        const RecordSlot& rec = job.records[job.nextRecord++];
+        if (rec.session != job.journalSession) {
+            // Records are listed journal by journal: one open per journal
+            if (job.journal) job.journal.close();
+            char path[64];
+            CaptureJournal::journalPath(rec.session, path, sizeof(path));
+            job.journal = SD.open(path, FILE_READ);
+            job.journalSession = rec.session;
+        }
+        JournalFormat::RecordHeader hdr;
+        if (!job.journal || !CaptureJournal::seekRecord(job.journal, rec.offset, hdr)) {
+            return job.state;  // Gone or damaged since the listing
+        }
+        job.splitter.reset();
+        uint32_t remaining = hdr.payloadLen;
+        while (remaining > 0) {
+            size_t want = remaining < IO_CHUNK ? remaining : IO_CHUNK;
+            int n = job.journal.read((uint8_t*)job.chunk, want);
+            if (n <= 0) break;
+            job.splitter.feed(job.chunk, (size_t)n, onLine, &job.st);
+            remaining -= (uint32_t)n;
+        }
+        job.splitter.finish(onLine, &job.st);
+    }
+    if (job.out.failed) return fail("write failed");
+    return job.state;
+}
+
+void cancel() {
+    if (job.state != State::Running) return;
+    releaseJob();
+    SD.remove(job.tmpPath);
+    job.state = State::Idle;
+    SDLog::log("EXPORT", "Merge cancelled");
+}
+
+State state() {
+    return job.state;
+}
+
+const Stats& stats() {
+    return job.stats;
+}
+
+uint8_t progress() {
+    if (job.state == State::Done) return 100;
+    if (job.state != State::Running || job.stats.files == 0) return 0;
+    uint64_t width = job.st.rangeHi - job.st.rangeLo;
+    uint64_t pos = job.st.rangeLo + width * job.fileInPass / job.stats.files;
+    uint64_t pct = pos * 100 / Hc22000Dedupe::kKeySpace;
+    return pct > 99 ? 99 : (uint8_t)pct;
+}
+
+const char* error() {
+    return job.error;
+}
+
+bool run(Stats& stats, ProgressFn progressFn) {
+    stats = Stats();
+    if (job.state == State::Running || !start()) {
+        if (job.state != State::Running) stats = job.stats;
+        return false;
+    }
+    uint8_t shown = 0xFF;
+    while (step() == State::Running) {
+        uint8_t pct = progress();
+        if (progressFn && pct != shown) progressFn(pct);
+        shown = pct;
+        yield();
+    }
+    stats = job.stats;
+    return job.state == State::Done;
+}
+
+}  // namespace HashExport
@@ -0,0 +1,76 @@
+// HashExport - Merge every 22000 capture into one deduplicated hash file
+// Streams each .22000 / _hs.22000 file in the handshakes directory, and
+// each 22000 record of the OINK session journals (read in place, see
+// CaptureJournal), through Hc22000Dedupe and writes the unique lines to
+// hashExportPath(), so a
+// download or crack upload is one sequential read instead of hundreds of
+// opens. Lines repeated across files or sessions (same type, MIC/PMKID,
+// AP and client) are written once; the first copy found wins.
+//
+// Memory is fixed (one heap block for the fingerprint table and I/O
+// buffers, plus the file name and record lists, freed when the job ends).
+// The handshakes directory and journals are listed once per job; large
+// collections take several read passes over those lists. start()/step()
+// run the merge one file or record per call so the web server keeps
+// answering while it works; run()
+// drives the same job to completion for the on-device menu.
+// Main loop only (SD access).
+#pragma once
+
+#include <Arduino.h>
+
+namespace HashExport {
+    struct Stats {
+        uint16_t files = 0;        // .22000 files and journal records read
+        uint16_t passes = 0;       // Read passes over the files
+        uint32_t lines = 0;        // Hash lines found
+        uint32_t written = 0;      // Unique lines written
+        uint32_t duplicates = 0;   // Lines dropped as duplicates
+        uint32_t skipped = 0;      // Non-hash or overlong lines
+        uint32_t bytes = 0;        // Output size
+    };
+
+    enum class State : uint8_t {
+        Idle,       // Never started, or cancelled
+        Running,    // step() has work left
+        Done,       // Merged file is at SDLayout::hashExportPath()
+        Failed      // See error()
+    };
+
+    /**
+     * @brief Reports progress while run() works (0-99)
+     */
+    typedef void (*ProgressFn)(uint8_t percent);
+
+    /**
+     * @brief List the 22000 files and open the merge job
+     * The file is written under a temporary name and renamed on success,
+     * so a previous export stays intact if this one fails.
+     * @return true if the job is running (false if one already is, or
+     * it failed to start: no 22000 files, no heap, no SD)
+     */
+    bool start();
+
+    /**
+     * @brief Merge the next file of the current pass (main loop)
+     * @return State after the step
+     */
+    State step();
+
+    /**
+     * @brief Abandon a running job and delete its temporary file
+     */
+    void cancel();
+
+    State state();
+    const Stats& stats();
+    uint8_t progress();        // 0-99 while running, 100 when done
+    const char* error();       // Reason for State::Failed, else ""
+
+    /**
+     * @brief Build the merged file at SDLayout::hashExportPath() now
+     * @return true if the merged file was written (false also when there
+     * are no 22000 files to merge, or a background job is running)
+     */
+    bool run(Stats& stats, ProgressFn progress = nullptr);
+}
@@ -0,0 +1,219 @@
+// Hc22000Dedupe - Bounded-memory duplicate filter for hashcat 22000 lines
+// Used by HashExport to merge every .22000 / _hs.22000 capture into one
+// file. Re-walking the same APs across sessions produces identical hash
+// lines in separate files; a line is a duplicate when its record key -
+// type, MIC / PMKID, AP MAC and client MAC - matches one already written.
+//
+// Each key is reduced to a 64-bit fingerprint (collision odds for 50k
+// lines are ~1e-10) stored in a caller-supplied open-addressing table, so
+// memory is fixed regardless of how many lines are merged. When there are
+// more lines than the table holds, the export runs several passes, each
+// taking only lines whose fingerprint falls in its slice of the key space
+// and clearing the table in between. Dedupe stays exact; the cost is one
+// extra sequential read of the captures per pass. The first slice is
+// sized from a file-size upper bound; it also counts the real lines, so
+// the remaining slices are sized from the exact total.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Hc22000Dedupe {
+
+// Shortest valid line: WPA*01 with an empty ESSID (71 chars + newline).
+// File size / this is an upper bound on a file's hash lines.
+static constexpr size_t kMinLineBytes = 72;
+
+inline int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Fold a fixed-width hex field into h (case-insensitive)
+ * @return false if the field is not exactly len hex digits followed by '*'
+ */
+inline bool foldHexField(const char*& p, const char* end, size_t len, uint64_t& h) {
+    if ((size_t)(end - p) < len + 1 || p[len] != '*') return false;
+    for (size_t i = 0; i < len; i++) {
+        int v = hexValue(p[i]);
+        if (v < 0) return false;
+        h = (h ^ (uint64_t)v) * 0x100000001B3ull;  // FNV-1a step
+    }
+    p += len + 1;
+    return true;
+}
+
+/**
+ * @brief Record key of a 22000 line: WPA*0T*HASH*MAC_AP*MAC_CLIENT*...
+ * @param key Non-zero 64-bit fingerprint of (type, MIC/PMKID, AP, client)
+ * @return false for anything that is not a WPA*01 / WPA*02 line
+ */
+inline bool lineKey(const char* line, size_t len, uint64_t& key) {
+    if (len < 7 || memcmp(line, "WPA*0", 5) != 0 || line[6] != '*') return false;
+    if (line[5] != '1' && line[5] != '2') return false;
+
+    const char* p = line + 7;
+    const char* end = line + len;
+    uint64_t h = 0xCBF29CE484222325ull ^ (uint64_t)line[5];
+    if (!foldHexField(p, end, 32, h)) return false;  // MIC / PMKID
+    if (!foldHexField(p, end, 12, h)) return false;  // MAC_AP
+    if (!foldHexField(p, end, 12, h)) return false;  // MAC_CLIENT
+
+    // Finalizer (splitmix64) so low bits index well and high bits slice
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    key = h ? h : 1;
+    return true;
+}
+
+// Passes cover consecutive ranges of the key's high 32 bits
+static constexpr uint64_t kKeySpace = 1ull << 32;
+
+inline uint32_t rangeOf(uint64_t key) {
+    return (uint32_t)(key >> 32);
+}
+
+/**
+ * @brief Width of the next pass's key range for a table of capacity keys
+ * Keys are uniform, so the range gets capacity/lines of the key space.
+ * A range can run a little over its share: plan for 7/8 of capacity.
+ * @param lines Hash lines in total (an upper bound before the first pass)
+ */
+inline uint64_t passWidth(uint32_t lines, uint32_t capacity) {
+    uint32_t perPass = capacity - capacity / 8;
+    if (lines <= perPass) return kKeySpace;
+    uint64_t width = kKeySpace * perPass / lines;
+    return width ? width : 1;
+}
+
+class FingerprintSet {
+public:
+    enum class Insert : uint8_t { Added, Duplicate, Full };
+
+    /**
+     * @brief Use storage for the table (slots rounded down to a power of two)
+     */
+    void attach(uint64_t* storage, uint32_t slots) {
+        table = storage;
+        mask = 0;
+        if (storage && slots >= 2) {
+            uint32_t n = 1;
+            while (n * 2 <= slots) n *= 2;
+            mask = n - 1;
+        }
+        clear();
+    }
+
+    void clear() {
+        if (table && mask) memset(table, 0, sizeof(uint64_t) * (mask + 1));
+        count = 0;
+    }
+
+    /**
+     * @brief Keys accepted before insert() reports Full (75% load)
+     */
+    uint32_t capacity() const { return mask ? (mask + 1) - (mask + 1) / 4 : 0; }
+    uint32_t size() const { return count; }
+
+    /**
+     * @brief Add a non-zero key
+     * @return Duplicate if already present, Full if the table is at capacity
+     */
+    Insert insert(uint64_t key) {
+        if (!mask) return Insert::Full;
+        uint32_t i = (uint32_t)key & mask;
+        while (table[i] != 0) {
+            if (table[i] == key) return Insert::Duplicate;
+            i = (i + 1) & mask;
+        }
+        if (count >= capacity()) return Insert::Full;
+        table[i] = key;
+        count++;
+        return Insert::Added;
+    }
+
+private:
+    uint64_t* table = nullptr;
+    uint32_t mask = 0;
+    uint32_t count = 0;
+};
+
+/**
+ * Splits streamed file chunks into lines in a caller-supplied buffer.
+ * Lines are delivered without '\n' / trailing '\r'. A line longer than the
+ * buffer is dropped whole (counted in overlong()) rather than cut, so a
+ * truncated hash never reaches the output.
+ */
+class LineSplitter {
+public:
+    typedef void (*LineFn)(void* ctx, const char* line, size_t len);
+
+    void attach(char* buffer, size_t cap) {
+        buf = buffer;
+        bufCap = cap;
+        reset();
+    }
+
+    /**
+     * @brief Start a new file (drops any unterminated tail)
+     */
+    void reset() {
+        used = 0;
+        discarding = false;
+    }
+
+    void feed(const char* data, size_t len, LineFn fn, void* ctx) {
+        while (len > 0) {
+            const char* nl = (const char*)memchr(data, '\n', len);
+            size_t n = nl ? (size_t)(nl - data) : len;
+            if (!discarding) {
+                if (used + n <= bufCap) {
+                    memcpy(buf + used, data, n);
+                    used += n;
+                } else {
+                    discarding = true;
+                    dropped++;
+                }
+            }
+            if (!nl) return;
+            if (!discarding) emit(fn, ctx);
+            used = 0;
+            discarding = false;
+            data += n + 1;
+            len -= n + 1;
+        }
+    }
+
+    /**
+     * @brief Deliver a final line that had no newline
+     */
+    void finish(LineFn fn, void* ctx) {
+        if (!discarding && used > 0) emit(fn, ctx);
+        reset();
+    }
+
+    uint32_t overlong() const { return dropped; }
+
+private:
+    void emit(LineFn fn, void* ctx) {
+        size_t n = used;
+        if (n > 0 && buf[n - 1] == '\r') n--;
+        fn(ctx, buf, n);
+    }
+
+    char* buf = nullptr;
+    size_t bufCap = 0;
+    size_t used = 0;
+    bool discarding = false;
+    uint32_t dropped = 0;
+};
+
+}  // namespace Hc22000Dedupe
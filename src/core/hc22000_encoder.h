@@ -0,0 +1,186 @@
+// Hc22000Encoder - Allocation-free hashcat 22000 (WPA*01 / WPA*02) lines
+// Used by OINK and DO NO HAM (and PigSync's received captures, which save
+// through OinkMode) for the .22000 / _hs.22000 files. Output matches
+// hcxpcapngtool: lowercase hex, no colons in MACs, hex ESSID, MIC zeroed
+// inside the EAPOL field.
+//
+// Each byte is emitted with one lookup in a 512-byte pair table instead of
+// a sprintf("%02x") call, and the line is built straight into a caller
+// buffer whose exact size is known up front (lineLength functions), so a
+// 2 x EAPOL line is one memcpy-like pass and one write() to the file.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Hc22000Encoder {
+
+static constexpr size_t kMaxSsidLen = 32;
+static constexpr size_t kMaxEapolLen = 512;
+
+// EAPOL-Key offsets (from the start of the 802.1X header)
+static constexpr size_t kNonceOffset = 17;   // 32-byte key nonce
+static constexpr size_t kMicOffset = 81;     // 16-byte key MIC
+static constexpr size_t kMicLen = 16;
+static constexpr size_t kMinNonceFrameLen = kNonceOffset + 32;
+static constexpr size_t kMinEapolLen = kMicOffset + kMicLen;
+
+// Fixed characters per line (everything except the ESSID / EAPOL hex)
+static constexpr size_t kPmkidFixedLen = 72;      // WPA*01*32*12*12*...***01\n
+static constexpr size_t kHandshakeFixedLen = 136; // WPA*02*32*12*12*...*64*...*02\n
+
+static constexpr size_t kMaxPmkidLine = kPmkidFixedLen + 2 * kMaxSsidLen;
+static constexpr size_t kMaxHandshakeLine = kHandshakeFixedLen + 2 * kMaxSsidLen + 2 * kMaxEapolLen;
+
+/**
+ * @brief 256 two-character lowercase hex pairs, indexed by byte * 2
+ */
+inline const char* hexPairs() {
+    static const char kPairs[513] =
+        "000102030405060708090a0b0c0d0e0f"
+        "101112131415161718191a1b1c1d1e1f"
+        "202122232425262728292a2b2c2d2e2f"
+        "303132333435363738393a3b3c3d3e3f"
+        "404142434445464748494a4b4c4d4e4f"
+        "505152535455565758595a5b5c5d5e5f"
+        "606162636465666768696a6b6c6d6e6f"
+        "707172737475767778797a7b7c7d7e7f"
+        "808182838485868788898a8b8c8d8e8f"
+        "909192939495969798999a9b9c9d9e9f"
+        "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+        "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+        "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+        "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+        "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+        "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+    return kPairs;
+}
+
+/**
+ * @brief Hex-encode len bytes at out (2 * len chars, no terminator)
+ * @return Pointer just past the last character written
+ */
+inline char* putHex(char* out, const uint8_t* data, size_t len) {
+    const char* pairs = hexPairs();
+    for (size_t i = 0; i < len; i++) {
+        const char* p = pairs + ((size_t)data[i] << 1);
+        out[0] = p[0];
+        out[1] = p[1];
+        out += 2;
+    }
+    return out;
+}
+
+inline char* putText(char* out, const char* text, size_t len) {
+    memcpy(out, text, len);
+    return out + len;
+}
+
+inline size_t clampSsidLen(size_t ssidLen) {
+    return ssidLen > kMaxSsidLen ? kMaxSsidLen : ssidLen;
+}
+
+/**
+ * @brief Exact WPA*01 line length, including the trailing newline
+ */
+inline size_t pmkidLineLength(size_t ssidLen) {
+    return kPmkidFixedLen + 2 * clampSsidLen(ssidLen);
+}
+
+/**
+ * @brief Exact WPA*02 line length, including the trailing newline
+ */
+inline size_t handshakeLineLength(size_t ssidLen, size_t eapolLen) {
+    return kHandshakeFixedLen + 2 * clampSsidLen(ssidLen) + 2 * eapolLen;
+}
+
+/**
+ * @brief Length of the EAPOL frame to hash: 802.1X body length + 4-byte
+ * header, capped to the bytes actually stored
+ */
+inline uint16_t eapolFrameLength(const uint8_t* eapol, size_t storedLen) {
+    if (storedLen < 4) return 0;
+    size_t len = (((size_t)eapol[2] << 8) | eapol[3]) + 4;
+    if (len > storedLen) len = storedLen;
+    return (uint16_t)len;
+}
+
+/**
+ * @brief Encode a PMKID line: WPA*01*PMKID*MAC_AP*MAC_CLIENT*ESSID***01
+ * Message pair 01 = PMKID taken from the AP (M1). ESSID beyond 32 bytes
+ * is truncated.
+ * @return Characters written (no terminator), or 0 if the PMKID is all
+ * zeros or cap is smaller than pmkidLineLength(ssidLen)
+ */
+inline size_t encodePmkid(char* out, size_t cap,
+                          const uint8_t* pmkid, const uint8_t* bssid, const uint8_t* station,
+                          const char* ssid, size_t ssidLen) {
+    ssidLen = clampSsidLen(ssidLen);
+    size_t need = pmkidLineLength(ssidLen);
+    if (!out || cap < need) return 0;
+
+    bool allZeros = true;
+    for (int i = 0; i < 16; i++) {
+        if (pmkid[i] != 0) { allZeros = false; break; }
+    }
+    if (allZeros) return 0;
+
+    char* p = out;
+    p = putText(p, "WPA*01*", 7);
+    p = putHex(p, pmkid, 16);
+    *p++ = '*';
+    p = putHex(p, bssid, 6);
+    *p++ = '*';
+    p = putHex(p, station, 6);
+    *p++ = '*';
+    p = putHex(p, (const uint8_t*)ssid, ssidLen);
+    p = putText(p, "***01\n", 6);
+    return (size_t)(p - out);
+}
+
+/**
+ * @brief Encode a handshake line:
+ * WPA*02*MIC*MAC_AP*MAC_CLIENT*ESSID*ANONCE*EAPOL*MESSAGEPAIR
+ * The MIC is read from eapol at kMicOffset and emitted as zeros inside the
+ * EAPOL field; eapol itself is not modified.
+ * @param anonce 32-byte AP nonce (from M1 or M3)
+ * @param eapol Client EAPOL frame (M2), eapolLen from eapolFrameLength()
+ * @return Characters written (no terminator), or 0 if eapolLen is outside
+ * [kMinEapolLen, kMaxEapolLen] or cap is too small
+ */
+inline size_t encodeHandshake(char* out, size_t cap,
+                              const uint8_t* bssid, const uint8_t* station,
+                              const char* ssid, size_t ssidLen,
+                              const uint8_t* anonce,
+                              const uint8_t* eapol, size_t eapolLen,
+                              uint8_t messagePair) {
+    if (eapolLen < kMinEapolLen || eapolLen > kMaxEapolLen) return 0;
+    ssidLen = clampSsidLen(ssidLen);
+    size_t need = handshakeLineLength(ssidLen, eapolLen);
+    if (!out || cap < need) return 0;
+
+    char* p = out;
+    p = putText(p, "WPA*02*", 7);
+    p = putHex(p, eapol + kMicOffset, kMicLen);
+    *p++ = '*';
+    p = putHex(p, bssid, 6);
+    *p++ = '*';
+    p = putHex(p, station, 6);
+    *p++ = '*';
+    p = putHex(p, (const uint8_t*)ssid, ssidLen);
+    *p++ = '*';
+    p = putHex(p, anonce, 32);
+    *p++ = '*';
+    p = putHex(p, eapol, kMicOffset);
+    memset(p, '0', 2 * kMicLen);
+    p += 2 * kMicLen;
+    p = putHex(p, eapol + kMinEapolLen, eapolLen - kMinEapolLen);
+    *p++ = '*';
+    p = putHex(p, &messagePair, 1);
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+}  // namespace Hc22000Encoder
@@ -29,6 +29,23 @@ namespace HeapPolicy {
     static constexpr size_t kPmkidAllocSlack = 256;
     static constexpr size_t kHandshakeAllocSlack = 1024;
 
+    // EAPOL arena (EapolStore): one block per capture session, halved down
+    // to the minimum when the heap cannot fit it. 16KB is what five inline
+    // 3.3KB handshakes used to take; it holds ~24 M1+M2 pairs.
+    static constexpr size_t kEapolArenaBytes = 16384;
+    static constexpr size_t kEapolArenaMinBytes = 4096;
+
+    // Hash export dedupe table (HashExport): 8-byte fingerprints, halved
+    // down to the minimum when the heap cannot fit it. 32KB dedupes ~2.7k
+    // lines per pass; more lines just take more passes.
+    static constexpr size_t kHashExportTableBytes = 32768;
+    static constexpr size_t kHashExportTableMinBytes = 4096;
+
+    // WiGLE upload compressor (GzipStream): a 4KB window, halved down to 1KB
+    // when the heap cannot fit it. Freed before the TLS connect.
+    static constexpr size_t kGzipStateBytes = 12288;
+    static constexpr size_t kGzipStateMinBytes = 3072;
+
     // Mode-specific thresholds
     static constexpr size_t kDnhInjectMinHeap = 80000;
     static constexpr size_t kPigSyncMinContig = 26000;
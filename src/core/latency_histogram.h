@@ -0,0 +1,71 @@
+// LatencyHistogram - Fixed-size log2 histogram of cycle-counter durations
+// 16 power-of-two buckets: bucket 0 holds [0, 16) cycles, bucket i holds
+// [2^(i+3), 2^(i+4)), and the last bucket takes everything from 2^18 up
+// (~1.1ms at 240MHz). Recording is a count-leading-zeros and two adds, so
+// it is cheap enough for the WiFi callback; percentiles are reported as the
+// upper edge of the bucket they fall in.
+//
+// Single writer per histogram; readers copy it and may see a sample that is
+// counted but not yet bucketed, which is fine for diagnostics.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+struct LatencyHistogram {
+    static constexpr uint8_t kBuckets = 16;
+
+    uint32_t buckets[kBuckets];
+    uint32_t count;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+
+    void reset() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    void record(uint32_t cycles) {
+        buckets[bucketOf(cycles)]++;
+        count++;
+        totalCycles += cycles;
+        if (cycles > maxCycles) maxCycles = cycles;
+    }
+
+    static uint8_t bucketOf(uint32_t cycles) {
+        if (cycles < 16) return 0;
+        int log2 = 31 - __builtin_clz(cycles);   // >= 4
+        int b = log2 - 3;
+        return (uint8_t)(b < kBuckets ? b : kBuckets - 1);
+    }
+
+    /**
+     * @brief Exclusive upper edge of a bucket in cycles (last bucket: max seen)
+     */
+    uint32_t bucketUpper(uint8_t b) const {
+        if (b >= kBuckets - 1) return maxCycles;
+        return 1u << (b + 4);
+    }
+
+    /**
+     * @brief Cycles below which pct percent of samples fall (bucket resolution)
+     */
+    uint32_t percentile(uint8_t pct) const {
+        if (count == 0) return 0;
+        uint64_t target = ((uint64_t)count * pct + 99) / 100;
+        if (target == 0) target = 1;
+        uint64_t seen = 0;
+        for (uint8_t b = 0; b < kBuckets; b++) {
+            seen += buckets[b];
+            if (seen >= target) {
+                uint32_t upper = bucketUpper(b);
+                return upper < maxCycles ? upper : maxCycles;
+            }
+        }
+        return maxCycles;
+    }
+
+    uint32_t meanCycles() const {
+        return count ? (uint32_t)(totalCycles / count) : 0;
+    }
+};
@@ -0,0 +1,133 @@
+// NetworkHot - Dense per-network record for NetworkRecon sweeps
+// DetectedNetwork (~96 bytes) stays the authoritative record the modes use.
+// NetworkRecon keeps a parallel array of these 20-byte projections, slot for
+// slot, holding only what the periodic sweeps read: BSSID, smoothed RSSI,
+// timestamps, and the retention-score contribution of everything else
+// (SSID, PMF, auth, beacon stability, handshake) folded into one byte.
+// Stale/eviction sweeps then walk 20 bytes per network instead of ~96.
+//
+// Templated on the network type so the native tests can project a
+// stand-in struct without pulling in oink.h / esp_wifi.h.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+struct NetworkHot {
+    uint8_t bssid[6];
+    int8_t rssi;             // rssiAvg, or raw rssi until the EMA has a sample
+    int8_t bias;             // Cold retention terms, or kBiasPinned
+    uint32_t lastSeen;
+    uint32_t lastDataSeen;   // 0 = no client data seen
+    uint32_t cooldownUntil;
+};
+
+static_assert(sizeof(NetworkHot) == 20, "NetworkHot should stay packed at 20 bytes");
+
+namespace ReconHot {
+
+// Current target - never evicted
+static constexpr int8_t kBiasPinned = -128;
+
+// Stale timeouts scale with signal: weak networks beacon less reliably
+static constexpr uint32_t kStaleStrongMs = 60000;
+static constexpr uint32_t kStaleMediumMs = 90000;
+static constexpr uint32_t kStaleWeakMs = 120000;
+
+static inline int8_t effectiveRssi(int8_t rssiAvg, int8_t rssi) {
+    return (rssiAvg != 0) ? rssiAvg : rssi;
+}
+
+static inline uint32_t staleTimeoutMs(int8_t rssi) {
+    if (rssi < -75) return kStaleWeakMs;
+    if (rssi < -50) return kStaleMediumMs;
+    return kStaleStrongMs;
+}
+
+static inline bool isStale(const NetworkHot& hot, uint32_t now) {
+    return now - hot.lastSeen > staleTimeoutMs(hot.rssi);
+}
+
+/**
+ * @brief Retention terms that only change when the record is written
+ * Beacon stability, handshake, PMF, open auth, missing SSID. Range -55..+10.
+ */
+template <typename Net>
+static inline int8_t coldBias(const Net& net) {
+    if (net.isTarget) return kBiasPinned;
+    int bias = 0;
+    if (net.beaconIntervalEmaMs > 0) {
+        if (net.beaconIntervalEmaMs <= 150) bias += 10;
+        else if (net.beaconIntervalEmaMs <= 500) bias += 6;
+        else if (net.beaconIntervalEmaMs <= 1000) bias += 3;
+    }
+    if (net.hasHandshake) bias -= 20;
+    if (net.hasPMF) bias -= 15;
+    if ((int)net.authmode == 0) bias -= 10;  // WIFI_AUTH_OPEN
+    if (net.ssid[0] == 0 || net.isHidden) bias -= 10;
+    return (int8_t)bias;
+}
+
+/**
+ * @brief Refresh a hot record from its full record
+ */
+template <typename Net>
+static inline void project(const Net& net, NetworkHot& out) {
+    memcpy(out.bssid, net.bssid, 6);
+    out.rssi = effectiveRssi(net.rssiAvg, net.rssi);
+    out.bias = coldBias(net);
+    out.lastSeen = net.lastSeen;
+    out.lastDataSeen = net.lastDataSeen;
+    out.cooldownUntil = net.cooldownUntil;
+}
+
+/**
+ * @brief Retention score (higher = keep)
+ * Pinned records score as if unpinned - callers skip them instead.
+ */
+static inline int retentionScore(const NetworkHot& hot, uint32_t now) {
+    int score = 0;
+
+    if (hot.rssi <= -95) score += 0;
+    else if (hot.rssi >= -30) score += 60;
+    else score += ((int)hot.rssi + 95) * 60 / 65;
+
+    uint32_t age = now - hot.lastSeen;
+    if (age <= 2000) score += 20;
+    else if (age <= 5000) score += 12;
+    else if (age <= 15000) score += 5;
+
+    if (hot.lastDataSeen > 0) {
+        uint32_t dataAge = now - hot.lastDataSeen;
+        if (dataAge <= 3000) score += 20;
+        else if (dataAge <= 10000) score += 10;
+        else if (dataAge <= 30000) score += 5;
+    }
+
+    if (hot.bias != kBiasPinned) score += hot.bias;
+    if (hot.cooldownUntil > now) score -= 10;
+
+    return score;
+}
+
+/**
+ * @brief Lowest-scoring unpinned record
+ * @return Index, or -1 if every record is pinned
+ */
+static inline int findWeakest(const NetworkHot* hot, size_t count, uint32_t now, int& worstScore) {
+    int worstIdx = -1;
+    worstScore = 100000;
+    for (size_t i = 0; i < count; i++) {
+        if (hot[i].bias == kBiasPinned) continue;
+        int score = retentionScore(hot[i], now);
+        if (score < worstScore) {
+            worstScore = score;
+            worstIdx = (int)i;
+        }
+    }
+    return worstIdx;
+}
+
+} // namespace ReconHot
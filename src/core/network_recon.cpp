@@ -8,11 +8,19 @@
 #include "wifi_utils.h"
 #include "heap_gates.h"
 #include "heap_policy.h"
+#include "bssid_index.h"
+#include "network_hot.h"
+#include "score_buckets.h"
+#include "beacon_summary.h"
+#include "frame_ring.h"
+#include "snapshot_buffer.h"
+#include "recon_metrics.h"
 #include <WiFi.h>
 #include <esp_wifi.h>
 #include <esp_heap_caps.h>
 #include <NimBLEDevice.h>
 #include <atomic>
+#include <cstddef>
 
 namespace NetworkRecon {
 
@@ -34,6 +42,11 @@ static uint32_t startTime = 0;
 static volatile uint32_t packetCount = 0;
 static std::atomic<bool> busy{false};  // [BUG3 FIX] Atomic for cross-core visibility
 static std::atomic<uint32_t> hopIntervalOverrideMs{0};
+static std::atomic<uint32_t> layoutVersion{0};  // Bumped when records move or leave slots
+static uint32_t cleanupPasses = 0;
+static uint32_t cleanupLastRemoved = 0;
+static uint32_t cleanupLastHoldCycles = 0;
+static uint32_t cleanupMaxHoldCycles = 0;
 static size_t heapLargestAtStart = 0;
 static bool heapStabilized = false;
 // shrinkDeferCount removed — shrink_to_fit no longer runs during operation
@@ -43,14 +56,24 @@ static const uint8_t CHANNEL_HOP_ORDER[RECON_CHANNEL_COUNT] = {
     1, 6, 11, 2, 3, 4, 5, 7, 8, 9, 10, 12, 13
 };
 
-// Stale network timeout (remove if not seen for this long)
-static const uint32_t STALE_TIMEOUT_MS = 60000;
+// Stale network timeouts (60s / 90s / 120s by RSSI) live in ReconHot
 
 // Cleanup interval
 static const uint32_t CLEANUP_INTERVAL_MS = 5000;
 
-// Client activity decay (clear bitset after inactivity)
-static const uint32_t CLIENT_BITMAP_RESET_MS = 30000;
+// Cap on records removed per cleanup pass (bounds time under vectorMux)
+static const uint8_t STALE_REMOVALS_PER_PASS = 50;
+
+// Eviction queue upkeep: slots re-keyed per update() (full table every
+// ~13 loops), and head re-checks per eviction before giving up
+static const uint8_t EVICTION_REFRESH_PER_UPDATE = 16;
+static const uint8_t EVICTION_VERIFY_ATTEMPTS = 4;
+
+// Snapshot publishing: cadence, records copied per lock hold, and the step
+// each half of the buffer grows by as the table fills
+static const uint32_t SNAPSHOT_PUBLISH_MS = 200;
+static const uint8_t SNAPSHOT_COPY_BATCH = 32;
+static const uint16_t SNAPSHOT_GROW_STEP = 32;
 
 static uint32_t getHopIntervalMsInternal() {
     uint32_t overrideMs = hopIntervalOverrideMs.load();
@@ -69,12 +92,86 @@ static const uint32_t BEACON_INTERVAL_MAX_MS = 5000;
 
 static portMUX_TYPE vectorMux = portMUX_INITIALIZER_UNLOCKED;
 
+// All vectorMux holds go through these so ReconMetrics sees every hold time
+static inline void lockNetworks() {
+    taskENTER_CRITICAL(&vectorMux);
+    ReconMetrics::lockAcquired();
+}
+
+static inline void unlockNetworks() {
+    ReconMetrics::lockReleased();
+    taskEXIT_CRITICAL(&vectorMux);
+}
+
 // ============================================================================
 // Shared Data
 // ============================================================================
 
 static std::vector<DetectedNetwork> networks;
 
+// BSSID -> networks[] slot. 512 buckets keeps load <= 40% at MAX_RECON_NETWORKS
+// (~2 probes per miss). 4KB static, never touches the heap.
+// Guarded by vectorMux alongside networks; every mutation of networks must
+// keep it in sync (or call reindexNetworks()).
+static BssidIndex<512> networkIndex;
+
+// Dense sweep view of networks[], slot for slot (see network_hot.h).
+// Cleanup and eviction read only this: 20 bytes per network instead of a
+// full DetectedNetwork. 4KB static. Guarded by vectorMux; refreshed after
+// every write to a record (syncHot / rebuildHot / syncNetwork()).
+static NetworkHot networkHot[MAX_RECON_NETWORKS];
+
+// Retention scores by slot, lowest first, so a full table finds its
+// eviction victim without scoring every network. Keyed from networkHot on
+// every sync; time-decay terms are caught up by refreshEvictionKeys().
+// Pinned (target) slots are left out. ~1.4KB static, guarded by vectorMux.
+static ScoreBuckets<MAX_RECON_NETWORKS, -80, 127> evictionQueue;
+static uint16_t evictionRefreshCursor = 0;
+
+// Published copy of networks[] for readers that must not take vectorMux
+// (see Snapshot). Written only from update(); both halves are heap
+// buffers sized to the table in SNAPSHOT_GROW_STEP views (64 bytes each).
+static SnapshotBuffer<NetworkView> snapshots;
+static uint32_t lastSnapshotTime = 0;
+static uint16_t snapshotCapacity = 0;
+static uint16_t snapshotTruncated = 0;
+static uint32_t snapshotLastHoldCycles = 0;
+static uint32_t snapshotMaxHoldCycles = 0;
+
+// Caller must hold vectorMux
+static inline size_t hotCount() {
+    return networks.size() < MAX_RECON_NETWORKS ? networks.size() : MAX_RECON_NETWORKS;
+}
+
+// Caller must hold vectorMux
+static inline void rekeyEviction(size_t idx, uint32_t now) {
+    const NetworkHot& hot = networkHot[idx];
+    if (hot.bias == ReconHot::kBiasPinned) {
+        evictionQueue.remove((uint16_t)idx);
+    } else {
+        evictionQueue.update((uint16_t)idx, ReconHot::retentionScore(hot, now));
+    }
+}
+
+// Caller must hold vectorMux
+static inline void syncHot(size_t idx) {
+    if (idx < MAX_RECON_NETWORKS && idx < networks.size()) {
+        ReconHot::project(networks[idx], networkHot[idx]);
+        rekeyEviction(idx, millis());
+    }
+}
+
+// Caller must hold vectorMux
+static void rebuildHot() {
+    uint32_t now = millis();
+    size_t n = hotCount();
+    evictionQueue.clear();
+    for (size_t i = 0; i < n; i++) {
+        ReconHot::project(networks[i], networkHot[i]);
+        rekeyEviction(i, now);
+    }
+}
+
 // ============================================================================
 // Deferred Event Processing (avoid allocations in callback)
 // ============================================================================
@@ -98,9 +195,56 @@ static std::atomic<uint8_t> pendingSsidWrite{0};
 // Mode-Specific Callbacks
 // ============================================================================
 
-static PacketCallback modeCallback = nullptr;
+static std::atomic<PacketCallback> modeCallback{nullptr};
 static NewNetworkCallback newNetworkCallback = nullptr;
 
+// IE summary of the frame currently being dispatched to modeCallback.
+// Only touched from the dispatch context (RX worker task).
+static const uint8_t* dispatchFrame = nullptr;
+static const BeaconSummary* dispatchSummary = nullptr;
+
+// ============================================================================
+// RX Ring (WiFi task -> worker task)
+// ============================================================================
+
+// The driver callback only copies frames into this ring; parsing, vector
+// updates and mode callbacks run in rxWorkerTask on the app core. Allocated
+// once in init() and never freed so it cannot fragment the heap later.
+static const uint32_t RX_RING_BYTES = 12288;
+
+// Per-type copy limits. Beacons/probe responses are kept whole (> MAX_BEACON_SIZE
+// + FCS). Large data frames are bulk traffic - only the 802.11 + LLC headers
+// matter to recon and the modes, and EAPOL frames are far below the cut.
+static const uint16_t RX_COPY_MGMT_MAX = 1600;
+static const uint16_t RX_COPY_DATA_MAX = 640;
+static const uint16_t RX_COPY_DATA_HDR = 64;
+static const uint16_t RX_COPY_OTHER_MAX = 64;
+
+// Worker re-checks the ring at least this often (covers a missed wakeup)
+static const uint32_t RX_WORKER_IDLE_WAIT_MS = 10;
+
+static_assert(offsetof(wifi_promiscuous_pkt_t, payload) == sizeof(wifi_pkt_rx_ctrl_t),
+              "RX ring records assume payload directly follows rx_ctrl");
+
+static FrameRing rxRing;
+static uint8_t* rxRingStorage = nullptr;
+static TaskHandle_t rxWorkerHandle = nullptr;
+static std::atomic<bool> rxDispatching{false};
+static std::atomic<uint32_t> rxTruncated{0};
+
+// ============================================================================
+// Frame Filter (see frame_interest.h)
+// ============================================================================
+
+// Recon always reads FrameInterest::kRecon; the active mode adds its own.
+// Types outside the union are filtered by the driver; management subtypes
+// are checked in promiscuousCallback against activeInterest.
+static std::atomic<uint32_t> modeInterest{0};
+static std::atomic<uint32_t> activeInterest{FrameInterest::kRecon};
+static uint32_t programmedInterest = 0;  // Last mask handed to the driver (0 = none yet)
+static std::atomic<uint32_t> rxSeen[4] = {{0}, {0}, {0}, {0}};  // Indexed by wifi_promiscuous_pkt_type_t
+static std::atomic<uint32_t> rxFiltered{0};
+
 // ============================================================================
 // Internal Functions
 // ============================================================================
@@ -113,7 +257,14 @@ static void hopChannel() {
     esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
 }
 
+// Caller must hold vectorMux
 static int findNetworkInternal(const uint8_t* bssid) {
+    int idx = networkIndex.find(bssid);
+    if (idx < 0) return -1;
+    if (idx < (int)networks.size() && memcmp(networks[idx].bssid, bssid, 6) == 0) {
+        return idx;
+    }
+    // Index out of sync (external mutation without reindex) - fall back to scan
     for (size_t i = 0; i < networks.size(); i++) {
         if (memcmp(networks[i].bssid, bssid, 6) == 0) {
             return (int)i;
@@ -133,10 +284,13 @@ static bool enqueuePendingNetwork(const DetectedNetwork& net) {
     uint8_t next = (uint8_t)((write + 1) % PENDING_NET_SLOTS);
     uint8_t read = pendingNetRead.load(std::memory_order_acquire);
     if (next == read) {
+        ReconMetrics::count(ReconMetrics::Counter::PendingNetDrop);
         return false;  // Queue full, drop
     }
     pendingNetworks[write] = net;
     pendingNetWrite.store(next, std::memory_order_release);
+    ReconMetrics::highWater(ReconMetrics::Gauge::PendingNetDepth,
+                            (uint8_t)(next + PENDING_NET_SLOTS - read) % PENDING_NET_SLOTS);
     return true;
 }
 
@@ -154,6 +308,9 @@ static bool dequeuePendingNetwork(DetectedNetwork& out) {
 static void storePendingSsid(const uint8_t* bssid, const char* ssid) {
     if (!bssid || !ssid || ssid[0] == 0) return;
     uint8_t slot = pendingSsidWrite.fetch_add(1, std::memory_order_relaxed) % PENDING_SSID_SLOTS;
+    if (ReconMetrics::kEnabled && pendingSsids[slot].ready.load(std::memory_order_relaxed)) {
+        ReconMetrics::count(ReconMetrics::Counter::PendingSsidOverwrite);
+    }
     pendingSsids[slot].ready.store(false, std::memory_order_relaxed);
     memcpy(pendingSsids[slot].bssid, bssid, 6);
     strncpy(pendingSsids[slot].ssid, ssid, 32);
@@ -178,7 +335,7 @@ static void revealSsidIfKnown(const uint8_t* bssid, const char* ssid) {
     if (!bssid || !ssid || ssid[0] == 0) return;
 
     // Try to apply to existing network first
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
     int idx = findNetworkInternal(bssid);
     if (idx >= 0 && idx < (int)networks.size()) {
         if (networks[idx].ssid[0] == 0 || networks[idx].isHidden) {
@@ -186,122 +343,34 @@ static void revealSsidIfKnown(const uint8_t* bssid, const char* ssid) {
             networks[idx].ssid[32] = 0;
             networks[idx].isHidden = false;
             networks[idx].lastSeen = millis();
+            syncHot(idx);
         }
-        taskEXIT_CRITICAL(&vectorMux);
+        unlockNetworks();
         return;
     }
-    taskEXIT_CRITICAL(&vectorMux);
+    unlockNetworks();
 
     // Otherwise, store for when the network is added
     storePendingSsid(bssid, ssid);
 }
 
-static inline uint8_t clientHashIndex(const uint8_t* mac) {
-    uint32_t h = 2166136261u;  // FNV-1a
-    for (int i = 0; i < 6; i++) {
-        h ^= mac[i];
-        h *= 16777619u;
-    }
-    return (uint8_t)(h & 0x7F);
-}
-
 static int computeRetentionScore(const DetectedNetwork& net, uint32_t now) {
-    int8_t rssi = (net.rssiAvg != 0) ? net.rssiAvg : net.rssi;
-    int score = 0;
-
-    if (rssi <= -95) score += 0;
-    else if (rssi >= -30) score += 60;
-    else score += ((int)rssi + 95) * 60 / 65;
-
-    uint32_t age = now - net.lastSeen;
-    if (age <= 2000) score += 20;
-    else if (age <= 5000) score += 12;
-    else if (age <= 15000) score += 5;
-
-    if (net.lastDataSeen > 0) {
-        uint32_t dataAge = now - net.lastDataSeen;
-        if (dataAge <= 3000) score += 20;
-        else if (dataAge <= 10000) score += 10;
-        else if (dataAge <= 30000) score += 5;
-    }
-
-    if (net.beaconIntervalEmaMs > 0) {
-        if (net.beaconIntervalEmaMs <= 150) score += 10;
-        else if (net.beaconIntervalEmaMs <= 500) score += 6;
-        else if (net.beaconIntervalEmaMs <= 1000) score += 3;
-    }
-
-    if (net.hasHandshake) score -= 20;
-    if (net.hasPMF) score -= 15;
-    if (net.authmode == WIFI_AUTH_OPEN) score -= 10;
-    if (net.ssid[0] == 0 || net.isHidden) score -= 10;
-    if (net.cooldownUntil > now) score -= 10;
-
-    return score;
+    NetworkHot hot;
+    ReconHot::project(net, hot);
+    return ReconHot::retentionScore(hot, now);
 }
 
-// PMF detection result - we need both bits to distinguish WPA3 from WPA2/WPA3 mixed
-// jader242 i know you reading dis. pig knows.
-struct PmfResult {
-    bool capable;   // MFPC (bit 6) - PMF capable (WPA2/WPA3 transitional sets this)
-    bool required;  // MFPR (bit 7) - PMF required (pure WPA3 sets both)
-};
-
-static PmfResult detectPMF(const uint8_t* payload, uint16_t len) {
-    PmfResult result = {false, false};
-    uint16_t offset = 36;
-    while (offset + 2 < len) {
-        uint8_t id = payload[offset];
-        uint8_t ieLen = payload[offset + 1];
-
-        if (offset + 2 + ieLen > len) break;
-
-        if (id == 0x30 && ieLen >= 8) {  // RSN IE
-            uint16_t rsnOffset = offset + 2;
-            uint16_t rsnEnd = rsnOffset + ieLen;
-            uint16_t version = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            if (version != 1) {
-                offset += 2 + ieLen;
-                continue;
-            }
-
-            // Walk the RSN IE properly - no shortcuts, no assumptions
-            rsnOffset += 6;  // Skip version(2) + group cipher(4)
-            if (rsnOffset + 2 > rsnEnd) break;
-
-            uint16_t pairwiseCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (pairwiseCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-
-            uint16_t akmCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (akmCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-
-            // RSN Capabilities - IEEE 802.11-2016 Table 9-133
-            // Bit 6: MFPC (Management Frame Protection Capable)
-            // Bit 7: MFPR (Management Frame Protection Required)
-            uint16_t caps = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            result.capable  = (caps >> 6) & 0x01;  // MFPC
-            result.required = (caps >> 7) & 0x01;  // MFPR
-            break;
-        }
-
-        offset += 2 + ieLen;
-    }
-    return result;
-}
-
-static void processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi) {
+static void processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi,
+                          const BeaconSummary& ies) {
     if (len < 36) return;
     
     const uint8_t* bssid = payload + 16;
-    PmfResult pmf = detectPMF(payload, len);
     uint32_t now = millis();
     
     // [BUG1 FIX] Lookup under spinlock - vector can be modified by cleanupStaleNetworks()
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
     int idx = findNetworkInternal(bssid);
-    taskEXIT_CRITICAL(&vectorMux);
+    unlockNetworks();
     
     if (idx < 0) {
         // New network - queue for deferred add
@@ -310,115 +379,41 @@ static void processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi) {
         net.rssi = rssi;
         net.rssiAvg = rssi;
         net.channel = currentChannel;
-        net.authmode = WIFI_AUTH_OPEN;
         net.firstSeen = now;
         net.lastSeen = now;
         net.lastBeaconSeen = now;
         net.beaconCount = 1;
         net.beaconIntervalEmaMs = 0;
         net.isTarget = false;
-        net.hasPMF = pmf.required;
+        net.hasPMF = ies.mfpr;
         net.hasHandshake = false;
+        net.lootChecked = false;
+        net.lootTypes = 0;
         net.attackAttempts = 0;
-        net.isHidden = false;
+        net.isHidden = ies.isHidden();
         net.lastDataSeen = 0;
         net.cooldownUntil = 0;
-        net.clientBitset = 0;
-        net.clientBitsetHigh = 0;
-
-        // Parse SSID from IE
-        uint16_t offset = 36;
-        while (offset + 2 < len) {
-            uint8_t id = payload[offset];
-            uint8_t ieLen = payload[offset + 1];
-            
-            if (offset + 2 + ieLen > len) break;
-            
-            if (id == 0) {
-                if (ieLen > 0 && ieLen <= 32) {
-                    memcpy(net.ssid, payload + offset + 2, ieLen);
-                    net.ssid[ieLen] = 0;
-                    
-                    // Check for all-null SSID (hidden)
-                    bool allNull = true;
-                    for (uint8_t i = 0; i < ieLen; i++) {
-                        if (net.ssid[i] != 0) { allNull = false; break; }
-                    }
-                    if (allNull) {
-                        net.isHidden = true;
-                    }
-                } else if (ieLen == 0) {
-                    net.isHidden = true;
-                }
-                break;
-            }
-            
-            offset += 2 + ieLen;
+        net.clients.clear();
+
+        if (!net.isHidden) {
+            ies.copySsid(net.ssid);
         }
-        
-        // Get channel from DS Parameter Set IE
-        offset = 36;
-        while (offset + 2 < len) {
-            uint8_t id = payload[offset];
-            uint8_t ieLen = payload[offset + 1];
-            
-            if (id == 3 && ieLen == 1) {
-                net.channel = payload[offset + 2];
-                break;
-            }
-            
-            offset += 2 + ieLen;
+        if (ies.dsChannel != 0) {
+            net.channel = ies.dsChannel;
         }
-        
-        // Parse auth mode from RSN (0x30) and WPA vendor (0xDD) IEs
+
         // RSN + MFPR        = pure WPA3 (PMF required, no fallback)
         // RSN + MFPC only   = WPA2/WPA3 transitional (PMF capable, clients choose)
         // RSN alone          = WPA2
         // WPA vendor alone   = WPA1
         // RSN + WPA vendor   = WPA1/WPA2 mixed
-        bool hasRSN = false;
-        offset = 36;
-        while (offset + 2 < len) {
-            uint8_t id = payload[offset];
-            uint8_t ieLen = payload[offset + 1];
-
-            if (offset + 2 + ieLen > len) break;
-
-            if (id == 0x30 && ieLen >= 2) {  // RSN IE
-                hasRSN = true;
-                net.authmode = WIFI_AUTH_WPA2_PSK;
-            } else if (id == 0xDD && ieLen >= 8) {  // Vendor specific
-                if (payload[offset + 2] == 0x00 && payload[offset + 3] == 0x50 &&
-                    payload[offset + 4] == 0xF2 && payload[offset + 5] == 0x01) {
-                    if (!hasRSN) {
-                        net.authmode = WIFI_AUTH_WPA_PSK;
-                    } else {
-                        net.authmode = WIFI_AUTH_WPA_WPA2_PSK;
-                    }
-                }
-            }
-
-            offset += 2 + ieLen;
-        }
-
-        // Apply PMF classification on top of RSN detection
-        if (hasRSN && net.authmode == WIFI_AUTH_WPA2_PSK) {
-            if (pmf.required) {
-                net.authmode = WIFI_AUTH_WPA3_PSK;         // MFPR=1: pure WPA3-SAE
-            } else if (pmf.capable) {
-                net.authmode = WIFI_AUTH_WPA2_WPA3_PSK;    // MFPC=1 only: transitional
-            }
-        }
-        
-        if (net.channel == 0) {
-            net.channel = currentChannel;
-        }
+        net.authmode = (wifi_auth_mode_t)ies.auth();
         
         // Queue for deferred add
         enqueuePendingNetwork(net);
     } else {
         // Update existing network
-        taskENTER_CRITICAL(&vectorMux);
+        lockNetworks();
         if (idx >= 0 && idx < (int)networks.size()) {
             DetectedNetwork& net = networks[idx];
             net.rssi = rssi;
@@ -437,58 +432,39 @@ static void processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi) {
                 }
             }
             net.lastBeaconSeen = now;
-            net.hasPMF |= pmf.required;
+            net.hasPMF |= ies.mfpr;
+            syncHot(idx);
         }
-        taskEXIT_CRITICAL(&vectorMux);
+        unlockNetworks();
     }
 }
 
-static void processProbeResponse(const uint8_t* payload, uint16_t len, int8_t rssi) {
+static void processProbeResponse(const uint8_t* payload, uint16_t len, int8_t rssi,
+                                 const BeaconSummary& ies) {
     if (len < 36) return;
     
     const uint8_t* bssid = payload + 16;
     uint32_t now = millis();
 
-    // Parse SSID from IE (probe responses can reveal hidden SSIDs)
+    // Probe responses can reveal hidden SSIDs
     char ssidBuf[33] = {0};
-    bool ssidFound = false;
-    bool ssidAllNull = true;
-    uint16_t offset = 36;
-    while (offset + 2 < len) {
-        uint8_t id = payload[offset];
-        uint8_t ieLen = payload[offset + 1];
-        
-        if (offset + 2 + ieLen > len) break;
-        
-        if (id == 0 && ieLen > 0 && ieLen <= 32) {
-            memcpy(ssidBuf, payload + offset + 2, ieLen);
-            ssidBuf[ieLen] = 0;
-            ssidFound = true;
-            
-            for (uint8_t i = 0; i < ieLen; i++) {
-                if (ssidBuf[i] != 0) { ssidAllNull = false; break; }
-            }
-            break;
-        }
-        
-        offset += 2 + ieLen;
-    }
+    bool ssidUsable = ies.hasUsableSsid() && ies.copySsid(ssidBuf);
     
     // [BUG5 FIX] Do lookup inside critical section to prevent TOCTOU race
     // cleanupStaleNetworks() can modify vector between lookup and use
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
     int idx = findNetworkInternal(bssid);
     
     if (idx < 0) {
-        taskEXIT_CRITICAL(&vectorMux);
-        if (ssidFound && !ssidAllNull) {
+        unlockNetworks();
+        if (ssidUsable) {
             revealSsidIfKnown(bssid, ssidBuf);
         }
         return;
     }
     
     // idx is valid and we hold the lock - safe to use
-    if ((networks[idx].ssid[0] == 0 || networks[idx].isHidden) && ssidFound && !ssidAllNull) {
+    if ((networks[idx].ssid[0] == 0 || networks[idx].isHidden) && ssidUsable) {
         memcpy(networks[idx].ssid, ssidBuf, 33);
         networks[idx].isHidden = false;
     }
@@ -496,61 +472,38 @@ static void processProbeResponse(const uint8_t* payload, uint16_t len, int8_t rs
     networks[idx].rssi = rssi;
     networks[idx].rssiAvg = updateRssiAvg(networks[idx].rssiAvg, rssi);
     networks[idx].lastSeen = now;
-    taskEXIT_CRITICAL(&vectorMux);
+    syncHot(idx);
+    unlockNetworks();
 }
 
 static void processAssocRequest(const uint8_t* payload, uint16_t len, bool isReassoc) {
     if (len < 36) return;
     
     const uint8_t* bssid = payload + 16;
-    uint16_t fixedLen = isReassoc ? 10 : 4;
-    uint16_t offset = 24 + fixedLen;
-    if (offset + 2 > len) return;
+    BeaconSummary ies;
+    if (!BeaconParser::parseAssocRequest(payload, len, isReassoc, ies)) return;
     
-    // Parse SSID IE from tagged parameters
     char ssidBuf[33] = {0};
-    bool ssidFound = false;
-    bool ssidAllNull = true;
-    while (offset + 2 < len) {
-        uint8_t id = payload[offset];
-        uint8_t ieLen = payload[offset + 1];
-        if (offset + 2 + ieLen > len) break;
-        
-        if (id == 0 && ieLen > 0 && ieLen <= 32) {
-            memcpy(ssidBuf, payload + offset + 2, ieLen);
-            ssidBuf[ieLen] = 0;
-            ssidFound = true;
-            for (uint8_t i = 0; i < ieLen; i++) {
-                if (ssidBuf[i] != 0) { ssidAllNull = false; break; }
-            }
-            break;
-        }
-        offset += 2 + ieLen;
-    }
-    
-    if (ssidFound && !ssidAllNull) {
+    if (ies.hasUsableSsid() && ies.copySsid(ssidBuf)) {
         revealSsidIfKnown(bssid, ssidBuf);
     }
 }
 
 static void markDataActivity(const uint8_t* bssid, const uint8_t* clientMac) {
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
 
     int idx = findNetworkInternal(bssid);
     if (idx >= 0 && idx < (int)networks.size()) {
         DetectedNetwork& net = networks[idx];
-        net.lastDataSeen = millis();
+        uint32_t now = millis();
+        net.lastDataSeen = now;
         if (clientMac) {
-            uint8_t bit = clientHashIndex(clientMac);
-            if (bit < 64) {
-                net.clientBitset |= (1ULL << bit);
-            } else {
-                net.clientBitsetHigh |= (1ULL << (bit - 64));
-            }
+            net.clients.add(clientMac, now);
         }
+        syncHot(idx);
     }
 
-    taskEXIT_CRITICAL(&vectorMux);
+    unlockNetworks();
 }
 
 static void processDataFrame(const uint8_t* payload, uint16_t len, int8_t rssi) {
@@ -578,17 +531,17 @@ static void processDataFrame(const uint8_t* payload, uint16_t len, int8_t rssi)
     }
 }
 
-static void promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
-    if (!buf) return;
-    if (!running || paused) return;
+// Parse one frame, update shared state and chain into the mode callback.
+// Runs in rxWorkerTask (or inline in the WiFi task if the worker is missing).
+static void dispatchPacket(const wifi_promiscuous_pkt_t* pkt, wifi_promiscuous_pkt_type_t type) {
+    PacketCallback cb = modeCallback;
     if (busy) {
-        if (modeCallback) {
-            modeCallback((wifi_promiscuous_pkt_t*)buf, type);
+        if (cb) {
+            cb(pkt, type);
         }
         return;
     }
     
-    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
     uint16_t len = pkt->rx_ctrl.sig_len;
     int8_t rssi = pkt->rx_ctrl.rssi;
     
@@ -597,17 +550,24 @@ static void promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
     if (len < 24) return;
     
     packetCount++;
+    uint32_t parseStart = ReconMetrics::begin();
     
     const uint8_t* payload = pkt->payload;
     uint8_t frameSubtype = (payload[0] >> 4) & 0x0F;
     
+    // One IE pass per beacon/probe response, shared with the mode callback
+    BeaconSummary ies;
+    bool haveIes = false;
+    
     // Basic network tracking (always happens)
     switch (type) {
         case WIFI_PKT_MGMT:
             if (frameSubtype == 0x08) {  // Beacon
-                processBeacon(payload, len, rssi);
+                haveIes = BeaconParser::parseBeacon(payload, len, ies);
+                processBeacon(payload, len, rssi, ies);
             } else if (frameSubtype == 0x05) {  // Probe Response
-                processProbeResponse(payload, len, rssi);
+                haveIes = BeaconParser::parseBeacon(payload, len, ies);
+                processProbeResponse(payload, len, rssi, ies);
             } else if (frameSubtype == 0x00) {  // Assoc Request
                 processAssocRequest(payload, len, false);
             } else if (frameSubtype == 0x02) {  // Reassoc Request
@@ -623,12 +583,152 @@ static void promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
             break;
     }
     
+    ReconMetrics::end(ReconMetrics::Stage::Dispatch, parseStart);
+    
     // Mode-specific callback (for EAPOL capture, PCAP logging, etc.)
-    if (modeCallback) {
-        modeCallback(pkt, type);
+    if (cb) {
+        if (haveIes) {
+            dispatchFrame = payload;
+            dispatchSummary = &ies;
+        }
+        uint32_t cbStart = ReconMetrics::begin();
+        cb(pkt, type);
+        ReconMetrics::end(ReconMetrics::Stage::ModeCallback, cbStart);
+        dispatchFrame = nullptr;
+        dispatchSummary = nullptr;
+    }
+}
+
+static inline uint16_t rxCopyLength(wifi_promiscuous_pkt_type_t type, uint16_t sigLen) {
+    switch (type) {
+        case WIFI_PKT_MGMT:
+            return sigLen < RX_COPY_MGMT_MAX ? sigLen : RX_COPY_MGMT_MAX;
+        case WIFI_PKT_DATA:
+            return sigLen <= RX_COPY_DATA_MAX ? sigLen : RX_COPY_DATA_HDR;
+        default:
+            return sigLen < RX_COPY_OTHER_MAX ? sigLen : RX_COPY_OTHER_MAX;
+    }
+}
+
+// Program the driver filter with recon's interest plus the active mode's.
+// Caller ensures promiscuous mode is (being) enabled.
+static void applyFrameFilter() {
+    uint32_t interest = FrameInterest::kRecon | modeInterest.load(std::memory_order_relaxed);
+    activeInterest.store(interest, std::memory_order_relaxed);
+    
+    wifi_promiscuous_filter_t filter = {};
+    if (FrameInterest::wantsMgmt(interest)) filter.filter_mask |= WIFI_PROMIS_FILTER_MASK_MGMT;
+    if (FrameInterest::wantsData(interest)) filter.filter_mask |= WIFI_PROMIS_FILTER_MASK_DATA;
+    if (FrameInterest::wantsCtrl(interest)) {
+        filter.filter_mask |= WIFI_PROMIS_FILTER_MASK_CTRL;
+        wifi_promiscuous_filter_t ctrlFilter = {};
+        ctrlFilter.filter_mask = WIFI_PROMIS_CTRL_FILTER_MASK_ALL;
+        esp_wifi_set_promiscuous_ctrl_filter(&ctrlFilter);
+    }
+    esp_wifi_set_promiscuous_filter(&filter);
+    
+    if (interest != programmedInterest) {
+        programmedInterest = interest;
+        Serial.printf("[RECON] Frame filter: mgmt=0x%04X data=%d ctrl=%d\n",
+                      (unsigned)(interest & FrameInterest::kMgmtAll),
+                      FrameInterest::wantsData(interest) ? 1 : 0,
+                      FrameInterest::wantsCtrl(interest) ? 1 : 0);
+    }
+}
+
+// WiFi driver task: copy into the ring and return. No parsing, no locks.
+static void promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
+    if (!buf) return;
+    if (!running || paused) return;
+    
+    const wifi_promiscuous_pkt_t* pkt = (const wifi_promiscuous_pkt_t*)buf;
+    uint32_t cbStart = ReconMetrics::begin();
+    rxSeen[type & 3].fetch_add(1, std::memory_order_relaxed);
+    
+    // The driver can only filter by type - drop unwanted management subtypes
+    // here, before they cost a ring copy and a worker wakeup
+    if (type == WIFI_PKT_MGMT) {
+        uint8_t fc0 = pkt->rx_ctrl.sig_len ? pkt->payload[0] : 0;
+        if (!FrameInterest::accepts(activeInterest.load(std::memory_order_relaxed), (uint8_t)type, fc0)) {
+            rxFiltered.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    
+    if (!rxWorkerHandle) {
+        dispatchPacket(pkt, type);
+        return;
+    }
+    
+    wifi_pkt_rx_ctrl_t ctrl = pkt->rx_ctrl;
+    uint16_t sigLen = ctrl.sig_len;
+    uint16_t copyLen = rxCopyLength(type, sigLen);
+    uint8_t flags = 0;
+    if (copyLen < sigLen) {
+        // Consumers size the frame from sig_len - make it match what we kept
+        ctrl.sig_len = copyLen;
+        flags |= FrameRing::kFlagTruncated;
+    }
+    
+    bool wasEmpty = false;
+    if (rxRing.push((uint8_t)type, flags, &ctrl, sizeof(ctrl), pkt->payload, copyLen, &wasEmpty)) {
+        if (flags) rxTruncated.fetch_add(1, std::memory_order_relaxed);
+        if (wasEmpty) xTaskNotifyGive(rxWorkerHandle);
+    }
+    ReconMetrics::end(ReconMetrics::Stage::DriverCallback, cbStart);
+}
+
+// App core: drain the ring. Frames queued before a stop/pause are discarded.
+static void rxWorkerTask(void* pvParameters) {
+    (void)pvParameters;
+    for (;;) {
+        uint16_t bodyLen;
+        uint8_t type;
+        uint8_t flags;
+        const uint8_t* body;
+        while ((body = rxRing.peek(bodyLen, type, flags)) != nullptr) {
+            if (running && !paused && bodyLen >= sizeof(wifi_pkt_rx_ctrl_t)) {
+                rxDispatching.store(true);
+                dispatchPacket((const wifi_promiscuous_pkt_t*)body, (wifi_promiscuous_pkt_type_t)type);
+                rxDispatching.store(false);
+            }
+            rxRing.pop();
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RX_WORKER_IDLE_WAIT_MS));
     }
 }
 
+static void startRxWorker() {
+    if (rxWorkerHandle) return;
+    
+    rxRingStorage = (uint8_t*)heap_caps_malloc(RX_RING_BYTES, MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    if (!rxRingStorage) {
+        Serial.println("[RECON] RX ring alloc failed - parsing in WiFi task");
+        return;
+    }
+    rxRing.attach(rxRingStorage, RX_RING_BYTES);
+    
+    xTaskCreatePinnedToCore(
+        rxWorkerTask,       // Function
+        "reconRx",          // Name
+        6144,               // Stack size (mode callbacks run here)
+        NULL,               // Parameters
+        4,                  // Priority (above loop, below WiFi)
+        &rxWorkerHandle,    // Task handle
+        1                   // App core - WiFi task owns core 0
+    );
+    
+    if (rxWorkerHandle == NULL) {
+        // Fallback: keep the old inline path
+        heap_caps_free(rxRingStorage);
+        rxRingStorage = nullptr;
+        rxRing.attach(nullptr, 0);
+        Serial.println("[RECON] RX worker create failed - parsing in WiFi task");
+        return;
+    }
+    Serial.printf("[RECON] RX worker started (ring=%u bytes)\n", (unsigned)RX_RING_BYTES);
+}
+
 static void processDeferredEvents() {
     const uint8_t kMaxAddsPerUpdate = 8;
     uint8_t processed = 0;
@@ -645,10 +745,15 @@ static void processDeferredEvents() {
         bool inserted = false;
         bool replaced = false;
         if (hasCapacity) {
-            taskENTER_CRITICAL(&vectorMux);
-            networks.push_back(pending);  // Safe: capacity pre-reserved at init
-            taskEXIT_CRITICAL(&vectorMux);
-            inserted = true;
+            lockNetworks();
+            // Several beacons from one AP can queue before we drain - add once
+            if (findNetworkInternal(pending.bssid) < 0) {
+                networks.push_back(pending);  // Safe: capacity pre-reserved at init
+                networkIndex.insert(pending.bssid, (uint16_t)(networks.size() - 1));
+                syncHot(networks.size() - 1);
+                inserted = true;
+            }
+            unlockNetworks();
         } else {
             // Vector is full - evict a low-value entry if the new one is better
             uint32_t now = millis();
@@ -656,20 +761,40 @@ static void processDeferredEvents() {
             int worstScore = 100000;
             int worstIdx = -1;
             
-            taskENTER_CRITICAL(&vectorMux);
-            for (size_t i = 0; i < networks.size(); i++) {
-                if (networks[i].isTarget) continue;
-                int score = computeRetentionScore(networks[i], now);
-                if (score < worstScore) {
-                    worstScore = score;
-                    worstIdx = (int)i;
+            lockNetworks();
+            if (findNetworkInternal(pending.bssid) >= 0) {
+                unlockNetworks();
+                processed++;
+                continue;
+            }
+            // Lowest key from the eviction queue. A key can lag its score by one
+            // refresh round and isTarget may have been set without syncNetwork(),
+            // so check the candidate and re-key until the head is current.
+            for (uint8_t attempt = 0; attempt < EVICTION_VERIFY_ATTEMPTS; attempt++) {
+                int keyScore = 0;
+                worstIdx = evictionQueue.peekMin(keyScore);
+                if (worstIdx < 0) break;
+                if (networks[worstIdx].isTarget) {
+                    syncHot(worstIdx);  // Pins it - drops out of the queue
+                    worstIdx = -1;
+                    continue;
                 }
+                worstScore = ReconHot::retentionScore(networkHot[worstIdx], now);
+                if (worstScore == keyScore || attempt == EVICTION_VERIFY_ATTEMPTS - 1) break;
+                evictionQueue.update((uint16_t)worstIdx, worstScore);
+                worstIdx = -1;
             }
             if (worstIdx >= 0 && pendingScore > worstScore) {
+                networkIndex.erase(networks[worstIdx].bssid);
                 networks[worstIdx] = pending;
+                networkIndex.insert(pending.bssid, (uint16_t)worstIdx);
+                syncHot(worstIdx);
                 replaced = true;
             }
-            taskEXIT_CRITICAL(&vectorMux);
+            unlockNetworks();
+            if (replaced) {
+                layoutVersion.fetch_add(1, std::memory_order_release);
+            }
         }
         
         if (inserted || replaced) {
@@ -690,40 +815,143 @@ static void processDeferredEvents() {
     }
 }
 
+// Caller must hold vectorMux. Moves the last record into idx (O(1), no tail shift).
+static void removeSlot(size_t idx) {
+    size_t last = networks.size() - 1;
+    networkIndex.erase(networks[idx].bssid);
+    evictionQueue.remove((uint16_t)last);
+    if (idx != last) {
+        networks[idx] = networks[last];
+        networkIndex.insert(networks[idx].bssid, (uint16_t)idx);
+        syncHot(idx);
+    }
+    networks.pop_back();
+}
+
+static_assert(sizeof(NetworkView) == 64, "NetworkView should stay at 64 bytes");
+
+// Caller must hold vectorMux
+static inline void makeView(const DetectedNetwork& net, NetworkView& view, uint32_t now) {
+    view.lastSeen = net.lastSeen;
+    view.lastDataSeen = net.lastDataSeen;
+    view.cooldownUntil = net.cooldownUntil;
+    view.beaconIntervalEmaMs = net.beaconIntervalEmaMs;
+    memcpy(view.bssid, net.bssid, 6);
+    memcpy(view.ssid, net.ssid, sizeof(view.ssid));
+    view.rssi = net.rssi;
+    view.rssiAvg = net.rssiAvg;
+    view.channel = net.channel;
+    view.authmode = (uint8_t)net.authmode;
+    view.attackAttempts = net.attackAttempts;
+    view.clientEstimate = net.clients.estimate(now);
+    view.lootTypes = net.lootTypes;
+    view.isTarget = net.isTarget;
+    view.hasPMF = net.hasPMF;
+    view.hasHandshake = net.hasHandshake;
+    view.isHidden = net.isHidden;
+}
+
+// Copy networks[] into the back half of the snapshot buffer and flip it.
+// The copy is split into SNAPSHOT_COPY_BATCH-record lock holds; only this
+// (loop) task moves records between slots, so batches stay consistent.
+static void publishSnapshot(uint32_t now) {
+    NetworkView* back = nullptr;
+    uint16_t cap = 0;
+    if (!snapshots.beginWrite(back, cap)) return;  // Reader still on it
+
+    lockNetworks();
+    size_t want = networks.size();
+    unlockNetworks();
+    if (want > MAX_RECON_NETWORKS) want = MAX_RECON_NETWORKS;
+
+    if (want > cap) {
+        uint16_t grown = (uint16_t)((want + SNAPSHOT_GROW_STEP - 1) / SNAPSHOT_GROW_STEP * SNAPSHOT_GROW_STEP);
+        if (grown > MAX_RECON_NETWORKS) grown = MAX_RECON_NETWORKS;
+        NetworkView* fresh = nullptr;
+        if (HeapGates::canGrow(HeapPolicy::kMinHeapForReconGrowth,
+                               HeapPolicy::kMinFragRatioForGrowth)) {
+            fresh = (NetworkView*)heap_caps_malloc(grown * sizeof(NetworkView),
+                                                   MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+        }
+        if (fresh) {
+            heap_caps_free(snapshots.attachBack(fresh, grown));
+            back = fresh;
+            cap = grown;
+            if (grown > snapshotCapacity) snapshotCapacity = grown;
+        }
+    }
+    if (!back) return;
+
+    uint16_t total = want < cap ? (uint16_t)want : cap;
+    snapshotTruncated = (uint16_t)(want - total);
+    uint16_t copied = 0;
+    uint32_t longestHold = 0;
+    while (copied < total) {
+        lockNetworks();
+        uint32_t holdStart = ESP.getCycleCount();
+        uint16_t end = copied + SNAPSHOT_COPY_BATCH;
+        if (end > total) end = total;
+        if (end > networks.size()) end = (uint16_t)networks.size();
+        for (uint16_t i = copied; i < end; i++) {
+            makeView(networks[i], back[i], now);
+        }
+        uint32_t hold = ESP.getCycleCount() - holdStart;
+        unlockNetworks();
+        if (hold > longestHold) longestHold = hold;
+        if (end == copied) break;  // Table shrank under us
+        copied = end;
+    }
+
+    snapshots.publish(copied, now);
+    snapshotLastHoldCycles = longestHold;
+    if (longestHold > snapshotMaxHoldCycles) {
+        snapshotMaxHoldCycles = longestHold;
+    }
+}
+
+// Re-key a rolling window of slots so time-decay terms (recency, data
+// activity, cooldown expiry) reach the eviction queue without a full sweep.
+static void refreshEvictionKeys(uint32_t now) {
+    lockNetworks();
+    size_t n = hotCount();
+    for (uint8_t k = 0; k < EVICTION_REFRESH_PER_UPDATE && k < n; k++) {
+        if (evictionRefreshCursor >= n) evictionRefreshCursor = 0;
+        rekeyEviction(evictionRefreshCursor++, now);
+    }
+    unlockNetworks();
+}
+
 static void cleanupStaleNetworks() {
     uint32_t now = millis();
+    uint8_t removed = 0;
     
-    // [BUG6 FIX] Single critical section for collect + erase
-    // Previously had gap between collect and erase where vector could change
-    // erase() doesn't allocate - just shifts elements and decrements size - safe in spinlock
-    taskENTER_CRITICAL(&vectorMux);
+    // [BUG6 FIX] Single critical section for scan + remove
+    // Swap-remove instead of erase(): each removal is O(1) rather than a tail
+    // shift, so time under the lock is one pass over the dense view plus at
+    // most STALE_REMOVALS_PER_PASS record moves. Measured below.
+    lockNetworks();
+    uint32_t holdStart = ESP.getCycleCount();
     
-    // Collect stale indices (static to avoid stack/heap allocation)
-    static size_t staleIndices[50];
-    size_t staleCount = 0;
-
-    for (size_t i = 0; i < networks.size() && staleCount < 50; i++) {
-        if (networks[i].lastDataSeen > 0 &&
-            now - networks[i].lastDataSeen > CLIENT_BITMAP_RESET_MS) {
-            networks[i].clientBitset = 0;
-            networks[i].clientBitsetHigh = 0;
-        }
-        int8_t rssi = (networks[i].rssiAvg != 0) ? networks[i].rssiAvg : networks[i].rssi;
-        uint32_t timeout = STALE_TIMEOUT_MS;  // 60s default (strong signal)
-        if (rssi < -75) timeout = 120000;     // Weak: 2 min
-        else if (rssi < -50) timeout = 90000; // Medium: 1.5 min
-        if (now - networks[i].lastSeen > timeout) {
-            staleIndices[staleCount++] = i;
+    // Walk backwards: the record swapped into slot i has already been visited
+    for (int i = (int)hotCount() - 1; i >= 0 && removed < STALE_REMOVALS_PER_PASS; i--) {
+        if (ReconHot::isStale(networkHot[i], now)) {
+            removeSlot((size_t)i);
+            removed++;
         }
     }
     
-    // Erase in reverse order to preserve indices
-    for (int i = staleCount - 1; i >= 0; i--) {
-        // No bounds check needed - indices are valid, no vector modification between collect and erase
-        networks.erase(networks.begin() + staleIndices[i]);
-    }
+    uint32_t holdCycles = ESP.getCycleCount() - holdStart;
+    unlockNetworks();
     
-    taskEXIT_CRITICAL(&vectorMux);
+    if (removed > 0) {
+        layoutVersion.fetch_add(1, std::memory_order_release);
+    }
+    cleanupPasses++;
+    cleanupLastRemoved = removed;
+    cleanupLastHoldCycles = holdCycles;
+    if (holdCycles > cleanupMaxHoldCycles) {
+        cleanupMaxHoldCycles = holdCycles;
+    }
 }
 
 // ============================================================================
@@ -737,6 +965,8 @@ void init() {
     
     networks.clear();
     networks.reserve(MAX_RECON_NETWORKS);  // Full upfront reserve — eliminates growth reallocations
+    networkIndex.clear();
+    evictionQueue.clear();
     
     packetCount = 0;
     currentChannel = 1;
@@ -756,6 +986,9 @@ void init() {
     modeCallback = nullptr;
     heapStabilized = false;
     
+    // Ring + worker allocated at boot alongside the networks reserve
+    startRxWorker();
+    
     initialized = true;
     Serial.println("[RECON] Initialized");
 }
@@ -823,7 +1056,7 @@ void start() {
     
     // Set up promiscuous mode
     esp_wifi_set_promiscuous_rx_cb(promiscuousCallback);
-    esp_wifi_set_promiscuous_filter(nullptr);  // Receive all packet types
+    applyFrameFilter();
     esp_wifi_set_promiscuous(true);
     esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
     
@@ -847,14 +1080,29 @@ void stop() {
     
     // Don't clear networks - they persist for mode reuse
     
-    Serial.printf("[RECON] Stopped. Networks cached: %d\n", networks.size());
+    Serial.printf("[RECON] Stopped. Networks cached: %d rx dropped=%u truncated=%u filtered=%u cleanup max hold=%uus snapshot max hold=%uus\n",
+                  networks.size(), rxRing.getDropped(),
+                  rxTruncated.load(std::memory_order_relaxed),
+                  rxFiltered.load(std::memory_order_relaxed),
+                  getCleanupStats().maxHoldUs, getSnapshotStats().maxHoldUs);
 }
 
 void freeNetworks() {
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
     networks.clear();
     networks.shrink_to_fit();
-    taskEXIT_CRITICAL(&vectorMux);
+    networkIndex.clear();
+    evictionQueue.clear();
+    unlockNetworks();
+    layoutVersion.fetch_add(1, std::memory_order_release);
+
+    NetworkView* halfA = nullptr;
+    NetworkView* halfB = nullptr;
+    if (snapshots.detachAll(halfA, halfB)) {
+        heap_caps_free(halfA);
+        heap_caps_free(halfB);
+        snapshotCapacity = 0;
+    }
     Serial.println("[RECON] Networks vector freed");
 }
 
@@ -891,7 +1139,7 @@ void resume() {
     
     // Re-enable promiscuous
     esp_wifi_set_promiscuous_rx_cb(promiscuousCallback);
-    esp_wifi_set_promiscuous_filter(nullptr);
+    applyFrameFilter();
     esp_wifi_set_promiscuous(true);
     esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
     
@@ -914,7 +1162,8 @@ void update() {
     
     uint32_t now = millis();
     
-    // Process deferred events from callback
+    // Keep eviction keys current, then process deferred events from callback
+    refreshEvictionKeys(now);
     processDeferredEvents();
     
     // Channel hopping
@@ -934,6 +1183,14 @@ void update() {
         // new differently-sized block on next growth, creating fragmentation.
         // Capacity is only released in freeNetworks() on mode exit.
     }
+
+    // Republish the reader snapshot after this loop's adds/removals
+    if (now - lastSnapshotTime >= SNAPSHOT_PUBLISH_MS) {
+        publishSnapshot(now);
+        lastSnapshotTime = now;
+    }
+    
+    ReconMetrics::update(now);
     
     // Check heap stabilization
     if (!heapStabilized) {
@@ -984,9 +1241,55 @@ uint32_t getPacketCount() {
     return packetCount;
 }
 
+CleanupStats getCleanupStats() {
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    if (mhz == 0) mhz = 240;
+    CleanupStats stats;
+    stats.passes = cleanupPasses;
+    stats.lastRemoved = cleanupLastRemoved;
+    stats.lastHoldUs = cleanupLastHoldCycles / mhz;
+    stats.maxHoldUs = cleanupMaxHoldCycles / mhz;
+    return stats;
+}
+
+SnapshotStats getSnapshotStats() {
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    if (mhz == 0) mhz = 240;
+    SnapshotStats stats;
+    stats.published = snapshots.generation();
+    stats.busySkips = snapshots.getBusySkips();
+    stats.capacity = snapshotCapacity;
+    stats.truncated = snapshotTruncated;
+    stats.lastHoldUs = snapshotLastHoldCycles / mhz;
+    stats.maxHoldUs = snapshotMaxHoldCycles / mhz;
+    return stats;
+}
+
+RxRingStats getRxRingStats() {
+    RxRingStats stats;
+    stats.enqueued = rxRing.getPushed();
+    stats.dispatched = rxRing.getPopped();
+    stats.dropped = rxRing.getDropped();
+    stats.truncated = rxTruncated.load(std::memory_order_relaxed);
+    stats.highWaterBytes = rxRing.getHighWater();
+    stats.capacityBytes = rxRing.capacity();
+    stats.workerActive = rxWorkerHandle != nullptr;
+    return stats;
+}
+
+RxFilterStats getRxFilterStats() {
+    RxFilterStats stats;
+    stats.mgmt = rxSeen[WIFI_PKT_MGMT].load(std::memory_order_relaxed);
+    stats.ctrl = rxSeen[WIFI_PKT_CTRL].load(std::memory_order_relaxed);
+    stats.data = rxSeen[WIFI_PKT_DATA].load(std::memory_order_relaxed);
+    stats.misc = rxSeen[WIFI_PKT_MISC].load(std::memory_order_relaxed);
+    stats.filtered = rxFiltered.load(std::memory_order_relaxed);
+    stats.interest = activeInterest.load(std::memory_order_relaxed);
+    return stats;
+}
+
 uint8_t estimateClientCount(const DetectedNetwork& net) {
-    return (uint8_t)(__builtin_popcountll(net.clientBitset) +
-                     __builtin_popcountll(net.clientBitsetHigh));
+    return net.clients.estimate(millis());
 }
 
 static inline uint8_t scoreRssi(int8_t rssi) {
@@ -1009,6 +1312,13 @@ static inline uint8_t scoreActivity(uint32_t ageMs) {
     return 0;
 }
 
+static inline uint8_t scoreClients(uint8_t clients) {
+    if (clients == 0) return 0;
+    if (clients == 1) return 4;
+    if (clients <= 3) return 7;
+    return 10;
+}
+
 static inline uint8_t scoreBeaconStability(uint16_t intervalEmaMs) {
     if (intervalEmaMs == 0) return 0;
     if (intervalEmaMs <= 150) return 10;
@@ -1028,6 +1338,7 @@ uint8_t getQualityScore(const DetectedNetwork& net) {
     if (dataAge != 0xFFFFFFFFu) {
         score += scoreActivity(dataAge);
     }
+    score += scoreClients(net.clients.estimate(now));
     score += scoreBeaconStability(net.beaconIntervalEmaMs);
     if (score > 100) score = 100;
     return score;
@@ -1042,24 +1353,51 @@ uint16_t getNetworkCount() {
 }
 
 bool findNetwork(const uint8_t* bssid, DetectedNetwork* out) {
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
     int idx = findNetworkInternal(bssid);
     bool found = (idx >= 0 && idx < (int)networks.size());
     if (found && out) {
         // Copy to caller's buffer while holding lock - pointer becomes invalid after unlock
         *out = networks[idx];
     }
-    taskEXIT_CRITICAL(&vectorMux);
+    unlockNetworks();
     return found;
 }
 
 int findNetworkIndex(const uint8_t* bssid) {
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
     int idx = findNetworkInternal(bssid);
-    taskEXIT_CRITICAL(&vectorMux);
+    unlockNetworks();
+    return idx;
+}
+
+int resolveNetworkIndex(const uint8_t* bssid, int hint) {
+    if (!bssid) return -1;
+    lockNetworks();
+    int idx = hint;
+    if (idx < 0 || idx >= (int)networks.size() || memcmp(networks[idx].bssid, bssid, 6) != 0) {
+        idx = findNetworkInternal(bssid);
+    }
+    unlockNetworks();
     return idx;
 }
 
+uint32_t getLayoutVersion() {
+    return layoutVersion.load(std::memory_order_acquire);
+}
+
+void reindexNetworks() {
+    networkIndex.rebuild(networks);
+    rebuildHot();
+    layoutVersion.fetch_add(1, std::memory_order_release);
+}
+
+void syncNetwork(int idx) {
+    if (idx >= 0) {
+        syncHot((size_t)idx);
+    }
+}
+
 void lockChannel(uint8_t channel) {
     if (channel < 1 || channel > 14) return;
 
@@ -1086,20 +1424,66 @@ void setChannel(uint8_t channel) {
     esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
 }
 
-void setPacketCallback(PacketCallback callback) {
+void setPacketCallback(PacketCallback callback, uint32_t interest) {
+    modeInterest.store(callback ? interest : 0, std::memory_order_relaxed);
+    if (running && !paused) {
+        // Widen before the new callback can run; narrowing after is harmless
+        applyFrameFilter();
+    }
     modeCallback = callback;
+    
+    // The old callback may still be running on the RX worker. Wait it out so
+    // a mode can free its state right after clearing the callback.
+    if (rxWorkerHandle && xTaskGetCurrentTaskHandle() != rxWorkerHandle) {
+        uint32_t waitStart = millis();
+        while (rxDispatching.load() && millis() - waitStart < 50) {
+            vTaskDelay(1);
+        }
+    }
+}
+
+const BeaconSummary& summarizeBeacon(const uint8_t* frame, uint16_t len, BeaconSummary& scratch) {
+    if (frame && frame == dispatchFrame && dispatchSummary) {
+        return *dispatchSummary;
+    }
+    BeaconParser::parseBeacon(frame, len, scratch);
+    return scratch;
 }
 
 void setNewNetworkCallback(NewNetworkCallback callback) {
     newNetworkCallback = callback;
 }
 
+Snapshot::Snapshot() {
+    SnapshotBuffer<NetworkView>::View v;
+    snapshots.acquire(v);
+    data = v.data;
+    count = v.count;
+    gen = v.generation;
+    stamp = v.stamp;
+    slot = v.slot;
+}
+
+Snapshot::~Snapshot() {
+    SnapshotBuffer<NetworkView>::View v;
+    v.slot = slot;
+    snapshots.release(v);
+}
+
+int Snapshot::find(const uint8_t* bssid) const {
+    if (!bssid) return -1;
+    for (uint16_t i = 0; i < count; i++) {
+        if (memcmp(data[i].bssid, bssid, 6) == 0) return (int)i;
+    }
+    return -1;
+}
+
 void enterCritical() {
-    taskENTER_CRITICAL(&vectorMux);
+    lockNetworks();
 }
 
 void exitCritical() {
-    taskEXIT_CRITICAL(&vectorMux);
+    unlockNetworks();
 }
 
 } // namespace NetworkRecon
@@ -6,6 +6,7 @@
 #include <Arduino.h>
 #include <esp_wifi.h>
 #include <vector>
+#include "frame_interest.h"
 
 // Maximum networks to track
 #define MAX_RECON_NETWORKS 200
@@ -20,6 +21,7 @@
 // TODO: Move these to a shared types header after full migration
 struct DetectedClient;
 struct DetectedNetwork;
+struct BeaconSummary;
 
 namespace NetworkRecon {
 
@@ -108,19 +110,71 @@ void clearHopIntervalOverride();
  */
 uint32_t getPacketCount();
 
+/**
+ * @brief Counters for the driver -> worker RX ring
+ * The WiFi callback only copies frames into the ring; a worker task on the
+ * app core parses them and runs mode callbacks.
+ */
+struct RxRingStats {
+    uint32_t enqueued;        // Frames copied in by the WiFi callback
+    uint32_t dispatched;      // Frames drained by the worker
+    uint32_t dropped;         // Ring full - frame lost (overrun)
+    uint32_t truncated;       // Bulk data frames copied header-only
+    uint32_t highWaterBytes;  // Peak ring occupancy
+    uint32_t capacityBytes;
+    bool workerActive;        // false = parsing inline in the WiFi task
+};
+
+/**
+ * @brief Snapshot RX ring counters (cumulative since boot)
+ */
+RxRingStats getRxRingStats();
+
+/**
+ * @brief Stale-cleanup pass timing (time spent holding the network lock)
+ */
+struct CleanupStats {
+    uint32_t passes;
+    uint32_t lastRemoved;
+    uint32_t lastHoldUs;
+    uint32_t maxHoldUs;       // Worst pass since boot
+};
+
+CleanupStats getCleanupStats();
+
+/**
+ * @brief Frames seen by the WiFi callback, per promiscuous type
+ * Types nobody registered interest in are filtered by the driver and never
+ * show up here; unwanted management subtypes arrive but are dropped before
+ * the RX ring (counted in filtered).
+ */
+struct RxFilterStats {
+    uint32_t mgmt;
+    uint32_t ctrl;
+    uint32_t data;
+    uint32_t misc;
+    uint32_t filtered;        // Dropped in the callback (management subtype)
+    uint32_t interest;        // FrameInterest mask currently programmed
+};
+
+/**
+ * @brief Snapshot frame filter counters (cumulative since boot)
+ */
+RxFilterStats getRxFilterStats();
+
 // ============================================================================
 // Quality + Client Estimates
 // ============================================================================
 
 /**
  * @brief Approximate unique client count for a network
- * Uses a small bitset updated from data frames (lower-bound estimate).
+ * Linear-counting sketch fed from data frames; covers the last 30-60s.
  */
 uint8_t estimateClientCount(const DetectedNetwork& net);
 
 /**
  * @brief Compute a 0-100 quality score for a network
- * Combines RSSI (smoothed), recency, activity, and beacon stability.
+ * Combines RSSI (smoothed), recency, activity, client count, and beacon stability.
  */
 uint8_t getQualityScore(const DetectedNetwork& net);
 
@@ -131,6 +185,7 @@ uint8_t getQualityScore(const DetectedNetwork& net);
 /**
  * @brief Get reference to shared networks vector
  * Thread-safe access via internal mutex
+ * Code that only reads (UI, scoring, lookups) should take a Snapshot instead.
  * @warning Do not hold reference across yield() calls
  */
 std::vector<DetectedNetwork>& getNetworks();
@@ -155,6 +210,126 @@ bool findNetwork(const uint8_t* bssid, DetectedNetwork* out);
  */
 int findNetworkIndex(const uint8_t* bssid);
 
+/**
+ * @brief Turn a cached (BSSID, index) handle back into a current index
+ * Cleanup swap-removes stale records, so indices are not stable. Returns
+ * hint if it still holds bssid, otherwise looks the BSSID up (O(1)).
+ * @return Index or -1 if the network is gone
+ */
+int resolveNetworkIndex(const uint8_t* bssid, int hint);
+
+/**
+ * @brief Changes whenever records move between slots or leave the table
+ * (cleanup, eviction, reindexNetworks(), freeNetworks()). Cache it next to
+ * a stored index and call resolveNetworkIndex() when it differs.
+ */
+uint32_t getLayoutVersion();
+
+/**
+ * @brief Rebuild the BSSID lookup index from the networks vector
+ * Call after mutating getNetworks() directly (sort, erase, push_back).
+ * @warning Caller must hold enterCritical()
+ */
+void reindexNetworks();
+
+/**
+ * @brief Refresh NetworkRecon's sweep view of one record
+ * Call after editing getNetworks()[idx] in place (isTarget, hasHandshake,
+ * cooldownUntil, ssid, lastSeen, rssi) so retention/stale sweeps see it.
+ * @warning Caller must hold enterCritical()
+ */
+void syncNetwork(int idx);
+
+// ============================================================================
+// Published Snapshot (lock-free reads)
+// ============================================================================
+
+/**
+ * @brief Read-only copy of one network, as of the last publish
+ * Field names match DetectedNetwork so scoring code can take either.
+ */
+struct NetworkView {
+    uint32_t lastSeen;
+    uint32_t lastDataSeen;
+    uint32_t cooldownUntil;
+    uint16_t beaconIntervalEmaMs;
+    uint8_t bssid[6];
+    char ssid[33];
+    int8_t rssi;
+    int8_t rssiAvg;
+    uint8_t channel;
+    uint8_t authmode;          // wifi_auth_mode_t
+    uint8_t attackAttempts;
+    uint8_t clientEstimate;    // estimateClientCount() at publish time
+    uint8_t lootTypes;         // CapturedIndex types from earlier sessions
+    bool isTarget;
+    bool hasPMF;
+    bool hasHandshake;
+    bool isHidden;
+};
+
+/**
+ * @brief Pinned view of the recon table for UI and mode readers
+ * update() republishes every 200ms into the other half of a double
+ * buffer, so taking and walking a Snapshot never enters the network lock.
+ * Indices match getNetworks() as of publish; records may have moved since,
+ * so go back to the live table through resolveNetworkIndex(bssid, i).
+ * @warning Scope it to one function - a held Snapshot stops its half of
+ * the buffer from being republished.
+ */
+class Snapshot {
+public:
+    Snapshot();
+    ~Snapshot();
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    uint16_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const NetworkView& operator[](uint16_t i) const { return data[i]; }
+    const NetworkView* begin() const { return data; }
+    const NetworkView* end() const { return data + count; }
+
+    /** @brief Publish counter (0 = nothing published yet) */
+    uint32_t generation() const { return gen; }
+    /** @brief millis() at publish */
+    uint32_t publishedAt() const { return stamp; }
+
+    /**
+     * @brief Index of a BSSID in this snapshot
+     * @return Index or -1
+     */
+    int find(const uint8_t* bssid) const;
+
+private:
+    const NetworkView* data;
+    uint16_t count;
+    uint32_t gen;
+    uint32_t stamp;
+    int8_t slot;
+};
+
+/**
+ * @brief Snapshot publish counters and time spent copying under the lock
+ */
+struct SnapshotStats {
+    uint32_t published;
+    uint32_t busySkips;       // Publish skipped: reader still held the back half
+    uint16_t capacity;        // Views per half (grows in steps with the table)
+    uint16_t truncated;       // Networks left out of the last publish (heap gate)
+    uint32_t lastHoldUs;      // Longest single lock hold in the last publish
+    uint32_t maxHoldUs;
+};
+
+SnapshotStats getSnapshotStats();
+
+/**
+ * @brief Client estimate carried in a view (for code templated on record type)
+ */
+inline uint8_t estimateClientCount(const NetworkView& view) {
+    return view.clientEstimate;
+}
+
 // ============================================================================
 // Channel Control
 // ============================================================================
@@ -186,7 +361,9 @@ void setChannel(uint8_t channel);
 
 /**
  * @brief Packet callback type for mode-specific processing
- * Called for every received packet after basic network tracking
+ * Called for every received packet after basic network tracking.
+ * Runs in the recon RX worker task (app core), not the WiFi driver task.
+ * Large data frames arrive header-only with rx_ctrl.sig_len trimmed to match.
  * @param pkt The promiscuous packet
  * @param type Packet type (MGMT, CTRL, DATA, MISC)
  */
@@ -195,9 +372,21 @@ using PacketCallback = void(*)(const wifi_promiscuous_pkt_t* pkt, wifi_promiscuo
 /**
  * @brief Register callback for mode-specific packet processing
  * Only one callback active at a time (last registration wins)
- * Pass nullptr to clear callback
+ * Pass nullptr to clear callback. Returns once any in-flight call to the
+ * previous callback has finished.
+ * @param interest FrameInterest mask of frames the callback reads. It is
+ * ORed with recon's own and pushed down to the driver filter, so frames
+ * outside the union never reach the RX ring (or the callback).
+ */
+void setPacketCallback(PacketCallback callback, uint32_t interest = FrameInterest::kAll);
+
+/**
+ * @brief Get the IE summary for a beacon / probe response frame
+ * Inside a PacketCallback, returns the summary NetworkRecon already built
+ * for this frame (no second IE walk). Otherwise parses into scratch.
+ * @warning Only call from the packet callback; result may reference scratch
  */
-void setPacketCallback(PacketCallback callback);
+const BeaconSummary& summarizeBeacon(const uint8_t* frame, uint16_t len, BeaconSummary& scratch);
 
 /**
  * @brief New network discovery callback type
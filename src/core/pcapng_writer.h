@@ -0,0 +1,259 @@
+// PcapngWriter - Buffered pcapng (IEEE 802.11 + radiotap) capture writer
+// Shared by OINK, DO NO HAM and PigSync for the per-network .pcap exports.
+// Emits one Section Header Block and one Interface Description Block
+// (LINKTYPE_IEEE802_11_RADIOTAP, microsecond timestamps), then an Enhanced
+// Packet Block per frame. Each frame gets a radiotap header carrying the
+// fields the capture actually knows: TSFT (ESP32 RX timer), channel and
+// dBm antenna signal.
+//
+// Output is staged in a fixed 512-byte block buffer and handed to the sink
+// only in whole blocks (plus one short tail from finish()), so the SD
+// layer sees sector-sized writes instead of three small writes per packet.
+//
+// Byte order is little-endian (the byte-order magic tells readers). File
+// names keep the .pcap suffix: Wireshark, libpcap and hcxpcapngtool pick
+// the format from the magic, not the extension.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Per-frame radio metadata (zero / false = unknown, field omitted)
+struct PcapngPacketMeta {
+    uint64_t timestampUs = 0;   // EPB timestamp
+    uint64_t tsft = 0;          // Radiotap TSFT (RX timer, microseconds)
+    bool hasTsft = false;
+    uint8_t channel = 0;        // 802.11 channel number
+    int8_t rssi = 0;            // dBm antenna signal
+};
+
+class PcapngWriter {
+public:
+    /**
+     * @brief Receives buffered output
+     * @return Bytes accepted (anything short of len marks the writer failed)
+     */
+    typedef size_t (*Sink)(void* ctx, const uint8_t* data, size_t len);
+
+    static constexpr size_t kBlockBytes = 512;
+    static constexpr uint16_t kLinkTypeRadiotap = 127;
+    static constexpr uint32_t kSnapLen = 65535;
+
+    static constexpr uint32_t kShbType = 0x0A0D0D0A;
+    static constexpr uint32_t kIdbType = 0x00000001;
+    static constexpr uint32_t kEpbType = 0x00000006;
+    static constexpr uint32_t kByteOrderMagic = 0x1A2B3C4D;
+
+    // Radiotap present bits
+    static constexpr uint32_t kRtTsft = 1u << 0;
+    static constexpr uint32_t kRtChannel = 1u << 3;
+    static constexpr uint32_t kRtAntSignal = 1u << 5;
+
+    // Radiotap channel flags
+    static constexpr uint16_t kChan2GHz = 0x0080;
+    static constexpr uint16_t kChan5GHz = 0x0100;
+
+    PcapngWriter(Sink sink, void* ctx) : sink(sink), ctx(ctx) {}
+
+    /**
+     * @brief Write the Section Header and Interface Description blocks
+     * @param userAppl Optional shb_userappl string (e.g. "M5PORKCHOP")
+     */
+    bool begin(const char* userAppl = nullptr) {
+        // SHB: type, len, magic, version 1.0, section length -1, options, len
+        size_t applLen = userAppl ? strlen(userAppl) : 0;
+        if (applLen > 255) applLen = 255;
+        uint32_t optBytes = applLen ? (uint32_t)(4 + pad4(applLen) + 4) : 0;
+        uint32_t shbLen = 28 + optBytes;
+        put32(kShbType);
+        put32(shbLen);
+        put32(kByteOrderMagic);
+        put16(1);
+        put16(0);
+        put32(0xFFFFFFFFu);
+        put32(0xFFFFFFFFu);
+        if (applLen) {
+            put16(4);  // shb_userappl
+            put16((uint16_t)applLen);
+            put((const uint8_t*)userAppl, applLen);
+            putZeros(pad4(applLen) - applLen);
+            put32(0);  // opt_endofopt
+        }
+        put32(shbLen);
+
+        // IDB: radiotap link type, snap length, no options (default tsresol = us)
+        put32(kIdbType);
+        put32(20);
+        put16(kLinkTypeRadiotap);
+        put16(0);
+        put32(kSnapLen);
+        put32(20);
+        return !failed;
+    }
+
+    /**
+     * @brief Write one 802.11 frame as an Enhanced Packet Block
+     */
+    bool writePacket(const uint8_t* frame, uint16_t len, const PcapngPacketMeta& meta) {
+        beginPacket(len, meta);
+        appendPacketData(frame, len);
+        return endPacket();
+    }
+
+    /**
+     * @brief Start an EPB whose frame bytes arrive in pieces
+     * Follow with appendPacketData() totalling frameLen, then endPacket().
+     */
+    void beginPacket(uint16_t frameLen, const PcapngPacketMeta& meta) {
+        uint16_t rtLen = radiotapLength(meta);
+        uint32_t capLen = (uint32_t)rtLen + frameLen;
+        pendingPad = pad4(capLen) - capLen;
+        pendingBlockLen = 32 + capLen + pendingPad;
+
+        put32(kEpbType);
+        put32(pendingBlockLen);
+        put32(0);  // Interface 0
+        put32((uint32_t)(meta.timestampUs >> 32));
+        put32((uint32_t)meta.timestampUs);
+        put32(capLen);
+        put32(capLen);
+        writeRadiotap(meta, rtLen);
+    }
+
+    void appendPacketData(const uint8_t* data, size_t len) {
+        put(data, len);
+    }
+
+    bool endPacket() {
+        putZeros(pendingPad);
+        put32(pendingBlockLen);
+        return !failed;
+    }
+
+    /**
+     * @brief Hand the buffered tail to the sink
+     * @return false if any sink write came up short
+     */
+    bool finish() {
+        flushBuffer();
+        return !failed;
+    }
+
+    bool ok() const { return !failed; }
+    size_t bytesWritten() const { return written; }
+
+    /**
+     * @brief Radiotap header length for meta (8-byte header + aligned fields)
+     */
+    static uint16_t radiotapLength(const PcapngPacketMeta& meta) {
+        uint16_t n = 8;
+        if (meta.hasTsft) n = (uint16_t)(align(n, 8) + 8);
+        if (meta.channel) n = (uint16_t)(align(n, 2) + 4);
+        if (meta.rssi) n = (uint16_t)(n + 1);
+        return n;
+    }
+
+    /**
+     * @brief Centre frequency (MHz) of an 802.11 channel number
+     */
+    static uint16_t channelFrequency(uint8_t channel) {
+        if (channel == 14) return 2484;
+        if (channel >= 1 && channel <= 13) return (uint16_t)(2407 + 5 * channel);
+        if (channel > 14) return (uint16_t)(5000 + 5 * channel);
+        return 0;
+    }
+
+private:
+    static size_t pad4(size_t n) { return (n + 3) & ~(size_t)3; }
+    static uint16_t align(uint16_t n, uint16_t a) { return (uint16_t)((n + a - 1) & ~(a - 1)); }
+
+    void writeRadiotap(const PcapngPacketMeta& meta, uint16_t rtLen) {
+        uint32_t present = 0;
+        if (meta.hasTsft) present |= kRtTsft;
+        if (meta.channel) present |= kRtChannel;
+        if (meta.rssi) present |= kRtAntSignal;
+
+        put8(0);  // Version
+        put8(0);  // Pad
+        put16(rtLen);
+        put32(present);
+        uint16_t n = 8;
+        if (meta.hasTsft) {
+            putZeros(align(n, 8) - n);
+            n = align(n, 8);
+            put64(meta.tsft);
+            n += 8;
+        }
+        if (meta.channel) {
+            putZeros(align(n, 2) - n);
+            n = align(n, 2);
+            put16(channelFrequency(meta.channel));
+            put16(meta.channel > 14 ? kChan5GHz : kChan2GHz);
+            n += 4;
+        }
+        if (meta.rssi) {
+            put8((uint8_t)meta.rssi);
+        }
+    }
+
+    void put(const uint8_t* data, size_t len) {
+        while (len > 0) {
+            size_t room = kBlockBytes - used;
+            size_t n = len < room ? len : room;
+            memcpy(buffer + used, data, n);
+            used += n;
+            data += n;
+            len -= n;
+            if (used == kBlockBytes) flushBuffer();
+        }
+    }
+
+    void putZeros(size_t len) {
+        static const uint8_t zeros[8] = {0};
+        while (len > 0) {
+            size_t n = len < sizeof(zeros) ? len : sizeof(zeros);
+            put(zeros, n);
+            len -= n;
+        }
+    }
+
+    void put8(uint8_t v) { put(&v, 1); }
+
+    void put16(uint16_t v) {
+        uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+        put(b, 2);
+    }
+
+    void put32(uint32_t v) {
+        uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+        put(b, 4);
+    }
+
+    void put64(uint64_t v) {
+        put32((uint32_t)v);
+        put32((uint32_t)(v >> 32));
+    }
+
+    void flushBuffer() {
+        if (used == 0) return;
+        if (!failed && sink) {
+            size_t n = sink(ctx, buffer, used);
+            written += n;
+            if (n != used) failed = true;
+        } else {
+            failed = true;
+        }
+        used = 0;
+    }
+
+    Sink sink;
+    void* ctx;
+    uint8_t buffer[kBlockBytes];
+    size_t used = 0;
+    size_t written = 0;
+    uint32_t pendingBlockLen = 0;
+    size_t pendingPad = 0;
+    bool failed = false;
+};
@@ -0,0 +1,177 @@
+// ReconMetrics - Recon pipeline instrumentation
+
+#include "recon_metrics.h"
+#include "network_recon.h"
+#include "latency_histogram.h"
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace ReconMetrics {
+
+static const uint32_t RATE_WINDOW_MS = 1000;
+
+static const char* const STAGE_KEYS[] = {"driverCb", "dispatch", "modeCb", "lockHold"};
+static_assert(sizeof(STAGE_KEYS) / sizeof(STAGE_KEYS[0]) == (size_t)Stage::Count,
+              "STAGE_KEYS must cover every Stage");
+
+// Frame rates are derived from NetworkRecon's cumulative RX counters
+static NetworkRecon::RxFilterStats lastRx = {};
+static uint32_t lastRateMs = 0;
+static FrameRates rates = {};
+
+#if PORKCHOP_METRICS_ENABLED
+
+// One writer per histogram (WiFi task, RX worker, or the vectorMux holder)
+static LatencyHistogram stages[(size_t)Stage::Count];
+static std::atomic<uint32_t> counters[(size_t)Counter::Count];
+static std::atomic<uint32_t> highWaters[(size_t)Gauge::Count];
+
+// Guarded by vectorMux itself - only the holder touches these
+static uint8_t lockDepth = 0;
+static uint32_t lockTakenAt = 0;
+
+void end(Stage stage, uint32_t startedAt) {
+    stages[(size_t)stage].record(ESP.getCycleCount() - startedAt);
+}
+
+void count(Counter counter) {
+    counters[(size_t)counter].fetch_add(1, std::memory_order_relaxed);
+}
+
+void highWater(Gauge gauge, uint32_t value) {
+    std::atomic<uint32_t>& hw = highWaters[(size_t)gauge];
+    uint32_t cur = hw.load(std::memory_order_relaxed);
+    while (value > cur && !hw.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+    }
+}
+
+void lockAcquired() {
+    if (lockDepth++ == 0) {
+        lockTakenAt = ESP.getCycleCount();
+    }
+}
+
+void lockReleased() {
+    if (lockDepth == 0) return;
+    if (--lockDepth == 0) {
+        stages[(size_t)Stage::LockHold].record(ESP.getCycleCount() - lockTakenAt);
+    }
+}
+
+static float cyclesToUs(uint32_t cycles) {
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    if (mhz == 0) mhz = 240;
+    return (float)cycles / (float)mhz;
+}
+
+bool getStage(Stage stage, StageSummary& out) {
+    LatencyHistogram h = stages[(size_t)stage];  // Copy: writers keep running
+    out.count = h.count;
+    out.meanUs = cyclesToUs(h.meanCycles());
+    out.p50Us = cyclesToUs(h.percentile(50));
+    out.p99Us = cyclesToUs(h.percentile(99));
+    out.maxUs = cyclesToUs(h.maxCycles);
+    return h.count > 0;
+}
+
+uint32_t getCounter(Counter counter) {
+    return counters[(size_t)counter].load(std::memory_order_relaxed);
+}
+
+uint32_t getHighWater(Gauge gauge) {
+    return highWaters[(size_t)gauge].load(std::memory_order_relaxed);
+}
+
+void reset() {
+    for (size_t i = 0; i < (size_t)Stage::Count; i++) stages[i].reset();
+    for (size_t i = 0; i < (size_t)Counter::Count; i++) counters[i].store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < (size_t)Gauge::Count; i++) highWaters[i].store(0, std::memory_order_relaxed);
+}
+
+#else
+
+bool getStage(Stage, StageSummary& out) {
+    out = StageSummary();
+    return false;
+}
+
+uint32_t getCounter(Counter) { return 0; }
+uint32_t getHighWater(Gauge) { return 0; }
+void reset() {}
+
+#endif
+
+void update(uint32_t nowMs) {
+    if (!kEnabled) return;
+    uint32_t elapsed = nowMs - lastRateMs;
+    if (elapsed < RATE_WINDOW_MS) return;
+
+    NetworkRecon::RxFilterStats rx = NetworkRecon::getRxFilterStats();
+    if (lastRateMs != 0) {
+        rates.mgmt = (rx.mgmt - lastRx.mgmt) * 1000 / elapsed;
+        rates.ctrl = (rx.ctrl - lastRx.ctrl) * 1000 / elapsed;
+        rates.data = (rx.data - lastRx.data) * 1000 / elapsed;
+        rates.misc = (rx.misc - lastRx.misc) * 1000 / elapsed;
+        rates.filtered = (rx.filtered - lastRx.filtered) * 1000 / elapsed;
+    }
+    lastRx = rx;
+    lastRateMs = nowMs;
+}
+
+FrameRates getFrameRates() {
+    return rates;
+}
+
+static void appendf(char* buf, size_t len, size_t& pos, const char* fmt, ...) {
+    if (pos >= len) return;
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + pos, len - pos, fmt, args);
+    va_end(args);
+    if (n > 0) pos += (size_t)n;
+}
+
+size_t formatJson(char* buf, size_t len) {
+    if (!buf || len == 0) return 0;
+    if (!kEnabled) {
+        int n = snprintf(buf, len, "{\"enabled\":false}");
+        return n < 0 ? 0 : ((size_t)n < len ? (size_t)n : len - 1);
+    }
+
+    size_t pos = 0;
+    appendf(buf, len, pos, "{\"enabled\":true,\"uptimeMs\":%lu,\"stages\":{", (unsigned long)millis());
+    for (size_t i = 0; i < (size_t)Stage::Count; i++) {
+        StageSummary s;
+        getStage((Stage)i, s);
+        appendf(buf, len, pos, "%s\"%s\":{\"n\":%lu,\"meanUs\":%.1f,\"p50Us\":%.1f,\"p99Us\":%.1f,\"maxUs\":%.1f}",
+            i ? "," : "", STAGE_KEYS[i], (unsigned long)s.count,
+            s.meanUs, s.p50Us, s.p99Us, s.maxUs);
+    }
+
+    FrameRates fps = getFrameRates();
+    appendf(buf, len, pos, "},\"fps\":{\"mgmt\":%lu,\"ctrl\":%lu,\"data\":%lu,\"misc\":%lu,\"filtered\":%lu}",
+        (unsigned long)fps.mgmt, (unsigned long)fps.ctrl, (unsigned long)fps.data,
+        (unsigned long)fps.misc, (unsigned long)fps.filtered);
+
+    NetworkRecon::RxRingStats ring = NetworkRecon::getRxRingStats();
+    appendf(buf, len, pos, ",\"ring\":{\"enqueued\":%lu,\"dropped\":%lu,\"truncated\":%lu,\"highWaterBytes\":%lu,\"capacityBytes\":%lu}",
+        (unsigned long)ring.enqueued, (unsigned long)ring.dropped, (unsigned long)ring.truncated,
+        (unsigned long)ring.highWaterBytes, (unsigned long)ring.capacityBytes);
+
+    appendf(buf, len, pos, ",\"pendingNets\":{\"highWater\":%lu,\"dropped\":%lu},\"ssidOverwrites\":%lu",
+        (unsigned long)getHighWater(Gauge::PendingNetDepth),
+        (unsigned long)getCounter(Counter::PendingNetDrop),
+        (unsigned long)getCounter(Counter::PendingSsidOverwrite));
+
+    NetworkRecon::CleanupStats cleanup = NetworkRecon::getCleanupStats();
+    NetworkRecon::SnapshotStats snap = NetworkRecon::getSnapshotStats();
+    appendf(buf, len, pos, ",\"cleanupMaxHoldUs\":%lu,\"snapshotMaxHoldUs\":%lu,\"snapshotBusySkips\":%lu}",
+        (unsigned long)cleanup.maxHoldUs, (unsigned long)snap.maxHoldUs,
+        (unsigned long)snap.busySkips);
+
+    if (pos >= len) pos = len - 1;
+    return pos;
+}
+
+} // namespace ReconMetrics
@@ -0,0 +1,101 @@
+// ReconMetrics - Recon pipeline instrumentation
+// Cycle-counter latency histograms per pipeline stage, spinlock hold times,
+// queue high-water marks, drop counters and frames/sec by type. Read from
+// the diagnostics menu ([M]) and GET /api/metrics on the file server.
+//
+// Compile-time switch: build with -DPORKCHOP_METRICS_ENABLED=1 (the debug
+// env does). Compiled out, every recording hook below is an empty inline
+// and the readers report zeros / {"enabled":false}.
+#pragma once
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PORKCHOP_METRICS_ENABLED
+#define PORKCHOP_METRICS_ENABLED 0
+#endif
+
+namespace ReconMetrics {
+
+static constexpr bool kEnabled = PORKCHOP_METRICS_ENABLED != 0;
+
+enum class Stage : uint8_t {
+    DriverCallback = 0,  // WiFi task: filter + ring copy
+    Dispatch,            // RX worker: recon's own parse + table update
+    ModeCallback,        // RX worker: active mode's packet callback
+    LockHold,            // Any vectorMux hold (outermost)
+    Count
+};
+
+enum class Counter : uint8_t {
+    PendingNetDrop = 0,     // New network lost: pending add queue full
+    PendingSsidOverwrite,   // Unconsumed SSID reveal overwritten
+    Count
+};
+
+enum class Gauge : uint8_t {
+    PendingNetDepth = 0,    // Pending add queue occupancy
+    Count
+};
+
+struct StageSummary {
+    uint32_t count;
+    float meanUs;
+    float p50Us;
+    float p99Us;
+    float maxUs;
+};
+
+struct FrameRates {
+    uint32_t mgmt;          // Frames/sec seen by the WiFi callback
+    uint32_t ctrl;
+    uint32_t data;
+    uint32_t misc;
+    uint32_t filtered;      // Dropped by the management subtype filter
+};
+
+#if PORKCHOP_METRICS_ENABLED
+
+inline uint32_t begin() { return ESP.getCycleCount(); }
+void end(Stage stage, uint32_t startedAt);
+void count(Counter counter);
+void highWater(Gauge gauge, uint32_t value);
+
+// Bracket every vectorMux hold (call while holding it); nesting-safe
+void lockAcquired();
+void lockReleased();
+
+#else
+
+inline uint32_t begin() { return 0; }
+inline void end(Stage, uint32_t) {}
+inline void count(Counter) {}
+inline void highWater(Gauge, uint32_t) {}
+inline void lockAcquired() {}
+inline void lockReleased() {}
+
+#endif
+
+/**
+ * @brief Roll frames/sec (call from the main loop; rate-limited internally)
+ */
+void update(uint32_t nowMs);
+
+bool getStage(Stage stage, StageSummary& out);
+uint32_t getCounter(Counter counter);
+uint32_t getHighWater(Gauge gauge);
+FrameRates getFrameRates();
+
+/**
+ * @brief Clear histograms, counters and high-water marks
+ */
+void reset();
+
+/**
+ * @brief Everything above plus RX ring / cleanup / snapshot stats as JSON
+ * @return Bytes written (excluding terminator)
+ */
+size_t formatJson(char* buf, size_t len);
+
+} // namespace ReconMetrics
@@ -0,0 +1,117 @@
+// ScoreBuckets - Bucket queue over small integer scores, indexed by slot
+// Used by NetworkRecon to find the lowest-retention network without scoring
+// the whole table. One intrusive doubly linked list per score value:
+// update/remove are O(1), and finding the minimum walks at most the score
+// range from a cached low-water bucket (usually zero or one step).
+//
+// Header-only and Arduino-free so the native test suite can exercise it.
+// No allocation: (kSlots * 5 + buckets * 2) bytes inline.
+#pragma once
+
+#include <cstdint>
+
+template <uint16_t kSlots, int kMinScore, int kMaxScore>
+class ScoreBuckets {
+    static_assert(kMaxScore > kMinScore, "ScoreBuckets needs a non-empty score range");
+    static_assert(kMaxScore - kMinScore < 255, "ScoreBuckets bucket id must fit in uint8_t");
+    static_assert(kSlots < 0xFFFF, "ScoreBuckets slot 0xFFFF is the list terminator");
+
+public:
+    static constexpr uint16_t kNone = 0xFFFF;
+    static constexpr uint8_t kNoBucket = 0xFF;
+    static constexpr uint8_t kBuckets = (uint8_t)(kMaxScore - kMinScore + 1);
+
+    ScoreBuckets() { clear(); }
+
+    void clear() {
+        for (uint16_t b = 0; b < kBuckets; b++) head[b] = kNone;
+        for (uint16_t s = 0; s < kSlots; s++) bucketOf[s] = kNoBucket;
+        count = 0;
+        lowBucket = kBuckets;
+    }
+
+    uint16_t size() const { return count; }
+
+    bool contains(uint16_t slot) const {
+        return slot < kSlots && bucketOf[slot] != kNoBucket;
+    }
+
+    /**
+     * @brief Insert a slot or move it to a new score (clamped to range)
+     */
+    void update(uint16_t slot, int score) {
+        if (slot >= kSlots) return;
+        uint8_t b = bucketFor(score);
+        uint8_t cur = bucketOf[slot];
+        if (cur == b) return;
+        if (cur != kNoBucket) {
+            unlink(slot, cur);
+        } else {
+            count++;
+        }
+        link(slot, b);
+    }
+
+    /**
+     * @brief Drop a slot (no-op if absent)
+     */
+    void remove(uint16_t slot) {
+        if (!contains(slot)) return;
+        unlink(slot, bucketOf[slot]);
+        bucketOf[slot] = kNoBucket;
+        count--;
+    }
+
+    /**
+     * @brief Lowest-scoring slot (ties: most recently keyed first)
+     * @param score Stored score of the returned slot (clamped)
+     * @return Slot, or -1 if empty
+     */
+    int peekMin(int& score) {
+        while (lowBucket < kBuckets && head[lowBucket] == kNone) {
+            lowBucket++;
+        }
+        if (lowBucket >= kBuckets) return -1;
+        score = (int)lowBucket + kMinScore;
+        return head[lowBucket];
+    }
+
+    /**
+     * @brief Stored score for a slot
+     * @return false if the slot is not queued
+     */
+    bool scoreOf(uint16_t slot, int& score) const {
+        if (!contains(slot)) return false;
+        score = (int)bucketOf[slot] + kMinScore;
+        return true;
+    }
+
+private:
+    uint16_t head[kBuckets];
+    uint16_t next[kSlots];
+    uint16_t prev[kSlots];
+    uint8_t bucketOf[kSlots];
+    uint16_t count = 0;
+    uint8_t lowBucket = kBuckets;   // No non-empty bucket below this
+
+    static uint8_t bucketFor(int score) {
+        if (score < kMinScore) score = kMinScore;
+        if (score > kMaxScore) score = kMaxScore;
+        return (uint8_t)(score - kMinScore);
+    }
+
+    void link(uint16_t slot, uint8_t b) {
+        prev[slot] = kNone;
+        next[slot] = head[b];
+        if (head[b] != kNone) prev[head[b]] = slot;
+        head[b] = slot;
+        bucketOf[slot] = b;
+        if (b < lowBucket) lowBucket = b;
+    }
+
+    void unlink(uint16_t slot, uint8_t b) {
+        if (prev[slot] != kNone) next[prev[slot]] = next[slot];
+        else head[b] = next[slot];
+        if (next[slot] != kNone) prev[next[slot]] = prev[slot];
+    }
+};
@@ -16,6 +16,7 @@ static constexpr const char* kLegacyModels = "/models";
 static constexpr const char* kLegacyLogs = "/logs";
 static constexpr const char* kLegacyCrash = "/crash";
 static constexpr const char* kLegacyScreenshots = "/screenshots";
+static constexpr const char* kLegacyJournal = "/journal";
 
 static constexpr const char* kNewHandshakes = "/m5porkchop/handshakes";
 static constexpr const char* kNewWardriving = "/m5porkchop/wardriving";
@@ -30,6 +31,7 @@ static constexpr const char* kNewXp = "/m5porkchop/xp";
 static constexpr const char* kNewMisc = "/m5porkchop/misc";
 static constexpr const char* kNewConfig = "/m5porkchop/config";
 static constexpr const char* kNewMeta = "/m5porkchop/meta";
+static constexpr const char* kNewJournal = "/m5porkchop/journal";
 
 static constexpr const char* kLegacyConfig = "/porkchop.conf";
 static constexpr const char* kLegacyPersonality = "/personality.json";
@@ -46,6 +48,8 @@ static constexpr const char* kLegacyHeapLog = "/heap_log.txt";
 static constexpr const char* kLegacyHeapWatermarks = "/heap_wm.bin";
 static constexpr const char* kLegacyWpasecKey = "/wpasec_key.txt";
 static constexpr const char* kLegacyWigleKey = "/wigle_key.txt";
+static constexpr const char* kLegacyHashExport = "/porkchop_all.hc22000";
+static constexpr const char* kLegacyCapturedIndex = "/captured.idx";
 
 static constexpr const char* kNewConfigPath = "/m5porkchop/config/porkchop.conf";
 static constexpr const char* kNewPersonalityPath = "/m5porkchop/config/personality.json";
@@ -62,6 +66,8 @@ static constexpr const char* kNewHeapLog = "/m5porkchop/diagnostics/heap_log.txt
 static constexpr const char* kNewHeapWatermarks = "/m5porkchop/diagnostics/heap_wm.bin";
 static constexpr const char* kNewWpasecKey = "/m5porkchop/wpa-sec/wpasec_key.txt";
 static constexpr const char* kNewWigleKey = "/m5porkchop/wigle/wigle_key.txt";
+static constexpr const char* kNewHashExport = "/m5porkchop/wpa-sec/porkchop_all.hc22000";
+static constexpr const char* kNewCapturedIndex = "/m5porkchop/meta/captured.idx";
 
 // Use mutex to protect shared state
 static portMUX_TYPE layoutMutex = portMUX_INITIALIZER_UNLOCKED;
@@ -444,6 +450,7 @@ const char* xpDir() { return usingNewLayout() ? kNewXp : "/"; }
 const char* miscDir() { return usingNewLayout() ? kNewMisc : "/"; }
 const char* configDir() { return usingNewLayout() ? kNewConfig : "/"; }
 const char* metaDir() { return usingNewLayout() ? kNewMeta : "/"; }
+const char* journalDir() { return usingNewLayout() ? kNewJournal : kLegacyJournal; }
 
 const char* configPathSD() { return usingNewLayout() ? kNewConfigPath : kLegacyConfig; }
 const char* personalityPathSD() { return usingNewLayout() ? kNewPersonalityPath : kLegacyPersonality; }
@@ -460,6 +467,8 @@ const char* heapLogPath() { return usingNewLayout() ? kNewHeapLog : kLegacyHeapL
 const char* heapWatermarksPath() { return usingNewLayout() ? kNewHeapWatermarks : kLegacyHeapWatermarks; }
 const char* wpasecKeyPath() { return usingNewLayout() ? kNewWpasecKey : kLegacyWpasecKey; }
 const char* wigleKeyPath() { return usingNewLayout() ? kNewWigleKey : kLegacyWigleKey; }
+const char* hashExportPath() { return usingNewLayout() ? kNewHashExport : kLegacyHashExport; }
+const char* capturedIndexPath() { return usingNewLayout() ? kNewCapturedIndex : kLegacyCapturedIndex; }
 
 const char* legacyConfigPath() { return kLegacyConfig; }
 const char* legacyPersonalityPath() { return kLegacyPersonality; }
@@ -516,6 +525,7 @@ void ensureDirs() {
         if (!SD.exists(kLegacyWardriving)) SD.mkdir(kLegacyWardriving);
         if (!SD.exists(kLegacyModels)) SD.mkdir(kLegacyModels);
         if (!SD.exists(kLegacyLogs)) SD.mkdir(kLegacyLogs);
+        if (!SD.exists(kLegacyJournal)) SD.mkdir(kLegacyJournal);
         return;
     }
 
@@ -533,6 +543,7 @@ void ensureDirs() {
     ensureDir(kNewMisc);
     ensureDir(kNewConfig);
     ensureDir(kNewMeta);
+    ensureDir(kNewJournal);
 }
 
 bool migrateIfNeeded() {
@@ -26,6 +26,7 @@ namespace SDLayout {
     const char* miscDir();
     const char* configDir();
     const char* metaDir();
+    const char* journalDir();            // OINK session capture journals
 
     // Files (resolved to legacy or new layout)
     const char* configPathSD();
@@ -43,6 +44,8 @@ namespace SDLayout {
     const char* heapWatermarksPath();
     const char* wpasecKeyPath();
     const char* wigleKeyPath();
+    const char* hashExportPath();         // Merged, deduplicated 22000 export
+    const char* capturedIndexPath();      // Sorted (BSSID, capture type) index
 
     // Legacy paths (explicit, for fallback imports)
     const char* legacyConfigPath();
@@ -0,0 +1,254 @@
+// SeenFilter - Fixed-memory "seen this session" set with best signal per AP
+// Replaces WARHOG's 4KB seen Bloom filter. The Bloom logged a BSSID once,
+// at wherever it was first heard (often -90 dBm from far away), could
+// never revise that, and past ~5k APs its false positives silently
+// dropped new networks (~6% at 10k, most of them by 30k).
+//
+// Cuckoo filter: 4-slot buckets of 16-bit entries, each a 12-bit BSSID
+// fingerprint plus a 4-bit signal level (5 dB steps). An AP lives in one
+// of two buckets, so a lookup reads 8 slots. False positives stay near
+// 8 / 4096 (~0.2%) at full load instead of growing with the session.
+// When both buckets are full, residents are kicked to their alternate
+// bucket; if that chain runs out, one resident is dropped. The only cost
+// of a drop is a second record for that AP if it is heard again - on a
+// drive the dropped AP is almost always one left far behind.
+//
+// Level 0 marks an AP that was seen but not written (no GPS fix yet), so
+// it is recorded as soon as there is a fix instead of never.
+//
+// Storage is caller-owned (static, no heap). Not thread-safe: main loop.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+class SeenFilter {
+public:
+    static constexpr uint8_t kSlotsPerBucket = 4;
+    static constexpr uint8_t kLevelBits = 4;
+    static constexpr uint16_t kLevelMask = (1u << kLevelBits) - 1;
+    static constexpr uint8_t kLevelDb = 5;          // Signal step per level
+    static constexpr uint8_t kMaxKicks = 64;        // Relocations before a drop
+
+    enum class Result : uint8_t {
+        Repeat,     // Known, no better than its last record: nothing to do
+        New,        // First sighting this session
+        Located,    // Seen before without a record; record it now
+        Better      // Signal up by the threshold since the last record
+    };
+
+    /**
+     * @brief Bind caller-owned storage
+     * @param bytes Rounded down to a power-of-two number of buckets
+     * @param betterDb Signal gain that counts as Better (rounded to levels)
+     * @return false if storage is too small for one bucket
+     */
+    bool attach(uint16_t* storage, size_t bytes, uint8_t betterDb = 10) {
+        size_t buckets = bytes / (sizeof(uint16_t) * kSlotsPerBucket);
+        if (!storage || buckets == 0) {
+            slots = nullptr;
+            bucketMask = 0;
+            return false;
+        }
+        while (buckets & (buckets - 1)) buckets &= buckets - 1;  // Largest power of two
+        slots = storage;
+        bucketMask = (uint32_t)buckets - 1;
+        betterLevels = (uint8_t)((betterDb + kLevelDb / 2) / kLevelDb);
+        if (betterLevels == 0) betterLevels = 1;
+        clear();
+        return true;
+    }
+
+    /**
+     * @brief Forget everything (new session)
+     */
+    void clear() {
+        if (slots) memset(slots, 0, capacity() * sizeof(uint16_t));
+        count = 0;
+        drops = 0;
+        kicks = 0;
+        rng = 0x9E3779B9u;
+    }
+
+    /**
+     * @brief Record a sighting and say whether it should be written
+     * @param record true if the caller will write a record now (GPS fix);
+     *        false stores a New AP as unrecorded and never reports Better
+     */
+    Result observe(uint64_t key, int8_t rssi, bool record) {
+        if (!slots) return Result::New;
+
+        uint16_t fp;
+        uint32_t i1, i2;
+        locate(key, fp, i1, i2);
+        uint8_t level = record ? levelFor(rssi) : 0;
+
+        uint16_t* entry = find(fp, i1, i2);
+        if (!entry) {
+            insert(makeEntry(fp, level), i1);
+            return Result::New;
+        }
+        Result result = classify(*entry, level, record);
+        if (result != Result::Repeat) *entry = makeEntry(fp, level);
+        return result;
+    }
+
+    /**
+     * @brief What observe() would return, without changing anything
+     * Lets callers skip building a sighting's fields for repeats.
+     */
+    Result check(uint64_t key, int8_t rssi, bool record) const {
+        if (!slots) return Result::New;
+
+        uint16_t fp;
+        uint32_t i1, i2;
+        locate(key, fp, i1, i2);
+        const uint16_t* entry = findConst(fp, i1, i2);
+        if (!entry) return Result::New;
+        return classify(*entry, record ? levelFor(rssi) : 0, record);
+    }
+
+    /**
+     * @brief True if key (or a fingerprint twin) is in the set
+     */
+    bool contains(uint64_t key) const {
+        if (!slots) return false;
+        uint16_t fp;
+        uint32_t i1, i2;
+        locate(key, fp, i1, i2);
+        return findConst(fp, i1, i2) != nullptr;
+    }
+
+    /**
+     * @brief Delete key so its next sighting is New again
+     * @return false if it was not present
+     */
+    bool remove(uint64_t key) {
+        if (!slots) return false;
+        uint16_t fp;
+        uint32_t i1, i2;
+        locate(key, fp, i1, i2);
+        uint16_t* entry = find(fp, i1, i2);
+        if (!entry) return false;
+        *entry = 0;
+        count--;
+        return true;
+    }
+
+    /**
+     * @brief Quantised signal level 1..15 (level 0 = not recorded)
+     */
+    static uint8_t levelFor(int8_t rssi) {
+        int level = (rssi + 100) / kLevelDb + 1;
+        if (level < 1) return 1;
+        if (level > (int)kLevelMask) return (uint8_t)kLevelMask;
+        return (uint8_t)level;
+    }
+
+    size_t capacity() const { return slots ? (size_t)(bucketMask + 1) * kSlotsPerBucket : 0; }
+    size_t size() const { return count; }
+    size_t memoryBytes() const { return capacity() * sizeof(uint16_t); }
+    uint32_t getDrops() const { return drops; }     // Residents dropped at full load
+    uint32_t getKicks() const { return kicks; }     // Relocations performed
+
+private:
+    uint16_t* slots = nullptr;
+    uint32_t bucketMask = 0;
+    uint32_t count = 0;
+    uint32_t drops = 0;
+    uint32_t kicks = 0;
+    uint32_t rng = 0x9E3779B9u;
+    uint8_t betterLevels = 2;
+
+    static uint64_t mix64(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    static uint16_t makeEntry(uint16_t fp, uint8_t level) {
+        return (uint16_t)((fp << kLevelBits) | level);
+    }
+
+    // Partial-key cuckoo: the alternate bucket depends only on the current
+    // bucket and the fingerprint, so residents can move without their key
+    uint32_t altBucket(uint32_t bucket, uint16_t fp) const {
+        return (bucket ^ ((uint32_t)fp * 0x5bd1e995u)) & bucketMask;
+    }
+
+    void locate(uint64_t key, uint16_t& fp, uint32_t& i1, uint32_t& i2) const {
+        uint64_t h = mix64(key);
+        fp = (uint16_t)(h >> (64 - (16 - kLevelBits)));
+        if (fp == 0) fp = 1;  // 0 marks an empty slot
+        i1 = (uint32_t)h & bucketMask;
+        i2 = altBucket(i1, fp);
+    }
+
+    Result classify(uint16_t entry, uint8_t level, bool record) const {
+        if (!record) return Result::Repeat;
+        uint8_t best = (uint8_t)(entry & kLevelMask);
+        if (best == 0) return Result::Located;
+        if (level >= best + betterLevels) return Result::Better;
+        return Result::Repeat;
+    }
+
+    uint16_t* bucket(uint32_t i) const { return slots + (size_t)i * kSlotsPerBucket; }
+
+    const uint16_t* findConst(uint16_t fp, uint32_t i1, uint32_t i2) const {
+        const uint16_t* b1 = bucket(i1);
+        const uint16_t* b2 = bucket(i2);
+        for (uint8_t s = 0; s < kSlotsPerBucket; s++) {
+            if ((b1[s] >> kLevelBits) == fp) return &b1[s];
+            if ((b2[s] >> kLevelBits) == fp) return &b2[s];
+        }
+        return nullptr;
+    }
+
+    uint16_t* find(uint16_t fp, uint32_t i1, uint32_t i2) {
+        return const_cast<uint16_t*>(findConst(fp, i1, i2));
+    }
+
+    bool placeIn(uint32_t i, uint16_t entry) {
+        uint16_t* b = bucket(i);
+        for (uint8_t s = 0; s < kSlotsPerBucket; s++) {
+            if (b[s] == 0) {
+                b[s] = entry;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t nextRand() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    void insert(uint16_t entry, uint32_t i1) {
+        uint16_t fp = entry >> kLevelBits;
+        uint32_t i2 = altBucket(i1, fp);
+        count++;
+        if (placeIn(i1, entry) || placeIn(i2, entry)) return;
+
+        uint32_t i = (nextRand() & 1) ? i1 : i2;
+        for (uint8_t n = 0; n < kMaxKicks; n++) {
+            uint16_t* victim = bucket(i) + (nextRand() % kSlotsPerBucket);
+            uint16_t moved = *victim;
+            *victim = entry;
+            entry = moved;
+            kicks++;
+            i = altBucket(i, entry >> kLevelBits);
+            if (placeIn(i, entry)) return;
+        }
+        // Chain exhausted: the entry in hand (a random resident) is dropped
+        count--;
+        drops++;
+    }
+};
@@ -0,0 +1,153 @@
+// SessionLogBuffer - RAM staging for long-lived SD text logs
+// WARHOG used to open, printf into and close its CSV and WiGLE files once
+// per network, plus an extra open just to size() the WiGLE file for
+// rotation: about three open/close cycles per geotagged AP.
+//
+// Records are formatted into a caller-owned block instead, and written out
+// in one write() when the block passes a fill threshold, when the oldest
+// pending record gets too old, or when the session ends. Records are whole
+// or absent - a record that does not fit is rejected untouched so the
+// caller can flush and retry - so a flush never splits a CSV line.
+//
+// fileBytes() counts what is on the card plus what is pending, so rotation
+// needs no size() call. A short or failed write keeps the unwritten bytes
+// for the next flush; new records are rejected while they do not fit.
+//
+// Not thread-safe (main loop only). Header-only and Arduino-free so the
+// native test suite can exercise it.
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+class SessionLogBuffer {
+public:
+    /**
+     * @brief Attach caller-owned storage and clear everything
+     * @param flushBytes Fill level that makes a flush due (0 = 3/4 full)
+     * @param flushMs    Age of the oldest pending record that makes a flush due
+     */
+    void attach(char* storage, size_t bytes, size_t flushBytes = 0, uint32_t flushMs = 10000) {
+        buf = storage;
+        cap = storage ? bytes : 0;
+        flushAt = (flushBytes > 0 && flushBytes <= cap) ? flushBytes : cap - cap / 4;
+        maxAgeMs = flushMs;
+        begin(0);
+        resetStats();
+    }
+
+    bool attached() const { return buf != nullptr && cap > 0; }
+    size_t capacity() const { return cap; }
+
+    /**
+     * @brief Start a new file that already holds existingBytes
+     * Pending bytes are discarded - flush first.
+     */
+    void begin(uint32_t existingBytes) {
+        used = 0;
+        onCard = existingBytes;
+        oldestMs = 0;
+    }
+
+    /**
+     * @brief Append one formatted record (all or nothing)
+     * @return false if it does not fit in the free space
+     */
+    bool appendf(uint32_t nowMs, const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 3, 4)))
+#endif
+    {
+        va_list args;
+        va_start(args, fmt);
+        bool ok = vappendf(nowMs, fmt, args);
+        va_end(args);
+        return ok;
+    }
+
+    bool vappendf(uint32_t nowMs, const char* fmt, va_list args) {
+        if (!attached()) return false;
+        size_t room = cap - used;
+        int n = vsnprintf(buf + used, room, fmt, args);
+        if (n < 0 || (size_t)n >= room) {
+            // vsnprintf may have written a partial record: it stays past
+            // used, so it is never flushed and the next append overwrites it
+            return false;
+        }
+        commit(nowMs, (size_t)n);
+        return true;
+    }
+
+    /**
+     * @brief Append raw bytes as one record (all or nothing)
+     */
+    bool append(uint32_t nowMs, const char* data, size_t len) {
+        if (!attached() || len > cap - used) return false;
+        memcpy(buf + used, data, len);
+        commit(nowMs, len);
+        return true;
+    }
+
+    /**
+     * @brief True if the fill or age threshold has been reached
+     */
+    bool flushDue(uint32_t nowMs) const {
+        if (used == 0) return false;
+        return used >= flushAt || (uint32_t)(nowMs - oldestMs) >= maxAgeMs;
+    }
+
+    /**
+     * @brief Hand the pending bytes to write(const char*, size_t) -> size_t
+     * @return true if everything pending reached the card
+     */
+    template <typename Write>
+    bool flush(Write&& write) {
+        if (used == 0) return true;
+        size_t n = write(buf, used);
+        if (n > used) n = used;
+        flushes++;
+        onCard += (uint32_t)n;
+        if (n < used) {
+            memmove(buf, buf + n, used - n);
+            used -= n;
+            failedFlushes++;
+            return false;
+        }
+        used = 0;
+        return true;
+    }
+
+    size_t pending() const { return used; }
+    uint32_t fileBytes() const { return onCard + (uint32_t)used; }
+
+    uint32_t getRecords() const { return records; }
+    uint32_t getFlushes() const { return flushes; }
+    uint32_t getFailedFlushes() const { return failedFlushes; }
+
+    void resetStats() {
+        records = 0;
+        flushes = 0;
+        failedFlushes = 0;
+    }
+
+private:
+    char* buf = nullptr;
+    size_t cap = 0;
+    size_t used = 0;
+    size_t flushAt = 0;
+    uint32_t maxAgeMs = 0;
+    uint32_t onCard = 0;      // Bytes already in the file
+    uint32_t oldestMs = 0;    // Append time of the oldest pending record
+    uint32_t records = 0;
+    uint32_t flushes = 0;
+    uint32_t failedFlushes = 0;
+
+    void commit(uint32_t nowMs, size_t n) {
+        if (used == 0) oldestMs = nowMs;
+        used += n;
+        records++;
+    }
+};
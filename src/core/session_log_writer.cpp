@@ -0,0 +1,117 @@
+// SessionLogWriter implementation
+
+#include "session_log_writer.h"
+#include "sdlog.h"
+#include <stdarg.h>
+
+// SD card retry settings (SD can be busy with other operations)
+static const int SD_RETRY_COUNT = 3;
+static const int SD_RETRY_DELAY_MS = 10;
+
+SessionLogWriter::SessionLogWriter(char* storage, size_t bytes, uint32_t flushMs)
+    : dropped(0) {
+    buffer.attach(storage, bytes, 0, flushMs);
+    path[0] = '\0';
+}
+
+bool SessionLogWriter::open(const char* newPath, const char* header) {
+    return open(newPath, header, header ? strlen(header) : 0);
+}
+
+bool SessionLogWriter::open(const char* newPath, const void* header, size_t headerLen) {
+    close();
+
+    for (int retry = 0; retry < SD_RETRY_COUNT; retry++) {
+        file = SD.open(newPath, FILE_WRITE);
+        if (file) break;
+        delay(SD_RETRY_DELAY_MS);
+    }
+    if (!file) {
+        SDLog::log("LOG", "Failed to create %s", newPath);
+        return false;
+    }
+
+    if (headerLen > 0 && file.write((const uint8_t*)header, headerLen) != headerLen) {
+        SDLog::log("LOG", "Failed to write header to %s", newPath);
+        file.close();
+        return false;
+    }
+    file.flush();
+
+    strncpy(path, newPath, sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+    buffer.begin((uint32_t)headerLen);
+    dropped = 0;
+    buffer.resetStats();
+    return true;
+}
+
+void SessionLogWriter::close() {
+    if (!isOpen()) return;
+    if (!flush()) {
+        SDLog::log("LOG", "%s: %u bytes lost at close", path, (unsigned)buffer.pending());
+    }
+    if (dropped > 0) {
+        SDLog::log("LOG", "%s: %lu records dropped", path, (unsigned long)dropped);
+    }
+    Serial.printf("[LOG] Closed %s: %lu records, %lu flushes, %lu bytes\n",
+                  path, (unsigned long)buffer.getRecords(),
+                  (unsigned long)buffer.getFlushes(), (unsigned long)buffer.fileBytes());
+    file.close();
+    buffer.begin(0);
+    path[0] = '\0';
+}
+
+bool SessionLogWriter::printf(const char* fmt, ...) {
+    if (!isOpen()) return false;
+
+    uint32_t now = millis();
+    va_list args;
+    va_start(args, fmt);
+    bool ok = buffer.vappendf(now, fmt, args);
+    va_end(args);
+
+    if (!ok) {
+        // Full (or a failed write is still pending): make room and retry once
+        flush();
+        va_start(args, fmt);
+        ok = buffer.vappendf(now, fmt, args);
+        va_end(args);
+    }
+    if (!ok) {
+        dropped++;
+        return false;
+    }
+    if (buffer.flushDue(now)) flush();
+    return true;
+}
+
+bool SessionLogWriter::append(const void* data, size_t len) {
+    if (!isOpen()) return false;
+
+    uint32_t now = millis();
+    const char* bytes = (const char*)data;
+    if (!buffer.append(now, bytes, len)) {
+        flush();
+        if (!buffer.append(now, bytes, len)) {
+            dropped++;
+            return false;
+        }
+    }
+    if (buffer.flushDue(now)) flush();
+    return true;
+}
+
+void SessionLogWriter::poll() {
+    if (isOpen() && buffer.flushDue(millis())) flush();
+}
+
+bool SessionLogWriter::flush() {
+    if (!isOpen() || buffer.pending() == 0) return true;
+    bool ok = buffer.flush([this](const char* data, size_t len) {
+        return file.write((const uint8_t*)data, len);
+    });
+    // Sync so the directory entry holds the new size if power drops
+    file.flush();
+    return ok;
+}
@@ -0,0 +1,73 @@
+// SessionLogWriter - Buffered, long-lived SD log for one session
+// Keeps the file open for the whole session and batches records through a
+// SessionLogBuffer (see session_log_buffer.h): one write + sync per flush
+// instead of an open/printf/close cycle per record. Records are text lines
+// (printf) or fixed binary records (append); WARHOG writes the latter.
+//
+// Main loop only (SD access). Call poll() regularly so a quiet session
+// still reaches the card within the age threshold, and close() on exit.
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+#include "session_log_buffer.h"
+
+class SessionLogWriter {
+public:
+    /**
+     * @brief Bind caller-owned RAM (see SessionLogBuffer::attach)
+     */
+    SessionLogWriter(char* storage, size_t bytes, uint32_t flushMs = 10000);
+
+    /**
+     * @brief Create path, write header and keep the file open
+     * Closes (and flushes) any file already open.
+     */
+    bool open(const char* path, const char* header);
+    bool open(const char* path, const void* header, size_t headerLen);
+
+    /**
+     * @brief Flush and close the file (no-op if not open)
+     */
+    void close();
+
+    bool isOpen() const { return path[0] != '\0'; }
+    const char* getPath() const { return path; }
+
+    /**
+     * @brief Queue one record, flushing first if the buffer is full
+     * @return false if the record was dropped
+     */
+    bool printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Queue one binary record (same flush rules as printf)
+     */
+    bool append(const void* data, size_t len);
+
+    /**
+     * @brief Flush if the fill or age threshold has been reached
+     */
+    void poll();
+
+    /**
+     * @brief Write pending records and sync the file
+     * @return true if nothing is left pending
+     */
+    bool flush();
+
+    /**
+     * @brief File size including pending records (no SD access)
+     */
+    uint32_t fileBytes() const { return buffer.fileBytes(); }
+
+    uint32_t getRecords() const { return buffer.getRecords(); }
+    uint32_t getFlushes() const { return buffer.getFlushes(); }
+    uint32_t getDropped() const { return dropped; }
+
+private:
+    SessionLogBuffer buffer;
+    File file;
+    char path[128];
+    uint32_t dropped;
+};
@@ -0,0 +1,134 @@
+// SnapshotBuffer - Double-buffered, generation-counted published view
+// One writer fills the back slot and publishes it; any number of readers
+// take the front slot without locks. Each slot has a reader count: the
+// writer never refills a slot someone is still reading (it skips that
+// publish instead), and a reader re-checks the front after announcing
+// itself so it can never pin a slot the writer has already started on.
+//
+// Storage is owned by the caller (attachBack() while the slot is free), so
+// the owner decides where it lives and how it grows.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class SnapshotBuffer {
+public:
+    struct View {
+        const T* data = nullptr;
+        uint16_t count = 0;
+        uint32_t generation = 0;   // 0 = nothing published yet
+        uint32_t stamp = 0;        // Writer-supplied (e.g. millis() at publish)
+        int8_t slot = -1;          // -1 = not holding a slot
+    };
+
+    /**
+     * @brief Pin the current front slot (lock-free, never blocks)
+     * @return false if nothing has been published yet (out is empty)
+     */
+    bool acquire(View& out) {
+        for (;;) {
+            uint8_t f = front.load();
+            readers[f].fetch_add(1);
+            if (front.load() == f) {
+                const Slot& s = slots[f];
+                if (s.generation == 0) {
+                    readers[f].fetch_sub(1);
+                    out = View();
+                    return false;
+                }
+                out.data = s.data;
+                out.count = s.count;
+                out.generation = s.generation;
+                out.stamp = s.stamp;
+                out.slot = (int8_t)f;
+                return true;
+            }
+            // Writer flipped between load and announce - retry on new front
+            readers[f].fetch_sub(1);
+        }
+    }
+
+    void release(View& v) {
+        if (v.slot >= 0) {
+            readers[v.slot].fetch_sub(1);
+        }
+        v = View();
+    }
+
+    // ---- Writer side (single writer) ----
+
+    /**
+     * @brief Claim the back slot for writing
+     * @param data Back slot storage (nullptr until attachBack())
+     * @return false if a reader still holds it - skip this publish
+     */
+    bool beginWrite(T*& data, uint16_t& capacity) {
+        uint8_t b = (uint8_t)(front.load() ^ 1);
+        if (readers[b].load() != 0) {
+            busySkips++;
+            return false;
+        }
+        data = slots[b].data;
+        capacity = slots[b].capacity;
+        return true;
+    }
+
+    /**
+     * @brief Swap in new back storage; returns the old pointer for freeing
+     * Only valid between a successful beginWrite() and publish().
+     */
+    T* attachBack(T* storage, uint16_t capacity) {
+        Slot& s = slots[front.load() ^ 1];
+        T* old = s.data;
+        s.data = storage;
+        s.capacity = capacity;
+        s.count = 0;
+        return old;
+    }
+
+    /**
+     * @brief Make the back slot the front
+     */
+    void publish(uint16_t count, uint32_t stamp) {
+        uint8_t b = (uint8_t)(front.load() ^ 1);
+        Slot& s = slots[b];
+        s.count = count <= s.capacity ? count : s.capacity;
+        s.stamp = stamp;
+        s.generation = ++lastGeneration;
+        front.store(b);
+    }
+
+    /**
+     * @brief Forget both slots; returns their storage for freeing
+     * @return false (nothing detached) if any reader is active
+     */
+    bool detachAll(T*& a, T*& b) {
+        if (readers[0].load() != 0 || readers[1].load() != 0) return false;
+        a = slots[0].data;
+        b = slots[1].data;
+        slots[0] = Slot();
+        slots[1] = Slot();
+        return true;
+    }
+
+    uint32_t generation() const { return lastGeneration; }
+    uint32_t getBusySkips() const { return busySkips; }
+
+private:
+    struct Slot {
+        T* data = nullptr;
+        uint16_t capacity = 0;
+        uint16_t count = 0;
+        uint32_t generation = 0;
+        uint32_t stamp = 0;
+    };
+
+    Slot slots[2];
+    std::atomic<uint8_t> front{0};
+    std::atomic<uint16_t> readers[2] = {{0}, {0}};
+    uint32_t lastGeneration = 0;
+    uint32_t busySkips = 0;
+};
@@ -0,0 +1,137 @@
+// SpscQueue - Lock-free single-producer/single-consumer queue of fixed slots
+// Producer: NetworkRecon dispatch context (mode packet callback).
+// Consumer: the mode's update() on the main loop.
+//
+// Capacity is a compile-time power of two and every slot is usable: head
+// and tail are free-running 32-bit counters, so full is head - tail == N.
+// Items are written and read in place (beginPush/commitPush, peek/pop), so
+// large items such as queued EAPOL frames are never copied through the
+// stack of either side.
+//
+// Telemetry mirrors FrameRing: pushed/popped/dropped counters and a
+// high-water mark of queued items, all readable from any thread.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T, uint16_t kSlots>
+class SpscQueue {
+    static_assert(kSlots >= 2 && (kSlots & (kSlots - 1)) == 0,
+                  "SpscQueue slot count must be a power of two");
+
+public:
+    static constexpr uint16_t kCapacity = kSlots;
+
+    /**
+     * @brief Empty the queue and clear telemetry
+     * Not thread-safe - call while neither side is running.
+     */
+    void reset() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        resetStats();
+    }
+
+    /**
+     * @brief Producer: claim the next free slot to fill in place
+     * @return nullptr if full (counted as a drop)
+     */
+    T* beginPush() {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t t = tail.load(std::memory_order_acquire);
+        if (h - t >= kSlots) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &slots[h & kMask];
+    }
+
+    /**
+     * @brief Producer: publish the slot returned by beginPush()
+     */
+    void commitPush() {
+        uint32_t h = head.load(std::memory_order_relaxed) + 1;
+        head.store(h, std::memory_order_release);
+        pushed.fetch_add(1, std::memory_order_relaxed);
+        uint32_t used = h - tail.load(std::memory_order_relaxed);
+        if (used > highWater.load(std::memory_order_relaxed)) {
+            highWater.store(used, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Producer: copy one item in
+     * @return false if full (counted as a drop)
+     */
+    bool push(const T& item) {
+        T* slot = beginPush();
+        if (!slot) return false;
+        *slot = item;
+        commitPush();
+        return true;
+    }
+
+    /**
+     * @brief Consumer: oldest item, left in place until pop()
+     * @return nullptr if empty
+     */
+    T* peek() {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return nullptr;
+        return &slots[t & kMask];
+    }
+
+    /**
+     * @brief Consumer: release the item returned by peek()
+     */
+    void pop() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        popped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Consumer: copy the oldest item out and release it
+     * @return false if empty
+     */
+    bool pop(T& out) {
+        T* item = peek();
+        if (!item) return false;
+        out = *item;
+        pop();
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    uint16_t size() const {
+        uint32_t t = tail.load(std::memory_order_acquire);
+        return (uint16_t)(head.load(std::memory_order_acquire) - t);
+    }
+
+    uint32_t getPushed() const { return pushed.load(std::memory_order_relaxed); }
+    uint32_t getPopped() const { return popped.load(std::memory_order_relaxed); }
+    uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    uint32_t getHighWater() const { return highWater.load(std::memory_order_relaxed); }
+
+    void resetStats() {
+        pushed.store(0, std::memory_order_relaxed);
+        popped.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        highWater.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t kMask = kSlots - 1;
+
+    T slots[kSlots];
+    std::atomic<uint32_t> head{0};   // Producer-owned
+    std::atomic<uint32_t> tail{0};   // Consumer-owned
+    std::atomic<uint32_t> pushed{0};
+    std::atomic<uint32_t> popped{0};
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint32_t> highWater{0};
+};
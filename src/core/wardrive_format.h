@@ -0,0 +1,454 @@
+// WardriveFormat - WARHOG binary session log and its CSV renderers
+// WARHOG used to write every geotagged network twice, as the internal CSV
+// and as WiGLE 1.6 text, printf-ing doubles and escaping the SSID for
+// each. Now it appends one fixed 64-byte Record per network to a single
+// .wdr file:
+//
+//   [FileHeader 16 bytes][Record 64 bytes][Record 64 bytes]...
+//
+// Coordinates are fixed point (degrees * 1e7, decimetres) and the sighting
+// time is GPS UTC epoch seconds, so the write path does no formatting at
+// all. Text is produced on demand by Renderer, a streaming converter with a
+// one-line buffer: WiGLE uploads, the file server and the host converter
+// (tools/wdr_convert.cpp) all render the same bytes WARHOG used to write.
+//
+// A torn write at power loss leaves a partial last record; readers stop at
+// the last whole one.
+// Header-only and Arduino-free so the native test suite can exercise it.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+namespace WardriveFormat {
+
+static constexpr uint32_t kFileMagic = 0x31574B50;    // "PKW1" little-endian
+static constexpr uint16_t kVersion = 1;
+static constexpr uint8_t kMaxSsidLen = 32;
+static constexpr const char* kExtension = ".wdr";
+
+// Same values as ESP-IDF wifi_auth_mode_t (stored as-is by WARHOG)
+enum Auth : uint8_t {
+    AUTH_OPEN = 0,
+    AUTH_WEP = 1,
+    AUTH_WPA_PSK = 2,
+    AUTH_WPA2_PSK = 3,
+    AUTH_WPA_WPA2_PSK = 4,
+    AUTH_WPA2_ENTERPRISE = 5,
+    AUTH_WPA3_PSK = 6,
+    AUTH_WPA2_WPA3_PSK = 7,
+    AUTH_WAPI_PSK = 8
+};
+
+#pragma pack(push, 1)
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordBytes;     // sizeof(Record)
+    uint32_t reserved[2];
+};
+
+struct Record {
+    uint8_t bssid[6];
+    uint8_t ssidLen;
+    uint8_t auth;             // Auth
+    char ssid[32];            // Not NUL-terminated; ssidLen bytes valid
+    int8_t rssi;
+    uint8_t channel;
+    uint16_t accuracyDm;      // WiGLE AccuracyMeters * 10
+    int32_t latE7;            // Degrees * 1e7
+    int32_t lonE7;
+    int32_t altDm;            // Metres * 10
+    uint32_t epoch;           // GPS UTC seconds since 1970 (0 = no GPS time)
+    uint32_t uptimeMs;        // millis() at the sighting (legacy CSV Timestamp)
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FileHeader) == 16, "WardriveFormat::FileHeader must be 16 bytes");
+static_assert(sizeof(Record) == 64, "WardriveFormat::Record must be 64 bytes");
+
+// Longest possible rendered lines, for sizing files by record count.
+// A line is the sum of each field's widest rendering over its full type
+// range (not just plausible values), so no record can exceed it.
+static constexpr size_t kMaxWigleHeader = 320;
+namespace WigleWidth {
+    static constexpr size_t kMac = 17;               // AA:BB:CC:DD:EE:FF
+    static constexpr size_t kSsid = 2 + kMaxSsidLen * 2;  // Quoted, every char a quote
+    static constexpr size_t kAuth = 44;              // [WPA-PSK-CCMP+TKIP][WPA2-PSK-CCMP+TKIP][ESS]
+    static constexpr size_t kSeen = 19;              // 2106-02-07 06:28:15 (uint32 epoch)
+    static constexpr size_t kChannel = 3;            // 233
+    static constexpr size_t kFrequency = 4;          // 7115
+    static constexpr size_t kRssi = 4;               // -128
+    static constexpr size_t kCoord = 11;             // -214.748365 (int32 degrees * 1e7)
+    static constexpr size_t kAltitude = 12;          // -214748364.8 (int32 dm)
+    static constexpr size_t kAccuracy = 6;           // 6553.5 (uint16 dm)
+    static constexpr size_t kSeparators = 10;        // Commas between those fields
+    static constexpr size_t kTail = 9;               // ,,,WIFI\r\n
+}
+static constexpr size_t kMaxWigleLine =
+    WigleWidth::kMac + WigleWidth::kSsid + WigleWidth::kAuth + WigleWidth::kSeen +
+    WigleWidth::kChannel + WigleWidth::kFrequency + WigleWidth::kRssi +
+    2 * WigleWidth::kCoord + WigleWidth::kAltitude + WigleWidth::kAccuracy +
+    WigleWidth::kSeparators + WigleWidth::kTail;
+
+inline FileHeader makeFileHeader() {
+    FileHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = kFileMagic;
+    h.version = kVersion;
+    h.recordBytes = sizeof(Record);
+    return h;
+}
+
+inline bool isFileHeader(const FileHeader& h) {
+    return h.magic == kFileMagic && h.version == kVersion &&
+           h.recordBytes == sizeof(Record);
+}
+
+/**
+ * @brief Whole records in a file of fileSize bytes (0 if too short)
+ */
+inline uint32_t recordCount(uint32_t fileSize) {
+    if (fileSize < sizeof(FileHeader)) return 0;
+    return (fileSize - sizeof(FileHeader)) / sizeof(Record);
+}
+
+/**
+ * @brief True if name (or path) ends in .wdr
+ */
+inline bool isLogName(const char* name) {
+    size_t n = name ? strlen(name) : 0;
+    size_t e = strlen(kExtension);
+    if (n <= e) return false;
+    for (size_t i = 0; i < e; i++) {
+        char c = name[n - e + i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if (c != kExtension[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Base name of a rendered copy: warhog_x.wdr -> warhog_x.wigle.csv
+ * @param path A .wdr name or path; suffix is ".wigle.csv" or ".csv"
+ */
+inline void renderedName(const char* path, const char* suffix, char* out, size_t cap) {
+    const char* base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    size_t n = strlen(base);
+    if (isLogName(base)) n -= strlen(kExtension);
+    snprintf(out, cap, "%.*s%s", (int)n, base, suffix);
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant)
+inline int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+    y -= m <= 2;
+    const int32_t era = (y >= 0 ? y : y - 399) / 400;
+    const uint32_t yoe = (uint32_t)(y - era * 400);
+    const uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+inline void civilFromDays(int32_t z, int32_t& y, uint32_t& m, uint32_t& d) {
+    z += 719468;
+    const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const uint32_t doe = (uint32_t)(z - era * 146097);
+    const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const uint32_t mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = (int32_t)yoe + era * 400 + (m <= 2);
+}
+
+/**
+ * @brief Epoch seconds from GPS date (DDMMYY) and time (HHMMSSCC)
+ * @return 0 if either is unset
+ */
+inline uint32_t epochFromGps(uint32_t date, uint32_t time) {
+    if (date == 0 || time == 0) return 0;
+    uint32_t day = date / 10000;
+    uint32_t month = (date / 100) % 100;
+    uint32_t year = 2000 + date % 100;
+    if (day < 1 || day > 31 || month < 1 || month > 12) return 0;
+    uint32_t hour = time / 1000000;
+    uint32_t minute = (time / 10000) % 100;
+    uint32_t second = (time / 100) % 100;
+    int32_t days = daysFromCivil((int32_t)year, month, day);
+    return (uint32_t)days * 86400u + hour * 3600u + minute * 60u + second;
+}
+
+inline int32_t toFixed(double v, double scale) {
+    double s = v * scale;
+    if (s > 2147483647.0) return 2147483647;
+    if (s < -2147483647.0) return -2147483647;
+    return (int32_t)lround(s);
+}
+
+/**
+ * @brief Build a record (ssid is a C string, truncated to 32 bytes)
+ */
+inline Record makeRecord(const uint8_t* bssid, const char* ssid, int8_t rssi,
+                         uint8_t channel, uint8_t auth, double lat, double lon,
+                         double alt, double accuracy, uint32_t epoch, uint32_t uptimeMs) {
+    Record r;
+    memset(&r, 0, sizeof(r));
+    memcpy(r.bssid, bssid, 6);
+    size_t n = ssid ? strnlen(ssid, kMaxSsidLen) : 0;
+    memcpy(r.ssid, ssid ? ssid : "", n);
+    r.ssidLen = (uint8_t)n;
+    r.auth = auth;
+    r.rssi = rssi;
+    r.channel = channel;
+    double acc = accuracy * 10.0;
+    r.accuracyDm = acc <= 0 ? 0 : (acc >= 65535.0 ? 65535 : (uint16_t)lround(acc));
+    r.latE7 = toFixed(lat, 1e7);
+    r.lonE7 = toFixed(lon, 1e7);
+    r.altDm = toFixed(alt, 10.0);
+    r.epoch = epoch;
+    r.uptimeMs = uptimeMs;
+    return r;
+}
+
+// ============================================================================
+// Text rendering
+// ============================================================================
+
+enum class Output : uint8_t {
+    Wigle,    // WiGLE 1.6 (.wigle.csv)
+    Csv       // Legacy internal CSV
+};
+
+inline const char* authString(uint8_t auth) {
+    switch (auth) {
+        case AUTH_OPEN:          return "OPEN";
+        case AUTH_WEP:           return "WEP";
+        case AUTH_WPA_PSK:       return "WPA";
+        case AUTH_WPA2_PSK:      return "WPA2";
+        case AUTH_WPA_WPA2_PSK:  return "WPA/WPA2";
+        case AUTH_WPA3_PSK:      return "WPA3";
+        case AUTH_WPA2_WPA3_PSK: return "WPA2/WPA3";
+        case AUTH_WAPI_PSK:      return "WAPI";
+        default:                 return "UNKNOWN";
+    }
+}
+
+// WiGLE capability string
+inline const char* authWigleString(uint8_t auth) {
+    switch (auth) {
+        case AUTH_OPEN:          return "[ESS]";
+        case AUTH_WEP:           return "[WEP][ESS]";
+        case AUTH_WPA_PSK:       return "[WPA-PSK-CCMP][ESS]";
+        case AUTH_WPA2_PSK:      return "[WPA2-PSK-CCMP][ESS]";
+        case AUTH_WPA_WPA2_PSK:  return "[WPA-PSK-CCMP+TKIP][WPA2-PSK-CCMP+TKIP][ESS]";
+        case AUTH_WPA3_PSK:      return "[WPA3-SAE][ESS]";
+        case AUTH_WPA2_WPA3_PSK: return "[WPA2-PSK-CCMP][WPA3-SAE][ESS]";
+        case AUTH_WAPI_PSK:      return "[WAPI-PSK][ESS]";
+        default:                 return "[ESS]";
+    }
+}
+
+// Best-effort mapping for 2.4/5/6 GHz
+inline int channelToFrequency(uint8_t channel) {
+    if (channel >= 1 && channel <= 13) return 2412 + (channel - 1) * 5;
+    if (channel == 14) return 2484;
+    if (channel <= 196) return 5000 + channel * 5;
+    if (channel <= 233) return 5950 + channel * 5;
+    return 0;
+}
+
+/**
+ * @brief Quoted CSV field: doubles quotes, strips control characters
+ * out needs 2 + 32 * 2 + 1 bytes for a worst-case SSID
+ */
+inline size_t escapeSsid(const char* ssid, size_t len, char* out) {
+    size_t n = 0;
+    out[n++] = '"';
+    for (size_t i = 0; i < len && ssid[i]; i++) {
+        if (ssid[i] == '"') {
+            out[n++] = '"';
+            out[n++] = '"';
+        } else if ((uint8_t)ssid[i] >= 32) {
+            out[n++] = ssid[i];
+        }
+    }
+    out[n++] = '"';
+    out[n] = '\0';
+    return n;
+}
+
+// value / 10^decimals with that many decimals, like %.Nf of the original
+inline int formatFixed(char* out, size_t cap, int64_t value, uint32_t divisor, uint8_t decimals) {
+    bool neg = value < 0;
+    uint64_t a = (uint64_t)(neg ? -value : value);
+    return snprintf(out, cap, "%s%llu.%0*llu", neg ? "-" : "",
+                    (unsigned long long)(a / divisor), (int)decimals,
+                    (unsigned long long)(a % divisor));
+}
+
+// Degrees * 1e7 to 6 decimals (round half away from zero)
+inline int formatCoord(char* out, size_t cap, int32_t e7) {
+    int64_t v = e7;
+    int64_t e6 = v >= 0 ? (v + 5) / 10 : (v - 5) / 10;
+    return formatFixed(out, cap, e6, 1000000, 6);
+}
+
+/**
+ * @brief Header text for a rendered file
+ * @param appRelease WiGLE appRelease field (firmware version)
+ */
+inline size_t renderHeader(Output fmt, const char* appRelease, char* out, size_t cap) {
+    int n;
+    if (fmt == Output::Wigle) {
+        n = snprintf(out, cap,
+                     "WigleWifi-1.6,appRelease=%s,model=M5Cardputer,release=ESP32-S3,device=PORKCHOP,"
+                     "display=240x135,board=m5stack,brand=M5Stack,star=Sol,body=3,subBody=0\n"
+                     "MAC,SSID,AuthMode,FirstSeen,Channel,Frequency,RSSI,CurrentLatitude,CurrentLongitude,"
+                     "AltitudeMeters,AccuracyMeters,RCOIs,MfgrId,Type\r\n",
+                     appRelease ? appRelease : "0.1.x");
+    } else {
+        n = snprintf(out, cap,
+                     "BSSID,SSID,RSSI,Channel,AuthMode,Latitude,Longitude,Altitude,Timestamp\r\n");
+    }
+    return (n < 0 || (size_t)n >= cap) ? 0 : (size_t)n;
+}
+
+/**
+ * @brief One record as a text line
+ * @return Length, or 0 if cap is too small (kMaxWigleLine + 1 always fits)
+ */
+inline size_t renderRecord(Output fmt, const Record& r, char* out, size_t cap) {
+    char ssid[2 + kMaxSsidLen * 2 + 1];
+    escapeSsid(r.ssid, r.ssidLen <= kMaxSsidLen ? r.ssidLen : kMaxSsidLen, ssid);
+    char lat[16], lon[16], alt[16];
+    formatCoord(lat, sizeof(lat), r.latE7);
+    formatCoord(lon, sizeof(lon), r.lonE7);
+    formatFixed(alt, sizeof(alt), r.altDm, 10, 1);
+
+    int n;
+    if (fmt == Output::Wigle) {
+        char seen[40];
+        if (r.epoch != 0) {
+            int32_t y;
+            uint32_t m, d;
+            civilFromDays((int32_t)(r.epoch / 86400), y, m, d);
+            uint32_t sec = r.epoch % 86400;
+            snprintf(seen, sizeof(seen), "%04d-%02u-%02u %02u:%02u:%02u", (int)y,
+                     (unsigned)m, (unsigned)d, (unsigned)(sec / 3600),
+                     (unsigned)((sec / 60) % 60), (unsigned)(sec % 60));
+        } else {
+            // No GPS time: boot time reference, as WARHOG always wrote
+            snprintf(seen, sizeof(seen), "1970-01-01 00:00:%02u",
+                     (unsigned)((r.uptimeMs / 1000) % 60));
+        }
+        char acc[12];
+        formatFixed(acc, sizeof(acc), r.accuracyDm > 0 ? r.accuracyDm : 100, 10, 1);
+        n = snprintf(out, cap, "%02X:%02X:%02X:%02X:%02X:%02X,%s,%s,%s,%d,%d,%d,%s,%s,%s,%s,,,WIFI\r\n",
+                     r.bssid[0], r.bssid[1], r.bssid[2], r.bssid[3], r.bssid[4], r.bssid[5],
+                     ssid, authWigleString(r.auth), seen, r.channel,
+                     channelToFrequency(r.channel), r.rssi, lat, lon, alt, acc);
+    } else {
+        n = snprintf(out, cap, "%02X:%02X:%02X:%02X:%02X:%02X,%s,%d,%d,%s,%s,%s,%s,%lu\n",
+                     r.bssid[0], r.bssid[1], r.bssid[2], r.bssid[3], r.bssid[4], r.bssid[5],
+                     ssid, r.rssi, r.channel, authString(r.auth), lat, lon, alt,
+                     (unsigned long)r.uptimeMs);
+    }
+    return (n < 0 || (size_t)n >= cap) ? 0 : (size_t)n;
+}
+
+/**
+ * @brief Streaming .wdr to text converter
+ * read() pulls bytes from src(uint8_t* dst, size_t n) -> size_t and fills
+ * out with as much text as fits; a line longer than out is carried over to
+ * the next call. Memory is one line buffer, so any output chunk size works.
+ */
+class Renderer {
+public:
+    static constexpr size_t kLineBytes = 336;
+    static_assert(kLineBytes > kMaxWigleHeader && kLineBytes > kMaxWigleLine,
+                  "Renderer line buffer must hold any header or record");
+
+    void begin(Output fmt, const char* release) {
+        format = fmt;
+        appRelease = release;
+        state = State::Header;
+        lineLen = 0;
+        linePos = 0;
+        records = 0;
+    }
+
+    /**
+     * @brief Next chunk of text
+     * @return Bytes written to out; 0 at the end or on a bad file header
+     */
+    template <typename Read>
+    size_t read(Read&& src, char* out, size_t cap) {
+        size_t n = 0;
+        while (n < cap) {
+            if (linePos == lineLen && !nextLine(src)) break;
+            size_t take = lineLen - linePos;
+            if (take > cap - n) take = cap - n;
+            memcpy(out + n, line + linePos, take);
+            linePos += take;
+            n += take;
+        }
+        return n;
+    }
+
+    bool failed() const { return state == State::BadHeader; }
+    uint32_t getRecords() const { return records; }
+
+private:
+    enum class State : uint8_t { Header, Records, Done, BadHeader };
+
+    Output format = Output::Wigle;
+    const char* appRelease = nullptr;
+    State state = State::Done;
+    char line[kLineBytes];
+    size_t lineLen = 0;
+    size_t linePos = 0;
+    uint32_t records = 0;
+
+    template <typename Read>
+    static bool readExact(Read& src, void* dst, size_t len) {
+        uint8_t* p = (uint8_t*)dst;
+        size_t got = 0;
+        while (got < len) {
+            size_t r = src(p + got, len - got);
+            if (r == 0) return false;
+            got += r;
+        }
+        return true;
+    }
+
+    template <typename Read>
+    bool nextLine(Read& src) {
+        lineLen = 0;
+        linePos = 0;
+        if (state == State::Header) {
+            FileHeader h;
+            if (!readExact(src, &h, sizeof(h)) || !isFileHeader(h)) {
+                state = State::BadHeader;
+                return false;
+            }
+            state = State::Records;
+            lineLen = renderHeader(format, appRelease, line, sizeof(line));
+            return lineLen > 0;
+        }
+        if (state != State::Records) return false;
+        Record r;
+        if (!readExact(src, &r, sizeof(r))) {
+            state = State::Done;  // End of file or a torn last record
+            return false;
+        }
+        records++;
+        lineLen = renderRecord(format, r, line, sizeof(line));
+        return lineLen > 0;
+    }
+};
+
+}  // namespace WardriveFormat
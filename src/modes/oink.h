@@ -7,6 +7,10 @@
 #include <set>
 #include <FS.h>
 #include "../core/network_recon.h"
+#include "../core/client_sketch.h"
+#include "../core/eapol_arena.h"
+#include "../core/beacon_store.h"
+#include "../core/spsc_queue.h"
 
 // Maximum clients to track for the current target (dense environments)
 #define MAX_CLIENTS_PER_NETWORK 20
@@ -32,15 +36,17 @@ struct DetectedNetwork {
     bool isTarget;
     bool hasPMF;  // Protected Management Frames (immune to deauth)
     bool hasHandshake;  // Already captured handshake for this network
+    bool lootChecked;   // Looked up in CapturedIndex (main loop)
+    uint8_t lootTypes;  // CapturedIndex types saved in earlier sessions
     uint8_t attackAttempts;  // Number of attack attempts (for retry logic)
     bool isHidden;  // Hidden SSID (needs probe response)
     uint32_t lastDataSeen;     // millis() of most recent client data frame
     uint32_t cooldownUntil;    // millis() until eligible for auto-target
-    uint64_t clientBitset;     // Approximate unique client tracker (bits 0-63)
-    uint64_t clientBitsetHigh; // Extended client tracker (bits 64-127)
+    ClientSketch clients;      // Unique clients seen in the last 30-60s
 };
 
-// Frame storage for PCAP export - stores full 802.11 frame with headers
+// Fixed-size staging copy of one EAPOL message, used by the callback-side
+// pending pools before the main loop files it into a CapturedHandshake
 struct EAPOLFrame {
     uint8_t data[512];       // EAPOL payload only (for hashcat 22000)
     uint8_t fullFrame[300];  // Full 802.11 frame for PCAP (header + LLC + EAPOL)
@@ -49,26 +55,77 @@ struct EAPOLFrame {
     uint8_t messageNum;      // 1-4
     uint32_t timestamp;
     int8_t rssi;             // Signal strength for radiotap header
+    uint8_t channel;         // RX channel for radiotap header (0 = unknown)
+    uint32_t rxTimeUs;       // RX timer (rx_ctrl.timestamp) for radiotap TSFT
+};
+
+// One EAPOL frame for a handshake the main loop has not created yet.
+// The packet callback queues these (no vector push_back in callback
+// context) and update() merges them into CapturedHandshake.
+struct PendingEapolFrame {
+    uint8_t bssid[6];
+    uint8_t station[6];
+    uint8_t msgIdx;          // 0-3 (M1-M4)
+    EAPOLFrame frame;
+
+    // Copy a frame in (EAPOL capped at 512 bytes, full frame at 300)
+    void set(const uint8_t* apBssid, const uint8_t* sta, uint8_t idx,
+             const uint8_t* eapol, uint16_t len,
+             const uint8_t* full, uint16_t fullLen,
+             int8_t rssi, uint8_t channel, uint32_t rxTimeUs);
+};
+
+// Callback -> update() handoff, shared by OINK and DO NO HAM (the modes are
+// exclusive). 16 x ~830 bytes, static in .bss.
+typedef SpscQueue<PendingEapolFrame, 16> EapolHandoffQueue;
+
+// Captured EAPOL message - bytes live in the shared EAPOL arena (EapolStore)
+// at their actual length; read them with EapolStore::copy()
+struct HandshakeFrame {
+    EapolArena::Ref eapol;      // EAPOL payload (for hashcat 22000)
+    EapolArena::Ref fullFrame;  // Full 802.11 frame for PCAP (header + LLC + EAPOL)
+    uint8_t messageNum;         // 1-4
+    uint32_t timestamp;
+    int8_t rssi;                // Signal strength for radiotap header
+    uint8_t channel;            // RX channel for radiotap header (0 = unknown)
+    uint32_t rxTimeUs;          // RX timer (rx_ctrl.timestamp), 0 = unknown
+
+    uint16_t len() const { return eapol.len; }
+    uint16_t fullFrameLen() const { return fullFrame.len; }
 };
 
 struct CapturedHandshake {
     uint8_t bssid[6];
     uint8_t station[6];
     char ssid[33];
-    EAPOLFrame frames[4];  // M1, M2, M3, M4
+    HandshakeFrame frames[4];  // M1, M2, M3, M4
     uint8_t capturedMask;  // Bits 0-3 for M1-M4
     uint32_t firstSeen;
     uint32_t lastSeen;
     bool saved;  // Already saved to SD
     uint8_t saveAttempts;  // Number of save attempts (0-3, then give up)
-    uint8_t* beaconData;   // Beacon frame for this AP
-    uint16_t beaconLen;    // Beacon frame length
+    BeaconCache::Ref beacon;  // Shared beacon for this AP (BeaconStore)
     
     bool hasM1() const { return capturedMask & 0x01; }
     bool hasM2() const { return capturedMask & 0x02; }
     bool hasM3() const { return capturedMask & 0x04; }
     bool hasM4() const { return capturedMask & 0x08; }
-    bool hasBeacon() const { return beaconData != nullptr && beaconLen > 0; }
+    bool hasBeacon() const { return BeaconStore::hasFrame(beacon); }
+    
+    // Store message msgIdx (0-3) in the EAPOL arena, replacing any earlier copy.
+    // EAPOL is capped at 512 bytes, the full frame at 300 (optional).
+    // Returns false (frame and mask unchanged) if the arena is out of space.
+    // OINK callers must hold NetworkRecon::enterCritical() (see EapolStore).
+    // channel / rxTimeUs feed the radiotap header (0 when not known).
+    bool storeFrame(uint8_t msgIdx, const uint8_t* eapol, uint16_t len,
+                    const uint8_t* fullFrame, uint16_t fullLen,
+                    int8_t rssi, uint32_t timestamp,
+                    uint8_t channel = 0, uint32_t rxTimeUs = 0);
+    // Return every frame to the arena and clear capturedMask
+    void releaseFrames();
+    // Return the frames of a capture written to SD, keeping capturedMask
+    // so it still counts as captured
+    void releaseSavedFrames();
     
     // Valid crackable pairs: M1+M2 (preferred) or M2+M3 (fallback if M1 missed)
     bool hasValidPair() const { return (hasM1() && hasM2()) || (hasM2() && hasM3()); }
@@ -134,6 +191,12 @@ public:
     // Hashcat 22000 format (direct cracking, no conversion)
     static bool saveHandshake22000(const CapturedHandshake& hs, const char* path);
     
+    // Stream the per-network file bodies (SD file or capture journal record).
+    // The 22000 writers validate first and write nothing when they fail.
+    static bool writeHandshakePCAP(Print& out, const CapturedHandshake& hs);
+    static bool writeHandshake22000(Print& out, const CapturedHandshake& hs);
+    static bool writePMKID22000(Print& out, const CapturedPMKID& p);
+    
     // Channel hopping
     static void setChannel(uint8_t ch);
     static uint8_t getChannel() { return currentChannel; }
@@ -171,6 +234,10 @@ public:
     struct BoarBro { uint64_t bssid; char ssid[33]; };
     static const BoarBro* getExcludedList() { return boarBros; }
     
+    // Shared EAPOL handoff queue (OINK and DO NO HAM) and its session log line
+    static EapolHandoffQueue& eapolHandoff();
+    static void logEapolHandoff(const char* tag);
+
     // Stress test injection (no RF)
     static void injectTestNetwork(const uint8_t* bssid, const char* ssid, uint8_t channel, int8_t rssi, wifi_auth_mode_t authmode, bool hasPMF);
     
@@ -203,11 +270,6 @@ private:
     static volatile uint32_t packetCount;
     static uint32_t deauthCount;
     
-    // Beacon frame storage (for PCAP)
-    static uint8_t* beaconFrame;
-    static uint16_t beaconFrameLen;
-    static std::atomic<bool> beaconCaptured;  // Atomic to prevent race between callback and main thread
-    
     // Private processing functions (callback dispatches here)
     static void processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi);
     static void processProbeResponse(const uint8_t* payload, uint16_t len, int8_t rssi);
@@ -228,13 +290,13 @@ private:
     static int findOrCreateHandshake(const uint8_t* bssid, const uint8_t* station);
     static int findOrCreatePMKID(const uint8_t* bssid, const uint8_t* station);
     static int findOrCreateHandshakeSafe(const uint8_t* bssid, const uint8_t* station);  // Main thread only
+    static void pruneStaleHandshakes();  // Main thread only
     static int findOrCreatePMKIDSafe(const uint8_t* bssid, const uint8_t* station);      // Main thread only
     static void sortNetworksByPriority();
     static void updateTargetCache();
     static bool hasHandshakeFor(const uint8_t* bssid);
+    static void tagLootedNetworks();
     static int getNextTarget();  // Smart target selection
-    static void writePCAPHeader(fs::File& f);
-    static void writePCAPPacket(fs::File& f, const uint8_t* data, uint16_t len, uint32_t ts);
     
     // BOAR BROS storage (fixed array, zero heap allocation)
     static BoarBro boarBros[50];
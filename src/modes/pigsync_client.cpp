@@ -19,6 +19,8 @@
 #include "../core/heap_gates.h"
 #include "../core/heap_policy.h"
 #include "../core/network_recon.h"
+#include "../core/eapol_store.h"
+#include "../core/captured_index.h"
 #include "../piglet/mood.h"
 #include "../ui/display.h"
 #include "../modes/warhog.h"
@@ -273,8 +275,6 @@ static bool parseSirloinHandshake(const uint8_t* data, uint16_t len, CapturedHan
     }
 
     memset(&out, 0, sizeof(out));
-    out.beaconData = nullptr;
-    out.beaconLen = 0;
 
     memcpy(out.bssid, data, 6);
     memcpy(out.station, data + 6, 6);
@@ -299,12 +299,10 @@ static bool parseSirloinHandshake(const uint8_t* data, uint16_t len, CapturedHan
         if (beaconLen > 512 || offset + beaconLen > len) {
             return false;
         }
-        out.beaconData = (uint8_t*)malloc(beaconLen);
-        if (!out.beaconData) {
-            return false;
+        // Shared beacon cache; the PCAP is still written without it if full
+        if (BeaconStore::put(out.bssid, data + offset, beaconLen)) {
+            out.beacon = BeaconStore::acquire(out.bssid);
         }
-        memcpy(out.beaconData, data + offset, beaconLen);
-        out.beaconLen = beaconLen;
         offset += beaconLen;
     }
 
@@ -336,23 +334,9 @@ static bool parseSirloinHandshake(const uint8_t* data, uint16_t len, CapturedHan
             continue;
         }
 
-        EAPOLFrame& frame = out.frames[msgNum - 1];
-        uint16_t copyLen = frameLen;
-        if (copyLen > sizeof(frame.data)) copyLen = sizeof(frame.data);
-        memcpy(frame.data, frameData, copyLen);
-        frame.len = copyLen;
-
-        uint16_t fullCopyLen = fullLen;
-        if (fullCopyLen > sizeof(frame.fullFrame)) fullCopyLen = sizeof(frame.fullFrame);
-        if (fullCopyLen > 0) {
-            memcpy(frame.fullFrame, fullFrame, fullCopyLen);
-        }
-        frame.fullFrameLen = fullCopyLen;
-        frame.messageNum = msgNum;
-        frame.rssi = rssi;
-        frame.timestamp = (ts < 1000000000) ? ts : millis();
-
-        out.capturedMask |= (1 << (msgNum - 1));
+        // Caps lengths and sets capturedMask; skipped if the arena is full
+        out.storeFrame(msgNum - 1, frameData, frameLen, fullFrame, fullLen,
+                       rssi, (ts < 1000000000) ? ts : millis());
     }
 
     out.firstSeen = millis();
@@ -361,11 +345,7 @@ static bool parseSirloinHandshake(const uint8_t* data, uint16_t len, CapturedHan
     out.saveAttempts = 0;
 
     if (out.capturedMask == 0) {
-        if (out.beaconData) {
-            free(out.beaconData);
-            out.beaconData = nullptr;
-        }
-        out.beaconLen = 0;
+        BeaconStore::release(out.beacon);
         return false;
     }
 
@@ -949,6 +929,9 @@ void PigSyncMode::stop() {
         PIGSYNC_LOGLN("[PIGSYNC-CLI-STATE] DEINIT");
     }
 
+    // Drop the EAPOL arena used while saving synced handshakes
+    EapolStore::end();
+
     // Resume NetworkRecon (restores promiscuous mode)
     NetworkRecon::resume();
     
@@ -2214,17 +2197,21 @@ bool PigSyncMode::savePMKID(const uint8_t* data, uint16_t len) {
     removeIfExists(filename);
 
     bool ok = OinkMode::savePMKID22000(pmkid, filename);
+    if (ok) CapturedIndex::add(pmkid.bssid, CapturedIndex::kPmkid);
     return ok;
 }
 
 bool PigSyncMode::saveHandshake(const uint8_t* data, uint16_t len) {
     if (!Config::isSDAvailable()) return false;
 
-    static CapturedHandshake hs;
-    if (hs.beaconData) {
-        free(hs.beaconData);
-        hs.beaconData = nullptr;
+    // Frames are parsed into the EAPOL arena (small: one handshake at a time)
+    if (!EapolStore::begin(HeapPolicy::kEapolArenaMinBytes)) {
+        return false;
     }
+
+    static CapturedHandshake hs;
+    BeaconStore::release(hs.beacon);
+    hs.releaseFrames();
     memset(&hs, 0, sizeof(hs));
 
     if (!parseSirloinHandshake(data, len, hs)) {
@@ -2248,11 +2235,10 @@ bool PigSyncMode::saveHandshake(const uint8_t* data, uint16_t len) {
 
     bool pcapOk = OinkMode::saveHandshakePCAP(hs, filenamePcap);
     bool hs22kOk = OinkMode::saveHandshake22000(hs, filename22000);
+    if (pcapOk || hs22kOk) CapturedIndex::add(hs.bssid, CapturedIndex::kHandshake);
 
-    if (hs.beaconData) {
-        free(hs.beaconData);
-        hs.beaconData = nullptr;
-    }
+    BeaconStore::release(hs.beacon);
+    hs.releaseFrames();
 
     return (pcapOk || hs22kOk);
 }
@@ -11,6 +11,7 @@
 #include "../core/wifi_utils.h"
 #include "../core/heap_gates.h"
 #include "../core/heap_policy.h"
+#include "../core/beacon_summary.h"
 #include "../core/xp.h"
 #include "../ui/display.h"
 #include <M5Cardputer.h>
@@ -309,8 +310,9 @@ void SpectrumMode::start() {
     init();
     networks.reserve(MAX_SPECTRUM_NETWORKS);
     
-    // Register our packet callback for visualization
-    NetworkRecon::setPacketCallback(promiscuousCallback);
+    // Register our packet callback for visualization. Every frame type:
+    // the PPS dial and channel activity count raw traffic, control included.
+    NetworkRecon::setPacketCallback(promiscuousCallback, FrameInterest::kAll);
     
     running = true;
     lastUpdateTime = millis();
@@ -2036,31 +2038,15 @@ void SpectrumMode::promiscuousCallback(const wifi_promiscuous_pkt_t* pkt, wifi_p
     // BSSID is at offset 16
     const uint8_t* bssid = payload + 16;
     
-    // Parse SSID and DS channel from tagged parameters (starts at offset 36)
+    // SSID, DS channel, RSN/WPA and PMF bits in one IE pass (shared with NetworkRecon)
+    BeaconSummary scratch;
+    const BeaconSummary& ies = NetworkRecon::summarizeBeacon(payload, len, scratch);
+    
     char ssid[33] = {0};
-    bool ssidFound = false;
-    uint8_t dsChannel = 0;
-    uint16_t offset = 36;
-    
-    while (offset + 2 < len) {
-        if (offset + 2 >= len) break; // Additional bounds check
-        uint8_t tagNum = payload[offset];
-        uint8_t tagLen = payload[offset + 1];
-        
-        if (offset + 2 + tagLen > len) break;
-        
-        if (tagNum == 0 && tagLen <= 32) {  // SSID tag
-            if (offset + 2 + tagLen >= len) break; // Bounds check before memcpy
-            memcpy(ssid, payload + offset + 2, tagLen);
-            ssid[tagLen] = 0;
-            ssidFound = true;
-        } else if (tagNum == 3 && tagLen == 1) {  // DS Parameter Set (channel)
-            dsChannel = payload[offset + 2];
-        }
-        
-        if (ssidFound && dsChannel >= 1 && dsChannel <= 13) break;
-        offset += 2 + tagLen;
+    if (ies.ssidLen <= 32) {
+        ies.copySsid(ssid);
     }
+    uint8_t dsChannel = ies.dsChannel;
     
     bool channelTrusted = (dsChannel >= 1 && dsChannel <= 13);
     uint8_t channel = channelTrusted ? dsChannel : rxChannel;
@@ -2068,48 +2054,10 @@ void SpectrumMode::promiscuousCallback(const wifi_promiscuous_pkt_t* pkt, wifi_p
     // Validate channel range (after DS channel override)
     if (channel < 1 || channel > 13) return;
     
-    // Parse auth mode from RSN (0x30) and WPA (0xDD) IEs
-    wifi_auth_mode_t authmode = WIFI_AUTH_OPEN;  // Default to open
-    bool hasRSN = false;
-    offset = 36;
-    while (offset + 2 < len) {
-        if (offset + 2 >= len) break; // Additional bounds check
-        uint8_t tagNum = payload[offset];
-        uint8_t tagLen = payload[offset + 1];
-        
-        if (offset + 2 + tagLen > len) break;
-        
-        if (tagNum == 0x30 && tagLen >= 2) {  // RSN IE = WPA2/WPA3
-            hasRSN = true;
-            authmode = WIFI_AUTH_WPA2_PSK;
-        } else if (tagNum == 0xDD && tagLen >= 8) {  // Vendor specific
-            // Check for WPA1 OUI: 00:50:F2:01
-            if (offset + 5 < len &&  // Ensure we don't read past buffer
-                payload[offset + 2] == 0x00 && payload[offset + 3] == 0x50 &&
-                payload[offset + 4] == 0xF2 && payload[offset + 5] == 0x01) {
-                // WPA1 - only set if not already WPA2
-                if (!hasRSN) {
-                    authmode = WIFI_AUTH_WPA_PSK;
-                } else {
-                    authmode = WIFI_AUTH_WPA_WPA2_PSK;
-                }
-            }
-        }
-        
-        offset += 2 + tagLen;
-    }
-    
-    // Detect PMF - need both MFPC and MFPR to distinguish WPA3 from WPA2/WPA3 mixed
-    bool hasPMF = false;
-    bool pmfCapable = false;
-    if (hasRSN && authmode == WIFI_AUTH_WPA2_PSK) {
-        detectPMFBits(payload, len, pmfCapable, hasPMF);
-        if (hasPMF) {
-            authmode = WIFI_AUTH_WPA3_PSK;         // MFPR=1: pure WPA3-SAE
-        } else if (pmfCapable) {
-            authmode = WIFI_AUTH_WPA2_WPA3_PSK;    // MFPC=1 only: transitional
-        }
-    }
+    // Auth mode from RSN (0x30) and WPA (0xDD) IEs, upgraded by MFPC/MFPR
+    // MFPR=1: pure WPA3-SAE, MFPC=1 only: WPA2/WPA3 transitional
+    wifi_auth_mode_t authmode = (wifi_auth_mode_t)ies.auth();
+    bool hasPMF = ies.hasRSN && !ies.hasWPA && ies.mfpr;
     
     // Update spectrum data
     onBeacon(bssid, channel, channelTrusted, rssi, ssid, authmode, hasPMF, isProbeResponse);
@@ -2174,40 +2122,10 @@ const char* SpectrumMode::authModeToShortString(wifi_auth_mode_t mode) {
 // Extract both PMF bits from RSN IE - MFPC (capable) and MFPR (required)
 // MFPC=1,MFPR=0 = WPA2/WPA3 transitional. MFPR=1 = pure WPA3, deauth immune.
 void SpectrumMode::detectPMFBits(const uint8_t* payload, uint16_t len, bool& mfpc, bool& mfpr) {
-    mfpc = false;
-    mfpr = false;
-    uint16_t offset = 36;
-
-    while (offset + 2 < len) {
-        uint8_t tag = payload[offset];
-        uint8_t tagLen = payload[offset + 1];
-
-        if (offset + 2 + tagLen > len) break;
-
-        if (tag == 0x30 && tagLen >= 8) {  // RSN IE
-            uint16_t rsnOffset = offset + 2;
-            uint16_t rsnEnd = rsnOffset + tagLen;
-
-            rsnOffset += 6;  // Skip version(2) + group cipher(4)
-            if (rsnOffset + 2 > rsnEnd) break;
-
-            uint16_t pairwiseCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (pairwiseCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-
-            uint16_t akmCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (akmCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-
-            // RSN Capabilities - IEEE 802.11-2016 Table 9-133
-            uint16_t rsnCaps = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            mfpc = (rsnCaps >> 6) & 0x01;  // Bit 6: MFPC
-            mfpr = (rsnCaps >> 7) & 0x01;  // Bit 7: MFPR
-            return;
-        }
-
-        offset += 2 + tagLen;
-    }
+    BeaconSummary scratch;
+    const BeaconSummary& ies = NetworkRecon::summarizeBeacon(payload, len, scratch);
+    mfpc = ies.mfpc;
+    mfpr = ies.mfpr;
 }
 
 // Detect if PMF is required (MFPR=1) - deauth won't work against these
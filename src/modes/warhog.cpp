@@ -3,12 +3,15 @@
 // Key changes from original:
 // - No entries[] vector - data goes directly to disk
 // - No "waiting for GPS" state - either GPS or ML-only
-// - Simpler memory management - Bloom filter for duplicate detection
-// - Per-network file writes instead of batch saves
+// - Simpler memory management - fixed-size SeenFilter for duplicate
+//   detection; an AP is logged again when its signal improves
+// - Per-network binary records buffered into one long-lived session log
+//   (wardrive_format.h); WiGLE/CSV text is rendered on demand
+// - Passive mode (default): sightings stream from NetworkRecon's published
+//   snapshot instead of blocking WiFi.scanNetworks() rounds
 
 #include "warhog.h"
 #include "oink.h"
-#include "../build_info.h"
 #include "../core/config.h"
 #include "../core/wifi_utils.h"
 #include "../core/heap_policy.h"
@@ -17,6 +20,10 @@
 #include "../core/wsl_bypasser.h"
 #include "../core/sdlog.h"
 #include "../core/sd_layout.h"
+#include "../core/captured_index.h"
+#include "../core/session_log_writer.h"
+#include "../core/wardrive_format.h"
+#include "../core/seen_filter.h"
 #include "../core/xp.h"
 #include "../ui/display.h"
 #include "../piglet/mood.h"
@@ -30,13 +37,13 @@
 #include <string.h>
 #include <esp_heap_caps.h>
 
-// Bloom filter for seen BSSIDs (fixed memory, no heap churn)
-// 4KB = 32,768 bits -> ~1.5% false positives around 5k entries with 3 hashes
-static const size_t SEEN_BLOOM_BYTES = 4096;
-static const size_t SEEN_BLOOM_BITS = SEEN_BLOOM_BYTES * 8;
-static const size_t SEEN_BLOOM_MASK = SEEN_BLOOM_BITS - 1;
-static const uint8_t SEEN_BLOOM_HASHES = 3;
-static_assert((SEEN_BLOOM_BITS & (SEEN_BLOOM_BITS - 1)) == 0, "SEEN_BLOOM_BITS must be power of two");
+// Seen filter for BSSIDs (fixed memory, no heap churn)
+// 8KB = 4096 fingerprint + best-signal slots, ~0.2% false positives at any
+// session size; once full, random residents (mostly APs left far behind)
+// make room and may be logged a second time
+static const size_t SEEN_FILTER_BYTES = 8192;
+// Re-log an AP once it is heard this much stronger than its last record
+static const uint8_t RELOG_GAIN_DB = 10;
 
 // Captured bloom for bounty exclusion (small, fast)
 static const size_t CAPTURED_BLOOM_BYTES = 2048;
@@ -53,30 +60,37 @@ static const size_t BOUNTY_POOL_SIZE = 50;
 // Minimum scan interval to avoid tight-loop scanning
 static const uint32_t SCAN_INTERVAL_MIN_MS = 1000;
 
-// SD card retry settings (SD can be busy with other operations)
-static const int SD_RETRY_COUNT = 3;
-static const int SD_RETRY_DELAY_MS = 10;
-
-// WiGLE file size limit for upload compatibility (400KB - leave room for headers)
-// Files larger than this will be rotated to a new file
-static const size_t WIGLE_FILE_MAX_SIZE = 400000;
+// Passive mode: only networks heard this recently are geotagged with the
+// current fix (~30m of travel at highway speed). Older snapshot entries wait
+// for their next beacon rather than being tagged where we are now.
+static const uint32_t PASSIVE_FRESH_MS = 1000;
+// Passive mode: batch mood/log reports instead of one per 200ms snapshot
+static const uint32_t PASSIVE_REPORT_MS = 5000;
+
+// Session log buffer: records are batched in RAM and written on a fill
+// threshold, after LOG_FLUSH_MS, or when the mode stops
+static const size_t LOG_BUFFER = 2048;
+static const uint32_t LOG_FLUSH_MS = 10000;
+
+// WiGLE file size limit per upload (2MB of CSV; uploads are gzipped to
+// roughly a third of that). A session file rotates once its worst-case
+// WiGLE rendering would exceed it
+static const size_t WIGLE_FILE_MAX_SIZE = 2000000;
+static const uint32_t LOG_MAX_RECORDS =
+    (WIGLE_FILE_MAX_SIZE - WardriveFormat::kMaxWigleHeader) / WardriveFormat::kMaxWigleLine;
+
+// Records store wifi_auth_mode_t as-is; the renderers rely on these values
+static_assert(WIFI_AUTH_OPEN == WardriveFormat::AUTH_OPEN &&
+              WIFI_AUTH_WPA2_PSK == WardriveFormat::AUTH_WPA2_PSK &&
+              WIFI_AUTH_WPA3_PSK == WardriveFormat::AUTH_WPA3_PSK &&
+              WIFI_AUTH_WAPI_PSK == WardriveFormat::AUTH_WAPI_PSK,
+              "WardriveFormat::Auth must match wifi_auth_mode_t");
 
 // Graceful stop request flag for background scan task
 static volatile bool stopRequested = false;
 // Set by scan task just before self-deleting, used for safe cleanup in stop()
 static volatile bool scanTaskExited = false;
 
-// Helper: Open SD file with retry logic
-static File openFileWithRetry(const char* path, const char* mode) {
-    File f;
-    for (int retry = 0; retry < SD_RETRY_COUNT; retry++) {
-        f = SD.open(path, mode);
-        if (f) return f;
-        delay(SD_RETRY_DELAY_MS);
-    }
-    return f;  // Returns invalid File if all retries failed
-}
-
 // Haversine formula for GPS distance calculation
 static double haversineMeters(double lat1, double lon1, double lat2, double lon2) {
     const double R = 6371000.0;  // Earth radius in meters
@@ -96,11 +110,20 @@ static double lastGPSLat = 0;
 static double lastGPSLon = 0;
 static uint32_t lastDistanceCheck = 0;
 
+// Passive mode state
+static uint32_t lastReconGeneration = 0;
+static uint32_t passiveNew = 0;
+static uint32_t passiveGeotagged = 0;
+static uint32_t lastPassiveReport = 0;
+
 // Static members
 bool WarhogMode::running = false;
+bool WarhogMode::passive = false;
 uint32_t WarhogMode::lastScanTime = 0;
 uint32_t WarhogMode::scanInterval = 5000;
-static uint8_t seenBloom[SEEN_BLOOM_BYTES];
+static uint16_t seenStorage[SEEN_FILTER_BYTES / sizeof(uint16_t)];
+static SeenFilter seenFilter;
+static uint32_t relogCount = 0;
 static uint8_t capturedBloom[CAPTURED_BLOOM_BYTES];
 static uint64_t bountyPool[BOUNTY_POOL_SIZE];
 static uint16_t bountyPoolCount = 0;
@@ -111,7 +134,10 @@ uint32_t WarhogMode::wepNetworks = 0;
 uint32_t WarhogMode::wpaNetworks = 0;
 uint32_t WarhogMode::savedCount = 0;      // Geotagged networks (CSV)
 char WarhogMode::currentFilename[128] = {0};
-char WarhogMode::currentWigleFilename[128] = {0};
+
+// Session log stays open from the first geotagged network until stop()
+static char logStorage[LOG_BUFFER];
+static SessionLogWriter sessionLog(logStorage, sizeof(logStorage), LOG_FLUSH_MS);
 
 // Scan state
 bool WarhogMode::scanInProgress = false;
@@ -157,7 +183,8 @@ static void bloomAdd(uint8_t* bloom, size_t mask, uint8_t hashes, uint64_t key)
 }
 
 static void resetSeenTracking() {
-    memset(seenBloom, 0, sizeof(seenBloom));
+    seenFilter.attach(seenStorage, sizeof(seenStorage), RELOG_GAIN_DB);
+    relogCount = 0;
     memset(capturedBloom, 0, sizeof(capturedBloom));
     bountyPoolCount = 0;
     bountySeenTotal = 0;
@@ -176,19 +203,6 @@ static uint32_t clampScanIntervalMs(uint32_t intervalMs) {
     return (intervalMs < SCAN_INTERVAL_MIN_MS) ? SCAN_INTERVAL_MIN_MS : intervalMs;
 }
 
-// Helper to write CSV-escaped SSID field (quoted, doubles internal quotes, strips control chars)
-static void writeCSVField(File& f, const char* ssid) {
-    f.print("\"");
-    for (int i = 0; i < 32 && ssid[i]; i++) {
-        if (ssid[i] == '"') {
-            f.print("\"\"");
-        } else if (ssid[i] >= 32) {  // Skip control characters (newlines, etc)
-            f.print(ssid[i]);
-        }
-    }
-    f.print("\"");
-}
-
 void WarhogMode::init() {
     totalNetworks = 0;
     openNetworks = 0;
@@ -196,7 +210,6 @@ void WarhogMode::init() {
     wpaNetworks = 0;
     savedCount = 0;
     currentFilename[0] = '\0';
-    currentWigleFilename[0] = '\0';
 
     resetSeenTracking();
 
@@ -213,7 +226,6 @@ void WarhogMode::start() {
     wpaNetworks = 0;
     savedCount = 0;
     currentFilename[0] = '\0';
-    currentWigleFilename[0] = '\0';
 
     resetSeenTracking();
     seedCapturedFromOink();
@@ -229,21 +241,34 @@ void WarhogMode::start() {
     // Reset stop flag for clean start
     stopRequested = false;
 
-    // Stop NetworkRecon before WiFi manipulation (uses promiscuous mode, incompatible with STA scanning)
-    NetworkRecon::stop();
-    
-    // Soft WiFi reset — keep driver alive to avoid esp_wifi_init() RX buffer failures
-    WiFi.disconnect(false, true);  // Keep driver, erase AP credentials
-    delay(200);             // Let it settle
-    WiFi.mode(WIFI_STA);    // Station mode for scanning
-    
-    // Randomize MAC if enabled (stealth)
-    if (Config::wifi().randomizeMAC) {
-        WSLBypasser::randomizeMAC();
+    passive = Config::gps().passiveScan;
+    lastReconGeneration = 0;
+    passiveNew = 0;
+    passiveGeotagged = 0;
+    lastPassiveReport = 0;
+
+    if (passive) {
+        // Recon already hops and tracks every beacon - consume its snapshot
+        // instead of tearing promiscuous mode down for STA scans
+        NetworkRecon::start();
+        SDLOG("WARHOG", "Passive mode (NetworkRecon sightings)");
+    } else {
+        // Stop NetworkRecon before WiFi manipulation (uses promiscuous mode, incompatible with STA scanning)
+        NetworkRecon::stop();
+
+        // Soft WiFi reset — keep driver alive to avoid esp_wifi_init() RX buffer failures
+        WiFi.disconnect(false, true);  // Keep driver, erase AP credentials
+        delay(200);             // Let it settle
+        WiFi.mode(WIFI_STA);    // Station mode for scanning
+
+        // Randomize MAC if enabled (stealth)
+        if (Config::wifi().randomizeMAC) {
+            WSLBypasser::randomizeMAC();
+        }
+
+        delay(200);             // Let it initialize
     }
     
-    delay(200);             // Let it initialize
-    
     // Reset scan state (critical for proper operation after restart)
     scanInProgress = false;
     scanStartTime = 0;
@@ -301,6 +326,13 @@ void WarhogMode::stop() {
     Avatar::setGrassMoving(false);
     
     running = false;
+
+    SDLOG("WARHOG", "Seen filter: %u/%u APs, %lu dropped, %lu re-logged closer",
+          (unsigned)seenFilter.size(), (unsigned)seenFilter.capacity(),
+          (unsigned long)seenFilter.getDrops(), (unsigned long)relogCount);
+
+    // Write out anything still buffered and release the file handle
+    sessionLog.close();
     
     // Put GPS to sleep if power management enabled
     if (Config::gps().powerSave) {
@@ -405,6 +437,14 @@ void WarhogMode::update() {
         lastPhraseTime = now;
     }
     
+    // Age-based flush keeps the card current when few new networks appear
+    sessionLog.poll();
+
+    if (passive) {
+        processReconSightings();
+        return;
+    }
+
     // Check if background scan task is complete
     if (scanInProgress) {
         if (scanResult >= 0) {
@@ -437,7 +477,7 @@ void WarhogMode::update() {
 }
 
 void WarhogMode::triggerScan() {
-    if (!scanInProgress) {
+    if (!passive && !scanInProgress) {
         performScan();
     }
 }
@@ -477,72 +517,23 @@ void WarhogMode::performScan() {
     }
 }
 
-// Ensure CSV file exists with header
-bool WarhogMode::ensureCSVFileReady() {
-    if (currentFilename[0] != '\0') return true;
-
-    // Ensure wardriving directory exists
-    const char* wardrivingDir = SDLayout::wardrivingDir();
-    if (!SD.exists(wardrivingDir)) {
-        if (!SD.mkdir(wardrivingDir)) {
-            return false;
-        }
-    }
-
-    generateFilename(currentFilename, sizeof(currentFilename), "csv");
-
-    File f = openFileWithRetry(currentFilename, FILE_WRITE);
-    if (!f) {
-        currentFilename[0] = '\0';
-        return false;
-    }
-    
-    f.println("BSSID,SSID,RSSI,Channel,AuthMode,Latitude,Longitude,Altitude,Timestamp");
-    f.close();
-    
-    return true;
-}
-
-// Append single network to CSV file
-void WarhogMode::appendCSVEntry(const uint8_t* bssid, const char* ssid,
-                                 int8_t rssi, uint8_t channel, wifi_auth_mode_t auth,
-                                 double lat, double lon, double alt) {
-    if (!ensureCSVFileReady()) return;
-    
-    File f = openFileWithRetry(currentFilename, FILE_APPEND);
-    if (!f) return;
-
-    f.printf("%02X:%02X:%02X:%02X:%02X:%02X,",
-            bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
-    writeCSVField(f, ssid);
-    f.print(",");
-    f.printf("%d,%d,%s,%.6f,%.6f,%.1f,%lu\n",
-            rssi, channel, authModeToString(auth),
-            lat, lon, alt, millis());
-    f.close();
-}
-
-// Check if WiGLE file needs rotation due to size
-void WarhogMode::checkWigleFileRotation() {
-    if (currentWigleFilename[0] == '\0') return;
-
-    File f = SD.open(currentWigleFilename, FILE_READ);
-    if (!f) return;
-
-    size_t fileSize = f.size();
-    f.close();
+// Rotate the session log before its WiGLE rendering could outgrow uploads
+// (size tracked by the writer, no SD access)
+void WarhogMode::checkLogRotation() {
+    if (!sessionLog.isOpen()) return;
 
-    if (fileSize >= WIGLE_FILE_MAX_SIZE) {
-        currentWigleFilename[0] = '\0';  // Force new file creation on next append
+    if (WardriveFormat::recordCount(sessionLog.fileBytes()) >= LOG_MAX_RECORDS) {
+        sessionLog.close();
+        currentFilename[0] = '\0';  // Force new file creation on next append
     }
 }
 
-// Ensure WiGLE file exists with header
-bool WarhogMode::ensureWigleFileReady() {
+// Ensure the session log exists with its file header
+bool WarhogMode::ensureLogFileReady() {
     // Check if current file needs rotation
-    checkWigleFileRotation();
-    
-    if (currentWigleFilename[0] != '\0') return true;
+    checkLogRotation();
+
+    if (sessionLog.isOpen()) return true;
 
     // Ensure wardriving directory exists
     const char* wardrivingDir = SDLayout::wardrivingDir();
@@ -552,118 +543,28 @@ bool WarhogMode::ensureWigleFileReady() {
         }
     }
 
-    generateFilename(currentWigleFilename, sizeof(currentWigleFilename), "wigle.csv");
+    generateFilename(currentFilename, sizeof(currentFilename), "wdr");
 
-    File f = openFileWithRetry(currentWigleFilename, FILE_WRITE);
-    if (!f) {
-        currentWigleFilename[0] = '\0';
+    WardriveFormat::FileHeader header = WardriveFormat::makeFileHeader();
+    if (!sessionLog.open(currentFilename, &header, sizeof(header))) {
+        currentFilename[0] = '\0';
         return false;
     }
-    
-    // WiGLE format v1.6 pre-header
-    f.print("WigleWifi-1.6,appRelease=");
-    #ifdef BUILD_VERSION
-    f.print(BUILD_VERSION);
-    #else
-    f.print("0.1.x");
-    #endif
-    f.print(",model=M5Cardputer,release=ESP32-S3,device=PORKCHOP,display=240x135,board=m5stack,brand=M5Stack,star=Sol,body=3,subBody=0\n");
-    
-    // WiGLE format header
-    f.println("MAC,SSID,AuthMode,FirstSeen,Channel,Frequency,RSSI,CurrentLatitude,CurrentLongitude,AltitudeMeters,AccuracyMeters,RCOIs,MfgrId,Type");
-    f.close();
-    
-    return true;
-}
 
-// Convert auth mode to WiGLE capability string format (returns string literal, zero allocation)
-const char* WarhogMode::authModeToWigleString(wifi_auth_mode_t mode) {
-    switch (mode) {
-        case WIFI_AUTH_OPEN:          return "[ESS]";
-        case WIFI_AUTH_WEP:           return "[WEP][ESS]";
-        case WIFI_AUTH_WPA_PSK:       return "[WPA-PSK-CCMP][ESS]";
-        case WIFI_AUTH_WPA2_PSK:      return "[WPA2-PSK-CCMP][ESS]";
-        case WIFI_AUTH_WPA_WPA2_PSK:  return "[WPA-PSK-CCMP+TKIP][WPA2-PSK-CCMP+TKIP][ESS]";
-        case WIFI_AUTH_WPA3_PSK:      return "[WPA3-SAE][ESS]";
-        case WIFI_AUTH_WPA2_WPA3_PSK: return "[WPA2-PSK-CCMP][WPA3-SAE][ESS]";
-        case WIFI_AUTH_WAPI_PSK:      return "[WAPI-PSK][ESS]";
-        default:                      return "[ESS]";
-    }
+    return true;
 }
 
-static int channelToFrequency(uint8_t channel) {
-    if (channel >= 1 && channel <= 13) {
-        return 2412 + (channel - 1) * 5;
-    }
-    if (channel == 14) {
-        return 2484;
-    }
-    if (channel <= 196) {
-        return 5000 + channel * 5;
-    }
-    if (channel <= 233) {
-        return 5950 + channel * 5;
-    }
-    return 0;
-}
+// Append one geotagged network (64 bytes, no text formatting)
+void WarhogMode::appendRecord(const uint8_t* bssid, const char* ssid,
+                              int8_t rssi, uint8_t channel, wifi_auth_mode_t auth,
+                              const GPSData& gps, double accuracy) {
+    if (!ensureLogFileReady()) return;
 
-// Append single network to WiGLE file
-void WarhogMode::appendWigleEntry(const uint8_t* bssid, const char* ssid,
-                                   int8_t rssi, uint8_t channel, wifi_auth_mode_t auth,
-                                   double lat, double lon, double alt, double accuracy) {
-    if (!ensureWigleFileReady()) return;
-    
-    File f = openFileWithRetry(currentWigleFilename, FILE_APPEND);
-    if (!f) return;
-    
-    // MAC (BSSID with colons)
-    f.printf("%02X:%02X:%02X:%02X:%02X:%02X,",
-            bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
-    
-    // SSID (escaped)
-    writeCSVField(f, ssid);
-    f.print(",");
-    
-    // AuthMode (WiGLE capability string)
-    f.print(authModeToWigleString(auth));
-    f.print(",");
-    
-    // FirstSeen (timestamp) - use GPS time if available, else millis
-    GPSData gps = GPS::getData();
-    if (gps.date > 0 && gps.time > 0) {
-        // date format: DDMMYY, time format: HHMMSSCC
-        uint8_t day = gps.date / 10000;
-        uint8_t month = (gps.date / 100) % 100;
-        uint8_t year = gps.date % 100;
-        uint8_t hour = gps.time / 1000000;
-        uint8_t minute = (gps.time / 10000) % 100;
-        uint8_t second = (gps.time / 100) % 100;
-        f.printf("20%02d-%02d-%02d %02d:%02d:%02d,", year, month, day, hour, minute, second);
-    } else {
-        // Fallback - use boot time reference
-        f.printf("1970-01-01 00:00:%02d,", (millis() / 1000) % 60);
-    }
-    
-    // Channel
-    f.printf("%d,", channel);
-    
-    // Frequency (best-effort mapping for 2.4/5/6 GHz)
-    int freq = channelToFrequency(channel);
-    f.printf("%d,", freq);
-    
-    // RSSI
-    f.printf("%d,", rssi);
-    
-    // Latitude, Longitude, Altitude
-    f.printf("%.6f,%.6f,%.1f,", lat, lon, alt);
-    
-    // AccuracyMeters (GPS HDOP as accuracy estimate, or default 10m)
-    f.printf("%.1f,", accuracy > 0 ? accuracy : 10.0);
-    
-    // RCOIs (empty), MfgrId (empty), Type (WIFI)
-    f.println(",,WIFI");
-    
-    f.close();
+    WardriveFormat::Record rec = WardriveFormat::makeRecord(
+        bssid, ssid, rssi, channel, (uint8_t)auth,
+        gps.latitude, gps.longitude, gps.altitude, accuracy,
+        WardriveFormat::epochFromGps(gps.date, gps.time), millis());
+    sessionLog.append(&rec, sizeof(rec));
 }
 
 void WarhogMode::processScanResults() {
@@ -678,6 +579,8 @@ void WarhogMode::processScanResults() {
     GPSData gpsData = GPS::getData();
     bool hasGPS = GPS::hasFix();
     
+    bool canRecord = hasGPS && Config::isSDAvailable();
+    
     SDLOG("WARHOG", "Processing %d networks (GPS: %s)", n, hasGPS ? "yes" : "no");
     
     uint32_t newThisScan = 0;
@@ -692,43 +595,113 @@ void WarhogMode::processScanResults() {
 
         uint8_t* bssidPtr = WiFi.BSSID(i);
         if (!bssidPtr) continue;
-        
-        uint64_t bssidKey = bssidToKey(bssidPtr);
-        
-        // Skip if already processed this session (Bloom filter)
-        if (bloomTest(seenBloom, SEEN_BLOOM_MASK, SEEN_BLOOM_HASHES, bssidKey)) {
+
+        // Repeats are the common case - skip them before building a String
+        if (seenFilter.check(bssidToKey(bssidPtr), WiFi.RSSI(i), canRecord) ==
+            SeenFilter::Result::Repeat) {
             continue;
         }
 
-        // Mark as seen and update bounty reservoir before any file writes
-        bloomAdd(seenBloom, SEEN_BLOOM_MASK, SEEN_BLOOM_HASHES, bssidKey);
-        bountySeenTotal++;
-        if (bountyPoolCount < BOUNTY_POOL_SIZE) {
-            bountyPool[bountyPoolCount++] = bssidKey;
-        } else {
-            uint32_t pick = esp_random() % bountySeenTotal;
-            if (pick < BOUNTY_POOL_SIZE) {
-                bountyPool[pick] = bssidKey;
-            }
-        }
-        
         // Extract SSID to stack buffer — avoids heap String for each of 50+ networks
         char ssidBuf[33];
         strncpy(ssidBuf, WiFi.SSID(i).c_str(), sizeof(ssidBuf) - 1);
         ssidBuf[sizeof(ssidBuf) - 1] = '\0';
-        const char* ssid = ssidBuf;
-        int8_t rssi = WiFi.RSSI(i);
-        uint8_t channel = WiFi.channel(i);
-        wifi_auth_mode_t authmode = WiFi.encryptionType(i);
-        
-        // Validate extracted data to prevent potential crashes
-        if (!ssid || strlen(ssid) > 32) continue;
-        if (channel == 0 || channel > 165) continue; // Valid WiFi channels are 1-165
 
+        uint32_t savedBefore = savedCount;
+        if (logSighting(bssidPtr, ssidBuf, WiFi.RSSI(i), WiFi.channel(i),
+                        WiFi.encryptionType(i), hasGPS, gpsData)) {
+            newThisScan++;
+            geotaggedThisScan += savedCount - savedBefore;
+        }
+    }
+    
+    // Trigger mood update if we found new networks
+    if (newThisScan > 0) {
+        Mood::onWarhogFound(nullptr, 0);
+        SDLOG("WARHOG", "Found %lu new (%lu geotagged)", newThisScan, geotaggedThisScan);
+    }
+    
+    WiFi.scanDelete();
+}
+
+// Passive mode: log every network NetworkRecon heard within PASSIVE_FRESH_MS.
+// Snapshots republish every 200ms, so this sees each beacon burst once per
+// hop cycle with no scan dead time; the seen filter drops repeats.
+void WarhogMode::processReconSightings() {
+    uint32_t now = millis();
+    {
+        NetworkRecon::Snapshot snap;
+        if (snap.generation() != lastReconGeneration) {
+            lastReconGeneration = snap.generation();
+
+            GPSData gpsData = GPS::getData();
+            bool hasGPS = GPS::hasFix();
+            uint32_t savedBefore = savedCount;
+
+            for (const auto& view : snap) {
+                // Signed age: the RX worker may stamp lastSeen after 'now'
+                if ((int32_t)(now - view.lastSeen) > (int32_t)PASSIVE_FRESH_MS) continue;
+                if (logSighting(view.bssid, view.ssid, view.rssi, view.channel,
+                                (wifi_auth_mode_t)view.authmode, hasGPS, gpsData)) {
+                    passiveNew++;
+                }
+            }
+            passiveGeotagged += savedCount - savedBefore;
+        }
+    }
+
+    if (passiveNew > 0 && now - lastPassiveReport >= PASSIVE_REPORT_MS) {
+        Mood::onWarhogFound(nullptr, 0);
+        SDLOG("WARHOG", "Found %lu new (%lu geotagged)", passiveNew, passiveGeotagged);
+        passiveNew = 0;
+        passiveGeotagged = 0;
+        lastPassiveReport = now;
+    }
+}
+
+// Dedupe, bounty, stats and XP for one sighting; geotag it if GPS has a fix
+// (again later if the network is heard much stronger)
+// @return true if this is the first sighting of the network this session
+bool WarhogMode::logSighting(const uint8_t* bssid, const char* ssid,
+                             int8_t rssi, uint8_t channel, wifi_auth_mode_t authmode,
+                             bool hasGPS, const GPSData& gpsData) {
+    uint64_t bssidKey = bssidToKey(bssid);
+    bool canRecord = hasGPS && Config::isSDAvailable();
+
+    // Skip repeats; a known AP comes back only when it can finally be
+    // geotagged or is heard RELOG_GAIN_DB stronger than its last record
+    SeenFilter::Result seen = seenFilter.observe(bssidKey, rssi, canRecord);
+    if (seen == SeenFilter::Result::Repeat) {
+        return false;
+    }
+    bool isNew = (seen == SeenFilter::Result::New);
+
+    // Update bounty reservoir before any file writes.
+    // Networks looted in earlier sessions are never bounties.
+    if (isNew) {
+        if (CapturedIndex::contains(bssid, CapturedIndex::kAnyCapture)) {
+            bloomAdd(capturedBloom, CAPTURED_BLOOM_MASK, CAPTURED_BLOOM_HASHES, bssidKey);
+        } else {
+            bountySeenTotal++;
+            if (bountyPoolCount < BOUNTY_POOL_SIZE) {
+                bountyPool[bountyPoolCount++] = bssidKey;
+            } else {
+                uint32_t pick = esp_random() % bountySeenTotal;
+                if (pick < BOUNTY_POOL_SIZE) {
+                    bountyPool[pick] = bssidKey;
+                }
+            }
+        }
+    }
+
+    // Validate extracted data to prevent potential crashes
+    if (!ssid || strlen(ssid) > 32) return false;
+    if (channel == 0 || channel > 165) return false; // Valid WiFi channels are 1-165
+
+    if (isNew) {
         // Update statistics
         totalNetworks++;
-        newThisScan++;
-        
+
         // Track auth types
         switch (authmode) {
             case WIFI_AUTH_OPEN:
@@ -749,33 +722,23 @@ void WarhogMode::processScanResults() {
                 XP::addXP(XPEvent::NETWORK_FOUND);
                 break;
         }
-        
-        // Write to files based on GPS status
-        if (Config::isSDAvailable()) {
-            if (hasGPS) {
-                // Full wardriving: both CSV, WiGLE, and ML
-                appendCSVEntry(bssidPtr, ssid, rssi, channel, authmode,
-                              gpsData.latitude, gpsData.longitude, gpsData.altitude);
-                
-                // WiGLE format export (HDOP * 5 as rough accuracy estimate in meters)
-                double accuracy = gpsData.hdop > 0 ? gpsData.hdop * 5.0 : 10.0;
-                appendWigleEntry(bssidPtr, ssid, rssi, channel, authmode,
-                                gpsData.latitude, gpsData.longitude, gpsData.altitude, accuracy);
-                
-                savedCount++;
-                geotaggedThisScan++;
-                XP::addXP(XPEvent::WARHOG_LOGGED);  // +2 XP for geotagged network
-            }
-        }
     }
-    
-    // Trigger mood update if we found new networks
-    if (newThisScan > 0) {
-        Mood::onWarhogFound(nullptr, 0);
-        SDLOG("WARHOG", "Found %lu new (%lu geotagged)", newThisScan, geotaggedThisScan);
+
+    // Write to files based on GPS status
+    if (canRecord) {
+        // Full wardriving: one record, rendered as WiGLE or CSV on demand
+        // (HDOP * 5 as rough WiGLE accuracy estimate in meters)
+        double accuracy = gpsData.hdop > 0 ? gpsData.hdop * 5.0 : 10.0;
+        appendRecord(bssid, ssid, rssi, channel, authmode, gpsData, accuracy);
+
+        if (seen == SeenFilter::Result::Better) {
+            relogCount++;  // Same network, closer fix - no XP
+        } else {
+            savedCount++;
+            XP::addXP(XPEvent::WARHOG_LOGGED);  // +2 XP for geotagged network
+        }
     }
-    
-    WiFi.scanDelete();
+    return isNew;
 }
 
 bool WarhogMode::hasGPSFix() {
@@ -787,29 +750,15 @@ GPSData WarhogMode::getGPSData() {
 }
 
 // Export functions - data is already on disk, these are for format conversion
-// They now read from the session CSV and convert format
+// WiGLE / CSV text is rendered from the session log by WardriveFormat::Renderer
 
 bool WarhogMode::exportCSV(const char* path) {
-    // Data is already in currentFilename as CSV
+    // Data is already in currentFilename as binary records
     // This function would copy/rename, but for now just return status
     return currentFilename[0] != '\0';
 }
 
 
-const char* WarhogMode::authModeToString(wifi_auth_mode_t mode) {
-    switch (mode) {
-        case WIFI_AUTH_OPEN:          return "OPEN";
-        case WIFI_AUTH_WEP:           return "WEP";
-        case WIFI_AUTH_WPA_PSK:       return "WPA";
-        case WIFI_AUTH_WPA2_PSK:      return "WPA2";
-        case WIFI_AUTH_WPA_WPA2_PSK:  return "WPA/WPA2";
-        case WIFI_AUTH_WPA3_PSK:      return "WPA3";
-        case WIFI_AUTH_WPA2_WPA3_PSK: return "WPA2/WPA3";
-        case WIFI_AUTH_WAPI_PSK:      return "WAPI";
-        default:                      return "UNKNOWN";
-    }
-}
-
 // === BOUNTY SYSTEM (Phase 5) ===
 // Track which BSSIDs were actually captured (handshakes/PMKIDs) so Papa only sends misses
 void WarhogMode::markCaptured(const uint8_t* bssid) {
@@ -25,6 +25,7 @@ public:
     static void stop();
     static void update();
     static bool isRunning() { return running; }
+    static bool isPassive() { return passive; }
     
     // Scan control
     static void triggerScan();
@@ -51,6 +52,7 @@ public:
 
 private:
     static bool running;
+    static bool passive;             // Sightings come from NetworkRecon, no scan task
     static uint32_t lastScanTime;
     static uint32_t scanInterval;
     static bool scanInProgress;
@@ -62,8 +64,7 @@ private:
     static uint32_t wepNetworks;
     static uint32_t wpaNetworks;
     static uint32_t savedCount;      // Networks saved with GPS to CSV
-    static char currentFilename[128];   // Current session CSV file
-    static char currentWigleFilename[128]; // Current session WiGLE CSV file
+    static char currentFilename[128];   // Current session log (.wdr)
 
     // Background scan task
     static TaskHandle_t scanTaskHandle;
@@ -72,19 +73,17 @@ private:
     static void performScan();
     static void scanTask(void* pvParameters);
     static void processScanResults();
+    static void processReconSightings();
+    static bool logSighting(const uint8_t* bssid, const char* ssid,
+                            int8_t rssi, uint8_t channel, wifi_auth_mode_t auth,
+                            bool hasGPS, const GPSData& gps);
     
-    // File helpers - write directly per-network
-    static bool ensureCSVFileReady();
-    static bool ensureWigleFileReady();
-    static void checkWigleFileRotation();
-    static void appendCSVEntry(const uint8_t* bssid, const char* ssid,
-                               int8_t rssi, uint8_t channel, wifi_auth_mode_t auth,
-                               double lat, double lon, double alt);
-    static void appendWigleEntry(const uint8_t* bssid, const char* ssid,
-                                 int8_t rssi, uint8_t channel, wifi_auth_mode_t auth,
-                                 double lat, double lon, double alt, double accuracy);
+    // File helpers - records go through a buffered session log
+    static bool ensureLogFileReady();
+    static void checkLogRotation();
+    static void appendRecord(const uint8_t* bssid, const char* ssid,
+                             int8_t rssi, uint8_t channel, wifi_auth_mode_t auth,
+                             const GPSData& gps, double accuracy);
     
-    static const char* authModeToString(wifi_auth_mode_t mode);
-    static const char* authModeToWigleString(wifi_auth_mode_t mode);
     static void generateFilename(char* buf, size_t bufSize, const char* ext);
 };
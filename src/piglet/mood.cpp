@@ -2084,7 +2084,7 @@ bool Mood::pickEncryptionPhraseIfDue(uint32_t now) {
     if (now - lastEncryptionPhraseMs < 300000) return false;  // Max 1 per 5 min
 
     // Scan current networks for notable encryption types
-    auto& nets = NetworkRecon::getNetworks();
+    NetworkRecon::Snapshot nets;
     uint8_t openCount = 0;
     bool hasWEP = false;
     bool hasWPA3 = false;
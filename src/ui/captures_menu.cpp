@@ -11,6 +11,9 @@
 #include "../web/wpasec.h"
 #include "../core/config.h"
 #include "../core/sd_layout.h"
+#include "../core/capture_journal.h"
+#include "../core/hash_export.h"
+#include "../core/captured_index.h"
 #include "../core/wifi_utils.h"
 #include "../core/heap_health.h"
 
@@ -37,7 +40,7 @@ uint8_t CapturesMenu::hintIndex = 0;
 const char* const CapturesMenu::HINTS[] = {
     "FEED YO HASHCAT.",
     "COLLECTED PAIN. COMPRESSED.",
-    "ENT:DET  S:SYNC  D:NUKE",
+    "ENT:DET S:SYNC E:EXP D:NUKE",
     "MALLOC SAID NAH.",
     "YOUR LOOT. YOUR PROBLEM."
 };
@@ -174,6 +177,54 @@ static bool isAllHex(const char* s, size_t n) {
     return true;
 }
 
+static bool endsWith(const char* s, const char* suffix) {
+    size_t n = strlen(s);
+    size_t m = strlen(suffix);
+    return n > m && strcmp(s + n - m, suffix) == 0;
+}
+
+// Journal records become list entries named like their loose-file twins
+void CapturesMenu::addJournalCaptures() {
+    size_t first = captures.size();
+    CaptureJournal::forEachRecord([](const CaptureJournal::RecordRef& rec, void* ctx) {
+        std::vector<CaptureInfo>& list = *(std::vector<CaptureInfo>*)ctx;
+        if (list.size() >= MAX_CAPTURES) return false;
+
+        CaptureInfo info;
+        memset(&info, 0, sizeof(info));
+        CaptureJournal::fileName(rec.hdr, info.filename, sizeof(info.filename));
+        JournalFormat::copySsid(rec.hdr, info.ssid);
+        if (info.ssid[0] == '\0') {
+            strncpy(info.ssid, "[UNKNOWN]", sizeof(info.ssid) - 1);
+        }
+        const uint8_t* b = rec.hdr.bssid;
+        snprintf(info.bssid, sizeof(info.bssid), "%02X:%02X:%02X:%02X:%02X:%02X",
+                 b[0], b[1], b[2], b[3], b[4], b[5]);
+        info.fileSize = rec.hdr.payloadLen;
+        info.captureTime = rec.written;
+        info.isPMKID = rec.hdr.type == (uint8_t)JournalFormat::RecordType::Pmkid22000;
+        info.status = CaptureStatus::LOCAL;
+        info.journalSession = rec.session;
+        info.journalOffset = rec.offset;
+        list.push_back(info);
+        return true;
+    }, &captures);
+
+    // Same de-dupe as the directory scan: a PCAP hides behind its _hs.22000
+    size_t out = first;
+    for (size_t i = first; i < captures.size(); i++) {
+        bool hidden = false;
+        if (endsWith(captures[i].filename, ".pcap")) {
+            for (size_t j = first; j < captures.size() && !hidden; j++) {
+                hidden = endsWith(captures[j].filename, "_hs.22000") &&
+                         strcmp(captures[j].bssid, captures[i].bssid) == 0;
+            }
+        }
+        if (!hidden) captures[out++] = captures[i];
+    }
+    captures.resize(out);
+}
+
 void CapturesMenu::processAsyncScan() {
     if (!scanInProgress || scanComplete) {
         return;
@@ -197,6 +248,9 @@ void CapturesMenu::processAsyncScan() {
             scanInProgress = false;
             scanDir.close();
 
+            // Finished OINK sessions: records are listed straight from the journals
+            addJournalCaptures();
+
             // Sort by capture time (newest first)
             std::sort(captures.begin(), captures.end(), [](const CaptureInfo& a, const CaptureInfo& b) {
                 return a.captureTime > b.captureTime;
@@ -239,6 +293,7 @@ void CapturesMenu::processAsyncScan() {
         if (isPCAP || isPMKID || isHS22000) {
             CaptureInfo info;
             memset(&info, 0, sizeof(info));
+            info.journalSession = CaptureJournal::kNoSession;
             strncpy(info.filename, name, sizeof(info.filename) - 1);
             info.fileSize = currentFile.size();
             info.captureTime = currentFile.getLastWrite();
@@ -517,6 +572,11 @@ void CapturesMenu::handleInput() {
         startSync();
     }
     
+    // E key merges every .22000 into one deduplicated hash file
+    if (M5Cardputer.Keyboard.isKeyPressed('e') || M5Cardputer.Keyboard.isKeyPressed('E')) {
+        exportAllHashes();
+    }
+    
     // Nuke all loot with D key
     if (M5Cardputer.Keyboard.isKeyPressed('d') || M5Cardputer.Keyboard.isKeyPressed('D')) {
         if (!captures.empty()) {
@@ -730,6 +790,14 @@ void CapturesMenu::drawNukeConfirm(M5Canvas& canvas) {
 void CapturesMenu::nukeLoot() {
     Serial.println("[CAPTURES] Nuking all loot...");
     
+    // Journaled sessions are loot too
+    uint16_t journals = CaptureJournal::removeAll();
+    if (journals > 0) {
+        Serial.printf("[CAPTURES] Nuked %u session journals\n", (unsigned)journals);
+        CapturedIndex::clear();
+        captures.clear();
+    }
+
     const char* handshakesDir = SDLayout::handshakesDir();
     if (!SD.exists(handshakesDir)) {
         return;
@@ -774,6 +842,7 @@ void CapturesMenu::nukeLoot() {
     }
     
     Serial.printf("[CAPTURES] Nuked %d files\n", deleted);
+    CapturedIndex::clear();  // Nothing looted any more
     
     // Reset selection
     selectedIndex = 0;
@@ -781,6 +850,25 @@ void CapturesMenu::nukeLoot() {
     captures.clear();
 }
 
+static void onExportProgress(uint8_t percent) {
+    Display::showProgress("MERGE 22000", percent);
+}
+
+void CapturesMenu::exportAllHashes() {
+    HashExport::Stats stats;
+    char msg[64];
+    if (HashExport::run(stats, onExportProgress)) {
+        snprintf(msg, sizeof(msg), "MERGED %lu HASHES\n%lu DUPES DROPPED",
+                 (unsigned long)stats.written, (unsigned long)stats.duplicates);
+    } else {
+        snprintf(msg, sizeof(msg), "%s", stats.files == 0 ? "NO 22000 LOOT" : "MERGE FAILED");
+    }
+    Display::showToast(msg);
+    Serial.printf("[CAPTURES] Hash export: %lu written, %lu dupes, %u passes\n",
+                  (unsigned long)stats.written, (unsigned long)stats.duplicates,
+                  (unsigned)stats.passes);
+}
+
 const char* CapturesMenu::getSelectedBSSID() {
     return HINTS[hintIndex];
 }
@@ -936,11 +1024,35 @@ void CapturesMenu::drawDetailView(M5Canvas& canvas) {
     // Cache: only parse once per detail view open
     static HSDetail cachedDetail;
     static char cachedFilename[48] = "";
-    if (strcmp(cachedFilename, cap.filename) != 0) {
+    static uint16_t cachedSession = CaptureJournal::kNoSession;
+    static uint32_t cachedOffset = 0;
+    if (strcmp(cachedFilename, cap.filename) != 0 ||
+        cachedSession != cap.journalSession || cachedOffset != cap.journalOffset) {
         memset(&cachedDetail, 0, sizeof(cachedDetail));
         strncpy(cachedFilename, cap.filename, sizeof(cachedFilename) - 1);
-
-        if (SD.exists(hsPath)) {
+        cachedSession = cap.journalSession;
+        cachedOffset = cap.journalOffset;
+
+        if (cap.journalSession != CaptureJournal::kNoSession) {
+            // Journal record: a 22000 payload is the line itself (PCAP
+            // records only stay listed when there is no 22000 twin)
+            char path[64];
+            CaptureJournal::journalPath(cap.journalSession, path, sizeof(path));
+            JournalFormat::RecordHeader hdr;
+            File f;
+            if (CaptureJournal::openRecord(path, cap.journalOffset, hdr, f)) {
+                if (hdr.type != (uint8_t)JournalFormat::RecordType::HandshakePcap) {
+                    char lineBuf[512];
+                    size_t want = hdr.payloadLen < sizeof(lineBuf) - 1 ? hdr.payloadLen : sizeof(lineBuf) - 1;
+                    int n = f.read((uint8_t*)lineBuf, want);
+                    lineBuf[n > 0 ? n : 0] = '\0';
+                    char* nl = strchr(lineBuf, '\n');
+                    if (nl) *nl = '\0';
+                    parseHS22000Line(lineBuf, &cachedDetail);
+                }
+                f.close();
+            }
+        } else if (SD.exists(hsPath)) {
             File f = SD.open(hsPath, FILE_READ);
             if (f) {
                 char lineBuf[512];
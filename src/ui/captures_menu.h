@@ -23,6 +23,8 @@ struct CaptureInfo {
     bool isPMKID;        // true = .22000 PMKID, false = .pcap handshake
     CaptureStatus status; // WPA-SEC status
     char password[64];    // Cracked password (if status == CRACKED)
+    uint16_t journalSession; // CaptureJournal::kNoSession for a loose file
+    uint32_t journalOffset;  // Record header offset within that journal
 };
 
 // Sync state machine for WPA-SEC operations
@@ -62,10 +64,12 @@ private:
     static const uint8_t VISIBLE_ITEMS = 5;
     
     static bool scanCaptures();  // Returns true if successful, false if SD access failed
+    static void addJournalCaptures();
     static void handleInput();
     static void drawNukeConfirm(M5Canvas& canvas);
     static void drawDetailView(M5Canvas& canvas);
     static void nukeLoot();
+    static void exportAllHashes();
     static void updateWPASecStatus();
     static void formatTime(char* out, size_t len, time_t t);
     static const size_t MAX_CAPTURES = 100;
@@ -13,6 +13,8 @@
 #include "../core/heap_health.h"
 #include "../core/heap_policy.h"
 #include "../core/wifi_utils.h"
+#include "../core/recon_metrics.h"
+#include "../core/network_recon.h"
 #include <WiFi.h>
 #include <esp_heap_caps.h>
 #include <esp_wifi.h>
@@ -20,6 +22,7 @@
 // Static member initialization
 bool DiagnosticsMenu::active = false;
 bool DiagnosticsMenu::keyWasPressed = false;
+bool DiagnosticsMenu::showMetrics = false;
 uint16_t DiagnosticsMenu::cachedWpaCracked = 0;
 uint16_t DiagnosticsMenu::cachedWigleUploaded = 0;
 uint32_t DiagnosticsMenu::lastStatRefreshMs = 0;
@@ -29,6 +32,7 @@ void DiagnosticsMenu::show() {
     active = true;
     keyWasPressed = true;  // Ignore the Enter that brought us here
     lastStatRefreshMs = 0; // force immediate refresh
+    showMetrics = false;
     HeapHealth::setKnuthEnabled(true);
 }
 
@@ -83,6 +87,19 @@ void DiagnosticsMenu::update() {
         return;
     }
 
+    // M key - toggle recon pipeline metrics page
+    if (M5Cardputer.Keyboard.isKeyPressed('m') || M5Cardputer.Keyboard.isKeyPressed('M')) {
+        showMetrics = !showMetrics;
+        return;
+    }
+
+    // X key - reset recon metrics (metrics page only)
+    if (showMetrics && (M5Cardputer.Keyboard.isKeyPressed('x') || M5Cardputer.Keyboard.isKeyPressed('X'))) {
+        ReconMetrics::reset();
+        Display::setTopBarMessage("METRICS RESET", 2000);
+        return;
+    }
+
     // Periodically refresh stats (e.g., every 5 seconds)
     if (millis() - lastStatRefreshMs > statRefreshIntervalMs) {
         refreshStats();
@@ -235,6 +252,11 @@ void DiagnosticsMenu::draw(M5Canvas& canvas) {
     canvas.setTextColor(COLOR_FG);
     canvas.setTextSize(1);
 
+    if (showMetrics) {
+        drawMetrics(canvas);
+        return;
+    }
+
     int y = 2;
     int lineH = 14;
 
@@ -363,5 +385,58 @@ void DiagnosticsMenu::draw(M5Canvas& canvas) {
     // Controls (compressed)
     canvas.drawString("[ENT]SAVE [R]WIFI", 4, y);
     y += lineH;
-    canvas.drawString("[H]HEAP [G]GC [BKSPC]BACK", 4, y);
+    canvas.drawString("[H]HEAP [G]GC [M]METRICS [BKSPC]BACK", 4, y);
+}
+
+void DiagnosticsMenu::drawMetrics(M5Canvas& canvas) {
+    int y = 2;
+    int lineH = 14;
+    char line[48];
+
+    if (!ReconMetrics::kEnabled) {
+        canvas.drawString("RECON METRICS", 4, y);
+        y += lineH * 2;
+        canvas.drawString("COMPILED OUT", 4, y);
+        y += lineH;
+        canvas.drawString("BUILD: PORKCHOP_METRICS_ENABLED=1", 4, y);
+        y += lineH * 2;
+        canvas.drawString("[M]BACK", 4, y);
+        return;
+    }
+
+    canvas.drawString("RECON US P50/P99/MAX", 4, y);
+    y += lineH;
+
+    static const char* const stageLabels[] = {"DRV", "DISP", "MODE", "LOCK"};
+    for (uint8_t i = 0; i < (uint8_t)ReconMetrics::Stage::Count; i++) {
+        ReconMetrics::StageSummary s;
+        ReconMetrics::getStage((ReconMetrics::Stage)i, s);
+        canvas.drawString(stageLabels[i], 4, y);
+        snprintf(line, sizeof(line), "%.1f/%.1f/%.0f", s.p50Us, s.p99Us, s.maxUs);
+        canvas.drawString(line, 44, y);
+        y += lineH;
+    }
+
+    ReconMetrics::FrameRates fps = ReconMetrics::getFrameRates();
+    snprintf(line, sizeof(line), "FPS M%lu C%lu D%lu F%lu",
+             (unsigned long)fps.mgmt, (unsigned long)fps.ctrl,
+             (unsigned long)fps.data, (unsigned long)fps.filtered);
+    canvas.drawString(line, 4, y);
+    y += lineH;
+
+    NetworkRecon::RxRingStats ring = NetworkRecon::getRxRingStats();
+    snprintf(line, sizeof(line), "RING HW %lu/%lu DROP %lu",
+             (unsigned long)ring.highWaterBytes, (unsigned long)ring.capacityBytes,
+             (unsigned long)ring.dropped);
+    canvas.drawString(line, 4, y);
+    y += lineH;
+
+    snprintf(line, sizeof(line), "PEND HW %lu DROP %lu SSID OVR %lu",
+             (unsigned long)ReconMetrics::getHighWater(ReconMetrics::Gauge::PendingNetDepth),
+             (unsigned long)ReconMetrics::getCounter(ReconMetrics::Counter::PendingNetDrop),
+             (unsigned long)ReconMetrics::getCounter(ReconMetrics::Counter::PendingSsidOverwrite));
+    canvas.drawString(line, 4, y);
+    y += lineH;
+
+    canvas.drawString("[M]BACK [X]RESET", 4, y);
 }
@@ -15,6 +15,7 @@ public:
 private:
     static bool active;
     static bool keyWasPressed;
+    static bool showMetrics;
     static uint16_t cachedWpaCracked;
     static uint16_t cachedWigleUploaded;
     static uint32_t lastStatRefreshMs;
@@ -24,4 +25,5 @@ private:
     static void logHeapSnapshot();
     static void collectGarbage();
     static void refreshStats();
+    static void drawMetrics(M5Canvas& canvas);
 };
@@ -2541,9 +2541,11 @@ void Display::drawModeInfo(M5Canvas& canvas, PorkchopMode mode) {
     canvas.setTextSize(1);
     
     if (mode == PorkchopMode::OINK_MODE) {
-        const auto& networks = OinkMode::getNetworks();
-        int selIdx = OinkMode::getSelectionIndex();
-        DetectedNetwork* target = OinkMode::getTarget();
+        // Published recon snapshot: drawing never takes the network lock
+        NetworkRecon::Snapshot networks;
+        const uint8_t* targetBssid = OinkMode::getTargetBSSID();
+        int targetIdx = targetBssid ? networks.find(targetBssid) : -1;
+        const NetworkRecon::NetworkView* target = targetIdx >= 0 ? &networks[targetIdx] : nullptr;
         
         // Show current target being attacked
         if (target) {
@@ -2564,7 +2566,8 @@ void Display::drawModeInfo(M5Canvas& canvas, PorkchopMode mode) {
             canvas.drawString(ssidBuf, 2, 14);
             
             char info[32];
-            snprintf(info, sizeof(info), "CH:%02d %ddB", target->channel, target->rssi);
+            snprintf(info, sizeof(info), "CH:%02d %ddB CL:%d", target->channel, target->rssi,
+                     target->clientEstimate);
             canvas.setTextColor(COLOR_FG);
             canvas.drawString(info, 2, 26);
         } else if (!networks.empty()) {
@@ -53,6 +53,7 @@ enum SettingId : uint8_t {
     SET_GPS_SOURCE,
     SET_GPS_PWRSAVE,
     SET_GPS_SCAN_INTV,
+    SET_GPS_PASSIVE,
     SET_GPS_BAUD,
     SET_GPS_RX,
     SET_GPS_TX,
@@ -140,6 +141,7 @@ static const EntryData kGpsEntries[] = {
     {SET_GPS_SOURCE, "GPS SRC", SettingType::VALUE, 0, (int)GPS_SOURCE_COUNT - 1, 1, "", "GROVE / LORACAP / CUSTOM"},
     {SET_GPS_PWRSAVE, "PWR SAVE", SettingType::TOGGLE, 0, 1, 1, "", "SLEEP WHEN NOT HUNTING"},
     {SET_GPS_SCAN_INTV, "SCAN INTV", SettingType::VALUE, 1, 30, 1, "S", "WARHOG SCAN FREQUENCY"},
+    {SET_GPS_PASSIVE, "PASSIVE", SettingType::TOGGLE, 0, 1, 1, "", "WARHOG SNIFFS BEACONS"},
     {SET_GPS_BAUD, "GPS BAUD", SettingType::VALUE, 0, 3, 1, "", "MATCH YOUR GPS MODULE"},
     {SET_GPS_RX, "GPS RX PIN", SettingType::VALUE, 1, 46, 1, "", "G1=GROVE, G15=LORACAP"},
     {SET_GPS_TX, "GPS TX PIN", SettingType::VALUE, 1, 46, 1, "", "G2=GROVE, G13=LORACAP"},
@@ -217,6 +219,7 @@ static bool isConfigSetting(SettingId id) {
         case SET_GPS_SOURCE:
         case SET_GPS_PWRSAVE:
         case SET_GPS_SCAN_INTV:
+        case SET_GPS_PASSIVE:
         case SET_GPS_BAUD:
         case SET_GPS_RX:
         case SET_GPS_TX:
@@ -529,6 +532,8 @@ static int getSettingValue(SettingId id) {
             return Config::gps().powerSave ? 1 : 0;
         case SET_GPS_SCAN_INTV:
             return Config::gps().updateInterval;
+        case SET_GPS_PASSIVE:
+            return Config::gps().passiveScan ? 1 : 0;
         case SET_GPS_BAUD:
             return getGpsBaudIndex();
         case SET_GPS_RX:
@@ -715,6 +720,12 @@ static bool setSettingValue(SettingId id, int value) {
             Config::gps().updateInterval = newVal;
             return true;
         }
+        case SET_GPS_PASSIVE: {
+            bool enabled = value != 0;
+            if (Config::gps().passiveScan == enabled) return false;
+            Config::gps().passiveScan = enabled;
+            return true;
+        }
         case SET_GPS_BAUD: {
             uint32_t newBaud = getGpsBaudForIndex(value);
             if (Config::gps().baudRate == newBaud) return false;
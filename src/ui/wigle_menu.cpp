@@ -11,6 +11,7 @@
 #include "../core/sd_layout.h"
 #include "../core/wifi_utils.h"
 #include "../core/heap_health.h"
+#include "../core/wardrive_format.h"
 
 // Static member initialization
 std::vector<WigleFileInfo> WigleMenu::files;
@@ -56,6 +57,8 @@ static void formatDisplayName(const char* filename, char* out, size_t len, size_
         const size_t suffixLen = 10;
         if (total >= suffixLen && strcmp(name + total - suffixLen, suffix) == 0) {
             end = total - suffixLen;
+        } else if (WardriveFormat::isLogName(name)) {
+            end = total - strlen(WardriveFormat::kExtension);
         }
     }
 
@@ -181,8 +184,10 @@ void WigleMenu::processAsyncScan() {
         if (!currentFile.isDirectory()) {
             const char* name = currentFile.name();
             size_t nameLen = strlen(name);
-            // Only show WiGLE format files (*.wigle.csv)
-            if (nameLen > 10 && strcmp(name + nameLen - 10, ".wigle.csv") == 0) {
+            // Only show WiGLE format files (*.wigle.csv) and WARHOG session
+            // logs (*.wdr, rendered to WiGLE CSV on upload)
+            bool isLog = WardriveFormat::isLogName(name);
+            if (isLog || (nameLen > 10 && strcmp(name + nameLen - 10, ".wigle.csv") == 0)) {
                 WigleFileInfo info;
                 memset(&info, 0, sizeof(info));
                 const char* slash = strrchr(name, '/');
@@ -190,8 +195,12 @@ void WigleMenu::processAsyncScan() {
                 strncpy(info.filename, base, sizeof(info.filename) - 1);
                 snprintf(info.fullPath, sizeof(info.fullPath), "%s/%s", SDLayout::wardrivingDir(), base);
                 info.fileSize = currentFile.size();
-                // Estimate network count: ~150 bytes per line after header
-                info.networkCount = info.fileSize > 300 ? (info.fileSize - 300) / 150 : 0;
+                // Logs hold fixed-size records; estimate CSV at ~150 bytes per line
+                if (isLog) {
+                    info.networkCount = WardriveFormat::recordCount(info.fileSize);
+                } else {
+                    info.networkCount = info.fileSize > 300 ? (info.fileSize - 300) / 150 : 0;
+                }
 
                 // Check upload status
                 info.status = WiGLE::isUploaded(info.fullPath) ?
@@ -559,7 +568,7 @@ void WigleMenu::nukeTrack() {
     
     Serial.printf("[WIGLE_MENU] Nuking track: %s\n", file.fullPath);
 
-    // Delete the .wigle.csv file
+    // Delete the .wigle.csv file (or .wdr session log)
     bool deleted = SD.remove(file.fullPath);
 
     // Also delete matching internal CSV if exists (same name without .wigle)
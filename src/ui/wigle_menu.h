@@ -17,7 +17,7 @@ struct WigleFileInfo {
     char filename[48];
     char fullPath[80];
     uint32_t fileSize;
-    uint32_t networkCount;  // Approximate based on file size
+    uint32_t networkCount;  // Exact for .wdr logs, estimated for CSV
     WigleFileStatus status;
 };
 
@@ -16,7 +16,12 @@
 #include "../core/xp.h"
 #include "../ui/swine_stats.h"
 #include "../core/sd_layout.h"
+#include "../core/capture_journal.h"
+#include "../core/hash_export.h"
 #include "../core/config.h"
+#include "../core/recon_metrics.h"
+#include "../core/wardrive_format.h"
+#include "../build_info.h"
 #include "wigle.h"
 
 #ifndef PORKCHOP_LOG_ENABLED
@@ -453,6 +458,15 @@ static bool wigleLooksValid(const char* path) {
     File f = SD.open(path, FILE_READ);
     if (!f) return false;
     const size_t size = f.size();
+    if (WardriveFormat::isLogName(path)) {
+        // WARHOG session log: valid header and at least one whole record
+        WardriveFormat::FileHeader hdr;
+        bool ok = f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+                  WardriveFormat::isFileHeader(hdr) &&
+                  WardriveFormat::recordCount(size) > 0;
+        f.close();
+        return ok;
+    }
     if (size < MIN_WIGLE_BYTES) {
         f.close();
         return false;
@@ -581,7 +595,8 @@ static void scanXpAwards() {
 
             size_t pathLen = strlen(path);
             if (pathLen < 10) continue;
-            if (strcasecmp(path + pathLen - 10, ".wigle.csv") != 0) continue;
+            if (strcasecmp(path + pathLen - 10, ".wigle.csv") != 0 &&
+                !WardriveFormat::isLogName(path)) continue;
 
             // Use filename-only as key (fits in 18-byte XpAwardEntry)
             const char* fname = basenameFromPath(path);
@@ -666,6 +681,7 @@ static size_t writeJsonEscaped(char* buf, size_t bufSize, const char* in) {
 
 // FIX: Static buffer version to avoid heap allocation per call
 static char swineSummaryBuf[512];
+static char metricsJsonBuf[1024];  // ReconMetrics::formatJson output
 
 static const char* buildSwineSummaryJson() {
     const uint8_t level = XP::getLevel();
@@ -1495,6 +1511,9 @@ const DEFAULT_LEFT = '/m5porkchop/handshakes';
 const DEFAULT_RIGHT = '/m5porkchop/wardriving';
 const HANDSHAKES_DIR = '/m5porkchop/handshakes';
 const WIGLE_DIR = '/m5porkchop/wardriving';
+// WARHOG .wdr logs (WardriveFormat): 16-byte header, 64-byte records
+const WDR_HEADER_BYTES = 16;
+const WDR_RECORD_BYTES = 64;
 const panes = {
     L: { path: '/', items: [], selected: new Set(), focusIdx: 0, loading: false },
     R: { path: '/', items: [], selected: new Set(), focusIdx: 0, loading: false }
@@ -1597,7 +1616,7 @@ function setWpaAuthState(state) {
 
 function setOpsBusy(busy) {
     opsBusy = busy;
-    const ids = ['btnWpaSync', 'btnWpaOpen', 'btnWigleSync'];
+    const ids = ['btnWpaSync', 'btnWpaOpen', 'btnWigleSync', 'btnHashExport', 'btnHashSend'];
     ids.forEach(id => {
         const el = document.getElementById(id);
         if (el) el.disabled = busy;
@@ -2004,6 +2023,18 @@ async function listDir(path) {
     }
 }
 
+// Captures still inside OINK session journals (read in place on download)
+async function listJournal() {
+    try {
+        const r = await queuedFetch('/api/journal');
+        if (!r.ok) return [];
+        const items = await r.json();
+        return Array.isArray(items) ? items : [];
+    } catch (e) {
+        return [];
+    }
+}
+
 function stripExtension(name) {
     const dot = name.lastIndexOf('.');
     return dot > 0 ? name.substring(0, dot) : name;
@@ -2078,8 +2109,9 @@ function decodeHexSSID(hex) {
 }
 
 async function buildWpaQueue() {
-    const [items, uploadedText, resultsText] = await Promise.all([
+    const [items, records, uploadedText, resultsText] = await Promise.all([
         listDir(HANDSHAKES_DIR),
+        listJournal(),
         fetchDeviceText('/m5porkchop/wpa-sec/wpasec_uploaded.txt'),
         fetchDeviceText('/m5porkchop/wpa-sec/wpasec_results.txt')
     ]);
@@ -2107,6 +2139,23 @@ async function buildWpaQueue() {
             status
         });
     }
+    for (const rec of records) {
+        if (!rec || rec.type !== 'pcap') continue;
+        const bssidKey = normalizeBssid(rec.bssid || '');
+        const result = resultsMap.get(bssidKey);
+        let status = 'LOCAL';
+        if (bssidKey && result) status = 'CRACKED';
+        else if (bssidKey && uploadedSet.has(bssidKey)) status = 'UPLOADED';
+        queue.push({
+            path: rec.f + '#' + rec.rec,
+            src: '/download?f=' + encodeURIComponent(rec.f) + '&rec=' + rec.rec,
+            name: rec.name,
+            bssidKey,
+            ssid: rec.ssid || (result ? result.ssid : '') || 'NONAME BRO',
+            pass: result ? result.pass : '',
+            status
+        });
+    }
     queue.sort((a, b) => a.name.localeCompare(b.name));
     return queue;
 }
@@ -2120,11 +2169,19 @@ async function buildWigleQueue() {
     const queue = [];
     for (const item of items) {
         if (!item || item.isDir) continue;
-        if (!item.name || !item.name.toLowerCase().endsWith('.wigle.csv')) continue;
+        const lower = (item.name || '').toLowerCase();
+        const isLog = lower.endsWith('.wdr');
+        if (!lower.endsWith('.wigle.csv') && !isLog) continue;
         const path = WIGLE_DIR + '/' + item.name;
         const status = (uploadedSet.has(path) || uploadedSet.has(item.name)) ? 'UPLOADED' : 'LOCAL';
-        const nets = await countWigleNetworks(path);
-        queue.push({ path, name: item.name, nets, status });
+        // WARHOG session logs are fetched rendered as WiGLE CSV
+        const src = isLog ? '/download?f=' + encodeURIComponent(path) + '&as=wigle' : null;
+        const upName = isLog ? item.name.slice(0, -4) + '.wigle.csv' : item.name;
+        // A .wdr holds one fixed-size record per network: count from its size
+        const nets = isLog
+            ? Math.max(0, Math.floor(((item.size || 0) - WDR_HEADER_BYTES) / WDR_RECORD_BYTES))
+            : await countWigleNetworks(path);
+        queue.push({ path, name: item.name, upName, src, nets, status });
     }
     queue.sort((a, b) => a.name.localeCompare(b.name));
     return queue;
@@ -2874,8 +2931,8 @@ function normalizeBssid(raw) {
     return raw.replace(/[^a-fA-F0-9]/g, '').toUpperCase();
 }
 
-async function fetchDeviceBlob(path) {
-    const resp = await queuedFetch('/download?f=' + encodeURIComponent(path));
+async function fetchDeviceBlob(path, src) {
+    const resp = await queuedFetch(src || ('/download?f=' + encodeURIComponent(path)));
     if (!resp.ok) throw new Error('device read failed (' + resp.status + ')');
     return await resp.blob();
 }
@@ -2923,28 +2980,30 @@ function describeError(e) {
     return msg;
 }
 
-async function updateWpasecUploadedList(newBssid) {
+// Takes one BSSID or an array; one device read and write either way
+async function updateWpasecUploadedList(newBssids) {
     const path = '/m5porkchop/wpa-sec/wpasec_uploaded.txt';
-    const bssid = normalizeBssid(newBssid || '');
-    if (!bssid || bssid.length < 12) return;
+    const bssids = [].concat(newBssids || []).map(b => normalizeBssid(b)).filter(b => b.length >= 12);
+    if (!bssids.length) return;
     const existing = await fetchDeviceText(path);
     const existingSet = parseUploadedBssids(existing);
-    const already = existingSet.has(bssid);
-    if (already) return false;
-    const merged = mergeLines(existing, [bssid]);
+    const added = bssids.filter(b => !existingSet.has(b));
+    if (!added.length) return false;
+    const merged = mergeLines(existing, added);
     await uploadTextToDevice(path, merged, 'text/plain');
     return true;
 }
 
-async function updateWpasecSentList(newBssid) {
+// Takes one BSSID or an array; one device read and write either way
+async function updateWpasecSentList(newBssids) {
     const path = '/m5porkchop/wpa-sec/wpasec_sent.txt';
-    const bssid = normalizeBssid(newBssid || '');
-    if (!bssid || bssid.length < 12) return;
+    const bssids = [].concat(newBssids || []).map(b => normalizeBssid(b)).filter(b => b.length >= 12);
+    if (!bssids.length) return;
     const existing = await fetchDeviceText(path);
     const existingSet = parseUploadedBssids(existing);
-    const already = existingSet.has(bssid);
-    if (already) return false;
-    const merged = mergeLines(existing, [bssid]);
+    const added = bssids.filter(b => !existingSet.has(b));
+    if (!added.length) return false;
+    const merged = mergeLines(existing, added);
     await uploadTextToDevice(path, merged, 'text/plain');
     return true;
 }
@@ -3022,6 +3081,82 @@ function wpaOpenResults() {
     addWpaLog('RESULTS TAB OPENED');
 }
 
+async function hashExportStatus(url) {
+    const resp = await queuedFetch(url);
+    if (!resp.ok) throw new Error('device busy (' + resp.status + ')');
+    return await resp.json();
+}
+
+// Device merges every .22000 into one deduplicated file in the background;
+// poll until it is written. Returns the job report, null on failure.
+async function runHashExport() {
+    addWpaLog('MERGE: 22000 FILES');
+    try {
+        let data = await hashExportStatus('/api/hashexport?start=1');
+        let shown = -1;
+        while (data.state === 'running') {
+            const quarter = Math.floor((data.progress || 0) / 25);
+            if (quarter !== shown) {
+                shown = quarter;
+                addWpaLog('MERGE: ' + data.progress + '% OF ' + data.files + ' FILES');
+            }
+            await new Promise(resolve => setTimeout(resolve, 500));
+            data = await hashExportStatus('/api/hashexport');
+        }
+        if (data.state !== 'done') {
+            addWpaLog('MERGE FAIL: ' + (data.error || data.state));
+            return null;
+        }
+        addWpaLog('MERGED: ' + data.written + ' LINES, ' + data.duplicates + ' DUPES, ' + data.files + ' FILES');
+        return data;
+    } catch (e) {
+        addWpaLog('MERGE FAIL: ' + describeError(e));
+        return null;
+    }
+}
+
+async function exportHashes() {
+    if (opsBusy) return;
+    setOpsBusy(true);
+    const data = await runHashExport();
+    setOpsBusy(false);
+    if (data) window.location.href = '/download?f=' + encodeURIComponent(data.path);
+}
+
+// AP MACs in a 22000 file: WPA*TYPE*MIC*MACAP*...
+function hashLineBssids(text) {
+    const out = new Set();
+    text.split(/\r?\n/).forEach(line => {
+        const parts = line.split('*');
+        if (parts.length > 3 && parts[0] === 'WPA') {
+            const bssid = normalizeBssid(parts[3]);
+            if (bssid.length >= 12) out.add(bssid);
+        }
+    });
+    return Array.from(out);
+}
+
+async function wpaSendAllHashes() {
+    // One upload of the merged file instead of one per capture
+    if (opsBusy) return;
+    if (!creds.wpaKey) {
+        addWpaLog('KEY MISSING - CLICK STATUS TO CONFIGURE');
+        return;
+    }
+    if (!(await ensureWpaAuthGate(1))) {
+        addWpaLog('SEND CANCELLED');
+        return;
+    }
+    setOpsBusy(true);
+    const data = await runHashExport();
+    if (data) {
+        const name = data.path.substring(data.path.lastIndexOf('/') + 1);
+        await wpaUploadItem({ path: data.path, name, hashFile: true });
+    }
+    setOpsBusy(false);
+    await loadQueues();
+}
+
 async function applyWpasecResultsFile(file) {
     if (!file) return { count: 0 };
     addWpaLog('APPLY: ' + file.name);
@@ -3072,13 +3207,19 @@ async function applyWpasecResultsAuto(allowPrompt) {
 async function wpaUploadItem(item) {
     addWpaLog('SEND: ' + item.name);
     try {
-        const blob = await fetchDeviceBlob(item.path);
+        const blob = await fetchDeviceBlob(item.path, item.src);
         const file = new File([blob], item.name, { type: 'application/octet-stream' });
         const url = 'https://wpa-sec.stanev.org/?submit&key=' + encodeURIComponent(creds.wpaKey);
         const form = new FormData();
         form.append('webfile', file);
         await fetch(url, { method: 'POST', body: form, mode: 'no-cors', credentials: 'include' });
-        if (item.bssidKey && item.bssidKey.length >= 12) {
+        if (item.hashFile) {
+            // Merged export: every AP in it counts as sent
+            const keys = hashLineBssids(await blob.text());
+            await updateWpasecUploadedList(keys);
+            await updateWpasecSentList(keys);
+            addWpaLog('MARKED: ' + keys.length + ' BSSIDS');
+        } else if (item.bssidKey && item.bssidKey.length >= 12) {
             await updateWpasecUploadedList(item.bssidKey);
             await updateWpasecSentList(item.bssidKey);
         } else {
@@ -3123,8 +3264,8 @@ async function wigleSync() {
 async function wigleUploadItem(item) {
     addWigleLog('UPLOAD: ' + item.name);
     try {
-        const blob = await fetchDeviceBlob(item.path);
-        const file = new File([blob], item.name, { type: 'text/csv' });
+        const blob = await fetchDeviceBlob(item.path, item.src);
+        const file = new File([blob], item.upName || item.name, { type: 'text/csv' });
         const auth = btoa(creds.wigleUser + ':' + creds.wigleToken);
         const form = new FormData();
         form.append('file', file);
@@ -3262,6 +3403,8 @@ static const char HTML_TEMPLATE[] PROGMEM = R"rawliteral(
                         <span class="ops-title">WPA-SEC QUEUE</span>
                         <span class="ops-meta ops-meta-link" id="wpaMeta" onclick="showCredsModal()">KEY: UNKNOWN</span>
                         <span class="ops-actions">
+                            <button class="btn btn-outline" id="btnHashExport" onclick="exportHashes()">ALL 22000</button>
+                            <button class="btn btn-outline" id="btnHashSend" onclick="wpaSendAllHashes()">SEND 22000</button>
                             <button class="btn btn-outline" id="btnWpaOpen" onclick="wpaOpenResults()">POT FILE</button>
                         </span>
                     </span>
@@ -3546,7 +3689,10 @@ void FileServer::startServer() {
     server->on("/ui.js", HTTP_GET, handleScript);
     server->on("/api/swine", HTTP_GET, handleSwine);
     server->on("/api/ls", HTTP_GET, handleFileList);
+    server->on("/api/journal", HTTP_GET, handleJournalList);
     server->on("/api/sdinfo", HTTP_GET, handleSDInfo);
+    server->on("/api/metrics", HTTP_GET, handleMetrics);
+    server->on("/api/hashexport", HTTP_GET, handleHashExport);
     server->on("/api/bulkdelete", HTTP_POST, handleBulkDelete);
     server->on("/api/rename", HTTP_GET, handleRename);
     server->on("/api/copy", HTTP_POST, handleCopy);
@@ -3585,6 +3731,7 @@ void FileServer::stop() {
     }
     // Close any pending upload file
     resetUploadState(false);
+    HashExport::cancel();
 
     scanXpAwards();
     
@@ -3681,6 +3828,10 @@ void FileServer::updateRunning() {
     if (server) {
         server->handleClient();
     }
+    // One 22000 file per loop, between requests
+    if (HashExport::state() == HashExport::State::Running) {
+        HashExport::step();
+    }
 
     if (uploadActive.load() && (millis() - uploadLastProgress.load() > 10000)) {
         resetUploadState(true);
@@ -3850,6 +4001,66 @@ void FileServer::handleSDInfo() {
     logHeapStatusIfLow("after /api/sdinfo");
 }
 
+void FileServer::handleMetrics() {
+    logRequest(server, "REQ");
+    if (isTransferBusy()) {
+        sendBusyResponse(server);
+        return;
+    }
+    size_t len = ReconMetrics::formatJson(metricsJsonBuf, sizeof(metricsJsonBuf));
+    server->sendHeader("Connection", "close");
+    server->sendHeader("Cache-Control", "no-store");
+    server->send(200, "application/json", metricsJsonBuf);
+    sessionTxBytes += len;
+}
+
+// ?start=1 begins a merge that updateRunning() steps; without it this
+// only reports the job, so the page polls until it is done
+void FileServer::handleHashExport() {
+    logRequest(server, "REQ");
+    if (isTransferBusy()) {
+        sendBusyResponse(server);
+        return;
+    }
+
+    if (server->hasArg("start") && HashExport::state() != HashExport::State::Running) {
+        logHeapStatusIfLow("before hash export");
+        HashExport::start();
+    }
+
+    const HashExport::Stats& stats = HashExport::stats();
+    char json[256];
+    switch (HashExport::state()) {
+        case HashExport::State::Running:
+            snprintf(json, sizeof(json),
+                     "{\"state\":\"running\",\"progress\":%u,\"files\":%u,\"passes\":%u}",
+                     (unsigned)HashExport::progress(), (unsigned)stats.files,
+                     (unsigned)stats.passes);
+            break;
+        case HashExport::State::Done:
+            snprintf(json, sizeof(json),
+                     "{\"state\":\"done\",\"path\":\"%s\",\"files\":%u,\"lines\":%lu,"
+                     "\"written\":%lu,\"duplicates\":%lu,\"skipped\":%lu,\"passes\":%u,"
+                     "\"bytes\":%lu}",
+                     SDLayout::hashExportPath(), (unsigned)stats.files,
+                     (unsigned long)stats.lines, (unsigned long)stats.written,
+                     (unsigned long)stats.duplicates, (unsigned long)stats.skipped,
+                     (unsigned)stats.passes, (unsigned long)stats.bytes);
+            break;
+        case HashExport::State::Failed:
+            snprintf(json, sizeof(json), "{\"state\":\"failed\",\"error\":\"%s\"}",
+                     HashExport::error());
+            break;
+        default:
+            snprintf(json, sizeof(json), "{\"state\":\"idle\"}");
+            break;
+    }
+    server->sendHeader("Connection", "close");
+    server->sendHeader("Cache-Control", "no-store");
+    server->send(200, "application/json", json);
+    sessionTxBytes += strlen(json);
+}
+
 void FileServer::handleCreds() {
     logRequest(server, "REQ");
     if (isTransferBusy()) {
@@ -4056,6 +4267,79 @@ void FileServer::handleFileList() {
     listActive.store(false);
 }
 
+// Captures held in closed OINK session journals, listed from the record
+// headers. Each entry downloads as /download?f=<f>&rec=<rec>.
+void FileServer::handleJournalList() {
+    logRequest(server, "REQ");
+    if (listActive.load() || isTransferBusy()) {
+        sendBusyResponse(server);
+        return;
+    }
+    listActive.store(true);
+    listStartTime.store(millis());
+
+    WiFiClient client = server->client();
+    client.setNoDelay(true);
+    server->sendHeader("Connection", "close");
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, "application/json", "[");
+
+    struct ListState {
+        String buffer;
+        WiFiClient* client;
+        uint16_t sent;
+    } ls;
+    ls.buffer.reserve(1024);
+    ls.client = &client;
+    ls.sent = 0;
+
+    CaptureJournal::forEachRecord([](const CaptureJournal::RecordRef& rec, void* ctx) {
+        ListState& st = *(ListState*)ctx;
+        if (!st.client->connected() || st.sent >= 1000) return false;
+
+        char name[64];
+        char ssid[JournalFormat::kMaxSsidLen + 1];
+        char path[64];
+        char fields[128];
+        CaptureJournal::fileName(rec.hdr, name, sizeof(name));
+        JournalFormat::copySsid(rec.hdr, ssid);
+        CaptureJournal::journalPath(rec.session, path, sizeof(path));
+        const uint8_t* b = rec.hdr.bssid;
+        static const char* const TYPES[] = {"", "pcap", "hs22000", "pmkid"};
+
+        if (st.sent > 0) st.buffer += ",";
+        st.buffer += "{\"name\":\"";
+        appendJsonEscaped(st.buffer, name);
+        st.buffer += "\",\"ssid\":\"";
+        appendJsonEscaped(st.buffer, ssid);
+        snprintf(fields, sizeof(fields),
+                 "\",\"bssid\":\"%02X%02X%02X%02X%02X%02X\",\"type\":\"%s\",\"size\":%u,\"mtime\":%lu,\"f\":\"",
+                 b[0], b[1], b[2], b[3], b[4], b[5], TYPES[rec.hdr.type],
+                 (unsigned)rec.hdr.payloadLen, (unsigned long)rec.written);
+        st.buffer += fields;
+        appendJsonEscaped(st.buffer, path);
+        snprintf(fields, sizeof(fields), "\",\"rec\":%u}", (unsigned)rec.offset);
+        st.buffer += fields;
+        st.sent++;
+
+        if (st.buffer.length() >= 1024) {
+            server->sendContent(st.buffer);
+            sessionTxBytes += st.buffer.length();
+            st.buffer.remove(0);
+        }
+        return true;
+    }, &ls);
+
+    ls.buffer += "]";
+    server->sendContent(ls.buffer);
+    sessionTxBytes += ls.buffer.length();
+    server->sendContent("");  // Finalize chunked transfer
+    client.flush();
+    client.stop();
+    logHeapStatusIfLow("after /api/journal");
+    listActive.store(false);
+}
+
 void FileServer::handleDownload() {
     String path = mapUiPathToFs(server->arg("f"));
     String dir = mapUiPathToFs(server->arg("dir"));  // For ZIP download
@@ -4090,11 +4374,29 @@ void FileServer::handleDownload() {
         return;
     }
     
-    File file = SD.open(path);
-    if (!file || file.isDirectory()) {
-        server->sendHeader("Connection", "close");
-        server->send(404, "text/plain", "File not found");
-        return;
+    // rec=<offset>: one capture read in place from an OINK session journal,
+    // served under the name it would have as a loose file
+    String rec = server->arg("rec");
+    const bool record = !rec.isEmpty();
+    JournalFormat::RecordHeader recordHdr;
+    char recordName[64];
+    File file;
+    if (record) {
+        if (!CaptureJournal::openRecord(path.c_str(), (uint32_t)strtoul(rec.c_str(), nullptr, 10),
+                                        recordHdr, file)) {
+            server->sendHeader("Connection", "close");
+            server->send(404, "text/plain", "Capture not found");
+            return;
+        }
+        CaptureJournal::fileName(recordHdr, recordName, sizeof(recordName));
+    } else {
+        file = SD.open(path);
+        if (!file || file.isDirectory()) {
+            if (file) file.close();
+            server->sendHeader("Connection", "close");
+            server->send(404, "text/plain", "File not found");
+            return;
+        }
     }
     
     // FIX: Use const char* / char[] instead of String to avoid heap allocs
@@ -4105,6 +4407,7 @@ void FileServer::handleDownload() {
     if (lastSlash) {
         filename = lastSlash + 1;
     }
+    if (record) filename = recordName;
     
     // Determine content type (use const char* - no allocation)
     const char* contentType = "application/octet-stream";
@@ -4112,8 +4415,45 @@ void FileServer::handleDownload() {
     else if (path.endsWith(".csv")) contentType = "text/csv";
     else if (path.endsWith(".json")) contentType = "application/json";
     else if (path.endsWith(".pcap")) contentType = "application/vnd.tcpdump.pcap";
+    else if (record && recordHdr.type == (uint8_t)JournalFormat::RecordType::HandshakePcap) {
+        contentType = "application/vnd.tcpdump.pcap";
+    }
+
+    // WARHOG session logs render to text on request: as=wigle or as=csv.
+    // A first pass over the file gives the rendered Content-Length.
+    static WardriveFormat::Renderer renderer;  // Line buffer kept off the stack
+    static uint8_t buffer[1024];
+    auto readFile = [&file](uint8_t* dst, size_t n) { return file.read(dst, n); };
+    String renderAs = server->arg("as");
+    const bool render = WardriveFormat::isLogName(pathCStr) &&
+                        (renderAs == "wigle" || renderAs == "csv");
+    const WardriveFormat::Output renderFormat =
+        renderAs == "csv" ? WardriveFormat::Output::Csv : WardriveFormat::Output::Wigle;
+    char renderedName[64];
     
-    const size_t totalSize = file.size();
+    size_t totalSize = record ? recordHdr.payloadLen : file.size();
+    if (render) {
+        renderer.begin(renderFormat, BUILD_VERSION);
+        totalSize = 0;
+        size_t n;
+        while ((n = renderer.read(readFile, (char*)buffer, sizeof(buffer))) > 0) {
+            totalSize += n;
+            yield();
+        }
+        if (renderer.failed()) {
+            file.close();
+            server->sendHeader("Connection", "close");
+            server->send(422, "text/plain", "Not a WARHOG log");
+            return;
+        }
+        file.seek(0);
+        renderer.begin(renderFormat, BUILD_VERSION);
+        WardriveFormat::renderedName(pathCStr,
+                                     renderFormat == WardriveFormat::Output::Csv ? ".csv" : ".wigle.csv",
+                                     renderedName, sizeof(renderedName));
+        filename = renderedName;
+        contentType = "text/csv";
+    }
     
     // FIX: Build Content-Disposition header in stack buffer to avoid String concat
     char dispositionBuf[160];
@@ -4127,7 +4467,6 @@ void FileServer::handleDownload() {
     WiFiClient client = server->client();
     client.setNoDelay(true);
 
-    static uint8_t buffer[1024];
     size_t sentTotal = 0;
     uint32_t lastProgress = millis();
     bool stalled = false;
@@ -4146,7 +4485,8 @@ void FileServer::handleDownload() {
             toRead = sizeof(buffer);
         }
 
-        size_t readBytes = file.read(buffer, toRead);
+        size_t readBytes = render ? renderer.read(readFile, (char*)buffer, toRead)
+                                  : file.read(buffer, toRead);
         if (readBytes == 0) {
             break;
         }
@@ -58,6 +58,7 @@ private:
     static void handleScript();
     static void handleSwine();
     static void handleFileList();
+    static void handleJournalList();
     static void handleDownload();
     static void handleUpload();
     static void handleUploadProcess();
@@ -65,6 +66,8 @@ private:
     static void handleBulkDelete();
     static void handleMkdir();
     static void handleSDInfo();
+    static void handleMetrics();
+    static void handleHashExport();
     static void handleRename();
     static void handleCopy();
     static void handleMove();
@@ -14,6 +14,9 @@
 #include "../core/wifi_utils.h"
 #include "../core/network_recon.h"
 #include "../core/sdlog.h"
+#include "../core/gzip_stream.h"
+#include "../core/wardrive_format.h"
+#include "../build_info.h"
 #include "../piglet/mood.h"
 
 // Static member initialization
@@ -24,6 +27,8 @@ char WiGLE::lastError[64] = "";
 bool WiGLE::batchMode = false;
 
 static const size_t WIGLE_MAX_UPLOADED = 200;
+static const size_t GZIP_READ_CHUNK = 1024;         // Shares the compressor's heap block
+static const char* GZIP_STAGE_NAME = "upload.gz.tmp";
 
 // RAII helper for busy flag
 struct BusyScope {
@@ -32,6 +37,13 @@ struct BusyScope {
     ~BusyScope() { flag = false; }
 };
 
+// RAII helper: staged upload file is removed on every exit path
+struct StagedFileScope {
+    const char* path;
+    StagedFileScope(const char* p) : path(p) {}
+    ~StagedFileScope() { if (SD.exists(path)) SD.remove(path); }
+};
+
 bool WiGLE::isBusy() {
     return busy;
 }
@@ -251,29 +263,118 @@ bool WiGLE::canSync() {
     return HeapGates::canTls(tls, lastError, sizeof(lastError));
 }
 
+// Gzip an upload to SD before any TLS setup, so the compressor's window
+// and the TLS buffers never hold heap at the same time and the compressed
+// size is known for Content-Length. WARHOG .wdr logs are rendered to WiGLE
+// CSV on the way in.
+bool WiGLE::stageGzip(File& src, bool render, const char* gzPath, size_t& gzSize) {
+    // One block: compressor state + read chunk
+    size_t stateBytes = HeapPolicy::kGzipStateBytes;
+    uint8_t* block = nullptr;
+    while (stateBytes >= HeapPolicy::kGzipStateMinBytes) {
+        size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+        if (largest >= stateBytes + GZIP_READ_CHUNK + HeapPolicy::kReserveSlackLarge) {
+            block = (uint8_t*)heap_caps_malloc(stateBytes + GZIP_READ_CHUNK, MALLOC_CAP_8BIT);
+            if (block) break;
+        }
+        stateBytes /= 2;
+    }
+    if (!block) {
+        strncpy(lastError, "NO HEAP FOR GZIP", sizeof(lastError) - 1);
+        SDLog::log("WIGLE", "Gzip alloc failed (largest=%u)",
+                   (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+        return false;
+    }
+
+    File gzFile = SD.open(gzPath, FILE_WRITE);
+    if (!gzFile) {
+        heap_caps_free(block);
+        strncpy(lastError, "SD WRITE FAILED", sizeof(lastError) - 1);
+        return false;
+    }
+
+    static GzipStream gz;                       // Output buffer kept off the stack
+    static WardriveFormat::Renderer renderer;   // Line buffer kept off the stack
+    gz.attach(block, stateBytes);
+    gz.begin();
+    char* chunk = (char*)block + stateBytes;
+    auto readFile = [&src](uint8_t* dst, size_t n) { return src.read(dst, n); };
+    auto writeGz = [&gzFile](const uint8_t* p, size_t n) { return gzFile.write(p, n) == n; };
+
+    if (render) renderer.begin(WardriveFormat::Output::Wigle, BUILD_VERSION);
+    bool ok = true;
+    size_t n;
+    while (ok && (n = render ? renderer.read(readFile, chunk, GZIP_READ_CHUNK)
+                             : src.read((uint8_t*)chunk, GZIP_READ_CHUNK)) > 0) {
+        ok = gz.write((const uint8_t*)chunk, n, writeGz);
+        yield();
+    }
+    const bool badLog = render && (renderer.failed() || renderer.getRecords() == 0);
+    if (ok && !badLog) ok = gz.finish(writeGz);
+    gzFile.close();
+    heap_caps_free(block);
+
+    if (badLog || gz.bytesIn() == 0) {
+        strncpy(lastError, render ? "EMPTY OR BAD LOG" : "EMPTY FILE", sizeof(lastError) - 1);
+        return false;
+    }
+    if (!ok) {
+        strncpy(lastError, "SD WRITE FAILED", sizeof(lastError) - 1);
+        return false;
+    }
+    gzSize = gz.bytesOut();
+    Serial.printf("[WIGLE] Gzipped %u -> %u bytes (%u window)\n",
+                  (unsigned int)gz.bytesIn(), (unsigned int)gzSize,
+                  (unsigned int)gz.getWindow());
+    return true;
+}
+
 bool WiGLE::uploadSingleFile(const char* csvPath) {
     if (!csvPath) return false;
     
     Serial.printf("[WIGLE] Uploading: %s\n", csvPath);
     
-    // Check file exists and get size
     File csvFile = SD.open(csvPath, FILE_READ);
     if (!csvFile) {
         Serial.printf("[WIGLE] Cannot open file: %s\n", csvPath);
         return false;
     }
-    
-    size_t fileSize = csvFile.size();
-    if (fileSize == 0 || fileSize > 500000) {  // Max 500KB for ESP32 memory safety
-        csvFile.close();
-        Serial.printf("[WIGLE] Invalid file size: %u\n", (unsigned int)fileSize);
-        strncpy(lastError, "FILE TOO LARGE", sizeof(lastError) - 1);
+
+    // Uploads go up as .gz: WiGLE CSV compresses ~3x, so sessions well past
+    // the old 500KB ceiling fit in the same transfer time
+    char gzPath[80];
+    const char* stageDir = SDLayout::wigleDir();
+    snprintf(gzPath, sizeof(gzPath), "%s%s%s", stageDir,
+             stageDir[strlen(stageDir) - 1] == '/' ? "" : "/", GZIP_STAGE_NAME);
+    StagedFileScope staged(gzPath);
+
+    const bool render = WardriveFormat::isLogName(csvPath);
+    size_t fileSize = 0;
+    bool stagedOk = stageGzip(csvFile, render, gzPath, fileSize);
+    csvFile.close();
+    if (!stagedOk) {
+        Serial.printf("[WIGLE] Gzip staging failed for %s: %s\n", csvPath, lastError);
         return false;
     }
-    
+
+    File gzFile = SD.open(gzPath, FILE_READ);
+    if (!gzFile) {
+        strncpy(lastError, "SD READ FAILED", sizeof(lastError) - 1);
+        return false;
+    }
+
+    // Stream file in chunks (heap-safe, 2KB for fewer TLS operations)
+    const size_t CHUNK_SIZE = 2048;
+    uint8_t chunk[CHUNK_SIZE];
+
     // Extract filename from path (use strrchr instead of String)
-    const char* filename = strrchr(csvPath, '/');
-    filename = filename ? filename + 1 : csvPath;
+    char filename[72];
+    if (render) {
+        WardriveFormat::renderedName(csvPath, ".wigle.csv.gz", filename, sizeof(filename));
+    } else {
+        const char* base = strrchr(csvPath, '/');
+        snprintf(filename, sizeof(filename), "%s.gz", base ? base + 1 : csvPath);
+    }
 
     // Build Basic Auth header on stack — no heap allocation during TLS window
     char credBuf[132];  // wigleApiName(64) + ":" + wigleApiToken(64) + NUL
@@ -295,7 +396,7 @@ bool WiGLE::uploadSingleFile(const char* csvPath) {
     // Connect with timeout (15s)
     Serial.printf("[WIGLE] Connecting to %s:%d\n", API_HOST, API_PORT);
     if (!client.connect(API_HOST, API_PORT, 15000)) {
-        csvFile.close();
+        gzFile.close();
         // Capture mbedTLS error for diagnostics
         char tlsErr[64] = {0};
         int errCode = client.lastError(tlsErr, sizeof(tlsErr) - 1);
@@ -312,13 +413,13 @@ bool WiGLE::uploadSingleFile(const char* csvPath) {
     snprintf(boundary, sizeof(boundary), "----PorkchopWiGLE%08lX", millis());
     
     // FIX: Use stack buffers for multipart body to avoid String concatenation fragmentation
-    // bodyStart: "--boundary\r\nContent-Disposition: ...; filename="name"\r\nContent-Type: text/csv\r\n\r\n"
+    // bodyStart: "--boundary\r\nContent-Disposition: ...; filename="name"\r\nContent-Type: application/gzip\r\n\r\n"
     // Max ~200 bytes with reasonable filename
     char bodyStart[220];
     int bodyStartLen = snprintf(bodyStart, sizeof(bodyStart),
         "--%s\r\n"
         "Content-Disposition: form-data; name=\"file\"; filename=\"%s\"\r\n"
-        "Content-Type: text/csv\r\n\r\n",
+        "Content-Type: application/gzip\r\n\r\n",
         boundary, filename);
     
     // bodyEnd: "\r\n--boundary--\r\n" (~60 bytes max)
@@ -340,9 +441,6 @@ bool WiGLE::uploadSingleFile(const char* csvPath) {
     // Send multipart body start
     client.print(bodyStart);
     
-    // Stream file in chunks (heap-safe, 2KB for fewer TLS operations)
-    const size_t CHUNK_SIZE = 2048;
-    uint8_t chunk[CHUNK_SIZE];
     size_t bytesRemaining = fileSize;
     size_t bytesSent = 0;
     
@@ -355,18 +453,18 @@ bool WiGLE::uploadSingleFile(const char* csvPath) {
                      (unsigned int)bytesSent, errCode);
             Serial.printf("[WIGLE] Connection lost during upload: sent=%u/%u, err=%d (%s)\n",
                           (unsigned int)bytesSent, (unsigned int)fileSize, errCode, tlsErr);
-            csvFile.close();
+            gzFile.close();
             client.stop();
             return false;
         }
         
         size_t toRead = (bytesRemaining > CHUNK_SIZE) ? CHUNK_SIZE : bytesRemaining;
-        size_t bytesRead = csvFile.read(chunk, toRead);
+        size_t bytesRead = gzFile.read(chunk, toRead);
         if (bytesRead == 0) {
             snprintf(lastError, sizeof(lastError), "SD READ @%uB", (unsigned int)bytesSent);
             Serial.printf("[WIGLE] SD read failed at offset %u/%u\n", 
                           (unsigned int)bytesSent, (unsigned int)fileSize);
-            csvFile.close();
+            gzFile.close();
             client.stop();
             return false;
         }
@@ -381,7 +479,7 @@ bool WiGLE::uploadSingleFile(const char* csvPath) {
                           (unsigned int)written, (unsigned int)bytesRead,
                           (unsigned int)bytesSent, (unsigned int)fileSize,
                           errCode, tlsErr, client.connected());
-            csvFile.close();
+            gzFile.close();
             client.stop();
             return false;
         }
@@ -390,7 +488,7 @@ bool WiGLE::uploadSingleFile(const char* csvPath) {
         bytesRemaining -= bytesRead;
         yield();  // Let WiFi stack breathe
     }
-    csvFile.close();
+    gzFile.close();
     
     // Send multipart body end
     client.print(bodyEnd);
@@ -705,8 +803,9 @@ WigleSyncResult WiGLE::syncFiles(WigleProgressCallback cb) {
             const char* fname = file.name();
             size_t fnameLen = strlen(fname);
             
-            // Check for WiGLE CSV files
-            bool isWigleCSV = (fnameLen > 10 && strstr(fname, ".wigle.csv") != nullptr);
+            // Check for WiGLE CSV files and WARHOG session logs (rendered on upload)
+            bool isWigleCSV = (fnameLen > 10 && strstr(fname, ".wigle.csv") != nullptr) ||
+                              WardriveFormat::isLogName(fname);
             
             if (isWigleCSV) {
                 // Check if already uploaded
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include <FS.h>
 #include <vector>
 #include "../core/heap_policy.h"
 
@@ -109,6 +110,7 @@ private:
     static bool loadUploadedList();
     static bool saveUploadedList();
     static const char* getFilenameFromPath(const char* path);
+    static bool stageGzip(File& src, bool render, const char* gzPath, size_t& gzSize);
     
     // Network helpers (internal)
     static bool uploadSingleFile(const char* csvPath);
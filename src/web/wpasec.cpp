@@ -3,6 +3,7 @@
 
 #include "wpasec.h"
 #include "../core/sd_layout.h"
+#include "../core/capture_journal.h"
 #include "../core/config.h"
 #include "../core/heap_gates.h"
 #include "../core/wifi_utils.h"
@@ -318,28 +319,44 @@ bool WPASec::canSync() {
     return HeapGates::canTls(tls, lastError, sizeof(lastError));
 }
 
-bool WPASec::uploadSingleCapture(const char* filepath, const char* bssid) {
+bool WPASec::uploadSingleCapture(const char* filepath, const char* bssid,
+                                 uint32_t recordOffset) {
     if (!filepath || !bssid) return false;
     
     Serial.printf("[WPASEC] Uploading: %s\n", filepath);
     
     // Check file exists and get size
-    File capFile = SD.open(filepath, FILE_READ);
-    if (!capFile) {
-        Serial.printf("[WPASEC] Cannot open file: %s\n", filepath);
-        return false;
+    File capFile;
+    size_t fileSize = 0;
+    char recordName[64];
+    const char* filename = nullptr;
+    if (recordOffset != UINT32_MAX) {
+        // Journal record: CRC-checked, then read in place under its loose-file name
+        JournalFormat::RecordHeader hdr;
+        if (!CaptureJournal::openRecord(filepath, recordOffset, hdr, capFile)) {
+            Serial.printf("[WPASEC] Bad journal record: %s@%u\n", filepath, (unsigned)recordOffset);
+            return false;
+        }
+        fileSize = hdr.payloadLen;
+        CaptureJournal::fileName(hdr, recordName, sizeof(recordName));
+        filename = recordName;
+    } else {
+        capFile = SD.open(filepath, FILE_READ);
+        if (!capFile) {
+            Serial.printf("[WPASEC] Cannot open file: %s\n", filepath);
+            return false;
+        }
+        fileSize = capFile.size();
+        // Extract filename from path
+        filename = strrchr(filepath, '/');
+        filename = filename ? filename + 1 : filepath;
     }
-    size_t fileSize = capFile.size();
     if (fileSize == 0 || fileSize > 100000) {  // Max 100KB
         capFile.close();
         Serial.printf("[WPASEC] Invalid file size: %u\n", (unsigned int)fileSize);
         return false;
     }
     
-    // Extract filename from path
-    const char* filename = strrchr(filepath, '/');
-    filename = filename ? filename + 1 : filepath;
-    
     // Create WiFiClientSecure with minimal buffers
     WiFiClientSecure client;
     client.setInsecure();  // Skip cert validation - saves ~10KB heap
@@ -644,6 +661,7 @@ WPASecSyncResult WPASec::syncCaptures(WPASecProgressCallback cb) {
     struct PendingUpload {
         char path[80];
         char bssid[13];
+        uint32_t recordOffset;  // UINT32_MAX = whole file, else a journal record
     };
     static PendingUpload pendingUploads[16];  // Max 16 per sync (reduced from 50, saves ~3KB BSS)
     uint8_t pendingCount = 0;
@@ -711,6 +729,7 @@ WPASecSyncResult WPASec::syncCaptures(WPASecProgressCallback cb) {
                                 sizeof(pendingUploads[pendingCount].path),
                                 "%s/%s", hsDir, fname);
                         memcpy(pendingUploads[pendingCount].bssid, bssid, 13);
+                        pendingUploads[pendingCount].recordOffset = UINT32_MAX;
                         pendingCount++;
                     } else {
                         result.skipped++;
@@ -722,6 +741,31 @@ WPASecSyncResult WPASec::syncCaptures(WPASecProgressCallback cb) {
         }
         dir.close();
     }
+
+    // Journaled OINK captures upload straight from their session journal
+    struct JournalScan {
+        PendingUpload* list;
+        uint8_t* count;
+        uint8_t* skipped;
+    } scan = { pendingUploads, &pendingCount, &result.skipped };
+    if (pendingCount < 16) {
+        CaptureJournal::forEachRecord([](const CaptureJournal::RecordRef& rec, void* ctx) {
+            JournalScan& js = *(JournalScan*)ctx;
+            char bssid[13];
+            const uint8_t* b = rec.hdr.bssid;
+            snprintf(bssid, sizeof(bssid), "%02X%02X%02X%02X%02X%02X",
+                     b[0], b[1], b[2], b[3], b[4], b[5]);
+            if (isUploaded(bssid)) {
+                (*js.skipped)++;
+                return true;
+            }
+            PendingUpload& p = js.list[*js.count];
+            CaptureJournal::journalPath(rec.session, p.path, sizeof(p.path));
+            memcpy(p.bssid, bssid, 13);
+            p.recordOffset = rec.offset;
+            return ++(*js.count) < 16;
+        }, &scan);
+    }
     
     Serial.printf("[WPASEC] Found %u files to upload, %u skipped\n", 
                   (unsigned int)pendingCount, (unsigned int)result.skipped);
@@ -747,7 +791,8 @@ WPASecSyncResult WPASec::syncCaptures(WPASecProgressCallback cb) {
         Serial.printf("[WPASEC] Heap before upload %u: %u\n", 
                       i, (unsigned int)ESP.getFreeHeap());
         
-        if (uploadSingleCapture(pendingUploads[i].path, pendingUploads[i].bssid)) {
+        if (uploadSingleCapture(pendingUploads[i].path, pendingUploads[i].bssid,
+                                pendingUploads[i].recordOffset)) {
             result.uploaded++;
             successMask[i] = 1;  // Track for deferred marking
         } else {
@@ -93,6 +93,8 @@ public:
     static bool saveUploadedList();
 
     // Network helpers (internal)
-    static bool uploadSingleCapture(const char* filepath, const char* bssid);
+    // recordOffset: upload one CaptureJournal record of filepath instead of the whole file
+    static bool uploadSingleCapture(const char* filepath, const char* bssid,
+                                    uint32_t recordOffset = UINT32_MAX);
     static bool downloadPotfile(uint16_t& newCracks);
 };
@@ -0,0 +1,387 @@
+// Beacon Cache Tests
+// Tests the shared per-BSSID beacon cache: captures on one AP sharing one
+// refcounted copy, wanted entries filled by offer(), length-exact packing
+// with compaction on eviction, LRU eviction that never touches referenced
+// beacons, a randomized session checked against a simple model, and the
+// OINK pattern of pinning a beacon only while its capture is saved.
+
+#include <unity.h>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include "../../src/core/beacon_cache.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x27D4EB2Fu;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void makeBssid(uint8_t* out, uint32_t id) {
+    out[0] = 0x00;
+    out[1] = 0x1A;
+    out[2] = (uint8_t)(id >> 16);
+    out[3] = (uint8_t)(id >> 8);
+    out[4] = (uint8_t)id;
+    out[5] = 0x01;
+}
+
+// Beacon-shaped frame: BSSID at offset 16, payload derived from id
+static std::vector<uint8_t> makeBeacon(uint32_t id, uint16_t len) {
+    std::vector<uint8_t> f(len);
+    for (uint16_t i = 0; i < len; i++) f[i] = (uint8_t)(id * 31 + i * 7);
+    if (len >= 22) {
+        f[0] = 0x80;
+        makeBssid(&f[16], id);
+    }
+    return f;
+}
+
+static bool frameEquals(const BeaconCache& c, const BeaconCache::Ref& r,
+                        const std::vector<uint8_t>& expect) {
+    if (c.length(r) != expect.size()) return false;
+    const uint8_t* d = c.data(r);
+    return d && memcmp(d, expect.data(), expect.size()) == 0;
+}
+
+// ============================================================================
+// Sharing and refcounts
+// ============================================================================
+
+void test_acquire_sharesOneCopyPerBssid(void) {
+    static uint8_t storage[2048];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    uint8_t ap[6];
+    makeBssid(ap, 1);
+    std::vector<uint8_t> beacon = makeBeacon(1, 300);
+
+    // Three stations handshaking with the same AP
+    BeaconCache::Ref a = c.acquire(ap);
+    BeaconCache::Ref b = c.acquire(ap);
+    BeaconCache::Ref d = c.acquire(ap);
+    TEST_ASSERT_FALSE(a.empty());
+    TEST_ASSERT_EQUAL_UINT8(a.slot, b.slot);
+    TEST_ASSERT_EQUAL_UINT8(a.slot, d.slot);
+    TEST_ASSERT_EQUAL_UINT8(3, c.refCount(a));
+    TEST_ASSERT_FALSE(c.hasFrame(a));
+
+    TEST_ASSERT_TRUE(c.offer(ap, beacon.data(), (uint16_t)beacon.size()));
+    TEST_ASSERT_TRUE(frameEquals(c, b, beacon));
+    TEST_ASSERT_EQUAL_UINT16(300, c.bytesUsed());  // One copy, exact length
+    TEST_ASSERT_EQUAL_UINT8(1, c.entryCount());
+}
+
+void test_release_keepsFrameCachedUntilEvicted(void) {
+    static uint8_t storage[1024];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    uint8_t ap[6];
+    makeBssid(ap, 2);
+    std::vector<uint8_t> beacon = makeBeacon(2, 200);
+
+    BeaconCache::Ref a = c.acquire(ap);
+    BeaconCache::Ref b = c.acquire(ap);
+    c.offer(ap, beacon.data(), (uint16_t)beacon.size());
+    c.release(a);
+    TEST_ASSERT_TRUE(a.empty());
+    TEST_ASSERT_EQUAL_UINT8(1, c.refCount(b));
+    c.release(b);
+
+    // Unreferenced but still findable (PCAP fallback) and re-acquirable
+    BeaconCache::Ref f = c.find(ap);
+    TEST_ASSERT_TRUE(frameEquals(c, f, beacon));
+    BeaconCache::Ref again = c.acquire(ap);
+    TEST_ASSERT_TRUE(frameEquals(c, again, beacon));
+    TEST_ASSERT_EQUAL_UINT16(200, c.bytesUsed());
+}
+
+void test_release_dropsFramelessWantedEntry(void) {
+    static uint8_t storage[512];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    uint8_t ap[6];
+    makeBssid(ap, 3);
+
+    BeaconCache::Ref a = c.acquire(ap);
+    TEST_ASSERT_EQUAL_UINT8(1, c.entryCount());
+    c.release(a);
+    TEST_ASSERT_EQUAL_UINT8(0, c.entryCount());
+
+    // Nobody wants it any more: offer is a no-op
+    std::vector<uint8_t> beacon = makeBeacon(3, 100);
+    TEST_ASSERT_FALSE(c.offer(ap, beacon.data(), (uint16_t)beacon.size()));
+    TEST_ASSERT_EQUAL_UINT16(0, c.bytesUsed());
+
+    BeaconCache::Ref none = {0};
+    c.release(none);  // Zero Ref is safe
+    TEST_ASSERT_EQUAL_UINT16(0, c.length(none));
+    TEST_ASSERT_NULL(c.data(none));
+}
+
+void test_offerAndPut_keepFirstFrame(void) {
+    static uint8_t storage[1024];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    uint8_t ap[6], other[6];
+    makeBssid(ap, 4);
+    makeBssid(other, 5);
+    std::vector<uint8_t> first = makeBeacon(4, 120);
+    std::vector<uint8_t> second = makeBeacon(44, 180);
+
+    TEST_ASSERT_TRUE(c.put(ap, first.data(), (uint16_t)first.size()));
+    TEST_ASSERT_TRUE(c.put(ap, second.data(), (uint16_t)second.size()));
+    TEST_ASSERT_FALSE(c.offer(ap, second.data(), (uint16_t)second.size()));
+    TEST_ASSERT_TRUE(frameEquals(c, c.find(ap), first));
+    TEST_ASSERT_EQUAL_UINT16(120, c.bytesUsed());
+
+    // offer() never caches beacons for unwanted APs
+    TEST_ASSERT_FALSE(c.offer(other, second.data(), (uint16_t)second.size()));
+    TEST_ASSERT_TRUE(c.find(other).empty());
+}
+
+void test_rejectsOversizedAndEmptyFrames(void) {
+    static uint8_t storage[4096];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    uint8_t ap[6];
+    makeBssid(ap, 6);
+    std::vector<uint8_t> huge = makeBeacon(6, BeaconCache::kMaxFrame + 1);
+    std::vector<uint8_t> max = makeBeacon(6, BeaconCache::kMaxFrame);
+
+    BeaconCache::Ref a = c.acquire(ap);
+    TEST_ASSERT_FALSE(c.offer(ap, huge.data(), (uint16_t)huge.size()));
+    TEST_ASSERT_FALSE(c.offer(ap, max.data(), 0));
+    TEST_ASSERT_FALSE(c.hasFrame(a));
+    TEST_ASSERT_TRUE(c.offer(ap, max.data(), (uint16_t)max.size()));
+    TEST_ASSERT_TRUE(frameEquals(c, a, max));
+    TEST_ASSERT_EQUAL_UINT32(2, c.getFailedStores());
+}
+
+// ============================================================================
+// Eviction and compaction
+// ============================================================================
+
+void test_evict_lruUnreferencedAndCompacts(void) {
+    static uint8_t storage[1000];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    uint8_t ap[4][6];
+    std::vector<uint8_t> beacon[4];
+    for (uint32_t i = 0; i < 4; i++) {
+        makeBssid(ap[i], 10 + i);
+        beacon[i] = makeBeacon(10 + i, 300);
+    }
+
+    // 0 and 2 referenced, 1 unreferenced (older), 3 does not fit yet
+    BeaconCache::Ref r0 = c.acquire(ap[0]);
+    TEST_ASSERT_TRUE(c.put(ap[1], beacon[1].data(), 300));
+    BeaconCache::Ref r2 = c.acquire(ap[2]);
+    c.offer(ap[0], beacon[0].data(), 300);
+    c.offer(ap[2], beacon[2].data(), 300);
+    TEST_ASSERT_EQUAL_UINT16(900, c.bytesUsed());
+
+    // Entry 1 sits between 0 and 2 in the block; evicting it slides 2 down
+    BeaconCache::Ref r3 = c.acquire(ap[3]);
+    TEST_ASSERT_TRUE(c.offer(ap[3], beacon[3].data(), 300));
+    TEST_ASSERT_EQUAL_UINT32(1, c.getEvictions());
+    TEST_ASSERT_TRUE(c.find(ap[1]).empty());
+    TEST_ASSERT_EQUAL_UINT16(900, c.bytesUsed());
+    TEST_ASSERT_TRUE(frameEquals(c, r0, beacon[0]));
+    TEST_ASSERT_TRUE(frameEquals(c, r2, beacon[2]));
+    TEST_ASSERT_TRUE(frameEquals(c, r3, beacon[3]));
+}
+
+void test_evict_neverTouchesReferenced(void) {
+    static uint8_t storage[700];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    uint8_t ap[3][6];
+    std::vector<uint8_t> beacon[3];
+    BeaconCache::Ref refs[3];
+    for (uint32_t i = 0; i < 3; i++) {
+        makeBssid(ap[i], 20 + i);
+        beacon[i] = makeBeacon(20 + i, 300);
+        refs[i] = c.acquire(ap[i]);
+    }
+    TEST_ASSERT_TRUE(c.offer(ap[0], beacon[0].data(), 300));
+    TEST_ASSERT_TRUE(c.offer(ap[1], beacon[1].data(), 300));
+    TEST_ASSERT_FALSE(c.offer(ap[2], beacon[2].data(), 300));  // Only 100 bytes left
+    TEST_ASSERT_TRUE(frameEquals(c, refs[0], beacon[0]));
+    TEST_ASSERT_TRUE(frameEquals(c, refs[1], beacon[1]));
+    TEST_ASSERT_EQUAL_UINT32(0, c.getEvictions());
+
+    // Once a capture is saved and releases, the waiting AP gets the space
+    c.release(refs[0]);
+    TEST_ASSERT_TRUE(c.offer(ap[2], beacon[2].data(), 300));
+    TEST_ASSERT_TRUE(frameEquals(c, refs[1], beacon[1]));
+    TEST_ASSERT_TRUE(frameEquals(c, refs[2], beacon[2]));
+}
+
+void test_entries_fullOfReferencesFailsAcquire(void) {
+    static uint8_t storage[512];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    BeaconCache::Ref refs[BeaconCache::kMaxEntries];
+    for (uint32_t i = 0; i < BeaconCache::kMaxEntries; i++) {
+        uint8_t ap[6];
+        makeBssid(ap, 100 + i);
+        refs[i] = c.acquire(ap);
+        TEST_ASSERT_FALSE(refs[i].empty());
+    }
+    uint8_t extra[6];
+    makeBssid(extra, 999);
+    TEST_ASSERT_TRUE(c.acquire(extra).empty());
+    TEST_ASSERT_EQUAL_UINT32(1, c.getFailedAcquires());
+
+    c.release(refs[5]);
+    TEST_ASSERT_FALSE(c.acquire(extra).empty());
+}
+
+// ============================================================================
+// Session
+// ============================================================================
+
+void test_session_matchesModel(void) {
+    // 200 APs, up to 8 live captures, beacons 80..500 bytes, 2.5KB block.
+    // Every referenced frame must match its AP's bytes and bytesUsed must
+    // equal the sum of cached lengths (no leaks, no holes).
+    static uint8_t storage[2560];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    struct Capture { uint32_t ap; BeaconCache::Ref ref; };
+    std::vector<Capture> live;
+    std::map<uint32_t, uint16_t> apLen;
+    uint32_t withBeacon = 0, saved = 0;
+    size_t oldPerCaptureBytes = 0, peakOld = 0, peakNew = 0;
+
+    for (int step = 0; step < 50000; step++) {
+        uint32_t op = nextRand() % 10;
+        if (op < 3 && live.size() < 8) {
+            uint32_t ap = nextRand() % 200;
+            uint8_t b[6];
+            makeBssid(b, ap);
+            BeaconCache::Ref r = c.acquire(b);
+            if (!r.empty()) live.push_back({ap, r});
+        } else if (op < 8) {
+            // Beacons from APs with live captures (offer) or a target (put)
+            bool target = op >= 6 || live.empty();
+            uint32_t ap = target ? nextRand() % 200 : live[nextRand() % live.size()].ap;
+            if (!apLen.count(ap)) apLen[ap] = (uint16_t)(80 + nextRand() % 420);
+            std::vector<uint8_t> f = makeBeacon(ap, apLen[ap]);
+            if (target) c.put(&f[16], f.data(), (uint16_t)f.size());
+            else c.offer(&f[16], f.data(), (uint16_t)f.size());
+        } else if (!live.empty()) {
+            size_t i = nextRand() % live.size();
+            if (c.hasFrame(live[i].ref)) withBeacon++;
+            saved++;
+            c.release(live[i].ref);
+            live[i] = live.back();
+            live.pop_back();
+        }
+
+        oldPerCaptureBytes = 0;
+        for (const Capture& cap : live) {
+            TEST_ASSERT_TRUE(c.refCount(cap.ref) > 0);
+            if (c.hasFrame(cap.ref)) {
+                TEST_ASSERT_TRUE(frameEquals(c, cap.ref, makeBeacon(cap.ap, apLen[cap.ap])));
+                oldPerCaptureBytes += apLen[cap.ap];
+            }
+        }
+        if (oldPerCaptureBytes > peakOld) peakOld = oldPerCaptureBytes;
+        if (c.bytesUsed() > peakNew) peakNew = c.bytesUsed();
+        TEST_ASSERT_TRUE(c.bytesUsed() <= c.capacity());
+    }
+
+    // bytesUsed accounts for exactly the cached frames
+    size_t cachedBytes = 0;
+    for (uint32_t ap = 0; ap < 200; ap++) {
+        uint8_t b[6];
+        makeBssid(b, ap);
+        BeaconCache::Ref r = c.find(b);
+        if (!r.empty()) cachedBytes += c.length(r);
+    }
+    TEST_ASSERT_EQUAL_UINT32(cachedBytes, c.bytesUsed());
+    TEST_ASSERT_TRUE(saved > 1000);
+    TEST_ASSERT_TRUE(withBeacon > saved / 2);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "%u captures saved (%u with beacon), peak %u bytes per-capture copies vs %u shared, %u evictions",
+             (unsigned)saved, (unsigned)withBeacon, (unsigned)peakOld, (unsigned)peakNew,
+             (unsigned)c.getEvictions());
+    TEST_MESSAGE(msg);
+}
+
+void test_session_oinkPinsOnlyWhileSaving(void) {
+    // OINK: the target's beacon is put() ahead of its handshake, and a ref
+    // is held only while a complete capture is being saved. 40 targets,
+    // each leaving behind several M1-only stations that never complete:
+    // every target's beacon must still be cached and pinned at save time.
+    static uint8_t storage[2560];
+    BeaconCache c;
+    c.attach(storage, sizeof(storage));
+    for (uint32_t target = 0; target < 40; target++) {
+        std::vector<uint8_t> f = makeBeacon(target, (uint16_t)(120 + nextRand() % 300));
+        TEST_ASSERT_TRUE(c.put(&f[16], f.data(), (uint16_t)f.size()));
+
+        // Incomplete captures on neighbours take no reference
+        for (int n = 0; n < 3; n++) {
+            std::vector<uint8_t> g = makeBeacon(1000 + target * 3 + n, 200);
+            c.offer(&g[16], g.data(), (uint16_t)g.size());
+        }
+
+        BeaconCache::Ref ref = c.acquire(&f[16]);
+        TEST_ASSERT_FALSE(ref.empty());
+        TEST_ASSERT_TRUE(frameEquals(c, ref, f));
+        c.release(ref);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, c.getFailedAcquires());
+    TEST_ASSERT_EQUAL_UINT32(0, c.getFailedStores());
+
+    // Pinning every capture at creation instead runs out after kMaxEntries
+    BeaconCache pinned;
+    pinned.attach(storage, sizeof(storage));
+    BeaconCache::Ref refs[BeaconCache::kMaxEntries];
+    for (uint32_t i = 0; i < BeaconCache::kMaxEntries; i++) {
+        uint8_t ap[6];
+        makeBssid(ap, 2000 + i);
+        refs[i] = pinned.acquire(ap);
+    }
+    std::vector<uint8_t> f = makeBeacon(3000, 200);
+    TEST_ASSERT_FALSE(pinned.put(&f[16], f.data(), (uint16_t)f.size()));
+    for (auto& r : refs) pinned.release(r);
+    TEST_ASSERT_TRUE(pinned.put(&f[16], f.data(), (uint16_t)f.size()));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Sharing and refcounts
+    RUN_TEST(test_acquire_sharesOneCopyPerBssid);
+    RUN_TEST(test_release_keepsFrameCachedUntilEvicted);
+    RUN_TEST(test_release_dropsFramelessWantedEntry);
+    RUN_TEST(test_offerAndPut_keepFirstFrame);
+    RUN_TEST(test_rejectsOversizedAndEmptyFrames);
+
+    // Eviction and compaction
+    RUN_TEST(test_evict_lruUnreferencedAndCompacts);
+    RUN_TEST(test_evict_neverTouchesReferenced);
+    RUN_TEST(test_entries_fullOfReferencesFailsAcquire);
+
+    // Session
+    RUN_TEST(test_session_matchesModel);
+    RUN_TEST(test_session_oinkPinsOnlyWhileSaving);
+
+    return UNITY_END();
+}
@@ -0,0 +1,672 @@
+// Beacon Summary Tests
+// Tests the single-pass IE parser shared by NetworkRecon, OINK, DNH and
+// SPECTRUM, checks it against the legacy multi-walk parsing it replaced,
+// and benchmarks throughput over a beacon corpus.
+
+#include <unity.h>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include "../mocks/mock_esp_wifi.h"
+#include "../../src/core/beacon_summary.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Frame builder
+// Beacon: FC(2) Dur(2) DA(6) SA(6) BSSID(6) Seq(2) | TS(8) Intvl(2) Cap(2) | IEs
+// ============================================================================
+
+struct Frame {
+    uint8_t buf[768];
+    uint16_t len;
+
+    explicit Frame(uint8_t fc0 = 0x80) {
+        memset(buf, 0, sizeof(buf));
+        buf[0] = fc0;
+        static const uint8_t bssid[6] = {0xA4, 0x2B, 0xB0, 0x11, 0x22, 0x33};
+        memset(buf + 4, 0xFF, 6);
+        memcpy(buf + 10, bssid, 6);
+        memcpy(buf + 16, bssid, 6);
+        buf[32] = 0x64;  // 100 TU
+        buf[34] = 0x11;  // ESS + Privacy
+        len = 36;
+    }
+
+    Frame& ie(uint8_t id, const uint8_t* data, uint8_t n) {
+        buf[len] = id;
+        buf[len + 1] = n;
+        if (n) memcpy(buf + len + 2, data, n);
+        len += 2 + n;
+        return *this;
+    }
+    Frame& ie(uint8_t id, std::initializer_list<uint8_t> data) {
+        std::vector<uint8_t> v(data);
+        return ie(id, v.data(), (uint8_t)v.size());
+    }
+    Frame& ssid(const char* s) { return ie(0, (const uint8_t*)s, (uint8_t)strlen(s)); }
+    Frame& rates() { return ie(1, {0x82, 0x84, 0x8B, 0x96, 0x0C, 0x12, 0x18, 0x24}); }
+    Frame& ds(uint8_t ch) { return ie(3, {ch}); }
+    Frame& tim() { return ie(5, {0x00, 0x01, 0x00, 0x00}); }
+    Frame& country() { return ie(7, {'U', 'S', 0x20, 0x01, 0x0B, 0x1E}); }
+    Frame& erp() { return ie(42, {0x00}); }
+    Frame& extRates() { return ie(50, {0x30, 0x48, 0x60, 0x6C}); }
+    Frame& htCap() {
+        uint8_t d[26] = {0xEF, 0x19, 0x1B, 0xFF, 0xFF, 0xFF, 0x00};
+        return ie(45, d, 26);
+    }
+    Frame& htOp(uint8_t ch) {
+        uint8_t d[22] = {ch, 0x05, 0x00, 0x00};
+        return ie(61, d, 22);
+    }
+    Frame& extCaps() { return ie(127, {0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x40}); }
+    Frame& vhtCap() {
+        uint8_t d[12] = {0x91, 0x59, 0x82, 0x0F, 0xEA, 0xFF};
+        return ie(191, d, 12);
+    }
+    Frame& rsn(std::initializer_list<uint8_t> akms, uint16_t caps) {
+        std::vector<uint8_t> d = {0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+                                  0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04};
+        d.push_back((uint8_t)akms.size());
+        d.push_back(0x00);
+        for (uint8_t a : akms) {
+            d.insert(d.end(), {0x00, 0x0F, 0xAC, a});
+        }
+        d.push_back((uint8_t)(caps & 0xFF));
+        d.push_back((uint8_t)(caps >> 8));
+        return ie(0x30, d.data(), (uint8_t)d.size());
+    }
+    Frame& wpa1() {
+        return ie(0xDD, {0x00, 0x50, 0xF2, 0x01, 0x01, 0x00,
+                         0x00, 0x50, 0xF2, 0x02,
+                         0x01, 0x00, 0x00, 0x50, 0xF2, 0x02,
+                         0x01, 0x00, 0x00, 0x50, 0xF2, 0x02});
+    }
+    Frame& wmm() {
+        uint8_t d[24] = {0x00, 0x50, 0xF2, 0x02, 0x01, 0x01, 0x80, 0x00,
+                         0x03, 0xA4, 0x00, 0x00, 0x27, 0xA4, 0x00, 0x00,
+                         0x42, 0x43, 0x5E, 0x00, 0x62, 0x32, 0x2F, 0x00};
+        return ie(0xDD, d, 24);
+    }
+    Frame& wps() {
+        return ie(0xDD, {0x00, 0x50, 0xF2, 0x04, 0x10, 0x4A, 0x00, 0x01, 0x10,
+                         0x10, 0x44, 0x00, 0x01, 0x02, 0x10, 0x49, 0x00, 0x06,
+                         0x00, 0x37, 0x2A, 0x00, 0x01, 0x20});
+    }
+    Frame& broadcom() { return ie(0xDD, {0x00, 0x10, 0x18, 0x02, 0x00, 0x00, 0x1C, 0x00, 0x00}); }
+    Frame& hotspot20() { return ie(0xDD, {0x50, 0x6F, 0x9A, 0x10, 0x10}); }
+    Frame& rsnx() { return ie(244, {0x20}); }
+};
+
+// ============================================================================
+// Corpus - IE layouts modelled on captures from common AP families
+// ============================================================================
+
+static Frame homeRouterWpa2() {
+    Frame f;
+    f.ssid("NETGEAR42").rates().ds(6).tim().country().erp().extRates()
+     .rsn({2}, 0x000C).htCap().htOp(6).extCaps().vhtCap().wmm().wps().broadcom();
+    return f;
+}
+
+static Frame wpa3Transition() {
+    Frame f;
+    f.ssid("Vodafone-5G-A1B2").rates().ds(11).tim().country().erp().extRates()
+     .rsn({2, 8}, 0x004C).htCap().htOp(11).extCaps().rsnx().wmm();
+    return f;
+}
+
+static Frame wpa3Only() {
+    Frame f;
+    f.ssid("pigpen").rates().ds(1).tim().rsn({8}, 0x00C0).htCap().htOp(1).extCaps().rsnx().wmm();
+    return f;
+}
+
+static Frame enterprise() {
+    Frame f;
+    f.ssid("eduroam").rates().ds(36).tim().country().rsn({1, 3}, 0x0028)
+     .htCap().htOp(36).vhtCap().extCaps().wmm();
+    return f;
+}
+
+static Frame openHotspot() {
+    Frame f;
+    f.buf[34] = 0x01;  // ESS, no privacy
+    f.ssid("xfinitywifi").rates().ds(1).tim().erp().extRates().htCap().htOp(1)
+     .extCaps().wmm().hotspot20();
+    return f;
+}
+
+static Frame hiddenWpa2() {
+    Frame f;
+    f.ie(0, nullptr, 0).rates().ds(3).tim().rsn({2}, 0x0000).htCap().htOp(3).wmm();
+    return f;
+}
+
+static Frame nullPaddedHidden() {
+    Frame f;
+    uint8_t zeros[9] = {0};
+    f.ie(0, zeros, 9).rates().ds(9).tim().rsn({2}, 0x0000).wmm();
+    return f;
+}
+
+static Frame mixedWpaWpa2() {
+    Frame f;
+    f.ssid("linksys").rates().ds(6).tim().erp().extRates().rsn({2}, 0x0000).wpa1().wmm().wps();
+    return f;
+}
+
+static Frame wpa1Only() {
+    Frame f;
+    f.ssid("old-dlink").rates().ds(2).tim().wpa1();
+    return f;
+}
+
+static Frame truncatedTail() {
+    Frame f;
+    f.ssid("cutoff").rates().ds(4).rsn({2}, 0x0040);
+    // Vendor IE claims 40 bytes but only 3 made it on air
+    f.buf[f.len] = 0xDD;
+    f.buf[f.len + 1] = 40;
+    f.len += 5;
+    return f;
+}
+
+static std::vector<Frame> buildCorpus() {
+    return {homeRouterWpa2(), wpa3Transition(), wpa3Only(), enterprise(), openHotspot(),
+            hiddenWpa2(), nullPaddedHidden(), mixedWpaWpa2(), wpa1Only(), truncatedTail()};
+}
+
+// ============================================================================
+// Legacy parsing (what NetworkRecon::processBeacon + detectPMF did before:
+// four separate IE walks). Kept as the reference for equivalence checks.
+// ============================================================================
+
+struct LegacyResult {
+    char ssid[33];
+    bool isHidden;
+    uint8_t channel;
+    wifi_auth_mode_t authmode;
+    bool pmfCapable;
+    bool pmfRequired;
+};
+
+static LegacyResult legacyParse(const uint8_t* payload, uint16_t len) {
+    LegacyResult r;
+    memset(&r, 0, sizeof(r));
+    r.authmode = WIFI_AUTH_OPEN;
+
+    // Pass 1: PMF
+    uint16_t offset = 36;
+    while (offset + 2 < len) {
+        uint8_t id = payload[offset];
+        uint8_t ieLen = payload[offset + 1];
+        if (offset + 2 + ieLen > len) break;
+        if (id == 0x30 && ieLen >= 8) {
+            uint16_t rsnOffset = offset + 2;
+            uint16_t rsnEnd = rsnOffset + ieLen;
+            uint16_t version = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
+            if (version != 1) { offset += 2 + ieLen; continue; }
+            rsnOffset += 6;
+            if (rsnOffset + 2 > rsnEnd) break;
+            uint16_t pairwiseCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
+            rsnOffset += 2 + (pairwiseCount * 4);
+            if (rsnOffset + 2 > rsnEnd) break;
+            uint16_t akmCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
+            rsnOffset += 2 + (akmCount * 4);
+            if (rsnOffset + 2 > rsnEnd) break;
+            uint16_t caps = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
+            r.pmfCapable = (caps >> 6) & 0x01;
+            r.pmfRequired = (caps >> 7) & 0x01;
+            break;
+        }
+        offset += 2 + ieLen;
+    }
+
+    // Pass 2: SSID
+    offset = 36;
+    while (offset + 2 < len) {
+        uint8_t id = payload[offset];
+        uint8_t ieLen = payload[offset + 1];
+        if (offset + 2 + ieLen > len) break;
+        if (id == 0) {
+            if (ieLen > 0 && ieLen <= 32) {
+                memcpy(r.ssid, payload + offset + 2, ieLen);
+                r.ssid[ieLen] = 0;
+                bool allNull = true;
+                for (uint8_t i = 0; i < ieLen; i++) {
+                    if (r.ssid[i] != 0) { allNull = false; break; }
+                }
+                if (allNull) r.isHidden = true;
+            } else if (ieLen == 0) {
+                r.isHidden = true;
+            }
+            break;
+        }
+        offset += 2 + ieLen;
+    }
+
+    // Pass 3: DS channel
+    offset = 36;
+    while (offset + 2 < len) {
+        uint8_t id = payload[offset];
+        uint8_t ieLen = payload[offset + 1];
+        if (offset + 2 + ieLen > len) break;
+        if (id == 3 && ieLen == 1) {
+            r.channel = payload[offset + 2];
+            break;
+        }
+        offset += 2 + ieLen;
+    }
+
+    // Pass 4: RSN / WPA
+    bool hasRSN = false;
+    offset = 36;
+    while (offset + 2 < len) {
+        uint8_t id = payload[offset];
+        uint8_t ieLen = payload[offset + 1];
+        if (offset + 2 + ieLen > len) break;
+        if (id == 0x30 && ieLen >= 2) {
+            hasRSN = true;
+            r.authmode = WIFI_AUTH_WPA2_PSK;
+        } else if (id == 0xDD && ieLen >= 8) {
+            if (payload[offset + 2] == 0x00 && payload[offset + 3] == 0x50 &&
+                payload[offset + 4] == 0xF2 && payload[offset + 5] == 0x01) {
+                r.authmode = hasRSN ? WIFI_AUTH_WPA_WPA2_PSK : WIFI_AUTH_WPA_PSK;
+            }
+        }
+        offset += 2 + ieLen;
+    }
+    if (hasRSN && r.authmode == WIFI_AUTH_WPA2_PSK) {
+        if (r.pmfRequired) r.authmode = WIFI_AUTH_WPA3_PSK;
+        else if (r.pmfCapable) r.authmode = WIFI_AUTH_WPA2_WPA3_PSK;
+    }
+    return r;
+}
+
+// Legacy SpectrumMode callback: SSID+DS walk, RSN/WPA walk, detectPMFBits walk
+static uint32_t legacySpectrumParse(const uint8_t* payload, uint16_t len) {
+    char ssid[33] = {0};
+    uint8_t dsChannel = 0;
+    bool ssidFound = false;
+    uint16_t offset = 36;
+    while (offset + 2 < len) {
+        uint8_t tagNum = payload[offset];
+        uint8_t tagLen = payload[offset + 1];
+        if (offset + 2 + tagLen > len) break;
+        if (tagNum == 0 && tagLen <= 32) {
+            memcpy(ssid, payload + offset + 2, tagLen);
+            ssid[tagLen] = 0;
+            ssidFound = true;
+        } else if (tagNum == 3 && tagLen == 1) {
+            dsChannel = payload[offset + 2];
+        }
+        if (ssidFound && dsChannel >= 1 && dsChannel <= 13) break;
+        offset += 2 + tagLen;
+    }
+    LegacyResult r = legacyParse(payload, len);  // RSN/WPA + PMF walks
+    return dsChannel + (uint32_t)ssid[0] + r.authmode;
+}
+
+// ============================================================================
+// IECursor
+// ============================================================================
+
+void test_cursor_walksAllElements(void) {
+    Frame f = homeRouterWpa2();
+    IECursor cur(f.buf + 36, f.len - 36);
+    uint8_t id, n;
+    const uint8_t* body;
+    int count = 0;
+    while (cur.next(id, n, body)) count++;
+    TEST_ASSERT_EQUAL_INT(15, count);
+    TEST_ASSERT_FALSE(cur.truncated);
+}
+
+void test_cursor_stopsOnTruncatedElement(void) {
+    Frame f = truncatedTail();
+    IECursor cur(f.buf + 36, f.len - 36);
+    uint8_t id, n;
+    const uint8_t* body;
+    int count = 0;
+    while (cur.next(id, n, body)) count++;
+    TEST_ASSERT_EQUAL_INT(4, count);
+    TEST_ASSERT_TRUE(cur.truncated);
+}
+
+void test_cursor_nullAndEmpty(void) {
+    IECursor a(nullptr, 100);
+    IECursor b((const uint8_t*)"", 0);
+    uint8_t id, n;
+    const uint8_t* body;
+    TEST_ASSERT_FALSE(a.next(id, n, body));
+    TEST_ASSERT_FALSE(b.next(id, n, body));
+}
+
+// ============================================================================
+// Field extraction
+// ============================================================================
+
+void test_summary_homeRouter(void) {
+    Frame f = homeRouterWpa2();
+    BeaconSummary s;
+    TEST_ASSERT_TRUE(BeaconParser::parseBeacon(f.buf, f.len, s));
+    char ssid[33] = {0};
+    TEST_ASSERT_TRUE(s.copySsid(ssid));
+    TEST_ASSERT_EQUAL_STRING("NETGEAR42", ssid);
+    TEST_ASSERT_TRUE(s.hasUsableSsid());
+    TEST_ASSERT_FALSE(s.isHidden());
+    TEST_ASSERT_EQUAL_UINT8(6, s.dsChannel);
+    TEST_ASSERT_TRUE(s.hasRSN);
+    TEST_ASSERT_TRUE(s.rsnCapsPresent);
+    TEST_ASSERT_FALSE(s.mfpc);
+    TEST_ASSERT_FALSE(s.mfpr);
+    TEST_ASSERT_EQUAL_UINT32(kAkmPsk, s.rsnAkms);
+    TEST_ASSERT_TRUE(s.hasWMM);
+    TEST_ASSERT_TRUE(s.hasWPS);
+    TEST_ASSERT_FALSE(s.hasWPA);
+    TEST_ASSERT_EQUAL_UINT8(3, s.vendorCount);
+    TEST_ASSERT_EQUAL_UINT8(3, s.vendorTotal);
+    TEST_ASSERT_FALSE(s.truncated);
+    TEST_ASSERT_EQUAL_INT((int)BeaconAuth::Wpa2, (int)s.auth());
+}
+
+void test_summary_wpa3Transition(void) {
+    Frame f = wpa3Transition();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.mfpc);
+    TEST_ASSERT_FALSE(s.mfpr);
+    TEST_ASSERT_EQUAL_UINT32(kAkmPsk | kAkmSae, s.rsnAkms);
+    TEST_ASSERT_EQUAL_INT((int)WIFI_AUTH_WPA2_WPA3_PSK, (int)s.auth());
+}
+
+void test_summary_wpa3Only(void) {
+    Frame f = wpa3Only();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.mfpc);
+    TEST_ASSERT_TRUE(s.mfpr);
+    TEST_ASSERT_EQUAL_UINT32(kAkmSae, s.rsnAkms);
+    TEST_ASSERT_EQUAL_INT((int)WIFI_AUTH_WPA3_PSK, (int)s.auth());
+}
+
+void test_summary_enterpriseAkms(void) {
+    Frame f = enterprise();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_EQUAL_UINT32(kAkm8021X | kAkmFt8021X, s.rsnAkms);
+    TEST_ASSERT_EQUAL_UINT8(36, s.dsChannel);
+}
+
+void test_summary_openHotspot(void) {
+    Frame f = openHotspot();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_FALSE(s.hasRSN);
+    TEST_ASSERT_FALSE(s.hasWPA);
+    TEST_ASSERT_EQUAL_INT((int)WIFI_AUTH_OPEN, (int)s.auth());
+    TEST_ASSERT_EQUAL_UINT8(2, s.vendorCount);
+    // Hotspot 2.0 element is exposed zero-copy for callers that want it
+    TEST_ASSERT_EQUAL_HEX8(0x50, s.vendor[1].body[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x9A, s.vendor[1].body[2]);
+    TEST_ASSERT_EQUAL_UINT8(5, s.vendor[1].len);
+}
+
+void test_summary_hiddenZeroLength(void) {
+    Frame f = hiddenWpa2();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.ssidPresent);
+    TEST_ASSERT_TRUE(s.isHidden());
+    TEST_ASSERT_FALSE(s.hasUsableSsid());
+    char ssid[33] = "untouched";
+    TEST_ASSERT_FALSE(s.copySsid(ssid));
+    TEST_ASSERT_EQUAL_STRING("untouched", ssid);
+}
+
+void test_summary_hiddenNullPadded(void) {
+    Frame f = nullPaddedHidden();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.isHidden());
+    TEST_ASSERT_FALSE(s.hasUsableSsid());
+    TEST_ASSERT_EQUAL_UINT8(9, s.ssidLen);
+}
+
+void test_summary_mixedWpaWpa2(void) {
+    Frame f = mixedWpaWpa2();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.hasRSN);
+    TEST_ASSERT_TRUE(s.hasWPA);
+    TEST_ASSERT_EQUAL_UINT32(kAkmPsk, s.wpaAkms);
+    TEST_ASSERT_EQUAL_INT((int)WIFI_AUTH_WPA_WPA2_PSK, (int)s.auth());
+}
+
+void test_summary_wpa1Only(void) {
+    Frame f = wpa1Only();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_EQUAL_INT((int)WIFI_AUTH_WPA_PSK, (int)s.auth());
+}
+
+void test_summary_truncatedKeepsEarlierFields(void) {
+    Frame f = truncatedTail();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.truncated);
+    TEST_ASSERT_EQUAL_UINT8(4, s.dsChannel);
+    TEST_ASSERT_TRUE(s.mfpc);
+    TEST_ASSERT_EQUAL_UINT8(0, s.vendorTotal);
+}
+
+void test_summary_rsnWithoutCaps(void) {
+    // Caps are optional - PSK AKM but no trailing capability field
+    Frame f;
+    f.ssid("nocaps").ie(0x30, {0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+                               0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+                               0x01, 0x00, 0x00, 0x0F, 0xAC, 0x02});
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.hasRSN);
+    TEST_ASSERT_FALSE(s.rsnCapsPresent);
+    TEST_ASSERT_EQUAL_UINT32(kAkmPsk, s.rsnAkms);
+    TEST_ASSERT_EQUAL_INT((int)WIFI_AUTH_WPA2_PSK, (int)s.auth());
+}
+
+void test_summary_rsnLyingAkmCount(void) {
+    // AKM count far past the element - must not read beyond it
+    Frame f;
+    f.ssid("liar").ie(0x30, {0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+                             0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+                             0xFF, 0x00, 0x00, 0x0F, 0xAC, 0x02, 0xC0, 0x00});
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_TRUE(s.hasRSN);
+    TEST_ASSERT_FALSE(s.rsnCapsPresent);
+    TEST_ASSERT_FALSE(s.mfpr);
+    TEST_ASSERT_EQUAL_UINT32(0, s.rsnAkms);
+}
+
+void test_summary_vendorCapKeepsCounting(void) {
+    Frame f;
+    f.ssid("vendors");
+    for (int i = 0; i < 12; i++) f.broadcom();
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+    TEST_ASSERT_EQUAL_UINT8(BeaconSummary::kMaxVendorIes, s.vendorCount);
+    TEST_ASSERT_EQUAL_UINT8(12, s.vendorTotal);
+}
+
+void test_summary_tooShort(void) {
+    uint8_t tiny[30] = {0x80};
+    BeaconSummary s;
+    TEST_ASSERT_FALSE(BeaconParser::parseBeacon(tiny, sizeof(tiny), s));
+    TEST_ASSERT_FALSE(s.ssidPresent);
+    TEST_ASSERT_FALSE(BeaconParser::parseBeacon(nullptr, 100, s));
+}
+
+void test_summary_assocRequestOffsets(void) {
+    // Assoc request: hdr(24) cap(2) listen(2) then IEs
+    uint8_t frame[64] = {0x00};
+    uint16_t len = 28;
+    frame[len++] = 0; frame[len++] = 4;
+    memcpy(frame + len, "oink", 4); len += 4;
+    BeaconSummary s;
+    TEST_ASSERT_TRUE(BeaconParser::parseAssocRequest(frame, len, false, s));
+    char ssid[33] = {0};
+    TEST_ASSERT_TRUE(s.copySsid(ssid));
+    TEST_ASSERT_EQUAL_STRING("oink", ssid);
+
+    // Reassoc adds current AP address (6 bytes)
+    uint8_t re[64] = {0x20};
+    len = 34;
+    re[len++] = 0; re[len++] = 4;
+    memcpy(re + len, "boar", 4); len += 4;
+    TEST_ASSERT_TRUE(BeaconParser::parseAssocRequest(re, len, true, s));
+    TEST_ASSERT_TRUE(s.copySsid(ssid));
+    TEST_ASSERT_EQUAL_STRING("boar", ssid);
+}
+
+// ============================================================================
+// Equivalence with the legacy multi-walk parser
+// ============================================================================
+
+static void assertMatchesLegacy(const Frame& f) {
+    LegacyResult old = legacyParse(f.buf, f.len);
+    BeaconSummary s;
+    BeaconParser::parseBeacon(f.buf, f.len, s);
+
+    char ssid[33] = {0};
+    if (!s.isHidden()) s.copySsid(ssid);
+    TEST_ASSERT_EQUAL_STRING(old.isHidden ? "" : old.ssid, ssid);
+    TEST_ASSERT_EQUAL(old.isHidden, s.isHidden());
+    TEST_ASSERT_EQUAL_UINT8(old.channel, s.dsChannel);
+    TEST_ASSERT_EQUAL(old.pmfRequired, s.mfpr);
+    TEST_ASSERT_EQUAL(old.pmfCapable, s.mfpc);
+    TEST_ASSERT_EQUAL_INT((int)old.authmode, (int)s.auth());
+}
+
+void test_corpus_matchesLegacyParser(void) {
+    std::vector<Frame> corpus = buildCorpus();
+    for (const Frame& f : corpus) {
+        assertMatchesLegacy(f);
+    }
+}
+
+void test_fuzz_noOverreadAndSsidChannelAgree(void) {
+    // Random bit-flips over the corpus. Run under ASan to catch overreads.
+    // Only fields whose legacy semantics are order-independent are compared.
+    uint32_t rng = 0xC0FFEE;
+    std::vector<Frame> corpus = buildCorpus();
+    for (int iter = 0; iter < 20000; iter++) {
+        Frame f = corpus[iter % corpus.size()];
+        for (int k = 0; k < 4; k++) {
+            rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+            uint16_t pos = 36 + (rng % (f.len - 36));
+            f.buf[pos] ^= (uint8_t)(rng >> 8);
+        }
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        uint16_t len = 36 + (rng % (f.len - 35));
+
+        LegacyResult old = legacyParse(f.buf, len);
+        BeaconSummary s;
+        BeaconParser::parseBeacon(f.buf, len, s);
+        TEST_ASSERT_EQUAL_UINT8(old.channel, s.dsChannel);
+        // Legacy loops (offset + 2 < len) never saw an empty element in the
+        // last two bytes of the frame; the cursor does.
+        bool trailingEmptySsid = s.ssidPresent && s.ssidLen == 0 && (s.ssid - f.buf) == len;
+        if (trailingEmptySsid) continue;
+        TEST_ASSERT_EQUAL(old.isHidden, s.isHidden() && s.ssidLen <= 32);
+    }
+}
+
+// ============================================================================
+// Throughput: legacy per-frame parsing (NetworkRecon 4 walks + SPECTRUM
+// re-walking the same frame) vs one shared pass. Reported, not asserted.
+// ============================================================================
+
+void test_benchmark_throughput(void) {
+    std::vector<Frame> corpus = buildCorpus();
+    size_t bytes = 0;
+    for (const Frame& f : corpus) bytes += f.len;
+
+    const int kRounds = 20000;
+    volatile uint32_t sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRounds; r++) {
+        for (const Frame& f : corpus) {
+            LegacyResult old = legacyParse(f.buf, f.len);
+            sink += old.channel + old.authmode;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRounds; r++) {
+        for (const Frame& f : corpus) {
+            LegacyResult old = legacyParse(f.buf, f.len);
+            sink += old.channel + legacySpectrumParse(f.buf, f.len);
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRounds; r++) {
+        for (const Frame& f : corpus) {
+            BeaconSummary s;
+            BeaconParser::parseBeacon(f.buf, f.len, s);
+            sink += s.dsChannel + (uint32_t)s.auth();
+        }
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    double frames = (double)kRounds * corpus.size();
+    double reconNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+    double pipeNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / frames;
+    double newNs = std::chrono::duration<double, std::nano>(t3 - t2).count() / frames;
+    double mbps = (bytes * (double)kRounds) /
+                  (std::chrono::duration<double>(t3 - t2).count() * 1e6);
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "avg beacon %zu B: legacy recon %.1f ns, legacy recon+mode %.1f ns, "
+             "single pass %.1f ns/frame (%.0f MB/s)",
+             bytes / corpus.size(), reconNs, pipeNs, newNs, mbps);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(sink != 0);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // IECursor
+    RUN_TEST(test_cursor_walksAllElements);
+    RUN_TEST(test_cursor_stopsOnTruncatedElement);
+    RUN_TEST(test_cursor_nullAndEmpty);
+
+    // Field extraction
+    RUN_TEST(test_summary_homeRouter);
+    RUN_TEST(test_summary_wpa3Transition);
+    RUN_TEST(test_summary_wpa3Only);
+    RUN_TEST(test_summary_enterpriseAkms);
+    RUN_TEST(test_summary_openHotspot);
+    RUN_TEST(test_summary_hiddenZeroLength);
+    RUN_TEST(test_summary_hiddenNullPadded);
+    RUN_TEST(test_summary_mixedWpaWpa2);
+    RUN_TEST(test_summary_wpa1Only);
+    RUN_TEST(test_summary_truncatedKeepsEarlierFields);
+    RUN_TEST(test_summary_rsnWithoutCaps);
+    RUN_TEST(test_summary_rsnLyingAkmCount);
+    RUN_TEST(test_summary_vendorCapKeepsCounting);
+    RUN_TEST(test_summary_tooShort);
+    RUN_TEST(test_summary_assocRequestOffsets);
+
+    // Legacy equivalence
+    RUN_TEST(test_corpus_matchesLegacyParser);
+    RUN_TEST(test_fuzz_noOverreadAndSsidChannelAgree);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_throughput);
+
+    return UNITY_END();
+}
@@ -0,0 +1,414 @@
+// BSSID Index Tests
+// Tests the open-addressed BSSID -> slot table used by NetworkRecon,
+// plus a lookup benchmark against the old linear memcmp scan.
+
+#include <unity.h>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <map>
+#include <vector>
+#include "../../src/core/bssid_index.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+struct FakeNetwork {
+    uint8_t bssid[6];
+};
+
+static uint32_t rngState = 0x12345678u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Realistic scan: a handful of vendor OUIs, random NIC bytes
+static void makeBssid(uint8_t* out) {
+    static const uint8_t ouis[4][3] = {
+        {0x64, 0xEE, 0xB7}, {0xA4, 0x2B, 0xB0}, {0x00, 0x1A, 0x2B}, {0xF0, 0x9F, 0xC2}
+    };
+    uint32_t r = nextRand();
+    memcpy(out, ouis[r & 3], 3);
+    uint32_t nic = nextRand();
+    out[3] = (uint8_t)(nic >> 16);
+    out[4] = (uint8_t)(nic >> 8);
+    out[5] = (uint8_t)nic;
+}
+
+static uint64_t keyOf(const uint8_t* b) {
+    uint64_t k = 0;
+    for (int i = 0; i < 6; i++) k = (k << 8) | b[i];
+    return k;
+}
+
+static std::vector<FakeNetwork> makeUniqueNetworks(size_t n) {
+    std::vector<FakeNetwork> nets;
+    std::map<uint64_t, bool> seen;
+    while (nets.size() < n) {
+        FakeNetwork net;
+        makeBssid(net.bssid);
+        if (seen.count(keyOf(net.bssid))) continue;
+        seen[keyOf(net.bssid)] = true;
+        nets.push_back(net);
+    }
+    return nets;
+}
+
+static int linearFind(const std::vector<FakeNetwork>& nets, const uint8_t* bssid) {
+    for (size_t i = 0; i < nets.size(); i++) {
+        if (memcmp(nets[i].bssid, bssid, 6) == 0) return (int)i;
+    }
+    return -1;
+}
+
+// ============================================================================
+// Basic Operations
+// ============================================================================
+
+void test_empty_findReturnsMinusOne(void) {
+    BssidIndex<16> idx;
+    uint8_t b[6] = {1, 2, 3, 4, 5, 6};
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(b));
+    TEST_ASSERT_EQUAL_UINT16(0, idx.size());
+}
+
+void test_insert_thenFind(void) {
+    BssidIndex<16> idx;
+    uint8_t b[6] = {0x64, 0xEE, 0xB7, 0x20, 0x82, 0x86};
+    TEST_ASSERT_TRUE(idx.insert(b, 7));
+    TEST_ASSERT_EQUAL_INT(7, idx.find(b));
+    TEST_ASSERT_EQUAL_UINT16(1, idx.size());
+}
+
+void test_insert_existingOverwritesSlot(void) {
+    BssidIndex<16> idx;
+    uint8_t b[6] = {0x64, 0xEE, 0xB7, 0x20, 0x82, 0x86};
+    idx.insert(b, 3);
+    idx.insert(b, 9);
+    TEST_ASSERT_EQUAL_INT(9, idx.find(b));
+    TEST_ASSERT_EQUAL_UINT16(1, idx.size());
+}
+
+void test_insert_rejectsEmptySentinelSlot(void) {
+    BssidIndex<16> idx;
+    uint8_t b[6] = {1, 1, 1, 1, 1, 1};
+    TEST_ASSERT_FALSE(idx.insert(b, BssidIndex<16>::kEmpty));
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(b));
+}
+
+void test_erase_removesEntry(void) {
+    BssidIndex<16> idx;
+    uint8_t b[6] = {0xA4, 0x2B, 0xB0, 0x01, 0x02, 0x03};
+    idx.insert(b, 0);
+    TEST_ASSERT_TRUE(idx.erase(b));
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(b));
+    TEST_ASSERT_EQUAL_UINT16(0, idx.size());
+}
+
+void test_erase_missingReturnsFalse(void) {
+    BssidIndex<16> idx;
+    uint8_t b[6] = {0xA4, 0x2B, 0xB0, 0x01, 0x02, 0x03};
+    TEST_ASSERT_FALSE(idx.erase(b));
+}
+
+void test_clear_dropsEverything(void) {
+    BssidIndex<64> idx;
+    std::vector<FakeNetwork> nets = makeUniqueNetworks(40);
+    for (size_t i = 0; i < nets.size(); i++) idx.insert(nets[i].bssid, (uint16_t)i);
+    idx.clear();
+    TEST_ASSERT_EQUAL_UINT16(0, idx.size());
+    for (size_t i = 0; i < nets.size(); i++) {
+        TEST_ASSERT_EQUAL_INT(-1, idx.find(nets[i].bssid));
+    }
+}
+
+void test_full_refusesInsertButKeepsLookups(void) {
+    BssidIndex<8> idx;
+    std::vector<FakeNetwork> nets = makeUniqueNetworks(8);
+    for (uint16_t i = 0; i < 7; i++) {
+        TEST_ASSERT_TRUE(idx.insert(nets[i].bssid, i));
+    }
+    TEST_ASSERT_FALSE(idx.insert(nets[7].bssid, 7));
+    TEST_ASSERT_EQUAL_UINT16(7, idx.size());
+    // Missing-key probe must still terminate on a full table
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(nets[7].bssid));
+    for (uint16_t i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL_INT(i, idx.find(nets[i].bssid));
+    }
+}
+
+// ============================================================================
+// Collision / Deletion Correctness
+// ============================================================================
+
+void test_randomChurn_matchesReferenceMap(void) {
+    // Small table, heavy churn: exercises wraparound and backward-shift
+    BssidIndex<64> idx;
+    std::map<uint64_t, uint16_t> ref;
+    std::vector<FakeNetwork> pool = makeUniqueNetworks(80);
+
+    for (int step = 0; step < 20000; step++) {
+        const FakeNetwork& n = pool[nextRand() % pool.size()];
+        uint64_t k = keyOf(n.bssid);
+        uint32_t op = nextRand() % 3;
+        if (op == 0 && ref.size() < 48) {
+            uint16_t slot = (uint16_t)(nextRand() % 1000);
+            TEST_ASSERT_TRUE(idx.insert(n.bssid, slot));
+            ref[k] = slot;
+        } else if (op == 1) {
+            bool had = ref.erase(k) > 0;
+            TEST_ASSERT_EQUAL(had, idx.erase(n.bssid));
+        } else {
+            auto it = ref.find(k);
+            int expected = (it == ref.end()) ? -1 : it->second;
+            TEST_ASSERT_EQUAL_INT(expected, idx.find(n.bssid));
+        }
+        TEST_ASSERT_EQUAL_UINT16(ref.size(), idx.size());
+    }
+
+    for (const FakeNetwork& n : pool) {
+        auto it = ref.find(keyOf(n.bssid));
+        int expected = (it == ref.end()) ? -1 : it->second;
+        TEST_ASSERT_EQUAL_INT(expected, idx.find(n.bssid));
+    }
+}
+
+void test_sameOuiSequentialNics_allFindable(void) {
+    // Multi-BSSID APs advertise consecutive MACs - worst case for weak hashes
+    BssidIndex<512> idx;
+    uint8_t b[6] = {0x64, 0xEE, 0xB7, 0x20, 0x82, 0x00};
+    for (uint16_t i = 0; i < 200; i++) {
+        b[4] = (uint8_t)(0x82 + (i >> 8));
+        b[5] = (uint8_t)i;
+        TEST_ASSERT_TRUE(idx.insert(b, i));
+    }
+    for (uint16_t i = 0; i < 200; i++) {
+        b[4] = (uint8_t)(0x82 + (i >> 8));
+        b[5] = (uint8_t)i;
+        TEST_ASSERT_EQUAL_INT(i, idx.find(b));
+    }
+}
+
+// ============================================================================
+// Rebuild (used after vector erase / external sort)
+// ============================================================================
+
+void test_rebuild_mapsPositions(void) {
+    BssidIndex<512> idx;
+    std::vector<FakeNetwork> nets = makeUniqueNetworks(200);
+    idx.rebuild(nets);
+    TEST_ASSERT_EQUAL_UINT16(200, idx.size());
+    for (size_t i = 0; i < nets.size(); i++) {
+        TEST_ASSERT_EQUAL_INT((int)i, idx.find(nets[i].bssid));
+    }
+}
+
+void test_rebuild_duplicateFirstWins(void) {
+    BssidIndex<16> idx;
+    std::vector<FakeNetwork> nets = makeUniqueNetworks(3);
+    nets.push_back(nets[1]);
+    idx.rebuild(nets);
+    TEST_ASSERT_EQUAL_UINT16(3, idx.size());
+    TEST_ASSERT_EQUAL_INT(1, idx.find(nets[1].bssid));
+}
+
+void test_rebuild_afterEraseTracksShiftedSlots(void) {
+    // Mirrors cleanupStaleNetworks(): erase from the middle, then rebuild
+    BssidIndex<512> idx;
+    std::vector<FakeNetwork> nets = makeUniqueNetworks(200);
+    idx.rebuild(nets);
+    FakeNetwork gone = nets[50];
+    nets.erase(nets.begin() + 120);
+    nets.erase(nets.begin() + 50);
+    idx.rebuild(nets);
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(gone.bssid));
+    for (size_t i = 0; i < nets.size(); i++) {
+        TEST_ASSERT_EQUAL_INT((int)i, idx.find(nets[i].bssid));
+    }
+}
+
+void test_evictReplace_keepsIndexInSync(void) {
+    // Mirrors processDeferredEvents() eviction: overwrite slot in place
+    BssidIndex<512> idx;
+    std::vector<FakeNetwork> nets = makeUniqueNetworks(201);
+    FakeNetwork incoming = nets.back();
+    nets.pop_back();
+    idx.rebuild(nets);
+
+    FakeNetwork evicted = nets[77];
+    idx.erase(nets[77].bssid);
+    nets[77] = incoming;
+    idx.insert(incoming.bssid, 77);
+
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(evicted.bssid));
+    for (size_t i = 0; i < nets.size(); i++) {
+        TEST_ASSERT_EQUAL_INT(linearFind(nets, nets[i].bssid), idx.find(nets[i].bssid));
+    }
+}
+
+// Mirrors NetworkRecon removeSlot(): last record moves into the hole
+template <typename Net, uint16_t kBuckets>
+static void swapRemove(std::vector<Net>& nets, BssidIndex<kBuckets>& idx, size_t slot) {
+    size_t last = nets.size() - 1;
+    idx.erase(nets[slot].bssid);
+    if (slot != last) {
+        nets[slot] = nets[last];
+        idx.insert(nets[slot].bssid, (uint16_t)slot);
+    }
+    nets.pop_back();
+}
+
+void test_swapRemove_keepsIndexInSync(void) {
+    // Mirrors cleanupStaleNetworks(): walk backwards, swap-remove every 3rd
+    BssidIndex<512> idx;
+    std::vector<FakeNetwork> nets = makeUniqueNetworks(200);
+    std::vector<FakeNetwork> removed;
+    idx.rebuild(nets);
+    for (int i = (int)nets.size() - 1; i >= 0; i--) {
+        if ((nets[i].bssid[5] % 3) == 0) {
+            removed.push_back(nets[i]);
+            swapRemove(nets, idx, (size_t)i);
+        }
+    }
+    TEST_ASSERT_TRUE(!removed.empty());
+    TEST_ASSERT_EQUAL_UINT16(nets.size(), idx.size());
+    for (const FakeNetwork& gone : removed) {
+        TEST_ASSERT_EQUAL_INT(-1, idx.find(gone.bssid));
+    }
+    for (size_t i = 0; i < nets.size(); i++) {
+        TEST_ASSERT_EQUAL_INT((int)i, idx.find(nets[i].bssid));
+        TEST_ASSERT_TRUE((nets[i].bssid[5] % 3) != 0);
+    }
+}
+
+// ============================================================================
+// Benchmark: linear scan vs index at 50 / 200 / 1000 entries
+// Half hits, half misses (data frames to unknown BSSIDs are common).
+// Reported, not asserted - timing on CI runners is too noisy.
+// ============================================================================
+
+template <uint16_t kBuckets>
+static void runLookupBenchmark(size_t n) {
+    std::vector<FakeNetwork> all = makeUniqueNetworks(n * 2);
+    std::vector<FakeNetwork> nets(all.begin(), all.begin() + n);
+    static BssidIndex<kBuckets> idx;
+    idx.rebuild(nets);
+
+    const int kRounds = 200;
+    volatile long sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRounds; r++) {
+        for (const FakeNetwork& q : all) sink += linearFind(nets, q.bssid);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    long linearSum = sink;
+    sink = 0;
+    for (int r = 0; r < kRounds; r++) {
+        for (const FakeNetwork& q : all) sink += idx.find(q.bssid);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    TEST_ASSERT_TRUE(linearSum == (long)sink);
+
+    double lookups = (double)kRounds * all.size();
+    double linNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / lookups;
+    double idxNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / lookups;
+    char msg[128];
+    snprintf(msg, sizeof(msg), "n=%4zu buckets=%4u  linear=%7.1f ns  index=%5.1f ns  (%.0fx)",
+             n, (unsigned)kBuckets, linNs, idxNs, idxNs > 0 ? linNs / idxNs : 0.0);
+    TEST_MESSAGE(msg);
+}
+
+void test_benchmark_lookup_50(void) { runLookupBenchmark<512>(50); }
+void test_benchmark_lookup_200(void) { runLookupBenchmark<512>(200); }
+void test_benchmark_lookup_1000(void) { runLookupBenchmark<2048>(1000); }
+
+// Cleanup pass at 200 DetectedNetwork-sized records with 50 stale:
+// erase() + full rebuild (old) vs swap-remove (new)
+struct FatNetwork {
+    uint8_t bssid[6];
+    uint8_t rest[90];
+};
+
+void test_benchmark_cleanup_eraseVsSwap(void) {
+    std::vector<FakeNetwork> keys = makeUniqueNetworks(200);
+    std::vector<FatNetwork> base(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        memset(&base[i], 0, sizeof(FatNetwork));
+        memcpy(base[i].bssid, keys[i].bssid, 6);
+    }
+    std::vector<size_t> stale;
+    for (size_t i = 0; i < base.size(); i += 4) stale.push_back(i);
+
+    static BssidIndex<512> idx;
+    const int kRounds = 2000;
+    double eraseNs = 0;
+    double swapNs = 0;
+    for (int r = 0; r < kRounds; r++) {
+        std::vector<FatNetwork> nets = base;
+        idx.rebuild(nets);
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = (int)stale.size() - 1; i >= 0; i--) {
+            nets.erase(nets.begin() + stale[i]);
+        }
+        idx.rebuild(nets);
+        auto t1 = std::chrono::steady_clock::now();
+        eraseNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+        nets = base;
+        idx.rebuild(nets);
+        auto t2 = std::chrono::steady_clock::now();
+        for (int i = (int)stale.size() - 1; i >= 0; i--) {
+            swapRemove(nets, idx, stale[i]);
+        }
+        auto t3 = std::chrono::steady_clock::now();
+        swapNs += std::chrono::duration<double, std::nano>(t3 - t2).count();
+        TEST_ASSERT_EQUAL_UINT16(150, idx.size());
+    }
+    char msg[128];
+    snprintf(msg, sizeof(msg), "cleanup 200 nets / 50 stale: erase+rebuild=%6.0f ns  swap-remove=%6.0f ns  (%.1fx)",
+             eraseNs / kRounds, swapNs / kRounds, swapNs > 0 ? eraseNs / swapNs : 0.0);
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Basic operations
+    RUN_TEST(test_empty_findReturnsMinusOne);
+    RUN_TEST(test_insert_thenFind);
+    RUN_TEST(test_insert_existingOverwritesSlot);
+    RUN_TEST(test_insert_rejectsEmptySentinelSlot);
+    RUN_TEST(test_erase_removesEntry);
+    RUN_TEST(test_erase_missingReturnsFalse);
+    RUN_TEST(test_clear_dropsEverything);
+    RUN_TEST(test_full_refusesInsertButKeepsLookups);
+
+    // Collision / deletion correctness
+    RUN_TEST(test_randomChurn_matchesReferenceMap);
+    RUN_TEST(test_sameOuiSequentialNics_allFindable);
+
+    // Rebuild
+    RUN_TEST(test_rebuild_mapsPositions);
+    RUN_TEST(test_rebuild_duplicateFirstWins);
+    RUN_TEST(test_rebuild_afterEraseTracksShiftedSlots);
+    RUN_TEST(test_evictReplace_keepsIndexInSync);
+    RUN_TEST(test_swapRemove_keepsIndexInSync);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_lookup_50);
+    RUN_TEST(test_benchmark_lookup_200);
+    RUN_TEST(test_benchmark_lookup_1000);
+    RUN_TEST(test_benchmark_cleanup_eraseVsSwap);
+
+    return UNITY_END();
+}
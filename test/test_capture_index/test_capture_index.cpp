@@ -0,0 +1,250 @@
+// Capture Index Tests
+// Tests the (AP, station) hash index used by OINK and DO NO HAM for
+// handshake/PMKID lookup: agreement with the old linear scan, AP-only keys,
+// capacity limits, and lookup cost against the linear scan.
+
+#include <unity.h>
+#include <cstdio>
+#include <vector>
+#include <chrono>
+#include "../../src/core/capture_index.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+struct Entry {
+    uint8_t bssid[6];
+    uint8_t station[6];
+};
+
+static uint32_t rngState = 0xA5A5F00Du;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Realistic-ish MACs: a handful of shared OUIs, random NIC bytes
+static void randomMac(uint8_t* mac) {
+    static const uint8_t ouis[4][3] = {
+        {0x00, 0x1A, 0x2B}, {0xDC, 0xA6, 0x32}, {0x3C, 0x22, 0xFB}, {0xF4, 0xF5, 0xD8}
+    };
+    const uint8_t* oui = ouis[nextRand() % 4];
+    mac[0] = oui[0]; mac[1] = oui[1]; mac[2] = oui[2];
+    uint32_t r = nextRand();
+    mac[3] = (uint8_t)r; mac[4] = (uint8_t)(r >> 8); mac[5] = (uint8_t)(r >> 16);
+}
+
+static Entry makeEntry() {
+    Entry e;
+    randomMac(e.bssid);
+    randomMac(e.station);
+    return e;
+}
+
+// The lookup being replaced: double memcmp over every entry
+static int linearFind(const std::vector<Entry>& items, const uint8_t* bssid, const uint8_t* station) {
+    for (int i = 0; i < (int)items.size(); i++) {
+        if (memcmp(items[i].bssid, bssid, 6) == 0 &&
+            (!station || memcmp(items[i].station, station, 6) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void add(CaptureIndex<128>& idx, std::vector<Entry>& items, const Entry& e) {
+    items.push_back(e);
+    TEST_ASSERT_TRUE(idx.insert(e.bssid, e.station, (uint16_t)(items.size() - 1)));
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+void test_find_empty(void) {
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    Entry e = makeEntry();
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(items, e.bssid, e.station));
+    TEST_ASSERT_EQUAL_UINT16(0, idx.size());
+}
+
+void test_insert_thenFind(void) {
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    for (int i = 0; i < 50; i++) add(idx, items, makeEntry());
+    for (int i = 0; i < 50; i++) {
+        TEST_ASSERT_EQUAL_INT(i, idx.find(items, items[i].bssid, items[i].station));
+    }
+    TEST_ASSERT_EQUAL_UINT16(50, idx.size());
+}
+
+void test_sameAp_differentStations(void) {
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    Entry a = makeEntry();
+    Entry b = a;
+    b.station[5] ^= 0x01;
+    add(idx, items, a);
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(items, b.bssid, b.station));
+    add(idx, items, b);
+    TEST_ASSERT_EQUAL_INT(0, idx.find(items, a.bssid, a.station));
+    TEST_ASSERT_EQUAL_INT(1, idx.find(items, b.bssid, b.station));
+}
+
+void test_apOnly_keys(void) {
+    // DO NO HAM PMKIDs: keyed on BSSID, station rewritten after insert
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    Entry e = makeEntry();
+    items.push_back(e);
+    TEST_ASSERT_TRUE(idx.insert(e.bssid, nullptr, 0));
+    randomMac(items[0].station);
+    TEST_ASSERT_EQUAL_INT(0, idx.find(items, e.bssid, nullptr));
+}
+
+void test_hashCollision_confirmedAgainstItems(void) {
+    // Tiny table: every probe chain is long and hashes collide often
+    CaptureIndex<8> idx;
+    std::vector<Entry> items;
+    for (int i = 0; i < 7; i++) {
+        items.push_back(makeEntry());
+        TEST_ASSERT_TRUE(idx.insert(items[i].bssid, items[i].station, (uint16_t)i));
+    }
+    for (int i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL_INT(i, idx.find(items, items[i].bssid, items[i].station));
+    }
+    for (int i = 0; i < 200; i++) {
+        Entry miss = makeEntry();
+        TEST_ASSERT_EQUAL_INT(-1, idx.find(items, miss.bssid, miss.station));
+    }
+}
+
+void test_staleSlot_ignored(void) {
+    // An entry pointing past the container (e.g. mid-clear) is never returned
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    Entry e = makeEntry();
+    TEST_ASSERT_TRUE(idx.insert(e.bssid, e.station, 3));
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(items, e.bssid, e.station));
+}
+
+// ============================================================================
+// Capacity / rebuild
+// ============================================================================
+
+void test_full_rejectsInsert(void) {
+    CaptureIndex<8> idx;
+    std::vector<Entry> items;
+    for (int i = 0; i < CaptureIndex<8>::kMaxEntries; i++) {
+        items.push_back(makeEntry());
+        TEST_ASSERT_TRUE(idx.insert(items[i].bssid, items[i].station, (uint16_t)i));
+    }
+    Entry extra = makeEntry();
+    TEST_ASSERT_FALSE(idx.insert(extra.bssid, extra.station, 7));
+    TEST_ASSERT_EQUAL_UINT16(7, idx.size());
+    idx.clear();
+    TEST_ASSERT_EQUAL_UINT16(0, idx.size());
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(items, items[0].bssid, items[0].station));
+}
+
+void test_rebuild_firstOccurrenceWins(void) {
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    for (int i = 0; i < 20; i++) items.push_back(makeEntry());
+    items.push_back(items[4]);  // Duplicate pair at slot 20
+    idx.rebuild(items);
+    TEST_ASSERT_EQUAL_UINT16(20, idx.size());
+    TEST_ASSERT_EQUAL_INT(4, idx.find(items, items[4].bssid, items[4].station));
+
+    // AP-only rebuild: same BSSID, different station collapses to first
+    items[7].station[0] ^= 0xFF;
+    memcpy(items[8].bssid, items[7].bssid, 6);
+    idx.rebuild(items, true);
+    TEST_ASSERT_EQUAL_INT(7, idx.find(items, items[8].bssid, nullptr));
+}
+
+void test_randomized_matchesLinearScan(void) {
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    for (int i = 0; i < CaptureIndex<128>::kMaxEntries; i++) {
+        Entry e = makeEntry();
+        if (linearFind(items, e.bssid, e.station) >= 0) continue;
+        add(idx, items, e);
+    }
+    for (int q = 0; q < 20000; q++) {
+        Entry probe = (nextRand() & 1) ? items[nextRand() % items.size()] : makeEntry();
+        TEST_ASSERT_EQUAL_INT(linearFind(items, probe.bssid, probe.station),
+                              idx.find(items, probe.bssid, probe.station));
+    }
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+static void benchAt(int entries) {
+    CaptureIndex<128> idx;
+    std::vector<Entry> items;
+    while ((int)items.size() < entries) add(idx, items, makeEntry());
+
+    // Mostly hits (EAPOL for a known pair), some misses (first frame)
+    std::vector<Entry> probes(1024);
+    for (auto& p : probes) p = (nextRand() % 4) ? items[nextRand() % items.size()] : makeEntry();
+
+    const int n = 400000;
+    volatile int sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        const Entry& p = probes[i & 1023];
+        sink = sink + linearFind(items, p.bssid, p.station);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        const Entry& p = probes[i & 1023];
+        sink = sink + idx.find(items, p.bssid, p.station);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double linNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    double idxNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / n;
+    char msg[112];
+    snprintf(msg, sizeof(msg), "%3d entries: linear %.1f ns, index %.1f ns per lookup (host)",
+             entries, linNs, idxNs);
+    TEST_MESSAGE(msg);
+}
+
+void test_bench_vsLinearScan(void) {
+    benchAt(25);
+    benchAt(50);
+    benchAt(127);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Lookup
+    RUN_TEST(test_find_empty);
+    RUN_TEST(test_insert_thenFind);
+    RUN_TEST(test_sameAp_differentStations);
+    RUN_TEST(test_apOnly_keys);
+    RUN_TEST(test_hashCollision_confirmedAgainstItems);
+    RUN_TEST(test_staleSlot_ignored);
+
+    // Capacity / rebuild
+    RUN_TEST(test_full_rejectsInsert);
+    RUN_TEST(test_rebuild_firstOccurrenceWins);
+    RUN_TEST(test_randomized_matchesLinearScan);
+
+    // Benchmark
+    RUN_TEST(test_bench_vsLinearScan);
+
+    return UNITY_END();
+}
@@ -0,0 +1,510 @@
+// Capture Journal Tests
+// Tests the on-SD journal format used by OINK's session capture journal:
+// CRC-32 against known vectors, record framing round trips, and the
+// shipped JournalFormat::Appender / walkRecords() / readPayload() run over
+// an in-memory store - the header slot zeroed before each payload, the
+// bounded zero-fill inside an append, the walk stopping at the first
+// invalid header, and Corrupt vs IoError when a payload is read back.
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../../src/core/crc32.h"
+#include "../../src/core/capture_journal_format.h"
+
+using namespace JournalFormat;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Positional store with the same contract as CaptureJournal's FileStore
+struct MemStore {
+    std::vector<uint8_t> bytes;
+    uint32_t failWriteAt = UINT32_MAX;   // Next write starting here fails
+    uint32_t zeroBytes = 0;
+    bool gap = false;                    // A write started past EOF
+
+    bool write(uint32_t off, const uint8_t* data, size_t len) {
+        if (off == failWriteAt) {
+            failWriteAt = UINT32_MAX;
+            return false;
+        }
+        if (off > bytes.size()) gap = true;
+        if (bytes.size() < off + len) bytes.resize(off + len, 0);
+        memcpy(&bytes[off], data, len);
+        return true;
+    }
+
+    bool zero(uint32_t off, uint32_t len) {
+        std::vector<uint8_t> z(len, 0);
+        zeroBytes += len;
+        return write(off, z.data(), len);
+    }
+};
+
+static const uint8_t STATION[6] = {0x02, 0, 0, 0, 0, 0x01};
+
+struct MemJournal {
+    MemStore store;
+    Appender<MemStore> app;
+
+    explicit MemJournal(uint32_t reserveBytes = 4096) : app(store) {
+        FileHeader fh = makeFileHeader(7);
+        store.write(0, (const uint8_t*)&fh, sizeof(fh));
+        app.reset(sizeof(fh));
+        app.reserve(reserveBytes);
+    }
+
+    // commitHeader=false simulates power loss after the payload write
+    bool append(RecordType type, const uint8_t* bssid, const char* ssid,
+                const std::string& payload, bool commitHeader = true) {
+        if (!app.begin()) return false;
+        if (!app.payload((const uint8_t*)payload.data(), payload.size())) return false;
+        if (!commitHeader) return true;
+        return app.commit(type, bssid, STATION, ssid, 1234);
+    }
+};
+
+struct Scanned {
+    RecordHeader hdr;
+    uint32_t offset;
+};
+
+static bool readMem(const std::vector<uint8_t>& bytes, uint32_t off, void* dst, size_t len) {
+    if ((uint64_t)off + len > bytes.size()) return false;
+    memcpy(dst, &bytes[off], len);
+    return true;
+}
+
+static Walk walk(const std::vector<uint8_t>& bytes, std::vector<Scanned>& out) {
+    out.clear();
+    return walkRecords((uint32_t)bytes.size(),
+                       [&bytes](uint32_t off, void* dst, size_t len) { return readMem(bytes, off, dst, len); },
+                       [&out](const RecordHeader& h, uint32_t off) {
+                           out.push_back({h, off});
+                           return true;
+                       });
+}
+
+// Small buffer so payloads span several read chunks
+static Payload payloadOf(const std::vector<uint8_t>& bytes, const Scanned& rec, std::string& out) {
+    uint8_t buf[64];
+    out.clear();
+    return readPayload(rec.hdr, rec.offset, buf, sizeof(buf),
+                       [&bytes](uint32_t off, void* dst, size_t len) { return readMem(bytes, off, dst, len); },
+                       [&out](const uint8_t* data, size_t len) {
+                           out.append((const char*)data, len);
+                           return true;
+                       });
+}
+
+static const uint8_t BSSID_A[6] = {0xDC, 0xA6, 0x32, 0x11, 0x22, 0x33};
+static const uint8_t BSSID_B[6] = {0x3C, 0x22, 0xFB, 0x44, 0x55, 0x66};
+
+// ============================================================================
+// CRC-32
+// ============================================================================
+
+void test_crc32_knownVectors(void) {
+    TEST_ASSERT_EQUAL_HEX32(0x00000000u, Crc32::compute(nullptr, 0));
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926u, Crc32::compute((const uint8_t*)"123456789", 9));
+    const char* fox = "The quick brown fox jumps over the lazy dog";
+    TEST_ASSERT_EQUAL_HEX32(0x414FA339u, Crc32::compute((const uint8_t*)fox, strlen(fox)));
+}
+
+void test_crc32_chainedMatchesOneShot(void) {
+    uint8_t buf[1000];
+    for (int i = 0; i < 1000; i++) buf[i] = (uint8_t)(i * 31 + 7);
+    uint32_t whole = Crc32::compute(buf, sizeof(buf));
+    uint32_t chained = 0;
+    size_t splits[] = {1, 63, 64, 372, 500};
+    size_t pos = 0;
+    for (size_t n : splits) {
+        chained = Crc32::update(chained, buf + pos, n);
+        pos += n;
+    }
+    TEST_ASSERT_EQUAL_UINT32(sizeof(buf), pos);
+    TEST_ASSERT_EQUAL_HEX32(whole, chained);
+}
+
+// ============================================================================
+// Framing
+// ============================================================================
+
+void test_roundtrip_records(void) {
+    MemJournal j;
+    std::string pcap(700, '\0');
+    for (size_t i = 0; i < pcap.size(); i++) pcap[i] = (char)(i * 13);
+    std::string hash = "WPA*02*00112233*dca632112233*020000000001*6c6f6c***00\n";
+    TEST_ASSERT_TRUE(j.append(RecordType::HandshakePcap, BSSID_A, "PorkNet", pcap));
+    TEST_ASSERT_TRUE(j.append(RecordType::Handshake22000, BSSID_A, "PorkNet", hash));
+    TEST_ASSERT_TRUE(j.append(RecordType::Pmkid22000, BSSID_B, "", "WPA*01*ab*cd*ef*00***01\n"));
+
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(3, recs.size());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(FileHeader), recs[0].offset);
+    TEST_ASSERT_EQUAL_UINT32(nextOffset(recs[0].hdr, recs[0].offset), recs[1].offset);
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)RecordType::HandshakePcap, recs[0].hdr.type);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(STATION, recs[0].hdr.station, 6);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(BSSID_B, recs[2].hdr.bssid, 6);
+
+    std::string body;
+    TEST_ASSERT_EQUAL_INT((int)Payload::Ok, (int)payloadOf(j.store.bytes, recs[0], body));
+    TEST_ASSERT_TRUE(body == pcap);
+    TEST_ASSERT_EQUAL_INT((int)Payload::Ok, (int)payloadOf(j.store.bytes, recs[1], body));
+    TEST_ASSERT_TRUE(body == hash);
+
+    char ssid[kMaxSsidLen + 1];
+    copySsid(recs[0].hdr, ssid);
+    TEST_ASSERT_EQUAL_STRING("PorkNet", ssid);
+    copySsid(recs[2].hdr, ssid);
+    TEST_ASSERT_EQUAL_STRING("", ssid);
+}
+
+void test_ssid_truncatedTo32(void) {
+    const char* longSsid = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    RecordHeader h = makeRecordHeader(RecordType::Pmkid22000, BSSID_A, nullptr,
+                                      longSsid, 10, 0, 0);
+    TEST_ASSERT_EQUAL_UINT8(32, h.ssidLen);
+    char ssid[kMaxSsidLen + 1];
+    copySsid(h, ssid);
+    TEST_ASSERT_EQUAL_INT(0, strncmp(ssid, longSsid, 32));
+    TEST_ASSERT_EQUAL_INT(32, (int)strlen(ssid));
+}
+
+void test_suffixMapping(void) {
+    TEST_ASSERT_EQUAL_STRING(".pcap", suffixFor(RecordType::HandshakePcap));
+    TEST_ASSERT_EQUAL_STRING("_hs.22000", suffixFor(RecordType::Handshake22000));
+    TEST_ASSERT_EQUAL_STRING(".22000", suffixFor(RecordType::Pmkid22000));
+    TEST_ASSERT_NULL(suffixFor(RecordType::None));
+}
+
+// ============================================================================
+// Appending
+// ============================================================================
+
+void test_append_withinReserve_noInlineZeroing(void) {
+    MemJournal j(4096);
+    uint32_t zeroed = j.app.zeroedTo();
+    TEST_ASSERT_TRUE(j.append(RecordType::HandshakePcap, BSSID_A, "A", std::string(1100, 'p')));
+    TEST_ASSERT_TRUE(j.append(RecordType::Handshake22000, BSSID_A, "A", std::string(560, 'h')));
+
+    // Everything fit in the reserve: the appends zeroed nothing themselves
+    TEST_ASSERT_EQUAL_UINT32(0, j.app.getInlineZeroBytes());
+    TEST_ASSERT_EQUAL_UINT32(zeroed, j.app.zeroedTo());
+    TEST_ASSERT_EQUAL_UINT32(zeroed - j.app.position(), j.app.headroom());
+    TEST_ASSERT_FALSE(j.store.gap);
+}
+
+void test_append_pastReserve_zeroesOneSlot(void) {
+    // Only the first header slot is zeroed up front (what open() does)
+    MemJournal j(sizeof(RecordHeader));
+    TEST_ASSERT_TRUE(j.append(RecordType::HandshakePcap, BSSID_A, "A", std::string(1100, 'p')));
+
+    // The payload ran past the zeroed region: zeroedEnd is bumped to the
+    // payload end and only the next header slot is zeroed before commit
+    TEST_ASSERT_EQUAL_UINT32(sizeof(RecordHeader), j.app.getInlineZeroBytes());
+    TEST_ASSERT_EQUAL_UINT32(j.app.position() + sizeof(RecordHeader), j.app.zeroedTo());
+    TEST_ASSERT_EQUAL_UINT32(j.app.zeroedTo(), j.store.bytes.size());
+
+    // Each further append stays bounded by one slot, whatever its size
+    uint32_t before = j.app.getInlineZeroBytes();
+    TEST_ASSERT_TRUE(j.append(RecordType::HandshakePcap, BSSID_B, "B", std::string(9000, 'q')));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(RecordHeader), j.app.getInlineZeroBytes() - before);
+    TEST_ASSERT_FALSE(j.store.gap);
+
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(2, recs.size());
+}
+
+void test_reserve_growsHeadroom(void) {
+    MemJournal j(sizeof(RecordHeader));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(RecordHeader), j.app.headroom());
+    TEST_ASSERT_TRUE(j.app.reserve(8192));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(RecordHeader) + 8192, j.app.headroom());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(RecordHeader) + 8192, j.app.getReservedBytes());
+
+    // Never under an open record: its payload lives in that region
+    TEST_ASSERT_TRUE(j.app.begin());
+    TEST_ASSERT_FALSE(j.app.reserve(8192));
+    TEST_ASSERT_TRUE(j.app.payload((const uint8_t*)"x\n", 2));
+    TEST_ASSERT_TRUE(j.app.commit(RecordType::Pmkid22000, BSSID_A, nullptr, "A", 0));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(RecordHeader) + 8192 - sizeof(RecordHeader) - 2,
+                             j.app.headroom());
+}
+
+void test_commit_rejectsEmptyAndOversize(void) {
+    MemJournal j;
+    TEST_ASSERT_TRUE(j.app.begin());
+    TEST_ASSERT_FALSE(j.app.commit(RecordType::Pmkid22000, BSSID_A, nullptr, "A", 0));
+
+    std::string big(kMaxPayloadBytes + 1, 'z');
+    TEST_ASSERT_FALSE(j.append(RecordType::HandshakePcap, BSSID_A, "A", big));
+    TEST_ASSERT_FALSE(j.app.commit(RecordType::HandshakePcap, BSSID_A, nullptr, "A", 0));
+
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(0, recs.size());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(FileHeader), j.app.position());
+}
+
+// ============================================================================
+// Recovery
+// ============================================================================
+
+void test_walk_stopsAtZeroTail(void) {
+    MemJournal j;
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(0, recs.size());
+
+    j.append(RecordType::Pmkid22000, BSSID_A, "A", "line\n");
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(1, recs.size());
+}
+
+void test_tornAppend_notVisible(void) {
+    MemJournal j;
+    j.append(RecordType::HandshakePcap, BSSID_A, "A", std::string(300, 'x'));
+    j.append(RecordType::HandshakePcap, BSSID_B, "B", std::string(300, 'y'), false);
+
+    // Power lost before the header: the slot begin() zeroed ends the walk
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(1, recs.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(BSSID_A, recs[0].hdr.bssid, 6);
+}
+
+void test_abortedAppend_staleBytesNeverReachable(void) {
+    MemJournal j(4096);
+
+    // A writer that gives up part-way leaves its payload inside the reserved
+    // region. Plant a valid-looking header in it, right where a shorter
+    // record's next slot will land.
+    const std::string shortBody = "ok\n";
+    std::string stale(600, 's');
+    RecordHeader fake = makeRecordHeader(RecordType::Pmkid22000, BSSID_B, nullptr, "F", 8,
+                                         Crc32::compute((const uint8_t*)"fakefake", 8), 0);
+    memcpy(&stale[shortBody.size()], &fake, sizeof(fake));
+    memcpy(&stale[shortBody.size() + sizeof(fake)], "fakefake", 8);
+    TEST_ASSERT_TRUE(j.app.begin());
+    TEST_ASSERT_TRUE(j.app.payload((const uint8_t*)stale.data(), stale.size()));
+    j.app.abort();
+
+    // The retry reuses the slot and must zero its next slot over the stale bytes
+    TEST_ASSERT_TRUE(j.append(RecordType::Pmkid22000, BSSID_A, "A", shortBody));
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(1, recs.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(BSSID_A, recs[0].hdr.bssid, 6);
+}
+
+void test_failedHeaderWrite_leavesSlotZero(void) {
+    MemJournal j;
+    j.append(RecordType::Pmkid22000, BSSID_A, "A", "first\n");
+    uint32_t slot = j.app.position();
+    j.store.failWriteAt = slot;
+    TEST_ASSERT_FALSE(j.append(RecordType::HandshakePcap, BSSID_B, "B", std::string(400, 'b')));
+    TEST_ASSERT_EQUAL_UINT32(slot, j.app.position());
+
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(1, recs.size());
+
+    // The next record takes the same slot
+    TEST_ASSERT_TRUE(j.append(RecordType::Pmkid22000, BSSID_B, "B", "second\n"));
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(2, recs.size());
+    TEST_ASSERT_EQUAL_UINT32(slot, recs[1].offset);
+}
+
+void test_walk_stopsAtFirstInvalidHeader(void) {
+    MemJournal j;
+    j.append(RecordType::Pmkid22000, BSSID_A, "A", "one\n");
+    j.append(RecordType::Pmkid22000, BSSID_A, "A", "two\n");
+    j.append(RecordType::Pmkid22000, BSSID_B, "B", "three\n");
+    std::vector<Scanned> recs;
+    walk(j.store.bytes, recs);
+    TEST_ASSERT_EQUAL_UINT32(3, recs.size());
+
+    // Damage the middle header: the third record is valid but unreachable
+    j.store.bytes[recs[1].offset] ^= 0xFF;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(1, recs.size());
+}
+
+void test_walk_fileHeaderAndReadErrors(void) {
+    MemJournal j;
+    j.append(RecordType::Pmkid22000, BSSID_A, "A", "one\n");
+    j.append(RecordType::Pmkid22000, BSSID_B, "B", "two\n");
+
+    std::vector<uint8_t> bad = j.store.bytes;
+    bad[0] ^= 0xFF;                                       // File magic
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::NotJournal, (int)walk(bad, recs));
+    bad.assign(sizeof(FileHeader) - 1, 0);                // Died before its header
+    TEST_ASSERT_EQUAL_INT((int)Walk::NotJournal, (int)walk(bad, recs));
+
+    // I/O failing on the second header is retryable, not the end
+    uint32_t second = nextOffset(makeRecordHeader(RecordType::Pmkid22000, nullptr, nullptr,
+                                                  "", 4, 0, 0), sizeof(FileHeader));
+    const std::vector<uint8_t>& bytes = j.store.bytes;
+    int visited = 0;
+    Walk w = walkRecords((uint32_t)bytes.size(),
+                         [&](uint32_t off, void* dst, size_t len) {
+                             return off != second && readMem(bytes, off, dst, len);
+                         },
+                         [&](const RecordHeader&, uint32_t) { return ++visited > 0; });
+    TEST_ASSERT_EQUAL_INT((int)Walk::ReadError, (int)w);
+    TEST_ASSERT_EQUAL_INT(1, visited);
+
+    // visit() can stop early
+    visited = 0;
+    w = walkRecords((uint32_t)bytes.size(),
+                    [&](uint32_t off, void* dst, size_t len) { return readMem(bytes, off, dst, len); },
+                    [&](const RecordHeader&, uint32_t) { return ++visited < 1; });
+    TEST_ASSERT_EQUAL_INT((int)Walk::Stopped, (int)w);
+    TEST_ASSERT_EQUAL_INT(1, visited);
+}
+
+void test_invalidHeaders_rejected(void) {
+    RecordHeader h = makeRecordHeader(RecordType::Handshake22000, BSSID_A, nullptr,
+                                      "X", 100, 0, 0);
+    TEST_ASSERT_TRUE(isRecord(h, 16, 16 + 64 + 100));
+    TEST_ASSERT_FALSE(isRecord(h, 16, 16 + 64 + 99));    // Payload past EOF
+
+    RecordHeader bad = h;
+    bad.magic ^= 1;
+    TEST_ASSERT_FALSE(isRecord(bad, 16, 4096));
+    bad = h;
+    bad.type = 9;
+    TEST_ASSERT_FALSE(isRecord(bad, 16, 4096));
+    bad = h;
+    bad.ssidLen = 33;
+    TEST_ASSERT_FALSE(isRecord(bad, 16, 4096));
+    bad = h;
+    bad.payloadLen = 0;
+    TEST_ASSERT_FALSE(isRecord(bad, 16, 4096));
+    bad = h;
+    bad.payloadLen = 0xFFFFFFF0u;                        // Offset overflow
+    TEST_ASSERT_FALSE(isRecord(bad, 16, 0xFFFFFFFFu));
+}
+
+void test_payload_corruptVsIoError(void) {
+    MemJournal j;
+    j.append(RecordType::HandshakePcap, BSSID_A, "A", std::string(500, 'p'));
+    j.append(RecordType::Handshake22000, BSSID_A, "A", "hash\n");
+    std::vector<Scanned> recs;
+    walk(j.store.bytes, recs);
+    TEST_ASSERT_EQUAL_UINT32(2, recs.size());
+
+    // A flipped bit is Corrupt for good; later records still read fine
+    j.store.bytes[recs[0].offset + sizeof(RecordHeader) + 250] ^= 0x40;
+    std::string body;
+    TEST_ASSERT_EQUAL_INT((int)Payload::Corrupt, (int)payloadOf(j.store.bytes, recs[0], body));
+    TEST_ASSERT_EQUAL_INT((int)Payload::Ok, (int)payloadOf(j.store.bytes, recs[1], body));
+    TEST_ASSERT_TRUE(body == "hash\n");
+
+    // A failed read or sink is IoError - worth retrying, not condemning
+    uint8_t buf[64];
+    const std::vector<uint8_t>& bytes = j.store.bytes;
+    Payload p = readPayload(recs[1].hdr, recs[1].offset, buf, sizeof(buf),
+                            [](uint32_t, void*, size_t) { return false; },
+                            [](const uint8_t*, size_t) { return true; });
+    TEST_ASSERT_EQUAL_INT((int)Payload::IoError, (int)p);
+    p = readPayload(recs[1].hdr, recs[1].offset, buf, sizeof(buf),
+                    [&bytes](uint32_t off, void* dst, size_t len) { return readMem(bytes, off, dst, len); },
+                    [](const uint8_t*, size_t) { return false; });
+    TEST_ASSERT_EQUAL_INT((int)Payload::IoError, (int)p);
+}
+
+// ============================================================================
+// Write amplification
+// ============================================================================
+
+void test_report_sessionFootprint(void) {
+    // 20 handshakes (PCAP ~1.1KB + 22000 line) and 10 PMKIDs, with reserve()
+    // run between saves the way OinkMode::update() does (32KB low water,
+    // 8KB per call). Consumers read records in place, so this is the whole
+    // SD cost of the session - there is no export step to add.
+    MemJournal j(sizeof(RecordHeader));
+    uint32_t payloadBytes = 0;
+    uint32_t maxInline = 0;
+    auto save = [&](RecordType type, const uint8_t* bssid, size_t len, char fill) {
+        uint32_t before = j.app.getInlineZeroBytes();
+        TEST_ASSERT_TRUE(j.append(type, bssid, "NET", std::string(len, fill)));
+        uint32_t inl = j.app.getInlineZeroBytes() - before;
+        if (inl > maxInline) maxInline = inl;
+        payloadBytes += (uint32_t)len;
+        if (j.app.headroom() < 32768) j.app.reserve(8192);
+    };
+    uint8_t bssid[6] = {0x00, 0x1A, 0x2B, 0, 0, 0};
+    for (int i = 0; i < 20; i++) {
+        bssid[5] = (uint8_t)i;
+        save(RecordType::HandshakePcap, bssid, 1100, 'p');
+        save(RecordType::Handshake22000, bssid, 560, 'h');
+    }
+    for (int i = 0; i < 10; i++) {
+        bssid[4] = 1;
+        bssid[5] = (uint8_t)i;
+        save(RecordType::Pmkid22000, bssid, 140, 'k');
+    }
+    std::vector<Scanned> recs;
+    TEST_ASSERT_EQUAL_INT((int)Walk::End, (int)walk(j.store.bytes, recs));
+    TEST_ASSERT_EQUAL_UINT32(50, recs.size());
+    TEST_ASSERT_TRUE(maxInline <= 2 * sizeof(RecordHeader));
+
+    uint32_t recordBytes = j.app.position();
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "Journal: 1 create, %u bytes (%u headers) + %u zero-fill (max %u inside one save)",
+             (unsigned)recordBytes, (unsigned)(recordBytes - payloadBytes),
+             (unsigned)j.store.zeroBytes, (unsigned)maxInline);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg),
+             "Per-file: 50 creates + 50 dir entries, %u bytes; journal writes %.2fx the bytes",
+             (unsigned)payloadBytes,
+             (double)(recordBytes + j.store.zeroBytes) / payloadBytes);
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // CRC-32
+    RUN_TEST(test_crc32_knownVectors);
+    RUN_TEST(test_crc32_chainedMatchesOneShot);
+
+    // Framing
+    RUN_TEST(test_roundtrip_records);
+    RUN_TEST(test_ssid_truncatedTo32);
+    RUN_TEST(test_suffixMapping);
+
+    // Appending
+    RUN_TEST(test_append_withinReserve_noInlineZeroing);
+    RUN_TEST(test_append_pastReserve_zeroesOneSlot);
+    RUN_TEST(test_reserve_growsHeadroom);
+    RUN_TEST(test_commit_rejectsEmptyAndOversize);
+
+    // Recovery
+    RUN_TEST(test_walk_stopsAtZeroTail);
+    RUN_TEST(test_tornAppend_notVisible);
+    RUN_TEST(test_abortedAppend_staleBytesNeverReachable);
+    RUN_TEST(test_failedHeaderWrite_leavesSlotZero);
+    RUN_TEST(test_walk_stopsAtFirstInvalidHeader);
+    RUN_TEST(test_walk_fileHeaderAndReadErrors);
+    RUN_TEST(test_invalidHeaders_rejected);
+    RUN_TEST(test_payload_corruptVsIoError);
+
+    // Write amplification
+    RUN_TEST(test_report_sessionFootprint);
+
+    return UNITY_END();
+}
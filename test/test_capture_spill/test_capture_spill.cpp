@@ -0,0 +1,368 @@
+// Capture Spill Tests
+// Tests the bookkeeping DO NO HAM uses to flush captures to SD and evict
+// them from RAM: dirty slot masks across swap-removes, capture keys, the
+// fixed-size saved-capture set, a simulated multi-hour session where
+// 2000 captures pass through a 50-slot vector without hitting the cap, and
+// OINK's EAPOL arena reclaim (saved frames released, oldest in-progress
+// capture reclaimed when full) keeping a 16KB arena open for new captures.
+
+#include <unity.h>
+#include <cstdio>
+#include <set>
+#include <vector>
+#include "../../src/core/capture_spill.h"
+#include "../../src/core/eapol_arena.h"
+
+using namespace CaptureSpill;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x1B873593u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+struct FakeCapture {
+    uint8_t bssid[6];
+    uint8_t station[6];
+    uint32_t id;
+};
+
+static FakeCapture makeCapture(uint32_t id) {
+    FakeCapture c;
+    c.bssid[0] = 0x00;
+    c.bssid[1] = 0x1A;
+    c.bssid[2] = (uint8_t)(id >> 16);
+    c.bssid[3] = (uint8_t)(id >> 8);
+    c.bssid[4] = (uint8_t)id;
+    c.bssid[5] = 0x01;
+    c.station[0] = 0x02;
+    c.station[1] = 0x00;
+    c.station[2] = (uint8_t)(id >> 8);
+    c.station[3] = (uint8_t)id;
+    c.station[4] = 0x00;
+    c.station[5] = 0x09;
+    c.id = id;
+    return c;
+}
+
+// Same descending evict loop as DoNoHamMode::evictSavedHandshakes
+static void evict(std::vector<FakeCapture>& items, DirtyMask& dirty, uint64_t flushed) {
+    for (int slot = (int)items.size() - 1; slot >= 0; slot--) {
+        if (!(flushed & (1ull << slot))) continue;
+        size_t last = removeSlot(items, (size_t)slot);
+        dirty.moveLast((uint8_t)slot, (uint8_t)last);
+    }
+}
+
+// OINK-shaped handshake: M1..M4 frames (EAPOL + full 802.11) in the arena
+struct FakeHandshake {
+    EapolArena::Ref eapol[4];
+    EapolArena::Ref full[4];
+    uint8_t capturedMask;
+    uint32_t lastSeen;
+    bool saved;
+
+    bool isComplete() const {
+        return ((capturedMask & 0x03) == 0x03) || ((capturedMask & 0x06) == 0x06);
+    }
+    void releaseFrames(EapolArena& arena) {
+        for (int i = 0; i < 4; i++) {
+            arena.release(eapol[i]);
+            arena.release(full[i]);
+        }
+        capturedMask = 0;
+    }
+};
+
+// Same store-then-reclaim loop as OINK's EAPOL paths
+static bool storeFrame(EapolArena& arena, std::vector<FakeHandshake>& list, int slot,
+                       uint8_t msg, uint32_t now, bool reclaim) {
+    static uint8_t eapol[121], full[150];
+    FakeHandshake& hs = list[slot];
+    for (;;) {
+        if (arena.storePair(hs.eapol[msg], eapol, sizeof(eapol), hs.full[msg], full, sizeof(full))) {
+            hs.capturedMask |= (uint8_t)(1 << msg);
+            hs.lastSeen = now;
+            return true;
+        }
+        int victim = reclaim ? oldestIncomplete(list, now, slot) : -1;
+        if (victim < 0) return false;
+        list[victim].releaseFrames(arena);
+    }
+}
+
+// ============================================================================
+// Dirty mask
+// ============================================================================
+
+void test_dirty_setResetTest(void) {
+    DirtyMask d;
+    TEST_ASSERT_FALSE(d.any());
+    d.set(0);
+    d.set(63);
+    d.set(64);  // Out of range: ignored
+    TEST_ASSERT_TRUE(d.test(0));
+    TEST_ASSERT_TRUE(d.test(63));
+    TEST_ASSERT_FALSE(d.test(64));
+    TEST_ASSERT_EQUAL_UINT64(0x8000000000000001ull, d.raw());
+    d.reset(0);
+    TEST_ASSERT_FALSE(d.test(0));
+    d.clear();
+    TEST_ASSERT_FALSE(d.any());
+}
+
+void test_dirty_followsSwapRemove(void) {
+    DirtyMask d;
+    d.set(4);  // Last slot dirty
+    d.moveLast(1, 4);
+    TEST_ASSERT_TRUE(d.test(1));
+    TEST_ASSERT_FALSE(d.test(4));
+
+    d.clear();
+    d.set(1);  // Evicted slot was dirty, last clean
+    d.moveLast(1, 4);
+    TEST_ASSERT_FALSE(d.test(1));
+
+    d.clear();
+    d.set(4);  // Removing the last slot itself
+    d.moveLast(4, 4);
+    TEST_ASSERT_FALSE(d.any());
+}
+
+void test_evict_keepsPendingWithItsSlot(void) {
+    // 10 entries; evict 2, 5, 9; 3 and 8 stay dirty
+    std::vector<FakeCapture> items;
+    for (uint32_t i = 0; i < 10; i++) items.push_back(makeCapture(i));
+    DirtyMask dirty;
+    dirty.set(3);
+    dirty.set(8);
+    evict(items, dirty, (1ull << 2) | (1ull << 5) | (1ull << 9));
+
+    TEST_ASSERT_EQUAL_UINT32(7, items.size());
+    std::set<uint32_t> ids, dirtyIds;
+    for (size_t i = 0; i < items.size(); i++) {
+        ids.insert(items[i].id);
+        if (dirty.test((uint8_t)i)) dirtyIds.insert(items[i].id);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ids.count(2) + ids.count(5) + ids.count(9));
+    TEST_ASSERT_EQUAL_UINT32(2, dirtyIds.size());
+    TEST_ASSERT_EQUAL_UINT32(1, dirtyIds.count(3));
+    TEST_ASSERT_EQUAL_UINT32(1, dirtyIds.count(8));
+}
+
+// ============================================================================
+// Keys and saved set
+// ============================================================================
+
+void test_captureKey_separatesTypesAndStations(void) {
+    FakeCapture a = makeCapture(1);
+    FakeCapture b = makeCapture(1);
+    b.station[5] ^= 0x01;
+    TEST_ASSERT_TRUE(captureKey(a.bssid, a.station) != 0);
+    TEST_ASSERT_EQUAL_UINT64(captureKey(a.bssid, a.station), captureKey(a.bssid, a.station));
+    TEST_ASSERT_TRUE(captureKey(a.bssid, a.station) != captureKey(b.bssid, b.station));
+    TEST_ASSERT_TRUE(captureKey(a.bssid, nullptr) != captureKey(a.bssid, a.station));
+
+    // All-zero station is still a handshake key, not a PMKID key
+    const uint8_t zero[6] = {0};
+    TEST_ASSERT_TRUE(captureKey(a.bssid, nullptr) != captureKey(a.bssid, zero));
+}
+
+void test_savedSet_addContainsFull(void) {
+    SavedCaptureSet<16> s;  // Capacity 12
+    TEST_ASSERT_EQUAL_UINT16(12, SavedCaptureSet<16>::kCapacity);
+    std::vector<uint64_t> keys;
+    for (uint32_t i = 0; i < 12; i++) {
+        FakeCapture c = makeCapture(i);
+        keys.push_back(captureKey(c.bssid, c.station));
+        TEST_ASSERT_TRUE(s.add(keys.back()));
+    }
+    TEST_ASSERT_TRUE(s.full());
+    TEST_ASSERT_TRUE(s.add(keys[3]));  // Present: still true
+    FakeCapture extra = makeCapture(99);
+    TEST_ASSERT_FALSE(s.add(captureKey(extra.bssid, extra.station)));
+    for (uint64_t k : keys) TEST_ASSERT_TRUE(s.contains(k));
+    TEST_ASSERT_FALSE(s.contains(captureKey(extra.bssid, extra.station)));
+
+    s.clear();
+    TEST_ASSERT_EQUAL_UINT16(0, s.size());
+    TEST_ASSERT_FALSE(s.contains(keys[0]));
+}
+
+void test_savedSet_noFalsePositives(void) {
+    SavedCaptureSet<256> s;
+    for (uint32_t i = 0; i < SavedCaptureSet<256>::kCapacity; i++) {
+        FakeCapture c = makeCapture(i);
+        TEST_ASSERT_TRUE(s.add(captureKey(c.bssid, c.station)));
+    }
+    for (uint32_t i = 1000; i < 6000; i++) {
+        FakeCapture c = makeCapture(i);
+        TEST_ASSERT_FALSE(s.contains(captureKey(c.bssid, c.station)));
+    }
+}
+
+// ============================================================================
+// Session
+// ============================================================================
+
+void test_session_spillsPastRamCap(void) {
+    // 2000 captures, frames arriving interleaved for up to 8 at a time,
+    // 50-slot RAM cap. Completed captures are flushed every few steps and
+    // late frames for saved captures must not reopen them.
+    const size_t RAM_CAP = 50;
+    std::vector<FakeCapture> ram;
+    DirtyMask dirty;
+    SavedCaptureSet<4096> saved;
+    std::set<uint32_t> written;
+    uint32_t nextId = 0;
+    size_t peak = 0;
+    uint32_t rejectedLate = 0;
+
+    for (int step = 0; step < 20000 && written.size() < 2000; step++) {
+        // Frame for a recent capture (sometimes one already saved)
+        uint32_t id = nextId > 0 ? nextId - 1 - (nextRand() % (nextId < 8 ? nextId : 8)) : 0;
+        if ((nextRand() % 4) == 0 || nextId == 0) id = nextId++;
+        FakeCapture c = makeCapture(id);
+        if (saved.contains(captureKey(c.bssid, c.station))) {
+            rejectedLate++;
+        } else {
+            int slot = -1;
+            for (size_t i = 0; i < ram.size(); i++) {
+                if (ram[i].id == id) slot = (int)i;
+            }
+            if (slot < 0 && ram.size() < RAM_CAP) {
+                ram.push_back(c);
+                slot = (int)ram.size() - 1;
+            }
+            TEST_ASSERT_TRUE(slot >= 0);  // Never capped
+            dirty.set((uint8_t)slot);
+        }
+        if (ram.size() > peak) peak = ram.size();
+
+        // Save pass every 5 frames: flush dirty slots only
+        if (step % 5 == 4) {
+            uint64_t flushed = 0;
+            uint64_t pending = dirty.raw();
+            while (pending) {
+                uint8_t slot = (uint8_t)__builtin_ctzll(pending);
+                pending &= pending - 1;
+                TEST_ASSERT_TRUE(slot < ram.size());
+                TEST_ASSERT_EQUAL_UINT32(0, written.count(ram[slot].id));
+                written.insert(ram[slot].id);
+                saved.add(captureKey(ram[slot].bssid, ram[slot].station));
+                flushed |= 1ull << slot;
+            }
+            evict(ram, dirty, flushed);
+            TEST_ASSERT_FALSE(dirty.any());
+        }
+    }
+
+    TEST_ASSERT_TRUE(written.size() >= 2000);
+    TEST_ASSERT_TRUE(peak <= 8);
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%u captures written, peak %u in RAM (cap %u), %u late frames dropped",
+             (unsigned)written.size(), (unsigned)peak, (unsigned)RAM_CAP, (unsigned)rejectedLate);
+    TEST_MESSAGE(msg);
+}
+
+// ============================================================================
+// OINK arena reclaim
+// ============================================================================
+
+void test_oldestIncomplete_skipsSavedCompleteAndEmpty(void) {
+    std::vector<FakeHandshake> list(5);
+    for (auto& hs : list) hs = FakeHandshake{};
+    list[0].capturedMask = 0x03;  list[0].lastSeen = 10;                        // Complete
+    list[1].capturedMask = 0x01;  list[1].lastSeen = 20; list[1].saved = true;  // Saved
+    list[2].capturedMask = 0x00;  list[2].lastSeen = 30;                        // Already reclaimed
+    list[3].capturedMask = 0x01;  list[3].lastSeen = 40;
+    list[4].capturedMask = 0x08;  list[4].lastSeen = 50;
+    TEST_ASSERT_EQUAL_INT(3, oldestIncomplete(list, 100));
+    TEST_ASSERT_EQUAL_INT(4, oldestIncomplete(list, 100, 3));
+    list[3].lastSeen = 0xFFFFFFF0u;  // Seen just before millis() wrapped: still oldest
+    TEST_ASSERT_EQUAL_INT(3, oldestIncomplete(list, 100));
+    list[4].capturedMask = 0x03;
+    list[3].capturedMask = 0x06;
+    TEST_ASSERT_EQUAL_INT(-1, oldestIncomplete(list, 100));
+}
+
+void test_arena_fullStillTakesNewCaptures(void) {
+    // 16KB arena (HeapPolicy::kEapolArenaBytes). 120 APs, each leaving two
+    // M1-only stations behind and one M1+M2 capture that is then saved.
+    // Without reclaim the arena fills after a couple of dozen captures;
+    // with saved frames released and stale M1s reclaimed, every capture
+    // still gets its frames stored.
+    static uint8_t storage[16384];
+    uint32_t completed[2] = {0, 0};
+    for (int pass = 0; pass < 2; pass++) {
+        bool reclaim = pass == 1;
+        EapolArena arena;
+        arena.attach(storage, sizeof(storage));
+        std::vector<FakeHandshake> list;
+        uint32_t now = 1000;
+        for (int ap = 0; ap < 120; ap++) {
+            for (int n = 0; n < 2; n++) {
+                list.push_back(FakeHandshake{});
+                storeFrame(arena, list, (int)list.size() - 1, 0, now += 50, reclaim);
+            }
+            list.push_back(FakeHandshake{});
+            int slot = (int)list.size() - 1;
+            bool ok = storeFrame(arena, list, slot, 0, now += 50, reclaim) &&
+                      storeFrame(arena, list, slot, 1, now += 50, reclaim);
+            if (ok && list[slot].isComplete()) {
+                completed[pass]++;
+                if (reclaim) {
+                    // Written to SD: frames back, mask kept
+                    uint8_t mask = list[slot].capturedMask;
+                    list[slot].releaseFrames(arena);
+                    list[slot].capturedMask = mask;
+                    list[slot].saved = true;
+                    TEST_ASSERT_TRUE(list[slot].isComplete());
+                }
+            }
+        }
+        if (reclaim) {
+            TEST_ASSERT_EQUAL_UINT32(120, completed[pass]);
+            TEST_ASSERT_TRUE(arena.freeChunks() > 0);
+        }
+    }
+    TEST_ASSERT_TRUE(completed[0] < 40);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "16KB arena, 120 APs: %u captures without reclaim, %u with",
+             (unsigned)completed[0], (unsigned)completed[1]);
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Dirty mask
+    RUN_TEST(test_dirty_setResetTest);
+    RUN_TEST(test_dirty_followsSwapRemove);
+    RUN_TEST(test_evict_keepsPendingWithItsSlot);
+
+    // Keys and saved set
+    RUN_TEST(test_captureKey_separatesTypesAndStations);
+    RUN_TEST(test_savedSet_addContainsFull);
+    RUN_TEST(test_savedSet_noFalsePositives);
+
+    // Session
+    RUN_TEST(test_session_spillsPastRamCap);
+
+    // OINK arena reclaim
+    RUN_TEST(test_oldestIncomplete_skipsSavedCompleteAndEmpty);
+    RUN_TEST(test_arena_fullStillTakesNewCaptures);
+
+    return UNITY_END();
+}
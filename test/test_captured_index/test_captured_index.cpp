@@ -0,0 +1,427 @@
+// Captured Index Tests
+// Tests the on-SD format behind CapturedIndex: record packing in MAC order,
+// header validation, the sorted in-RAM delta, streaming merges into a new
+// sorted file, page-by-page binary search, the in-RAM key filter that
+// answers misses without SD, and loot file name parsing.
+// The "file" is a byte vector built the same way CapturedIndex writes it;
+// a lifecycle test drives thousands of adds through delta + merge and
+// checks every lookup against std::map.
+
+#include <unity.h>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include "../../src/core/captured_index_format.h"
+
+using namespace CapturedIndexFormat;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x2C1B3C6Du;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint64_t randomKey() {
+    return (((uint64_t)nextRand() << 32) | nextRand()) & kKeyMask;
+}
+
+typedef Delta<64> TestDelta;
+
+// Sorted index file in memory: header + records
+struct MemIndex {
+    std::vector<uint8_t> bytes;
+    uint32_t count = 0;
+    uint32_t pageReads = 0;
+
+    MemIndex() {
+        bytes.resize(kHeaderSize);
+        encodeHeader(bytes.data(), 0);
+    }
+
+    // Same merge CapturedIndex::writeIndex runs against SD
+    void merge(const TestDelta& delta) {
+        std::vector<uint8_t> out(kHeaderSize);
+        uint32_t pos = 0;
+        int32_t n = mergeSorted(delta,
+            [&](uint64_t& rec) {
+                if (pos >= count) return false;
+                rec = getRecord(&bytes[kHeaderSize + pos++ * kRecordSize]);
+                return true;
+            },
+            [&](uint64_t rec) {
+                uint8_t buf[kRecordSize];
+                putRecord(buf, rec);
+                out.insert(out.end(), buf, buf + kRecordSize);
+                return true;
+            });
+        TEST_ASSERT_TRUE(n >= 0);
+        encodeHeader(out.data(), (uint32_t)n);
+        bytes.swap(out);
+        count = (uint32_t)n;
+    }
+
+    uint8_t lookup(uint64_t key) {
+        return searchPaged(count, key, [&](uint32_t page, const uint8_t*& recs, uint32_t& n) {
+            uint32_t first = page * kPageRecords;
+            n = count - first;
+            if (n > kPageRecords) n = kPageRecords;
+            recs = &bytes[kHeaderSize + first * kRecordSize];
+            pageReads++;
+            return true;
+        });
+    }
+};
+
+// ============================================================================
+// Records and header
+// ============================================================================
+
+void test_record_roundtripAndMacOrder(void) {
+    const uint8_t a[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    const uint8_t b[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x56};
+    const uint8_t c[6] = {0xDC, 0xA6, 0x32, 0x00, 0x00, 0x00};
+    TEST_ASSERT_EQUAL_UINT64(0x001122334455ull, bssidKey(a));
+    TEST_ASSERT_TRUE(bssidKey(a) < bssidKey(b));
+    TEST_ASSERT_TRUE(bssidKey(b) < bssidKey(c));
+
+    uint64_t rec = makeRecord(bssidKey(c), kHandshake | kPmkid);
+    uint8_t buf[kRecordSize];
+    putRecord(buf, rec);
+    TEST_ASSERT_EQUAL_UINT8(0x03, buf[0]);  // Little-endian, types first
+    TEST_ASSERT_EQUAL_UINT64(rec, getRecord(buf));
+    TEST_ASSERT_EQUAL_UINT64(bssidKey(c), recordKey(rec));
+    TEST_ASSERT_EQUAL_UINT8(kAnyCapture, recordTypes(rec));
+    TEST_ASSERT_TRUE(validRecord(rec));
+    TEST_ASSERT_FALSE(validRecord(makeRecord(1, 0)));
+    TEST_ASSERT_FALSE(validRecord(makeRecord(1, 0x10)));
+}
+
+void test_header_roundtrip(void) {
+    uint8_t hdr[kHeaderSize];
+    encodeHeader(hdr, 123456);
+    uint32_t count = 0;
+    TEST_ASSERT_TRUE(decodeHeader(hdr, count));
+    TEST_ASSERT_EQUAL_UINT32(123456, count);
+    TEST_ASSERT_EQUAL_UINT8('P', hdr[0]);
+    TEST_ASSERT_EQUAL_UINT8('K', hdr[1]);
+}
+
+void test_header_rejectsDamage(void) {
+    uint8_t hdr[kHeaderSize];
+    uint32_t count = 0;
+
+    encodeHeader(hdr, 10);
+    hdr[8] ^= 0x01;  // Count flipped: CRC mismatch
+    TEST_ASSERT_FALSE(decodeHeader(hdr, count));
+
+    encodeHeader(hdr, 10);
+    hdr[0] = 'X';
+    TEST_ASSERT_FALSE(decodeHeader(hdr, count));
+
+    uint8_t zeros[kHeaderSize] = {0};
+    TEST_ASSERT_FALSE(decodeHeader(zeros, count));
+
+    // Newer version with a valid CRC is still refused
+    encodeHeader(hdr, 10);
+    hdr[4] = 2;
+    uint32_t crc = Crc32::compute(hdr, 12);
+    for (int i = 0; i < 4; i++) hdr[12 + i] = (uint8_t)(crc >> (8 * i));
+    TEST_ASSERT_FALSE(decodeHeader(hdr, count));
+}
+
+// ============================================================================
+// Delta and merge
+// ============================================================================
+
+void test_delta_sortedAndMergesTypes(void) {
+    TestDelta d;
+    TEST_ASSERT_TRUE(d.add(50, kHandshake) == TestDelta::Add::Added);
+    TEST_ASSERT_TRUE(d.add(10, kPmkid) == TestDelta::Add::Added);
+    TEST_ASSERT_TRUE(d.add(30, kHandshake) == TestDelta::Add::Added);
+    TEST_ASSERT_TRUE(d.add(30, kHandshake) == TestDelta::Add::Unchanged);
+    TEST_ASSERT_TRUE(d.add(30, kPmkid) == TestDelta::Add::Merged);
+
+    TEST_ASSERT_EQUAL_UINT16(3, d.size());
+    TEST_ASSERT_EQUAL_UINT64(10, recordKey(d.at(0)));
+    TEST_ASSERT_EQUAL_UINT64(30, recordKey(d.at(1)));
+    TEST_ASSERT_EQUAL_UINT64(50, recordKey(d.at(2)));
+    TEST_ASSERT_EQUAL_UINT8(kAnyCapture, d.find(30));
+    TEST_ASSERT_EQUAL_UINT8(kPmkid, d.find(10));
+    TEST_ASSERT_EQUAL_UINT8(0, d.find(20));
+}
+
+void test_delta_fullStillMergesKnownKeys(void) {
+    TestDelta d;
+    for (uint64_t k = 0; k < 64; k++) {
+        TEST_ASSERT_TRUE(d.add(k * 2, kHandshake) == TestDelta::Add::Added);
+    }
+    TEST_ASSERT_TRUE(d.full());
+    TEST_ASSERT_TRUE(d.add(1, kHandshake) == TestDelta::Add::Full);
+    TEST_ASSERT_TRUE(d.add(4, kPmkid) == TestDelta::Add::Merged);
+    TEST_ASSERT_EQUAL_UINT8(0, d.find(1));
+}
+
+void test_merge_combinesFileAndDelta(void) {
+    MemIndex idx;
+    TestDelta d;
+    d.add(100, kHandshake);
+    d.add(300, kHandshake);
+    idx.merge(d);
+
+    d.clear();
+    d.add(200, kPmkid);
+    d.add(300, kPmkid);  // Same BSSID as a filed record
+    d.add(50, kPmkid);
+    idx.merge(d);
+
+    TEST_ASSERT_EQUAL_UINT32(4, idx.count);
+    uint32_t count = 0;
+    TEST_ASSERT_TRUE(decodeHeader(idx.bytes.data(), count));
+    TEST_ASSERT_EQUAL_UINT32(4, count);
+
+    const uint64_t keys[4] = {50, 100, 200, 300};
+    for (int i = 0; i < 4; i++) {
+        uint64_t rec = getRecord(&idx.bytes[kHeaderSize + i * kRecordSize]);
+        TEST_ASSERT_EQUAL_UINT64(keys[i], recordKey(rec));
+    }
+    TEST_ASSERT_EQUAL_UINT8(kAnyCapture, idx.lookup(300));
+    TEST_ASSERT_EQUAL_UINT8(kHandshake, idx.lookup(100));
+    TEST_ASSERT_EQUAL_UINT8(0, idx.lookup(150));
+}
+
+// ============================================================================
+// Paged search
+// ============================================================================
+
+void test_search_edgesAndMisses(void) {
+    MemIndex idx;
+    TEST_ASSERT_EQUAL_UINT8(0, idx.lookup(5));  // Empty file
+
+    // 100 keys: pages of 32, 32, 32, 4
+    TestDelta d;
+    for (uint64_t k = 1; k <= 100; k++) {
+        if (d.full()) {
+            idx.merge(d);
+            d.clear();
+        }
+        d.add(k * 10, (k & 1) ? kHandshake : kPmkid);
+    }
+    idx.merge(d);
+    TEST_ASSERT_EQUAL_UINT32(100, idx.count);
+
+    for (uint64_t k = 1; k <= 100; k++) {
+        TEST_ASSERT_EQUAL_UINT8((k & 1) ? kHandshake : kPmkid, idx.lookup(k * 10));
+        TEST_ASSERT_EQUAL_UINT8(0, idx.lookup(k * 10 + 5));  // Between keys
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, idx.lookup(0));
+    TEST_ASSERT_EQUAL_UINT8(0, idx.lookup(kKeyMask));
+}
+
+void test_search_readFailureIsMiss(void) {
+    MemIndex idx;
+    TestDelta d;
+    d.add(42, kHandshake);
+    idx.merge(d);
+    uint8_t r = searchPaged(idx.count, 42, [](uint32_t, const uint8_t*&, uint32_t&) {
+        return false;
+    });
+    TEST_ASSERT_EQUAL_UINT8(0, r);
+}
+
+// ============================================================================
+// Key filter
+// ============================================================================
+
+void test_filter_noFalseNegatives(void) {
+    KeyFilter<2048> f;
+    std::vector<uint64_t> keys;
+    TEST_ASSERT_FALSE(f.mayContain(0));
+    for (int i = 0; i < 3000; i++) {
+        keys.push_back(randomKey());
+        f.add(keys.back());
+    }
+    for (uint64_t key : keys) TEST_ASSERT_TRUE(f.mayContain(key));
+    TEST_ASSERT_EQUAL_UINT32(3000, f.size());
+
+    f.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, f.size());
+    TEST_ASSERT_FALSE(f.mayContain(keys[0]));
+}
+
+void test_report_filterSkipsSd(void) {
+    // 2000 looted BSSIDs (a busy loot folder) in the same 2KB filter
+    // CapturedIndex keeps; count how many unseen BSSIDs still hit SD
+    KeyFilter<2048> f;
+    std::map<uint64_t, uint8_t> truth;
+    while (truth.size() < 2000) {
+        uint64_t key = randomKey();
+        truth[key] = kHandshake;
+        f.add(key);
+    }
+    uint32_t tries = 0, falsePos = 0;
+    while (tries < 100000) {
+        uint64_t key = randomKey();
+        if (truth.count(key)) continue;
+        tries++;
+        if (f.mayContain(key)) falsePos++;
+    }
+    // k=3 over 16384 bits at 2000 keys: ~2.9% expected
+    TEST_ASSERT_TRUE(falsePos < tries / 20);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg),
+             "%u keys in %u bytes: %.2f%% of unseen BSSIDs read SD",
+             (unsigned)truth.size(), 2048u, 100.0 * falsePos / tries);
+    TEST_MESSAGE(msg);
+}
+
+// ============================================================================
+// Loot names
+// ============================================================================
+
+void test_parseLootName(void) {
+    uint8_t bssid[6];
+    uint8_t type = 0;
+    const uint8_t expect[6] = {0xDC, 0xA6, 0x32, 0x11, 0x22, 0x3F};
+
+    TEST_ASSERT_TRUE(parseLootName("HomeNet_DCA63211223F.22000", bssid, type));
+    TEST_ASSERT_EQUAL_UINT8(kPmkid, type);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, bssid, 6);
+
+    TEST_ASSERT_TRUE(parseLootName("Home_Net_DCA63211223F_hs.22000", bssid, type));
+    TEST_ASSERT_EQUAL_UINT8(kHandshake, type);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, bssid, 6);
+
+    TEST_ASSERT_TRUE(parseLootName("_dca63211223f.pcap", bssid, type));
+    TEST_ASSERT_EQUAL_UINT8(kHandshake, type);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, bssid, 6);
+
+    TEST_ASSERT_FALSE(parseLootName("DCA63211223F.txt", bssid, type));
+    TEST_ASSERT_FALSE(parseLootName("DCA63211223F_pmkid.txt", bssid, type));
+    TEST_ASSERT_FALSE(parseLootName("DCA63211223F.22000", bssid, type));   // No separator
+    TEST_ASSERT_FALSE(parseLootName("Net_DCA63211223G.22000", bssid, type));
+    TEST_ASSERT_FALSE(parseLootName("porkchop_all.hc22000", bssid, type));
+    TEST_ASSERT_FALSE(parseLootName(".22000", bssid, type));
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void test_lifecycle_matchesMap(void) {
+    // 5000 captures over many "sessions", some BSSIDs captured twice with a
+    // different type; every merged state must agree with std::map
+    MemIndex idx;
+    TestDelta d;
+    std::map<uint64_t, uint8_t> truth;
+    std::vector<uint64_t> keys;
+
+    for (int i = 0; i < 5000; i++) {
+        uint64_t key;
+        if (!keys.empty() && (nextRand() % 8) == 0) {
+            key = keys[nextRand() % keys.size()];
+        } else {
+            key = randomKey();
+            keys.push_back(key);
+        }
+        uint8_t type = (nextRand() & 1) ? kHandshake : kPmkid;
+        truth[key] |= type;
+        if (d.add(key, type) == TestDelta::Add::Full) {
+            idx.merge(d);
+            d.clear();
+            TEST_ASSERT_TRUE(d.add(key, type) != TestDelta::Add::Full);
+        }
+    }
+    idx.merge(d);
+    d.clear();
+
+    TEST_ASSERT_EQUAL_UINT32(truth.size(), idx.count);
+    uint64_t prev = 0;
+    for (uint32_t i = 0; i < idx.count; i++) {
+        uint64_t rec = getRecord(&idx.bytes[kHeaderSize + i * kRecordSize]);
+        if (i > 0) TEST_ASSERT_TRUE(recordKey(rec) > prev);
+        prev = recordKey(rec);
+    }
+    for (const auto& kv : truth) {
+        TEST_ASSERT_EQUAL_UINT8(kv.second, idx.lookup(kv.first));
+    }
+    for (int i = 0; i < 2000; i++) {
+        uint64_t key = randomKey();
+        if (truth.count(key)) continue;
+        TEST_ASSERT_EQUAL_UINT8(0, idx.lookup(key));
+    }
+}
+
+void test_report_lookupCost(void) {
+    // 10k looted BSSIDs: pages touched per lookup vs loading the whole file
+    MemIndex idx;
+    TestDelta d;
+    std::vector<uint64_t> keys;
+    for (int i = 0; i < 10000; i++) {
+        uint64_t key = randomKey();
+        keys.push_back(key);
+        if (d.add(key, kHandshake) == TestDelta::Add::Full) {
+            idx.merge(d);
+            d.clear();
+            d.add(key, kHandshake);
+        }
+    }
+    idx.merge(d);
+
+    idx.pageReads = 0;
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_UINT8(kHandshake, idx.lookup(keys[nextRand() % keys.size()]));
+    }
+    uint32_t pages = (idx.count + kPageRecords - 1) / kPageRecords;
+    uint32_t maxReads = 1;
+    while ((1u << (maxReads - 1)) < pages) maxReads++;
+    TEST_ASSERT_TRUE(idx.pageReads <= 1000 * maxReads);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "%u records (%u bytes): %.1f page reads (%u bytes) per filter hit, boot streams the file once",
+             (unsigned)idx.count, (unsigned)idx.bytes.size(), idx.pageReads / 1000.0,
+             (unsigned)(idx.pageReads / 1000.0 * kPageRecords * kRecordSize));
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Records and header
+    RUN_TEST(test_record_roundtripAndMacOrder);
+    RUN_TEST(test_header_roundtrip);
+    RUN_TEST(test_header_rejectsDamage);
+
+    // Delta and merge
+    RUN_TEST(test_delta_sortedAndMergesTypes);
+    RUN_TEST(test_delta_fullStillMergesKnownKeys);
+    RUN_TEST(test_merge_combinesFileAndDelta);
+
+    // Paged search
+    RUN_TEST(test_search_edgesAndMisses);
+    RUN_TEST(test_search_readFailureIsMiss);
+
+    // Key filter
+    RUN_TEST(test_filter_noFalseNegatives);
+    RUN_TEST(test_report_filterSkipsSd);
+
+    // Loot names
+    RUN_TEST(test_parseLootName);
+
+    // Lifecycle
+    RUN_TEST(test_lifecycle_matchesMap);
+    RUN_TEST(test_report_lookupCost);
+
+    return UNITY_END();
+}
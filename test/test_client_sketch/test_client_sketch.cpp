@@ -0,0 +1,241 @@
+// Client Sketch Tests
+// Tests the per-network unique client estimator NetworkRecon feeds from data
+// frames: window rotation/decay, and estimation error against ground-truth
+// client counts, alongside the 128-bit popcount tracker it replaces.
+
+#include <unity.h>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include "../../src/core/client_sketch.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static const uint32_t W = ClientSketch::kWindowMs;
+
+static uint32_t rngState = 0x13579BDFu;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void randomMac(uint8_t* mac) {
+    for (int i = 0; i < 6; i++) mac[i] = (uint8_t)nextRand();
+    mac[0] &= 0xFE;  // Unicast
+}
+
+// Pre-sketch NetworkRecon tracker, verbatim: FNV-1a & 0x7F into 128 bits
+struct LegacyBitset {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    void add(const uint8_t* mac) {
+        uint32_t h = 2166136261u;
+        for (int i = 0; i < 6; i++) {
+            h ^= mac[i];
+            h *= 16777619u;
+        }
+        uint8_t bit = (uint8_t)(h & 0x7F);
+        if (bit < 64) lo |= (1ULL << bit);
+        else hi |= (1ULL << (bit - 64));
+    }
+
+    uint8_t estimate() const {
+        return (uint8_t)(__builtin_popcountll(lo) + __builtin_popcountll(hi));
+    }
+};
+
+// ============================================================================
+// Basics
+// ============================================================================
+
+void test_empty_estimatesZero(void) {
+    ClientSketch s = {};
+    TEST_ASSERT_EQUAL_UINT8(0, s.estimate(1000));
+    s.clear();
+    TEST_ASSERT_EQUAL_UINT8(0, s.estimate(5 * W));
+}
+
+void test_sameClient_countedOnce(void) {
+    ClientSketch s = {};
+    uint8_t mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+    for (int i = 0; i < 100; i++) s.add(mac, 1000 + i);
+    TEST_ASSERT_EQUAL_UINT8(1, s.estimate(2000));
+}
+
+void test_smallCounts_withinOne(void) {
+    for (int n = 1; n <= 3; n++) {
+        for (int trial = 0; trial < 500; trial++) {
+            ClientSketch s = {};
+            for (int i = 0; i < n; i++) {
+                uint8_t mac[6];
+                randomMac(mac);
+                s.add(mac, 100);
+            }
+            int est = s.estimate(100);
+            TEST_ASSERT_TRUE(abs(est - n) <= 1);
+        }
+    }
+}
+
+void test_hashBit_inRange(void) {
+    for (int i = 0; i < 10000; i++) {
+        uint8_t mac[6];
+        randomMac(mac);
+        TEST_ASSERT_TRUE(ClientSketch::hashBit(mac) < ClientSketch::kBits);
+    }
+}
+
+void test_fullBitmap_saturates(void) {
+    TEST_ASSERT_EQUAL_UINT8(255, ClientSketch::estimateFromSetBits(ClientSketch::kBits));
+    TEST_ASSERT_EQUAL_UINT8(0, ClientSketch::estimateFromSetBits(0));
+    TEST_ASSERT_EQUAL_UINT8(1, ClientSketch::estimateFromSetBits(1));
+}
+
+// ============================================================================
+// Sliding window
+// ============================================================================
+
+void test_window_keepsPreviousThenForgets(void) {
+    ClientSketch s = {};
+    uint32_t t = 10 * W + 500;
+    for (int i = 0; i < 5; i++) {
+        uint8_t mac[6] = {0x02, 0, 0, 0, 0, (uint8_t)(i * 37)};
+        s.add(mac, t);
+    }
+    uint8_t est = s.estimate(t);
+    TEST_ASSERT_TRUE(est >= 4 && est <= 6);
+    // Next window: still counted (previous generation)
+    TEST_ASSERT_EQUAL_UINT8(est, s.estimate(t + W));
+    // Two windows on: aged out without any sweep
+    TEST_ASSERT_EQUAL_UINT8(0, s.estimate(t + 2 * W));
+}
+
+void test_window_unionsGenerations(void) {
+    ClientSketch s = {};
+    uint32_t t = 3 * W;
+    uint8_t a[6] = {0x02, 0xAA, 0, 0, 0, 1};
+    uint8_t b[6] = {0x02, 0xBB, 0, 0, 0, 2};
+    s.add(a, t);
+    s.add(b, t + W);  // Rotates: a moves to prev
+    TEST_ASSERT_EQUAL_UINT8(2, s.estimate(t + W));
+    s.add(b, t + 2 * W);  // Rotates again: a drops out
+    TEST_ASSERT_EQUAL_UINT8(1, s.estimate(t + 2 * W));
+}
+
+void test_window_longGapClearsBoth(void) {
+    ClientSketch s = {};
+    uint8_t a[6] = {0x02, 0xAA, 0, 0, 0, 1};
+    uint8_t b[6] = {0x02, 0xBB, 0, 0, 0, 2};
+    s.add(a, W);
+    s.add(b, 9 * W);
+    TEST_ASSERT_EQUAL_UINT8(1, s.estimate(9 * W));
+}
+
+void test_window_epochWrap(void) {
+    ClientSketch s = {};
+    uint8_t a[6] = {0x02, 0xAA, 0, 0, 0, 1};
+    uint8_t b[6] = {0x02, 0xBB, 0, 0, 0, 2};
+    uint32_t t = 65535u * W + 100;  // Last uint16 window
+    s.add(a, t);
+    s.add(b, t + W);                // Window index wraps to 0
+    TEST_ASSERT_EQUAL_UINT8(2, s.estimate(t + W));
+}
+
+void test_churn_tracksRecentPopulation(void) {
+    // 40 clients, then 10 new ones, then 5 new ones: the estimate follows
+    // the last two windows rather than everything ever seen
+    ClientSketch s = {};
+    uint32_t t = 100 * W;
+    uint8_t mac[6];
+    for (int i = 0; i < 40; i++) { randomMac(mac); s.add(mac, t); }
+    for (int i = 0; i < 10; i++) { randomMac(mac); s.add(mac, t + W); }
+    uint8_t est1 = s.estimate(t + W);
+    for (int i = 0; i < 5; i++) { randomMac(mac); s.add(mac, t + 2 * W); }
+    uint8_t est2 = s.estimate(t + 2 * W);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "churn: 40+10 -> est %u, 10+5 -> est %u", est1, est2);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(est1 >= 35 && est1 <= 65);
+    TEST_ASSERT_TRUE(est2 >= 10 && est2 <= 20);
+}
+
+// ============================================================================
+// Accuracy vs ground truth
+// ============================================================================
+
+void test_accuracy_vsGroundTruth(void) {
+    static const int counts[] = {1, 2, 3, 5, 10, 20, 35, 50, 75, 100, 150, 200};
+    const int trials = 400;
+
+    for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++) {
+        int n = counts[c];
+        double sketchErr = 0, sketchBias = 0, legacyErr = 0;
+        for (int trial = 0; trial < trials; trial++) {
+            ClientSketch s = {};
+            LegacyBitset legacy;
+            for (int i = 0; i < n; i++) {
+                uint8_t mac[6];
+                randomMac(mac);
+                s.add(mac, 1000);
+                legacy.add(mac);
+            }
+            int est = s.estimate(1000);
+            sketchErr += fabs((double)(est - n)) / n;
+            sketchBias += (double)(est - n) / n;
+            legacyErr += fabs((double)(legacy.estimate() - n)) / n;
+        }
+        sketchErr /= trials;
+        sketchBias /= trials;
+        legacyErr /= trials;
+
+        char msg[128];
+        snprintf(msg, sizeof(msg), "n=%3d  sketch mean err=%5.1f%% bias=%+5.1f%%  legacy bitset err=%5.1f%%",
+                 n, sketchErr * 100, sketchBias * 100, legacyErr * 100);
+        TEST_MESSAGE(msg);
+
+        // Linear counting is unbiased until the bitmap nears full
+        if (n <= 100) {
+            TEST_ASSERT_TRUE(sketchErr < 0.12);
+            TEST_ASSERT_TRUE(fabs(sketchBias) < 0.05);
+        } else {
+            TEST_ASSERT_TRUE(sketchErr < 0.25);
+        }
+        // Where the old tracker saturated, the sketch must do better
+        if (n >= 50) {
+            TEST_ASSERT_TRUE(sketchErr < legacyErr);
+        }
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Basics
+    RUN_TEST(test_empty_estimatesZero);
+    RUN_TEST(test_sameClient_countedOnce);
+    RUN_TEST(test_smallCounts_withinOne);
+    RUN_TEST(test_hashBit_inRange);
+    RUN_TEST(test_fullBitmap_saturates);
+
+    // Sliding window
+    RUN_TEST(test_window_keepsPreviousThenForgets);
+    RUN_TEST(test_window_unionsGenerations);
+    RUN_TEST(test_window_longGapClearsBoth);
+    RUN_TEST(test_window_epochWrap);
+    RUN_TEST(test_churn_tracksRecentPopulation);
+
+    // Accuracy
+    RUN_TEST(test_accuracy_vsGroundTruth);
+
+    return UNITY_END();
+}
@@ -0,0 +1,280 @@
+// EAPOL Arena Tests
+// Tests the fixed-chunk slab behind EapolStore: round trips at actual
+// length, all-or-nothing failure when full, no chunk leaks across churn,
+// and how many handshakes fit compared with the old inline layout.
+
+#include <unity.h>
+#include <cstdio>
+#include <vector>
+#include "../../src/core/eapol_arena.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x2545F491u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void fillPattern(uint8_t* buf, uint16_t len, uint8_t seed) {
+    for (uint16_t i = 0; i < len; i++) buf[i] = (uint8_t)(seed + i * 7);
+}
+
+static bool matchesPattern(const uint8_t* buf, uint16_t len, uint8_t seed) {
+    for (uint16_t i = 0; i < len; i++) {
+        if (buf[i] != (uint8_t)(seed + i * 7)) return false;
+    }
+    return true;
+}
+
+// Old CapturedHandshake embedded 4 x (data[512] + fullFrame[300] + fields)
+static const size_t INLINE_HANDSHAKE_BYTES = 4 * (512 + 300 + 12);
+
+// Typical captured sizes: M1 EAPOL ~121 bytes in a ~161 byte data frame,
+// M2 ~143 bytes (with RSN IE) in a ~183 byte frame
+static const uint16_t M1_EAPOL = 121, M1_FULL = 161;
+static const uint16_t M2_EAPOL = 143, M2_FULL = 183;
+
+// ============================================================================
+// Store / copy
+// ============================================================================
+
+void test_roundtrip_variousLengths(void) {
+    static uint8_t storage[64 * 64];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    const uint16_t lens[] = {1, 61, 62, 63, 124, 125, 300, 512};
+    for (uint16_t len : lens) {
+        uint8_t in[512], out[512];
+        fillPattern(in, len, (uint8_t)len);
+        EapolArena::Ref ref = {};
+        TEST_ASSERT_TRUE(arena.store(ref, in, len));
+        TEST_ASSERT_EQUAL_UINT16(len, ref.len);
+        TEST_ASSERT_EQUAL_UINT16(arena.totalChunks() - EapolArena::chunksFor(len), arena.freeChunks());
+        TEST_ASSERT_EQUAL_UINT16(len, arena.copyOut(ref, out, sizeof(out)));
+        TEST_ASSERT_TRUE(matchesPattern(out, len, (uint8_t)len));
+        arena.release(ref);
+        TEST_ASSERT_TRUE(ref.empty());
+        TEST_ASSERT_EQUAL_UINT16(arena.totalChunks(), arena.freeChunks());
+    }
+}
+
+void test_copyOut_truncatesToCap(void) {
+    static uint8_t storage[16 * 64];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    uint8_t in[200], out[64];
+    fillPattern(in, sizeof(in), 3);
+    EapolArena::Ref ref = {};
+    TEST_ASSERT_TRUE(arena.store(ref, in, sizeof(in)));
+    TEST_ASSERT_EQUAL_UINT16(49, arena.copyOut(ref, out, 49));
+    TEST_ASSERT_TRUE(matchesPattern(out, 49, 3));
+}
+
+void test_forEachSpan_coversFrameInOrder(void) {
+    static uint8_t storage[16 * 64];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    uint8_t in[300];
+    fillPattern(in, sizeof(in), 9);
+    EapolArena::Ref ref = {};
+    TEST_ASSERT_TRUE(arena.store(ref, in, sizeof(in)));
+
+    std::vector<uint8_t> joined;
+    int spans = 0;
+    arena.forEachSpan(ref, [&](const uint8_t* p, uint16_t n) {
+        joined.insert(joined.end(), p, p + n);
+        spans++;
+    });
+    TEST_ASSERT_EQUAL_INT(EapolArena::chunksFor(sizeof(in)), spans);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(in), joined.size());
+    TEST_ASSERT_TRUE(matchesPattern(joined.data(), sizeof(in), 9));
+}
+
+void test_store_replacesOldFrame(void) {
+    static uint8_t storage[16 * 64];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    uint8_t a[300], b[40], out[300];
+    fillPattern(a, sizeof(a), 1);
+    fillPattern(b, sizeof(b), 2);
+    EapolArena::Ref ref = {};
+    TEST_ASSERT_TRUE(arena.store(ref, a, sizeof(a)));
+    TEST_ASSERT_TRUE(arena.store(ref, b, sizeof(b)));
+    TEST_ASSERT_EQUAL_UINT16(arena.totalChunks() - 1, arena.freeChunks());
+    TEST_ASSERT_EQUAL_UINT16(sizeof(b), arena.copyOut(ref, out, sizeof(out)));
+    TEST_ASSERT_TRUE(matchesPattern(out, sizeof(b), 2));
+}
+
+// ============================================================================
+// Exhaustion
+// ============================================================================
+
+void test_full_failsAndKeepsOldFrame(void) {
+    static uint8_t storage[4 * 64];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    uint8_t small[100], big[512], out[512];
+    fillPattern(small, sizeof(small), 5);
+    fillPattern(big, sizeof(big), 6);
+    EapolArena::Ref keep = {};
+    EapolArena::Ref other = {};
+    TEST_ASSERT_TRUE(arena.store(keep, small, sizeof(small)));   // 2 chunks
+    TEST_ASSERT_TRUE(arena.store(other, small, 62));             // 1 chunk
+
+    TEST_ASSERT_FALSE(arena.store(keep, big, sizeof(big)));      // needs 9
+    TEST_ASSERT_EQUAL_UINT32(1, arena.getFailedStores());
+    TEST_ASSERT_EQUAL_UINT16(sizeof(small), arena.copyOut(keep, out, sizeof(out)));
+    TEST_ASSERT_TRUE(matchesPattern(out, sizeof(small), 5));
+    TEST_ASSERT_EQUAL_UINT16(1, arena.freeChunks());
+}
+
+void test_storePair_allOrNothing(void) {
+    static uint8_t storage[6 * 64];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    uint8_t eapol[121], full[300], out[300];
+    fillPattern(eapol, sizeof(eapol), 7);
+    fillPattern(full, sizeof(full), 8);
+    EapolArena::Ref e = {};
+    EapolArena::Ref f = {};
+    TEST_ASSERT_TRUE(arena.storePair(e, eapol, 62, f, full, 62));  // 1 + 1
+
+    // 2 + 5 chunks > 4 free + 2 held: both refs untouched
+    TEST_ASSERT_FALSE(arena.storePair(e, eapol, sizeof(eapol), f, full, sizeof(full)));
+    TEST_ASSERT_EQUAL_UINT16(62, e.len);
+    TEST_ASSERT_EQUAL_UINT16(62, f.len);
+    TEST_ASSERT_EQUAL_UINT16(4, arena.freeChunks());
+
+    // Full frame optional: empty side is released
+    TEST_ASSERT_TRUE(arena.storePair(e, eapol, sizeof(eapol), f, nullptr, 0));
+    TEST_ASSERT_TRUE(f.empty());
+    TEST_ASSERT_EQUAL_UINT16(sizeof(eapol), arena.copyOut(e, out, sizeof(out)));
+    TEST_ASSERT_TRUE(matchesPattern(out, sizeof(eapol), 7));
+    TEST_ASSERT_EQUAL_UINT16(4, arena.freeChunks());
+}
+
+void test_detached_failsSafely(void) {
+    EapolArena arena;
+    arena.attach(nullptr, 0);
+    uint8_t in[10] = {0};
+    EapolArena::Ref ref = {};
+    TEST_ASSERT_FALSE(arena.attached());
+    TEST_ASSERT_FALSE(arena.store(ref, in, sizeof(in)));
+    TEST_ASSERT_TRUE(ref.empty());
+}
+
+// ============================================================================
+// Churn
+// ============================================================================
+
+void test_churn_noLeaks(void) {
+    static uint8_t storage[256 * 64];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    const int slots = 40;
+    EapolArena::Ref refs[slots] = {};
+    uint8_t seeds[slots] = {0};
+    uint8_t in[512], out[512];
+    uint32_t failures = 0;
+
+    for (int i = 0; i < 50000; i++) {
+        int s = nextRand() % slots;
+        if (nextRand() % 4 == 0) {
+            arena.release(refs[s]);
+            continue;
+        }
+        uint16_t len = (uint16_t)(1 + nextRand() % 512);
+        uint8_t seed = (uint8_t)nextRand();
+        fillPattern(in, len, seed);
+        if (arena.store(refs[s], in, len)) {
+            seeds[s] = seed;
+        } else {
+            failures++;
+        }
+    }
+
+    // Every surviving frame is intact and the free count adds up
+    uint32_t held = 0;
+    for (int s = 0; s < slots; s++) {
+        if (refs[s].empty()) continue;
+        uint16_t n = arena.copyOut(refs[s], out, sizeof(out));
+        TEST_ASSERT_EQUAL_UINT16(refs[s].len, n);
+        TEST_ASSERT_TRUE(matchesPattern(out, n, seeds[s]));
+        held += EapolArena::chunksFor(refs[s].len);
+    }
+    TEST_ASSERT_EQUAL_UINT32(arena.totalChunks(), held + arena.freeChunks());
+    TEST_ASSERT_EQUAL_UINT32(failures, arena.getFailedStores());
+
+    for (int s = 0; s < slots; s++) arena.release(refs[s]);
+    TEST_ASSERT_EQUAL_UINT16(arena.totalChunks(), arena.freeChunks());
+}
+
+// ============================================================================
+// Capacity
+// ============================================================================
+
+void test_capacity_vsInlineLayout(void) {
+    static uint8_t storage[16384];
+    EapolArena arena;
+    arena.attach(storage, sizeof(storage));
+
+    uint8_t e1[M1_EAPOL], f1[M1_FULL], e2[M2_EAPOL], f2[M2_FULL];
+    fillPattern(e1, sizeof(e1), 1);
+    fillPattern(f1, sizeof(f1), 2);
+    fillPattern(e2, sizeof(e2), 3);
+    fillPattern(f2, sizeof(f2), 4);
+
+    int handshakes = 0;
+    for (;;) {
+        EapolArena::Ref r[4] = {};
+        if (!arena.storePair(r[0], e1, sizeof(e1), r[1], f1, sizeof(f1))) break;
+        if (!arena.storePair(r[2], e2, sizeof(e2), r[3], f2, sizeof(f2))) break;
+        handshakes++;
+    }
+    size_t inlineFit = sizeof(storage) / INLINE_HANDSHAKE_BYTES;
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "16KB: %d M1+M2 handshakes in arena vs %u inline (%.1fx)",
+             handshakes, (unsigned)inlineFit, (double)handshakes / inlineFit);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE((size_t)handshakes >= inlineFit * 4);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Store / copy
+    RUN_TEST(test_roundtrip_variousLengths);
+    RUN_TEST(test_copyOut_truncatesToCap);
+    RUN_TEST(test_forEachSpan_coversFrameInOrder);
+    RUN_TEST(test_store_replacesOldFrame);
+
+    // Exhaustion
+    RUN_TEST(test_full_failsAndKeepsOldFrame);
+    RUN_TEST(test_storePair_allOrNothing);
+    RUN_TEST(test_detached_failsSafely);
+
+    // Churn
+    RUN_TEST(test_churn_noLeaks);
+
+    // Capacity
+    RUN_TEST(test_capacity_vsInlineLayout);
+
+    return UNITY_END();
+}
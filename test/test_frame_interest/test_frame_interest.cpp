@@ -0,0 +1,194 @@
+// Frame Interest Tests
+// Tests the frame-interest masks NetworkRecon pushes down to the promiscuous
+// filter: subtype bits, the software management-subtype check, and how much
+// of a typical 2.4GHz traffic mix each mode's union lets through.
+
+#include <unity.h>
+#include <cstdio>
+#include "../../src/core/frame_interest.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+using namespace FrameInterest;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x2468ACE1u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint8_t fc0ForSubtype(uint8_t type, uint8_t subtype) {
+    return (uint8_t)((subtype << 4) | (type == kTypeData ? 0x08 : type == kTypeCtrl ? 0x04 : 0x00));
+}
+
+// Mirrors NetworkRecon: the driver drops whole types, the callback drops
+// management subtypes. Returns 0 = driver filtered, 1 = callback dropped,
+// 2 = reaches the RX ring.
+static int route(uint32_t interest, uint8_t type, uint8_t fc0) {
+    if (type == kTypeMgmt && !wantsMgmt(interest)) return 0;
+    if (type == kTypeData && !wantsData(interest)) return 0;
+    if (type == kTypeCtrl && !wantsCtrl(interest)) return 0;
+    return accepts(interest, type, fc0) ? 2 : 1;
+}
+
+struct MixEntry {
+    uint8_t type;
+    uint8_t subtype;
+    uint8_t weight;   // Percent of frames
+};
+
+// Rough busy-channel mix: ACK/RTS/CTS/BlockAck dominate, beacons and
+// probe traffic next, then data and action frames
+static const MixEntry TRAFFIC_MIX[] = {
+    {kTypeCtrl, 13, 22},  // ACK
+    {kTypeCtrl, 11, 6},   // RTS
+    {kTypeCtrl, 12, 6},   // CTS
+    {kTypeCtrl, 9, 4},    // BlockAck
+    {kTypeMgmt, 8, 20},   // Beacon
+    {kTypeMgmt, 4, 9},    // Probe request
+    {kTypeMgmt, 5, 7},    // Probe response
+    {kTypeMgmt, 13, 4},   // Action
+    {kTypeMgmt, 11, 1},   // Auth
+    {kTypeMgmt, 0, 1},    // Assoc request
+    {kTypeData, 0, 12},   // Data
+    {kTypeData, 4, 5},    // Null data
+    {kTypeData, 8, 3},    // QoS data
+};
+
+static const MixEntry& sampleMix() {
+    uint32_t r = nextRand() % 100;
+    for (const MixEntry& e : TRAFFIC_MIX) {
+        if (r < e.weight) return e;
+        r -= e.weight;
+    }
+    return TRAFFIC_MIX[0];
+}
+
+// ============================================================================
+// Masks
+// ============================================================================
+
+void test_subtypeBits_matchFrameControl(void) {
+    TEST_ASSERT_EQUAL_HEX32(1u << 8, kBeacon);
+    TEST_ASSERT_EQUAL_HEX32(1u << 5, kProbeResp);
+    TEST_ASSERT_EQUAL_HEX32(1u << 0, kAssocReq);
+    TEST_ASSERT_EQUAL_HEX32(1u << 2, kReassocReq);
+    TEST_ASSERT_EQUAL_HEX32(0, mgmt(16));
+    TEST_ASSERT_EQUAL_HEX32(0, kData & kMgmtAll);
+    TEST_ASSERT_EQUAL_HEX32(0, kCtrl & kMgmtAll);
+}
+
+void test_reconMask_coversWhatReconParses(void) {
+    TEST_ASSERT_TRUE(accepts(kRecon, kTypeMgmt, 0x80));   // Beacon
+    TEST_ASSERT_TRUE(accepts(kRecon, kTypeMgmt, 0x50));   // Probe response
+    TEST_ASSERT_TRUE(accepts(kRecon, kTypeMgmt, 0x00));   // Assoc request
+    TEST_ASSERT_TRUE(accepts(kRecon, kTypeMgmt, 0x20));   // Reassoc request
+    TEST_ASSERT_TRUE(accepts(kRecon, kTypeData, 0x08));
+    TEST_ASSERT_FALSE(accepts(kRecon, kTypeMgmt, 0x40));  // Probe request
+    TEST_ASSERT_FALSE(accepts(kRecon, kTypeMgmt, 0xD0));  // Action
+    TEST_ASSERT_FALSE(wantsCtrl(kRecon));
+}
+
+void test_accepts_ignoresFlagBits(void) {
+    // Low nibble (type/version) must not affect the subtype check
+    TEST_ASSERT_TRUE(accepts(kBeacon, kTypeMgmt, 0x80));
+    TEST_ASSERT_TRUE(accepts(kBeacon, kTypeMgmt, 0x83));
+    TEST_ASSERT_FALSE(accepts(kBeacon, kTypeMgmt, 0x90));
+}
+
+void test_accepts_miscAlwaysPasses(void) {
+    TEST_ASSERT_TRUE(accepts(0, 3, 0));
+}
+
+void test_all_acceptsEverything(void) {
+    for (int type = 0; type < 3; type++) {
+        for (int sub = 0; sub < 16; sub++) {
+            TEST_ASSERT_EQUAL_INT(2, route(kAll, (uint8_t)type, fc0ForSubtype((uint8_t)type, (uint8_t)sub)));
+        }
+    }
+}
+
+void test_union_neverLosesModeFrames(void) {
+    // Whatever a mode asks for must survive the union with recon's mask
+    const uint32_t modes[] = {
+        kBeacon | kData,                     // OINK
+        kBeacon | kProbeResp | kData,        // DO NO HAM
+        kAll,                                // SPECTRUM
+        kDeauth | kCtrl,
+    };
+    for (uint32_t mode : modes) {
+        uint32_t u = kRecon | mode;
+        for (int type = 0; type < 3; type++) {
+            for (int sub = 0; sub < 16; sub++) {
+                uint8_t fc0 = fc0ForSubtype((uint8_t)type, (uint8_t)sub);
+                if (route(mode, (uint8_t)type, fc0) == 2) {
+                    TEST_ASSERT_EQUAL_INT(2, route(u, (uint8_t)type, fc0));
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Reduction on a traffic mix
+// ============================================================================
+
+void test_reduction_onTrafficMix(void) {
+    struct Case { const char* name; uint32_t mode; };
+    const Case cases[] = {
+        {"idle", 0},
+        {"oink", kBeacon | kData},
+        {"dnh", kBeacon | kProbeResp | kData},
+        {"spectrum", kAll},
+    };
+    const int frames = 100000;
+
+    for (const Case& c : cases) {
+        uint32_t interest = kRecon | c.mode;
+        int callbacks = 0, ring = 0;
+        rngState = 0x2468ACE1u;
+        for (int i = 0; i < frames; i++) {
+            const MixEntry& e = sampleMix();
+            int r = route(interest, e.type, fc0ForSubtype(e.type, e.subtype));
+            if (r >= 1) callbacks++;
+            if (r == 2) ring++;
+        }
+        char msg[128];
+        snprintf(msg, sizeof(msg), "%-8s callbacks=%5.1f%% ring=%5.1f%% of %d frames",
+                 c.name, callbacks * 100.0 / frames, ring * 100.0 / frames, frames);
+        TEST_MESSAGE(msg);
+
+        if (c.mode == kAll) {
+            TEST_ASSERT_EQUAL_INT(frames, ring);
+        } else {
+            // No control frames requested: the driver drops them outright
+            TEST_ASSERT_TRUE(callbacks < frames * 7 / 10);
+            TEST_ASSERT_TRUE(ring < callbacks);
+        }
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Masks
+    RUN_TEST(test_subtypeBits_matchFrameControl);
+    RUN_TEST(test_reconMask_coversWhatReconParses);
+    RUN_TEST(test_accepts_ignoresFlagBits);
+    RUN_TEST(test_accepts_miscAlwaysPasses);
+    RUN_TEST(test_all_acceptsEverything);
+    RUN_TEST(test_union_neverLosesModeFrames);
+
+    // Reduction
+    RUN_TEST(test_reduction_onTrafficMix);
+
+    return UNITY_END();
+}
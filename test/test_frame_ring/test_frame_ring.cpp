@@ -0,0 +1,345 @@
+// Frame Ring Tests
+// Tests the SPSC variable-length record ring between the WiFi driver
+// callback and the NetworkRecon worker task: layout, wrap handling,
+// overrun accounting, and a two-thread producer/consumer stress run.
+
+#include <unity.h>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+#include "../../src/core/frame_ring.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Stand-in for wifi_pkt_rx_ctrl_t (size is what matters for layout)
+struct FakeRxCtrl {
+    uint32_t word[12];
+};
+
+alignas(4) static uint8_t storage[4096];
+
+static uint32_t rngState = 0x9E3779B9u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void fillPattern(uint8_t* out, uint16_t len, uint32_t seed) {
+    for (uint16_t i = 0; i < len; i++) {
+        out[i] = (uint8_t)(seed * 31u + i * 7u);
+    }
+}
+
+static bool checkPattern(const uint8_t* in, uint16_t len, uint32_t seed) {
+    for (uint16_t i = 0; i < len; i++) {
+        if (in[i] != (uint8_t)(seed * 31u + i * 7u)) return false;
+    }
+    return true;
+}
+
+static uint32_t recordSize(uint16_t bodyLen) {
+    return (FrameRing::kRecordHeader + bodyLen + 3u) & ~3u;
+}
+
+// ============================================================================
+// Basic operations
+// ============================================================================
+
+void test_empty_peekReturnsNull(void) {
+    FrameRing ring;
+    ring.attach(storage, sizeof(storage));
+    uint16_t len;
+    uint8_t type, flags;
+    TEST_ASSERT_NULL(ring.peek(len, type, flags));
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.usedBytes());
+}
+
+void test_unattached_dropsEverything(void) {
+    FrameRing ring;
+    uint8_t payload[8] = {0};
+    TEST_ASSERT_FALSE(ring.attached());
+    TEST_ASSERT_FALSE(ring.push(0, 0, nullptr, 0, payload, sizeof(payload)));
+    TEST_ASSERT_EQUAL_UINT32(1, ring.getDropped());
+}
+
+void test_pushPeekPop_roundTrip(void) {
+    FrameRing ring;
+    ring.attach(storage, sizeof(storage));
+
+    FakeRxCtrl ctrl;
+    for (int i = 0; i < 12; i++) ctrl.word[i] = 0xA0000000u + i;
+    uint8_t payload[100];
+    fillPattern(payload, sizeof(payload), 7);
+
+    TEST_ASSERT_TRUE(ring.push(2, FrameRing::kFlagTruncated, &ctrl, sizeof(ctrl),
+                               payload, sizeof(payload)));
+
+    uint16_t len;
+    uint8_t type, flags;
+    const uint8_t* body = ring.peek(len, type, flags);
+    TEST_ASSERT_NOT_NULL(body);
+    TEST_ASSERT_EQUAL_UINT8(2, type);
+    TEST_ASSERT_EQUAL_UINT8(FrameRing::kFlagTruncated, flags);
+    TEST_ASSERT_TRUE(len >= sizeof(ctrl) + sizeof(payload));
+    TEST_ASSERT_EQUAL_MEMORY(&ctrl, body, sizeof(ctrl));
+    TEST_ASSERT_TRUE(checkPattern(body + sizeof(ctrl), sizeof(payload), 7));
+
+    ring.pop();
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_EQUAL_UINT32(1, ring.getPushed());
+    TEST_ASSERT_EQUAL_UINT32(1, ring.getPopped());
+}
+
+void test_body_isFourByteAligned(void) {
+    FrameRing ring;
+    ring.attach(storage, sizeof(storage));
+    uint8_t payload[37];
+    fillPattern(payload, sizeof(payload), 1);
+
+    // Odd payload sizes must not misalign the next record's rx_ctrl
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(ring.push(0, 0, nullptr, 0, payload, (uint16_t)(sizeof(payload) - i)));
+    }
+    for (int i = 0; i < 5; i++) {
+        uint16_t len;
+        uint8_t type, flags;
+        const uint8_t* body = ring.peek(len, type, flags);
+        TEST_ASSERT_NOT_NULL(body);
+        TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)body & 3u);
+        ring.pop();
+    }
+}
+
+void test_fifoOrder_preserved(void) {
+    FrameRing ring;
+    ring.attach(storage, sizeof(storage));
+    for (uint32_t i = 0; i < 20; i++) {
+        TEST_ASSERT_TRUE(ring.push((uint8_t)i, 0, &i, sizeof(i), nullptr, 0));
+    }
+    for (uint32_t i = 0; i < 20; i++) {
+        uint16_t len;
+        uint8_t type, flags;
+        const uint8_t* body = ring.peek(len, type, flags);
+        TEST_ASSERT_NOT_NULL(body);
+        uint32_t v;
+        memcpy(&v, body, sizeof(v));
+        TEST_ASSERT_EQUAL_UINT32(i, v);
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)i, type);
+        ring.pop();
+    }
+}
+
+// ============================================================================
+// Capacity / wrap
+// ============================================================================
+
+void test_full_dropsAndCounts(void) {
+    FrameRing ring;
+    ring.attach(storage, 256);
+    uint8_t payload[60];
+    fillPattern(payload, sizeof(payload), 3);
+
+    uint32_t accepted = 0;
+    for (int i = 0; i < 10; i++) {
+        if (ring.push(0, 0, nullptr, 0, payload, sizeof(payload))) accepted++;
+    }
+    // 64-byte records in 256 bytes: one slot is sacrificed so full != empty
+    TEST_ASSERT_EQUAL_UINT32(3, accepted);
+    TEST_ASSERT_EQUAL_UINT32(7, ring.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(192, ring.getHighWater());
+}
+
+void test_exactFillToEnd_withTailAtZero_isRejected(void) {
+    FrameRing ring;
+    ring.attach(storage, 128);
+    uint8_t payload[124];
+    // Record would end exactly at capacity while tail == 0 -> head == tail
+    TEST_ASSERT_FALSE(ring.push(0, 0, nullptr, 0, payload, sizeof(payload)));
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_wrap_recordStaysContiguous(void) {
+    FrameRing ring;
+    ring.attach(storage, 256);
+    uint8_t payload[92];
+
+    // Advance head/tail to offset 192 so the next 96-byte record can't fit
+    for (uint32_t i = 0; i < 2; i++) {
+        fillPattern(payload, sizeof(payload), i);
+        TEST_ASSERT_TRUE(ring.push(0, 0, nullptr, 0, payload, sizeof(payload)));
+        uint16_t len;
+        uint8_t type, flags;
+        TEST_ASSERT_NOT_NULL(ring.peek(len, type, flags));
+        ring.pop();
+    }
+    uint8_t small[60];
+    fillPattern(small, sizeof(small), 99);
+    TEST_ASSERT_TRUE(ring.push(0, 0, nullptr, 0, small, 0));  // 4-byte record at 192
+    uint16_t len;
+    uint8_t type, flags;
+    TEST_ASSERT_NOT_NULL(ring.peek(len, type, flags));
+    ring.pop();
+
+    fillPattern(payload, sizeof(payload), 42);
+    TEST_ASSERT_TRUE(ring.push(5, 0, nullptr, 0, payload, sizeof(payload)));
+    const uint8_t* body = ring.peek(len, type, flags);
+    TEST_ASSERT_NOT_NULL(body);
+    TEST_ASSERT_TRUE(body == storage + FrameRing::kRecordHeader);  // Wrapped to 0
+    TEST_ASSERT_EQUAL_UINT8(5, type);
+    TEST_ASSERT_TRUE(checkPattern(body, sizeof(payload), 42));
+    ring.pop();
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_wasEmpty_onlyOnTransition(void) {
+    FrameRing ring;
+    ring.attach(storage, sizeof(storage));
+    uint8_t payload[16] = {0};
+    bool wasEmpty = false;
+    TEST_ASSERT_TRUE(ring.push(0, 0, nullptr, 0, payload, sizeof(payload), &wasEmpty));
+    TEST_ASSERT_TRUE(wasEmpty);
+    TEST_ASSERT_TRUE(ring.push(0, 0, nullptr, 0, payload, sizeof(payload), &wasEmpty));
+    TEST_ASSERT_FALSE(wasEmpty);
+}
+
+void test_randomSequence_matchesReferenceQueue(void) {
+    FrameRing ring;
+    ring.attach(storage, 1024);
+    std::deque<std::pair<uint32_t, uint16_t>> ref;
+    uint8_t payload[300];
+    uint32_t seq = 0;
+    uint32_t drops = 0;
+
+    for (int step = 0; step < 20000; step++) {
+        if ((nextRand() % 3) != 0) {
+            uint16_t plen = (uint16_t)(nextRand() % sizeof(payload));
+            fillPattern(payload, plen, seq);
+            if (ring.push((uint8_t)(seq & 0xFF), 0, &seq, sizeof(seq), payload, plen)) {
+                ref.push_back({seq, plen});
+            } else {
+                drops++;
+            }
+            seq++;
+        } else {
+            uint16_t len;
+            uint8_t type, flags;
+            const uint8_t* body = ring.peek(len, type, flags);
+            if (ref.empty()) {
+                TEST_ASSERT_NULL(body);
+                continue;
+            }
+            TEST_ASSERT_NOT_NULL(body);
+            uint32_t gotSeq;
+            memcpy(&gotSeq, body, sizeof(gotSeq));
+            TEST_ASSERT_EQUAL_UINT32(ref.front().first, gotSeq);
+            TEST_ASSERT_EQUAL_UINT32(recordSize(sizeof(uint32_t) + ref.front().second),
+                                     (uint32_t)len + FrameRing::kRecordHeader);
+            TEST_ASSERT_TRUE(checkPattern(body + sizeof(uint32_t), ref.front().second, gotSeq));
+            ring.pop();
+            ref.pop_front();
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(drops, ring.getDropped());
+    TEST_ASSERT_TRUE(drops > 0);  // 1KB ring under 2:1 push bias must overrun
+}
+
+// ============================================================================
+// Concurrency
+// ============================================================================
+
+void test_twoThreads_noCorruptionOrReorder(void) {
+    static uint8_t big[12288];
+    FrameRing ring;
+    ring.attach(big, sizeof(big));
+    const uint32_t kFrames = 200000;
+
+    struct StressHdr {
+        uint32_t seq;
+        uint32_t plen;
+    };
+
+    std::thread producer([&]() {
+        uint8_t payload[1600];
+        uint32_t localRng = 0xC0FFEEu;
+        for (uint32_t seq = 0; seq < kFrames; seq++) {
+            localRng = localRng * 1664525u + 1013904223u;
+            StressHdr hdr = {seq, (uint32_t)((localRng >> 8) % sizeof(payload))};
+            fillPattern(payload, (uint16_t)hdr.plen, seq);
+            ring.push(0, 0, &hdr, sizeof(hdr), payload, (uint16_t)hdr.plen);
+            if ((seq & 7) == 0) std::this_thread::yield();  // Bursty, like a busy channel
+        }
+    });
+
+    uint32_t received = 0;
+    uint32_t lastSeq = 0;
+    bool ordered = true;
+    bool intact = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (std::chrono::steady_clock::now() < deadline) {
+        uint16_t len;
+        uint8_t type, flags;
+        const uint8_t* body = ring.peek(len, type, flags);
+        if (!body) {
+            if (ring.getPushed() + ring.getDropped() == kFrames && ring.empty()) break;
+            std::this_thread::yield();
+            continue;
+        }
+        StressHdr hdr;
+        memcpy(&hdr, body, sizeof(hdr));
+        if (received > 0 && hdr.seq <= lastSeq) ordered = false;
+        if (hdr.plen + sizeof(hdr) > len ||
+            !checkPattern(body + sizeof(hdr), (uint16_t)hdr.plen, hdr.seq)) {
+            intact = false;
+        }
+        lastSeq = hdr.seq;
+        received++;
+        ring.pop();
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_TRUE(intact);
+    TEST_ASSERT_EQUAL_UINT32(kFrames, ring.getPushed() + ring.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(ring.getPushed(), received);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "stress: %u frames, %u delivered, %u dropped, high water %u/%u bytes",
+             (unsigned)kFrames, (unsigned)received, (unsigned)ring.getDropped(),
+             (unsigned)ring.getHighWater(), (unsigned)ring.capacity());
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Basic operations
+    RUN_TEST(test_empty_peekReturnsNull);
+    RUN_TEST(test_unattached_dropsEverything);
+    RUN_TEST(test_pushPeekPop_roundTrip);
+    RUN_TEST(test_body_isFourByteAligned);
+    RUN_TEST(test_fifoOrder_preserved);
+
+    // Capacity / wrap
+    RUN_TEST(test_full_dropsAndCounts);
+    RUN_TEST(test_exactFillToEnd_withTailAtZero_isRejected);
+    RUN_TEST(test_wrap_recordStaysContiguous);
+    RUN_TEST(test_wasEmpty_onlyOnTransition);
+    RUN_TEST(test_randomSequence_matchesReferenceQueue);
+
+    // Concurrency
+    RUN_TEST(test_twoThreads_noCorruptionOrReorder);
+
+    return UNITY_END();
+}
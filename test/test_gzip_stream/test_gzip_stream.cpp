@@ -0,0 +1,319 @@
+// Gzip Stream Tests
+// Tests the bounded-memory gzip compressor used for WiGLE uploads: window
+// sizing, round trips through an independent fixed-Huffman inflater
+// (RFC 1951/1952, written from the spec here) for empty, random, run-heavy
+// and multi-window inputs, identical output at any write chunking, sink
+// failures, and the ratio / speed on rendered WiGLE CSV per window size.
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../../src/core/gzip_stream.h"
+#include "../../src/core/wardrive_format.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0xA5A5F00Du;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint8_t block[GzipStream::stateBytes(GzipStream::kMaxWindow)];
+
+struct VectorSink {
+    std::vector<uint8_t> data;
+    bool operator()(const uint8_t* p, size_t n) {
+        data.insert(data.end(), p, p + n);
+        return true;
+    }
+};
+
+static std::vector<uint8_t> gzipAll(const std::string& in, size_t stateBytes, size_t chunk) {
+    GzipStream gz;
+    TEST_ASSERT_TRUE(gz.attach(block, stateBytes));
+    gz.begin();
+    VectorSink sink;
+    for (size_t off = 0; off < in.size(); off += chunk) {
+        size_t n = in.size() - off < chunk ? in.size() - off : chunk;
+        TEST_ASSERT_TRUE(gz.write((const uint8_t*)in.data() + off, n, sink));
+    }
+    TEST_ASSERT_TRUE(gz.finish(sink));
+    TEST_ASSERT_EQUAL_UINT32(in.size(), gz.bytesIn());
+    TEST_ASSERT_EQUAL_UINT32(sink.data.size(), gz.bytesOut());
+    return sink.data;
+}
+
+// Minimal gunzip for fixed-Huffman blocks (all GzipStream emits)
+struct Inflater {
+    const std::vector<uint8_t>& in;
+    size_t bytePos = 10;
+    uint32_t bitPos = 0;
+    bool bad = false;
+
+    explicit Inflater(const std::vector<uint8_t>& src) : in(src) {}
+
+    uint32_t bit() {
+        if (bytePos >= in.size()) {
+            bad = true;
+            return 0;
+        }
+        uint32_t b = (in[bytePos] >> bitPos) & 1;
+        if (++bitPos == 8) {
+            bitPos = 0;
+            bytePos++;
+        }
+        return b;
+    }
+
+    uint32_t bits(int n) {  // LSB-first value
+        uint32_t v = 0;
+        for (int i = 0; i < n; i++) v |= bit() << i;
+        return v;
+    }
+
+    uint32_t code(int n) {  // MSB-first Huffman code
+        uint32_t v = 0;
+        for (int i = 0; i < n; i++) v = (v << 1) | bit();
+        return v;
+    }
+
+    int symbol() {
+        uint32_t c = code(7);
+        if (c <= 0x17) return 256 + (int)c;
+        c = (c << 1) | bit();
+        if (c >= 0x30 && c <= 0xBF) return (int)(c - 0x30);
+        if (c >= 0xC0 && c <= 0xC7) return 280 + (int)(c - 0xC0);
+        c = (c << 1) | bit();
+        if (c >= 0x190 && c <= 0x1FF) return 144 + (int)(c - 0x190);
+        bad = true;
+        return 256;
+    }
+
+    bool run(std::string& out) {
+        static const uint16_t lenBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                             35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const uint8_t lenExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                             3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const uint16_t distBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                              257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                              8193, 12289, 16385, 24577};
+        static const uint8_t distExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                              7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        if (in.size() < 18 || in[0] != 0x1F || in[1] != 0x8B || in[2] != 8 || in[3] != 0) return false;
+        bool last = false;
+        while (!last && !bad) {
+            last = bit() != 0;
+            if (bits(2) != 1) return false;
+            for (;;) {
+                int sym = symbol();
+                if (bad) return false;
+                if (sym < 256) {
+                    out.push_back((char)sym);
+                } else if (sym == 256) {
+                    break;
+                } else {
+                    int li = sym - 257;
+                    if (li > 28) return false;
+                    size_t len = lenBase[li] + bits(lenExtra[li]);
+                    uint32_t di = code(5);
+                    if (di > 29) return false;
+                    size_t dist = distBase[di] + bits(distExtra[di]);
+                    if (dist > out.size()) return false;
+                    for (size_t i = 0; i < len; i++) out.push_back(out[out.size() - dist]);
+                }
+            }
+        }
+        if (bitPos) bytePos++;
+        if (bytePos + 8 != in.size()) return false;
+        uint32_t crc = 0, isize = 0;
+        for (int i = 0; i < 4; i++) crc |= (uint32_t)in[bytePos + i] << (8 * i);
+        for (int i = 0; i < 4; i++) isize |= (uint32_t)in[bytePos + 4 + i] << (8 * i);
+        return crc == Crc32::compute((const uint8_t*)out.data(), out.size()) && isize == out.size();
+    }
+};
+
+static void assertRoundTrip(const std::string& in, size_t stateBytes, size_t chunk) {
+    std::vector<uint8_t> gz = gzipAll(in, stateBytes, chunk);
+    std::string out;
+    Inflater inf(gz);
+    TEST_ASSERT_TRUE(inf.run(out));
+    TEST_ASSERT_EQUAL_UINT32(in.size(), out.size());
+    TEST_ASSERT_TRUE(out == in);
+}
+
+// Rendered WiGLE CSV for a drive: consecutive sightings share time and
+// coordinate prefixes like a real session log
+static std::string wigleDrive(int records) {
+    char line[WardriveFormat::Renderer::kLineBytes];
+    WardriveFormat::renderHeader(WardriveFormat::Output::Wigle, "0.1.8", line, sizeof(line));
+    std::string csv = line;
+    double lat = 37.7749, lon = -122.4194;
+    uint32_t epoch = 1792154096u;
+    static const char* names[] = {"NETGEAR", "xfinitywifi", "linksys", "ATT", "Home", "DIRECT-"};
+    for (int i = 0; i < records; i++) {
+        uint8_t bssid[6];
+        for (int b = 0; b < 6; b++) bssid[b] = (uint8_t)nextRand();
+        char ssid[33];
+        snprintf(ssid, sizeof(ssid), "%s%u", names[nextRand() % 6], (unsigned)(nextRand() % 1000));
+        if (nextRand() % 5 == 0) ssid[0] = '\0';
+        static const uint8_t auths[] = {0, 3, 3, 3, 4, 6, 7};
+        lat += 0.00003 * (nextRand() % 3);
+        lon -= 0.00004 * (nextRand() % 3);
+        epoch += nextRand() % 2;
+        WardriveFormat::Record r = WardriveFormat::makeRecord(
+            bssid, ssid, (int8_t)(-40 - (int)(nextRand() % 55)), (uint8_t)(1 + nextRand() % 11),
+            auths[nextRand() % 7], lat, lon, 12.0 + (nextRand() % 50) / 10.0,
+            5.0 + (nextRand() % 20) / 2.0, epoch, 0);
+        WardriveFormat::renderRecord(WardriveFormat::Output::Wigle, r, line, sizeof(line));
+        csv += line;
+    }
+    return csv;
+}
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+void test_attach_largestWindowThatFits(void) {
+    GzipStream gz;
+    TEST_ASSERT_TRUE(gz.attach(block, sizeof(block)));
+    TEST_ASSERT_EQUAL_UINT32(16384, gz.getWindow());
+    TEST_ASSERT_TRUE(gz.attach(block, GzipStream::stateBytes(4096) + 100));
+    TEST_ASSERT_EQUAL_UINT32(4096, gz.getWindow());
+    TEST_ASSERT_EQUAL_UINT32(12288, GzipStream::stateBytes(4096));
+    TEST_ASSERT_FALSE(gz.attach(block, GzipStream::stateBytes(1024) - 1));
+    TEST_ASSERT_FALSE(gz.attach(nullptr, sizeof(block)));
+
+    VectorSink sink;
+    gz.begin();
+    TEST_ASSERT_FALSE(gz.write((const uint8_t*)"x", 1, sink));
+    TEST_ASSERT_TRUE(gz.hasFailed());
+}
+
+// ============================================================================
+// Round trips
+// ============================================================================
+
+void test_roundTrip_emptyAndTiny(void) {
+    std::vector<uint8_t> gz = gzipAll("", sizeof(block), 1);
+    TEST_ASSERT_EQUAL_UINT32(21, gz.size());  // Header, 20 bits of blocks, trailer
+    std::string out;
+    Inflater inf(gz);
+    TEST_ASSERT_TRUE(inf.run(out));
+    TEST_ASSERT_EQUAL_UINT32(0, out.size());
+
+    assertRoundTrip("a", sizeof(block), 1);
+    assertRoundTrip("abcd", sizeof(block), 1);
+    assertRoundTrip("abcdabcdabcd", sizeof(block), 5);
+}
+
+void test_roundTrip_randomRunsAndManyWindows(void) {
+    std::string random, runs, mixed;
+    for (int i = 0; i < 70000; i++) random.push_back((char)nextRand());
+    for (int i = 0; i < 70000; i++) runs.push_back((char)('a' + (i / 1000) % 3));
+    for (int i = 0; i < 70000; i++) {
+        if (nextRand() % 4 == 0 && mixed.size() > 600) {
+            size_t back = 1 + nextRand() % 600;
+            mixed.push_back(mixed[mixed.size() - back]);
+        } else {
+            mixed.push_back((char)(nextRand() % 256));
+        }
+    }
+    for (size_t window : {1024u, 4096u, 16384u}) {
+        size_t bytes = GzipStream::stateBytes(window);
+        assertRoundTrip(random, bytes, 4096);
+        assertRoundTrip(runs, bytes, 777);
+        assertRoundTrip(mixed, bytes, 1);
+    }
+
+    // Runs collapse to max-length matches: ~3 bytes per 258
+    std::vector<uint8_t> gz = gzipAll(runs, GzipStream::stateBytes(4096), 4096);
+    TEST_ASSERT_TRUE(gz.size() < runs.size() / 50);
+}
+
+void test_output_sameForAnyChunking(void) {
+    std::string csv = wigleDrive(400);
+    std::vector<uint8_t> ref = gzipAll(csv, GzipStream::stateBytes(4096), csv.size());
+    for (size_t chunk : {1u, 3u, 255u, 2048u, 8193u}) {
+        TEST_ASSERT_TRUE(gzipAll(csv, GzipStream::stateBytes(4096), chunk) == ref);
+    }
+}
+
+void test_sinkFailure_stopsStream(void) {
+    GzipStream gz;
+    gz.attach(block, GzipStream::stateBytes(2048));
+    gz.begin();
+    size_t accepted = 0;
+    auto sink = [&accepted](const uint8_t*, size_t n) {
+        if (accepted > 1000) return false;
+        accepted += n;
+        return true;
+    };
+    std::string random;
+    for (int i = 0; i < 20000; i++) random.push_back((char)nextRand());
+    bool ok = gz.write((const uint8_t*)random.data(), random.size(), sink);
+    ok = gz.finish(sink) && ok;
+    TEST_ASSERT_FALSE(ok);
+    TEST_ASSERT_TRUE(gz.hasFailed());
+    TEST_ASSERT_FALSE(gz.write((const uint8_t*)"x", 1, sink));
+}
+
+// ============================================================================
+// WiGLE CSV
+// ============================================================================
+
+void test_wigleCsv_ratioAndSpeedPerWindow(void) {
+    std::string csv = wigleDrive(6000);
+    double ratio4k = 0;
+    for (size_t window : {1024u, 2048u, 4096u, 8192u, 16384u}) {
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<uint8_t> gz = gzipAll(csv, GzipStream::stateBytes(window), 2048);
+        auto t1 = std::chrono::steady_clock::now();
+        double ratio = (double)csv.size() / gz.size();
+        double mbps = csv.size() / std::chrono::duration<double>(t1 - t0).count() / 1e6;
+        if (window == 4096) ratio4k = ratio;
+
+        std::string out;
+        Inflater inf(gz);
+        TEST_ASSERT_TRUE(inf.run(out));
+        TEST_ASSERT_TRUE(out == csv);
+
+        char msg[160];
+        snprintf(msg, sizeof(msg), "window %5u (%5u B state): %u -> %u bytes, %.2fx, %.0f MB/s host",
+                 (unsigned)window, (unsigned)GzipStream::stateBytes(window),
+                 (unsigned)csv.size(), (unsigned)gz.size(), ratio, mbps);
+        TEST_MESSAGE(msg);
+    }
+    TEST_ASSERT_TRUE(ratio4k > 2.5);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Setup
+    RUN_TEST(test_attach_largestWindowThatFits);
+
+    // Round trips
+    RUN_TEST(test_roundTrip_emptyAndTiny);
+    RUN_TEST(test_roundTrip_randomRunsAndManyWindows);
+    RUN_TEST(test_output_sameForAnyChunking);
+    RUN_TEST(test_sinkFailure_stopsStream);
+
+    // WiGLE CSV
+    RUN_TEST(test_wigleCsv_ratioAndSpeedPerWindow);
+
+    return UNITY_END();
+}
@@ -0,0 +1,377 @@
+// Hashcat 22000 Dedupe Tests
+// Tests the pieces behind the merged 22000 export: record keys parsed from
+// hash lines, line splitting across read chunks, the fixed fingerprint
+// table, and a multi-pass 50k-line merge checked against std::set.
+
+#include <unity.h>
+#include <cstdio>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <set>
+#include <chrono>
+#include "../../src/core/hc22000_dedupe.h"
+#include "../../src/core/hc22000_encoder.h"
+
+using Hc22000Dedupe::FingerprintSet;
+using Hc22000Dedupe::LineSplitter;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x68E31DA4u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static const char* PMKID_LINE =
+    "WPA*01*4d4fe7aac3a2cecab195321ceb99a7d0*fc690c158264*f4747f87f9f4*"
+    "686173686361742d6573736964***01";
+
+static uint64_t keyOf(const std::string& line) {
+    uint64_t key = 0;
+    TEST_ASSERT_TRUE(Hc22000Dedupe::lineKey(line.c_str(), line.size(), key));
+    return key;
+}
+
+static bool parses(const std::string& line) {
+    uint64_t key;
+    return Hc22000Dedupe::lineKey(line.c_str(), line.size(), key);
+}
+
+// Capture record: the fields the key covers plus what it ignores
+struct Record {
+    uint8_t type;        // 1 = PMKID, 2 = EAPOL
+    uint8_t hash[16];
+    uint8_t ap[6];
+    uint8_t sta[6];
+    char ssid[33];
+};
+
+static Record randomRecord() {
+    Record r;
+    r.type = (nextRand() & 1) ? 1 : 2;
+    for (auto& b : r.hash) b = (uint8_t)nextRand();
+    for (auto& b : r.ap) b = (uint8_t)nextRand();
+    for (auto& b : r.sta) b = (uint8_t)nextRand();
+    int len = 1 + nextRand() % 32;
+    for (int i = 0; i < len; i++) r.ssid[i] = (char)('a' + nextRand() % 26);
+    r.ssid[len] = 0;
+    return r;
+}
+
+// Encoded the way OINK writes it
+static std::string encode(const Record& r) {
+    static char line[Hc22000Encoder::kMaxHandshakeLine];
+    size_t n;
+    if (r.type == 1) {
+        n = Hc22000Encoder::encodePmkid(line, sizeof(line), r.hash, r.ap, r.sta, r.ssid, strlen(r.ssid));
+    } else {
+        uint8_t anonce[32] = {0x11};
+        uint8_t eapol[121] = {0x01, 0x03, 0x00, 0x75};
+        memcpy(eapol + Hc22000Encoder::kMicOffset, r.hash, 16);
+        n = Hc22000Encoder::encodeHandshake(line, sizeof(line), r.ap, r.sta, r.ssid, strlen(r.ssid),
+                                            anonce, eapol, sizeof(eapol), 0x00);
+    }
+    return std::string(line, n);
+}
+
+struct Collected {
+    std::vector<std::string> lines;
+};
+
+static void collect(void* ctx, const char* line, size_t len) {
+    static_cast<Collected*>(ctx)->lines.push_back(std::string(line, len));
+}
+
+// ============================================================================
+// Record keys
+// ============================================================================
+
+void test_lineKey_pmkidAndHandshake(void) {
+    Record r = randomRecord();
+    r.type = 2;
+    TEST_ASSERT_TRUE(parses(PMKID_LINE));
+    TEST_ASSERT_TRUE(parses(encode(r)));
+    TEST_ASSERT_TRUE(keyOf(PMKID_LINE) != 0);
+}
+
+void test_lineKey_caseInsensitive_ignoresTail(void) {
+    std::string upper = PMKID_LINE;
+    for (size_t i = 7; i < 7 + 32 + 1 + 12 + 1 + 12; i++) upper[i] = (char)toupper(upper[i]);
+    TEST_ASSERT_TRUE(keyOf(PMKID_LINE) == keyOf(upper));
+
+    // Different ESSID / message pair: same capture, same key
+    std::string other = std::string(PMKID_LINE).substr(0, 7 + 32 + 1 + 12 + 1 + 12 + 1) + "6f74686572***01";
+    TEST_ASSERT_TRUE(keyOf(PMKID_LINE) == keyOf(other));
+}
+
+void test_lineKey_fieldsDistinguish(void) {
+    uint64_t base = keyOf(PMKID_LINE);
+    std::string typ = PMKID_LINE;  typ[5] = '2';
+    std::string mic = PMKID_LINE;  mic[10] = 'e';
+    std::string ap = PMKID_LINE;   ap[45] = '0';
+    std::string sta = PMKID_LINE;  sta[60] = '0';
+    TEST_ASSERT_TRUE(base != keyOf(typ));
+    TEST_ASSERT_TRUE(base != keyOf(mic));
+    TEST_ASSERT_TRUE(base != keyOf(ap));
+    TEST_ASSERT_TRUE(base != keyOf(sta));
+}
+
+void test_lineKey_rejectsOtherLines(void) {
+    TEST_ASSERT_FALSE(parses(""));
+    TEST_ASSERT_FALSE(parses("# comment"));
+    TEST_ASSERT_FALSE(parses("WPA*03*4d4fe7aac3a2cecab195321ceb99a7d0*fc690c158264*f4747f87f9f4*"));
+    TEST_ASSERT_FALSE(parses("WPA*01*4d4fe7aac3a2cecab195321ceb99a7d*fc690c158264*f4747f87f9f4*"));   // short hash
+    TEST_ASSERT_FALSE(parses("WPA*01*4d4fe7aac3a2cecab195321ceb99a7dz*fc690c158264*f4747f87f9f4*"));  // non-hex
+    TEST_ASSERT_FALSE(parses("WPA*01*4d4fe7aac3a2cecab195321ceb99a7d0*fc690c158264*f4747f87f9f4"));   // truncated
+    TEST_ASSERT_FALSE(parses("WPA*01*4d4fe7aac3a2cecab195321ceb99a7d0*fc690c1582640*f4747f87f9f*"));  // shifted field
+}
+
+// ============================================================================
+// Line splitting
+// ============================================================================
+
+void test_splitter_chunkBoundaries(void) {
+    std::string text = std::string(PMKID_LINE) + "\n\nsecond\r\nthird";
+    char buf[256];
+
+    Collected whole;
+    LineSplitter a;
+    a.attach(buf, sizeof(buf));
+    a.feed(text.c_str(), text.size(), collect, &whole);
+    a.finish(collect, &whole);
+
+    for (size_t step = 1; step < 9; step++) {
+        Collected pieces;
+        LineSplitter b;
+        b.attach(buf, sizeof(buf));
+        for (size_t i = 0; i < text.size(); i += step) {
+            size_t n = text.size() - i < step ? text.size() - i : step;
+            b.feed(text.c_str() + i, n, collect, &pieces);
+        }
+        b.finish(collect, &pieces);
+        TEST_ASSERT_TRUE(whole.lines == pieces.lines);
+    }
+    TEST_ASSERT_EQUAL_INT(4, (int)whole.lines.size());
+    TEST_ASSERT_EQUAL_STRING(PMKID_LINE, whole.lines[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("", whole.lines[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("second", whole.lines[2].c_str());
+    TEST_ASSERT_EQUAL_STRING("third", whole.lines[3].c_str());
+}
+
+void test_splitter_overlongDroppedWhole(void) {
+    char buf[16];
+    LineSplitter s;
+    s.attach(buf, sizeof(buf));
+    Collected out;
+    std::string text = "short\n" + std::string(40, 'x') + "\nafter\n";
+    s.feed(text.c_str(), 10, collect, &out);
+    s.feed(text.c_str() + 10, text.size() - 10, collect, &out);
+    s.finish(collect, &out);
+    TEST_ASSERT_EQUAL_INT(2, (int)out.lines.size());
+    TEST_ASSERT_EQUAL_STRING("short", out.lines[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("after", out.lines[1].c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, s.overlong());
+}
+
+void test_splitter_resetDropsTail(void) {
+    char buf[64];
+    LineSplitter s;
+    s.attach(buf, sizeof(buf));
+    Collected out;
+    s.feed("partial", 7, collect, &out);
+    s.reset();
+    s.feed("next\n", 5, collect, &out);
+    TEST_ASSERT_EQUAL_INT(1, (int)out.lines.size());
+    TEST_ASSERT_EQUAL_STRING("next", out.lines[0].c_str());
+}
+
+// ============================================================================
+// Fingerprint table
+// ============================================================================
+
+void test_set_addDuplicateFull(void) {
+    static uint64_t storage[16];
+    FingerprintSet set;
+    set.attach(storage, 16);
+    TEST_ASSERT_EQUAL_UINT32(12, set.capacity());
+    for (uint64_t k = 1; k <= 12; k++) {
+        TEST_ASSERT_TRUE(set.insert(k * 0x9E3779B97F4A7C15ull) == FingerprintSet::Insert::Added);
+    }
+    TEST_ASSERT_TRUE(set.insert(5 * 0x9E3779B97F4A7C15ull) == FingerprintSet::Insert::Duplicate);
+    TEST_ASSERT_TRUE(set.insert(99) == FingerprintSet::Insert::Full);
+    TEST_ASSERT_EQUAL_UINT32(12, set.size());
+    set.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, set.size());
+    TEST_ASSERT_TRUE(set.insert(99) == FingerprintSet::Insert::Added);
+}
+
+void test_set_roundsDownToPowerOfTwo(void) {
+    static uint64_t storage[100];
+    FingerprintSet set;
+    set.attach(storage, 100);
+    TEST_ASSERT_EQUAL_UINT32(48, set.capacity());
+    FingerprintSet none;
+    none.attach(nullptr, 0);
+    TEST_ASSERT_TRUE(none.insert(1) == FingerprintSet::Insert::Full);
+}
+
+void test_passWidth(void) {
+    const uint64_t space = Hc22000Dedupe::kKeySpace;
+    TEST_ASSERT_TRUE(Hc22000Dedupe::passWidth(0, 3072) == space);
+    TEST_ASSERT_TRUE(Hc22000Dedupe::passWidth(2688, 3072) == space);
+    TEST_ASSERT_TRUE(Hc22000Dedupe::passWidth(2689, 3072) < space);
+    // 50k lines: ~19 slices of ~2.7k keys each
+    uint64_t w = Hc22000Dedupe::passWidth(50000, 3072);
+    TEST_ASSERT_EQUAL_UINT32(19, (uint32_t)((space + w - 1) / w));
+    TEST_ASSERT_TRUE(Hc22000Dedupe::passWidth(0xFFFFFFFFu, 8) >= 1);
+}
+
+// ============================================================================
+// Multi-pass merge
+// ============================================================================
+
+// The HashExport loop over in-memory "files"
+struct MergeState {
+    FingerprintSet* seen;
+    bool first;
+    uint64_t rangeLo;
+    uint64_t rangeHi;
+    uint32_t lines;
+    uint32_t duplicates;
+    uint32_t full;
+    std::vector<std::string>* out;
+};
+
+static void mergeLine(void* ctx, const char* line, size_t len) {
+    MergeState& st = *static_cast<MergeState*>(ctx);
+    uint64_t key;
+    if (!Hc22000Dedupe::lineKey(line, len, key)) return;
+    if (st.first) st.lines++;
+    uint32_t range = Hc22000Dedupe::rangeOf(key);
+    if (range < st.rangeLo || range >= st.rangeHi) return;
+    FingerprintSet::Insert r = st.seen->insert(key);
+    if (r == FingerprintSet::Insert::Duplicate) {
+        st.duplicates++;
+        return;
+    }
+    if (r == FingerprintSet::Insert::Full) st.full++;
+    st.out->push_back(std::string(line, len));
+}
+
+void test_merge_50kLines_exactDedupe(void) {
+    // 35k distinct captures; 15k re-captures of earlier ones (new ESSID
+    // spelling is irrelevant - same key) spread over files of 1-40 lines
+    std::vector<Record> distinct;
+    std::vector<std::string> files;
+    std::string current;
+    int inFile = 0, fileTarget = 1;
+    for (int i = 0; i < 50000; i++) {
+        Record r;
+        if (distinct.size() < 100 || nextRand() % 10 >= 3) {
+            r = randomRecord();
+            distinct.push_back(r);
+        } else {
+            r = distinct[nextRand() % distinct.size()];
+        }
+        current += encode(r) + "\n";
+        if (++inFile >= fileTarget) {
+            files.push_back(current);
+            current.clear();
+            inFile = 0;
+            fileTarget = 1 + nextRand() % 40;
+        }
+    }
+    if (!current.empty()) files.push_back(current);
+
+    std::set<uint64_t> expected;
+    for (const Record& r : distinct) expected.insert(keyOf(encode(r)));
+
+    // 32KB table, as on the device
+    static uint64_t storage[4096];
+    FingerprintSet seen;
+    seen.attach(storage, 4096);
+    uint32_t maxLines = 0;
+    for (const std::string& f : files) {
+        maxLines += (uint32_t)((f.size() + Hc22000Dedupe::kMinLineBytes - 1) / Hc22000Dedupe::kMinLineBytes);
+    }
+
+    static char lineBuf[Hc22000Encoder::kMaxHandshakeLine + 64];
+    LineSplitter splitter;
+    splitter.attach(lineBuf, sizeof(lineBuf));
+    std::vector<std::string> out;
+    MergeState st = {&seen, true, 0, 0, 0, 0, 0, &out};
+    uint32_t peak = 0;
+    unsigned passes = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    while (st.rangeLo < Hc22000Dedupe::kKeySpace) {
+        uint32_t lines = st.first ? maxLines : st.lines;
+        st.rangeHi = st.rangeLo + Hc22000Dedupe::passWidth(lines, seen.capacity());
+        if (st.rangeHi > Hc22000Dedupe::kKeySpace) st.rangeHi = Hc22000Dedupe::kKeySpace;
+        seen.clear();
+        for (const std::string& f : files) {
+            splitter.reset();
+            for (size_t i = 0; i < f.size(); i += 512) {
+                size_t n = f.size() - i < 512 ? f.size() - i : 512;
+                splitter.feed(f.c_str() + i, n, mergeLine, &st);
+            }
+            splitter.finish(mergeLine, &st);
+        }
+        if (seen.size() > peak) peak = seen.size();
+        st.first = false;
+        st.rangeLo = st.rangeHi;
+        passes++;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::set<uint64_t> got;
+    for (const std::string& line : out) got.insert(keyOf(line));
+    TEST_ASSERT_EQUAL_UINT32(0, st.full);
+    TEST_ASSERT_EQUAL_UINT32(expected.size(), out.size());
+    TEST_ASSERT_TRUE(expected == got);
+    TEST_ASSERT_EQUAL_UINT32(50000 - expected.size(), st.duplicates);
+    TEST_ASSERT_EQUAL_UINT32(50000, st.lines);
+    TEST_ASSERT_TRUE(passes <= 21);
+
+    double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%u files, 50000 lines -> %u unique in %u passes, peak %u/%u keys, %.0f ms (host)",
+             (unsigned)files.size(), (unsigned)out.size(), passes,
+             (unsigned)peak, (unsigned)seen.capacity(), ms);
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Record keys
+    RUN_TEST(test_lineKey_pmkidAndHandshake);
+    RUN_TEST(test_lineKey_caseInsensitive_ignoresTail);
+    RUN_TEST(test_lineKey_fieldsDistinguish);
+    RUN_TEST(test_lineKey_rejectsOtherLines);
+
+    // Line splitting
+    RUN_TEST(test_splitter_chunkBoundaries);
+    RUN_TEST(test_splitter_overlongDroppedWhole);
+    RUN_TEST(test_splitter_resetDropsTail);
+
+    // Fingerprint table
+    RUN_TEST(test_set_addDuplicateFull);
+    RUN_TEST(test_set_roundsDownToPowerOfTwo);
+    RUN_TEST(test_passWidth);
+
+    // Multi-pass merge
+    RUN_TEST(test_merge_50kLines_exactDedupe);
+
+    return UNITY_END();
+}
@@ -0,0 +1,302 @@
+// Hashcat 22000 Encoder Tests
+// Tests the WPA*01 / WPA*02 line encoder used by OINK, DO NO HAM and
+// PigSync: golden lines in hcxpcapngtool format, exact length
+// precomputation, rejection of bad input, agreement with the old
+// sprintf-per-byte builder, and encode cost against it.
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include <chrono>
+#include "../../src/core/hc22000_encoder.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x1B873593u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static const uint8_t AP[6] = {0x64, 0x66, 0xb3, 0x8e, 0xc3, 0xfc};
+static const uint8_t STA[6] = {0x22, 0x5e, 0xdc, 0x49, 0xb7, 0xaa};
+static const char SSID[] = "TP-LINK_HASHCAT_TEST";
+
+// Synthetic M1 (ANonce) and M2 (SNonce, MIC, 22-byte RSN IE) EAPOL-Key frames
+struct Frames {
+    uint8_t m1[99];
+    uint8_t m2[121];
+};
+
+static void buildFrames(Frames& f) {
+    static const uint8_t m1Hdr[17] = {0x01, 0x03, 0x00, 0x5f, 0x02, 0x00, 0x8a, 0x00, 0x10,
+                                      0, 0, 0, 0, 0, 0, 0, 0x01};
+    static const uint8_t m2Hdr[17] = {0x01, 0x03, 0x00, 0x75, 0x02, 0x01, 0x0a, 0x00, 0x00,
+                                      0, 0, 0, 0, 0, 0, 0, 0x01};
+    static const uint8_t rsn[22] = {0x30, 0x14, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04,
+                                    0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00,
+                                    0x00, 0x0f, 0xac, 0x02, 0x80, 0x00};
+    memset(&f, 0, sizeof(f));
+    memcpy(f.m1, m1Hdr, sizeof(m1Hdr));
+    memcpy(f.m2, m2Hdr, sizeof(m2Hdr));
+    for (int i = 0; i < 32; i++) {
+        f.m1[17 + i] = (uint8_t)(0x10 + i * 3);   // ANonce
+        f.m2[17 + i] = (uint8_t)(0xa0 + i * 5);   // SNonce
+    }
+    for (int i = 0; i < 16; i++) {
+        f.m2[81 + i] = (uint8_t)(0x3c + i * 11);  // MIC
+    }
+    f.m2[97] = 0x00;
+    f.m2[98] = sizeof(rsn);
+    memcpy(f.m2 + 99, rsn, sizeof(rsn));
+}
+
+// The builder being replaced (OINK / DNH before the encoder)
+static std::string legacyHandshake(const uint8_t* bssid, const uint8_t* station, const char* ssid,
+                                   const uint8_t* nonceFrame, const uint8_t* eapol,
+                                   uint16_t eapolLen, uint8_t msgPair) {
+    char micHex[33], macAP[13], macClient[13], essidHex[65], nonceHex[65];
+    static char eapolHex[1025];
+    uint8_t copy[512];
+    memcpy(copy, eapol, eapolLen);
+    for (int i = 0; i < 16; i++) sprintf(micHex + i*2, "%02x", copy[81 + i]);
+    sprintf(macAP, "%02x%02x%02x%02x%02x%02x",
+            bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+    sprintf(macClient, "%02x%02x%02x%02x%02x%02x",
+            station[0], station[1], station[2], station[3], station[4], station[5]);
+    int ssidLen = strlen(ssid);
+    if (ssidLen > 32) ssidLen = 32;
+    for (int i = 0; i < ssidLen; i++) sprintf(essidHex + i*2, "%02x", (uint8_t)ssid[i]);
+    essidHex[ssidLen * 2] = 0;
+    for (int i = 0; i < 32; i++) sprintf(nonceHex + i*2, "%02x", nonceFrame[17 + i]);
+    memset(copy + 81, 0, 16);
+    for (int i = 0; i < eapolLen; i++) sprintf(eapolHex + i*2, "%02x", copy[i]);
+    eapolHex[eapolLen * 2] = 0;
+    static char line[1300];
+    snprintf(line, sizeof(line), "WPA*02*%s*%s*%s*%s*%s*%s*%02x\n",
+             micHex, macAP, macClient, essidHex, nonceHex, eapolHex, msgPair);
+    return line;
+}
+
+static std::string encodeHs(const Frames& f, const char* ssid, uint8_t msgPair) {
+    static char line[Hc22000Encoder::kMaxHandshakeLine];
+    size_t n = Hc22000Encoder::encodeHandshake(line, sizeof(line), AP, STA, ssid, strlen(ssid),
+                                               f.m1 + Hc22000Encoder::kNonceOffset,
+                                               f.m2, Hc22000Encoder::eapolFrameLength(f.m2, sizeof(f.m2)),
+                                               msgPair);
+    return std::string(line, n);
+}
+
+// ============================================================================
+// Golden lines (hcxpcapngtool format)
+// ============================================================================
+
+void test_golden_pmkid(void) {
+    // Values from the hashcat -m 22000 example hash
+    static const uint8_t pmkid[16] = {0x4d, 0x4f, 0xe7, 0xaa, 0xc3, 0xa2, 0xce, 0xca,
+                                      0xb1, 0x95, 0x32, 0x1c, 0xeb, 0x99, 0xa7, 0xd0};
+    static const uint8_t ap[6] = {0xfc, 0x69, 0x0c, 0x15, 0x82, 0x64};
+    static const uint8_t sta[6] = {0xf4, 0x74, 0x7f, 0x87, 0xf9, 0xf4};
+    const char* ssid = "hashcat-essid";
+    char line[Hc22000Encoder::kMaxPmkidLine];
+    size_t n = Hc22000Encoder::encodePmkid(line, sizeof(line), pmkid, ap, sta, ssid, strlen(ssid));
+    TEST_ASSERT_EQUAL_STRING(
+        "WPA*01*4d4fe7aac3a2cecab195321ceb99a7d0*fc690c158264*f4747f87f9f4*"
+        "686173686361742d6573736964***01\n",
+        std::string(line, n).c_str());
+    TEST_ASSERT_EQUAL_UINT32(Hc22000Encoder::pmkidLineLength(strlen(ssid)), n);
+}
+
+void test_golden_handshake_m1m2(void) {
+    Frames f;
+    buildFrames(f);
+    TEST_ASSERT_EQUAL_STRING(
+        "WPA*02*3c47525d68737e89949faab5c0cbd6e1*6466b38ec3fc*225edc49b7aa*"
+        "54502d4c494e4b5f484153484341545f54455354*"
+        "101316191c1f2225282b2e3134373a3d404346494c4f5255585b5e6164676a6d*"
+        "0103007502010a00000000000000000001a0a5aaafb4b9bec3c8cdd2d7dce1e6"
+        "ebf0f5faff04090e13181d22272c31363b000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000"
+        "00001630140100000fac040100000fac040100000fac028000*00\n",
+        encodeHs(f, SSID, 0x00).c_str());
+}
+
+void test_golden_handshake_m2m3_pair(void) {
+    Frames f;
+    buildFrames(f);
+    std::string line = encodeHs(f, SSID, 0x02);
+    TEST_ASSERT_EQUAL_STRING("*02\n", line.substr(line.size() - 4).c_str());
+}
+
+void test_handshake_micZeroedOnlyInEapol(void) {
+    Frames f;
+    buildFrames(f);
+    uint8_t before[sizeof(f.m2)];
+    memcpy(before, f.m2, sizeof(before));
+    std::string line = encodeHs(f, SSID, 0x00);
+    // Input untouched, MIC present in field 3
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(before, f.m2, sizeof(before));
+    TEST_ASSERT_EQUAL_STRING("3c47525d68737e89949faab5c0cbd6e1", line.substr(7, 32).c_str());
+}
+
+// ============================================================================
+// Lengths / validation
+// ============================================================================
+
+void test_lineLength_isExact(void) {
+    Frames f;
+    buildFrames(f);
+    char ssid[40];
+    for (size_t s = 0; s <= 36; s++) {
+        memset(ssid, 'x', s);
+        ssid[s] = 0;
+        std::string line = encodeHs(f, ssid, 0x00);
+        TEST_ASSERT_EQUAL_UINT32(Hc22000Encoder::handshakeLineLength(s, 121), line.size());
+        TEST_ASSERT_EQUAL_UINT32(line.size(), strlen(line.c_str()));
+    }
+    TEST_ASSERT_EQUAL_UINT32(136 + 64 + 1024, Hc22000Encoder::kMaxHandshakeLine);
+    TEST_ASSERT_EQUAL_UINT32(72 + 64, Hc22000Encoder::kMaxPmkidLine);
+}
+
+void test_ssid_truncatedAt32(void) {
+    static const uint8_t pmkid[16] = {1};
+    char ssid[41];
+    memset(ssid, 'A', 40);
+    ssid[40] = 0;
+    char line[Hc22000Encoder::kMaxPmkidLine];
+    size_t n = Hc22000Encoder::encodePmkid(line, sizeof(line), pmkid, AP, STA, ssid, 40);
+    TEST_ASSERT_EQUAL_UINT32(Hc22000Encoder::kMaxPmkidLine, n);
+}
+
+void test_bufferTooSmall_writesNothing(void) {
+    Frames f;
+    buildFrames(f);
+    size_t need = Hc22000Encoder::handshakeLineLength(strlen(SSID), 121);
+    char line[Hc22000Encoder::kMaxHandshakeLine];
+    memset(line, '#', sizeof(line));
+    TEST_ASSERT_EQUAL_UINT32(0, Hc22000Encoder::encodeHandshake(line, need - 1, AP, STA,
+                                                                SSID, strlen(SSID), f.m1 + 17,
+                                                                f.m2, 121, 0x00));
+    TEST_ASSERT_EQUAL_INT('#', line[0]);
+    TEST_ASSERT_EQUAL_UINT32(need, Hc22000Encoder::encodeHandshake(line, need, AP, STA,
+                                                                   SSID, strlen(SSID), f.m1 + 17,
+                                                                   f.m2, 121, 0x00));
+}
+
+void test_invalidInput_rejected(void) {
+    Frames f;
+    buildFrames(f);
+    char line[Hc22000Encoder::kMaxHandshakeLine];
+    static const uint8_t zeros[16] = {0};
+    TEST_ASSERT_EQUAL_UINT32(0, Hc22000Encoder::encodePmkid(line, sizeof(line), zeros,
+                                                            AP, STA, SSID, strlen(SSID)));
+    // EAPOL must reach past the MIC, and fit the 512-byte capture
+    TEST_ASSERT_EQUAL_UINT32(0, Hc22000Encoder::encodeHandshake(line, sizeof(line), AP, STA,
+                                                                SSID, strlen(SSID), f.m1 + 17,
+                                                                f.m2, 96, 0x00));
+    TEST_ASSERT_EQUAL_UINT32(0, Hc22000Encoder::encodeHandshake(line, sizeof(line), AP, STA,
+                                                                SSID, strlen(SSID), f.m1 + 17,
+                                                                f.m2, 513, 0x00));
+}
+
+void test_eapolFrameLength_cappedToStored(void) {
+    Frames f;
+    buildFrames(f);
+    TEST_ASSERT_EQUAL_UINT16(121, Hc22000Encoder::eapolFrameLength(f.m2, sizeof(f.m2)));
+    TEST_ASSERT_EQUAL_UINT16(121, Hc22000Encoder::eapolFrameLength(f.m2, 300));
+    TEST_ASSERT_EQUAL_UINT16(100, Hc22000Encoder::eapolFrameLength(f.m2, 100));
+    TEST_ASSERT_EQUAL_UINT16(0, Hc22000Encoder::eapolFrameLength(f.m2, 3));
+}
+
+// ============================================================================
+// Agreement with the sprintf builder
+// ============================================================================
+
+void test_randomized_matchesLegacy(void) {
+    uint8_t nonceFrame[49], eapol[512], ap[6], sta[6];
+    char ssid[33];
+    for (int round = 0; round < 500; round++) {
+        for (auto& b : nonceFrame) b = (uint8_t)nextRand();
+        for (auto& b : eapol) b = (uint8_t)nextRand();
+        for (auto& b : ap) b = (uint8_t)nextRand();
+        for (auto& b : sta) b = (uint8_t)nextRand();
+        int ssidLen = nextRand() % 33;
+        for (int i = 0; i < ssidLen; i++) ssid[i] = (char)(1 + nextRand() % 255);
+        ssid[ssidLen] = 0;
+        uint16_t eapolLen = (uint16_t)(97 + nextRand() % (512 - 97 + 1));
+        uint8_t pair = (nextRand() & 1) ? 0x02 : 0x00;
+
+        static char line[Hc22000Encoder::kMaxHandshakeLine];
+        size_t n = Hc22000Encoder::encodeHandshake(line, sizeof(line), ap, sta, ssid, ssidLen,
+                                                   nonceFrame + 17, eapol, eapolLen, pair);
+        std::string expect = legacyHandshake(ap, sta, ssid, nonceFrame, eapol, eapolLen, pair);
+        TEST_ASSERT_EQUAL_UINT32(expect.size(), n);
+        TEST_ASSERT_TRUE(expect == std::string(line, n));
+    }
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+void test_bench_vsSprintf(void) {
+    Frames f;
+    buildFrames(f);
+    const int n = 20000;
+    volatile size_t sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        f.m2[0] = (uint8_t)i;
+        sink = sink + legacyHandshake(AP, STA, SSID, f.m1, f.m2, 121, 0x00).size();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    static char line[Hc22000Encoder::kMaxHandshakeLine];
+    for (int i = 0; i < n; i++) {
+        f.m2[0] = (uint8_t)i;
+        sink = sink + Hc22000Encoder::encodeHandshake(line, sizeof(line), AP, STA, SSID, strlen(SSID),
+                                                      f.m1 + 17, f.m2, 121, 0x00);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double oldUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / n;
+    double newUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / n;
+    char msg[112];
+    snprintf(msg, sizeof(msg), "WPA*02 line (121B EAPOL): sprintf %.2f us, encoder %.2f us (%.0fx, host)",
+             oldUs, newUs, oldUs / newUs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(newUs < oldUs);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Golden lines
+    RUN_TEST(test_golden_pmkid);
+    RUN_TEST(test_golden_handshake_m1m2);
+    RUN_TEST(test_golden_handshake_m2m3_pair);
+    RUN_TEST(test_handshake_micZeroedOnlyInEapol);
+
+    // Lengths / validation
+    RUN_TEST(test_lineLength_isExact);
+    RUN_TEST(test_ssid_truncatedAt32);
+    RUN_TEST(test_bufferTooSmall_writesNothing);
+    RUN_TEST(test_invalidInput_rejected);
+    RUN_TEST(test_eapolFrameLength_cappedToStored);
+
+    // Agreement with sprintf
+    RUN_TEST(test_randomized_matchesLegacy);
+
+    // Benchmark
+    RUN_TEST(test_bench_vsSprintf);
+
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+// Latency Histogram Tests
+// Tests the log2 cycle histogram behind ReconMetrics: bucket edges,
+// percentiles against exact sorted quantiles, and recording cost.
+
+#include <unity.h>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "../../src/core/latency_histogram.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x9E3779B9u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static LatencyHistogram makeEmpty() {
+    LatencyHistogram h;
+    h.reset();
+    return h;
+}
+
+// ============================================================================
+// Buckets
+// ============================================================================
+
+void test_bucketOf_edges(void) {
+    TEST_ASSERT_EQUAL_UINT8(0, LatencyHistogram::bucketOf(0));
+    TEST_ASSERT_EQUAL_UINT8(0, LatencyHistogram::bucketOf(15));
+    TEST_ASSERT_EQUAL_UINT8(1, LatencyHistogram::bucketOf(16));
+    TEST_ASSERT_EQUAL_UINT8(1, LatencyHistogram::bucketOf(31));
+    TEST_ASSERT_EQUAL_UINT8(2, LatencyHistogram::bucketOf(32));
+    TEST_ASSERT_EQUAL_UINT8(14, LatencyHistogram::bucketOf((1u << 18) - 1));
+    TEST_ASSERT_EQUAL_UINT8(15, LatencyHistogram::bucketOf(1u << 18));
+    TEST_ASSERT_EQUAL_UINT8(15, LatencyHistogram::bucketOf(0xFFFFFFFFu));
+}
+
+void test_bucketUpper_containsBucket(void) {
+    LatencyHistogram h = makeEmpty();
+    h.maxCycles = 0xFFFFFFFFu;
+    for (uint32_t v = 1; v < (1u << 18); v = v * 3 + 1) {
+        uint8_t b = LatencyHistogram::bucketOf(v);
+        TEST_ASSERT_TRUE(v < h.bucketUpper(b));
+        if (b > 0) TEST_ASSERT_TRUE(v >= h.bucketUpper(b - 1));
+    }
+}
+
+void test_record_tracksCountMaxMean(void) {
+    LatencyHistogram h = makeEmpty();
+    h.record(100);
+    h.record(300);
+    h.record(200);
+    TEST_ASSERT_EQUAL_UINT32(3, h.count);
+    TEST_ASSERT_EQUAL_UINT32(300, h.maxCycles);
+    TEST_ASSERT_EQUAL_UINT32(200, h.meanCycles());
+}
+
+// ============================================================================
+// Percentiles
+// ============================================================================
+
+void test_percentile_empty(void) {
+    LatencyHistogram h = makeEmpty();
+    TEST_ASSERT_EQUAL_UINT32(0, h.percentile(50));
+    TEST_ASSERT_EQUAL_UINT32(0, h.meanCycles());
+}
+
+void test_percentile_neverAboveMax(void) {
+    LatencyHistogram h = makeEmpty();
+    h.record(1000);
+    TEST_ASSERT_EQUAL_UINT32(1000, h.percentile(50));
+    TEST_ASSERT_EQUAL_UINT32(1000, h.percentile(99));
+}
+
+void test_percentile_tailSample(void) {
+    // 99 fast samples and one slow one: p50 stays fast, p100 is the outlier
+    LatencyHistogram h = makeEmpty();
+    for (int i = 0; i < 99; i++) h.record(200);
+    h.record(500000);
+    TEST_ASSERT_EQUAL_UINT32(256, h.percentile(50));
+    TEST_ASSERT_EQUAL_UINT32(256, h.percentile(99));
+    TEST_ASSERT_EQUAL_UINT32(500000, h.percentile(100));
+}
+
+void test_percentile_withinOneBucketOfExact(void) {
+    // Log-normal-ish cycle counts, like callback durations
+    LatencyHistogram h = makeEmpty();
+    std::vector<uint32_t> samples;
+    for (int i = 0; i < 20000; i++) {
+        uint32_t shift = 6 + nextRand() % 8;
+        uint32_t v = (1u << shift) + nextRand() % (1u << shift);
+        samples.push_back(v);
+        h.record(v);
+    }
+    std::sort(samples.begin(), samples.end());
+    const uint8_t pcts[] = {50, 90, 99};
+    for (uint8_t p : pcts) {
+        uint32_t exact = samples[(samples.size() * p + 99) / 100 - 1];
+        uint32_t est = h.percentile(p);
+        char msg[80];
+        snprintf(msg, sizeof(msg), "p%u exact=%u histogram=%u", p, exact, est);
+        TEST_MESSAGE(msg);
+        // Reported as the bucket's upper edge: >= exact, < 2x exact
+        TEST_ASSERT_TRUE(est >= exact);
+        TEST_ASSERT_TRUE(est <= exact * 2);
+    }
+}
+
+// ============================================================================
+// Cost
+// ============================================================================
+
+void test_bench_recordCost(void) {
+    LatencyHistogram h = makeEmpty();
+    const int n = 2000000;
+    std::vector<uint32_t> values(4096);
+    for (auto& v : values) v = nextRand() >> (nextRand() % 24);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) h.record(values[i & 4095]);
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    char msg[64];
+    snprintf(msg, sizeof(msg), "record(): %.2f ns/sample (host)", ns);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(n, h.count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Buckets
+    RUN_TEST(test_bucketOf_edges);
+    RUN_TEST(test_bucketUpper_containsBucket);
+    RUN_TEST(test_record_tracksCountMaxMean);
+
+    // Percentiles
+    RUN_TEST(test_percentile_empty);
+    RUN_TEST(test_percentile_neverAboveMax);
+    RUN_TEST(test_percentile_tailSample);
+    RUN_TEST(test_percentile_withinOneBucketOfExact);
+
+    // Cost
+    RUN_TEST(test_bench_recordCost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,352 @@
+// Network Hot View Tests
+// Tests the dense NetworkHot projection NetworkRecon sweeps instead of the
+// full DetectedNetwork records: projection, retention-score and stale-check
+// equivalence with the old full-record code, and sweep benchmarks.
+
+#include <unity.h>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include "../../src/core/network_hot.h"
+#include "../../src/core/client_sketch.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Same fields and order as DetectedNetwork (oink.h); authmode is an enum there
+struct FakeNetwork {
+    uint8_t bssid[6];
+    char ssid[33];
+    int8_t rssi;
+    int8_t rssiAvg;
+    uint8_t channel;
+    int authmode;
+    uint32_t firstSeen;
+    uint32_t lastSeen;
+    uint32_t lastBeaconSeen;
+    uint16_t beaconCount;
+    uint16_t beaconIntervalEmaMs;
+    bool isTarget;
+    bool hasPMF;
+    bool hasHandshake;
+    uint8_t attackAttempts;
+    bool isHidden;
+    uint32_t lastDataSeen;
+    uint32_t cooldownUntil;
+    ClientSketch clients;
+};
+
+static const int kAuthOpen = 0;
+
+// Pre-split NetworkRecon::computeRetentionScore, verbatim
+static int legacyRetentionScore(const FakeNetwork& net, uint32_t now) {
+    int8_t rssi = (net.rssiAvg != 0) ? net.rssiAvg : net.rssi;
+    int score = 0;
+
+    if (rssi <= -95) score += 0;
+    else if (rssi >= -30) score += 60;
+    else score += ((int)rssi + 95) * 60 / 65;
+
+    uint32_t age = now - net.lastSeen;
+    if (age <= 2000) score += 20;
+    else if (age <= 5000) score += 12;
+    else if (age <= 15000) score += 5;
+
+    if (net.lastDataSeen > 0) {
+        uint32_t dataAge = now - net.lastDataSeen;
+        if (dataAge <= 3000) score += 20;
+        else if (dataAge <= 10000) score += 10;
+        else if (dataAge <= 30000) score += 5;
+    }
+
+    if (net.beaconIntervalEmaMs > 0) {
+        if (net.beaconIntervalEmaMs <= 150) score += 10;
+        else if (net.beaconIntervalEmaMs <= 500) score += 6;
+        else if (net.beaconIntervalEmaMs <= 1000) score += 3;
+    }
+
+    if (net.hasHandshake) score -= 20;
+    if (net.hasPMF) score -= 15;
+    if (net.authmode == kAuthOpen) score -= 10;
+    if (net.ssid[0] == 0 || net.isHidden) score -= 10;
+    if (net.cooldownUntil > now) score -= 10;
+
+    return score;
+}
+
+// Pre-split stale check from cleanupStaleNetworks()
+static bool legacyIsStale(const FakeNetwork& net, uint32_t now) {
+    int8_t rssi = (net.rssiAvg != 0) ? net.rssiAvg : net.rssi;
+    uint32_t timeout = 60000;
+    if (rssi < -75) timeout = 120000;
+    else if (rssi < -50) timeout = 90000;
+    return now - net.lastSeen > timeout;
+}
+
+// Pre-split eviction sweep from processDeferredEvents()
+static int legacyFindWeakest(const std::vector<FakeNetwork>& nets, uint32_t now, int& worstScore) {
+    int worstIdx = -1;
+    worstScore = 100000;
+    for (size_t i = 0; i < nets.size(); i++) {
+        if (nets[i].isTarget) continue;
+        int score = legacyRetentionScore(nets[i], now);
+        if (score < worstScore) {
+            worstScore = score;
+            worstIdx = (int)i;
+        }
+    }
+    return worstIdx;
+}
+
+static uint32_t rngState = 0x2545F491u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void makeNetwork(FakeNetwork& net, uint32_t now) {
+    memset(&net, 0, sizeof(net));
+    for (int i = 0; i < 6; i++) net.bssid[i] = (uint8_t)nextRand();
+    if (nextRand() % 5 != 0) {
+        snprintf(net.ssid, sizeof(net.ssid), "net%u", (unsigned)(nextRand() % 10000));
+    }
+    net.rssi = (int8_t)(-100 + (int)(nextRand() % 80));
+    net.rssiAvg = (nextRand() % 4 == 0) ? 0 : (int8_t)(-100 + (int)(nextRand() % 80));
+    net.channel = (uint8_t)(1 + nextRand() % 13);
+    net.authmode = (int)(nextRand() % 8);
+    net.lastSeen = now - (nextRand() % 150000);
+    net.beaconIntervalEmaMs = (uint16_t)((nextRand() % 3 == 0) ? 0 : nextRand() % 1500);
+    net.isTarget = (nextRand() % 50 == 0);
+    net.hasPMF = (nextRand() % 4 == 0);
+    net.hasHandshake = (nextRand() % 6 == 0);
+    net.isHidden = (net.ssid[0] == 0) || (nextRand() % 10 == 0);
+    net.lastDataSeen = (nextRand() % 2 == 0) ? 0 : now - (nextRand() % 60000);
+    net.cooldownUntil = (nextRand() % 5 == 0) ? now + (nextRand() % 20000) - 5000 : 0;
+}
+
+static void makeTable(std::vector<FakeNetwork>& nets, std::vector<NetworkHot>& hot,
+                      size_t n, uint32_t now) {
+    nets.resize(n);
+    hot.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        makeNetwork(nets[i], now);
+        ReconHot::project(nets[i], hot[i]);
+    }
+}
+
+// ============================================================================
+// Projection
+// ============================================================================
+
+void test_project_copiesHotFields(void) {
+    FakeNetwork net;
+    makeNetwork(net, 100000);
+    net.isTarget = false;
+    net.rssiAvg = -61;
+    NetworkHot hot;
+    ReconHot::project(net, hot);
+    TEST_ASSERT_EQUAL_MEMORY(net.bssid, hot.bssid, 6);
+    TEST_ASSERT_EQUAL_INT8(-61, hot.rssi);
+    TEST_ASSERT_EQUAL_UINT32(net.lastSeen, hot.lastSeen);
+    TEST_ASSERT_EQUAL_UINT32(net.lastDataSeen, hot.lastDataSeen);
+    TEST_ASSERT_EQUAL_UINT32(net.cooldownUntil, hot.cooldownUntil);
+}
+
+void test_project_rssiFallsBackToRaw(void) {
+    FakeNetwork net = {};
+    net.rssi = -72;
+    net.rssiAvg = 0;
+    NetworkHot hot;
+    ReconHot::project(net, hot);
+    TEST_ASSERT_EQUAL_INT8(-72, hot.rssi);
+}
+
+void test_coldBias_targetIsPinned(void) {
+    FakeNetwork net = {};
+    net.isTarget = true;
+    TEST_ASSERT_EQUAL_INT8(ReconHot::kBiasPinned, ReconHot::coldBias(net));
+}
+
+void test_coldBias_extremesFitInt8(void) {
+    FakeNetwork best = {};
+    strcpy(best.ssid, "x");
+    best.authmode = 3;
+    best.beaconIntervalEmaMs = 100;
+    TEST_ASSERT_EQUAL_INT8(10, ReconHot::coldBias(best));
+
+    FakeNetwork worst = {};
+    worst.authmode = kAuthOpen;
+    worst.hasHandshake = true;
+    worst.hasPMF = true;
+    worst.isHidden = true;
+    TEST_ASSERT_EQUAL_INT8(-55, ReconHot::coldBias(worst));
+    TEST_ASSERT_TRUE(ReconHot::coldBias(worst) != ReconHot::kBiasPinned);
+}
+
+// ============================================================================
+// Equivalence with the full-record code
+// ============================================================================
+
+void test_retentionScore_matchesLegacy(void) {
+    for (int i = 0; i < 20000; i++) {
+        uint32_t now = 200000 + nextRand() % 1000000;
+        FakeNetwork net;
+        makeNetwork(net, now);
+        net.isTarget = false;
+        NetworkHot hot;
+        ReconHot::project(net, hot);
+        int expected = legacyRetentionScore(net, now);
+        int actual = ReconHot::retentionScore(hot, now);
+        if (expected != actual) {
+            char msg[96];
+            snprintf(msg, sizeof(msg), "case %d: legacy=%d hot=%d", i, expected, actual);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+void test_retentionScore_cooldownExpiresWithoutResync(void) {
+    FakeNetwork net = {};
+    strcpy(net.ssid, "x");
+    net.authmode = 3;
+    net.rssi = -60;
+    net.lastSeen = 1000;
+    net.cooldownUntil = 5000;
+    NetworkHot hot;
+    ReconHot::project(net, hot);
+    // Same hot record, later clock: the cooldown penalty drops off on its own
+    TEST_ASSERT_EQUAL_INT(legacyRetentionScore(net, 4000), ReconHot::retentionScore(hot, 4000));
+    TEST_ASSERT_EQUAL_INT(legacyRetentionScore(net, 6000), ReconHot::retentionScore(hot, 6000));
+}
+
+void test_isStale_matchesLegacyAtBoundaries(void) {
+    const int8_t rssis[] = {-40, -50, -51, -75, -76, -90};
+    const uint32_t ages[] = {59999, 60000, 60001, 90000, 90001, 120000, 120001};
+    for (int8_t r : rssis) {
+        for (uint32_t age : ages) {
+            FakeNetwork net = {};
+            net.rssi = r;
+            net.lastSeen = 1000;
+            NetworkHot hot;
+            ReconHot::project(net, hot);
+            uint32_t now = 1000 + age;
+            TEST_ASSERT_EQUAL(legacyIsStale(net, now), ReconHot::isStale(hot, now));
+        }
+    }
+}
+
+void test_findWeakest_matchesLegacySweep(void) {
+    std::vector<FakeNetwork> nets;
+    std::vector<NetworkHot> hot;
+    for (int round = 0; round < 200; round++) {
+        uint32_t now = 500000 + round * 777;
+        makeTable(nets, hot, 1 + nextRand() % 200, now);
+        int legacyScore = 0;
+        int hotScore = 0;
+        int legacyIdx = legacyFindWeakest(nets, now, legacyScore);
+        int hotIdx = ReconHot::findWeakest(hot.data(), hot.size(), now, hotScore);
+        TEST_ASSERT_EQUAL_INT(legacyIdx, hotIdx);
+        TEST_ASSERT_EQUAL_INT(legacyScore, hotScore);
+    }
+}
+
+void test_findWeakest_allPinnedReturnsMinusOne(void) {
+    std::vector<FakeNetwork> nets;
+    std::vector<NetworkHot> hot;
+    makeTable(nets, hot, 10, 100000);
+    for (size_t i = 0; i < nets.size(); i++) {
+        nets[i].isTarget = true;
+        ReconHot::project(nets[i], hot[i]);
+    }
+    int score = 0;
+    TEST_ASSERT_EQUAL_INT(-1, ReconHot::findWeakest(hot.data(), hot.size(), 100000, score));
+}
+
+// ============================================================================
+// Benchmarks (informational - no timing assertions)
+// ============================================================================
+
+static volatile int sink = 0;
+
+static void runSweepBenchmark(size_t n) {
+    const uint32_t now = 1000000;
+    std::vector<FakeNetwork> nets;
+    std::vector<NetworkHot> hot;
+    makeTable(nets, hot, n, now);
+    const int iters = (int)(2000000 / n) + 1;
+
+    // Eviction sweep (computeRetentionScore over every record)
+    auto t0 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iters; it++) {
+        int score;
+        sink += legacyFindWeakest(nets, now + it, score);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iters; it++) {
+        int score;
+        sink += ReconHot::findWeakest(hot.data(), hot.size(), now + it, score);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    // Stale sweep (cleanupStaleNetworks collect phase)
+    for (int it = 0; it < iters; it++) {
+        int stale = 0;
+        for (size_t i = 0; i < n; i++) stale += legacyIsStale(nets[i], now + it);
+        sink += stale;
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iters; it++) {
+        int stale = 0;
+        for (size_t i = 0; i < n; i++) stale += ReconHot::isStale(hot[i], now + it);
+        sink += stale;
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    double div = (double)iters * (double)n;
+    double legacyEvict = std::chrono::duration<double, std::nano>(t1 - t0).count() / div;
+    double hotEvict = std::chrono::duration<double, std::nano>(t2 - t1).count() / div;
+    double legacyStale = std::chrono::duration<double, std::nano>(t3 - t2).count() / div;
+    double hotStale = std::chrono::duration<double, std::nano>(t4 - t3).count() / div;
+
+    char msg[192];
+    snprintf(msg, sizeof(msg),
+             "n=%5zu  evict: full=%5.2f hot=%5.2f ns/net (%.1fx)  stale: full=%5.2f hot=%5.2f ns/net (%.1fx)  bytes %zu->%zu",
+             n, legacyEvict, hotEvict, hotEvict > 0 ? legacyEvict / hotEvict : 0.0,
+             legacyStale, hotStale, hotStale > 0 ? legacyStale / hotStale : 0.0,
+             n * sizeof(FakeNetwork), n * sizeof(NetworkHot));
+    TEST_MESSAGE(msg);
+}
+
+void test_benchmark_sweeps_200(void) { runSweepBenchmark(200); }
+void test_benchmark_sweeps_5000(void) { runSweepBenchmark(5000); }
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Projection
+    RUN_TEST(test_project_copiesHotFields);
+    RUN_TEST(test_project_rssiFallsBackToRaw);
+    RUN_TEST(test_coldBias_targetIsPinned);
+    RUN_TEST(test_coldBias_extremesFitInt8);
+
+    // Equivalence
+    RUN_TEST(test_retentionScore_matchesLegacy);
+    RUN_TEST(test_retentionScore_cooldownExpiresWithoutResync);
+    RUN_TEST(test_isStale_matchesLegacyAtBoundaries);
+    RUN_TEST(test_findWeakest_matchesLegacySweep);
+    RUN_TEST(test_findWeakest_allPinnedReturnsMinusOne);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_sweeps_200);
+    RUN_TEST(test_benchmark_sweeps_5000);
+
+    return UNITY_END();
+}
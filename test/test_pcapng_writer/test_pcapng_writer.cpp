@@ -0,0 +1,283 @@
+// pcapng Writer Tests
+// Tests the buffered pcapng writer shared by OINK, DO NO HAM and PigSync:
+// byte-exact Section Header / Interface Description / Enhanced Packet
+// blocks per the pcapng spec, radiotap field layout and alignment, block
+// buffering (sink only ever sees whole 512-byte blocks plus one tail) and
+// short-write failure.
+
+#include <unity.h>
+#include <cstdio>
+#include <vector>
+#include "../../src/core/pcapng_writer.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+struct Capture {
+    std::vector<uint8_t> bytes;
+    std::vector<size_t> writes;   // Size of every sink call
+    size_t acceptLimit = (size_t)-1;
+};
+
+static size_t captureSink(void* ctx, const uint8_t* data, size_t len) {
+    Capture* c = static_cast<Capture*>(ctx);
+    c->writes.push_back(len);
+    size_t n = len < c->acceptLimit ? len : c->acceptLimit;
+    c->bytes.insert(c->bytes.end(), data, data + n);
+    c->acceptLimit -= n;
+    return n;
+}
+
+static uint32_t rd32(const std::vector<uint8_t>& b, size_t off) {
+    return (uint32_t)b[off] | ((uint32_t)b[off + 1] << 8) |
+           ((uint32_t)b[off + 2] << 16) | ((uint32_t)b[off + 3] << 24);
+}
+
+static void assertBytes(const std::vector<uint8_t>& actual, size_t off,
+                        const uint8_t* expected, size_t len) {
+    TEST_ASSERT_TRUE(off + len <= actual.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, &actual[off], len);
+}
+
+// Walk the block chain; every block's leading and trailing length agree
+static int countBlocks(const std::vector<uint8_t>& b) {
+    size_t off = 0;
+    int blocks = 0;
+    while (off + 12 <= b.size()) {
+        uint32_t len = rd32(b, off + 4);
+        if (len < 12 || (len & 3) || off + len > b.size()) return -1;
+        if (rd32(b, off + len - 4) != len) return -1;
+        off += len;
+        blocks++;
+    }
+    return off == b.size() ? blocks : -1;
+}
+
+static const uint8_t FRAME[5] = {0x88, 0x02, 0x3A, 0x01, 0xFF};
+
+// ============================================================================
+// Blocks
+// ============================================================================
+
+void test_sectionAndInterface_exactBytes(void) {
+    Capture c;
+    PcapngWriter w(captureSink, &c);
+    TEST_ASSERT_TRUE(w.begin());
+    TEST_ASSERT_TRUE(w.finish());
+
+    const uint8_t expected[] = {
+        // SHB
+        0x0A, 0x0D, 0x0D, 0x0A,  28, 0, 0, 0,
+        0x4D, 0x3C, 0x2B, 0x1A,  1, 0, 0, 0,
+        0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF,
+        28, 0, 0, 0,
+        // IDB: LINKTYPE_IEEE802_11_RADIOTAP, snaplen 65535
+        1, 0, 0, 0,  20, 0, 0, 0,
+        127, 0, 0, 0,  0xFF, 0xFF, 0, 0,
+        20, 0, 0, 0
+    };
+    TEST_ASSERT_EQUAL_UINT32(sizeof(expected), c.bytes.size());
+    assertBytes(c.bytes, 0, expected, sizeof(expected));
+}
+
+void test_sectionHeader_userApplOption(void) {
+    Capture c;
+    PcapngWriter w(captureSink, &c);
+    TEST_ASSERT_TRUE(w.begin("M5PORKCHOP"));
+    TEST_ASSERT_TRUE(w.finish());
+
+    // 28 + option header 4 + "M5PORKCHOP" padded to 12 + opt_endofopt 4
+    TEST_ASSERT_EQUAL_UINT32(48, rd32(c.bytes, 4));
+    const uint8_t opt[] = {
+        4, 0, 10, 0,
+        'M', '5', 'P', 'O', 'R', 'K', 'C', 'H', 'O', 'P', 0, 0,
+        0, 0, 0, 0,
+        48, 0, 0, 0
+    };
+    assertBytes(c.bytes, 24, opt, sizeof(opt));
+    TEST_ASSERT_EQUAL_INT(2, countBlocks(c.bytes));
+}
+
+void test_enhancedPacket_allRadiotapFields(void) {
+    Capture c;
+    PcapngWriter w(captureSink, &c);
+    w.begin();
+    size_t epb = c.bytes.size() + 48;  // SHB 28 + IDB 20, still buffered
+    PcapngPacketMeta meta;
+    meta.timestampUs = 0x0000000123456789ull;
+    meta.tsft = 0x1122334455667788ull;
+    meta.hasTsft = true;
+    meta.channel = 6;
+    meta.rssi = -42;
+    TEST_ASSERT_TRUE(w.writePacket(FRAME, sizeof(FRAME), meta));
+    TEST_ASSERT_TRUE(w.finish());
+
+    // Radiotap 21 bytes + frame 5 = 26 captured, padded to 28; block 60
+    const uint8_t expected[] = {
+        6, 0, 0, 0,  60, 0, 0, 0,
+        0, 0, 0, 0,                      // Interface 0
+        0x01, 0, 0, 0,  0x89, 0x67, 0x45, 0x23,  // Timestamp high, low
+        26, 0, 0, 0,  26, 0, 0, 0,       // Captured / original length
+        // Radiotap: version, pad, len 21, present TSFT|Channel|AntSignal
+        0, 0, 21, 0,  0x29, 0, 0, 0,
+        0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,  // TSFT (offset 8)
+        0x85, 0x09,  0x80, 0x00,         // 2437 MHz, 2 GHz spectrum
+        (uint8_t)-42,                    // dBm antenna signal
+        0x88, 0x02, 0x3A, 0x01, 0xFF,    // Frame
+        0, 0,                            // Pad to 32 bits
+        60, 0, 0, 0
+    };
+    TEST_ASSERT_EQUAL_UINT32(epb + sizeof(expected), c.bytes.size());
+    assertBytes(c.bytes, epb, expected, sizeof(expected));
+    TEST_ASSERT_EQUAL_INT(3, countBlocks(c.bytes));
+}
+
+void test_radiotap_alignmentWithoutTsft(void) {
+    PcapngPacketMeta meta;
+    TEST_ASSERT_EQUAL_UINT16(8, PcapngWriter::radiotapLength(meta));
+    meta.rssi = -70;
+    TEST_ASSERT_EQUAL_UINT16(9, PcapngWriter::radiotapLength(meta));
+    meta.channel = 11;
+    TEST_ASSERT_EQUAL_UINT16(13, PcapngWriter::radiotapLength(meta));
+    meta.hasTsft = true;
+    TEST_ASSERT_EQUAL_UINT16(21, PcapngWriter::radiotapLength(meta));
+
+    // Channel + signal only: channel at offset 8, signal at 12
+    Capture c;
+    PcapngWriter w(captureSink, &c);
+    PcapngPacketMeta m2;
+    m2.channel = 11;
+    m2.rssi = -70;
+    w.writePacket(FRAME, sizeof(FRAME), m2);
+    w.finish();
+    const uint8_t rt[] = {0, 0, 13, 0,  0x28, 0, 0, 0,  0x9E, 0x09, 0x80, 0x00, (uint8_t)-70};
+    assertBytes(c.bytes, 28, rt, sizeof(rt));
+}
+
+void test_noRadioMeta_emptyPresentWord(void) {
+    Capture c;
+    PcapngWriter w(captureSink, &c);
+    w.writePacket(FRAME, 4, PcapngPacketMeta());
+    w.finish();
+    // Old-style 8-byte radiotap: 12 captured bytes, no padding
+    TEST_ASSERT_EQUAL_UINT32(44, rd32(c.bytes, 4));
+    TEST_ASSERT_EQUAL_UINT32(12, rd32(c.bytes, 20));
+    const uint8_t rt[] = {0, 0, 8, 0, 0, 0, 0, 0};
+    assertBytes(c.bytes, 28, rt, sizeof(rt));
+}
+
+void test_channelFrequency(void) {
+    TEST_ASSERT_EQUAL_UINT16(2412, PcapngWriter::channelFrequency(1));
+    TEST_ASSERT_EQUAL_UINT16(2472, PcapngWriter::channelFrequency(13));
+    TEST_ASSERT_EQUAL_UINT16(2484, PcapngWriter::channelFrequency(14));
+    TEST_ASSERT_EQUAL_UINT16(5180, PcapngWriter::channelFrequency(36));
+    TEST_ASSERT_EQUAL_UINT16(0, PcapngWriter::channelFrequency(0));
+}
+
+void test_spanApi_matchesWritePacket(void) {
+    uint8_t frame[300];
+    for (int i = 0; i < 300; i++) frame[i] = (uint8_t)(i * 7 + 1);
+    PcapngPacketMeta meta;
+    meta.channel = 1;
+    meta.rssi = -55;
+    meta.timestampUs = 5000;
+
+    Capture a;
+    PcapngWriter wa(captureSink, &a);
+    wa.writePacket(frame, sizeof(frame), meta);
+    wa.finish();
+
+    Capture b;
+    PcapngWriter wb(captureSink, &b);
+    wb.beginPacket(sizeof(frame), meta);
+    for (int off = 0; off < 300; off += 62) {
+        wb.appendPacketData(frame + off, off + 62 <= 300 ? 62 : 300 - off);
+    }
+    wb.endPacket();
+    wb.finish();
+
+    TEST_ASSERT_EQUAL_UINT32(a.bytes.size(), b.bytes.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(a.bytes.data(), b.bytes.data(), a.bytes.size());
+}
+
+// ============================================================================
+// Buffering
+// ============================================================================
+
+void test_sinkSeesWholeBlocks(void) {
+    Capture c;
+    PcapngWriter w(captureSink, &c);
+    w.begin("M5PORKCHOP");
+    uint8_t frame[300] = {0};
+    PcapngPacketMeta meta;
+    meta.hasTsft = true;
+    meta.channel = 6;
+    meta.rssi = -60;
+    for (int i = 0; i < 9; i++) {
+        TEST_ASSERT_TRUE(w.writePacket(frame, (uint16_t)(120 + i * 20), meta));
+    }
+    TEST_ASSERT_TRUE(w.finish());
+
+    TEST_ASSERT_TRUE(c.writes.size() >= 3);
+    for (size_t i = 0; i + 1 < c.writes.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(PcapngWriter::kBlockBytes, c.writes[i]);
+    }
+    TEST_ASSERT_TRUE(c.writes.back() <= PcapngWriter::kBlockBytes);
+    TEST_ASSERT_EQUAL_UINT32(c.bytes.size(), w.bytesWritten());
+    TEST_ASSERT_EQUAL_INT(11, countBlocks(c.bytes));
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "9 packets: %u sink writes (unbuffered pcap: %d)",
+             (unsigned)c.writes.size(), 1 + 9 * 3);
+    TEST_MESSAGE(msg);
+}
+
+void test_nothingWrittenUntilBlockFills(void) {
+    Capture c;
+    PcapngWriter w(captureSink, &c);
+    w.begin();
+    w.writePacket(FRAME, sizeof(FRAME), PcapngPacketMeta());
+    TEST_ASSERT_EQUAL_UINT32(0, c.writes.size());
+    w.finish();
+    TEST_ASSERT_EQUAL_UINT32(1, c.writes.size());
+    TEST_ASSERT_TRUE(w.finish());  // Idempotent: empty buffer, no extra write
+    TEST_ASSERT_EQUAL_UINT32(1, c.writes.size());
+}
+
+void test_shortWrite_fails(void) {
+    Capture c;
+    c.acceptLimit = 600;
+    PcapngWriter w(captureSink, &c);
+    w.begin();
+    uint8_t frame[300] = {0};
+    bool ok = true;
+    for (int i = 0; i < 4; i++) ok = w.writePacket(frame, sizeof(frame), PcapngPacketMeta()) && ok;
+    ok = w.finish() && ok;
+    TEST_ASSERT_FALSE(ok);
+    TEST_ASSERT_FALSE(w.ok());
+    TEST_ASSERT_EQUAL_UINT32(600, w.bytesWritten());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Blocks
+    RUN_TEST(test_sectionAndInterface_exactBytes);
+    RUN_TEST(test_sectionHeader_userApplOption);
+    RUN_TEST(test_enhancedPacket_allRadiotapFields);
+    RUN_TEST(test_radiotap_alignmentWithoutTsft);
+    RUN_TEST(test_noRadioMeta_emptyPresentWord);
+    RUN_TEST(test_channelFrequency);
+    RUN_TEST(test_spanApi_matchesWritePacket);
+
+    // Buffering
+    RUN_TEST(test_sinkSeesWholeBlocks);
+    RUN_TEST(test_nothingWrittenUntilBlockFills);
+    RUN_TEST(test_shortWrite_fails);
+
+    return UNITY_END();
+}
@@ -0,0 +1,275 @@
+// Score Buckets Tests
+// Tests the slot-indexed bucket queue NetworkRecon uses to pick eviction
+// victims, against a brute-force minimum, plus a benchmark of the full-table
+// retention sweep it replaces.
+
+#include <unity.h>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include "../../src/core/score_buckets.h"
+#include "../../src/core/network_hot.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+typedef ScoreBuckets<200, -80, 127> ReconQueue;
+
+static uint32_t rngState = 0xDEADBEEFu;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void makeHot(NetworkHot& hot, uint32_t now) {
+    memset(&hot, 0, sizeof(hot));
+    for (int i = 0; i < 6; i++) hot.bssid[i] = (uint8_t)nextRand();
+    hot.rssi = (int8_t)(-100 + (int)(nextRand() % 80));
+    hot.bias = (int8_t)(-55 + (int)(nextRand() % 66));
+    hot.lastSeen = now - (nextRand() % 60000);
+    hot.lastDataSeen = (nextRand() % 2) ? 0 : now - (nextRand() % 60000);
+    hot.cooldownUntil = (nextRand() % 5 == 0) ? now + (nextRand() % 10000) : 0;
+}
+
+// ============================================================================
+// Basic operations
+// ============================================================================
+
+void test_empty_peekReturnsMinusOne(void) {
+    static ReconQueue q;
+    q.clear();
+    int score = 0;
+    TEST_ASSERT_EQUAL_INT(-1, q.peekMin(score));
+    TEST_ASSERT_EQUAL_UINT16(0, q.size());
+}
+
+void test_update_insertsAndRekeys(void) {
+    static ReconQueue q;
+    q.clear();
+    q.update(5, 40);
+    q.update(9, 10);
+    q.update(3, 70);
+    int score = 0;
+    TEST_ASSERT_EQUAL_INT(9, q.peekMin(score));
+    TEST_ASSERT_EQUAL_INT(10, score);
+    TEST_ASSERT_EQUAL_UINT16(3, q.size());
+
+    q.update(9, 90);  // Re-key upward: 5 becomes the minimum
+    TEST_ASSERT_EQUAL_INT(5, q.peekMin(score));
+    TEST_ASSERT_EQUAL_INT(40, score);
+    TEST_ASSERT_EQUAL_UINT16(3, q.size());
+
+    q.update(3, -20);  // Re-key downward below everything
+    TEST_ASSERT_EQUAL_INT(3, q.peekMin(score));
+    TEST_ASSERT_EQUAL_INT(-20, score);
+}
+
+void test_remove_dropsSlot(void) {
+    static ReconQueue q;
+    q.clear();
+    q.update(1, 5);
+    q.update(2, 6);
+    q.remove(1);
+    q.remove(1);  // Second remove is a no-op
+    TEST_ASSERT_FALSE(q.contains(1));
+    TEST_ASSERT_EQUAL_UINT16(1, q.size());
+    int score = 0;
+    TEST_ASSERT_EQUAL_INT(2, q.peekMin(score));
+    q.remove(2);
+    TEST_ASSERT_EQUAL_INT(-1, q.peekMin(score));
+}
+
+void test_sameBucket_unlinkMiddle(void) {
+    static ReconQueue q;
+    q.clear();
+    q.update(10, 0);
+    q.update(11, 0);
+    q.update(12, 0);
+    q.remove(11);
+    int score = 0;
+    int first = q.peekMin(score);
+    TEST_ASSERT_TRUE(first == 10 || first == 12);
+    q.remove((uint16_t)first);
+    int second = q.peekMin(score);
+    TEST_ASSERT_TRUE((second == 10 || second == 12) && second != first);
+    q.remove((uint16_t)second);
+    TEST_ASSERT_EQUAL_INT(-1, q.peekMin(score));
+}
+
+void test_scores_clampToRange(void) {
+    static ReconQueue q;
+    q.clear();
+    q.update(0, -1000);
+    q.update(1, 1000);
+    int score = 0;
+    TEST_ASSERT_TRUE(q.scoreOf(0, score));
+    TEST_ASSERT_EQUAL_INT(-80, score);
+    TEST_ASSERT_TRUE(q.scoreOf(1, score));
+    TEST_ASSERT_EQUAL_INT(127, score);
+}
+
+void test_outOfRangeSlot_ignored(void) {
+    static ReconQueue q;
+    q.clear();
+    q.update(200, 5);
+    q.remove(200);
+    TEST_ASSERT_EQUAL_UINT16(0, q.size());
+    TEST_ASSERT_FALSE(q.contains(200));
+}
+
+void test_randomOps_matchBruteForceMin(void) {
+    static ReconQueue q;
+    q.clear();
+    int ref[200];
+    bool present[200] = {false};
+
+    for (int step = 0; step < 50000; step++) {
+        uint16_t slot = (uint16_t)(nextRand() % 200);
+        if (nextRand() % 4 == 0) {
+            q.remove(slot);
+            present[slot] = false;
+        } else {
+            int s = -65 + (int)(nextRand() % 176);
+            q.update(slot, s);
+            ref[slot] = s;
+            present[slot] = true;
+        }
+
+        int best = 100000;
+        uint16_t n = 0;
+        for (int i = 0; i < 200; i++) {
+            if (!present[i]) continue;
+            n++;
+            if (ref[i] < best) best = ref[i];
+        }
+        TEST_ASSERT_EQUAL_UINT16(n, q.size());
+        int score = 0;
+        int got = q.peekMin(score);
+        if (n == 0) {
+            TEST_ASSERT_EQUAL_INT(-1, got);
+        } else {
+            TEST_ASSERT_TRUE(got >= 0 && present[got]);
+            TEST_ASSERT_EQUAL_INT(best, score);
+            TEST_ASSERT_EQUAL_INT(best, ref[got]);
+        }
+    }
+}
+
+// Mirrors processDeferredEvents(): keys go stale as time passes, the head
+// is re-scored and re-keyed until current, then compared to a full sweep
+void test_lazyVerify_findsSameWeakestScoreAsSweep(void) {
+    static ReconQueue q;
+    NetworkHot hot[200];
+    uint32_t now = 1000000;
+    q.clear();
+    for (int i = 0; i < 200; i++) {
+        makeHot(hot[i], now);
+        q.update((uint16_t)i, ReconHot::retentionScore(hot[i], now));
+    }
+
+    for (int round = 0; round < 500; round++) {
+        now += 5 + nextRand() % 45;  // Main-loop cadence
+        // Some networks are heard again (synced); the rest only decay
+        for (int k = 0; k < 5; k++) {
+            int i = (int)(nextRand() % 200);
+            hot[i].lastSeen = now;
+            q.update((uint16_t)i, ReconHot::retentionScore(hot[i], now));
+        }
+        // Rolling refresh, as in refreshEvictionKeys()
+        for (int k = 0; k < 16; k++) {
+            int i = (round * 16 + k) % 200;
+            q.update((uint16_t)i, ReconHot::retentionScore(hot[i], now));
+        }
+
+        int worstIdx = -1;
+        int worstScore = 0;
+        for (int attempt = 0; attempt < 64; attempt++) {
+            int key = 0;
+            worstIdx = q.peekMin(key);
+            worstScore = ReconHot::retentionScore(hot[worstIdx], now);
+            if (worstScore == key) break;
+            q.update((uint16_t)worstIdx, worstScore);
+        }
+
+        int sweepScore = 0;
+        ReconHot::findWeakest(hot, 200, now, sweepScore);
+        // A key lags its score by at most one refresh round (13 updates),
+        // so the verified head is within one decay step of the true minimum
+        TEST_ASSERT_TRUE(worstScore - sweepScore <= 20);
+        TEST_ASSERT_TRUE(worstScore >= sweepScore);
+    }
+}
+
+// ============================================================================
+// Benchmark (informational - no timing assertions)
+// ============================================================================
+
+static volatile int sink = 0;
+
+template <uint16_t kSlots>
+static void runEvictBenchmark() {
+    static ScoreBuckets<kSlots, -80, 127> q;
+    static NetworkHot hot[kSlots];
+    const uint32_t now = 2000000;
+    q.clear();
+    for (uint16_t i = 0; i < kSlots; i++) {
+        makeHot(hot[i], now);
+        q.update(i, ReconHot::retentionScore(hot[i], now));
+    }
+    const int iters = 20000;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iters; it++) {
+        int score;
+        sink += ReconHot::findWeakest(hot, kSlots, now, score);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int it = 0; it < iters; it++) {
+        // Evict head and re-key the slot as a fresh network, like an add
+        int score;
+        int idx = q.peekMin(score);
+        sink += idx;
+        hot[idx].lastSeen = now;
+        q.update((uint16_t)idx, ReconHot::retentionScore(hot[idx], now));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double sweepNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+    double queueNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / iters;
+    char msg[128];
+    snprintf(msg, sizeof(msg), "n=%5u  full sweep=%8.1f ns  bucket queue=%5.1f ns per eviction  (%.0fx)",
+             (unsigned)kSlots, sweepNs, queueNs, queueNs > 0 ? sweepNs / queueNs : 0.0);
+    TEST_MESSAGE(msg);
+}
+
+void test_benchmark_evict_200(void) { runEvictBenchmark<200>(); }
+void test_benchmark_evict_2000(void) { runEvictBenchmark<2000>(); }
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Basic operations
+    RUN_TEST(test_empty_peekReturnsMinusOne);
+    RUN_TEST(test_update_insertsAndRekeys);
+    RUN_TEST(test_remove_dropsSlot);
+    RUN_TEST(test_sameBucket_unlinkMiddle);
+    RUN_TEST(test_scores_clampToRange);
+    RUN_TEST(test_outOfRangeSlot_ignored);
+
+    // Correctness
+    RUN_TEST(test_randomOps_matchBruteForceMin);
+    RUN_TEST(test_lazyVerify_findsSameWeakestScoreAsSweep);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_evict_200);
+    RUN_TEST(test_benchmark_evict_2000);
+
+    return UNITY_END();
+}
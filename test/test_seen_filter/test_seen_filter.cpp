@@ -0,0 +1,366 @@
+// Seen Filter Tests
+// Tests WARHOG's cuckoo seen filter: sizing, signal levels, the New /
+// Repeat / Located / Better lifecycle, deletes that survive relocation,
+// the false-positive rate at full load against the old 4KB Bloom filter,
+// and a 50k-AP synthetic drive comparing where each one places the APs.
+
+#include <unity.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/core/seen_filter.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x1234567u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint64_t randomBssid() {
+    return (((uint64_t)nextRand() << 32) | nextRand()) & 0xFFFFFFFFFFFFull;
+}
+
+static double uniform() {
+    return (nextRand() & 0xFFFFFF) / 16777216.0;
+}
+
+// Same sizing as warhog.cpp
+static const size_t FILTER_BYTES = 8192;
+static uint16_t storage[FILTER_BYTES / sizeof(uint16_t)];
+
+// The Bloom filter WARHOG used before (warhog.cpp: 4KB, 3 hashes)
+struct OldBloom {
+    static const size_t kBytes = 4096;
+    static const uint32_t kMask = kBytes * 8 - 1;
+    uint8_t bits[kBytes];
+
+    void clear() { memset(bits, 0, sizeof(bits)); }
+
+    static uint32_t mix32(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return (uint32_t)x;
+    }
+
+    bool test(uint64_t key) const {
+        uint32_t h1 = mix32(key);
+        uint32_t h2 = mix32(key ^ 0x9e3779b97f4a7c15ULL) | 1U;
+        for (uint32_t i = 0; i < 3; i++) {
+            uint32_t idx = (h1 + i * h2) & kMask;
+            if ((bits[idx >> 3] & (1 << (idx & 7))) == 0) return false;
+        }
+        return true;
+    }
+
+    void add(uint64_t key) {
+        uint32_t h1 = mix32(key);
+        uint32_t h2 = mix32(key ^ 0x9e3779b97f4a7c15ULL) | 1U;
+        for (uint32_t i = 0; i < 3; i++) {
+            uint32_t idx = (h1 + i * h2) & kMask;
+            bits[idx >> 3] |= (1 << (idx & 7));
+        }
+    }
+};
+
+static OldBloom oldBloom;
+
+// ============================================================================
+// Sizing and levels
+// ============================================================================
+
+void test_attach_roundsToPowerOfTwoBuckets(void) {
+    SeenFilter f;
+    TEST_ASSERT_TRUE(f.attach(storage, sizeof(storage)));
+    TEST_ASSERT_EQUAL_UINT32(4096, f.capacity());
+    TEST_ASSERT_EQUAL_UINT32(8192, f.memoryBytes());
+
+    TEST_ASSERT_TRUE(f.attach(storage, 6000));  // 750 buckets -> 512
+    TEST_ASSERT_EQUAL_UINT32(2048, f.capacity());
+
+    TEST_ASSERT_FALSE(f.attach(storage, 7));
+    TEST_ASSERT_EQUAL_UINT32(0, f.capacity());
+    TEST_ASSERT_TRUE(f.observe(1, -50, true) == SeenFilter::Result::New);
+    TEST_ASSERT_FALSE(f.contains(1));
+}
+
+void test_levels_fiveDbSteps(void) {
+    TEST_ASSERT_EQUAL_UINT8(1, SeenFilter::levelFor(-128));
+    TEST_ASSERT_EQUAL_UINT8(1, SeenFilter::levelFor(-96));
+    TEST_ASSERT_EQUAL_UINT8(2, SeenFilter::levelFor(-95));
+    TEST_ASSERT_EQUAL_UINT8(3, SeenFilter::levelFor(-90));
+    TEST_ASSERT_EQUAL_UINT8(14, SeenFilter::levelFor(-35));
+    TEST_ASSERT_EQUAL_UINT8(15, SeenFilter::levelFor(-30));
+    TEST_ASSERT_EQUAL_UINT8(15, SeenFilter::levelFor(0));
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void test_observe_betterOnlyPastThreshold(void) {
+    SeenFilter f;
+    f.attach(storage, sizeof(storage), 10);
+    const uint64_t ap = 0xAABBCCDDEEFFull;
+
+    TEST_ASSERT_TRUE(f.observe(ap, -88, true) == SeenFilter::Result::New);
+    TEST_ASSERT_TRUE(f.observe(ap, -88, true) == SeenFilter::Result::Repeat);
+    TEST_ASSERT_TRUE(f.observe(ap, -83, true) == SeenFilter::Result::Repeat);   // +1 level
+    TEST_ASSERT_TRUE(f.check(ap, -78, true) == SeenFilter::Result::Better);
+    TEST_ASSERT_TRUE(f.check(ap, -78, true) == SeenFilter::Result::Better);     // check() is read-only
+    TEST_ASSERT_TRUE(f.observe(ap, -78, true) == SeenFilter::Result::Better);   // +2 levels
+    TEST_ASSERT_TRUE(f.observe(ap, -90, true) == SeenFilter::Result::Repeat);   // Weaker never lowers best
+    TEST_ASSERT_TRUE(f.observe(ap, -73, true) == SeenFilter::Result::Repeat);
+    TEST_ASSERT_TRUE(f.observe(ap, -66, true) == SeenFilter::Result::Better);
+    TEST_ASSERT_TRUE(f.observe(ap, -20, false) == SeenFilter::Result::Repeat);  // No fix: never Better
+    TEST_ASSERT_EQUAL_UINT32(1, f.size());
+}
+
+void test_observe_unrecordedIsLocatedOnceFixArrives(void) {
+    SeenFilter f;
+    f.attach(storage, sizeof(storage));
+    const uint64_t ap = 0x001122334455ull;
+
+    TEST_ASSERT_TRUE(f.observe(ap, -60, false) == SeenFilter::Result::New);
+    TEST_ASSERT_TRUE(f.observe(ap, -40, false) == SeenFilter::Result::Repeat);
+    TEST_ASSERT_TRUE(f.observe(ap, -92, true) == SeenFilter::Result::Located);
+    TEST_ASSERT_TRUE(f.observe(ap, -92, true) == SeenFilter::Result::Repeat);
+    TEST_ASSERT_TRUE(f.observe(ap, -80, true) == SeenFilter::Result::Better);
+}
+
+void test_remove_survivesRelocation(void) {
+    SeenFilter f;
+    f.attach(storage, sizeof(storage));
+    rngState = 0xC0FFEEu;
+    std::vector<uint64_t> keys;
+    while (keys.size() < 3600) {  // ~88% load: plenty of kicks
+        uint64_t k = randomBssid();
+        // Skip fingerprint twins (a false positive on insert) so each key owns a slot
+        if (f.observe(k, -70, true) == SeenFilter::Result::New) keys.push_back(k);
+    }
+    TEST_ASSERT_TRUE(f.getKicks() > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, f.getDrops());
+    TEST_ASSERT_EQUAL_UINT32(3600, f.size());
+
+    for (uint64_t k : keys) TEST_ASSERT_TRUE(f.contains(k));  // No false negatives
+    for (size_t i = 0; i < keys.size(); i += 2) TEST_ASSERT_TRUE(f.remove(keys[i]));
+    TEST_ASSERT_EQUAL_UINT32(1800, f.size());
+    for (size_t i = 1; i < keys.size(); i += 2) TEST_ASSERT_TRUE(f.contains(keys[i]));
+    TEST_ASSERT_FALSE(f.remove(keys[0]));
+    TEST_ASSERT_TRUE(f.observe(keys[0], -70, true) == SeenFilter::Result::New);
+
+    f.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, f.size());
+    TEST_ASSERT_FALSE(f.contains(keys[1]));
+}
+
+// ============================================================================
+// False positives
+// ============================================================================
+
+void test_falsePositives_fullLoadVsOldBloom(void) {
+    SeenFilter f;
+    f.attach(storage, sizeof(storage));
+    oldBloom.clear();
+    rngState = 0xBADC0DEu;
+
+    // Keep inserting well past capacity: the filter stays full, the Bloom fills up
+    const int inserted = 20000;
+    for (int i = 0; i < inserted; i++) {
+        uint64_t k = randomBssid();
+        f.observe(k, -70, true);
+        oldBloom.add(k);
+    }
+    TEST_ASSERT_TRUE(f.size() <= f.capacity());
+    TEST_ASSERT_TRUE(f.size() > f.capacity() * 95 / 100);
+
+    const int probes = 200000;
+    int filterHits = 0, bloomHits = 0;
+    for (int i = 0; i < probes; i++) {
+        uint64_t k = randomBssid() | 0x1000000000000ull;  // Outside the inserted key space
+        if (f.contains(k)) filterHits++;
+        if (oldBloom.test(k)) bloomHits++;
+    }
+    double filterRate = (double)filterHits / probes;
+    double bloomRate = (double)bloomHits / probes;
+    TEST_ASSERT_TRUE(filterRate < 0.003);  // 8 / 4096 at full load
+    TEST_ASSERT_TRUE(bloomRate > 0.5);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "FP after %d APs: seen filter %.3f%% (%u drops), old Bloom %.1f%%",
+             inserted, filterRate * 100, (unsigned)f.getDrops(), bloomRate * 100);
+    TEST_MESSAGE(msg);
+}
+
+// ============================================================================
+// Synthetic drive
+// ============================================================================
+
+struct DriveAp {
+    double x, y;          // Metres along / across the road
+    uint64_t bssid;
+    bool located;         // At least one record
+    double bestRssi;      // Strongest record so far
+    double errorM;        // Distance from that record's position to the AP
+    uint16_t records;
+    uint16_t news;        // New results (more than one = dropped and re-added)
+};
+
+struct DriveResult {
+    int located;
+    int records;
+    int renewed;
+    double meanError;
+    double medianError;
+};
+
+// Log-distance path loss with shadowing (about 200 m range at -92 dBm)
+static double rssiAt(double d) {
+    if (d < 1) d = 1;
+    double noise = (uniform() + uniform() + uniform() + uniform() - 2.0) * 7.0;  // ~4 dB sigma
+    return -30.0 - 27.0 * log10(d) + noise;
+}
+
+// 50k APs along 500 km of road; one recon sighting per AP per 2 s hop
+// cycle while in range, 20% of beacons missed. useFilter picks the new
+// filter; otherwise the old Bloom logic (record on first sighting only).
+static DriveResult runDrive(std::vector<DriveAp>& aps, bool useFilter, SeenFilter& f) {
+    for (auto& ap : aps) {
+        ap.located = false;
+        ap.records = 0;
+        ap.news = 0;
+        ap.bestRssi = -200;
+        ap.errorM = 0;
+    }
+    f.clear();
+    oldBloom.clear();
+
+    const double roadM = 500000.0;
+    const double stepM = 30.0;  // 15 m/s, 2 s per hop cycle
+    size_t lo = 0;
+    DriveResult r = {0, 0, 0, 0, 0};
+
+    for (double car = 0; car <= roadM; car += stepM) {
+        while (lo < aps.size() && aps[lo].x < car - 300) lo++;
+        for (size_t i = lo; i < aps.size() && aps[i].x < car + 300; i++) {
+            DriveAp& ap = aps[i];
+            double d = hypot(ap.x - car, ap.y);
+            double rssi = rssiAt(d);
+            if (rssi < -92 || uniform() < 0.2) continue;
+            int8_t rssi8 = (int8_t)std::max(-127.0, std::min(-1.0, rssi));
+
+            bool write = false;
+            if (useFilter) {
+                SeenFilter::Result res = f.observe(ap.bssid, rssi8, true);
+                if (res == SeenFilter::Result::New) ap.news++;
+                write = res != SeenFilter::Result::Repeat;
+            } else if (!oldBloom.test(ap.bssid)) {
+                oldBloom.add(ap.bssid);
+                ap.news++;
+                write = true;
+            }
+            if (!write) continue;
+
+            r.records++;
+            ap.records++;
+            if (rssi8 > ap.bestRssi) {
+                ap.bestRssi = rssi8;
+                ap.errorM = d;
+            }
+            ap.located = true;
+        }
+    }
+
+    std::vector<double> errors;
+    for (const auto& ap : aps) {
+        if (!ap.located) continue;
+        r.located++;
+        if (ap.news > 1) r.renewed++;
+        errors.push_back(ap.errorM);
+        r.meanError += ap.errorM;
+    }
+    if (!errors.empty()) {
+        r.meanError /= errors.size();
+        std::nth_element(errors.begin(), errors.begin() + errors.size() / 2, errors.end());
+        r.medianError = errors[errors.size() / 2];
+    }
+    return r;
+}
+
+void test_drive_50kAps_boundedMemoryBetterLocations(void) {
+    rngState = 0x5EEDF00Du;
+    std::vector<DriveAp> aps(50000);
+    for (auto& ap : aps) {
+        ap.x = uniform() * 500000.0;
+        ap.y = (uniform() - 0.5) * 160.0;  // Within 80 m either side of the road
+        ap.bssid = randomBssid();
+    }
+    std::sort(aps.begin(), aps.end(), [](const DriveAp& a, const DriveAp& b) { return a.x < b.x; });
+
+    SeenFilter f;
+    f.attach(storage, sizeof(storage));
+
+    DriveResult bloom = runDrive(aps, false, f);
+    DriveResult seen = runDrive(aps, true, f);
+
+    // Memory: fixed 8KB table, never more entries than slots
+    TEST_ASSERT_EQUAL_UINT32(FILTER_BYTES, f.memoryBytes());
+    TEST_ASSERT_TRUE(f.size() <= f.capacity());
+
+    // Coverage: the Bloom saturates and silently skips most of the drive
+    TEST_ASSERT_TRUE(bloom.located < 30000);
+    TEST_ASSERT_TRUE(seen.located > 49500);
+
+    // Location quality: strongest record sits much closer to the AP
+    TEST_ASSERT_TRUE(seen.medianError < bloom.medianError * 0.6);
+    TEST_ASSERT_TRUE(seen.meanError < bloom.meanError * 0.6);
+
+    // Cost: a few records per AP, and drops rarely hit an AP still in range
+    TEST_ASSERT_TRUE(seen.records < seen.located * 3);
+    TEST_ASSERT_TRUE(seen.renewed < seen.located / 50);
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "old Bloom: %d/50000 located, median %.0f m, mean %.0f m, %d records",
+             bloom.located, bloom.medianError, bloom.meanError, bloom.records);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg), "seen filter (%u B): %d/50000 located, median %.0f m, mean %.0f m, "
+             "%d records, %d re-added, %u drops",
+             (unsigned)f.memoryBytes(), seen.located, seen.medianError, seen.meanError,
+             seen.records, seen.renewed, (unsigned)f.getDrops());
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Sizing and levels
+    RUN_TEST(test_attach_roundsToPowerOfTwoBuckets);
+    RUN_TEST(test_levels_fiveDbSteps);
+
+    // Lifecycle
+    RUN_TEST(test_observe_betterOnlyPastThreshold);
+    RUN_TEST(test_observe_unrecordedIsLocatedOnceFixArrives);
+    RUN_TEST(test_remove_survivesRelocation);
+
+    // False positives
+    RUN_TEST(test_falsePositives_fullLoadVsOldBloom);
+
+    // Synthetic drive
+    RUN_TEST(test_drive_50kAps_boundedMemoryBetterLocations);
+
+    return UNITY_END();
+}
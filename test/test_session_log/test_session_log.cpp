@@ -0,0 +1,335 @@
+// Session Log Tests
+// Tests the RAM staging WARHOG's CSV and WiGLE logs write through: whole
+// record appends, fill and age flush thresholds, short writes, tracked
+// file size for rotation, and a benchmark counting SD operations per 1000
+// records for the old open/printf/close pattern against the buffered one.
+
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "../../src/core/session_log_buffer.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0xCC9E2D51u;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Counts calls the way the SD layer sees them
+struct FakeFs {
+    uint32_t opens = 0;
+    uint32_t closes = 0;
+    uint32_t writes = 0;
+    uint32_t sizes = 0;
+    uint32_t syncs = 0;
+    size_t shortWriteAt = 0;   // Nonzero: next write stops after this many bytes
+    std::string content;
+
+    uint32_t total() const { return opens + closes + writes + sizes + syncs; }
+
+    size_t write(const char* data, size_t len) {
+        writes++;
+        if (shortWriteAt > 0) {
+            len = shortWriteAt < len ? shortWriteAt : len;
+            shortWriteAt = 0;
+        }
+        content.append(data, len);
+        return len;
+    }
+};
+
+struct FakeAp {
+    uint8_t bssid[6];
+    char ssid[33];
+    int8_t rssi;
+    uint8_t channel;
+};
+
+static FakeAp makeAp() {
+    FakeAp ap;
+    for (int i = 0; i < 6; i++) ap.bssid[i] = (uint8_t)nextRand();
+    uint8_t len = (uint8_t)(nextRand() % 33);
+    for (uint8_t i = 0; i < len; i++) ap.ssid[i] = (char)('a' + nextRand() % 26);
+    ap.ssid[len] = '\0';
+    ap.rssi = (int8_t)(-30 - (int)(nextRand() % 60));
+    ap.channel = (uint8_t)(1 + nextRand() % 13);
+    return ap;
+}
+
+// Old WARHOG pattern: for each geotagged AP, appendCSVEntry() opened the
+// CSV, issued printf/print calls (writeCSVField printed per character) and
+// closed it; appendWigleEntry() opened the WiGLE file read-only to size()
+// it, then opened it again to append a dozen printf/print calls.
+static void legacyRecord(FakeFs& fs, const FakeAp& ap) {
+    uint32_t ssidWrites = 2 + (uint32_t)strlen(ap.ssid);  // Quotes + one per char
+
+    fs.opens++;                              // CSV open(FILE_APPEND)
+    fs.writes += 1 + ssidWrites + 1 + 1;     // MAC, SSID, ",", rest
+    fs.closes++;
+
+    fs.opens++;                              // checkWigleFileRotation
+    fs.sizes++;
+    fs.closes++;
+    fs.opens++;                              // WiGLE open(FILE_APPEND)
+    fs.writes += 1 + ssidWrites + 1 + 2 + 1 + 1 + 1 + 1 + 1 + 1 + 1;
+    fs.closes++;
+}
+
+// Mirrors SessionLogWriter: append, flush and retry when full, flush when due
+struct BufferedLog {
+    SessionLogBuffer buf;
+    FakeFs* fs;
+    uint32_t dropped = 0;
+
+    void open(char* storage, size_t bytes, FakeFs& f, const char* header) {
+        fs = &f;
+        buf.attach(storage, bytes, 0, 10000);
+        fs->opens++;
+        fs->write(header, strlen(header));
+        fs->syncs++;
+        buf.begin((uint32_t)strlen(header));
+    }
+
+    void flush() {
+        if (buf.pending() == 0) return;
+        buf.flush([this](const char* d, size_t n) { return fs->write(d, n); });
+        fs->syncs++;
+    }
+
+    template <typename... Args>
+    void record(uint32_t now, const char* fmt, Args... args) {
+        bool ok = buf.appendf(now, fmt, args...);
+        if (!ok) {
+            flush();
+            ok = buf.appendf(now, fmt, args...);
+        }
+        if (!ok) {
+            dropped++;
+            return;
+        }
+        if (buf.flushDue(now)) flush();
+    }
+
+    void poll(uint32_t now) {
+        if (buf.flushDue(now)) flush();
+    }
+
+    void close() {
+        flush();
+        fs->closes++;
+    }
+};
+
+static void csvRecord(BufferedLog& log, uint32_t now, const FakeAp& ap) {
+    log.record(now, "%02X:%02X:%02X:%02X:%02X:%02X,\"%s\",%d,%d,%s,%.6f,%.6f,%.1f,%lu\n",
+               ap.bssid[0], ap.bssid[1], ap.bssid[2], ap.bssid[3], ap.bssid[4], ap.bssid[5],
+               ap.ssid, ap.rssi, ap.channel, "WPA2", 51.507351, -0.127758, 35.2,
+               (unsigned long)now);
+}
+
+static void wigleRecord(BufferedLog& log, uint32_t now, const FakeAp& ap) {
+    log.record(now, "%02X:%02X:%02X:%02X:%02X:%02X,\"%s\",%s,%s,%d,%d,%d,%.6f,%.6f,%.1f,%.1f,,,WIFI\r\n",
+               ap.bssid[0], ap.bssid[1], ap.bssid[2], ap.bssid[3], ap.bssid[4], ap.bssid[5],
+               ap.ssid, "[WPA2-PSK-CCMP][ESS]", "2026-10-16 12:00:00", ap.channel,
+               2412 + (ap.channel - 1) * 5, ap.rssi, 51.507351, -0.127758, 35.2, 7.5);
+}
+
+// ============================================================================
+// Appends
+// ============================================================================
+
+void test_append_wholeRecordOrNothing(void) {
+    char storage[32];
+    SessionLogBuffer b;
+    b.attach(storage, sizeof(storage));
+    TEST_ASSERT_TRUE(b.appendf(0, "%s,%d\n", "alpha", 1));   // 8 bytes
+    TEST_ASSERT_TRUE(b.appendf(0, "%s\n", "0123456789abcdef"));  // 17 bytes
+    TEST_ASSERT_EQUAL_UINT32(25, b.pending());
+
+    // 8 more bytes would need 33 with the terminator: rejected, untouched
+    TEST_ASSERT_FALSE(b.appendf(0, "%s\n", "1234567"));
+    TEST_ASSERT_EQUAL_UINT32(25, b.pending());
+    TEST_ASSERT_EQUAL_UINT32(2, b.getRecords());
+
+    FakeFs fs;
+    TEST_ASSERT_TRUE(b.flush([&](const char* d, size_t n) { return fs.write(d, n); }));
+    TEST_ASSERT_EQUAL_STRING("alpha,1\n0123456789abcdef\n", fs.content.c_str());
+    TEST_ASSERT_TRUE(b.append(0, "raw", 3));
+    TEST_ASSERT_FALSE(b.append(0, storage, sizeof(storage)));
+}
+
+void test_unattached_rejectsEverything(void) {
+    SessionLogBuffer b;
+    TEST_ASSERT_FALSE(b.attached());
+    TEST_ASSERT_FALSE(b.appendf(0, "x"));
+    TEST_ASSERT_FALSE(b.flushDue(100000));
+}
+
+// ============================================================================
+// Flush policy
+// ============================================================================
+
+void test_flushDue_fillThreshold(void) {
+    char storage[100];
+    SessionLogBuffer b;
+    b.attach(storage, sizeof(storage), 0, 60000);  // Due at 75 bytes
+    for (int i = 0; i < 7; i++) TEST_ASSERT_TRUE(b.appendf(0, "%09d\n", i));
+    TEST_ASSERT_FALSE(b.flushDue(0));
+    TEST_ASSERT_TRUE(b.appendf(0, "%09d\n", 7));
+    TEST_ASSERT_TRUE(b.flushDue(0));
+}
+
+void test_flushDue_ageOfOldestRecord(void) {
+    char storage[256];
+    SessionLogBuffer b;
+    b.attach(storage, sizeof(storage), 0, 10000);
+    TEST_ASSERT_FALSE(b.flushDue(50000));  // Nothing pending
+    b.appendf(1000, "a\n");
+    b.appendf(9000, "b\n");
+    TEST_ASSERT_FALSE(b.flushDue(10999));
+    TEST_ASSERT_TRUE(b.flushDue(11000));   // Oldest record, not newest
+
+    FakeFs fs;
+    b.flush([&](const char* d, size_t n) { return fs.write(d, n); });
+    b.appendf(0xFFFFF000u, "c\n");         // Across millis() wrap
+    TEST_ASSERT_FALSE(b.flushDue(0x00000100u));
+    TEST_ASSERT_TRUE(b.flushDue(0x00002000u));
+}
+
+void test_shortWrite_keepsTailForNextFlush(void) {
+    char storage[64];
+    SessionLogBuffer b;
+    b.attach(storage, sizeof(storage));
+    b.begin(10);
+    b.appendf(0, "first line\n");
+    b.appendf(0, "second line\n");
+    TEST_ASSERT_EQUAL_UINT32(33, b.fileBytes());
+
+    FakeFs fs;
+    fs.shortWriteAt = 5;
+    auto sink = [&](const char* d, size_t n) { return fs.write(d, n); };
+    TEST_ASSERT_FALSE(b.flush(sink));
+    TEST_ASSERT_EQUAL_UINT32(18, b.pending());
+    TEST_ASSERT_EQUAL_UINT32(33, b.fileBytes());
+    TEST_ASSERT_EQUAL_UINT32(1, b.getFailedFlushes());
+
+    TEST_ASSERT_TRUE(b.flush(sink));
+    TEST_ASSERT_EQUAL_STRING("first line\nsecond line\n", fs.content.c_str());
+    TEST_ASSERT_EQUAL_UINT32(33, b.fileBytes());
+}
+
+void test_fileBytes_drivesRotationWithoutSize(void) {
+    // WARHOG rotates the WiGLE log at 400000 bytes; the tracked size must
+    // match what actually reached each file
+    const uint32_t LIMIT = 400000;
+    static char storage[2048];
+    FakeFs fs;
+    BufferedLog log;
+    const char* header = "WigleWifi-1.6,appRelease=test\nMAC,SSID\r\n";
+    log.open(storage, sizeof(storage), fs, header);
+    uint32_t files = 1;
+    uint32_t now = 0;
+    for (int i = 0; i < 8000; i++) {
+        if (log.buf.fileBytes() >= LIMIT) {
+            log.close();
+            TEST_ASSERT_EQUAL_UINT32(fs.content.size(), log.buf.fileBytes());
+            TEST_ASSERT_TRUE(fs.content.size() < LIMIT + 200);
+            fs.content.clear();
+            log.open(storage, sizeof(storage), fs, header);
+            files++;
+        }
+        now += 50;
+        wigleRecord(log, now, makeAp());
+    }
+    log.close();
+    TEST_ASSERT_EQUAL_UINT32(fs.content.size(), log.buf.fileBytes());
+    TEST_ASSERT_EQUAL_UINT32(0, fs.sizes);
+    TEST_ASSERT_EQUAL_UINT32(0, log.dropped);
+    TEST_ASSERT_TRUE(files >= 2);
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+void test_benchmark_fsOpsPer1000Records(void) {
+    // 1000 geotagged APs arriving in scans of up to 60 every 5 s, each
+    // logged to both the CSV and the WiGLE file
+    const uint32_t RECORDS = 1000;
+    rngState = 0xCC9E2D51u;
+    FakeFs legacy;
+    for (uint32_t i = 0; i < RECORDS; i++) legacyRecord(legacy, makeAp());
+
+    rngState = 0xCC9E2D51u;
+    static char csvStorage[1024];
+    static char wigleStorage[2048];
+    FakeFs fs;
+    BufferedLog csv, wigle;
+    csv.open(csvStorage, sizeof(csvStorage), fs, "BSSID,SSID\r\n");
+    wigle.open(wigleStorage, sizeof(wigleStorage), fs, "WigleWifi-1.6\nMAC,SSID\r\n");
+    uint32_t now = 0;
+    uint32_t logged = 0;
+    while (logged < RECORDS) {
+        uint32_t scan = 1 + nextRand() % 60;
+        for (uint32_t i = 0; i < scan && logged < RECORDS; i++, logged++) {
+            FakeAp ap = makeAp();
+            csvRecord(csv, now, ap);
+            wigleRecord(wigle, now, ap);
+        }
+        for (int tick = 0; tick < 50; tick++) {  // update() polls between scans
+            now += 100;
+            csv.poll(now);
+            wigle.poll(now);
+        }
+    }
+    csv.close();
+    wigle.close();
+
+    TEST_ASSERT_EQUAL_UINT32(0, csv.dropped + wigle.dropped);
+    TEST_ASSERT_EQUAL_UINT32(RECORDS, csv.buf.getRecords());
+    TEST_ASSERT_EQUAL_UINT32(0, fs.sizes);
+    TEST_ASSERT_TRUE(legacy.opens + legacy.closes >= 100 * (fs.opens + fs.closes));
+    TEST_ASSERT_TRUE(legacy.total() >= 20 * fs.total());
+
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "legacy: %u ops (%u open, %u close, %u write, %u size) per %u records",
+             (unsigned)legacy.total(), (unsigned)legacy.opens, (unsigned)legacy.closes,
+             (unsigned)legacy.writes, (unsigned)legacy.sizes, (unsigned)RECORDS);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg),
+             "buffered: %u ops (%u open, %u close, %u write, %u sync) per %u records",
+             (unsigned)fs.total(), (unsigned)fs.opens, (unsigned)fs.closes,
+             (unsigned)fs.writes, (unsigned)fs.syncs, (unsigned)RECORDS);
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Appends
+    RUN_TEST(test_append_wholeRecordOrNothing);
+    RUN_TEST(test_unattached_rejectsEverything);
+
+    // Flush policy
+    RUN_TEST(test_flushDue_fillThreshold);
+    RUN_TEST(test_flushDue_ageOfOldestRecord);
+    RUN_TEST(test_shortWrite_keepsTailForNextFlush);
+    RUN_TEST(test_fileBytes_drivesRotationWithoutSize);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_fsOpsPer1000Records);
+
+    return UNITY_END();
+}
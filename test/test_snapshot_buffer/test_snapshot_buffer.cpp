@@ -0,0 +1,256 @@
+// Snapshot Buffer Tests
+// Tests the double-buffered published view NetworkRecon hands to UI and
+// mode readers: publish/acquire, reader pinning, storage swaps, and a
+// multi-thread writer/reader stress run checking every view is whole.
+
+#include <unity.h>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../../src/core/snapshot_buffer.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+struct Item {
+    uint32_t gen;
+    uint32_t idx;
+};
+
+typedef SnapshotBuffer<Item> ItemSnapshots;
+
+static void fill(Item* data, uint16_t count, uint32_t gen) {
+    for (uint16_t i = 0; i < count; i++) {
+        data[i].gen = gen;
+        data[i].idx = i;
+    }
+}
+
+// Attach storage to both slots by publishing twice
+static void primeBoth(ItemSnapshots& s, Item* a, Item* b, uint16_t cap) {
+    Item* back = nullptr;
+    uint16_t c = 0;
+    s.beginWrite(back, c);
+    s.attachBack(a, cap);
+    s.publish(0, 0);
+    s.beginWrite(back, c);
+    s.attachBack(b, cap);
+    s.publish(0, 0);
+}
+
+// ============================================================================
+// Basic operations
+// ============================================================================
+
+void test_acquire_beforePublish_isEmpty(void) {
+    ItemSnapshots s;
+    ItemSnapshots::View v;
+    TEST_ASSERT_FALSE(s.acquire(v));
+    TEST_ASSERT_EQUAL_UINT16(0, v.count);
+    TEST_ASSERT_EQUAL_INT8(-1, v.slot);
+    s.release(v);  // Harmless
+}
+
+void test_publish_thenAcquire_seesData(void) {
+    ItemSnapshots s;
+    static Item a[8], b[8];
+    primeBoth(s, a, b, 8);
+
+    Item* back = nullptr;
+    uint16_t cap = 0;
+    TEST_ASSERT_TRUE(s.beginWrite(back, cap));
+    TEST_ASSERT_NOT_NULL(back);
+    TEST_ASSERT_EQUAL_UINT16(8, cap);
+    fill(back, 5, 42);
+    s.publish(5, 1234);
+
+    ItemSnapshots::View v;
+    TEST_ASSERT_TRUE(s.acquire(v));
+    TEST_ASSERT_EQUAL_UINT16(5, v.count);
+    TEST_ASSERT_EQUAL_UINT32(1234, v.stamp);
+    TEST_ASSERT_EQUAL_UINT32(s.generation(), v.generation);
+    TEST_ASSERT_TRUE(v.data == back);
+    TEST_ASSERT_EQUAL_UINT32(42, v.data[4].gen);
+    s.release(v);
+}
+
+void test_publish_clampsToCapacity(void) {
+    ItemSnapshots s;
+    static Item a[4], b[4];
+    primeBoth(s, a, b, 4);
+    Item* back = nullptr;
+    uint16_t cap = 0;
+    s.beginWrite(back, cap);
+    s.publish(100, 0);
+    ItemSnapshots::View v;
+    s.acquire(v);
+    TEST_ASSERT_EQUAL_UINT16(4, v.count);
+    s.release(v);
+}
+
+void test_generation_increments(void) {
+    ItemSnapshots s;
+    static Item a[4], b[4];
+    primeBoth(s, a, b, 4);
+    uint32_t g0 = s.generation();
+    Item* back = nullptr;
+    uint16_t cap = 0;
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(s.beginWrite(back, cap));
+        s.publish(1, 0);
+    }
+    TEST_ASSERT_EQUAL_UINT32(g0 + 5, s.generation());
+}
+
+void test_heldSlot_isNotRewritten(void) {
+    ItemSnapshots s;
+    static Item a[4], b[4];
+    primeBoth(s, a, b, 4);
+    Item* back = nullptr;
+    uint16_t cap = 0;
+
+    s.beginWrite(back, cap);
+    fill(back, 4, 7);
+    s.publish(4, 0);
+
+    ItemSnapshots::View held;
+    TEST_ASSERT_TRUE(s.acquire(held));
+    TEST_ASSERT_TRUE(held.data == back);
+
+    // One more publish goes to the other slot...
+    Item* other = nullptr;
+    TEST_ASSERT_TRUE(s.beginWrite(other, cap));
+    TEST_ASSERT_TRUE(other != held.data);
+    fill(other, 4, 8);
+    s.publish(4, 0);
+
+    // ...but the next would land on the held slot: skipped
+    Item* blocked = nullptr;
+    TEST_ASSERT_FALSE(s.beginWrite(blocked, cap));
+    TEST_ASSERT_EQUAL_UINT32(1, s.getBusySkips());
+    TEST_ASSERT_EQUAL_UINT32(7, held.data[3].gen);
+
+    s.release(held);
+    TEST_ASSERT_TRUE(s.beginWrite(blocked, cap));
+}
+
+void test_attachBack_returnsOldStorage(void) {
+    ItemSnapshots s;
+    static Item a[4], b[4], grown[16];
+    primeBoth(s, a, b, 4);
+    Item* back = nullptr;
+    uint16_t cap = 0;
+    s.beginWrite(back, cap);
+    Item* old = s.attachBack(grown, 16);
+    TEST_ASSERT_TRUE(old == back);
+    s.publish(16, 0);
+    ItemSnapshots::View v;
+    s.acquire(v);
+    TEST_ASSERT_TRUE(v.data == grown);
+    TEST_ASSERT_EQUAL_UINT16(16, v.count);
+    s.release(v);
+}
+
+void test_detachAll_refusedWhileReading(void) {
+    ItemSnapshots s;
+    static Item a[4], b[4];
+    primeBoth(s, a, b, 4);
+    ItemSnapshots::View v;
+    s.acquire(v);
+    Item* x = nullptr;
+    Item* y = nullptr;
+    TEST_ASSERT_FALSE(s.detachAll(x, y));
+    s.release(v);
+    TEST_ASSERT_TRUE(s.detachAll(x, y));
+    TEST_ASSERT_TRUE((x == a && y == b) || (x == b && y == a));
+    TEST_ASSERT_FALSE(s.acquire(v));
+}
+
+// ============================================================================
+// Concurrency
+// ============================================================================
+
+// Writer republishes continuously; every item of a slot carries the
+// generation it was written for, so a torn or reused view shows up as a
+// mismatch. Readers also check generations never go backwards.
+void test_stress_viewsAreNeverTorn(void) {
+    static ItemSnapshots s;
+    const uint16_t kCap = 64;
+    static Item a[kCap], b[kCap];
+    primeBoth(s, a, b, kCap);
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> torn{0};
+    std::atomic<uint32_t> backwards{0};
+    std::atomic<uint32_t> reads{0};
+    uint32_t published = 0;
+
+    auto reader = [&]() {
+        uint32_t lastGen = 0;
+        while (!stop.load()) {
+            ItemSnapshots::View v;
+            if (!s.acquire(v)) continue;
+            if (v.generation < lastGen) backwards++;
+            lastGen = v.generation;
+            for (uint16_t i = 0; i < v.count; i++) {
+                if (v.data[i].gen != v.generation || v.data[i].idx != i) {
+                    torn++;
+                    break;
+                }
+            }
+            s.release(v);
+            reads++;
+        }
+    };
+
+    std::thread r1(reader);
+    std::thread r2(reader);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    while (std::chrono::steady_clock::now() < deadline) {
+        Item* back = nullptr;
+        uint16_t cap = 0;
+        if (!s.beginWrite(back, cap)) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint16_t n = (uint16_t)(1 + (published % cap));
+        fill(back, n, s.generation() + 1);
+        s.publish(n, 0);
+        published++;
+    }
+    stop.store(true);
+    r1.join();
+    r2.join();
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "published=%u reads=%u busy skips=%u",
+             published, reads.load(), s.getBusySkips());
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_EQUAL_UINT32(0, backwards.load());
+    TEST_ASSERT_TRUE(published > 0);
+    TEST_ASSERT_TRUE(reads.load() > 0);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Basic operations
+    RUN_TEST(test_acquire_beforePublish_isEmpty);
+    RUN_TEST(test_publish_thenAcquire_seesData);
+    RUN_TEST(test_publish_clampsToCapacity);
+    RUN_TEST(test_generation_increments);
+    RUN_TEST(test_heldSlot_isNotRewritten);
+    RUN_TEST(test_attachBack_returnsOldStorage);
+    RUN_TEST(test_detachAll_refusedWhileReading);
+
+    // Concurrency
+    RUN_TEST(test_stress_viewsAreNeverTorn);
+
+    return UNITY_END();
+}
@@ -0,0 +1,281 @@
+// SPSC Queue Tests
+// Tests the fixed-slot queue OINK and DO NO HAM use to hand EAPOL frames
+// from the recon dispatch context to update(): FIFO order, full/drop
+// accounting, high water, in-place slots, a burst of several stations'
+// 4-way handshakes in one tick, and a two-thread stress run (build with
+// -e native_tsan to run it under ThreadSanitizer).
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include "../../src/core/spsc_queue.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x85EBCA6Bu;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Roughly the shape of PendingEapolFrame: addresses, index, big payload
+struct FakeEapol {
+    uint8_t bssid[6];
+    uint8_t station[6];
+    uint8_t msgIdx;
+    uint32_t seq;
+    uint16_t len;
+    uint8_t data[512];
+};
+
+static void fillPattern(uint8_t* p, uint16_t len, uint32_t seq) {
+    for (uint16_t i = 0; i < len; i++) p[i] = (uint8_t)(seq * 31u + i);
+}
+
+static bool checkPattern(const uint8_t* p, uint16_t len, uint32_t seq) {
+    for (uint16_t i = 0; i < len; i++) {
+        if (p[i] != (uint8_t)(seq * 31u + i)) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Basic operations
+// ============================================================================
+
+void test_empty_peekReturnsNull(void) {
+    SpscQueue<uint32_t, 4> q;
+    TEST_ASSERT_TRUE(q.empty());
+    TEST_ASSERT_NULL(q.peek());
+    uint32_t v = 7;
+    TEST_ASSERT_FALSE(q.pop(v));
+    TEST_ASSERT_EQUAL_UINT32(7, v);
+    TEST_ASSERT_EQUAL_UINT16(0, q.size());
+}
+
+void test_fifoOrder_preserved(void) {
+    SpscQueue<uint32_t, 8> q;
+    for (uint32_t i = 0; i < 5; i++) TEST_ASSERT_TRUE(q.push(i * 10));
+    TEST_ASSERT_EQUAL_UINT16(5, q.size());
+    for (uint32_t i = 0; i < 5; i++) {
+        uint32_t v;
+        TEST_ASSERT_TRUE(q.pop(v));
+        TEST_ASSERT_EQUAL_UINT32(i * 10, v);
+    }
+    TEST_ASSERT_TRUE(q.empty());
+    TEST_ASSERT_EQUAL_UINT32(5, q.getPushed());
+    TEST_ASSERT_EQUAL_UINT32(5, q.getPopped());
+}
+
+void test_full_everySlotUsableThenDrops(void) {
+    SpscQueue<uint32_t, 4> q;
+    TEST_ASSERT_EQUAL_UINT16(4, (SpscQueue<uint32_t, 4>::kCapacity));
+    for (uint32_t i = 0; i < 4; i++) TEST_ASSERT_TRUE(q.push(i));
+    TEST_ASSERT_NULL(q.beginPush());
+    TEST_ASSERT_FALSE(q.push(99));
+    TEST_ASSERT_EQUAL_UINT32(2, q.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(4, q.getPushed());
+
+    // One pop frees exactly one slot
+    uint32_t v;
+    TEST_ASSERT_TRUE(q.pop(v));
+    TEST_ASSERT_EQUAL_UINT32(0, v);
+    TEST_ASSERT_TRUE(q.push(4));
+    TEST_ASSERT_FALSE(q.push(5));
+    TEST_ASSERT_EQUAL_UINT32(3, q.getDropped());
+}
+
+void test_highWater_tracksPeak(void) {
+    SpscQueue<uint32_t, 16> q;
+    for (uint32_t i = 0; i < 6; i++) q.push(i);
+    for (uint32_t i = 0; i < 6; i++) q.pop();
+    for (uint32_t i = 0; i < 3; i++) q.push(i);
+    TEST_ASSERT_EQUAL_UINT32(6, q.getHighWater());
+
+    q.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, q.getHighWater());
+    TEST_ASSERT_EQUAL_UINT32(0, q.getPushed());
+    TEST_ASSERT_EQUAL_UINT16(3, q.size());  // Stats only, items stay
+
+    q.reset();
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+void test_inPlace_beginPushPeek(void) {
+    static SpscQueue<FakeEapol, 4> q;
+    q.reset();
+    FakeEapol* slot = q.beginPush();
+    TEST_ASSERT_NOT_NULL(slot);
+    TEST_ASSERT_TRUE(q.empty());  // Not visible until committed
+    slot->seq = 42;
+    slot->len = 300;
+    fillPattern(slot->data, slot->len, 42);
+    q.commitPush();
+
+    FakeEapol* item = q.peek();
+    TEST_ASSERT_TRUE(item == slot);  // Same storage, no copy
+    TEST_ASSERT_EQUAL_UINT32(42, item->seq);
+    TEST_ASSERT_TRUE(checkPattern(item->data, item->len, 42));
+    q.pop();
+    TEST_ASSERT_NULL(q.peek());
+}
+
+void test_randomSequence_matchesReferenceQueue(void) {
+    SpscQueue<uint32_t, 8> q;
+    std::deque<uint32_t> ref;
+    uint32_t drops = 0;
+    for (uint32_t step = 0; step < 100000; step++) {
+        if (nextRand() % 3 != 0) {
+            uint32_t v = nextRand();
+            if (q.push(v)) {
+                ref.push_back(v);
+            } else {
+                TEST_ASSERT_EQUAL_UINT32(8, ref.size());
+                drops++;
+            }
+        } else {
+            uint32_t v;
+            bool got = q.pop(v);
+            TEST_ASSERT_EQUAL(!ref.empty(), got);
+            if (got) {
+                TEST_ASSERT_EQUAL_UINT32(ref.front(), v);
+                ref.pop_front();
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT16(ref.size(), q.size());
+    }
+    TEST_ASSERT_EQUAL_UINT32(drops, q.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(8, q.getHighWater());
+}
+
+// ============================================================================
+// EAPOL burst
+// ============================================================================
+
+void test_burst_fourStationsFitInOneTick(void) {
+    // Client mass-reconnect after a deauth: 4 stations on 2 APs each send
+    // M1-M4 before update() runs once. Every frame must survive.
+    static SpscQueue<FakeEapol, 16> q;
+    q.reset();
+    uint32_t seq = 0;
+    for (uint8_t msg = 0; msg < 4; msg++) {
+        for (uint8_t sta = 0; sta < 4; sta++) {
+            FakeEapol* slot = q.beginPush();
+            TEST_ASSERT_NOT_NULL(slot);
+            memset(slot->bssid, 0xA0 + (sta & 1), 6);
+            memset(slot->station, 0x10 + sta, 6);
+            slot->msgIdx = msg;
+            slot->seq = seq;
+            slot->len = 99;
+            fillPattern(slot->data, slot->len, seq++);
+            q.commitPush();
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, q.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(16, q.getHighWater());
+
+    uint8_t seen[4] = {0};
+    while (FakeEapol* item = q.peek()) {
+        uint8_t sta = (uint8_t)(item->station[0] - 0x10);
+        TEST_ASSERT_TRUE(sta < 4);
+        seen[sta] |= (uint8_t)(1u << item->msgIdx);
+        TEST_ASSERT_TRUE(checkPattern(item->data, item->len, item->seq));
+        q.pop();
+    }
+    for (uint8_t sta = 0; sta < 4; sta++) TEST_ASSERT_EQUAL_HEX8(0x0F, seen[sta]);
+
+    // One more station in the same tick overflows and is counted
+    for (uint8_t i = 0; i < 17; i++) {
+        if (q.beginPush()) q.commitPush();
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, q.getDropped());
+}
+
+// ============================================================================
+// Concurrency
+// ============================================================================
+
+void test_twoThreads_noCorruptionOrReorder(void) {
+    static SpscQueue<FakeEapol, 16> q;
+    q.reset();
+    const uint32_t kItems = 200000;
+
+    std::thread producer([&]() {
+        uint32_t localRng = 0xC0FFEEu;
+        for (uint32_t seq = 0; seq < kItems; seq++) {
+            localRng = localRng * 1664525u + 1013904223u;
+            FakeEapol* slot = q.beginPush();
+            if (slot) {
+                slot->seq = seq;
+                slot->len = (uint16_t)((localRng >> 8) % sizeof(slot->data));
+                fillPattern(slot->data, slot->len, seq);
+                q.commitPush();
+            }
+            if ((seq & 7) == 0) std::this_thread::yield();  // Bursty, like a busy channel
+        }
+    });
+
+    uint32_t received = 0;
+    uint32_t lastSeq = 0;
+    bool ordered = true;
+    bool intact = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (std::chrono::steady_clock::now() < deadline) {
+        FakeEapol* item = q.peek();
+        if (!item) {
+            if (q.getPushed() + q.getDropped() == kItems && q.empty()) break;
+            std::this_thread::yield();
+            continue;
+        }
+        if (received > 0 && item->seq <= lastSeq) ordered = false;
+        if (!checkPattern(item->data, item->len, item->seq)) intact = false;
+        lastSeq = item->seq;
+        received++;
+        q.pop();
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_TRUE(intact);
+    TEST_ASSERT_EQUAL_UINT32(kItems, q.getPushed() + q.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(q.getPushed(), received);
+    TEST_ASSERT_EQUAL_UINT32(received, q.getPopped());
+    TEST_ASSERT_TRUE(q.getHighWater() <= 16);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "stress: %u items, %u delivered, %u dropped, high water %u/%u slots",
+             (unsigned)kItems, (unsigned)received, (unsigned)q.getDropped(),
+             (unsigned)q.getHighWater(), (unsigned)SpscQueue<FakeEapol, 16>::kCapacity);
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Basic operations
+    RUN_TEST(test_empty_peekReturnsNull);
+    RUN_TEST(test_fifoOrder_preserved);
+    RUN_TEST(test_full_everySlotUsableThenDrops);
+    RUN_TEST(test_highWater_tracksPeak);
+    RUN_TEST(test_inPlace_beginPushPeek);
+    RUN_TEST(test_randomSequence_matchesReferenceQueue);
+
+    // EAPOL burst
+    RUN_TEST(test_burst_fourStationsFitInOneTick);
+
+    // Concurrency
+    RUN_TEST(test_twoThreads_noCorruptionOrReorder);
+
+    return UNITY_END();
+}
@@ -0,0 +1,402 @@
+// Wardrive Format Tests
+// Tests WARHOG's binary session log: record layout, GPS time conversion,
+// WiGLE and legacy CSV lines checked against the printf formats WARHOG
+// used to write directly, the worst-case line length over every field's
+// full range, the streaming renderer at odd chunk sizes and
+// with torn or foreign files, and the per-AP write cost before and after.
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../../src/core/wardrive_format.h"
+
+using namespace WardriveFormat;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t rngState = 0x27D4EB2Fu;
+
+static uint32_t nextRand() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+struct Sighting {
+    uint8_t bssid[6];
+    char ssid[33];
+    int8_t rssi;
+    uint8_t channel;
+    uint8_t auth;
+    double lat, lon, alt, accuracy;
+    uint32_t date, time, uptimeMs;
+};
+
+// Random E7 coordinate whose 7th decimal is not 5, so rounding to 6
+// decimals has no ties that binary doubles could break either way
+static double randomCoord(int32_t maxDeg) {
+    int32_t e7 = (int32_t)(nextRand() % (uint32_t)(maxDeg * 10000000)) - maxDeg * 5000000;
+    if ((e7 >= 0 ? e7 : -e7) % 10 == 5) e7++;
+    return e7 / 1e7;
+}
+
+static Sighting makeSighting() {
+    Sighting s;
+    for (int i = 0; i < 6; i++) s.bssid[i] = (uint8_t)nextRand();
+    static const char alphabet[] = "abcXYZ019 _-\"',\t";
+    uint8_t len = (uint8_t)(nextRand() % 33);
+    for (uint8_t i = 0; i < len; i++) s.ssid[i] = alphabet[nextRand() % (sizeof(alphabet) - 1)];
+    s.ssid[len] = '\0';
+    s.rssi = (int8_t)(-20 - (int)(nextRand() % 75));
+    static const uint8_t channels[] = {1, 6, 11, 13, 14, 36, 149, 165};
+    s.channel = channels[nextRand() % sizeof(channels)];
+    s.auth = (uint8_t)(nextRand() % 10);
+    s.lat = randomCoord(180);
+    s.lon = randomCoord(360);
+    s.alt = ((int32_t)(nextRand() % 40000) - 2000) / 10.0;
+    s.accuracy = (nextRand() % 4 == 0) ? 10.0 : (nextRand() % 300) * 0.5;
+    if (nextRand() % 8 == 0) {
+        s.date = 0;
+        s.time = 0;
+    } else {
+        s.date = (1 + nextRand() % 28) * 10000 + (1 + nextRand() % 12) * 100 + 20 + nextRand() % 10;
+        s.time = (nextRand() % 24) * 1000000 + (nextRand() % 60) * 10000 + (nextRand() % 60) * 100;
+    }
+    s.uptimeMs = nextRand();
+    return s;
+}
+
+static Record toRecord(const Sighting& s) {
+    return makeRecord(s.bssid, s.ssid, s.rssi, s.channel, s.auth, s.lat, s.lon, s.alt,
+                      s.accuracy, epochFromGps(s.date, s.time), s.uptimeMs);
+}
+
+// WARHOG's old writeCSVField
+static std::string legacyField(const char* ssid) {
+    std::string out = "\"";
+    for (int i = 0; i < 32 && ssid[i]; i++) {
+        if (ssid[i] == '"') out += "\"\"";
+        else if (ssid[i] >= 32) out += ssid[i];
+    }
+    return out + "\"";
+}
+
+// WARHOG's old appendCSVEntry line
+static std::string legacyCsv(const Sighting& s) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X,%s,%d,%d,%s,%.6f,%.6f,%.1f,%lu\n",
+             s.bssid[0], s.bssid[1], s.bssid[2], s.bssid[3], s.bssid[4], s.bssid[5],
+             legacyField(s.ssid).c_str(), s.rssi, s.channel, authString(s.auth),
+             s.lat, s.lon, s.alt, (unsigned long)s.uptimeMs);
+    return buf;
+}
+
+// WARHOG's old appendWigleEntry line
+static std::string legacyWigle(const Sighting& s) {
+    char seen[32];
+    if (s.date > 0 && s.time > 0) {
+        snprintf(seen, sizeof(seen), "20%02d-%02d-%02d %02d:%02d:%02d",
+                 (int)(s.date % 100), (int)((s.date / 100) % 100), (int)(s.date / 10000),
+                 (int)(s.time / 1000000), (int)((s.time / 10000) % 100), (int)((s.time / 100) % 100));
+    } else {
+        snprintf(seen, sizeof(seen), "1970-01-01 00:00:%02d", (int)((s.uptimeMs / 1000) % 60));
+    }
+    char buf[320];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X,%s,%s,%s,%d,%d,%d,%.6f,%.6f,%.1f,%.1f,,,WIFI\r\n",
+             s.bssid[0], s.bssid[1], s.bssid[2], s.bssid[3], s.bssid[4], s.bssid[5],
+             legacyField(s.ssid).c_str(), authWigleString(s.auth), seen, s.channel,
+             channelToFrequency(s.channel), s.rssi, s.lat, s.lon, s.alt,
+             s.accuracy > 0 ? s.accuracy : 10.0);
+    return buf;
+}
+
+static std::string buildFile(const std::vector<Sighting>& all) {
+    FileHeader h = makeFileHeader();
+    std::string file((const char*)&h, sizeof(h));
+    for (const Sighting& s : all) {
+        Record r = toRecord(s);
+        file.append((const char*)&r, sizeof(r));
+    }
+    return file;
+}
+
+// Render a file image with reads and output chunks of the given sizes
+static std::string renderAll(const std::string& file, Output fmt, size_t readChunk,
+                             size_t outChunk, Renderer& r) {
+    size_t pos = 0;
+    auto src = [&](uint8_t* dst, size_t n) {
+        if (n > readChunk) n = readChunk;
+        if (n > file.size() - pos) n = file.size() - pos;
+        memcpy(dst, file.data() + pos, n);
+        pos += n;
+        return n;
+    };
+    r.begin(fmt, "test");
+    std::string out;
+    std::vector<char> buf(outChunk);
+    size_t n;
+    while ((n = r.read(src, buf.data(), outChunk)) > 0) out.append(buf.data(), n);
+    return out;
+}
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+void test_layout_headerAndCounts(void) {
+    FileHeader h = makeFileHeader();
+    TEST_ASSERT_TRUE(isFileHeader(h));
+    h.recordBytes = 48;
+    TEST_ASSERT_FALSE(isFileHeader(h));
+
+    TEST_ASSERT_EQUAL_UINT32(0, recordCount(10));
+    TEST_ASSERT_EQUAL_UINT32(0, recordCount(16 + 63));
+    TEST_ASSERT_EQUAL_UINT32(2, recordCount(16 + 128 + 5));  // Torn third record
+
+    TEST_ASSERT_TRUE(isLogName("/m5porkchop/wardriving/warhog_20261016_120000.wdr"));
+    TEST_ASSERT_TRUE(isLogName("WARHOG.WDR"));
+    TEST_ASSERT_FALSE(isLogName("warhog.wigle.csv"));
+    TEST_ASSERT_FALSE(isLogName(".wdr"));
+
+    char name[64];
+    renderedName("/x/warhog_1.wdr", ".wigle.csv", name, sizeof(name));
+    TEST_ASSERT_EQUAL_STRING("warhog_1.wigle.csv", name);
+    renderedName("warhog_1.wdr", ".csv", name, sizeof(name));
+    TEST_ASSERT_EQUAL_STRING("warhog_1.csv", name);
+}
+
+void test_record_fixedPointAndSsid(void) {
+    const uint8_t bssid[6] = {0xDE, 0xAD, 0xBE, 0xEF, 0x00, 0x01};
+    Record r = makeRecord(bssid, "0123456789012345678901234567890123456789", -67, 6,
+                          AUTH_WPA2_PSK, -33.8688197, 151.2092955, -12.34, 7.5, 0, 1234);
+    TEST_ASSERT_EQUAL_UINT8(32, r.ssidLen);
+    TEST_ASSERT_EQUAL_INT32(-338688197, r.latE7);
+    TEST_ASSERT_EQUAL_INT32(1512092955, r.lonE7);
+    TEST_ASSERT_EQUAL_INT32(-123, r.altDm);
+    TEST_ASSERT_EQUAL_UINT16(75, r.accuracyDm);
+
+    char line[kMaxWigleLine + 1];
+    TEST_ASSERT_TRUE(renderRecord(Output::Csv, r, line, sizeof(line)) > 0);
+    TEST_ASSERT_EQUAL_STRING("DE:AD:BE:EF:00:01,\"01234567890123456789012345678901\",-67,6,WPA2,"
+                             "-33.868820,151.209296,-12.3,1234\n", line);
+}
+
+// ============================================================================
+// GPS time
+// ============================================================================
+
+void test_epoch_fromGpsAndBack(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, epochFromGps(0, 12345600));
+    TEST_ASSERT_EQUAL_UINT32(0, epochFromGps(161026, 0));
+    TEST_ASSERT_EQUAL_UINT32(1792154096u, epochFromGps(161026, 12345600));  // 2026-10-16 12:34:56
+    TEST_ASSERT_EQUAL_UINT32(1709251199u, epochFromGps(290224, 23595999));  // Leap day
+    TEST_ASSERT_EQUAL_UINT32(946684800u, epochFromGps(10100, 1));           // 2000-01-01 00:00:00
+
+    const uint8_t bssid[6] = {0};
+    Record r = makeRecord(bssid, "x", -50, 1, AUTH_OPEN, 0, 0, 0, 0, 1709251199u, 0);
+    char line[kMaxWigleLine + 1];
+    renderRecord(Output::Wigle, r, line, sizeof(line));
+    TEST_ASSERT_NOT_NULL(strstr(line, ",2024-02-29 23:59:59,"));
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void test_render_matchesLegacyWriters(void) {
+    char line[Renderer::kLineBytes];
+    size_t longest = 0;
+    for (int i = 0; i < 20000; i++) {
+        Sighting s = makeSighting();
+        Record r = toRecord(s);
+
+        size_t n = renderRecord(Output::Wigle, r, line, sizeof(line));
+        TEST_ASSERT_EQUAL_STRING(legacyWigle(s).c_str(), line);
+        TEST_ASSERT_TRUE(n <= kMaxWigleLine);
+        if (n > longest) longest = n;
+
+        renderRecord(Output::Csv, r, line, sizeof(line));
+        TEST_ASSERT_EQUAL_STRING(legacyCsv(s).c_str(), line);
+    }
+
+    // Worst case: all quotes, longest auth string, extreme values
+    Sighting s = makeSighting();
+    memset(s.ssid, '"', 32);
+    s.ssid[32] = '\0';
+    s.auth = AUTH_WPA_WPA2_PSK;
+    s.channel = 233;
+    s.rssi = -128;
+    s.lat = -89.9999999;
+    s.lon = -179.9999999;
+    s.alt = -214748.3;
+    s.accuracy = 6553.5;
+    Record r = toRecord(s);
+    size_t n = renderRecord(Output::Wigle, r, line, sizeof(line));
+    TEST_ASSERT_TRUE(n > 0 && n <= kMaxWigleLine);
+
+    char header[Renderer::kLineBytes];
+    TEST_ASSERT_TRUE(renderHeader(Output::Wigle, "0.1.8b-PSTH-longer-release", header, sizeof(header)) <= kMaxWigleHeader);
+}
+
+void test_render_extremeRecordFitsExactly(void) {
+    // Every field at the widest value its type can hold, not just values
+    // a GPS or radio would produce: the line must be exactly kMaxWigleLine
+    Record r;
+    memset(&r, 0, sizeof(r));
+    memset(r.bssid, 0xFF, sizeof(r.bssid));
+    memset(r.ssid, '"', sizeof(r.ssid));
+    r.ssidLen = kMaxSsidLen;
+    r.auth = AUTH_WPA_WPA2_PSK;
+    r.rssi = -128;
+    r.channel = 233;
+    r.accuracyDm = 0xFFFF;
+    r.latE7 = INT32_MIN;
+    r.lonE7 = INT32_MIN;
+    r.altDm = INT32_MIN;
+    r.epoch = 0xFFFFFFFFu;
+    r.uptimeMs = 0xFFFFFFFFu;
+
+    char line[kMaxWigleLine + 1];
+    size_t n = renderRecord(Output::Wigle, r, line, sizeof(line));
+    TEST_ASSERT_EQUAL_UINT32(kMaxWigleLine, n);
+    TEST_ASSERT_NOT_NULL(strstr(line, ",2106-02-07 06:28:15,233,7115,-128,-214.748365,"
+                                      "-214.748365,-214748364.8,6553.5,,,WIFI\r\n"));
+
+    // No auth or channel pushes either format past the bound
+    for (int auth = 0; auth < 256; auth++) {
+        for (int ch = 0; ch < 256; ch++) {
+            r.auth = (uint8_t)auth;
+            r.channel = (uint8_t)ch;
+            TEST_ASSERT_TRUE(renderRecord(Output::Wigle, r, line, sizeof(line)) > 0);
+            TEST_ASSERT_TRUE(renderRecord(Output::Csv, r, line, sizeof(line)) > 0);
+        }
+    }
+}
+
+void test_renderer_anyChunkSizeSameOutput(void) {
+    std::vector<Sighting> all;
+    for (int i = 0; i < 300; i++) all.push_back(makeSighting());
+    std::string file = buildFile(all);
+
+    std::string expected;
+    char header[Renderer::kLineBytes];
+    renderHeader(Output::Wigle, "test", header, sizeof(header));
+    expected = header;
+    for (const Sighting& s : all) expected += legacyWigle(s);
+
+    Renderer r;
+    TEST_ASSERT_TRUE(renderAll(file, Output::Wigle, 4096, 2048, r) == expected);
+    TEST_ASSERT_EQUAL_UINT32(300, r.getRecords());
+    for (size_t readChunk : {1u, 7u, 64u, 100u}) {
+        for (size_t outChunk : {1u, 3u, 17u, 213u, 1024u}) {
+            TEST_ASSERT_TRUE(renderAll(file, Output::Wigle, readChunk, outChunk, r) == expected);
+        }
+    }
+}
+
+void test_renderer_tornTailAndForeignFiles(void) {
+    std::vector<Sighting> all;
+    for (int i = 0; i < 5; i++) all.push_back(makeSighting());
+    std::string file = buildFile(all);
+    Renderer r;
+
+    std::string whole = renderAll(file, Output::Csv, 4096, 512, r);
+    std::string torn = renderAll(file.substr(0, file.size() - 20), Output::Csv, 4096, 512, r);
+    TEST_ASSERT_EQUAL_UINT32(4, r.getRecords());
+    TEST_ASSERT_FALSE(r.failed());
+    TEST_ASSERT_TRUE(whole.compare(0, torn.size(), torn) == 0);
+    TEST_ASSERT_EQUAL_UINT32(legacyCsv(all[4]).size(), whole.size() - torn.size());
+
+    // Header only: just the column header line
+    std::string empty = renderAll(file.substr(0, sizeof(FileHeader)), Output::Csv, 4096, 512, r);
+    TEST_ASSERT_EQUAL_STRING("BSSID,SSID,RSSI,Channel,AuthMode,Latitude,Longitude,Altitude,Timestamp\r\n",
+                             empty.c_str());
+
+    // An old text WiGLE file renamed .wdr, or a truncated header
+    std::string text = "WigleWifi-1.6,appRelease=0.1.x\nMAC,SSID\r\n";
+    TEST_ASSERT_EQUAL_UINT32(0, renderAll(text, Output::Wigle, 4096, 512, r).size());
+    TEST_ASSERT_TRUE(r.failed());
+    TEST_ASSERT_EQUAL_UINT32(0, renderAll(file.substr(0, 9), Output::Wigle, 4096, 512, r).size());
+    TEST_ASSERT_TRUE(r.failed());
+}
+
+// ============================================================================
+// Write cost
+// ============================================================================
+
+void test_writeCost_recordVsTwoTextLines(void) {
+    const int N = 50000;
+    std::vector<Sighting> all;
+    all.reserve(N);
+    for (int i = 0; i < N; i++) all.push_back(makeSighting());
+
+    // Old path: format both text lines (as WARHOG did per AP)
+    size_t legacyBytes = 0;
+    char csv[256], wigle[320];
+    auto t0 = std::chrono::steady_clock::now();
+    for (const Sighting& s : all) {
+        std::string field = legacyField(s.ssid);
+        int a = snprintf(csv, sizeof(csv), "%02X:%02X:%02X:%02X:%02X:%02X,%s,%d,%d,%s,%.6f,%.6f,%.1f,%lu\n",
+                         s.bssid[0], s.bssid[1], s.bssid[2], s.bssid[3], s.bssid[4], s.bssid[5],
+                         field.c_str(), s.rssi, s.channel, authString(s.auth),
+                         s.lat, s.lon, s.alt, (unsigned long)s.uptimeMs);
+        int b = snprintf(wigle, sizeof(wigle), "%02X:%02X:%02X:%02X:%02X:%02X,%s,%s,%s,%d,%d,%d,%.6f,%.6f,%.1f,%.1f,,,WIFI\r\n",
+                         s.bssid[0], s.bssid[1], s.bssid[2], s.bssid[3], s.bssid[4], s.bssid[5],
+                         field.c_str(), authWigleString(s.auth), "2026-10-16 12:00:00", s.channel,
+                         channelToFrequency(s.channel), s.rssi, s.lat, s.lon, s.alt, s.accuracy);
+        legacyBytes += (size_t)a + (size_t)b;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // New path: one fixed record
+    size_t recordBytes = 0;
+    uint32_t sink = 0;
+    for (const Sighting& s : all) {
+        Record r = toRecord(s);
+        sink += (uint32_t)r.latE7 ^ r.epoch;
+        recordBytes += sizeof(r);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    double recordNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / N;
+    TEST_ASSERT_TRUE(legacyBytes >= 3 * recordBytes);
+    TEST_ASSERT_TRUE(recordNs * 2 < legacyNs);
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "per AP: legacy %.0f bytes / %.0f ns, record %u bytes / %.0f ns (%u)",
+             (double)legacyBytes / N, legacyNs, (unsigned)sizeof(Record), recordNs,
+             (unsigned)(sink & 1));
+    TEST_MESSAGE(msg);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Layout
+    RUN_TEST(test_layout_headerAndCounts);
+    RUN_TEST(test_record_fixedPointAndSsid);
+
+    // GPS time
+    RUN_TEST(test_epoch_fromGpsAndBack);
+
+    // Rendering
+    RUN_TEST(test_render_matchesLegacyWriters);
+    RUN_TEST(test_render_extremeRecordFitsExactly);
+    RUN_TEST(test_renderer_anyChunkSizeSameOutput);
+    RUN_TEST(test_renderer_tornTailAndForeignFiles);
+
+    // Write cost
+    RUN_TEST(test_writeCost_recordVsTwoTextLines);
+
+    return UNITY_END();
+}
@@ -0,0 +1,92 @@
+// wdr_convert - Render WARHOG .wdr session logs as WiGLE or legacy CSV
+// Uses the same WardriveFormat::Renderer as the device, so the CSV is
+// byte-identical to a file server download and to a WiGLE upload once
+// decompressed. --gzip output is equivalent after decompression only: the
+// device may halve its window under heap pressure, which changes the
+// compressed bytes.
+//
+// Build:  g++ -std=c++17 -O2 -o wdr_convert tools/wdr_convert.cpp
+// Usage:  wdr_convert [--csv] [--gzip] [--release VERSION] input.wdr [output]
+//         Writes WiGLE 1.6 CSV (or the legacy CSV with --csv) to output,
+//         or to stdout if no output is given. --gzip compresses it with the
+//         upload's default 4KB window.
+
+#include <cstdio>
+#include <cstring>
+#include "../src/core/gzip_stream.h"
+#include "../src/core/wardrive_format.h"
+
+static int usage() {
+    fprintf(stderr, "usage: wdr_convert [--csv] [--gzip] [--release VERSION] input.wdr [output]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    WardriveFormat::Output format = WardriveFormat::Output::Wigle;
+    bool gzip = false;
+    const char* release = "0.1.x";
+    const char* inPath = nullptr;
+    const char* outPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            format = WardriveFormat::Output::Csv;
+        } else if (strcmp(argv[i], "--gzip") == 0) {
+            gzip = true;
+        } else if (strcmp(argv[i], "--release") == 0 && i + 1 < argc) {
+            release = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            return usage();
+        } else if (!inPath) {
+            inPath = argv[i];
+        } else if (!outPath) {
+            outPath = argv[i];
+        } else {
+            return usage();
+        }
+    }
+    if (!inPath) return usage();
+
+    FILE* in = fopen(inPath, "rb");
+    if (!in) {
+        perror(inPath);
+        return 1;
+    }
+    FILE* out = outPath ? fopen(outPath, "wb") : stdout;
+    if (!out) {
+        perror(outPath);
+        fclose(in);
+        return 1;
+    }
+
+    WardriveFormat::Renderer renderer;
+    renderer.begin(format, release);
+    auto readFile = [in](uint8_t* dst, size_t n) { return fread(dst, 1, n, in); };
+    auto writeOut = [out](const uint8_t* src, size_t n) { return fwrite(src, 1, n, out) == n; };
+    static uint8_t gzState[GzipStream::stateBytes(4096)];
+    GzipStream gz;
+    gz.attach(gzState, sizeof(gzState));
+    gz.begin();
+
+    char chunk[4096];
+    size_t n;
+    bool writeOk = true;
+    while (writeOk && (n = renderer.read(readFile, chunk, sizeof(chunk))) > 0) {
+        writeOk = gzip ? gz.write((const uint8_t*)chunk, n, writeOut)
+                       : writeOut((const uint8_t*)chunk, n);
+    }
+    if (writeOk && gzip && !renderer.failed()) writeOk = gz.finish(writeOut);
+    fclose(in);
+    if (outPath) fclose(out);
+
+    if (renderer.failed()) {
+        fprintf(stderr, "%s: not a WARHOG session log\n", inPath);
+        return 1;
+    }
+    if (!writeOk) {
+        fprintf(stderr, "write failed\n");
+        return 1;
+    }
+    fprintf(stderr, "%u records\n", (unsigned)renderer.getRecords());
+    return 0;
+}